@@ -810,6 +810,16 @@ class ErrorObjectIdProvider final : public ObjectIdProvider {
 
 }  // anonymous namespace
 
+const char* GetWireCmdName(WireCmd command) {
+    switch (command) {
+        {% for command in cmd_records["command"] %}
+            case WireCmd::{{command.name.CamelCase()}}:
+                return "{{command.name.CamelCase()}}";
+        {% endfor %}
+    }
+    return nullptr;
+}
+
 {% for command in cmd_records["command"] -%}
     {{write_command_serialization_methods(command, False)}}
 {% endfor %}
@@ -77,6 +77,10 @@ namespace dawn::wire {
         {% endfor %}
     };
 
+    //* Returns the name of a command, for example "DeviceCreateBuffer", for tools that report
+    //* per-command statistics. Returns nullptr for values that aren't a WireCmd.
+    const char* GetWireCmdName(WireCmd command);
+
     struct CmdHeader {
         uint64_t commandSize;
     };
@@ -80,6 +80,12 @@ namespace dawn::wire::server {
             {% endfor %}
         }
 
+        void AllowOutOfOrderAllocations() {
+            {% for type in by_category["object"] %}
+                Objects<{{as_cType(type.name)}}>().AllowOutOfOrderAllocations();
+            {% endfor %}
+        }
+
       private:
         // Implementation of the ObjectIdResolver interface
         {% for type in by_category["object"] %}
@@ -53,19 +53,22 @@ namespace dawn::wire::server {
                     {%- endfor -%}
                 ) {
                     {% set ret = command.members|selectattr("is_return_value")|list %}
-                    //* If there is a return value, assign it.
-                    {% if ret|length == 1 %}
-                        *{{as_varName(ret[0].name)}} =
-                    {% else %}
-                        //* Only one member should be a return value.
-                        {{ assert(ret|length == 0) }}
-                    {% endif %}
-                    mProcs.{{as_varName(type.name, method.name)}}(
-                        {%- for member in command.members if not member.is_return_value -%}
-                            {{as_varName(member.name)}}
-                            {%- if not loop.last -%}, {% endif %}
-                        {%- endfor -%}
-                    );
+                    {
+                        BackendCallScope backendCall(this);
+                        //* If there is a return value, assign it.
+                        {% if ret|length == 1 %}
+                            *{{as_varName(ret[0].name)}} =
+                        {% else %}
+                            //* Only one member should be a return value.
+                            {{ assert(ret|length == 0) }}
+                        {% endif %}
+                        mProcs.{{as_varName(type.name, method.name)}}(
+                            {%- for member in command.members if not member.is_return_value -%}
+                                {{as_varName(member.name)}}
+                                {%- if not loop.last -%}, {% endif %}
+                            {%- endfor -%}
+                        );
+                    }
                     {% if ret|length == 1 %}
                         //* WebGPU error handling guarantees that no null object can be returned by
                         //* object creation functions.
@@ -92,6 +95,7 @@ namespace dawn::wire::server {
                             //* they should not be forwarded if the device no longer exists on the wire.
                             ClearDeviceCallbacks(obj->handle);
                         {% endif %}
+                        BackendCallScope backendCall(this);
                         Release(mProcs, obj->handle);
                     }
                     Objects<{{cType}}>().Free(objectId);
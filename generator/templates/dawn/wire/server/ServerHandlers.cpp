@@ -26,9 +26,48 @@
 //* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "dawn/common/Assert.h"
+#include "dawn/wire/server/DeviceCommandDispatcher.h"
 #include "dawn/wire/server/Server.h"
 
 namespace dawn::wire::server {
+
+    namespace {
+
+    // ObjectIdResolver that records the objects used by a command instead of resolving them.
+    // It is used to route commands before they are handled so objects are resolved to nullptr.
+    class ObjectUseRecorder final : public ObjectIdResolver {
+      public:
+        explicit ObjectUseRecorder(CommandObjects* objects) : mObjects(objects) {}
+
+        {% for type in by_category["object"] %}
+            {% set cType = as_cType(type.name) %}
+            WireResult GetFromId(ObjectId id, {{cType}}* out) const final {
+                *out = nullptr;
+                return Record(ObjectType::{{type.name.CamelCase()}}, id);
+            }
+
+            WireResult GetOptionalFromId(ObjectId id, {{cType}}* out) const final {
+                *out = nullptr;
+                if (id == 0) {
+                    return WireResult::Success;
+                }
+                return Record(ObjectType::{{type.name.CamelCase()}}, id);
+            }
+        {% endfor %}
+
+      private:
+        WireResult Record(ObjectType type, ObjectId id) const {
+            if (id == 0) {
+                return WireResult::FatalError;
+            }
+            mObjects->used.push_back({type, id});
+            return WireResult::Success;
+        }
+
+        raw_ptr<CommandObjects> mObjects;
+    };
+
+    }  // anonymous namespace
     {% for command in cmd_records["command"] %}
         {% set method = command.derived_method %}
         {% set is_method = method != None %}
@@ -36,9 +75,10 @@ namespace dawn::wire::server {
 
         {% set Suffix = command.name.CamelCase() %}
         //* The generic command handlers
-        WireResult Server::Handle{{Suffix}}(DeserializeBuffer* deserializeBuffer) {
+        WireResult Server::Handle{{Suffix}}(DeserializeBuffer* deserializeBuffer,
+                                            DeserializeAllocator* allocator) {
             {{Suffix}}Cmd cmd;
-            WIRE_TRY(cmd.Deserialize(deserializeBuffer, &mAllocator
+            WIRE_TRY(cmd.Deserialize(deserializeBuffer, allocator
                 {%- if command.may_have_dawn_object -%}
                     , *this
                 {%- endif -%}
@@ -87,6 +127,63 @@ namespace dawn::wire::server {
         }
     {% endfor %}
 
+    WireResult Server::HandleCommand(DeserializeBuffer* deserializeBuffer,
+                                     DeserializeAllocator* allocator) {
+        WireCmd cmdId = *static_cast<const volatile WireCmd*>(static_cast<const volatile void*>(
+            deserializeBuffer->Buffer() + sizeof(CmdHeader)));
+        switch (cmdId) {
+            {% for command in cmd_records["command"] %}
+                case WireCmd::{{command.name.CamelCase()}}:
+                    return Handle{{command.name.CamelCase()}}(deserializeBuffer, allocator);
+            {% endfor %}
+            default:
+                return WireResult::FatalError;
+        }
+    }
+
+    WireResult Server::GetCommandObjects(DeserializeBuffer* deserializeBuffer,
+                                         DeserializeAllocator* allocator,
+                                         CommandObjects* objects) {
+        objects->Clear();
+
+        WireCmd cmdId = *static_cast<const volatile WireCmd*>(static_cast<const volatile void*>(
+            deserializeBuffer->Buffer() + sizeof(CmdHeader)));
+        switch (cmdId) {
+            {% for command in cmd_records["command"] %}
+                {% set Suffix = command.name.CamelCase() %}
+                case WireCmd::{{Suffix}}: {
+                    {{Suffix}}Cmd cmd;
+                    {% if command.may_have_dawn_object %}
+                        ObjectUseRecorder recorder(objects);
+                        WIRE_TRY(cmd.Deserialize(deserializeBuffer, allocator, recorder));
+                    {% else %}
+                        WIRE_TRY(cmd.Deserialize(deserializeBuffer, allocator));
+                    {% endif %}
+
+                    //* The target of the command is the object it is called on, or the first
+                    //* object passed by ID for handwritten commands.
+                    {% set id_members = command.members|selectattr("id_type")|list %}
+                    {% if command.derived_method %}
+                        objects->target = {ObjectType::{{command.derived_object.name.CamelCase()}}, cmd.selfId};
+                    {% elif command.name.get() == "unregister object" %}
+                        objects->target = {cmd.objectType, cmd.objectId};
+                    {% elif id_members|length > 0 %}
+                        objects->target = {ObjectType::{{id_members[0].id_type.name.CamelCase()}}, cmd.{{as_varName(id_members[0].name)}}};
+                    {% endif %}
+                    {% for member in id_members %}
+                        objects->used.push_back({ObjectType::{{member.id_type.name.CamelCase()}}, cmd.{{as_varName(member.name)}}});
+                    {% endfor %}
+                    {% for member in command.members if member.handle_type %}
+                        objects->created.push_back({ObjectType::{{member.handle_type.name.CamelCase()}}, cmd.{{as_varName(member.name)}}.id});
+                    {% endfor %}
+                    return WireResult::Success;
+                }
+            {% endfor %}
+            default:
+                return WireResult::FatalError;
+        }
+    }
+
     const volatile char* Server::HandleCommandsImpl(const volatile char* commands, size_t size) {
         DeserializeBuffer deserializeBuffer(commands, size);
 
@@ -102,31 +199,29 @@ namespace dawn::wire::server {
                     break;
             }
 
-            WireCmd cmdId = *static_cast<const volatile WireCmd*>(static_cast<const volatile void*>(
-                deserializeBuffer.Buffer() + sizeof(CmdHeader)));
-            WireResult result;
-            switch (cmdId) {
-                {% for command in cmd_records["command"] %}
-                    case WireCmd::{{command.name.CamelCase()}}:
-                        result = Handle{{command.name.CamelCase()}}(&deserializeBuffer);
-                        break;
-                {% endfor %}
-                default:
-                    result = WireResult::FatalError;
-            }
-
+            //* When commands are dispatched by device, they are handled on the worker threads.
+            WireResult result = mDispatcher != nullptr
+                                    ? DispatchCommand(&deserializeBuffer)
+                                    : HandleCommand(&deserializeBuffer, &mAllocator);
             if (result != WireResult::Success) {
                 return nullptr;
             }
             mAllocator.Reset();
         }
 
+        if (mDispatcher != nullptr) {
+            mDispatcher->Submit();
+        }
+
         // After the server handles all the commands from the stream, we additionally run
         // ProcessEvents on all known Instances so that any work done on the server side can be
         // forwarded through to the client.
-        for (auto instance : Objects<WGPUInstance>().GetAllHandles()) {
-            if (DoInstanceProcessEvents(instance) != WireResult::Success) {
-                return nullptr;
+        {
+            auto lock = LockState();
+            for (auto instance : Objects<WGPUInstance>().GetAllHandles()) {
+                if (DoInstanceProcessEvents(instance) != WireResult::Success) {
+                    return nullptr;
+                }
             }
         }
 
@@ -200,6 +200,19 @@ DAWN_NATIVE_EXPORT std::vector<const char*> GetTogglesUsed(WGPUDevice device);
 // Backdoor to get the number of lazy clears for testing
 DAWN_NATIVE_EXPORT size_t GetLazyClearCountForTesting(WGPUDevice device);
 
+// Counters of the device's shader module caches.
+struct DAWN_NATIVE_EXPORT ShaderModuleCacheStats {
+    // The number of shader module creations that were looked up in the caches.
+    uint64_t lookupCount = 0;
+    // The number of creations that returned a module with the same descriptor, or with a
+    // descriptor that was already found to have the same canonical program.
+    uint64_t contentHitCount = 0;
+    // The number of creations that returned a module with the same canonical program, when the
+    // dedup_shader_modules_by_program toggle is enabled.
+    uint64_t programHitCount = 0;
+};
+DAWN_NATIVE_EXPORT ShaderModuleCacheStats GetShaderModuleCacheStats(WGPUDevice device);
+
 //  Query if texture has been initialized
 DAWN_NATIVE_EXPORT bool IsTextureSubresourceInitialized(
     WGPUTexture texture,
@@ -308,8 +321,29 @@ DAWN_NATIVE_EXPORT uint64_t ComputeEstimatedMemoryUsage(WGPUDevice device);
 // Free any unused GPU memory like staging buffers, cached resources, etc.
 DAWN_NATIVE_EXPORT void ReduceMemoryUsage(WGPUDevice device);
 
+// Counters of the device's sub-allocated resource memory. Only implemented on Vulkan, other
+// backends return zeros.
+struct DAWN_NATIVE_EXPORT ResourceMemoryStats {
+    // The number and total size of the memory heaps that resources are sub-allocated from, and
+    // the total size of the sub-allocations in them.
+    uint64_t heapCount = 0;
+    uint64_t heapSize = 0;
+    uint64_t usedSize = 0;
+    // The number of heaps in which at most a quarter of the size is sub-allocated.
+    uint64_t sparseHeapCount = 0;
+    // The number of free heaps kept for reuse.
+    uint64_t pooledHeapCount = 0;
+    // The number of sub-allocations moved to other heaps by PerformIdleTasks to release sparse
+    // heaps, and the number of free heaps released by PerformIdleTasks or to stay in budget.
+    uint64_t movedAllocationCount = 0;
+    uint64_t releasedHeapCount = 0;
+    // The number of memory heaps allocated while exceeding the memory budget.
+    uint64_t overBudgetAllocationCount = 0;
+};
+DAWN_NATIVE_EXPORT ResourceMemoryStats GetResourceMemoryStats(WGPUDevice device);
+
 // Perform tasks that are appropriate to do when idle like serializing pipeline
-// caches, etc.
+// caches, moving resources out of sparse memory heaps, etc.
 DAWN_NATIVE_EXPORT void PerformIdleTasks(const wgpu::Device& device);
 
 }  // namespace dawn::native
@@ -83,6 +83,13 @@ class DAWN_PLATFORM_EXPORT WaitableEvent {
 
 using PostWorkerTaskCallback = void (*)(void* userdata);
 
+// Scheduling hint for worker tasks. High priority tasks (e.g. asynchronous pipeline compilation)
+// are latency-sensitive and run before any queued Low priority tasks (e.g. cache writes).
+enum class WorkerTaskPriority {
+    High,
+    Low,
+};
+
 class DAWN_PLATFORM_EXPORT WorkerTaskPool {
   public:
     WorkerTaskPool() = default;
@@ -93,6 +100,13 @@ class DAWN_PLATFORM_EXPORT WorkerTaskPool {
 
     virtual std::unique_ptr<WaitableEvent> PostWorkerTask(PostWorkerTaskCallback,
                                                           void* userdata) = 0;
+
+    // Posts a task with a scheduling hint. The default implementation ignores the priority and
+    // forwards to PostWorkerTask so that existing embedder pools keep working.
+    virtual std::unique_ptr<WaitableEvent> PostWorkerTaskWithPriority(
+        PostWorkerTaskCallback callback,
+        void* userdata,
+        WorkerTaskPriority priority);
 };
 
 // These features map to similarly named ones in src/chromium/src/gpu/config/gpu_finch_features.h
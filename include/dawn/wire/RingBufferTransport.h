@@ -0,0 +1,115 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef INCLUDE_DAWN_WIRE_RINGBUFFERTRANSPORT_H_
+#define INCLUDE_DAWN_WIRE_RINGBUFFERTRANSPORT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "dawn/wire/Wire.h"
+#include "dawn/wire/dawn_wire_export.h"
+
+namespace dawn::wire {
+
+class RingBufferConsumer;
+class RingBufferProducer;
+
+// A single-producer single-consumer transport for the wire, built on a ring buffer in memory
+// shared between the two ends, for example between a renderer process and a GPU process.
+//
+// The producer serializes commands directly into the ring and the consumer hands them to its
+// CommandHandler in place, so that commands such as QueueWriteBuffer and QueueWriteTexture are
+// copied once by the client into the ring and read from there by the server. Allocations can use
+// up to half of the ring, which keeps large uploads from being heap-allocated and split into
+// chunks by the client, and reassembled by the server.
+
+// Signals the other end of the ring buffer. Each end has its own doorbell.
+class DAWN_WIRE_EXPORT RingBufferDoorbell {
+  public:
+    RingBufferDoorbell();
+    virtual ~RingBufferDoorbell();
+    RingBufferDoorbell(const RingBufferDoorbell& rhs) = delete;
+    RingBufferDoorbell& operator=(const RingBufferDoorbell& rhs) = delete;
+
+    // Wakes up the other end: the producer rings after publishing commands, and the consumer
+    // after freeing space in the ring.
+    virtual void Ring() = 0;
+    // Waits until the other end rings. Returns false on error, for example if the other end is
+    // gone.
+    virtual bool Wait() = 0;
+};
+
+// Returns the size of the shared memory needed for a ring with |capacity| bytes of commands.
+// |capacity| must be a multiple of 8.
+DAWN_WIRE_EXPORT size_t GetRingBufferMemorySize(size_t capacity);
+
+// Initializes the shared memory of a ring. Must be called once before either end uses it.
+DAWN_WIRE_EXPORT void InitializeRingBuffer(void* memory, size_t capacity);
+
+class DAWN_WIRE_EXPORT RingBufferCommandSerializer : public CommandSerializer {
+  public:
+    // |memory| must be GetRingBufferMemorySize(capacity) bytes, initialized with
+    // InitializeRingBuffer and outlive the serializer.
+    RingBufferCommandSerializer(void* memory, size_t capacity, RingBufferDoorbell* doorbell);
+    ~RingBufferCommandSerializer() override;
+
+    // Waits on the doorbell for the consumer to free space if the ring is full.
+    void* GetCmdSpace(size_t size) override;
+    // Publishes the commands serialized so far and rings the doorbell.
+    bool Flush() override;
+    size_t GetMaximumAllocationSize() const override;
+
+  private:
+    std::unique_ptr<RingBufferProducer> mImpl;
+};
+
+class DAWN_WIRE_EXPORT RingBufferCommandReader {
+  public:
+    // |memory| must be GetRingBufferMemorySize(capacity) bytes, initialized with
+    // InitializeRingBuffer and outlive the reader.
+    RingBufferCommandReader(void* memory,
+                            size_t capacity,
+                            CommandHandler* handler,
+                            RingBufferDoorbell* doorbell);
+    ~RingBufferCommandReader();
+    RingBufferCommandReader(const RingBufferCommandReader& rhs) = delete;
+    RingBufferCommandReader& operator=(const RingBufferCommandReader& rhs) = delete;
+
+    // Hands all the published commands to the handler, then rings the doorbell to signal the
+    // producer that space was freed. Returns false if the ring is corrupted or the handler
+    // failed, after which the reader must not be used anymore.
+    bool ProcessCommands();
+
+  private:
+    std::unique_ptr<RingBufferConsumer> mImpl;
+};
+
+}  // namespace dawn::wire
+
+#endif  // INCLUDE_DAWN_WIRE_RINGBUFFERTRANSPORT_H_
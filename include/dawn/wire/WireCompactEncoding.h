@@ -0,0 +1,104 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef INCLUDE_DAWN_WIRE_WIRECOMPACTENCODING_H_
+#define INCLUDE_DAWN_WIRE_WIRECOMPACTENCODING_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "dawn/wire/Wire.h"
+#include "dawn/wire/dawn_wire_export.h"
+
+namespace dawn::wire {
+
+class CompactEncoder;
+class CompactDecoder;
+
+// Version of the stream produced by CompactCommandSerializer. The compact encoding is optional
+// and both ends of a connection must agree to use it, for example by exchanging this version in
+// the embedder's connection handshake before wrapping their transports. Frames with another
+// version are rejected by CompactCommandHandler.
+static constexpr uint32_t kCompactEncodingVersion = 1;
+
+// Maximum size of the commands contained in a single frame. CompactCommandSerializer never makes
+// allocations larger than this, and CompactCommandHandler rejects frames that claim to be larger
+// before buffering them.
+static constexpr uint64_t kMaxCompactFrameDecodedSize = 64 * 1024 * 1024;
+
+struct DAWN_WIRE_EXPORT CompactCommandSerializerDescriptor {
+    // The serializer that receives the compact stream.
+    CommandSerializer* serializer;
+    // Drop pass and bundle encoder state-setting commands that are identical to the previous one
+    // when no command in between can have changed the encoder state. Only valid for the
+    // client-to-server stream.
+    bool elideRedundantCommands = false;
+};
+
+struct CompactEncodingStats {
+    // Size of the commands given to the serializer, including elided commands.
+    uint64_t decodedBytes = 0;
+    // Size of the frames written to the wrapped serializer.
+    uint64_t encodedBytes = 0;
+    uint64_t elidedCommands = 0;
+};
+
+// A CommandSerializer that delta-encodes the commands it is given against the previous command of
+// the same type and writes them, using variable-length integers, as frames into another
+// serializer. The frames must be decoded by a CompactCommandHandler on the other end.
+class DAWN_WIRE_EXPORT CompactCommandSerializer : public CommandSerializer {
+  public:
+    explicit CompactCommandSerializer(const CompactCommandSerializerDescriptor& descriptor);
+    ~CompactCommandSerializer() override;
+
+    void* GetCmdSpace(size_t size) override;
+    bool Flush() override;
+    size_t GetMaximumAllocationSize() const override;
+    void OnSerializeError() override;
+
+    CompactEncodingStats GetStats() const;
+
+  private:
+    std::unique_ptr<CompactEncoder> mImpl;
+};
+
+// A CommandHandler that decodes frames produced by a CompactCommandSerializer and forwards the
+// original commands to another handler.
+class DAWN_WIRE_EXPORT CompactCommandHandler : public CommandHandler {
+  public:
+    explicit CompactCommandHandler(CommandHandler* handler);
+    ~CompactCommandHandler() override;
+
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override;
+
+  private:
+    std::unique_ptr<CompactDecoder> mImpl;
+};
+
+}  // namespace dawn::wire
+
+#endif  // INCLUDE_DAWN_WIRE_WIRECOMPACTENCODING_H_
@@ -45,6 +45,15 @@ struct DAWN_WIRE_EXPORT WireServerDescriptor {
     const DawnProcTable* procs;
     CommandSerializer* serializer;
     server::MemoryTransferService* memoryTransferService = nullptr;
+    // When non-zero, commands are sharded by device onto this many worker threads so that a
+    // device with heavy work doesn't stall the others. Commands of a device keep their order,
+    // and commands using objects of several devices wait for the previous commands on them.
+    // The procs must then be safe to call from several threads concurrently (for example
+    // dawn::native with ImplicitDeviceSynchronization). Errors from commands handled on the
+    // workers are reported by the following HandleCommands or WaitForDispatchedCommands. The
+    // serializer is only used with the server state locked, so it must be flushed with
+    // WaitForDispatchedCommands while the workers may use it.
+    uint32_t deviceCommandThreadCount = 0;
 };
 
 class DAWN_WIRE_EXPORT WireServer : public CommandHandler {
@@ -73,6 +82,14 @@ class DAWN_WIRE_EXPORT WireServer : public CommandHandler {
     // them periodically to ensure progress on asynchronous work is made.
     bool IsDeviceKnown(WGPUDevice device) const;
 
+    // Waits until all the commands dispatched to the device command threads have been handled.
+    // If |flushReplies| is true, the serializer is flushed each time all the commands of a device
+    // are handled, so that the replies of a device don't wait for the commands of the others, and
+    // once more before returning. It is then flushed on the calling thread with the server state
+    // locked, so its handler must not wait on the server. Returns false if one of the commands
+    // failed or if a flush failed.
+    bool WaitForDispatchedCommands(bool flushReplies = true);
+
   private:
     std::shared_ptr<server::Server> mImpl;
 };
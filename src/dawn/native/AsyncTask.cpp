@@ -29,18 +29,21 @@
 
 #include <utility>
 
-#include "dawn/platform/DawnPlatform.h"
+#include "dawn/common/Assert.h"
 
 namespace dawn::native {
 
 AsyncTaskManager::AsyncTaskManager(dawn::platform::WorkerTaskPool* workerTaskPool)
     : mWorkerTaskPool(workerTaskPool) {}
 
-void AsyncTaskManager::PostTask(AsyncTask asyncTask) {
+void AsyncTaskManager::PostTask(AsyncTask asyncTask,
+                                AsyncTask cancelTask,
+                                dawn::platform::WorkerTaskPriority priority) {
     // If these allocations becomes expensive, we can slab-allocate tasks.
     Ref<WaitableTask> waitableTask = AcquireRef(new WaitableTask());
     waitableTask->taskManager = this;
     waitableTask->asyncTask = std::move(asyncTask);
+    waitableTask->cancelTask = std::move(cancelTask);
 
     {
         // We insert new waitableTask objects into mPendingTasks in main thread (PostTask()),
@@ -55,7 +58,7 @@ void AsyncTaskManager::PostTask(AsyncTask asyncTask) {
     // The worker function will acquire and release the task upon completion.
     waitableTask->AddRef();
     waitableTask->waitableEvent =
-        mWorkerTaskPool->PostWorkerTask(DoWaitableTask, waitableTask.Get());
+        mWorkerTaskPool->PostWorkerTaskWithPriority(DoWaitableTask, waitableTask.Get(), priority);
 }
 
 void AsyncTaskManager::HandleTaskCompletion(WaitableTask* task) {
@@ -76,6 +79,33 @@ void AsyncTaskManager::WaitAllPendingTasks() {
     }
 }
 
+void AsyncTaskManager::CancelAndWaitAllPendingTasks() {
+    absl::flat_hash_map<WaitableTask*, Ref<WaitableTask>> allPendingTasks;
+
+    {
+        std::lock_guard<std::mutex> lock(mPendingTasksMutex);
+        allPendingTasks.swap(mPendingTasks);
+    }
+
+    for (auto& [_, task] : allPendingTasks) {
+        WaitableTask::State expected = WaitableTask::State::Pending;
+        if (!task->state.compare_exchange_strong(expected, WaitableTask::State::Cancelled)) {
+            // The task is already running on a worker thread.
+            task->waitableEvent->Wait();
+            continue;
+        }
+
+        // The worker still owns a reference to the task and will skip it when it gets to it,
+        // possibly after this AsyncTaskManager is destroyed.
+        task->taskManager = nullptr;
+        task->asyncTask = nullptr;
+        AsyncTask cancelTask = std::move(task->cancelTask);
+        if (cancelTask) {
+            cancelTask();
+        }
+    }
+}
+
 bool AsyncTaskManager::HasPendingTasks() {
     std::lock_guard<std::mutex> lock(mPendingTasksMutex);
     return !mPendingTasks.empty();
@@ -83,6 +113,12 @@ bool AsyncTaskManager::HasPendingTasks() {
 
 void AsyncTaskManager::DoWaitableTask(void* task) {
     Ref<WaitableTask> waitableTask = AcquireRef(static_cast<WaitableTask*>(task));
+    WaitableTask::State expected = WaitableTask::State::Pending;
+    if (!waitableTask->state.compare_exchange_strong(expected, WaitableTask::State::Running)) {
+        DAWN_ASSERT(expected == WaitableTask::State::Cancelled);
+        return;
+    }
+    waitableTask->cancelTask = nullptr;
     waitableTask->asyncTask();
     waitableTask->taskManager->HandleTaskCompletion(waitableTask.Get());
 }
@@ -28,6 +28,7 @@
 #ifndef SRC_DAWN_NATIVE_ASYNCTASK_H_
 #define SRC_DAWN_NATIVE_ASYNCTASK_H_
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -35,28 +36,31 @@
 #include "absl/container/flat_hash_map.h"
 #include "dawn/common/Ref.h"
 #include "dawn/common/RefCounted.h"
+#include "dawn/platform/DawnPlatform.h"
 #include "partition_alloc/pointers/raw_ptr.h"
 
-namespace dawn::platform {
-class WaitableEvent;
-class WorkerTaskPool;
-}  // namespace dawn::platform
-
 namespace dawn::native {
 
 // TODO(crbug.com/dawn/826): we'll add additional things to AsyncTask in the future, like
-// Cancel() and RunNow(). Cancelling helps avoid running the task's body when we are just
-// shutting down the device. RunNow() could be used for more advanced scenarios, for example
-// always doing ShaderModule initial compilation asynchronously, but being able to steal the
-// task if we need it for synchronous pipeline compilation.
+// RunNow(). RunNow() could be used for more advanced scenarios, for example always doing
+// ShaderModule initial compilation asynchronously, but being able to steal the task if we need it
+// for synchronous pipeline compilation.
 using AsyncTask = std::function<void()>;
 
 class AsyncTaskManager {
   public:
     explicit AsyncTaskManager(dawn::platform::WorkerTaskPool* workerTaskPool);
 
-    void PostTask(AsyncTask asyncTask);
+    // Posts |asyncTask| to the worker task pool. If the task is cancelled before a worker starts
+    // running it, |cancelTask| is called instead on the thread that cancels it.
+    void PostTask(
+        AsyncTask asyncTask,
+        AsyncTask cancelTask = {},
+        dawn::platform::WorkerTaskPriority priority = dawn::platform::WorkerTaskPriority::High);
     void WaitAllPendingTasks();
+    // Cancels the pending tasks that haven't started running yet and waits for the other ones to
+    // complete. Used when shutting down the device to avoid doing work whose result is discarded.
+    void CancelAndWaitAllPendingTasks();
     bool HasPendingTasks();
 
   private:
@@ -65,7 +69,15 @@ class AsyncTaskManager {
         WaitableTask();
         ~WaitableTask() override;
 
+        enum class State {
+            Pending,
+            Running,
+            Cancelled,
+        };
+
         AsyncTask asyncTask;
+        AsyncTask cancelTask;
+        std::atomic<State> state = State::Pending;
         raw_ptr<AsyncTaskManager> taskManager;
         std::unique_ptr<dawn::platform::WaitableEvent> waitableEvent;
     };
@@ -537,9 +537,95 @@ BindGroupBase::BindGroupBase(DeviceBase* device,
                                                     mBindingData.bufferData[bindingIndex].size;
                                             });
 
+    ComputeResourceUsage();
+
     GetObjectTrackingList()->Track(this);
 }
 
+void BindGroupBase::ComputeResourceUsage() {
+    const BindGroupLayoutInternalBase* layout = GetLayout();
+
+    auto addBufferUsage = [&](BufferBase* buffer, wgpu::BufferUsage usage,
+                              wgpu::ShaderStage shaderStages) {
+        // Bind groups have few bindings so a linear search is enough to merge the usages of
+        // buffers bound multiple times.
+        for (size_t i = 0; i < mResourceUsage.buffers.size(); ++i) {
+            if (mResourceUsage.buffers[i] == buffer) {
+                mResourceUsage.bufferSyncInfos[i].usage |= usage;
+                mResourceUsage.bufferSyncInfos[i].shaderStages |= shaderStages;
+                return;
+            }
+        }
+        mResourceUsage.buffers.push_back(buffer);
+        mResourceUsage.bufferSyncInfos.push_back({usage, shaderStages});
+    };
+    auto addTextureViewUsage = [&](TextureViewBase* view, wgpu::TextureUsage usage,
+                                   wgpu::ShaderStage shaderStages) {
+        mResourceUsage.textureRanges.push_back(
+            {view->GetTexture(), view->GetSubresourceRange(), {usage, shaderStages}});
+    };
+
+    for (BindingIndex bindingIndex{0}; bindingIndex < layout->GetBindingCount(); ++bindingIndex) {
+        const BindingInfo& bindingInfo = layout->GetBindingInfo(bindingIndex);
+
+        MatchVariant(
+            bindingInfo.bindingLayout,
+            [&](const BufferBindingInfo& bindingLayout) {
+                BufferBase* buffer = GetBindingAsBufferBinding(bindingIndex).buffer;
+                switch (bindingLayout.type) {
+                    case wgpu::BufferBindingType::Uniform:
+                        addBufferUsage(buffer, wgpu::BufferUsage::Uniform, bindingInfo.visibility);
+                        break;
+                    case wgpu::BufferBindingType::Storage:
+                        addBufferUsage(buffer, wgpu::BufferUsage::Storage, bindingInfo.visibility);
+                        break;
+                    case kInternalStorageBufferBinding:
+                        addBufferUsage(buffer, kInternalStorageBuffer, bindingInfo.visibility);
+                        break;
+                    case wgpu::BufferBindingType::ReadOnlyStorage:
+                        addBufferUsage(buffer, kReadOnlyStorageBuffer, bindingInfo.visibility);
+                        break;
+                    case wgpu::BufferBindingType::Undefined:
+                        DAWN_UNREACHABLE();
+                }
+            },
+            [&](const TextureBindingInfo& bindingLayout) {
+                TextureViewBase* view = GetBindingAsTextureView(bindingIndex);
+                switch (bindingLayout.sampleType) {
+                    case kInternalResolveAttachmentSampleType:
+                        addTextureViewUsage(view, kResolveAttachmentLoadingUsage,
+                                            bindingInfo.visibility);
+                        break;
+                    default:
+                        addTextureViewUsage(view, wgpu::TextureUsage::TextureBinding,
+                                            bindingInfo.visibility);
+                        break;
+                }
+            },
+            [&](const StorageTextureBindingInfo& bindingLayout) {
+                TextureViewBase* view = GetBindingAsTextureView(bindingIndex);
+                switch (bindingLayout.access) {
+                    case wgpu::StorageTextureAccess::WriteOnly:
+                        addTextureViewUsage(view, kWriteOnlyStorageTexture, bindingInfo.visibility);
+                        break;
+                    case wgpu::StorageTextureAccess::ReadWrite:
+                        addTextureViewUsage(view, wgpu::TextureUsage::StorageBinding,
+                                            bindingInfo.visibility);
+                        break;
+                    case wgpu::StorageTextureAccess::ReadOnly:
+                        addTextureViewUsage(view, kReadOnlyStorageTexture, bindingInfo.visibility);
+                        break;
+                    case wgpu::StorageTextureAccess::Undefined:
+                        DAWN_UNREACHABLE();
+                }
+            },
+            [](const SamplerBindingInfo&) {}, [](const StaticSamplerBindingInfo&) {},
+            // Input attachments are only created by backends for the pass's own attachments,
+            // which are already tracked as render attachments.
+            [](const InputAttachmentBindingInfo&) {});
+    }
+}
+
 BindGroupBase::~BindGroupBase() = default;
 
 void BindGroupBase::DestroyImpl() {
@@ -548,6 +634,7 @@ void BindGroupBase::DestroyImpl() {
         for (BindingIndex i{0}; i < GetLayout()->GetBindingCount(); ++i) {
             mBindingData.bindings[i].~Ref<ObjectBase>();
         }
+        mResourceUsage = {};
     }
 }
 
@@ -633,6 +720,11 @@ const std::vector<Ref<ExternalTextureBase>>& BindGroupBase::GetBoundExternalText
     return mBoundExternalTextures;
 }
 
+const BindGroupResourceUsage& BindGroupBase::GetResourceUsage() const {
+    DAWN_ASSERT(!IsError());
+    return mResourceUsage;
+}
+
 void BindGroupBase::ForEachUnverifiedBufferBindingIndex(
     std::function<void(BindingIndex, uint32_t)> fn) const {
     ForEachUnverifiedBufferBindingIndexImpl(GetLayout(), fn);
@@ -214,7 +214,7 @@ uint64_t BuddyAllocator::Allocate(uint64_t allocationSize, uint64_t alignment) {
     return currBlock->mOffset;
 }
 
-void BuddyAllocator::Deallocate(uint64_t offset) {
+uint64_t BuddyAllocator::Deallocate(uint64_t offset) {
     BuddyBlock* curr = mRoot;
 
     // TODO(crbug.com/dawn/827): Optimize de-allocation.
@@ -240,6 +240,7 @@ void BuddyAllocator::Deallocate(uint64_t offset) {
 
     // Mark curr free so we can merge.
     curr->mState = BlockState::Free;
+    const uint64_t blockSize = curr->mSize;
 
     // Merge the buddies (LevelN-to-Level0).
     while (currBlockLevel > 0 && curr->pBuddy->mState == BlockState::Free) {
@@ -262,6 +263,8 @@ void BuddyAllocator::Deallocate(uint64_t offset) {
     }
 
     InsertFreeBlock(curr, currBlockLevel);
+
+    return blockSize;
 }
 
 // Helper which deletes a block in the tree recursively (post-order).
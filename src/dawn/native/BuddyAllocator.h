@@ -55,7 +55,8 @@ class BuddyAllocator {
 
     // Required methods.
     uint64_t Allocate(uint64_t allocationSize, uint64_t alignment = 1);
-    void Deallocate(uint64_t offset);
+    // Returns the size of the block that was allocated at `offset`.
+    uint64_t Deallocate(uint64_t offset);
 
     // For testing purposes only.
     uint64_t ComputeTotalNumOfFreeBlocksForTesting() const;
@@ -86,10 +86,13 @@ ResultOrError<ResourceMemoryAllocation> BuddyMemoryAllocator::Allocate(uint64_t
         // Transfer ownership to this allocator
         std::unique_ptr<ResourceHeapBase> memory;
         DAWN_TRY_ASSIGN(memory, mHeapAllocator->AllocateResourceHeap(mMemoryBlockSize));
-        mTrackedSubAllocations[memoryIndex] = {/*refcount*/ 0, std::move(memory)};
+        mTrackedSubAllocations[memoryIndex] = {/*refcount*/ 0, /*usedSize*/ 0, std::move(memory)};
+        mHeapCount++;
     }
 
     mTrackedSubAllocations[memoryIndex].refcount++;
+    mTrackedSubAllocations[memoryIndex].usedSize += allocationSize;
+    mUsedSize += allocationSize;
 
     AllocationInfo info;
     info.mBlockOffset = blockOffset;
@@ -115,15 +118,59 @@ void BuddyMemoryAllocator::Deallocate(const ResourceMemoryAllocation& allocation
     if (mTrackedSubAllocations[memoryIndex].refcount == 0) {
         mHeapAllocator->DeallocateResourceHeap(
             std::move(mTrackedSubAllocations[memoryIndex].mMemoryAllocation));
+        mHeapCount--;
     }
 
-    mBuddyBlockAllocator.Deallocate(info.mBlockOffset);
+    const uint64_t blockSize = mBuddyBlockAllocator.Deallocate(info.mBlockOffset);
+    DAWN_ASSERT(mTrackedSubAllocations[memoryIndex].usedSize >= blockSize);
+    mTrackedSubAllocations[memoryIndex].usedSize -= blockSize;
+    mUsedSize -= blockSize;
 }
 
 uint64_t BuddyMemoryAllocator::GetMemoryBlockSize() const {
     return mMemoryBlockSize;
 }
 
+uint64_t BuddyMemoryAllocator::GetHeapCount() const {
+    return mHeapCount;
+}
+
+uint64_t BuddyMemoryAllocator::GetUsedSize() const {
+    return mUsedSize;
+}
+
+uint64_t BuddyMemoryAllocator::GetHeapUsedSize(const ResourceMemoryAllocation& allocation) const {
+    DAWN_ASSERT(allocation.GetInfo().mMethod == AllocationMethod::kSubAllocated);
+    return mTrackedSubAllocations[GetMemoryIndex(allocation.GetInfo().mBlockOffset)].usedSize;
+}
+
+uint64_t BuddyMemoryAllocator::GetHeapSubAllocationCount(
+    const ResourceMemoryAllocation& allocation) const {
+    DAWN_ASSERT(allocation.GetInfo().mMethod == AllocationMethod::kSubAllocated);
+    return mTrackedSubAllocations[GetMemoryIndex(allocation.GetInfo().mBlockOffset)].refcount;
+}
+
+uint64_t BuddyMemoryAllocator::ComputeSparseHeapCount(uint64_t maxUsedSize) const {
+    uint64_t count = 0;
+    for (const TrackedSubAllocations& allocation : mTrackedSubAllocations) {
+        if (allocation.refcount > 0 && allocation.usedSize <= maxUsedSize) {
+            count++;
+        }
+    }
+    return count;
+}
+
+std::vector<const ResourceHeapBase*> BuddyMemoryAllocator::GetSparseHeaps(
+    uint64_t maxUsedSize) const {
+    std::vector<const ResourceHeapBase*> heaps;
+    for (const TrackedSubAllocations& allocation : mTrackedSubAllocations) {
+        if (allocation.refcount > 0 && allocation.usedSize <= maxUsedSize) {
+            heaps.push_back(allocation.mMemoryAllocation.get());
+        }
+    }
+    return heaps;
+}
+
 uint64_t BuddyMemoryAllocator::ComputeTotalNumOfHeapsForTesting() const {
     uint64_t count = 0;
     for (const TrackedSubAllocations& allocation : mTrackedSubAllocations) {
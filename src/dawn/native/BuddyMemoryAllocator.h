@@ -63,6 +63,22 @@ class BuddyMemoryAllocator {
 
     uint64_t GetMemoryBlockSize() const;
 
+    // The number of heaps backing sub-allocations, and the total size of the blocks sub-allocated
+    // in them. Blocks are rounded up to a power of two so this is at least the requested size.
+    uint64_t GetHeapCount() const;
+    uint64_t GetUsedSize() const;
+
+    // Returns the total size of the blocks sub-allocated in the heap that contains `allocation`.
+    uint64_t GetHeapUsedSize(const ResourceMemoryAllocation& allocation) const;
+
+    // Returns the number of blocks sub-allocated in the heap that contains `allocation`.
+    uint64_t GetHeapSubAllocationCount(const ResourceMemoryAllocation& allocation) const;
+
+    // Returns the number of heaps in which at most `maxUsedSize` bytes are sub-allocated, and
+    // these heaps.
+    uint64_t ComputeSparseHeapCount(uint64_t maxUsedSize) const;
+    std::vector<const ResourceHeapBase*> GetSparseHeaps(uint64_t maxUsedSize) const;
+
     // For testing purposes.
     uint64_t ComputeTotalNumOfHeapsForTesting() const;
 
@@ -76,10 +92,14 @@ class BuddyMemoryAllocator {
 
     struct TrackedSubAllocations {
         size_t refcount = 0;
+        uint64_t usedSize = 0;
         std::unique_ptr<ResourceHeapBase> mMemoryAllocation;
     };
 
     std::vector<TrackedSubAllocations> mTrackedSubAllocations;
+
+    uint64_t mHeapCount = 0;
+    uint64_t mUsedSize = 0;
 };
 
 }  // namespace dawn::native
@@ -27,6 +27,7 @@
 
 #include "dawn/native/Buffer.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <limits>
@@ -1088,17 +1089,35 @@ MaybeError BufferBase::UploadData(uint64_t bufferOffset, const void* data, size_
     }
 
     DeviceBase* device = GetDevice();
+    DynamicUploader* uploader = device->GetDynamicUploader();
 
-    UploadHandle uploadHandle;
-    DAWN_TRY_ASSIGN(uploadHandle, device->GetDynamicUploader()->Allocate(
-                                      size, device->GetQueue()->GetPendingCommandSerial(),
-                                      kCopyBufferToBufferOffsetAlignment));
-    DAWN_ASSERT(uploadHandle.mappedBuffer != nullptr);
+    // Large uploads are split in chunks that are copied by the GPU while the next ones are
+    // written.
+    const uint8_t* srcPointer = static_cast<const uint8_t*>(data);
+    uint64_t remainingSize = size;
+    while (true) {
+        uint64_t chunkSize = std::min(remainingSize, DynamicUploader::kUploadChunkSize);
 
-    memcpy(uploadHandle.mappedBuffer, data, size);
+        UploadHandle uploadHandle;
+        DAWN_TRY_ASSIGN(uploadHandle, uploader->Allocate(
+                                          chunkSize, device->GetQueue()->GetPendingCommandSerial(),
+                                          kCopyBufferToBufferOffsetAlignment));
+        DAWN_ASSERT(uploadHandle.mappedBuffer != nullptr);
 
-    return device->CopyFromStagingToBuffer(uploadHandle.stagingBuffer, uploadHandle.startOffset,
-                                           this, bufferOffset, size);
+        memcpy(uploadHandle.mappedBuffer, srcPointer, chunkSize);
+
+        DAWN_TRY(device->CopyFromStagingToBuffer(uploadHandle.stagingBuffer,
+                                                 uploadHandle.startOffset, this, bufferOffset,
+                                                 chunkSize));
+
+        remainingSize -= chunkSize;
+        if (remainingSize == 0) {
+            return {};
+        }
+        srcPointer += chunkSize;
+        bufferOffset += chunkSize;
+        DAWN_TRY(uploader->OnUploadChunkRecorded());
+    }
 }
 
 ExecutionSerial BufferBase::OnEndAccess() {
@@ -77,40 +77,61 @@ void CallbackTask::OnDeviceLoss() {
 
 CallbackTaskManager::CallbackTaskManager() = default;
 
-CallbackTaskManager::~CallbackTaskManager() = default;
+CallbackTaskManager::~CallbackTaskManager() {
+    LinkedList<CallbackTask> allTasks;
+    mStateAndQueue.Use([&](auto stateAndQueue) { stateAndQueue->mTaskQueue.MoveInto(&allTasks); });
+    ReleaseTasks(&allTasks);
+}
 
 bool CallbackTaskManager::IsEmpty() {
     return mStateAndQueue.Use([](auto stateAndQueue) { return stateAndQueue->mTaskQueue.empty(); });
 }
 
+// static
+void CallbackTaskManager::EnqueueTask(StateAndQueue* stateAndQueue, CallbackTask* task) {
+    switch (stateAndQueue->mState) {
+        case CallbackState::ShutDown:
+            task->OnShutDown();
+            break;
+        case CallbackState::DeviceLoss:
+            task->OnDeviceLoss();
+            break;
+        default:
+            break;
+    }
+    stateAndQueue->mTaskQueue.Append(task);
+}
+
 void CallbackTaskManager::AddCallbackTask(std::unique_ptr<CallbackTask> callbackTask) {
-    mStateAndQueue.Use([&](auto stateAndQueue) {
-        switch (stateAndQueue->mState) {
-            case CallbackState::ShutDown:
-                callbackTask->OnShutDown();
-                break;
-            case CallbackState::DeviceLoss:
-                callbackTask->OnDeviceLoss();
-                break;
-            default:
-                break;
-        }
-        stateAndQueue->mTaskQueue.push_back(std::move(callbackTask));
-    });
+    mStateAndQueue.Use(
+        [&](auto stateAndQueue) { EnqueueTask(&*stateAndQueue, callbackTask.release()); });
 }
 
 void CallbackTaskManager::AddCallbackTask(std::function<void()> callback) {
     AddCallbackTask(std::make_unique<GenericFunctionTask>(std::move(callback)));
 }
 
+void CallbackTaskManager::AddCallbackTasks(LinkedList<CallbackTask>* tasks) {
+    if (tasks->empty()) {
+        return;
+    }
+
+    mStateAndQueue.Use([&](auto stateAndQueue) {
+        for (LinkNode<CallbackTask>* node : *tasks) {
+            node->RemoveFromList();
+            EnqueueTask(&*stateAndQueue, node->value());
+        }
+    });
+}
+
 void CallbackTaskManager::HandleDeviceLoss() {
     mStateAndQueue.Use([&](auto stateAndQueue) {
         if (stateAndQueue->mState != CallbackState::Normal) {
             return;
         }
         stateAndQueue->mState = CallbackState::DeviceLoss;
-        for (auto& task : stateAndQueue->mTaskQueue) {
-            task->OnDeviceLoss();
+        for (LinkNode<CallbackTask>* node : stateAndQueue->mTaskQueue) {
+            node->value()->OnDeviceLoss();
         }
     });
 }
@@ -121,8 +142,8 @@ void CallbackTaskManager::HandleShutDown() {
             return;
         }
         stateAndQueue->mState = CallbackState::ShutDown;
-        for (auto& task : stateAndQueue->mTaskQueue) {
-            task->OnShutDown();
+        for (LinkNode<CallbackTask>* node : stateAndQueue->mTaskQueue) {
+            node->value()->OnShutDown();
         }
     });
 }
@@ -136,12 +157,36 @@ void CallbackTaskManager::Flush() {
     // which in turns ticks the tracker, causing reentrance and dead lock here. To prevent
     // such reentrant call, we remove all the callback tasks from mCallbackTaskManager,
     // update mCallbackTaskManager, then call all the callbacks.
-    std::vector<std::unique_ptr<CallbackTask>> allTasks;
-    mStateAndQueue.Use([&](auto stateAndQueue) { allTasks.swap(stateAndQueue->mTaskQueue); });
+    LinkedList<CallbackTask> allTasks;
+    mStateAndQueue.Use([&](auto stateAndQueue) { stateAndQueue->mTaskQueue.MoveInto(&allTasks); });
 
-    for (auto& callbackTask : allTasks) {
-        callbackTask->Execute();
+    for (LinkNode<CallbackTask>* node : allTasks) {
+        node->value()->Execute();
     }
+    ReleaseTasks(&allTasks);
+}
+
+void CallbackTaskManager::ReleaseTasks(LinkedList<CallbackTask>* tasks) {
+    // Tasks from the heap are deleted without holding the lock because their destructor may drop
+    // the last reference to objects that add more callback tasks. Deleting them also removes them
+    // from |tasks|.
+    for (LinkNode<CallbackTask>* node : *tasks) {
+        if (!node->value()->mIsPooled) {
+            delete node->value();
+        }
+    }
+    if (tasks->empty()) {
+        return;
+    }
+
+    // Only pooled tasks are left, they are all returned to the pool at once.
+    mStateAndQueue.Use([&](auto stateAndQueue) {
+        for (LinkNode<CallbackTask>* node : *tasks) {
+            PooledFunctionTask* task = static_cast<PooledFunctionTask*>(node->value());
+            task->~PooledFunctionTask();
+            stateAndQueue->mTaskPool.Deallocate(task);
+        }
+    });
 }
 
 }  // namespace dawn::native
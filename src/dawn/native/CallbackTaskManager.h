@@ -28,13 +28,20 @@
 #ifndef SRC_DAWN_NATIVE_CALLBACKTASKMANAGER_H_
 #define SRC_DAWN_NATIVE_CALLBACKTASKMANAGER_H_
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "dawn/common/LinkedList.h"
 #include "dawn/common/MutexProtected.h"
 #include "dawn/common/RefCounted.h"
+#include "dawn/common/SlabAllocator.h"
 #include "dawn/common/TypeTraits.h"
 
 namespace dawn::native {
@@ -45,7 +52,9 @@ enum class CallbackState {
     DeviceLoss,
 };
 
-struct CallbackTask {
+// CallbackTasks are linked intrusively in the queue of the CallbackTaskManager so that adding one
+// doesn't allocate and that a whole queue can be handed off by swapping a couple of pointers.
+struct CallbackTask : public LinkNode<CallbackTask> {
   public:
     virtual ~CallbackTask() = default;
 
@@ -59,7 +68,40 @@ struct CallbackTask {
     virtual void HandleDeviceLossImpl() = 0;
 
   private:
+    friend class CallbackTaskManager;
+
     CallbackState mState = CallbackState::Normal;
+    // Whether the task is allocated out of the pool of its CallbackTaskManager instead of the heap.
+    bool mIsPooled = false;
+};
+
+// A CallbackTask calling a function pointer with a few trivially destructible arguments. They are
+// used for the common case of calling a C callback and its userdata so that adding such a callback
+// reuses the storage of previous ones.
+class PooledFunctionTask final : public CallbackTask {
+  public:
+    static constexpr size_t kStorageSize = 4 * sizeof(void*);
+
+    template <typename Call>
+    static constexpr bool CanHold() {
+        return sizeof(Call) <= kStorageSize && alignof(Call) <= alignof(std::max_align_t) &&
+               std::is_trivially_destructible_v<Call>;
+    }
+
+    template <typename Call, typename... Args>
+    void Emplace(Args&&... args) {
+        static_assert(CanHold<Call>());
+        new (mStorage) Call{std::forward<Args>(args)...};
+        mInvoke = [](const void* storage) { (*static_cast<const Call*>(storage))(); };
+    }
+
+  private:
+    void FinishImpl() override { mInvoke(mStorage); }
+    void HandleShutDownImpl() override { mInvoke(mStorage); }
+    void HandleDeviceLossImpl() override { mInvoke(mStorage); }
+
+    void (*mInvoke)(const void* storage) = nullptr;
+    alignas(std::max_align_t) char mStorage[kStorageSize];
 };
 
 class CallbackTaskManager : public RefCounted {
@@ -73,18 +115,57 @@ class CallbackTaskManager : public RefCounted {
     void AddCallbackTask(void (*callback)(Args... args), Args... args) {
         static_assert((!IsCString<Args>::value && ...), "passing C string argument is not allowed");
 
-        AddCallbackTask([=] { callback(args...); });
+        using Call = FunctionPointerCall<Args...>;
+        if constexpr (PooledFunctionTask::CanHold<Call>()) {
+            mStateAndQueue.Use([&](auto stateAndQueue) {
+                PooledFunctionTask* task = stateAndQueue->mTaskPool.Allocate();
+                task->mIsPooled = true;
+                task->Emplace<Call>(callback, std::make_tuple(args...));
+                EnqueueTask(&*stateAndQueue, task);
+            });
+        } else {
+            AddCallbackTask([=] { callback(args...); });
+        }
+    }
+    // Adds all of |tasks| at once, in order, acquiring the lock a single time.
+    template <typename T>
+    void AddCallbackTasks(std::vector<std::unique_ptr<T>> tasks) {
+        LinkedList<CallbackTask> batch;
+        for (std::unique_ptr<T>& task : tasks) {
+            batch.Append(task.release());
+        }
+        AddCallbackTasks(&batch);
     }
+    void AddCallbackTasks(LinkedList<CallbackTask>* tasks);
     bool IsEmpty();
     void HandleDeviceLoss();
     void HandleShutDown();
     void Flush();
 
   private:
+    template <typename... Args>
+    struct FunctionPointerCall {
+        void operator()() const { std::apply(callback, args); }
+
+        void (*callback)(Args...);
+        std::tuple<Args...> args;
+    };
+
+    // The number of PooledFunctionTasks allocated at once when the pool is exhausted.
+    static constexpr size_t kPooledTasksPerSlab = 64;
+
     struct StateAndQueue {
         CallbackState mState = CallbackState::Normal;
-        std::vector<std::unique_ptr<CallbackTask>> mTaskQueue;
+        LinkedList<CallbackTask> mTaskQueue;
+        SlabAllocator<PooledFunctionTask> mTaskPool{kPooledTasksPerSlab *
+                                                    sizeof(PooledFunctionTask)};
     };
+
+    // Appends |task| to the queue, updating it for the current state. Requires the lock.
+    static void EnqueueTask(StateAndQueue* stateAndQueue, CallbackTask* task);
+    // Deletes the tasks of |tasks| and returns the pooled ones to the pool.
+    void ReleaseTasks(LinkedList<CallbackTask>* tasks);
+
     MutexProtected<StateAndQueue> mStateAndQueue;
 };
 
@@ -28,15 +28,204 @@
 #include "dawn/native/CommandAllocator.h"
 
 #include <algorithm>
+#include <array>
 #include <climits>
 #include <cstdlib>
+#include <new>
 #include <utility>
 
 #include "dawn/common/Assert.h"
 #include "dawn/common/Math.h"
+#include "dawn/common/MutexProtected.h"
 
 namespace dawn::native {
 
+namespace {
+
+// Command blocks are recycled instead of being freed, so that encoders recording on several
+// threads at once don't all contend on the system allocator for their blocks. Each thread keeps a
+// small cache of free blocks, and moves blocks in batches to and from a pool shared by all the
+// threads. The shared pool is what lets blocks freed on one thread (for example when command
+// buffers are submitted) be reused by encoders on other threads.
+//
+// Only the block sizes produced by the doubling policy of CommandAllocator::GetNewBlock are
+// recycled. Larger blocks hold a single large command and are freed directly.
+//
+// The shared pool holds at most kSharedPoolCapacity blocks of each size, and TrimCommandBlockPool
+// frees the ones that stayed unused between two calls. The device calls it when it is idle, so
+// that a burst of encoding doesn't keep its blocks alive for the rest of the process.
+constexpr size_t kMinPooledBlockSize = 4096;
+constexpr size_t kMaxPooledBlockSize = 16384;
+constexpr size_t kPooledBlockSizeCount =
+    ConstexprLog2(kMaxPooledBlockSize) - ConstexprLog2(kMinPooledBlockSize) + 1;
+
+// The number of free blocks of each size that a thread keeps. When a thread's cache is full, half
+// of it is moved to the shared pool. When it is empty, it is refilled with up to half of its
+// capacity from the shared pool.
+constexpr size_t kThreadCacheCapacity = 16;
+// The number of free blocks of each size that are kept in the shared pool. Blocks released to a
+// full shared pool are freed.
+constexpr size_t kSharedPoolCapacity = 128;
+
+// Returns the index of the pooled size of |size|, or kPooledBlockSizeCount if blocks of that size
+// are not recycled.
+size_t GetPooledBlockSizeIndex(size_t size) {
+    if (size < kMinPooledBlockSize || size > kMaxPooledBlockSize || !IsPowerOfTwo(size)) {
+        return kPooledBlockSizeCount;
+    }
+    return Log2(static_cast<uint64_t>(size)) - ConstexprLog2(kMinPooledBlockSize);
+}
+
+class SharedBlockPool {
+  public:
+    // Moves up to |count| free blocks of the pooled size |sizeIndex| to |blocks|, and returns the
+    // number of blocks moved.
+    size_t Acquire(size_t sizeIndex, char** blocks, size_t count) {
+        return mFreeBlocks.Use([&](auto freeBlocks) {
+            FreeBlocksOfSize& freeBlocksOfSize = (*freeBlocks)[sizeIndex];
+            std::vector<std::unique_ptr<char[]>>& pooledBlocks = freeBlocksOfSize.blocks;
+            size_t acquired = std::min(count, pooledBlocks.size());
+            for (size_t i = 0; i < acquired; i++) {
+                blocks[i] = pooledBlocks.back().release();
+                pooledBlocks.pop_back();
+            }
+            freeBlocksOfSize.unusedCount =
+                std::min(freeBlocksOfSize.unusedCount, pooledBlocks.size());
+            return acquired;
+        });
+    }
+
+    // Takes ownership of the |count| blocks of the pooled size |sizeIndex| in |blocks|.
+    void Release(size_t sizeIndex, char* const* blocks, size_t count) {
+        mFreeBlocks.Use([&](auto freeBlocks) {
+            std::vector<std::unique_ptr<char[]>>& pooledBlocks = (*freeBlocks)[sizeIndex].blocks;
+            for (size_t i = 0; i < count; i++) {
+                if (pooledBlocks.size() < kSharedPoolCapacity) {
+                    pooledBlocks.emplace_back(blocks[i]);
+                } else {
+                    delete[] blocks[i];
+                }
+            }
+        });
+    }
+
+    // Frees the blocks that weren't acquired since the previous call, or all of them.
+    void Trim(bool freeAll) {
+        mFreeBlocks.Use([&](auto freeBlocks) {
+            for (FreeBlocksOfSize& freeBlocksOfSize : *freeBlocks) {
+                std::vector<std::unique_ptr<char[]>>& pooledBlocks = freeBlocksOfSize.blocks;
+                // Blocks are acquired from the back, so the unused ones are at the front.
+                size_t freedCount = freeAll ? pooledBlocks.size() : freeBlocksOfSize.unusedCount;
+                pooledBlocks.erase(pooledBlocks.begin(), pooledBlocks.begin() + freedCount);
+                freeBlocksOfSize.unusedCount = pooledBlocks.size();
+            }
+        });
+    }
+
+    size_t GetSize() {
+        return mFreeBlocks.Use([&](auto freeBlocks) {
+            size_t size = 0;
+            for (size_t sizeIndex = 0; sizeIndex < kPooledBlockSizeCount; sizeIndex++) {
+                size += (*freeBlocks)[sizeIndex].blocks.size() * (kMinPooledBlockSize << sizeIndex);
+            }
+            return size;
+        });
+    }
+
+  private:
+    struct FreeBlocksOfSize {
+        std::vector<std::unique_ptr<char[]>> blocks;
+        // The smallest number of blocks in the pool since the last trim.
+        size_t unusedCount = 0;
+    };
+    MutexProtected<std::array<FreeBlocksOfSize, kPooledBlockSizeCount>> mFreeBlocks;
+};
+
+SharedBlockPool& GetSharedBlockPool() {
+    // Never destroyed, so that it outlives all the thread caches regardless of the order in which
+    // threads exit and static objects are destroyed. Its blocks are freed by TrimCommandBlockPool.
+    static SharedBlockPool* pool = new SharedBlockPool();
+    return *pool;
+}
+
+class ThreadBlockCache {
+  public:
+    // Runs when the thread exits, possibly after the static objects are destroyed, which is fine
+    // since the shared pool is never destroyed.
+    ~ThreadBlockCache() { ReleaseAll(); }
+
+    std::unique_ptr<char[]> Acquire(size_t size) {
+        size_t sizeIndex = GetPooledBlockSizeIndex(size);
+        if (sizeIndex == kPooledBlockSizeCount) {
+            return std::unique_ptr<char[]>(new (std::nothrow) char[size]);
+        }
+
+        size_t& count = mCounts[sizeIndex];
+        if (count == 0) {
+            count = GetSharedBlockPool().Acquire(sizeIndex, mFreeBlocks[sizeIndex].data(),
+                                                 kThreadCacheCapacity / 2);
+            if (count == 0) {
+                return std::unique_ptr<char[]>(new (std::nothrow) char[size]);
+            }
+        }
+        count--;
+        return std::unique_ptr<char[]>(mFreeBlocks[sizeIndex][count]);
+    }
+
+    void Release(BlockDef block) {
+        size_t sizeIndex = GetPooledBlockSizeIndex(block.size);
+        if (sizeIndex == kPooledBlockSizeCount) {
+            return;
+        }
+
+        size_t& count = mCounts[sizeIndex];
+        if (count == kThreadCacheCapacity) {
+            count -= kThreadCacheCapacity / 2;
+            GetSharedBlockPool().Release(sizeIndex, &mFreeBlocks[sizeIndex][count],
+                                         kThreadCacheCapacity / 2);
+        }
+        mFreeBlocks[sizeIndex][count] = block.block.release();
+        count++;
+    }
+
+    // Moves all the cached blocks to the shared pool.
+    void ReleaseAll() {
+        for (size_t sizeIndex = 0; sizeIndex < kPooledBlockSizeCount; sizeIndex++) {
+            GetSharedBlockPool().Release(sizeIndex, mFreeBlocks[sizeIndex].data(),
+                                         mCounts[sizeIndex]);
+            mCounts[sizeIndex] = 0;
+        }
+    }
+
+  private:
+    // Raw pointers so that the cache is constant-initialized.
+    std::array<std::array<char*, kThreadCacheCapacity>, kPooledBlockSizeCount> mFreeBlocks = {};
+    std::array<size_t, kPooledBlockSizeCount> mCounts = {};
+};
+
+thread_local ThreadBlockCache tlBlockCache;
+
+// Returns all the blocks in |blocks| to the pool, and clears it.
+void ReleaseCommandBlocks(CommandBlocks* blocks) {
+    for (BlockDef& block : *blocks) {
+        tlBlockCache.Release(std::move(block));
+    }
+    blocks->clear();
+}
+
+}  // anonymous namespace
+
+void TrimCommandBlockPool(bool freeAll) {
+    if (freeAll) {
+        tlBlockCache.ReleaseAll();
+    }
+    GetSharedBlockPool().Trim(freeAll);
+}
+
+size_t GetCommandBlockPoolSizeForTesting() {
+    return GetSharedBlockPool().GetSize();
+}
+
 // TODO(cwallez@chromium.org): figure out a way to have more type safety for the iterator
 
 CommandIterator::CommandIterator() {
@@ -113,13 +302,22 @@ void CommandIterator::Reset() {
     }
 }
 
+CommandIterator::Position CommandIterator::GetPosition() const {
+    return {mCurrentPtr, mCurrentBlock};
+}
+
+void CommandIterator::SetPosition(const Position& position) {
+    mCurrentPtr = position.ptr;
+    mCurrentBlock = position.block;
+}
+
 void CommandIterator::MakeEmptyAsDataWasDestroyed() {
     if (IsEmpty()) {
         return;
     }
 
     mCurrentPtr = reinterpret_cast<char*>(&mEndOfBlock);
-    mBlocks.clear();
+    ReleaseCommandBlocks(&mBlocks);
     Reset();
     DAWN_ASSERT(IsEmpty());
 }
@@ -172,7 +370,7 @@ CommandAllocator& CommandAllocator::operator=(CommandAllocator&& other) {
 
 void CommandAllocator::Reset() {
     ResetPointers();
-    mBlocks.clear();
+    ReleaseCommandBlocks(&mBlocks);
     mLastAllocationSize = kDefaultBaseAllocationSize;
 }
 
@@ -220,9 +418,10 @@ char* CommandAllocator::AllocateInNewBlock(uint32_t commandId,
 
 bool CommandAllocator::GetNewBlock(size_t minimumSize) {
     // Allocate blocks doubling sizes each time, to a maximum of 16k (or at least minimumSize).
-    mLastAllocationSize = std::max(minimumSize, std::min(mLastAllocationSize * 2, size_t(16384)));
+    mLastAllocationSize =
+        std::max(minimumSize, std::min(mLastAllocationSize * 2, kMaxPooledBlockSize));
 
-    auto block = std::unique_ptr<char[]>(new (std::nothrow) char[mLastAllocationSize]);
+    auto block = tlBlockCache.Acquire(mLastAllocationSize);
     if (DAWN_UNLIKELY(block == nullptr)) {
         return false;
     }
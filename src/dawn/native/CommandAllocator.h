@@ -77,6 +77,13 @@ struct BlockDef {
 };
 using CommandBlocks = std::vector<BlockDef>;
 
+// Freed command blocks are kept in a pool shared by all the threads so that they can be reused.
+// Frees the pooled blocks that weren't reused since the previous call, or all of them if |freeAll|
+// is true, including the ones cached by the calling thread.
+void TrimCommandBlockPool(bool freeAll = false);
+// The total size of the blocks in the shared pool.
+size_t GetCommandBlockPoolSizeForTesting();
+
 namespace detail {
 constexpr uint32_t kEndOfBlock = std::numeric_limits<uint32_t>::max();
 constexpr uint32_t kAdditionalData = std::numeric_limits<uint32_t>::max() - 1;
@@ -114,6 +121,16 @@ class CommandIterator : public NonCopyable {
     // be used if iteration was stopped early and the iterator needs to be restarted.
     void Reset();
 
+    // A position in the commands. It can be used to look ahead at the next commands and then
+    // continue the iteration from where it was.
+    struct Position {
+        // RAW_PTR_EXCLUSION: Same as mCurrentPtr.
+        RAW_PTR_EXCLUSION char* ptr = nullptr;
+        size_t block = 0;
+    };
+    Position GetPosition() const;
+    void SetPosition(const Position& position);
+
     // This method must to be called after commands have been deleted. This indicates that the
     // commands have been submitted and they are no longer valid.
     void MakeEmptyAsDataWasDestroyed();
@@ -176,7 +176,22 @@ void CreatePipelineAsyncEvent<PipelineType, CreatePipelineAsyncCallbackInfo>::In
                             "CreatePipelineAsyncEvent::InitializeAsync", this, "label", eventLabel);
 
     auto asyncTask = [event = Ref<CreatePipelineAsyncEvent>(this)] { event->InitializeImpl(true); };
-    device->GetAsyncTaskManager()->PostTask(std::move(asyncTask));
+    auto cancelTask = [event = Ref<CreatePipelineAsyncEvent>(this)] { event->CancelAsync(); };
+    device->GetAsyncTaskManager()->PostTask(std::move(asyncTask), std::move(cancelTask),
+                                            dawn::platform::WorkerTaskPriority::High);
+}
+
+template <typename PipelineType, typename CreatePipelineAsyncCallbackInfo>
+void CreatePipelineAsyncEvent<PipelineType, CreatePipelineAsyncCallbackInfo>::CancelAsync() {
+    DeviceBase* device = mPipeline->GetDevice();
+    TRACE_EVENT_FLOW_END1(device->GetPlatform(), General,
+                          "CreatePipelineAsyncEvent::InitializeAsync", this, "label",
+                          utils::GetLabelForTrace(mPipeline->GetLabel()));
+
+    // The pipeline is never initialized, Complete() resolves it as an error pipeline the same way
+    // as for a lost device.
+    mCancelled = true;
+    device->GetInstance()->GetEventManager()->SetFutureReady(this);
 }
 
 template <typename PipelineType, typename CreatePipelineAsyncCallbackInfo>
@@ -196,7 +211,7 @@ void CreatePipelineAsyncEvent<PipelineType, CreatePipelineAsyncCallbackInfo>::Co
     DeviceBase* device = mPipeline->GetDevice();
     // TODO(dawn:2353): Device losts later than this check could potentially lead to racing
     // condition.
-    if (device->IsLost()) {
+    if (mCancelled || device->IsLost()) {
         // Invalid async creation should "succeed" if the device is already lost.
         if (!mPipeline->IsError()) {
             mPipeline = PipelineType::MakeError(device, mPipeline->GetLabel().c_str());
@@ -90,6 +90,9 @@ class CreatePipelineAsyncEvent final : public EventManager::TrackedEvent {
     // Body of pipeline initialization, called synchronously, or wrapped in an AsyncTask run by
     // AsyncTaskManager.
     void InitializeImpl(bool isAsync);
+    // Called instead of InitializeImpl when the AsyncTask is cancelled before it started because
+    // the device is being destroyed or lost.
+    void CancelAsync();
 
     CallbackType mCallback;
     raw_ptr<void> mUserdata1;
@@ -98,6 +101,7 @@ class CreatePipelineAsyncEvent final : public EventManager::TrackedEvent {
     // Pipeline::MakeError. So we need to hold the pipeline and the error separately.
     Ref<PipelineType> mPipeline;
     std::unique_ptr<ErrorData> mError;
+    bool mCancelled = false;
     // Used to keep ShaderModuleBase::mTintProgram alive until pipeline initialization is done.
     PipelineBase::ScopedUseShaderPrograms mScopedUseShaderPrograms;
 };
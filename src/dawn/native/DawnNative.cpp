@@ -225,6 +225,10 @@ size_t GetLazyClearCountForTesting(WGPUDevice device) {
     return FromAPI(device)->GetLazyClearCountForTesting();
 }
 
+ShaderModuleCacheStats GetShaderModuleCacheStats(WGPUDevice device) {
+    return FromAPI(device)->GetShaderModuleCacheStats();
+}
+
 bool IsTextureSubresourceInitialized(WGPUTexture texture,
                                      uint32_t baseMipLevel,
                                      uint32_t levelCount,
@@ -312,6 +316,11 @@ void ReduceMemoryUsage(WGPUDevice device) {
     FromAPI(device)->ReduceMemoryUsage();
 }
 
+ResourceMemoryStats GetResourceMemoryStats(WGPUDevice device) {
+    auto deviceLock(FromAPI(device)->GetScopedLock());
+    return FromAPI(device)->GetResourceMemoryStats();
+}
+
 void PerformIdleTasks(const wgpu::Device& device) {
     auto* deviceBase = FromAPI(device.Get());
     auto deviceLock(deviceBase->GetScopedLock());
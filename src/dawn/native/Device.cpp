@@ -32,14 +32,18 @@
 #include <algorithm>
 #include <array>
 #include <mutex>
+#include <string_view>
 #include <utility>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/str_format.h"
 #include "dawn/common/Log.h"
+#include "dawn/common/MutexProtected.h"
 #include "dawn/common/Ref.h"
 #include "dawn/common/StringViewUtils.h"
 #include "dawn/common/Version_autogen.h"
+#include "dawn/common/WeakRef.h"
 #include "dawn/native/AsyncTask.h"
 #include "dawn/native/AttachmentState.h"
 #include "dawn/native/BindGroup.h"
@@ -48,6 +52,7 @@
 #include "dawn/native/BlobCache.h"
 #include "dawn/native/Buffer.h"
 #include "dawn/native/ChainUtils.h"
+#include "dawn/native/CommandAllocator.h"
 #include "dawn/native/CommandBuffer.h"
 #include "dawn/native/CommandEncoder.h"
 #include "dawn/native/CompilationMessages.h"
@@ -66,6 +71,7 @@
 #include "dawn/native/PipelineCache.h"
 #include "dawn/native/QuerySet.h"
 #include "dawn/native/Queue.h"
+#include "dawn/native/RenderBundle.h"
 #include "dawn/native/RenderBundleEncoder.h"
 #include "dawn/native/RenderPipeline.h"
 #include "dawn/native/Sampler.h"
@@ -94,6 +100,17 @@ struct DeviceBase::Caches {
     ContentLessObjectCache<RenderPipelineBase> renderPipelines;
     ContentLessObjectCache<SamplerBase> samplers;
     ContentLessObjectCache<ShaderModuleBase> shaderModules;
+
+    // Second level of the shader module cache, keyed by the canonical program of the modules.
+    // The keys point into the modules' GetCanonicalProgramKey() and the modules remove themselves
+    // when they are destroyed.
+    MutexProtected<absl::flat_hash_map<std::string_view, WeakRef<ShaderModuleBase>>>
+        shaderModulesByProgram;
+    // Descriptor contents that were resolved to a module with another content by the second
+    // level, so that they hit without parsing again. The modules keep the list of their aliases
+    // and remove them when they are destroyed.
+    MutexProtected<absl::flat_hash_map<std::string, WeakRef<ShaderModuleBase>>>
+        shaderModulesByContentAlias;
 };
 
 // Tries to find an object in the cache, creating and inserting into the cache if not found.
@@ -630,9 +647,9 @@ void DeviceBase::Destroy() {
             mLostEvent = nullptr;
         }
 
-        // Call all the callbacks immediately as the device is about to shut down.
-        // TODO(crbug.com/dawn/826): Cancel the tasks that are in flight if possible.
-        mAsyncTaskManager->WaitAllPendingTasks();
+        // Call all the callbacks immediately as the device is about to shut down. Tasks that
+        // haven't started yet are cancelled instead of being run for nothing.
+        mAsyncTaskManager->CancelAndWaitAllPendingTasks();
         mCallbackTaskManager->HandleShutDown();
     }
 
@@ -777,8 +794,7 @@ void DeviceBase::HandleError(std::unique_ptr<ErrorData> error,
 
         mQueue->HandleDeviceLoss();
 
-        // TODO(crbug.com/dawn/826): Cancel the tasks that are in flight if possible.
-        mAsyncTaskManager->WaitAllPendingTasks();
+        mAsyncTaskManager->CancelAndWaitAllPendingTasks();
         mCallbackTaskManager->HandleDeviceLoss();
 
         // Still forward device loss errors to the error scopes so they all reject.
@@ -1221,8 +1237,43 @@ ResultOrError<Ref<ShaderModuleBase>> DeviceBase::GetOrCreateShaderModule(
     const size_t blueprintHash = blueprint.ComputeContentHash();
     blueprint.SetContentHash(blueprintHash);
 
+    // Maps the content of the descriptor to |module|, which has the same canonical program.
+    auto AddContentAlias = [&](ShaderModuleBase* module, std::string aliasKey) {
+        if (aliasKey.empty()) {
+            return;
+        }
+        mCaches->shaderModulesByContentAlias.Use([&](auto aliases) {
+            auto [it, inserted] = aliases->try_emplace(aliasKey, GetWeakRef(module));
+            if (!inserted) {
+                // The alias can only be stale, as a live one would have been found before.
+                it->second = GetWeakRef(module);
+            }
+            module->GetContentAliasKeys().push_back(std::move(aliasKey));
+        });
+    };
+
+    mShaderModuleLookupCount++;
     return GetOrCreate(
         mCaches->shaderModules, &blueprint, [&]() -> ResultOrError<Ref<ShaderModuleBase>> {
+            // The descriptor content may have been mapped to a module with the same canonical
+            // program by a previous lookup.
+            std::string aliasKey;
+            if (IsToggleEnabled(Toggle::DedupShaderModulesByProgram)) {
+                aliasKey = blueprint.ComputeContentAliasKey();
+            }
+            if (!aliasKey.empty()) {
+                Ref<ShaderModuleBase> aliased = mCaches->shaderModulesByContentAlias.Use(
+                    [&](auto aliases) -> Ref<ShaderModuleBase> {
+                        auto it = aliases->find(aliasKey);
+                        return it != aliases->end() ? it->second.Promote() : nullptr;
+                    });
+                if (aliased != nullptr) {
+                    return aliased;
+                }
+            }
+
+            mShaderModuleContentMissCount++;
+
             auto* unownedMessages = compilationMessages ? compilationMessages->get() : nullptr;
             if (!parseResult->HasParsedShader()) {
                 // We skip the parse on creation if validation isn't enabled which let's us quickly
@@ -1233,6 +1284,28 @@ ResultOrError<Ref<ShaderModuleBase>> DeviceBase::GetOrCreateShaderModule(
                                                       parseResult, unownedMessages));
             }
 
+            // Look for a module with the same canonical program. Shaders with compilation
+            // messages are skipped, as sharing a module would return the messages of another
+            // shader.
+            std::string programKey;
+            if (IsToggleEnabled(Toggle::DedupShaderModulesByProgram) &&
+                (unownedMessages == nullptr || !unownedMessages->HasWarningsOrErrors())) {
+                programKey =
+                    blueprint.ComputeCanonicalProgramKey(parseResult->tintProgram->program);
+            }
+            if (!programKey.empty()) {
+                Ref<ShaderModuleBase> existing = mCaches->shaderModulesByProgram.Use(
+                    [&](auto modules) -> Ref<ShaderModuleBase> {
+                        auto it = modules->find(programKey);
+                        return it != modules->end() ? it->second.Promote() : nullptr;
+                    });
+                if (existing != nullptr) {
+                    mShaderModuleProgramHitCount++;
+                    AddContentAlias(existing.Get(), std::move(aliasKey));
+                    return existing;
+                }
+            }
+
             auto resultOrError = [&]() -> ResultOrError<Ref<ShaderModuleBase>> {
                 SCOPED_DAWN_HISTOGRAM_TIMER_MICROS(GetPlatform(), "CreateShaderModuleUS");
                 return CreateShaderModuleImpl(descriptor, internalExtensions, parseResult,
@@ -1249,10 +1322,66 @@ ResultOrError<Ref<ShaderModuleBase>> DeviceBase::GetOrCreateShaderModule(
             if (compilationMessages) {
                 result->InjectCompilationMessages(std::move(*compilationMessages));
             }
+
+            if (!programKey.empty()) {
+                result->SetCanonicalProgramKey(std::move(programKey));
+                // Another thread may have created a module with the same program in the meantime,
+                // in which case it is returned instead.
+                Ref<ShaderModuleBase> existing = mCaches->shaderModulesByProgram.Use(
+                    [&](auto modules) -> Ref<ShaderModuleBase> {
+                        auto [it, inserted] = modules->try_emplace(
+                            result->GetCanonicalProgramKey(), GetWeakRef(result.Get()));
+                        if (inserted) {
+                            return nullptr;
+                        }
+                        Ref<ShaderModuleBase> existingModule = it->second.Promote();
+                        if (existingModule == nullptr) {
+                            // The cached module is being destroyed, replace it. The key is
+                            // re-inserted because it points into the destroyed module.
+                            modules->erase(it);
+                            modules->emplace(result->GetCanonicalProgramKey(),
+                                             GetWeakRef(result.Get()));
+                        }
+                        return existingModule;
+                    });
+                if (existing != nullptr) {
+                    mShaderModuleProgramHitCount++;
+                    AddContentAlias(existing.Get(), std::move(aliasKey));
+                    return existing;
+                }
+            }
             return result;
         });
 }
 
+void DeviceBase::UncacheShaderModuleByProgram(ShaderModuleBase* module) {
+    mCaches->shaderModulesByProgram.Use([&](auto modules) {
+        // Only erase the entry if it is for this module, it may have been replaced by another
+        // module with the same program while this one was being destroyed.
+        auto it = modules->find(module->GetCanonicalProgramKey());
+        if (it != modules->end() && it->second.UnsafeGet() == module) {
+            modules->erase(it);
+        }
+    });
+    mCaches->shaderModulesByContentAlias.Use([&](auto aliases) {
+        for (const std::string& aliasKey : module->GetContentAliasKeys()) {
+            auto it = aliases->find(aliasKey);
+            if (it != aliases->end() && it->second.UnsafeGet() == module) {
+                aliases->erase(it);
+            }
+        }
+        module->GetContentAliasKeys().clear();
+    });
+}
+
+ShaderModuleCacheStats DeviceBase::GetShaderModuleCacheStats() const {
+    ShaderModuleCacheStats stats;
+    stats.lookupCount = mShaderModuleLookupCount;
+    stats.contentHitCount = stats.lookupCount - mShaderModuleContentMissCount;
+    stats.programHitCount = mShaderModuleProgramHitCount;
+    return stats;
+}
+
 Ref<AttachmentState> DeviceBase::GetOrCreateAttachmentState(AttachmentState* blueprint) {
     return GetOrCreate(mCaches->attachmentStates, blueprint, [&]() -> Ref<AttachmentState> {
         return AcquireRef(new AttachmentState(*blueprint));
@@ -2232,6 +2361,18 @@ ResultOrError<Ref<RenderBundleEncoder>> DeviceBase::CreateRenderBundleEncoder(
     return RenderBundleEncoder::Create(this, descriptor);
 }
 
+Ref<RenderBundleBase> DeviceBase::CreateRenderBundle(RenderBundleEncoder* encoder,
+                                                     const RenderBundleDescriptor* descriptor,
+                                                     Ref<AttachmentState> attachmentState,
+                                                     bool depthReadOnly,
+                                                     bool stencilReadOnly,
+                                                     RenderPassResourceUsage resourceUsage,
+                                                     IndirectDrawMetadata indirectDrawMetadata) {
+    return AcquireRef(new RenderBundleBase(encoder, descriptor, std::move(attachmentState),
+                                           depthReadOnly, stencilReadOnly, std::move(resourceUsage),
+                                           std::move(indirectDrawMetadata)));
+}
+
 ResultOrError<Ref<RenderPipelineBase>> DeviceBase::CreateRenderPipeline(
     const RenderPipelineDescriptor* descriptor,
     bool allowInternalBinding) {
@@ -2576,13 +2717,19 @@ void DeviceBase::ReduceMemoryUsage() {
     GetDynamicUploader()->Deallocate(GetQueue()->GetCompletedCommandSerial(), /*freeAll=*/true);
     mInternalPipelineStore->ResetScratchBuffers();
     mTemporaryUniformBuffer = nullptr;
+    TrimCommandBlockPool(/*freeAll=*/true);
 }
 
 void DeviceBase::PerformIdleTasks() {
     DAWN_ASSERT(IsLockedByCurrentThreadIfNeeded());
+    TrimCommandBlockPool();
     PerformIdleTasksImpl();
 }
 
+ResourceMemoryStats DeviceBase::GetResourceMemoryStats() const {
+    return {};
+}
+
 ResultOrError<Ref<BufferBase>> DeviceBase::GetOrCreateTemporaryUniformBuffer(size_t size) {
     if (!mTemporaryUniformBuffer || mTemporaryUniformBuffer->GetSize() != size) {
         BufferDescriptor desc;
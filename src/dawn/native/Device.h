@@ -74,10 +74,12 @@ class BlobCache;
 class CallbackTaskManager;
 class DynamicUploader;
 class ErrorScopeStack;
+class IndirectDrawMetadata;
 class SharedTextureMemory;
 class OwnedCompilationMessages;
 struct CallbackTask;
 struct InternalPipelineStore;
+struct RenderPassResourceUsage;
 struct ShaderModuleParseResult;
 
 class DeviceBase : public ErrorSink, public RefCountedWithExternalCount<RefCounted> {
@@ -149,6 +151,15 @@ class DeviceBase : public ErrorSink, public RefCountedWithExternalCount<RefCount
     virtual ResultOrError<Ref<CommandBufferBase>> CreateCommandBuffer(
         CommandEncoder* encoder,
         const CommandBufferDescriptor* descriptor) = 0;
+    // Creates the render bundle of a finished RenderBundleEncoder. Backends can override it to
+    // keep backend data with the bundle.
+    virtual Ref<RenderBundleBase> CreateRenderBundle(RenderBundleEncoder* encoder,
+                                                     const RenderBundleDescriptor* descriptor,
+                                                     Ref<AttachmentState> attachmentState,
+                                                     bool depthReadOnly,
+                                                     bool stencilReadOnly,
+                                                     RenderPassResourceUsage resourceUsage,
+                                                     IndirectDrawMetadata indirectDrawMetadata);
 
     // Many Dawn objects are completely immutable once created which means that if two
     // creations are given the same arguments, they can return the same object. Reusing
@@ -183,6 +194,9 @@ class DeviceBase : public ErrorSink, public RefCountedWithExternalCount<RefCount
         const std::vector<tint::wgsl::Extension>& internalExtensions,
         ShaderModuleParseResult* parseResult,
         std::unique_ptr<OwnedCompilationMessages>* compilationMessages);
+    // Called by shader modules cached by their canonical program when they are destroyed.
+    void UncacheShaderModuleByProgram(ShaderModuleBase* module);
+    ShaderModuleCacheStats GetShaderModuleCacheStats() const;
 
     Ref<AttachmentState> GetOrCreateAttachmentState(AttachmentState* blueprint);
     Ref<AttachmentState> GetOrCreateAttachmentState(
@@ -438,6 +452,7 @@ class DeviceBase : public ErrorSink, public RefCountedWithExternalCount<RefCount
     uint64_t ComputeEstimatedMemoryUsage() const;
     void ReduceMemoryUsage();
     void PerformIdleTasks();
+    virtual ResourceMemoryStats GetResourceMemoryStats() const;
 
     ResultOrError<Ref<BufferBase>> GetOrCreateTemporaryUniformBuffer(size_t size);
 
@@ -584,6 +599,10 @@ class DeviceBase : public ErrorSink, public RefCountedWithExternalCount<RefCount
     size_t mLazyClearCountForTesting = 0;
     std::atomic_uint64_t mNextPipelineCompatibilityToken;
 
+    std::atomic_uint64_t mShaderModuleLookupCount = 0;
+    std::atomic_uint64_t mShaderModuleContentMissCount = 0;
+    std::atomic_uint64_t mShaderModuleProgramHitCount = 0;
+
     CombinedLimits mLimits;
     FeaturesSet mEnabledFeatures;
     tint::wgsl::AllowedFeatures mWGSLAllowedFeatures;
@@ -27,36 +27,62 @@
 
 #include "dawn/native/DynamicUploader.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "dawn/common/Math.h"
 #include "dawn/native/Buffer.h"
 #include "dawn/native/Device.h"
 #include "dawn/native/Queue.h"
+#include "dawn/platform/metrics/HistogramMacros.h"
 
 namespace dawn::native {
 
+namespace {
+
+// How long an upload waits for the GPU to finish with one of its chunks before it gives up on
+// bounding its staging memory, with wait_for_in_flight_upload_chunks.
+constexpr Nanoseconds kUploadChunkWaitTimeout = Nanoseconds(100 * 1000 * 1000);
+
+}  // anonymous namespace
+
 DynamicUploader::DynamicUploader(DeviceBase* device) : mDevice(device) {}
 
+DynamicUploader::~DynamicUploader() {
+    DAWN_HISTOGRAM_MEMORY_MB(mDevice->GetPlatform(), "DynamicUploaderStagingHighWaterMarkMB",
+                             mStagingHighWaterMark / (1024 * 1024));
+}
+
 void DynamicUploader::ReleaseStagingBuffer(Ref<BufferBase> stagingBuffer) {
     mReleasedStagingBuffers.Enqueue(std::move(stagingBuffer),
                                     mDevice->GetQueue()->GetPendingCommandSerial());
 }
 
+ResultOrError<Ref<BufferBase>> DynamicUploader::CreateStagingBuffer(uint64_t size) {
+    BufferDescriptor bufferDesc = {};
+    bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
+    bufferDesc.size = Align(size, 4);
+    bufferDesc.mappedAtCreation = true;
+    bufferDesc.label = "Dawn_DynamicUploaderStaging";
+
+    IgnoreLazyClearCountScope scope(mDevice);
+    Ref<BufferBase> stagingBuffer;
+    DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateBuffer(&bufferDesc));
+
+    mStagingHighWaterMark =
+        std::max(mStagingHighWaterMark, GetTotalAllocatedSize() + stagingBuffer->GetSize());
+    return stagingBuffer;
+}
+
 ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocationSize,
                                                               ExecutionSerial serial,
                                                               uint64_t offsetAlignment) {
+    mUploadSizeSinceTick += allocationSize;
+
     // Disable further sub-allocation should the request be too large.
-    if (allocationSize > kRingBufferSize) {
-        BufferDescriptor bufferDesc = {};
-        bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
-        bufferDesc.size = Align(allocationSize, 4);
-        bufferDesc.mappedAtCreation = true;
-        bufferDesc.label = "Dawn_DynamicUploaderStaging";
-
-        IgnoreLazyClearCountScope scope(mDevice);
+    if (allocationSize > kMaxRingBufferSize) {
         Ref<BufferBase> stagingBuffer;
-        DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateBuffer(&bufferDesc));
+        DAWN_TRY_ASSIGN(stagingBuffer, CreateStagingBuffer(allocationSize));
 
         UploadHandle uploadHandle;
         uploadHandle.mappedBuffer = static_cast<uint8_t*>(stagingBuffer->GetMappedPointer());
@@ -66,15 +92,10 @@ ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocatio
         return uploadHandle;
     }
 
-    if (mRingBuffers.empty()) {
-        mRingBuffers.emplace_back(std::unique_ptr<RingBuffer>(
-            new RingBuffer{nullptr, RingBufferAllocator(kRingBufferSize)}));
-    }
-
     // Note: Validation ensures size is already aligned.
     // First-fit: find next buffer large enough to satisfy the allocation request.
     uint64_t startOffset = RingBufferAllocator::kInvalidOffset;
-    RingBuffer* targetRingBuffer = mRingBuffers.back().get();
+    RingBuffer* targetRingBuffer = nullptr;
     for (auto& ringBuffer : mRingBuffers) {
         RingBufferAllocator& ringBufferAllocator = ringBuffer->mAllocator;
         // Prevent overflow.
@@ -86,14 +107,18 @@ ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocatio
         }
     }
 
-    // Upon failure, append a newly created ring buffer to fulfill the
-    // request.
+    // Upon failure, append a newly created ring buffer to fulfill the request. It is sized for
+    // the upload volume of the previous ticks so that the ring buffers of a tick can hold all of
+    // its uploads.
     if (startOffset == RingBufferAllocator::kInvalidOffset) {
+        uint64_t ringBufferSize =
+            std::max(GetTargetRingBufferSize(), NextPowerOfTwo(allocationSize));
         mRingBuffers.emplace_back(std::unique_ptr<RingBuffer>(
-            new RingBuffer{nullptr, RingBufferAllocator(kRingBufferSize)}));
+            new RingBuffer{nullptr, RingBufferAllocator(ringBufferSize)}));
 
         targetRingBuffer = mRingBuffers.back().get();
-        startOffset = targetRingBuffer->mAllocator.Allocate(allocationSize, serial);
+        startOffset =
+            targetRingBuffer->mAllocator.Allocate(allocationSize, serial, offsetAlignment);
     }
 
     DAWN_ASSERT(startOffset != RingBufferAllocator::kInvalidOffset);
@@ -101,16 +126,8 @@ ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocatio
     // Allocate the staging buffer backing the ringbuffer.
     // Note: the first ringbuffer will be lazily created.
     if (targetRingBuffer->mStagingBuffer == nullptr) {
-        BufferDescriptor bufferDesc = {};
-        bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
-        bufferDesc.size = Align(targetRingBuffer->mAllocator.GetSize(), 4);
-        bufferDesc.mappedAtCreation = true;
-        bufferDesc.label = "Dawn_DynamicUploaderStaging";
-
-        IgnoreLazyClearCountScope scope(mDevice);
-        Ref<BufferBase> stagingBuffer;
-        DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateBuffer(&bufferDesc));
-        targetRingBuffer->mStagingBuffer = std::move(stagingBuffer);
+        DAWN_TRY_ASSIGN(targetRingBuffer->mStagingBuffer,
+                        CreateStagingBuffer(targetRingBuffer->mAllocator.GetSize()));
     }
 
     DAWN_ASSERT(targetRingBuffer->mStagingBuffer != nullptr);
@@ -125,24 +142,84 @@ ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocatio
 }
 
 void DynamicUploader::Deallocate(ExecutionSerial lastCompletedSerial, bool freeAll) {
+    // Each call marks the end of a device tick, record how much data was uploaded during it.
+    mUploadSizeHistory[mUploadSizeHistoryIndex] = mUploadSizeSinceTick;
+    mUploadSizeHistoryIndex = (mUploadSizeHistoryIndex + 1) % kUploadHistoryLength;
+    mUploadSizeSinceTick = 0;
+
     // Reclaim memory within the ring buffers by ticking (or removing requests no longer
     // in-flight).
-    size_t i = 0;
-    while (i < mRingBuffers.size()) {
-        mRingBuffers[i]->mAllocator.Deallocate(lastCompletedSerial);
-
-        // Never erase the last buffer as to prevent re-creating smaller buffers
-        // again unless explicitly asked to do so. The last buffer is the largest.
-        const bool shouldFree = (i < mRingBuffers.size() - 1) || freeAll;
-        if (mRingBuffers[i]->mAllocator.Empty() && shouldFree) {
-            mRingBuffers.erase(mRingBuffers.begin() + i);
+    for (auto& ringBuffer : mRingBuffers) {
+        ringBuffer->mAllocator.Deallocate(lastCompletedSerial);
+    }
+
+    // Keep the most recent idle ring buffers, as long as they fit in the memory needed for the
+    // recent upload volume, so that they don't have to be re-created on the next tick. Ring buffers
+    // left over from a spike of the upload volume, or beyond the cap, are freed.
+    uint64_t retainedSizeBudget = 0;
+    if (!freeAll) {
+        retainedSizeBudget = std::clamp(NextPowerOfTwo(GetPeakUploadSize()), kMinRingBufferSize,
+                                        kMaxRetainedStagingSize);
+    }
+    for (size_t i = mRingBuffers.size(); i > 0; --i) {
+        RingBuffer* ringBuffer = mRingBuffers[i - 1].get();
+        if (!ringBuffer->mAllocator.Empty()) {
+            continue;
+        }
+        uint64_t size = ringBuffer->mAllocator.GetSize();
+        if (size <= retainedSizeBudget) {
+            retainedSizeBudget -= size;
         } else {
-            i++;
+            mRingBuffers.erase(mRingBuffers.begin() + (i - 1));
         }
     }
     mReleasedStagingBuffers.ClearUpTo(lastCompletedSerial);
 }
 
+MaybeError DynamicUploader::OnUploadChunkRecorded() {
+    QueueBase* queue = mDevice->GetQueue();
+    DAWN_TRY(queue->EnsureCommandsFlushed(queue->GetScheduledWorkDoneSerial()));
+    DAWN_TRY(queue->CheckPassedSerials());
+
+    // Only reclaim the space of completed chunks. Ring buffers aren't freed in the middle of an
+    // upload because the next chunks are about to use them.
+    auto reclaimCompletedChunks = [&] {
+        ExecutionSerial completedSerial = queue->GetCompletedCommandSerial();
+        for (auto& ringBuffer : mRingBuffers) {
+            ringBuffer->mAllocator.Deallocate(completedSerial);
+        }
+    };
+    reclaimCompletedChunks();
+
+    // By default the upload never blocks: if the GPU is behind, the next chunks use more staging
+    // memory, which the next Submit or device tick reclaims once the copies complete.
+    if (!mDevice->IsToggleEnabled(Toggle::WaitForInFlightUploadChunks)) {
+        return {};
+    }
+
+    // Wait for the GPU to catch up when the next chunk wouldn't fit in the in-flight budget, so
+    // that the next chunks reuse the ring buffers instead of growing them for the whole upload.
+    // The waits are bounded: if the GPU doesn't complete a chunk in time, the upload continues
+    // with more staging memory.
+    while (GetInFlightUploadSize() + kUploadChunkSize > kMaxInFlightUploadSize &&
+           queue->GetCompletedCommandSerial() < queue->GetLastSubmittedCommandSerial()) {
+        if (mDevice->IsLost()) {
+            return DAWN_DEVICE_LOST_ERROR("Device lost while uploading data.");
+        }
+        ExecutionSerial waitSerial =
+            ExecutionSerial(uint64_t(queue->GetCompletedCommandSerial()) + 1);
+        bool waitSucceeded;
+        DAWN_TRY_ASSIGN(waitSucceeded,
+                        queue->WaitForQueueSerial(waitSerial, kUploadChunkWaitTimeout));
+        DAWN_TRY(queue->CheckPassedSerials());
+        reclaimCompletedChunks();
+        if (!waitSucceeded) {
+            break;
+        }
+    }
+    return {};
+}
+
 ResultOrError<UploadHandle> DynamicUploader::Allocate(uint64_t allocationSize,
                                                       ExecutionSerial serial,
                                                       uint64_t offsetAlignment) {
@@ -170,4 +247,29 @@ uint64_t DynamicUploader::GetTotalAllocatedSize() {
     return size;
 }
 
+uint64_t DynamicUploader::GetInFlightUploadSize() const {
+    uint64_t size = 0;
+    for (const auto& ringBuffer : mRingBuffers) {
+        size += ringBuffer->mAllocator.GetUsedSize();
+    }
+    return size;
+}
+
+uint64_t DynamicUploader::GetStagingHighWaterMark() const {
+    return mStagingHighWaterMark;
+}
+
+uint64_t DynamicUploader::GetPeakUploadSize() const {
+    uint64_t peak = 0;
+    for (uint64_t size : mUploadSizeHistory) {
+        peak = std::max(peak, size);
+    }
+    return peak;
+}
+
+uint64_t DynamicUploader::GetTargetRingBufferSize() const {
+    return std::clamp(NextPowerOfTwo(GetPeakUploadSize()), kMinRingBufferSize,
+                      kMaxRingBufferSize);
+}
+
 }  // namespace dawn::native
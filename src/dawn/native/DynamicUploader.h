@@ -28,6 +28,7 @@
 #ifndef SRC_DAWN_NATIVE_DYNAMICUPLOADER_H_
 #define SRC_DAWN_NATIVE_DYNAMICUPLOADER_H_
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -39,7 +40,8 @@
 #include "partition_alloc/pointers/raw_ptr.h"
 
 // DynamicUploader is the front-end implementation used to manage multiple ring buffers for upload
-// usage.
+// usage. The size of new ring buffers adapts to the amount of data uploaded between device ticks,
+// and the ring buffers kept alive while idle are capped to kMaxRetainedStagingSize.
 namespace dawn::native {
 
 class BufferBase;
@@ -52,8 +54,12 @@ struct UploadHandle {
 
 class DynamicUploader {
   public:
+    // WriteBuffer and WriteTexture split uploads larger than this in chunks so that the GPU can
+    // copy the first chunks while the next ones are written, reusing the same ring buffers.
+    static constexpr uint64_t kUploadChunkSize = 4 * 1024 * 1024;
+
     explicit DynamicUploader(DeviceBase* device);
-    ~DynamicUploader() = default;
+    ~DynamicUploader();
 
     // We add functions to Release StagingBuffers to the DynamicUploader as there's
     // currently no place to track the allocated staging buffers such that they're freed after
@@ -66,11 +72,28 @@ class DynamicUploader {
                                          uint64_t offsetAlignment);
     void Deallocate(ExecutionSerial lastCompletedSerial, bool freeAll = false);
 
+    // Called between the chunks of a large upload. Submits the copies of the previous chunks and
+    // reclaims the ring buffer space of the ones that completed. With
+    // wait_for_in_flight_upload_chunks, if the next chunk would bring the staging memory in use
+    // above kMaxInFlightUploadSize, first waits a bounded time for the previous chunks.
+    MaybeError OnUploadChunkRecorded();
+
     bool ShouldFlush();
 
-  private:
-    static constexpr uint64_t kRingBufferSize = 4 * 1024 * 1024;
     uint64_t GetTotalAllocatedSize();
+    // The size of the ring buffer allocations that the GPU hasn't finished with.
+    uint64_t GetInFlightUploadSize() const;
+    // The largest amount of staging memory that was allocated at once.
+    uint64_t GetStagingHighWaterMark() const;
+
+    static constexpr uint64_t kMinRingBufferSize = 4 * 1024 * 1024;
+    static constexpr uint64_t kMaxRingBufferSize = 16 * 1024 * 1024;
+    static constexpr uint64_t kMaxRetainedStagingSize = 32 * 1024 * 1024;
+    static constexpr uint64_t kMaxInFlightUploadSize = 4 * kUploadChunkSize;
+
+  private:
+    // The number of device ticks over which the upload volume is tracked to size ring buffers.
+    static constexpr size_t kUploadHistoryLength = 16;
 
     struct RingBuffer {
         Ref<BufferBase> mStagingBuffer;
@@ -80,10 +103,23 @@ class DynamicUploader {
     ResultOrError<UploadHandle> AllocateInternal(uint64_t allocationSize,
                                                  ExecutionSerial serial,
                                                  uint64_t offsetAlignment);
+    ResultOrError<Ref<BufferBase>> CreateStagingBuffer(uint64_t size);
+
+    // The largest amount of data uploaded between two device ticks, in the previous ticks.
+    uint64_t GetPeakUploadSize() const;
+    // The size of the ring buffers to create for the current upload volume.
+    uint64_t GetTargetRingBufferSize() const;
 
     std::vector<std::unique_ptr<RingBuffer>> mRingBuffers;
     SerialQueue<ExecutionSerial, Ref<BufferBase>> mReleasedStagingBuffers;
     raw_ptr<DeviceBase> mDevice;
+
+    // The amount of data uploaded since the last device tick, and during the previous ones.
+    uint64_t mUploadSizeSinceTick = 0;
+    std::array<uint64_t, kUploadHistoryLength> mUploadSizeHistory = {};
+    size_t mUploadSizeHistoryIndex = 0;
+
+    uint64_t mStagingHighWaterMark = 0;
 };
 }  // namespace dawn::native
 
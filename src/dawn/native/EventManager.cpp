@@ -108,18 +108,14 @@ class SystemEventAndReadyStateIterator {
     WrappedIter mWrappedIt;
 };
 
-// Wait/poll the queue for futures in range [begin, end). `waitSerial` should be
-// the serial after which at least one future should be complete. All futures must
-// have completion data of type QueueAndSerial.
-// Returns true if at least one future is ready. If no futures are ready or the wait
-// timed out, returns false.
-bool WaitQueueSerialsImpl(DeviceBase* device,
-                          QueueBase* queue,
-                          ExecutionSerial waitSerial,
-                          std::vector<TrackedFutureWaitInfo>::iterator begin,
-                          std::vector<TrackedFutureWaitInfo>::iterator end,
-                          Nanoseconds timeout) {
-    bool success = false;
+// Makes |queue| progress toward |waitSerial|, waits at most |timeout| for it to complete, and
+// returns the completed serial of the queue. If there is an error, the device is lost and all the
+// futures of the queue are ready, so kMaxExecutionSerial is returned.
+ExecutionSerial WaitQueueSerial(DeviceBase* device,
+                                QueueBase* queue,
+                                ExecutionSerial waitSerial,
+                                Nanoseconds timeout) {
+    ExecutionSerial completedSerial = kBeginningOfGPUTime;
     // TODO(dawn:1662): Make error handling thread-safe.
     auto deviceLock(device->GetScopedLock());
     if (device->ConsumedError([&]() -> MaybeError {
@@ -132,34 +128,48 @@ bool WaitQueueSerialsImpl(DeviceBase* device,
                 DAWN_TRY(device->Tick());
             }
             // Check the completed serial.
-            ExecutionSerial completedSerial = queue->GetCompletedCommandSerial();
+            completedSerial = queue->GetCompletedCommandSerial();
             if (completedSerial < waitSerial) {
                 if (timeout > Nanoseconds(0)) {
                     // Wait on the serial if it hasn't passed yet.
-                    DAWN_TRY_ASSIGN(success, queue->WaitForQueueSerial(waitSerial, timeout));
+                    [[maybe_unused]] bool waitSucceeded;
+                    DAWN_TRY_ASSIGN(waitSucceeded, queue->WaitForQueueSerial(waitSerial, timeout));
                 }
                 // Update completed serials.
                 DAWN_TRY(queue->CheckPassedSerials());
                 completedSerial = queue->GetCompletedCommandSerial();
             }
-            // Poll futures for completion.
-            for (auto it = begin; it != end; ++it) {
-                ExecutionSerial serial =
-                    std::get<QueueAndSerial>(it->event->GetCompletionData()).completionSerial;
-                if (serial <= completedSerial) {
-                    success = true;
-                    it->ready = true;
-                }
-            }
             return {};
         }())) {
         // There was an error. Pending submit may have failed or waiting for fences
         // may have lost the device. The device is lost inside ConsumedError.
-        // Mark all futures as ready.
-        for (auto it = begin; it != end; ++it) {
+        return kMaxExecutionSerial;
+    }
+    return completedSerial;
+}
+
+// Wait/poll the queue for futures in range [begin, end). `waitSerial` should be
+// the serial after which at least one future should be complete. All futures must
+// have completion data of type QueueAndSerial.
+// Returns true if at least one future is ready. If no futures are ready or the wait
+// timed out, returns false.
+bool WaitQueueSerialsImpl(DeviceBase* device,
+                          QueueBase* queue,
+                          ExecutionSerial waitSerial,
+                          std::vector<TrackedFutureWaitInfo>::iterator begin,
+                          std::vector<TrackedFutureWaitInfo>::iterator end,
+                          Nanoseconds timeout) {
+    ExecutionSerial completedSerial = WaitQueueSerial(device, queue, waitSerial, timeout);
+
+    // Poll futures for completion.
+    bool success = false;
+    for (auto it = begin; it != end; ++it) {
+        ExecutionSerial serial =
+            std::get<QueueAndSerial>(it->event->GetCompletionData()).completionSerial;
+        if (serial <= completedSerial) {
+            success = true;
             it->ready = true;
         }
-        success = true;
     }
     return success;
 }
@@ -274,13 +284,73 @@ auto PrepareReadyCallbacks(std::vector<TrackedFutureWaitInfo>& futures) {
 
 }  // namespace
 
-// EventManager
+// EventManager::EventShard
 
-EventManager::EventManager() {
-    // Construct the non-movable inner struct.
-    mEvents.Use([&](auto events) { (*events).emplace(); });
+void EventManager::EventShard::Track(Ref<TrackedEvent> event) {
+    FutureID futureID = event->mFutureID;
+    if (event->mCallbackMode != wgpu::CallbackMode::WaitAnyOnly) {
+        const auto& completionData = event->GetCompletionData();
+        if (std::holds_alternative<QueueAndSerial>(completionData)) {
+            const auto& queueAndSerial = std::get<QueueAndSerial>(completionData);
+            queueEvents[queueAndSerial.queue.Get()].emplace(
+                std::make_pair(queueAndSerial.completionSerial, futureID), event);
+        } else {
+            systemEvents.emplace(futureID, event);
+        }
+    }
+    events.emplace(futureID, std::move(event));
 }
 
+bool EventManager::EventShard::Untrack(FutureID futureID) {
+    auto it = events.find(futureID);
+    if (it == events.end()) {
+        return false;
+    }
+
+    const TrackedEvent* event = it->second.Get();
+    if (event->mCallbackMode != wgpu::CallbackMode::WaitAnyOnly) {
+        const auto& completionData = event->GetCompletionData();
+        if (std::holds_alternative<QueueAndSerial>(completionData)) {
+            const auto& queueAndSerial = std::get<QueueAndSerial>(completionData);
+            auto queueIt = queueEvents.find(queueAndSerial.queue.Get());
+            DAWN_ASSERT(queueIt != queueEvents.end());
+            queueIt->second.erase(std::make_pair(queueAndSerial.completionSerial, futureID));
+            if (queueIt->second.empty()) {
+                queueEvents.erase(queueIt);
+            }
+        } else {
+            systemEvents.erase(futureID);
+        }
+    }
+    events.erase(it);
+    return true;
+}
+
+void EventManager::EventShard::SetCompletionSerial(TrackedEvent* event, ExecutionSerial serial) {
+    auto& queueAndSerial = std::get<QueueAndSerial>(event->mCompletionData);
+    FutureID futureID = event->mFutureID;
+    if (event->mCallbackMode != wgpu::CallbackMode::WaitAnyOnly && events.contains(futureID)) {
+        // The events of a queue are keyed by the serial they were tracked with, so re-key the
+        // event for Untrack and ProcessEvents to find it.
+        auto queueIt = queueEvents.find(queueAndSerial.queue.Get());
+        DAWN_ASSERT(queueIt != queueEvents.end());
+        auto node =
+            queueIt->second.extract(std::make_pair(queueAndSerial.completionSerial, futureID));
+        DAWN_ASSERT(!node.empty());
+        node.key().first = serial;
+        queueIt->second.insert(std::move(node));
+    }
+    queueAndSerial.completionSerial = serial;
+}
+
+bool EventManager::EventShard::HasPollEvents() const {
+    return !queueEvents.empty() || !systemEvents.empty();
+}
+
+// EventManager
+
+EventManager::EventManager() = default;
+
 EventManager::~EventManager() {
     DAWN_ASSERT(IsShutDown());
 }
@@ -301,11 +371,20 @@ MaybeError EventManager::Initialize(const UnpackedPtr<InstanceDescriptor>& descr
 }
 
 void EventManager::ShutDown() {
-    mEvents.Use([&](auto events) { (*events).reset(); });
+    mIsShutDown.store(true, std::memory_order_release);
+    for (auto& shard : mShards) {
+        // Drop the events outside of the lock since it may complete them, which calls callbacks.
+        EventShard events;
+        shard.Use([&](auto eventShard) { std::swap(*eventShard, events); });
+    }
 }
 
 bool EventManager::IsShutDown() const {
-    return mEvents.Use([](auto events) { return !events->has_value(); });
+    return mIsShutDown.load(std::memory_order_acquire);
+}
+
+MutexProtected<EventManager::EventShard>& EventManager::GetShard(FutureID futureID) {
+    return mShards[futureID % kEventShardCount];
 }
 
 FutureID EventManager::TrackEvent(Ref<TrackedEvent>&& event) {
@@ -336,8 +415,8 @@ FutureID EventManager::TrackEvent(Ref<TrackedEvent>&& event) {
         }
     }
 
-    mEvents.Use([&](auto events) {
-        if (!events->has_value()) {
+    GetShard(futureID).Use([&](auto shard) {
+        if (IsShutDown()) {
             return;
         }
         if (event->mCallbackMode != wgpu::CallbackMode::WaitAnyOnly) {
@@ -347,19 +426,27 @@ FutureID EventManager::TrackEvent(Ref<TrackedEvent>&& event) {
                                                               std::memory_order_acq_rel)) {
             }
         }
-        (*events)->emplace(futureID, std::move(event));
+        shard->Track(std::move(event));
     });
     return futureID;
 }
 
 void EventManager::SetFutureReady(TrackedEvent* event) {
-    auto completionData = event->GetCompletionData();
+    const auto& completionData = event->GetCompletionData();
     if (std::holds_alternative<Ref<SystemEvent>>(completionData)) {
         std::get<Ref<SystemEvent>>(completionData)->Signal();
     }
     if (std::holds_alternative<QueueAndSerial>(completionData)) {
-        auto& queueAndSerial = std::get<QueueAndSerial>(completionData);
-        queueAndSerial.completionSerial = queueAndSerial.queue->GetCompletedCommandSerial();
+        // The event is ready now, so it must not wait for the serial it was tracked with.
+        ExecutionSerial completedSerial =
+            std::get<QueueAndSerial>(completionData).queue->GetCompletedCommandSerial();
+        if (event->mFutureID == kNullFutureID) {
+            std::get<QueueAndSerial>(event->mCompletionData).completionSerial = completedSerial;
+        } else {
+            GetShard(event->mFutureID).Use([&](auto shard) {
+                shard->SetCompletionSerial(event, completedSerial);
+            });
+        }
     }
 
     // Sometimes, events might become ready before they are even tracked. This can happen because
@@ -371,12 +458,7 @@ void EventManager::SetFutureReady(TrackedEvent* event) {
 
     // Handle spontaneous completion now.
     if (event->mCallbackMode == wgpu::CallbackMode::AllowSpontaneous) {
-        mEvents.Use([&](auto events) {
-            if (!events->has_value()) {
-                return;
-            }
-            (*events)->erase(event->mFutureID);
-        });
+        GetShard(event->mFutureID).Use([&](auto shard) { shard->Untrack(event->mFutureID); });
         event->EnsureComplete(EventCompletionType::Ready);
     }
 }
@@ -385,55 +467,103 @@ bool EventManager::ProcessPollEvents() {
     DAWN_ASSERT(!IsShutDown());
 
     std::vector<TrackedFutureWaitInfo> futures;
-    wgpu::WaitStatus waitStatus;
+    bool hasPollEvents = false;
     bool hasProgressingEvents = false;
-    FutureID lastProcessEventID;
-    mEvents.Use([&](auto events) {
-        // Iterate all events and record poll events and spontaneous events since they are both
-        // allowed to be completed in the ProcessPoll call. Note that spontaneous events are allowed
-        // to trigger anywhere which is why we include them in the call.
-        lastProcessEventID = mLastProcessEventID.load(std::memory_order_acquire);
-        futures.reserve((*events)->size());
-        for (auto& [futureID, event] : **events) {
-            if (event->mCallbackMode != wgpu::CallbackMode::WaitAnyOnly) {
-                // Figure out if there are any progressing events. If we only have non-progressing
-                // events, we need to return false to indicate that there isn't any polling work to
-                // be done.
-                auto completionData = event->GetCompletionData();
-                if (std::holds_alternative<Ref<SystemEvent>>(completionData)) {
-                    hasProgressingEvents |=
-                        std::get<Ref<SystemEvent>>(completionData)->IsProgressing();
+    FutureID lastProcessEventID = mLastProcessEventID.load(std::memory_order_acquire);
+
+    // Poll events and spontaneous events are both allowed to be completed in the ProcessPoll call.
+    // Note that spontaneous events are allowed to trigger anywhere which is why they are included.
+    // First find the lowest serial each queue waits on, and take the system events that are ready.
+    struct QueueWait {
+        Ref<QueueBase> queue;
+        ExecutionSerial waitSerial;
+        ExecutionSerial completedSerial;
+    };
+    absl::flat_hash_map<QueueBase*, QueueWait> queueWaits;
+    for (auto& shard : mShards) {
+        shard.Use([&](auto eventShard) {
+            hasPollEvents |= eventShard->HasPollEvents();
+            for (const auto& [queue, queueEvents] : eventShard->queueEvents) {
+                ExecutionSerial waitSerial = queueEvents.begin()->first.first;
+                auto [it, inserted] = queueWaits.try_emplace(queue);
+                if (inserted) {
+                    it->second.queue = queue;
+                    it->second.waitSerial = waitSerial;
                 } else {
-                    hasProgressingEvents = true;
+                    it->second.waitSerial = std::min(it->second.waitSerial, waitSerial);
                 }
-
-                futures.push_back(TrackedFutureWaitInfo{futureID, event, 0, false});
             }
-        }
-    });
+            // Queue events always progress. Only system events can be non-progressing.
+            hasProgressingEvents |= !eventShard->queueEvents.empty();
+
+            std::vector<FutureID> readySystemEvents;
+            for (const auto& [futureID, event] : eventShard->systemEvents) {
+                const auto& systemEvent = std::get<Ref<SystemEvent>>(event->GetCompletionData());
+                if (systemEvent->IsSignaled()) {
+                    futures.push_back(TrackedFutureWaitInfo{futureID, event, 0, true});
+                    readySystemEvents.push_back(futureID);
+                } else {
+                    hasProgressingEvents |= systemEvent->IsProgressing();
+                }
+            }
+            for (FutureID futureID : readySystemEvents) {
+                eventShard->Untrack(futureID);
+            }
+        });
+    }
 
     // If there wasn't anything to wait on, we can skip the wait and just return.
-    if (futures.size() == 0) {
+    if (!hasPollEvents) {
         return false;
     }
 
-    // Wait and enforce callback ordering.
-    waitStatus = WaitImpl(futures, Nanoseconds(0));
-    if (waitStatus == wgpu::WaitStatus::TimedOut) {
+    // Poll the queues, outside of the shard locks since it may tick the devices.
+    for (auto& [_, queueWait] : queueWaits) {
+        QueueBase* queue = queueWait.queue.Get();
+        queueWait.completedSerial =
+            WaitQueueSerial(queue->GetDevice(), queue, queueWait.waitSerial, Nanoseconds(0));
+    }
+
+    // Take the queue events that are ready, which are at the front of the serial ordered lists.
+    bool hasIncompleteEvents = false;
+    for (auto& shard : mShards) {
+        shard.Use([&](auto eventShard) {
+            for (auto it = eventShard->queueEvents.begin(); it != eventShard->queueEvents.end();) {
+                auto queueWait = queueWaits.find(it->first);
+                if (queueWait == queueWaits.end()) {
+                    ++it;
+                    continue;
+                }
+
+                auto& queueEvents = it->second;
+                auto readyEnd = queueEvents.begin();
+                for (; readyEnd != queueEvents.end() &&
+                       readyEnd->first.first <= queueWait->second.completedSerial;
+                     ++readyEnd) {
+                    FutureID futureID = readyEnd->first.second;
+                    futures.push_back(
+                        TrackedFutureWaitInfo{futureID, std::move(readyEnd->second), 0, true});
+                    eventShard->events.erase(futureID);
+                }
+                queueEvents.erase(queueEvents.begin(), readyEnd);
+
+                if (queueEvents.empty()) {
+                    eventShard->queueEvents.erase(it++);
+                } else {
+                    ++it;
+                }
+            }
+            hasIncompleteEvents |= eventShard->HasPollEvents();
+        });
+    }
+
+    if (futures.empty()) {
         return hasProgressingEvents;
     }
-    DAWN_ASSERT(waitStatus == wgpu::WaitStatus::Success);
 
     // Enforce callback ordering.
     auto readyEnd = PrepareReadyCallbacks(futures);
-    bool hasIncompleteEvents = readyEnd != futures.end();
-
-    // For all the futures we are about to complete, first ensure they're untracked.
-    mEvents.Use([&](auto events) {
-        for (auto it = futures.begin(); it != readyEnd; ++it) {
-            (*events)->erase(it->futureID);
-        }
-    });
+    DAWN_ASSERT(readyEnd == futures.end());
 
     // Finally, call callbacks while comparing the last process event id with any new ones that may
     // have been created via the callbacks.
@@ -446,6 +576,19 @@ bool EventManager::ProcessPollEvents() {
            (lastProcessEventID != mLastProcessEventID.load(std::memory_order_acquire));
 }
 
+size_t EventManager::GetTrackedEventCountForTesting() {
+    size_t count = 0;
+    for (auto& shard : mShards) {
+        shard.Use([&](auto eventShard) {
+            count += eventShard->events.size() + eventShard->systemEvents.size();
+            for (const auto& [_, queueEvents] : eventShard->queueEvents) {
+                count += queueEvents.size();
+            }
+        });
+    }
+    return count;
+}
+
 wgpu::WaitStatus EventManager::WaitAny(size_t count, FutureWaitInfo* infos, Nanoseconds timeout) {
     DAWN_ASSERT(!IsShutDown());
 
@@ -468,27 +611,27 @@ wgpu::WaitStatus EventManager::WaitAny(size_t count, FutureWaitInfo* infos, Nano
     std::vector<TrackedFutureWaitInfo> futures;
     futures.reserve(count);
     bool anyCompleted = false;
-    mEvents.Use([&](auto events) {
-        FutureID firstInvalidFutureID = mNextFutureID;
-        for (size_t i = 0; i < count; ++i) {
-            FutureID futureID = infos[i].future.id;
-
-            // Check for cases that are undefined behavior in the API contract.
-            DAWN_ASSERT(futureID != 0);
-            DAWN_ASSERT(futureID < firstInvalidFutureID);
-
-            // Try to find the event.
-            auto it = (*events)->find(futureID);
-            if (it == (*events)->end()) {
-                infos[i].completed = true;
-                anyCompleted = true;
-            } else {
-                infos[i].completed = false;
-                TrackedEvent* event = it->second.Get();
-                futures.push_back(TrackedFutureWaitInfo{futureID, event, i, false});
-            }
+    FutureID firstInvalidFutureID = mNextFutureID;
+    for (size_t i = 0; i < count; ++i) {
+        FutureID futureID = infos[i].future.id;
+
+        // Check for cases that are undefined behavior in the API contract.
+        DAWN_ASSERT(futureID != 0);
+        DAWN_ASSERT(futureID < firstInvalidFutureID);
+
+        // Try to find the event.
+        Ref<TrackedEvent> event = GetShard(futureID).Use([&](auto shard) -> Ref<TrackedEvent> {
+            auto it = shard->events.find(futureID);
+            return it == shard->events.end() ? nullptr : it->second;
+        });
+        if (event == nullptr) {
+            infos[i].completed = true;
+            anyCompleted = true;
+        } else {
+            infos[i].completed = false;
+            futures.push_back(TrackedFutureWaitInfo{futureID, std::move(event), i, false});
         }
-    });
+    }
     // If any completed, return immediately.
     if (anyCompleted) {
         return wgpu::WaitStatus::Success;
@@ -506,11 +649,9 @@ wgpu::WaitStatus EventManager::WaitAny(size_t count, FutureWaitInfo* infos, Nano
 
     // For any futures that we're about to complete, first ensure they're untracked. It's OK if
     // something actually isn't tracked anymore (because it completed elsewhere while waiting.)
-    mEvents.Use([&](auto events) {
-        for (auto it = futures.begin(); it != readyEnd; ++it) {
-            (*events)->erase(it->futureID);
-        }
-    });
+    for (auto it = futures.begin(); it != readyEnd; ++it) {
+        GetShard(it->futureID).Use([&](auto shard) { shard->Untrack(it->futureID); });
+    }
 
     // Finally, call callbacks and update return values.
     for (auto it = futures.begin(); it != readyEnd; ++it) {
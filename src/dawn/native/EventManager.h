@@ -28,10 +28,12 @@
 #ifndef SRC_DAWN_NATIVE_EVENTMANAGER_H_
 #define SRC_DAWN_NATIVE_EVENTMANAGER_H_
 
+#include <array>
 #include <atomic>
 #include <cstdint>
+#include <map>
 #include <mutex>
-#include <optional>
+#include <utility>
 #include <variant>
 
 #include "absl/container/flat_hash_map.h"
@@ -54,6 +56,11 @@ struct InstanceDescriptor;
 //
 // TODO(crbug.com/dawn/2050): Can this eventually replace CallbackTaskManager?
 //
+// Events are spread over shards by FutureID so that threads tracking and completing events rarely
+// contend on the same lock. Each shard also keeps the events that ProcessEvents may complete,
+// ordered by completion serial for each queue, so ProcessEvents only visits the events that are
+// ready instead of scanning all of them.
+//
 // There are various ways to optimize ProcessEvents/WaitAny:
 // - TODO(crbug.com/dawn/2059) Spontaneously set events as "early-ready" in other places when we see
 //   serials advance, e.g. Submit, or when checking a later wait before an earlier wait.
@@ -79,17 +86,42 @@ class EventManager final : NonMovable {
                                            FutureWaitInfo* infos,
                                            Nanoseconds timeout);
 
+    // Returns the number of entries of all the shards, including the ones indexing the events for
+    // ProcessEvents.
+    size_t GetTrackedEventCountForTesting();
+
   private:
     bool IsShutDown() const;
 
+    struct EventShard {
+        // All the events of the shard that aren't completed yet.
+        absl::flat_hash_map<FutureID, Ref<TrackedEvent>> events;
+
+        // The subset of |events| that ProcessEvents may complete. The events that wait on a queue
+        // serial are ordered by serial so ProcessEvents only visits the ones that are ready.
+        using QueueEvents = std::map<std::pair<ExecutionSerial, FutureID>, Ref<TrackedEvent>>;
+        absl::flat_hash_map<QueueBase*, QueueEvents> queueEvents;
+        absl::flat_hash_map<FutureID, Ref<TrackedEvent>> systemEvents;
+
+        void Track(Ref<TrackedEvent> event);
+        // Returns whether the event was tracked.
+        bool Untrack(FutureID futureID);
+        // Sets the completion serial of |event|, which waits on a queue serial, and moves it to
+        // the position of the new serial in the events of its queue if it is tracked.
+        void SetCompletionSerial(TrackedEvent* event, ExecutionSerial serial);
+        bool HasPollEvents() const;
+    };
+    static constexpr size_t kEventShardCount = 16;
+    MutexProtected<EventShard>& GetShard(FutureID futureID);
+
     bool mTimedWaitAnyEnable = false;
     size_t mTimedWaitAnyMaxCount = kTimedWaitAnyMaxCountDefault;
     std::atomic<FutureID> mNextFutureID = 1;
 
-    // Freed once the user has dropped their last ref to the Instance, so can't call WaitAny or
+    // Cleared once the user has dropped their last ref to the Instance, so can't call WaitAny or
     // ProcessEvents anymore. This breaks reference cycles.
-    using EventMap = absl::flat_hash_map<FutureID, Ref<TrackedEvent>>;
-    MutexProtected<std::optional<EventMap>> mEvents;
+    std::array<MutexProtected<EventShard>, kEventShardCount> mShards;
+    std::atomic<bool> mIsShutDown = false;
 
     // Records last process event id in order to properly return whether or not there are still
     // events to process when we have re-entrant callbacks.
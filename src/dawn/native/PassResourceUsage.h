@@ -76,6 +76,21 @@ struct SyncScopeResourceUsage {
     std::vector<ExternalTextureBase*> externalTextures;
 };
 
+// The usages of the buffers and textures in a bind group, with the usages of a resource that is
+// bound multiple times already merged. Bind groups compute it once at creation so that adding a
+// bind group to a synchronization scope doesn't need to walk its layout.
+struct BindGroupResourceUsage {
+    std::vector<BufferBase*> buffers;
+    std::vector<BufferSyncInfo> bufferSyncInfos;
+
+    struct TextureRangeUsage {
+        TextureBase* texture;
+        SubresourceRange range;
+        TextureSyncInfo syncInfo;
+    };
+    std::vector<TextureRangeUsage> textureRanges;
+};
+
 // Contains all the resource usage data for a compute pass.
 //
 // Essentially a list of SyncScopeResourceUsage, one per Dispatch as required by the WebGPU
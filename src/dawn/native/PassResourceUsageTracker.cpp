@@ -48,12 +48,29 @@ SyncScopeUsageTracker::~SyncScopeUsageTracker() = default;
 
 SyncScopeUsageTracker& SyncScopeUsageTracker::operator=(SyncScopeUsageTracker&&) = default;
 
+BufferSyncInfo& SyncScopeUsageTracker::GetBufferSyncInfo(BufferBase* buffer) {
+    auto [index, added] = mBuffers.GetOrAdd(buffer);
+    if (added) {
+        mBufferSyncInfos.emplace_back();
+    }
+    return mBufferSyncInfos[index];
+}
+
+TextureSubresourceSyncInfo& SyncScopeUsageTracker::GetTextureSyncInfo(TextureBase* texture) {
+    auto [index, added] = mTextures.GetOrAdd(texture);
+    if (added) {
+        // Initially filled with wgpu::TextureUsage::None and WGPUShaderStage_None.
+        mTextureSyncInfos.emplace_back(
+            texture->GetFormat().aspects, texture->GetArrayLayers(), texture->GetNumMipLevels(),
+            TextureSyncInfo{wgpu::TextureUsage::None, wgpu::ShaderStage::None});
+    }
+    return mTextureSyncInfos[index];
+}
+
 void SyncScopeUsageTracker::BufferUsedAs(BufferBase* buffer,
                                          wgpu::BufferUsage usage,
                                          wgpu::ShaderStage shaderStages) {
-    // absl::flat_hash_map's operator[] will create a new element using the default constructor
-    // if the key didn't exist before.
-    BufferSyncInfo& bufferSyncInfo = mBufferSyncInfos[buffer];
+    BufferSyncInfo& bufferSyncInfo = GetBufferSyncInfo(buffer);
 
     bufferSyncInfo.usage |= usage;
     bufferSyncInfo.shaderStages |= shaderStages;
@@ -69,13 +86,7 @@ void SyncScopeUsageTracker::TextureRangeUsedAs(TextureBase* texture,
                                                const SubresourceRange& range,
                                                wgpu::TextureUsage usage,
                                                wgpu::ShaderStage shaderStages) {
-    // Get or create a new TextureSubresourceSyncInfo for that texture (initially filled with
-    // wgpu::TextureUsage::None and WGPUShaderStage_None)
-    auto it = mTextureSyncInfos.try_emplace(
-        texture, texture->GetFormat().aspects, texture->GetArrayLayers(),
-        texture->GetNumMipLevels(),
-        TextureSyncInfo{wgpu::TextureUsage::None, wgpu::ShaderStage::None});
-    TextureSubresourceSyncInfo& textureSyncInfo = it.first->second;
+    TextureSubresourceSyncInfo& textureSyncInfo = GetTextureSyncInfo(texture);
 
     textureSyncInfo.Update(
         range, [usage, shaderStages](const SubresourceRange&, TextureSyncInfo* storedSyncInfo) {
@@ -87,15 +98,9 @@ void SyncScopeUsageTracker::TextureRangeUsedAs(TextureBase* texture,
 void SyncScopeUsageTracker::AddRenderBundleTextureUsage(
     TextureBase* texture,
     const TextureSubresourceSyncInfo& textureSyncInfo) {
-    // Get or create a new TextureSubresourceSyncInfo for that texture (initially filled with
-    // wgpu::TextureUsage::None and WGPUShaderStage_None)
-    auto it = mTextureSyncInfos.try_emplace(
-        texture, texture->GetFormat().aspects, texture->GetArrayLayers(),
-        texture->GetNumMipLevels(),
-        TextureSyncInfo{wgpu::TextureUsage::None, wgpu::ShaderStage::None});
-    TextureSubresourceSyncInfo* passTextureSyncInfo = &it.first->second;
-
-    passTextureSyncInfo->Merge(
+    TextureSubresourceSyncInfo& passTextureSyncInfo = GetTextureSyncInfo(texture);
+
+    passTextureSyncInfo.Merge(
         textureSyncInfo, [](const SubresourceRange&, TextureSyncInfo* storedSyncInfo,
                             const TextureSyncInfo& addedSyncInfo) {
             DAWN_ASSERT((addedSyncInfo.usage & wgpu::TextureUsage::RenderAttachment) == 0);
@@ -105,67 +110,18 @@ void SyncScopeUsageTracker::AddRenderBundleTextureUsage(
 }
 
 void SyncScopeUsageTracker::AddBindGroup(BindGroupBase* group) {
-    for (BindingIndex bindingIndex{0}; bindingIndex < group->GetLayout()->GetBindingCount();
-         ++bindingIndex) {
-        const BindingInfo& bindingInfo = group->GetLayout()->GetBindingInfo(bindingIndex);
+    if (!mBindGroups.GetOrAdd(group).second) {
+        return;
+    }
 
-        MatchVariant(
-            bindingInfo.bindingLayout,
-            [&](const BufferBindingInfo& layout) {
-                BufferBase* buffer = group->GetBindingAsBufferBinding(bindingIndex).buffer;
-                switch (layout.type) {
-                    case wgpu::BufferBindingType::Uniform:
-                        BufferUsedAs(buffer, wgpu::BufferUsage::Uniform, bindingInfo.visibility);
-                        break;
-                    case wgpu::BufferBindingType::Storage:
-                        BufferUsedAs(buffer, wgpu::BufferUsage::Storage, bindingInfo.visibility);
-                        break;
-                    case kInternalStorageBufferBinding:
-                        BufferUsedAs(buffer, kInternalStorageBuffer, bindingInfo.visibility);
-                        break;
-                    case wgpu::BufferBindingType::ReadOnlyStorage:
-                        BufferUsedAs(buffer, kReadOnlyStorageBuffer, bindingInfo.visibility);
-                        break;
-                    case wgpu::BufferBindingType::Undefined:
-                        DAWN_UNREACHABLE();
-                }
-            },
-            [&](const TextureBindingInfo& layout) {
-                TextureViewBase* view = group->GetBindingAsTextureView(bindingIndex);
-                switch (layout.sampleType) {
-                    case kInternalResolveAttachmentSampleType:
-                        TextureViewUsedAs(view, kResolveAttachmentLoadingUsage,
-                                          bindingInfo.visibility);
-                        break;
-                    default:
-                        TextureViewUsedAs(view, wgpu::TextureUsage::TextureBinding,
-                                          bindingInfo.visibility);
-                        break;
-                }
-            },
-            [&](const StorageTextureBindingInfo& layout) {
-                TextureViewBase* view = group->GetBindingAsTextureView(bindingIndex);
-                switch (layout.access) {
-                    case wgpu::StorageTextureAccess::WriteOnly:
-                        TextureViewUsedAs(view, kWriteOnlyStorageTexture, bindingInfo.visibility);
-                        break;
-                    case wgpu::StorageTextureAccess::ReadWrite:
-                        TextureViewUsedAs(view, wgpu::TextureUsage::StorageBinding,
-                                          bindingInfo.visibility);
-                        break;
-                    case wgpu::StorageTextureAccess::ReadOnly:
-                        TextureViewUsedAs(view, kReadOnlyStorageTexture, bindingInfo.visibility);
-                        break;
-                    case wgpu::StorageTextureAccess::Undefined:
-                        DAWN_UNREACHABLE();
-                }
-            },
-            [&](const SamplerBindingInfo&) {},  //
-            [&](const StaticSamplerBindingInfo&) {},
-            [&](const InputAttachmentBindingInfo&) {
-                // This binding is not supposed to be used on front-end.
-                DAWN_UNREACHABLE();
-            });
+    const BindGroupResourceUsage& usage = group->GetResourceUsage();
+    for (size_t i = 0; i < usage.buffers.size(); ++i) {
+        BufferUsedAs(usage.buffers[i], usage.bufferSyncInfos[i].usage,
+                     usage.bufferSyncInfos[i].shaderStages);
+    }
+    for (const BindGroupResourceUsage::TextureRangeUsage& textureRange : usage.textureRanges) {
+        TextureRangeUsedAs(textureRange.texture, textureRange.range, textureRange.syncInfo.usage,
+                           textureRange.syncInfo.shaderStages);
     }
 
     for (const Ref<ExternalTextureBase>& externalTexture : group->GetBoundExternalTextures()) {
@@ -175,21 +131,12 @@ void SyncScopeUsageTracker::AddBindGroup(BindGroupBase* group) {
 
 SyncScopeResourceUsage SyncScopeUsageTracker::AcquireSyncScopeUsage() {
     SyncScopeResourceUsage result;
-    result.buffers.reserve(mBufferSyncInfos.size());
-    result.bufferSyncInfos.reserve(mBufferSyncInfos.size());
-    result.textures.reserve(mTextureSyncInfos.size());
-    result.textureSyncInfos.reserve(mTextureSyncInfos.size());
-
-    for (auto& [buffer, syncInfo] : mBufferSyncInfos) {
-        result.buffers.push_back(buffer);
-        result.bufferSyncInfos.push_back(std::move(syncInfo));
-    }
-
-    for (auto& [texture, syncInfo] : mTextureSyncInfos) {
-        result.textures.push_back(texture);
-        result.textureSyncInfos.push_back(std::move(syncInfo));
-    }
+    result.buffers = mBuffers.AcquireObjects();
+    result.bufferSyncInfos = std::move(mBufferSyncInfos);
+    result.textures = mTextures.AcquireObjects();
+    result.textureSyncInfos = std::move(mTextureSyncInfos);
 
+    result.externalTextures.reserve(mExternalTextureUsages.size());
     for (auto* const it : mExternalTextureUsages) {
         result.externalTextures.push_back(it);
     }
@@ -197,6 +144,7 @@ SyncScopeResourceUsage SyncScopeUsageTracker::AcquireSyncScopeUsage() {
     mBufferSyncInfos.clear();
     mTextureSyncInfos.clear();
     mExternalTextureUsages.clear();
+    mBindGroups.clear();
 
     return result;
 }
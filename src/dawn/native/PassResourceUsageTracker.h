@@ -28,6 +28,7 @@
 #ifndef SRC_DAWN_NATIVE_PASSRESOURCEUSAGETRACKER_H_
 #define SRC_DAWN_NATIVE_PASSRESOURCEUSAGETRACKER_H_
 
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
@@ -46,6 +47,58 @@ class TextureBase;
 
 using QueryAvailabilityMap = absl::flat_hash_map<QuerySetBase*, std::vector<bool>>;
 
+// Assigns dense indices to objects in the order they are first added. Synchronization scopes
+// usually contain a handful of resources so lookups are a linear search over a contiguous vector,
+// which is cheaper than hashing. Past kMaxLinearSearchSize a hash map index is built instead.
+template <typename T>
+class DenseIndexMap {
+  public:
+    // Returns the index of |object| and whether it was added by this call.
+    std::pair<uint32_t, bool> GetOrAdd(T* object) {
+        if (mIndices.empty()) {
+            for (uint32_t i = 0; i < mObjects.size(); ++i) {
+                if (mObjects[i] == object) {
+                    return {i, false};
+                }
+            }
+            mObjects.push_back(object);
+            if (mObjects.size() > kMaxLinearSearchSize) {
+                mIndices.reserve(mObjects.size());
+                for (uint32_t i = 0; i < mObjects.size(); ++i) {
+                    mIndices.emplace(mObjects[i], i);
+                }
+            }
+            return {static_cast<uint32_t>(mObjects.size() - 1), true};
+        }
+
+        auto [it, inserted] = mIndices.try_emplace(object, static_cast<uint32_t>(mObjects.size()));
+        if (inserted) {
+            mObjects.push_back(object);
+        }
+        return {it->second, inserted};
+    }
+
+    size_t size() const { return mObjects.size(); }
+
+    // Returns the objects in index order and resets the map.
+    std::vector<T*> AcquireObjects() {
+        std::vector<T*> objects = std::move(mObjects);
+        clear();
+        return objects;
+    }
+
+    void clear() {
+        mObjects.clear();
+        mIndices.clear();
+    }
+
+  private:
+    static constexpr size_t kMaxLinearSearchSize = 16;
+
+    std::vector<T*> mObjects;
+    absl::flat_hash_map<T*, uint32_t> mIndices;
+};
+
 // Helper class to build SyncScopeResourceUsages
 class SyncScopeUsageTracker {
   public:
@@ -75,9 +128,19 @@ class SyncScopeUsageTracker {
     SyncScopeResourceUsage AcquireSyncScopeUsage();
 
   private:
-    absl::flat_hash_map<BufferBase*, BufferSyncInfo> mBufferSyncInfos;
-    absl::flat_hash_map<TextureBase*, TextureSubresourceSyncInfo> mTextureSyncInfos;
+    BufferSyncInfo& GetBufferSyncInfo(BufferBase* buffer);
+    TextureSubresourceSyncInfo& GetTextureSyncInfo(TextureBase* texture);
+
+    // Resources get a dense index on first use, which indexes their usage in the vectors below.
+    DenseIndexMap<BufferBase> mBuffers;
+    std::vector<BufferSyncInfo> mBufferSyncInfos;
+    DenseIndexMap<TextureBase> mTextures;
+    std::vector<TextureSubresourceSyncInfo> mTextureSyncInfos;
     absl::flat_hash_set<ExternalTextureBase*> mExternalTextureUsages;
+
+    // Usages are only ever merged together so adding a bind group that is already in the scope
+    // again is a no-op and is skipped.
+    DenseIndexMap<BindGroupBase> mBindGroups;
 };
 
 // Helper class to build ComputePassResourceUsages
@@ -46,6 +46,8 @@ bool PipelineCacheBase::CacheHit() const {
 }
 
 MaybeError PipelineCacheBase::Flush() {
+    std::lock_guard<std::mutex> lock(mFlushMutex);
+
     // Try to write the data out to the persistent cache.
     Blob blob;
     DAWN_TRY(SerializeToBlobImpl(&blob));
@@ -62,7 +64,7 @@ MaybeError PipelineCacheBase::DidCompilePipeline() {
     if (mStoreOnIdle) {
         // Assume pipeline cache was modified by compiling a pipeline. It will be stored in
         // BlobCache at some later point in StoreOnIdle() if necessary.
-        mNeedsStore = true;
+        MarkNeedsStore();
     } else {
         // TODO(dawn:549): Flush is currently synchronously happening on the same thread as pipeline
         // compilation, but it's perhaps deferrable.
@@ -75,11 +77,14 @@ MaybeError PipelineCacheBase::DidCompilePipeline() {
 
 MaybeError PipelineCacheBase::StoreOnIdle() {
     DAWN_ASSERT(mStoreOnIdle);
-    if (mNeedsStore) {
-        mNeedsStore = false;
+    if (mNeedsStore.exchange(false)) {
         DAWN_TRY(Flush());
     }
     return {};
 }
 
+void PipelineCacheBase::MarkNeedsStore() {
+    mNeedsStore = true;
+}
+
 }  // namespace dawn::native
@@ -28,6 +28,9 @@
 #ifndef SRC_DAWN_NATIVE_PIPELINECACHE_H_
 #define SRC_DAWN_NATIVE_PIPELINECACHE_H_
 
+#include <atomic>
+#include <mutex>
+
 #include "dawn/common/RefCounted.h"
 #include "dawn/native/BlobCache.h"
 #include "dawn/native/CacheKey.h"
@@ -44,7 +47,8 @@ class PipelineCacheBase : public RefCounted {
 
     // Serializes and writes the current contents of the backend cache object into the backing
     // blob cache, potentially overwriting what is already there. Useful when we are working
-    // with more monolithic-like caches where we expect overwriting sometimes.
+    // with more monolithic-like caches where we expect overwriting sometimes. Can be called from
+    // worker threads.
     MaybeError Flush();
 
     // Called after pipeline was compiled. The default implementation serializes and writes the
@@ -64,6 +68,10 @@ class PipelineCacheBase : public RefCounted {
     // implementations to get the cache and set the cache hit state. Should only be called once.
     Blob Initialize();
 
+    // Marks the cache as modified so that the next StoreOnIdle() stores it. Can be called from
+    // worker threads.
+    void MarkNeedsStore();
+
   private:
     // Backend implementation of serialization of the cache into a blob.
     // Note: given that no local cached blob should be destructed and copy elision has strict
@@ -78,7 +86,10 @@ class PipelineCacheBase : public RefCounted {
     const bool mStoreOnIdle;
     bool mInitialized = false;
     bool mCacheHit = false;
-    bool mNeedsStore = false;
+    std::atomic<bool> mNeedsStore = false;
+
+    // Serializes the flushes so that an older serialization never overwrites a newer one.
+    std::mutex mFlushMutex;
 };
 
 }  // namespace dawn::native
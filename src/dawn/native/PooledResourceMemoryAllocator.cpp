@@ -72,7 +72,7 @@ void PooledResourceMemoryAllocator::DeallocateResourceHeap(
     mPool.push_front(std::move(allocation));
 }
 
-uint64_t PooledResourceMemoryAllocator::GetPoolSizeForTesting() const {
+uint64_t PooledResourceMemoryAllocator::GetPoolSize() const {
     return mPool.size();
 }
 }  // namespace dawn::native
@@ -53,8 +53,8 @@ class PooledResourceMemoryAllocator : public ResourceHeapAllocator {
 
     void DestroyPool();
 
-    // For testing purposes.
-    uint64_t GetPoolSizeForTesting() const;
+    // The number of heaps available for reuse in the pool.
+    uint64_t GetPoolSize() const;
 
   private:
     raw_ptr<ResourceHeapAllocator> mHeapAllocator = nullptr;
@@ -265,8 +265,7 @@ void QueueBase::APIOnSubmittedWorkDone(WGPUQueueWorkDoneCallback callback, void*
     // The error status depends on the type of error so we let the validation function choose it
     wgpu::QueueWorkDoneStatus status;
     if (GetDevice()->ConsumedError(ValidateOnSubmittedWorkDone(&status))) {
-        GetDevice()->GetCallbackTaskManager()->AddCallbackTask(
-            [callback, status, userdata] { callback(ToAPI(status), userdata); });
+        GetDevice()->GetCallbackTaskManager()->AddCallbackTask(callback, ToAPI(status), userdata);
         return;
     }
 
@@ -418,18 +417,20 @@ void QueueBase::Tick(ExecutionSerial finishedSerial) {
     // are ready to be called.
     for (auto& task : tasks) {
         task->SetFinishedSerial(finishedSerial);
-        GetDevice()->GetCallbackTaskManager()->AddCallbackTask(std::move(task));
     }
+    GetDevice()->GetCallbackTaskManager()->AddCallbackTasks(std::move(tasks));
 }
 
 void QueueBase::HandleDeviceLoss() {
+    std::vector<std::unique_ptr<TrackTaskCallback>> tasks;
     mTasksInFlight.Use([&](auto tasksInFlight) {
         for (auto& task : tasksInFlight->IterateAll()) {
             task->OnDeviceLoss();
-            GetDevice()->GetCallbackTaskManager()->AddCallbackTask(std::move(task));
+            tasks.push_back(std::move(task));
         }
         tasksInFlight->Clear();
     });
+    GetDevice()->GetCallbackTaskManager()->AddCallbackTasks(std::move(tasks));
 }
 
 void QueueBase::APIWriteBuffer(BufferBase* buffer,
@@ -499,6 +500,93 @@ MaybeError QueueBase::WriteTextureImpl(const ImageCopyTexture& destination,
     const Format& format = destination.texture->GetFormat();
     const TexelBlockInfo& blockInfo = format.GetAspectInfo(destination.aspect).block;
 
+    uint64_t bytesPerRow = Align(writeSizePixel.width / blockInfo.width * blockInfo.byteSize,
+                                 GetDevice()->GetOptimalBytesPerRowAlignment());
+    uint64_t uploadSize = bytesPerRow * (writeSizePixel.height / blockInfo.height) *
+                          writeSizePixel.depthOrArrayLayers;
+    if (uploadSize <= DynamicUploader::kUploadChunkSize) {
+        return WriteTextureChunk(destination, data, dataLayout, writeSizePixel);
+    }
+
+    // Each chunk only writes part of the subresources, which would make the first one lazily clear
+    // them. Mark them as initialized upfront instead if they are entirely written, and revert that
+    // if one of the chunks fails so that their content isn't exposed.
+    TextureCopy textureCopy;
+    textureCopy.texture = destination.texture;
+    textureCopy.mipLevel = destination.mipLevel;
+    textureCopy.origin = destination.origin;
+    textureCopy.aspect = ConvertAspect(format, destination.aspect);
+    SubresourceRange range = GetSubresourcesAffectedByCopy(textureCopy, writeSizePixel);
+    bool initializeUpfront =
+        IsCompleteSubresourceCopiedTo(destination.texture, writeSizePixel, destination.mipLevel,
+                                      destination.aspect) &&
+        !destination.texture->IsSubresourceContentInitialized(range);
+    if (initializeUpfront) {
+        destination.texture->SetIsSubresourceContentInitialized(true, range);
+    }
+
+    MaybeError result = WriteTextureInChunks(destination, data, dataLayout, writeSizePixel);
+    if (result.IsError() && initializeUpfront) {
+        destination.texture->SetIsSubresourceContentInitialized(false, range);
+    }
+    return result;
+}
+
+MaybeError QueueBase::WriteTextureInChunks(const ImageCopyTexture& destination,
+                                           const void* data,
+                                           const TextureDataLayout& dataLayout,
+                                           const Extent3D& writeSizePixel) {
+    const TexelBlockInfo& blockInfo =
+        destination.texture->GetFormat().GetAspectInfo(destination.aspect).block;
+    uint64_t uploadBytesPerRow = Align(writeSizePixel.width / blockInfo.width * blockInfo.byteSize,
+                                       GetDevice()->GetOptimalBytesPerRowAlignment());
+    uint32_t heightInBlocks = writeSizePixel.height / blockInfo.height;
+    uint64_t uploadBytesPerImage = uploadBytesPerRow * heightInBlocks;
+    uint64_t dataBytesPerImage = uint64_t(dataLayout.bytesPerRow) * dataLayout.rowsPerImage;
+
+    // Chunks are made of whole images when they fit, otherwise of rows of a single image.
+    uint32_t imagesPerChunk = 1;
+    uint32_t rowsPerChunk = heightInBlocks;
+    if (uploadBytesPerImage <= DynamicUploader::kUploadChunkSize) {
+        imagesPerChunk = DynamicUploader::kUploadChunkSize / uploadBytesPerImage;
+    } else {
+        rowsPerChunk = std::max(DynamicUploader::kUploadChunkSize / uploadBytesPerRow, uint64_t(1));
+    }
+
+    bool isFirstChunk = true;
+    for (uint32_t image = 0; image < writeSizePixel.depthOrArrayLayers; image += imagesPerChunk) {
+        for (uint32_t row = 0; row < heightInBlocks; row += rowsPerChunk) {
+            if (!isFirstChunk) {
+                DAWN_TRY(GetDevice()->GetDynamicUploader()->OnUploadChunkRecorded());
+            }
+            isFirstChunk = false;
+
+            ImageCopyTexture chunkDestination = destination;
+            chunkDestination.origin.y += row * blockInfo.height;
+            chunkDestination.origin.z += image;
+
+            TextureDataLayout chunkDataLayout = dataLayout;
+            chunkDataLayout.offset +=
+                image * dataBytesPerImage + uint64_t(row) * dataLayout.bytesPerRow;
+
+            Extent3D chunkSize = writeSizePixel;
+            chunkSize.height = std::min(rowsPerChunk, heightInBlocks - row) * blockInfo.height;
+            chunkSize.depthOrArrayLayers =
+                std::min(imagesPerChunk, writeSizePixel.depthOrArrayLayers - image);
+
+            DAWN_TRY(WriteTextureChunk(chunkDestination, data, chunkDataLayout, chunkSize));
+        }
+    }
+    return {};
+}
+
+MaybeError QueueBase::WriteTextureChunk(const ImageCopyTexture& destination,
+                                        const void* data,
+                                        const TextureDataLayout& dataLayout,
+                                        const Extent3D& writeSizePixel) {
+    const Format& format = destination.texture->GetFormat();
+    const TexelBlockInfo& blockInfo = format.GetAspectInfo(destination.aspect).block;
+
     // We are only copying the part of the data that will appear in the texture.
     // Note that validating texture copy range ensures that writeSizePixel->width and
     // writeSizePixel->height are multiples of blockWidth and blockHeight respectively.
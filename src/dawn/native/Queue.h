@@ -133,6 +133,14 @@ class QueueBase : public ApiObjectBase, public ExecutionQueueBase {
                                     size_t dataSize,
                                     const TextureDataLayout& dataLayout,
                                     const Extent3D* writeSize);
+    MaybeError WriteTextureInChunks(const ImageCopyTexture& destination,
+                                    const void* data,
+                                    const TextureDataLayout& dataLayout,
+                                    const Extent3D& writeSizePixel);
+    MaybeError WriteTextureChunk(const ImageCopyTexture& destination,
+                                 const void* data,
+                                 const TextureDataLayout& dataLayout,
+                                 const Extent3D& writeSizePixel);
     MaybeError CopyTextureForBrowserInternal(const ImageCopyTexture* source,
                                              const ImageCopyTexture* destination,
                                              const Extent3D* copySize,
@@ -174,9 +174,9 @@ ResultOrError<Ref<RenderBundleBase>> RenderBundleEncoder::Finish(
         DAWN_TRY(ValidateFinish(usages));
     }
 
-    return AcquireRef(new RenderBundleBase(this, descriptor, AcquireAttachmentState(),
+    return GetDevice()->CreateRenderBundle(this, descriptor, AcquireAttachmentState(),
                                            IsDepthReadOnly(), IsStencilReadOnly(),
-                                           std::move(usages), std::move(mIndirectDrawMetadata)));
+                                           std::move(usages), std::move(mIndirectDrawMetadata));
 }
 
 MaybeError RenderBundleEncoder::ValidateFinish(const RenderPassResourceUsage& usages) const {
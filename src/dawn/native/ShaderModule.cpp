@@ -353,11 +353,14 @@ ResultOrError<PixelLocalMemberType> FromTintPixelLocalMemberType(
 ResultOrError<tint::Program> ParseWGSL(const tint::Source::File* file,
                                        const tint::wgsl::AllowedFeatures& allowedFeatures,
                                        const std::vector<tint::wgsl::Extension>& internalExtensions,
+                                       bool parallelUniformityAnalysis,
                                        OwnedCompilationMessages* outMessages) {
     tint::wgsl::reader::Options options;
     options.allowed_features = allowedFeatures;
     options.allowed_features.extensions.insert(internalExtensions.begin(),
                                                internalExtensions.end());
+    // 0 uses one thread per hardware thread.
+    options.max_resolver_threads = parallelUniformityAnalysis ? 0 : 1;
     tint::Program program = tint::wgsl::reader::Parse(file, options);
     if (outMessages != nullptr) {
         DAWN_TRY(outMessages->AddMessages(program.Diagnostics()));
@@ -1202,8 +1205,10 @@ MaybeError ValidateAndParseShaderModule(
     }
 
     tint::Program program;
-    DAWN_TRY_ASSIGN(program, ParseWGSL(tintFile.get(), device->GetWGSLAllowedFeatures(),
-                                       internalExtensions, outMessages));
+    DAWN_TRY_ASSIGN(program,
+                    ParseWGSL(tintFile.get(), device->GetWGSLAllowedFeatures(), internalExtensions,
+                              device->IsToggleEnabled(Toggle::ParallelWGSLUniformityAnalysis),
+                              outMessages));
 
     parseResult->tintProgram = AcquireRef(new TintProgram(std::move(program), std::move(tintFile)));
 
@@ -1397,6 +1402,9 @@ ShaderModuleBase::~ShaderModuleBase() = default;
 
 void ShaderModuleBase::DestroyImpl() {
     Uncache();
+    if (!mCanonicalProgramKey.empty()) {
+        GetDevice()->UncacheShaderModuleByProgram(this);
+    }
 }
 
 // static
@@ -1449,6 +1457,91 @@ bool ShaderModuleBase::EqualityFunc::operator()(const ShaderModuleBase* a,
            a->mStrictMath == b->mStrictMath;
 }
 
+std::string ShaderModuleBase::ComputeCanonicalProgramKey(const tint::Program& program) const {
+#if TINT_BUILD_WGSL_WRITER
+    // Programs read from SPIR-V use internal attributes that can't be printed back to WGSL.
+    if (mType != Type::Wgsl) {
+        return std::string();
+    }
+
+    std::ostringstream key;
+    key << "strict_math:" << (mStrictMath ? (*mStrictMath ? "true" : "false") : "default") << "\n";
+    for (tint::wgsl::Extension extension : mInternalExtensions) {
+        key << "internal_extension:" << tint::wgsl::ToString(extension) << "\n";
+    }
+
+    // Entry point and override names are used by the API so they are kept as is, and also written
+    // to the key in case the renamer had to change them to avoid a collision. All the other
+    // declarations are renamed in the order they are used.
+    tint::inspector::Inspector inspector(program);
+    std::vector<tint::inspector::EntryPoint> entryPoints = inspector.GetEntryPoints();
+    tint::ast::transform::Renamer::Remappings apiVisibleNames;
+    for (const tint::inspector::EntryPoint& entryPoint : entryPoints) {
+        apiVisibleNames.emplace(entryPoint.name, entryPoint.name);
+        for (const tint::inspector::Override& override : entryPoint.overrides) {
+            apiVisibleNames.emplace(override.name, override.name);
+        }
+    }
+
+    // Each entry point is stripped down to the declarations it uses, so that unused functions,
+    // bindings and overrides don't change the key.
+    for (const tint::inspector::EntryPoint& entryPoint : entryPoints) {
+        key << "entry_point:" << entryPoint.name << "\n";
+        for (const tint::inspector::Override& override : entryPoint.overrides) {
+            key << "override:" << override.name << "\n";
+        }
+
+        tint::ast::transform::Manager transformManager;
+        tint::ast::transform::DataMap transformInputs;
+        transformManager.Add<tint::ast::transform::SingleEntryPoint>();
+        transformInputs.Add<tint::ast::transform::SingleEntryPoint::Config>(entryPoint.name);
+        transformManager.Add<tint::ast::transform::Renamer>();
+        transformInputs.Add<tint::ast::transform::Renamer::Config>(
+            tint::ast::transform::Renamer::Target::kAll, /* preserve_unicode */ false,
+            tint::ast::transform::Renamer::Remappings(apiVisibleNames));
+
+        tint::ast::transform::DataMap transformOutputs;
+        tint::Program canonicalProgram =
+            transformManager.Run(program, transformInputs, transformOutputs);
+        if (!canonicalProgram.IsValid()) {
+            return std::string();
+        }
+
+        auto result = tint::wgsl::writer::Generate(canonicalProgram, {});
+        if (result != tint::Success) {
+            return std::string();
+        }
+        key << result->wgsl;
+    }
+    return key.str();
+#else
+    return std::string();
+#endif  // TINT_BUILD_WGSL_WRITER
+}
+
+void ShaderModuleBase::SetCanonicalProgramKey(std::string key) {
+    mCanonicalProgramKey = std::move(key);
+}
+
+const std::string& ShaderModuleBase::GetCanonicalProgramKey() const {
+    return mCanonicalProgramKey;
+}
+
+std::string ShaderModuleBase::ComputeContentAliasKey() const {
+    if (mType != Type::Wgsl) {
+        return std::string();
+    }
+    std::string key = "strict_math:";
+    key += mStrictMath ? (*mStrictMath ? "true" : "false") : "default";
+    key += "\n";
+    key += mWgsl;
+    return key;
+}
+
+std::vector<std::string>& ShaderModuleBase::GetContentAliasKeys() {
+    return mContentAliasKeys;
+}
+
 ShaderModuleBase::ScopedUseTintProgram ShaderModuleBase::UseTintProgram() {
     return mTintData.Use([&](auto tintData) {
         if (tintData->tintProgram) {
@@ -325,6 +325,20 @@ class ShaderModuleBase : public RefCountedWithExternalCount<ApiObjectBase>,
         bool operator()(const ShaderModuleBase* a, const ShaderModuleBase* b) const;
     };
 
+    // Canonical form of the shader, used by the device to share a single ShaderModuleBase between
+    // WGSL shaders that only differ in formatting, comments, the names of declarations that aren't
+    // visible to the API, or declarations that no entry point uses. It is built from the module's
+    // descriptor and the parsed `program`, and is empty if the module can't be deduplicated.
+    std::string ComputeCanonicalProgramKey(const tint::Program& program) const;
+    void SetCanonicalProgramKey(std::string key);
+    const std::string& GetCanonicalProgramKey() const;
+
+    // Key of the descriptor content compared by EqualityFunc, used by the device to map other
+    // descriptors with the same canonical program to this module. Empty for non-WGSL modules.
+    std::string ComputeContentAliasKey() const;
+    // The alias keys mapped to this module, only accessed with the device's alias cache locked.
+    std::vector<std::string>& GetContentAliasKeys();
+
     std::optional<bool> GetStrictMath() const;
 
     using ScopedUseTintProgram = APIRef<ShaderModuleBase>;
@@ -375,6 +389,9 @@ class ShaderModuleBase : public RefCountedWithExternalCount<ApiObjectBase>,
     std::unique_ptr<OwnedCompilationMessages> mCompilationMessages;
 
     const std::vector<tint::wgsl::Extension> mInternalExtensions;
+
+    std::string mCanonicalProgramKey;
+    std::vector<std::string> mContentAliasKeys;
 };
 
 }  // namespace dawn::native
@@ -92,6 +92,11 @@ struct ToBackendTraits<QueueBase, BackendTraits> {
     using BackendType = typename BackendTraits::QueueType;
 };
 
+template <typename BackendTraits>
+struct ToBackendTraits<RenderBundleBase, BackendTraits> {
+    using BackendType = typename BackendTraits::RenderBundleType;
+};
+
 template <typename BackendTraits>
 struct ToBackendTraits<RenderPipelineBase, BackendTraits> {
     using BackendType = typename BackendTraits::RenderPipelineType;
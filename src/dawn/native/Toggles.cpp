@@ -603,6 +603,55 @@ static constexpr ToggleEnumAndInfoList kToggleNameAndInfoList = {{
       "Don't validate the required VkImage size against the size of the AHardwareBuffer on import. "
       "Some drivers report the wrong size.",
       "https://crbug.com/333424893", ToggleStage::Device}},
+    {Toggle::DedupShaderModulesByProgram,
+     {"dedup_shader_modules_by_program",
+      "Share one shader module between WGSL shaders that only differ in whitespace, comments, the "
+      "names of declarations that aren't visible to the API, or declarations that no entry point "
+      "uses. Shaders that miss the descriptor cache are canonicalized after parsing and looked up "
+      "by their canonical form before creating a new shader module.",
+      "https://crbug.com/dawn/1481", ToggleStage::Device}},
+    {Toggle::VulkanUseSecondaryCommandBuffersForRenderBundles,
+     {"vulkan_use_secondary_command_buffers_for_render_bundles",
+      "Record render bundles once in secondary command buffers that are reused every time they "
+      "are executed, instead of recording the commands of the bundles again in each render pass. "
+      "Only render passes that contain nothing but ExecuteBundles use secondary command buffers.",
+      "https://crbug.com/dawn/1601", ToggleStage::Device}},
+    {Toggle::VulkanDefragmentMemoryOnIdle,
+     {"vulkan_defragment_memory_on_idle",
+      "Move the buffers that are only used in copies out of the memory heaps in which at most a "
+      "quarter of the memory is used and that only contain such buffers, with GPU copies "
+      "recorded when PerformIdleTasks() is called, so that these heaps can be released. Free "
+      "heaps kept for reuse are also released when they stay unused during several calls.",
+      "https://crbug.com/dawn/849", ToggleStage::Device}},
+    {Toggle::VulkanMergePipelineCaches,
+     {"vulkan_merge_pipeline_caches",
+      "With vulkan_monolithic_pipeline_cache, compile each pipeline with its own VkPipelineCache "
+      "and merge it into the monolithic VkPipelineCache on a worker thread, which also stores it "
+      "to BlobCache once enough data was merged. Concurrent pipeline compilations don't contend "
+      "on the monolithic VkPipelineCache and don't serialize it.",
+      "https://crbug.com/370343334", ToggleStage::Device}},
+    {Toggle::TintOptimizeIR,
+     {"tint_optimize_ir",
+      "Run Tint's core IR Optimize transform (store-to-load forwarding, constant folding, common "
+      "subexpression elimination and dead code elimination) before generating SPIR-V, or HLSL "
+      "and MSL when use_tint_ir is enabled. The AST code paths of the HLSL and MSL writers don't "
+      "run it.",
+      "https://issues.chromium.org/savedsearches/6783217", ToggleStage::Device}},
+    {Toggle::WaitForInFlightUploadChunks,
+     {"wait_for_in_flight_upload_chunks",
+      "When WriteBuffer or WriteTexture upload their data in several chunks, wait for the GPU to "
+      "complete the copies of the previous chunks once more than 16MB of them are in flight, so "
+      "that the next chunks reuse their staging memory. Each wait is bounded to 100ms, but blocks "
+      "the call with the device lock held. Otherwise more staging memory is allocated, and "
+      "reclaimed by the next Submit or device tick.",
+      "https://crbug.com/dawn/828", ToggleStage::Device}},
+    {Toggle::ParallelWGSLUniformityAnalysis,
+     {"parallel_wgsl_uniformity_analysis",
+      "Analyze the uniformity of the functions of WGSL shader modules on one thread per hardware "
+      "thread, for modules with at least 16 functions. Functions are analyzed once their callees "
+      "are, and the diagnostics are the same as with the serial analysis. The rest of the parsing "
+      "and resolving of the module stays on the calling thread.",
+      "https://gpuweb.github.io/gpuweb/wgsl/#uniformity", ToggleStage::Device}},
     // Comment to separate the }} so it is clearer what to copy-paste to add a toggle.
 }};
 }  // anonymous namespace
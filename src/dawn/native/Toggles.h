@@ -147,6 +147,13 @@ enum class Toggle {
 
     D3D11UseUnmonitoredFence,
     IgnoreImportedAHardwareBufferVulkanImageSize,
+    DedupShaderModulesByProgram,
+    VulkanUseSecondaryCommandBuffersForRenderBundles,
+    VulkanDefragmentMemoryOnIdle,
+    VulkanMergePipelineCaches,
+    TintOptimizeIR,
+    WaitForInFlightUploadChunks,
+    ParallelWGSLUniformityAnalysis,
 
     EnumCount,
     InvalidEnum = EnumCount,
@@ -290,6 +290,7 @@ ResultOrError<CacheResult<MslCompilation>> TranslateToMSL(
     req.use_tint_ir = device->IsToggleEnabled(Toggle::UseTintIR);
     req.tintOptions.disable_polyfill_integer_div_mod =
         device->IsToggleEnabled(Toggle::DisablePolyfillsOnIntegerDivisonAndModulo);
+    req.tintOptions.optimize_ir = device->IsToggleEnabled(Toggle::TintOptimizeIR);
 
     const CombinedLimits& limits = device->GetLimits();
     req.limits = LimitsForCompilationRequest::Create(limits.v1);
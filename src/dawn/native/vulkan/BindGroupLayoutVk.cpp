@@ -27,7 +27,10 @@
 
 #include "dawn/native/vulkan/BindGroupLayoutVk.h"
 
+#include <cstddef>
 #include <utility>
+#include <variant>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "dawn/common/BitSetIterator.h"
@@ -221,11 +224,75 @@ MaybeError BindGroupLayout::Initialize() {
     mDescriptorSetAllocator =
         DescriptorSetAllocator::Create(device, std::move(descriptorCountPerType));
 
+    if (device->GetDeviceInfo().HasExt(DeviceExt::DescriptorUpdateTemplate)) {
+        DAWN_TRY(InitializeDescriptorUpdateTemplate());
+    }
+
     SetLabelImpl();
 
     return {};
 }
 
+MaybeError BindGroupLayout::InitializeDescriptorUpdateTemplate() {
+    // Each descriptor of the set is written from the DescriptorInfo at the BindingIndex of the
+    // Dawn binding, so the same template works for all the bind groups of this layout.
+    std::vector<VkDescriptorUpdateTemplateEntry> entries;
+    entries.reserve(static_cast<size_t>(GetBindingCount()));
+
+    for (BindingIndex bindingIndex : Range(GetBindingCount())) {
+        const BindingInfo& bindingInfo = GetBindingInfo(bindingIndex);
+        if (std::holds_alternative<StaticSamplerBindingInfo>(bindingInfo.bindingLayout)) {
+            // Static samplers are immutable samplers of the VkDescriptorSetLayout. When they are
+            // combined with a texture, the descriptor is written by the texture's entry instead.
+            continue;
+        }
+
+        VkDescriptorUpdateTemplateEntry entry;
+        entry.dstBinding = static_cast<uint32_t>(bindingIndex);
+        entry.dstArrayElement = 0;
+        entry.descriptorCount = 1;
+        entry.descriptorType = VulkanDescriptorType(bindingInfo);
+        entry.stride = sizeof(DescriptorInfo);
+
+        size_t infoOffset = offsetof(DescriptorInfo, image);
+        if (std::holds_alternative<BufferBindingInfo>(bindingInfo.bindingLayout)) {
+            infoOffset = offsetof(DescriptorInfo, buffer);
+        }
+        entry.offset = static_cast<size_t>(bindingIndex) * sizeof(DescriptorInfo) + infoOffset;
+
+        if (auto samplerIndex = GetStaticSamplerIndexForTexture(bindingIndex)) {
+            entry.dstBinding = static_cast<uint32_t>(samplerIndex.value());
+            entry.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        }
+
+        entries.push_back(entry);
+    }
+
+    if (entries.empty()) {
+        return {};
+    }
+
+    VkDescriptorUpdateTemplateCreateInfo createInfo;
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0;
+    createInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+    createInfo.pDescriptorUpdateEntries = entries.data();
+    createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    createInfo.descriptorSetLayout = mHandle;
+    // The remaining members are only used for push descriptor templates.
+    createInfo.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    createInfo.pipelineLayout = VK_NULL_HANDLE;
+    createInfo.set = 0;
+
+    Device* device = ToBackend(GetDevice());
+    DAWN_TRY(CheckVkSuccess(
+        device->fn.CreateDescriptorUpdateTemplate(device->GetVkDevice(), &createInfo, nullptr,
+                                                  &*mDescriptorUpdateTemplate),
+        "CreateDescriptorUpdateTemplate"));
+    return {};
+}
+
 BindGroupLayout::BindGroupLayout(DeviceBase* device, const BindGroupLayoutDescriptor* descriptor)
     : BindGroupLayoutInternalBase(device, descriptor),
       mBindGroupAllocator(MakeFrontendBindGroupAllocator<BindGroup>(4096)) {}
@@ -247,6 +314,12 @@ void BindGroupLayout::DestroyImpl() {
         device->fn.DestroyDescriptorSetLayout(device->GetVkDevice(), mHandle, nullptr);
         mHandle = VK_NULL_HANDLE;
     }
+    // Like the VkDescriptorSetLayout, the template is only used on the host.
+    if (mDescriptorUpdateTemplate != VK_NULL_HANDLE) {
+        device->fn.DestroyDescriptorUpdateTemplate(device->GetVkDevice(),
+                                                   mDescriptorUpdateTemplate, nullptr);
+        mDescriptorUpdateTemplate = VK_NULL_HANDLE;
+    }
     mDescriptorSetAllocator = nullptr;
 }
 
@@ -254,21 +327,71 @@ VkDescriptorSetLayout BindGroupLayout::GetHandle() const {
     return mHandle;
 }
 
+VkDescriptorUpdateTemplate BindGroupLayout::GetDescriptorUpdateTemplate() const {
+    return mDescriptorUpdateTemplate;
+}
+
 ResultOrError<Ref<BindGroup>> BindGroupLayout::AllocateBindGroup(
     Device* device,
     const BindGroupDescriptor* descriptor) {
-    DescriptorSetAllocation descriptorSetAllocation;
-    DAWN_TRY_ASSIGN(descriptorSetAllocation, mDescriptorSetAllocator->Allocate(this));
-
-    return AcquireRef(mBindGroupAllocator->Allocate(device, descriptor, descriptorSetAllocation));
+    Ref<BindGroup> bindGroup = AcquireRef(mBindGroupAllocator->Allocate(device, descriptor));
+    DAWN_TRY(bindGroup->Initialize());
+    return bindGroup;
 }
 
 void BindGroupLayout::DeallocateBindGroup(BindGroup* bindGroup,
                                           DescriptorSetAllocation* descriptorSetAllocation) {
-    mDescriptorSetAllocator->Deallocate(descriptorSetAllocation);
+    // Shared descriptor sets are already released, and the allocation is empty if the bind group
+    // failed to initialize.
+    if (descriptorSetAllocation->set != VK_NULL_HANDLE) {
+        mDescriptorSetAllocator->Deallocate(descriptorSetAllocation);
+    }
     mBindGroupAllocator->Deallocate(bindGroup);
 }
 
+ResultOrError<DescriptorSetAllocation> BindGroupLayout::AllocateDescriptorSet() {
+    return mDescriptorSetAllocator->Allocate(this);
+}
+
+ResultOrError<DescriptorSetAllocation> BindGroupLayout::AcquireSharedDescriptorSet(
+    const DescriptorSetContentsKey& key,
+    const std::function<void(VkDescriptorSet)>& writeDescriptors) {
+    return mSharedDescriptorSets.Use(
+        [&](auto sharedDescriptorSets) -> ResultOrError<DescriptorSetAllocation> {
+            auto it = sharedDescriptorSets->find(key);
+            if (it != sharedDescriptorSets->end()) {
+                it->second.refCount++;
+                return it->second.allocation;
+            }
+
+            // Write the descriptors while holding the lock so that no other bind group can
+            // see the set before it is complete.
+            DescriptorSetAllocation allocation;
+            DAWN_TRY_ASSIGN(allocation, mDescriptorSetAllocator->Allocate(this));
+            writeDescriptors(allocation.set);
+            sharedDescriptorSets->emplace(key, SharedDescriptorSet{allocation, 1});
+            return allocation;
+        });
+}
+
+void BindGroupLayout::ReleaseSharedDescriptorSet(
+    const DescriptorSetContentsKey& key,
+    DescriptorSetAllocation* descriptorSetAllocation) {
+    mSharedDescriptorSets.Use([&](auto sharedDescriptorSets) {
+        auto it = sharedDescriptorSets->find(key);
+        DAWN_ASSERT(it != sharedDescriptorSets->end());
+        DAWN_ASSERT(it->second.allocation.set == descriptorSetAllocation->set);
+
+        // The objects in the key are kept alive by the bind groups sharing the set, so the key
+        // can't be reused for different contents until the last of them is destroyed.
+        if (--it->second.refCount == 0) {
+            mDescriptorSetAllocator->Deallocate(&it->second.allocation);
+            sharedDescriptorSets->erase(it);
+        }
+    });
+    *descriptorSetAllocation = {};
+}
+
 std::optional<BindingIndex> BindGroupLayout::GetStaticSamplerIndexForTexture(
     BindingIndex textureBinding) const {
     if (mTextureToStaticSamplerIndices.contains(textureBinding)) {
@@ -28,8 +28,11 @@
 #ifndef SRC_DAWN_NATIVE_VULKAN_BINDGROUPLAYOUTVK_H_
 #define SRC_DAWN_NATIVE_VULKAN_BINDGROUPLAYOUTVK_H_
 
+#include <functional>
+#include <optional>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "dawn/common/MutexProtected.h"
 #include "dawn/common/SlabAllocator.h"
 #include "dawn/common/vulkan_platform.h"
@@ -48,6 +51,13 @@ class Device;
 
 VkDescriptorType VulkanDescriptorType(const BindingInfo& bindingInfo);
 
+// The descriptor info for one binding of a bind group, indexed by BindingIndex. The descriptor
+// update template of the layout reads either the image or the buffer info of each entry.
+struct DescriptorInfo {
+    VkDescriptorImageInfo image;
+    VkDescriptorBufferInfo buffer;
+};
+
 // In Vulkan descriptor pools have to be sized to an exact number of descriptors. This means
 // it's hard to have something where we can mix different types of descriptor sets because
 // we don't know if their vector of number of descriptors will be similar.
@@ -60,6 +70,10 @@ VkDescriptorType VulkanDescriptorType(const BindingInfo& bindingInfo);
 // the pools are reused when no longer used. Minimizing the number of descriptor pool allocation
 // is important because creating them can incur GPU memory allocation which is usually an
 // expensive syscall.
+//
+// Bind groups with identical contents share a single descriptor set that the layout keeps
+// reference counted. Descriptor sets are written with a descriptor update template computed once
+// per layout when VK_KHR_descriptor_update_template is available.
 class BindGroupLayout final : public BindGroupLayoutInternalBase {
   public:
     static ResultOrError<Ref<BindGroupLayout>> Create(Device* device,
@@ -74,6 +88,22 @@ class BindGroupLayout final : public BindGroupLayoutInternalBase {
     void DeallocateBindGroup(BindGroup* bindGroup,
                              DescriptorSetAllocation* descriptorSetAllocation);
 
+    // Allocates a descriptor set that is owned by a single bind group.
+    ResultOrError<DescriptorSetAllocation> AllocateDescriptorSet();
+
+    // Returns the descriptor set of the live bind groups that have the contents `key`, or
+    // allocates a new one and calls `writeDescriptors` on it. The set is released with
+    // ReleaseSharedDescriptorSet once for each successful call.
+    ResultOrError<DescriptorSetAllocation> AcquireSharedDescriptorSet(
+        const DescriptorSetContentsKey& key,
+        const std::function<void(VkDescriptorSet)>& writeDescriptors);
+    void ReleaseSharedDescriptorSet(const DescriptorSetContentsKey& key,
+                                    DescriptorSetAllocation* descriptorSetAllocation);
+
+    // The template updating every descriptor of the set from an array of DescriptorInfo, or
+    // VK_NULL_HANDLE if descriptor update templates aren't supported.
+    VkDescriptorUpdateTemplate GetDescriptorUpdateTemplate() const;
+
     // If the client specified that the texture at `textureBinding` should be
     // combined with a static sampler, returns the binding index of the static
     // sampler that is sampling this texture.
@@ -82,6 +112,7 @@ class BindGroupLayout final : public BindGroupLayoutInternalBase {
   private:
     ~BindGroupLayout() override;
     MaybeError Initialize();
+    MaybeError InitializeDescriptorUpdateTemplate();
     void DestroyImpl() override;
 
     // Dawn API
@@ -92,9 +123,17 @@ class BindGroupLayout final : public BindGroupLayoutInternalBase {
     absl::flat_hash_map<BindingIndex, BindingIndex> mTextureToStaticSamplerIndices;
 
     VkDescriptorSetLayout mHandle = VK_NULL_HANDLE;
+    VkDescriptorUpdateTemplate mDescriptorUpdateTemplate = VK_NULL_HANDLE;
 
     MutexProtected<SlabAllocator<BindGroup>> mBindGroupAllocator;
     Ref<DescriptorSetAllocator> mDescriptorSetAllocator;
+
+    struct SharedDescriptorSet {
+        DescriptorSetAllocation allocation;
+        uint32_t refCount;
+    };
+    MutexProtected<absl::flat_hash_map<DescriptorSetContentsKey, SharedDescriptorSet>>
+        mSharedDescriptorSets;
 };
 
 }  // namespace dawn::native::vulkan
@@ -50,34 +50,27 @@ ResultOrError<Ref<BindGroup>> BindGroup::Create(Device* device,
         ->AllocateBindGroup(device, descriptor);
 }
 
-BindGroup::BindGroup(Device* device,
-                     const BindGroupDescriptor* descriptor,
-                     DescriptorSetAllocation descriptorSetAllocation)
-    : BindGroupBase(this, device, descriptor), mDescriptorSetAllocation(descriptorSetAllocation) {
-    // Now do a write of a single descriptor set with all possible chained data allocated on the
-    // stack.
-    const uint32_t bindingCount = static_cast<uint32_t>((GetLayout()->GetBindingCount()));
-    ityp::stack_vec<uint32_t, VkWriteDescriptorSet, kMaxOptimalBindingsPerGroup> writes(
-        bindingCount);
-    ityp::stack_vec<uint32_t, VkDescriptorBufferInfo, kMaxOptimalBindingsPerGroup> writeBufferInfo(
+BindGroup::BindGroup(Device* device, const BindGroupDescriptor* descriptor)
+    : BindGroupBase(this, device, descriptor) {}
+
+MaybeError BindGroup::Initialize() {
+    Device* device = ToBackend(GetDevice());
+    BindGroupLayout* layout = ToBackend(GetLayout());
+
+    // Gather the info of all the descriptors on the stack, at the BindingIndex of each binding
+    // as expected by the layout's descriptor update template.
+    const BindingIndex bindingCount = layout->GetBindingCount();
+    ityp::stack_vec<BindingIndex, DescriptorInfo, kMaxOptimalBindingsPerGroup> infos(
         bindingCount);
-    ityp::stack_vec<uint32_t, VkDescriptorImageInfo, kMaxOptimalBindingsPerGroup> writeImageInfo(
+    ityp::stack_vec<BindingIndex, bool, kMaxOptimalBindingsPerGroup> shouldWriteDescriptor(
         bindingCount);
 
-    uint32_t numWrites = 0;
-    for (BindingIndex bindingIndex : Range(GetLayout()->GetBindingCount())) {
-        const BindingInfo& bindingInfo = GetLayout()->GetBindingInfo(bindingIndex);
-
-        auto& write = writes[numWrites];
-        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        write.pNext = nullptr;
-        write.dstSet = GetHandle();
-        write.dstBinding = static_cast<uint32_t>(bindingIndex);
-        write.dstArrayElement = 0;
-        write.descriptorCount = 1;
-        write.descriptorType = VulkanDescriptorType(bindingInfo);
+    bool hasDestroyedResource = false;
+    for (BindingIndex bindingIndex : Range(bindingCount)) {
+        const BindingInfo& bindingInfo = layout->GetBindingInfo(bindingIndex);
+        DescriptorInfo& info = infos[bindingIndex];
 
-        bool shouldWriteDescriptor = MatchVariant(
+        shouldWriteDescriptor[bindingIndex] = MatchVariant(
             bindingInfo.bindingLayout,
             [&](const BufferBindingInfo&) -> bool {
                 BufferBinding binding = GetBindingAsBufferBinding(bindingIndex);
@@ -88,21 +81,20 @@ BindGroup::BindGroup(Device* device,
                     // a Vulkan Validation Layers error. This bind group won't be used as it
                     // is an error to submit a command buffer that references destroyed
                     // resources.
+                    hasDestroyedResource = true;
                     return false;
                 }
-                writeBufferInfo[numWrites].buffer = handle;
-                writeBufferInfo[numWrites].offset = binding.offset;
-                writeBufferInfo[numWrites].range = binding.size;
-                write.pBufferInfo = &writeBufferInfo[numWrites];
+                info.buffer.buffer = handle;
+                info.buffer.offset = binding.offset;
+                info.buffer.range = binding.size;
                 return true;
             },
             [&](const SamplerBindingInfo&) -> bool {
                 Sampler* sampler = ToBackend(GetBindingAsSampler(bindingIndex));
-                writeImageInfo[numWrites].sampler = sampler->GetHandle();
-                write.pImageInfo = &writeImageInfo[numWrites];
+                info.image.sampler = sampler->GetHandle();
                 return true;
             },
-            [&](const StaticSamplerBindingInfo& layout) -> bool {
+            [&](const StaticSamplerBindingInfo&) -> bool {
                 // Static samplers are bound into the Vulkan layout as immutable
                 // samplers at BindGroupLayout creation time. There is no work
                 // to be done at BindGroup creation time.
@@ -118,27 +110,12 @@ BindGroup::BindGroup(Device* device,
                     // a Vulkan Validation Layers error. This bind group won't be used as it
                     // is an error to submit a command buffer that references destroyed
                     // resources.
+                    hasDestroyedResource = true;
                     return false;
                 }
-
-                // TODO(crbug.com/41488897: Add GetVkDescriptorSet{Index,
-                // Type}(BindingIndex) functions to BindGroupLayoutVk that
-                // access vectors holding entries for all BGL entries and
-                // eliminate this special-case code in favor of calling those
-                // functions to assign `dstBinding` and `descriptorType` above.
-                if (auto samplerIndex =
-                        ToBackend(GetLayout())->GetStaticSamplerIndexForTexture(bindingIndex)) {
-                    // Write the info of the texture at the binding index for the
-                    // sampler.
-                    write.dstBinding = static_cast<uint32_t>(samplerIndex.value());
-                    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-                }
-
-                writeImageInfo[numWrites].imageView = handle;
-                writeImageInfo[numWrites].imageLayout = VulkanImageLayout(
-                    view->GetTexture()->GetFormat(), wgpu::TextureUsage::TextureBinding);
-
-                write.pImageInfo = &writeImageInfo[numWrites];
+                info.image.imageView = handle;
+                info.image.imageLayout = VulkanImageLayout(view->GetTexture()->GetFormat(),
+                                                           wgpu::TextureUsage::TextureBinding);
                 return true;
             },
             [&](const StorageTextureBindingInfo&) -> bool {
@@ -156,12 +133,11 @@ BindGroup::BindGroup(Device* device,
                     // a Vulkan Validation Layers error. This bind group won't be used as it
                     // is an error to submit a command buffer that references destroyed
                     // resources.
+                    hasDestroyedResource = true;
                     return false;
                 }
-                writeImageInfo[numWrites].imageView = handle;
-                writeImageInfo[numWrites].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-
-                write.pImageInfo = &writeImageInfo[numWrites];
+                info.image.imageView = handle;
+                info.image.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
                 return true;
             },
             [&](const InputAttachmentBindingInfo&) -> bool {
@@ -174,29 +150,117 @@ BindGroup::BindGroup(Device* device,
                     // a Vulkan Validation Layers error. This bind group won't be used as it
                     // is an error to submit a command buffer that references destroyed
                     // resources.
+                    hasDestroyedResource = true;
                     return false;
                 }
-                writeImageInfo[numWrites].imageView = handle;
-                writeImageInfo[numWrites].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-                write.pImageInfo = &writeImageInfo[numWrites];
+                info.image.imageView = handle;
+                info.image.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
                 return true;
             });
+    }
+
+    // Write each descriptor individually, skipping the ones that reference destroyed resources.
+    auto WriteDescriptorsWithoutTemplate = [&](VkDescriptorSet set) {
+        ityp::stack_vec<uint32_t, VkWriteDescriptorSet, kMaxOptimalBindingsPerGroup> writes(
+            static_cast<uint32_t>(bindingCount));
+
+        uint32_t numWrites = 0;
+        for (BindingIndex bindingIndex : Range(bindingCount)) {
+            if (!shouldWriteDescriptor[bindingIndex]) {
+                continue;
+            }
+
+            auto& write = writes[numWrites++];
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.pNext = nullptr;
+            write.dstSet = set;
+            write.dstBinding = static_cast<uint32_t>(bindingIndex);
+            write.dstArrayElement = 0;
+            write.descriptorCount = 1;
+            write.descriptorType = VulkanDescriptorType(layout->GetBindingInfo(bindingIndex));
+            write.pImageInfo = &infos[bindingIndex].image;
+            write.pBufferInfo = &infos[bindingIndex].buffer;
+            write.pTexelBufferView = nullptr;
 
-        if (shouldWriteDescriptor) {
-            numWrites++;
+            // TODO(crbug.com/41488897: Add GetVkDescriptorSet{Index,
+            // Type}(BindingIndex) functions to BindGroupLayoutVk that
+            // access vectors holding entries for all BGL entries and
+            // eliminate this special-case code in favor of calling those
+            // functions to assign `dstBinding` and `descriptorType` above.
+            if (auto samplerIndex = layout->GetStaticSamplerIndexForTexture(bindingIndex)) {
+                // Write the info of the texture at the binding index for the
+                // sampler.
+                write.dstBinding = static_cast<uint32_t>(samplerIndex.value());
+                write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            }
         }
-    }
 
-    // TODO(crbug.com/dawn/855): Batch these updates
-    device->fn.UpdateDescriptorSets(device->GetVkDevice(), numWrites, writes.data(), 0, nullptr);
+        device->fn.UpdateDescriptorSets(device->GetVkDevice(), numWrites, writes.data(), 0,
+                                        nullptr);
+    };
+
+    if (hasDestroyedResource) {
+        // This bind group can't be used in a submit, so it gets its own descriptor set instead
+        // of sharing one whose descriptors are all valid.
+        DAWN_TRY_ASSIGN(mDescriptorSetAllocation, layout->AllocateDescriptorSet());
+        WriteDescriptorsWithoutTemplate(GetHandle());
+    } else {
+        DAWN_TRY_ASSIGN(mDescriptorSetAllocation,
+                        layout->AcquireSharedDescriptorSet(
+                            ComputeContentsKey(), [&](VkDescriptorSet set) {
+                                VkDescriptorUpdateTemplate updateTemplate =
+                                    layout->GetDescriptorUpdateTemplate();
+                                if (updateTemplate == VK_NULL_HANDLE) {
+                                    WriteDescriptorsWithoutTemplate(set);
+                                    return;
+                                }
+                                device->fn.UpdateDescriptorSetWithTemplate(
+                                    device->GetVkDevice(), set, updateTemplate, infos.data());
+                            }));
+        mUsesSharedDescriptorSet = true;
+    }
 
     SetLabelImpl();
+
+    return {};
+}
+
+DescriptorSetContentsKey BindGroup::ComputeContentsKey() {
+    const BindGroupLayoutInternalBase* layout = GetLayout();
+
+    DescriptorSetContentsKey key;
+    for (BindingIndex bindingIndex : Range(layout->GetBindingCount())) {
+        MatchVariant(
+            layout->GetBindingInfo(bindingIndex).bindingLayout,
+            [&](const BufferBindingInfo&) {
+                BufferBinding binding = GetBindingAsBufferBinding(bindingIndex);
+                key.push_back(reinterpret_cast<uintptr_t>(binding.buffer));
+                key.push_back(binding.offset);
+                key.push_back(binding.size);
+            },
+            [&](const SamplerBindingInfo&) {
+                key.push_back(reinterpret_cast<uintptr_t>(GetBindingAsSampler(bindingIndex)));
+            },
+            [&](const StaticSamplerBindingInfo&) {
+                // Static samplers are part of the layout.
+            },
+            [&](const auto&) {
+                key.push_back(reinterpret_cast<uintptr_t>(GetBindingAsTextureView(bindingIndex)));
+            });
+    }
+    return key;
 }
 
 BindGroup::~BindGroup() = default;
 
 void BindGroup::DestroyImpl() {
+    if (mUsesSharedDescriptorSet) {
+        // Release the shared set before BindGroupBase::DestroyImpl drops the bindings that make
+        // up its key.
+        ToBackend(GetLayout())
+            ->ReleaseSharedDescriptorSet(ComputeContentsKey(), &mDescriptorSetAllocation);
+        mUsesSharedDescriptorSet = false;
+    }
     BindGroupBase::DestroyImpl();
     ToBackend(GetLayout())->DeallocateBindGroup(this, &mDescriptorSetAllocation);
 }
@@ -30,6 +30,7 @@
 
 #include "dawn/native/BindGroup.h"
 
+#include "absl/container/inlined_vector.h"
 #include "dawn/common/PlacementAllocated.h"
 #include "dawn/common/vulkan_platform.h"
 #include "dawn/native/vulkan/DescriptorSetAllocation.h"
@@ -38,20 +39,26 @@ namespace dawn::native::vulkan {
 
 class Device;
 
+// Identifies the contents of a bind group: the objects bound at each binding followed by the
+// offset and size of buffer bindings.
+using DescriptorSetContentsKey = absl::InlinedVector<uint64_t, kMaxOptimalBindingsPerGroup>;
+
 class BindGroup final : public BindGroupBase, public PlacementAllocated {
   public:
     static ResultOrError<Ref<BindGroup>> Create(Device* device,
                                                 const BindGroupDescriptor* descriptor);
 
-    BindGroup(Device* device,
-              const BindGroupDescriptor* descriptor,
-              DescriptorSetAllocation descriptorSetAllocation);
+    BindGroup(Device* device, const BindGroupDescriptor* descriptor);
+
+    MaybeError Initialize();
 
     VkDescriptorSet GetHandle() const;
 
   private:
     ~BindGroup() override;
 
+    DescriptorSetContentsKey ComputeContentsKey();
+
     void DestroyImpl() override;
 
     // Dawn API
@@ -60,6 +67,8 @@ class BindGroup final : public BindGroupBase, public PlacementAllocated {
     // The descriptor set in this allocation outlives the BindGroup because it is owned by
     // the BindGroupLayout which is referenced by the BindGroup.
     DescriptorSetAllocation mDescriptorSetAllocation;
+    // Whether the descriptor set is shared with the other bind groups with the same contents.
+    bool mUsesSharedDescriptorSet = false;
 };
 
 }  // namespace dawn::native::vulkan
@@ -212,17 +212,7 @@ MaybeError Buffer::Initialize(bool mappedAtCreation) {
         return DAWN_OUT_OF_MEMORY_ERROR("Buffer size is HUGE and could cause overflows");
     }
 
-    VkBufferCreateInfo createInfo;
-    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    createInfo.pNext = nullptr;
-    createInfo.flags = 0;
-    createInfo.size = mAllocatedSize;
-    // Add CopyDst for non-mappable buffer initialization with mappedAtCreation
-    // and robust resource initialization.
-    createInfo.usage = VulkanBufferUsage(GetInternalUsage() | wgpu::BufferUsage::CopyDst);
-    createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    createInfo.queueFamilyIndexCount = 0;
-    createInfo.pQueueFamilyIndices = 0;
+    VkBufferCreateInfo createInfo = GetCreateInfo();
 
     Device* device = ToBackend(GetDevice());
     DAWN_TRY(CheckVkOOMThenSuccess(
@@ -269,18 +259,37 @@ MaybeError Buffer::Initialize(bool mappedAtCreation) {
         }
     }
 
+    UpdateMemoryProperties();
+    mHasWriteTransitioned = false;
+
+    SetLabelImpl();
+
+    return {};
+}
+
+VkBufferCreateInfo Buffer::GetCreateInfo() const {
+    VkBufferCreateInfo createInfo;
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0;
+    createInfo.size = mAllocatedSize;
+    // Add CopyDst for non-mappable buffer initialization with mappedAtCreation
+    // and robust resource initialization.
+    createInfo.usage = VulkanBufferUsage(GetInternalUsage() | wgpu::BufferUsage::CopyDst);
+    createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    createInfo.queueFamilyIndexCount = 0;
+    createInfo.pQueueFamilyIndices = 0;
+    return createInfo;
+}
+
+void Buffer::UpdateMemoryProperties() {
     // Get if buffer is host visible and coherent. This can be the case even if the buffer was not
     // created with map usages, as on integrated GPUs all memory will typically be host visible.
     const size_t memoryType = ToBackend(mMemoryAllocation.GetResourceHeap())->GetMemoryType();
     const VkMemoryPropertyFlags memoryPropertyFlags =
-        device->GetDeviceInfo().memoryTypes[memoryType].propertyFlags;
+        ToBackend(GetDevice())->GetDeviceInfo().memoryTypes[memoryType].propertyFlags;
     mHostVisible = IsSubset(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, memoryPropertyFlags);
     mHostCoherent = IsSubset(VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, memoryPropertyFlags);
-    mHasWriteTransitioned = false;
-
-    SetLabelImpl();
-
-    return {};
 }
 
 MaybeError Buffer::InitializeHostMapped(const BufferHostMappedPointer* hostMappedDesc) {
@@ -386,19 +395,100 @@ VkBuffer Buffer::GetHandle() const {
     return mHandle;
 }
 
+const ResourceMemoryAllocation& Buffer::GetMemoryAllocation() const {
+    return mMemoryAllocation;
+}
+
+bool Buffer::CanMoveMemory() const {
+    constexpr wgpu::BufferUsage kMovableUsages =
+        wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst | kInternalCopySrcBuffer;
+    return mMemoryAllocation.GetInfo().mMethod == AllocationMethod::kSubAllocated &&
+           IsSubset(GetInternalUsage(), kMovableUsages) && !IsDestroyed() && HasAccess() &&
+           APIGetMapState() == wgpu::BufferMapState::Unmapped;
+}
+
+ResultOrError<bool> Buffer::MoveMemoryOutOfHeaps(
+    CommandRecordingContext* recordingContext,
+    const absl::flat_hash_set<const ResourceHeapBase*>& excludedHeaps) {
+    DAWN_ASSERT(CanMoveMemory());
+    Device* device = ToBackend(GetDevice());
+
+    VkBufferCreateInfo createInfo = GetCreateInfo();
+    VkBuffer handle = VK_NULL_HANDLE;
+    DAWN_TRY(CheckVkOOMThenSuccess(
+        device->fn.CreateBuffer(device->GetVkDevice(), &createInfo, nullptr, &*handle),
+        "vkCreateBuffer"));
+
+    VkMemoryRequirements requirements;
+    device->fn.GetBufferMemoryRequirements(device->GetVkDevice(), handle, &requirements);
+
+    ResourceMemoryAllocation allocation;
+    DAWN_TRY_ASSIGN_WITH_CLEANUP(
+        allocation,
+        device->GetResourceMemoryAllocator()->AllocateOutsideOfHeaps(
+            requirements, MemoryKind::Linear, excludedHeaps),
+        { device->fn.DestroyBuffer(device->GetVkDevice(), handle, nullptr); });
+    if (allocation.GetInfo().mMethod == AllocationMethod::kInvalid) {
+        device->fn.DestroyBuffer(device->GetVkDevice(), handle, nullptr);
+        return false;
+    }
+
+    DAWN_TRY_WITH_CLEANUP(
+        CheckVkSuccess(device->fn.BindBufferMemory(
+                           device->GetVkDevice(), handle,
+                           ToBackend(allocation.GetResourceHeap())->GetMemory(),
+                           allocation.GetOffset()),
+                       "vkBindBufferMemory"),
+        {
+            device->GetResourceMemoryAllocator()->Deallocate(&allocation);
+            device->fn.DestroyBuffer(device->GetVkDevice(), handle, nullptr);
+        });
+
+    // Wait for the previous uses of the old VkBuffer before copying from it, and make the next
+    // uses of the buffer wait for the copy to the new VkBuffer.
+    TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
+    VkBuffer oldHandle = mHandle;
+    ResourceMemoryAllocation oldAllocation = mMemoryAllocation;
+    mHandle = handle;
+    mMemoryAllocation = allocation;
+    TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
+
+    // The contents of buffers that are not initialized are cleared on their first use instead.
+    if (!NeedsInitialization()) {
+        VkBufferCopy copy;
+        copy.srcOffset = 0;
+        copy.dstOffset = 0;
+        copy.size = mAllocatedSize;
+        device->fn.CmdCopyBuffer(recordingContext->commandBuffer, oldHandle, mHandle, 1, &copy);
+    }
+    MarkUsedInPendingCommands();
+
+    device->GetFencedDeleter()->DeleteWhenUnused(oldHandle);
+    device->GetResourceMemoryAllocator()->Deallocate(&oldAllocation);
+
+    UpdateMemoryProperties();
+    SetLabelImpl();
+
+    return true;
+}
+
 void Buffer::TransitionUsageNow(CommandRecordingContext* recordingContext,
                                 wgpu::BufferUsage usage,
                                 wgpu::ShaderStage shaderStage) {
+    TransitionUsageForNextCommand(recordingContext, usage, shaderStage);
+    recordingContext->FlushBarriers(ToBackend(GetDevice())->fn);
+}
+
+void Buffer::TransitionUsageForNextCommand(CommandRecordingContext* recordingContext,
+                                           wgpu::BufferUsage usage,
+                                           wgpu::ShaderStage shaderStage) {
     VkBufferMemoryBarrier barrier;
-    VkPipelineStageFlags srcStages = 0;
-    VkPipelineStageFlags dstStages = 0;
+    BarrierBatch* batch = &recordingContext->pendingBarriers;
 
-    if (TrackUsageAndGetResourceBarrier(recordingContext, usage, shaderStage, &barrier, &srcStages,
-                                        &dstStages)) {
-        DAWN_ASSERT(srcStages != 0 && dstStages != 0);
-        ToBackend(GetDevice())
-            ->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
-                                    nullptr, 1u, &barrier, 0, nullptr);
+    if (TrackUsageAndGetResourceBarrier(recordingContext, usage, shaderStage, &barrier,
+                                        &batch->srcStages, &batch->dstStages)) {
+        DAWN_ASSERT(batch->srcStages != 0 && batch->dstStages != 0);
+        batch->bufferBarriers.push_back(barrier);
     }
 }
 
@@ -763,9 +853,8 @@ void Buffer::TransitionMappableBuffersEagerly(const VulkanFunctions& fn,
         return;
     }
 
-    DAWN_ASSERT(srcStages != 0 && dstStages != 0);
-    fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0, nullptr,
-                          barriers.size(), barriers.data(), 0, nullptr);
+    recordingContext->RecordPipelineBarrier(fn, srcStages, dstStages, barriers.size(),
+                                            barriers.data(), 0, nullptr);
 }
 
 void Buffer::SetLabelImpl() {
@@ -50,11 +50,17 @@ class Buffer final : public BufferBase {
     VkBuffer GetHandle() const;
 
     // Transitions the buffer to be used as `usage`, recording any necessary barrier in
-    // `commands`.
-    // TODO(crbug.com/dawn/851): coalesce barriers and do them early when possible.
+    // `commands`, along with the other barriers pending in `recordingContext`.
+    // TODO(crbug.com/dawn/851): do barriers early when possible.
     void TransitionUsageNow(CommandRecordingContext* recordingContext,
                             wgpu::BufferUsage usage,
                             wgpu::ShaderStage shaderStage = wgpu::ShaderStage::None);
+    // Same as TransitionUsageNow, but adds the barrier to the pending barriers of
+    // `recordingContext` so that it is merged with the barriers of the other resources used by
+    // the next command. The caller must call FlushBarriers before recording that command.
+    void TransitionUsageForNextCommand(CommandRecordingContext* recordingContext,
+                                       wgpu::BufferUsage usage,
+                                       wgpu::ShaderStage shaderStage = wgpu::ShaderStage::None);
     bool TrackUsageAndGetResourceBarrier(CommandRecordingContext* recordingContext,
                                          wgpu::BufferUsage usage,
                                          wgpu::ShaderStage shaderStage,
@@ -70,6 +76,19 @@ class Buffer final : public BufferBase {
     bool EnsureDataInitializedAsDestination(CommandRecordingContext* recordingContext,
                                             const CopyTextureToBufferCmd* copy);
 
+    const ResourceMemoryAllocation& GetMemoryAllocation() const;
+
+    // Returns true if the VkBuffer can be replaced to move the buffer to other memory. This is
+    // only the case for unmapped buffers used in copies, which get the VkBuffer when the copy is
+    // recorded, while other usages can keep it in descriptor sets or secondary command buffers.
+    bool CanMoveMemory() const;
+    // Moves the contents of the buffer to a new VkBuffer in memory allocated outside of
+    // `excludedHeaps`, recording the copy in `recordingContext`. Returns false if the buffer was
+    // not moved because no memory could be allocated outside of the excluded heaps.
+    ResultOrError<bool> MoveMemoryOutOfHeaps(
+        CommandRecordingContext* recordingContext,
+        const absl::flat_hash_set<const ResourceHeapBase*>& excludedHeaps);
+
     // Dawn API
     void SetLabelImpl() override;
 
@@ -83,6 +102,8 @@ class Buffer final : public BufferBase {
 
     MaybeError Initialize(bool mappedAtCreation);
     MaybeError InitializeHostMapped(const BufferHostMappedPointer* hostMappedDesc);
+    VkBufferCreateInfo GetCreateInfo() const;
+    void UpdateMemoryProperties();
     void InitializeToZero(CommandRecordingContext* recordingContext);
     void ClearBuffer(CommandRecordingContext* recordingContext,
                      uint32_t clearValue,
@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "dawn/native/BindGroupTracker.h"
 #include "dawn/native/CommandEncoder.h"
 #include "dawn/native/CommandValidation.h"
@@ -47,6 +48,7 @@
 #include "dawn/native/vulkan/PipelineLayoutVk.h"
 #include "dawn/native/vulkan/QuerySetVk.h"
 #include "dawn/native/vulkan/QueueVk.h"
+#include "dawn/native/vulkan/RenderBundleVk.h"
 #include "dawn/native/vulkan/RenderPassCache.h"
 #include "dawn/native/vulkan/RenderPipelineVk.h"
 #include "dawn/native/vulkan/ResolveTextureLoadingUtilsVk.h"
@@ -167,16 +169,14 @@ class DescriptorSetTracker : public BindGroupTrackerBase<true, uint32_t> {
         mInternalImmediateDataSize = pipeline->GetInternalImmediateDataSize();
     }
 
-    void Apply(Device* device,
-               CommandRecordingContext* recordingContext,
-               VkPipelineBindPoint bindPoint) {
+    void Apply(Device* device, VkCommandBuffer commands, VkPipelineBindPoint bindPoint) {
         BeforeApply();
         for (BindGroupIndex dirtyIndex : IterateBitSet(mDirtyBindGroupsObjectChangedOrIsDynamic)) {
             VkDescriptorSet set = ToBackend(mBindGroups[dirtyIndex])->GetHandle();
             uint32_t count = static_cast<uint32_t>(mDynamicOffsets[dirtyIndex].size());
             const uint32_t* dynamicOffset =
                 count > 0 ? mDynamicOffsets[dirtyIndex].data() : nullptr;
-            device->fn.CmdBindDescriptorSets(recordingContext->commandBuffer, bindPoint, mVkLayout,
+            device->fn.CmdBindDescriptorSets(commands, bindPoint, mVkLayout,
                                              static_cast<uint32_t>(dirtyIndex), 1, &*set, count,
                                              dynamicOffset);
         }
@@ -192,30 +192,28 @@ class DescriptorSetTracker : public BindGroupTrackerBase<true, uint32_t> {
     uint32_t mInternalImmediateDataSize = 0;
 };
 
-// Records the necessary barriers for a synchronization scope using the resource usage
+// The barriers of synchronization scopes. Barriers with vertex stages in destination stages are
+// separated from all other barriers. This avoids creating unnecessary fragment->vertex dependencies
+// when merging barriers. Eg. merging a compute->vertex barrier and a fragment->fragment barrier
+// would create a compute|fragment->vertex|fragment barrier.
+struct SyncScopeBarriers {
+    BarrierBatch vertexBarriers;
+    BarrierBatch nonVertexBarriers;
+};
+
+// Adds the necessary barriers for a synchronization scope to `barriers` using the resource usage
 // data pre-computed in the frontend. Also performs lazy initialization if required.
-MaybeError TransitionAndClearForSyncScope(Device* device,
-                                          CommandRecordingContext* recordingContext,
-                                          const SyncScopeResourceUsage& scope) {
-    // Separate barriers with vertex stages in destination stages from all other barriers.
-    // This avoids creating unnecessary fragment->vertex dependencies when merging barriers.
-    // Eg. merging a compute->vertex barrier and a fragment->fragment barrier would create
-    // a compute|fragment->vertex|fragment barrier.
+MaybeError AddBarriersAndClearForSyncScope(CommandRecordingContext* recordingContext,
+                                           const SyncScopeResourceUsage& scope,
+                                           SyncScopeBarriers* barriers) {
     const VkPipelineStageFlags vertexStages = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT |
                                               VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
                                               VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
 
-    struct Barriers {
-        std::vector<VkBufferMemoryBarrier> bufferBarriers;
-        std::vector<VkImageMemoryBarrier> imageBarriers;
-        VkPipelineStageFlags srcStages = 0;
-        VkPipelineStageFlags dstStages = 0;
-    };
-
-    Barriers vertexBarriers;
-    Barriers nonVertexBarriers;
+    BarrierBatch& vertexBarriers = barriers->vertexBarriers;
+    BarrierBatch& nonVertexBarriers = barriers->nonVertexBarriers;
 
-    auto MergeBufferBarrier = [](Barriers* barriers, VkPipelineStageFlags srcStages,
+    auto MergeBufferBarrier = [](BarrierBatch* barriers, VkPipelineStageFlags srcStages,
                                  VkPipelineStageFlags dstStages,
                                  const VkBufferMemoryBarrier& bufferBarrier) {
         barriers->srcStages |= srcStages;
@@ -251,7 +249,7 @@ MaybeError TransitionAndClearForSyncScope(Device* device,
         }
     }
 
-    auto MergeImageBarriers = [](Barriers* barriers, VkPipelineStageFlags srcStages,
+    auto MergeImageBarriers = [](BarrierBatch* barriers, VkPipelineStageFlags srcStages,
                                  VkPipelineStageFlags dstStages,
                                  const std::vector<VkImageMemoryBarrier>& imageBarriers) {
         barriers->srcStages |= srcStages;
@@ -288,18 +286,265 @@ MaybeError TransitionAndClearForSyncScope(Device* device,
         }
     }
 
-    for (const Barriers& barriers : {vertexBarriers, nonVertexBarriers}) {
-        if (!barriers.bufferBarriers.empty() || !barriers.imageBarriers.empty()) {
-            device->fn.CmdPipelineBarrier(
-                recordingContext->commandBuffer, barriers.srcStages, barriers.dstStages, 0, 0,
-                nullptr, barriers.bufferBarriers.size(), barriers.bufferBarriers.data(),
-                barriers.imageBarriers.size(), barriers.imageBarriers.data());
+    return {};
+}
+
+void RecordSyncScopeBarriers(Device* device,
+                             CommandRecordingContext* recordingContext,
+                             const SyncScopeBarriers& syncScopeBarriers) {
+    for (const BarrierBatch* barriers :
+         {&syncScopeBarriers.vertexBarriers, &syncScopeBarriers.nonVertexBarriers}) {
+        if (!barriers->IsEmpty()) {
+            recordingContext->RecordPipelineBarrier(
+                device->fn, barriers->srcStages, barriers->dstStages,
+                barriers->bufferBarriers.size(), barriers->bufferBarriers.data(),
+                barriers->imageBarriers.size(), barriers->imageBarriers.data());
         }
     }
+}
 
+// Records the necessary barriers for a synchronization scope using the resource usage
+// data pre-computed in the frontend. Also performs lazy initialization if required.
+MaybeError TransitionAndClearForSyncScope(Device* device,
+                                          CommandRecordingContext* recordingContext,
+                                          const SyncScopeResourceUsage& scope) {
+    SyncScopeBarriers barriers;
+    DAWN_TRY(AddBarriersAndClearForSyncScope(recordingContext, scope, &barriers));
+    RecordSyncScopeBarriers(device, recordingContext, barriers);
     return {};
 }
 
+// The buffers and textures used by the commands whose barriers are recorded together, before the
+// first of these commands. A command can only join them if its transitions don't depend on the
+// commands before it: the resources it shares with them must be read, with the same image layout,
+// by all of them. Otherwise the barrier between the commands would be lost.
+class BatchedResources {
+  public:
+    // Returns whether a command can use `resource` after the commands in the batch.
+    bool CanUse(const ApiObjectBase* resource, bool isReadOnly) const {
+        auto it = mResources.find(resource);
+        return it == mResources.end() || (isReadOnly && it->second);
+    }
+
+    void Use(const ApiObjectBase* resource, bool isReadOnly) {
+        auto [it, inserted] = mResources.emplace(resource, isReadOnly);
+        if (!inserted) {
+            it->second = it->second && isReadOnly;
+        }
+    }
+
+  private:
+    // Whether each resource is only read by the commands in the batch.
+    absl::flat_hash_map<const ApiObjectBase*, bool> mResources;
+};
+
+// Returns the number of consecutive synchronization scopes starting at `firstScope` whose barriers
+// can be recorded together, before the first of them.
+size_t CountBatchableSyncScopes(const std::vector<SyncScopeResourceUsage>& scopes,
+                                size_t firstScope) {
+    BatchedResources resources;
+    size_t scopeCount = 0;
+    for (size_t scopeIndex = firstScope; scopeIndex < scopes.size(); ++scopeIndex) {
+        const SyncScopeResourceUsage& scope = scopes[scopeIndex];
+
+        auto IsReadOnly = [&](size_t bufferIndex) {
+            wgpu::BufferUsage usage = scope.bufferSyncInfos[bufferIndex].usage &
+                                      ~kIndirectBufferForFrontendValidation;
+            return IsSubset(usage, kReadOnlyBufferUsages);
+        };
+
+        // Read-only usages of a texture can have different layouts so textures aren't shared.
+        bool canBatch = true;
+        for (size_t i = 0; i < scope.buffers.size() && canBatch; ++i) {
+            canBatch = resources.CanUse(scope.buffers[i], IsReadOnly(i));
+        }
+        for (size_t i = 0; i < scope.textures.size() && canBatch; ++i) {
+            canBatch = resources.CanUse(scope.textures[i], /*isReadOnly=*/false);
+        }
+        if (!canBatch) {
+            break;
+        }
+
+        for (size_t i = 0; i < scope.buffers.size(); ++i) {
+            resources.Use(scope.buffers[i], IsReadOnly(i));
+        }
+        for (TextureBase* texture : scope.textures) {
+            resources.Use(texture, /*isReadOnly=*/false);
+        }
+        scopeCount++;
+    }
+    return scopeCount;
+}
+
+// Returns whether the texture-to-texture copy must be done through a temporary buffer, see
+// RecordCopyImageWithTemporaryBuffer().
+bool ShouldCopyUsingTemporaryBuffer(Device* device, const CopyTextureToTextureCmd* copy) {
+    return device->IsToggleEnabled(Toggle::UseTemporaryBufferInCompressedTextureToTextureCopy) &&
+           copy->source.texture->GetFormat().isCompressed &&
+           !HasSameTextureCopyExtent(copy->source, copy->destination, copy->copySize);
+}
+
+// Returns whether a copy would lazily clear `range` of `texture` before reading or partially
+// writing it.
+bool NeedsLazyClear(Texture* texture, const SubresourceRange& range) {
+    return texture->GetDevice()->IsToggleEnabled(Toggle::LazyClearResourceOnFirstUse) &&
+           !texture->IsSubresourceContentInitialized(range);
+}
+
+// Looks ahead at the copies that follow the current command of `commands` and adds their
+// transitions to the pending barriers of `recordingContext`, so that they are recorded with the
+// barrier of the current copy. A copy can only join the batch if it can use its resources after
+// the commands in `resources`, and if it doesn't need a lazy clear, which would have to be recorded
+// between the copies. Returns the number of copies whose transitions were added, which must not be
+// transitioned again. `commands` is left at the current command.
+size_t TransitionFollowingCopies(Device* device,
+                                 CommandRecordingContext* recordingContext,
+                                 CommandIterator* commands,
+                                 BatchedResources* resources) {
+    CommandIterator::Position position = commands->GetPosition();
+
+    size_t copyCount = 0;
+    bool canBatch = true;
+    Command type;
+    while (canBatch && commands->NextCommandId(&type)) {
+        switch (type) {
+            case Command::CopyBufferToBuffer: {
+                CopyBufferToBufferCmd* copy = commands->NextCommand<CopyBufferToBufferCmd>();
+                if (copy->size == 0) {
+                    // No-op copies are skipped without transitions.
+                    break;
+                }
+                Buffer* src = ToBackend(copy->source.Get());
+                Buffer* dst = ToBackend(copy->destination.Get());
+
+                canBatch = !src->NeedsInitialization() &&
+                           (!dst->NeedsInitialization() ||
+                            dst->IsFullBufferRange(copy->destinationOffset, copy->size)) &&
+                           resources->CanUse(src, /*isReadOnly=*/true) &&
+                           resources->CanUse(dst, /*isReadOnly=*/false);
+                if (canBatch) {
+                    resources->Use(src, /*isReadOnly=*/true);
+                    resources->Use(dst, /*isReadOnly=*/false);
+                    src->TransitionUsageForNextCommand(recordingContext,
+                                                       wgpu::BufferUsage::CopySrc);
+                    dst->TransitionUsageForNextCommand(recordingContext,
+                                                       wgpu::BufferUsage::CopyDst);
+                    copyCount++;
+                }
+                break;
+            }
+
+            case Command::CopyBufferToTexture: {
+                CopyBufferToTextureCmd* copy = commands->NextCommand<CopyBufferToTextureCmd>();
+                if (copy->copySize.width == 0 || copy->copySize.height == 0 ||
+                    copy->copySize.depthOrArrayLayers == 0) {
+                    // No-op copies are skipped without transitions.
+                    break;
+                }
+                Buffer* src = ToBackend(copy->source.buffer.Get());
+                Texture* dst = ToBackend(copy->destination.texture.Get());
+                SubresourceRange range =
+                    GetSubresourcesAffectedByCopy(copy->destination, copy->copySize);
+
+                canBatch = !src->NeedsInitialization() &&
+                           (IsCompleteSubresourceCopiedTo(dst, copy->copySize,
+                                                          copy->destination.mipLevel,
+                                                          copy->destination.aspect) ||
+                            !NeedsLazyClear(dst, range)) &&
+                           resources->CanUse(src, /*isReadOnly=*/true) &&
+                           resources->CanUse(dst, /*isReadOnly=*/false);
+                if (canBatch) {
+                    resources->Use(src, /*isReadOnly=*/true);
+                    resources->Use(dst, /*isReadOnly=*/false);
+                    src->TransitionUsageForNextCommand(recordingContext,
+                                                       wgpu::BufferUsage::CopySrc);
+                    dst->TransitionUsageForNextCommand(recordingContext,
+                                                       wgpu::TextureUsage::CopyDst,
+                                                       wgpu::ShaderStage::None, range);
+                    copyCount++;
+                }
+                break;
+            }
+
+            case Command::CopyTextureToBuffer: {
+                CopyTextureToBufferCmd* copy = commands->NextCommand<CopyTextureToBufferCmd>();
+                if (copy->copySize.width == 0 || copy->copySize.height == 0 ||
+                    copy->copySize.depthOrArrayLayers == 0) {
+                    // No-op copies are skipped without transitions.
+                    break;
+                }
+                Texture* src = ToBackend(copy->source.texture.Get());
+                Buffer* dst = ToBackend(copy->destination.buffer.Get());
+                SubresourceRange range =
+                    GetSubresourcesAffectedByCopy(copy->source, copy->copySize);
+
+                // The CopySrc usage of textures always has the GENERAL layout, so they can be read
+                // by several copies of the batch.
+                canBatch = !NeedsLazyClear(src, range) &&
+                           (!dst->NeedsInitialization() ||
+                            IsFullBufferOverwrittenInTextureToBufferCopy(copy)) &&
+                           resources->CanUse(src, /*isReadOnly=*/true) &&
+                           resources->CanUse(dst, /*isReadOnly=*/false);
+                if (canBatch) {
+                    resources->Use(src, /*isReadOnly=*/true);
+                    resources->Use(dst, /*isReadOnly=*/false);
+                    src->TransitionUsageForNextCommand(recordingContext,
+                                                       wgpu::TextureUsage::CopySrc,
+                                                       wgpu::ShaderStage::None, range);
+                    dst->TransitionUsageForNextCommand(recordingContext,
+                                                       wgpu::BufferUsage::CopyDst);
+                    copyCount++;
+                }
+                break;
+            }
+
+            case Command::CopyTextureToTexture: {
+                CopyTextureToTextureCmd* copy = commands->NextCommand<CopyTextureToTextureCmd>();
+                if (copy->copySize.width == 0 || copy->copySize.height == 0 ||
+                    copy->copySize.depthOrArrayLayers == 0) {
+                    // No-op copies are skipped without transitions.
+                    break;
+                }
+                Texture* src = ToBackend(copy->source.texture.Get());
+                Texture* dst = ToBackend(copy->destination.texture.Get());
+                SubresourceRange srcRange =
+                    GetSubresourcesAffectedByCopy(copy->source, copy->copySize);
+                SubresourceRange dstRange =
+                    GetSubresourcesAffectedByCopy(copy->destination, copy->copySize);
+
+                // Copies through a temporary buffer record their own barriers.
+                canBatch = !ShouldCopyUsingTemporaryBuffer(device, copy) &&
+                           !NeedsLazyClear(src, srcRange) &&
+                           (IsCompleteSubresourceCopiedTo(dst, copy->copySize,
+                                                          copy->destination.mipLevel,
+                                                          copy->destination.aspect) ||
+                            !NeedsLazyClear(dst, dstRange)) &&
+                           resources->CanUse(src, /*isReadOnly=*/true) &&
+                           resources->CanUse(dst, /*isReadOnly=*/false);
+                if (canBatch) {
+                    resources->Use(src, /*isReadOnly=*/true);
+                    resources->Use(dst, /*isReadOnly=*/false);
+                    src->TransitionUsageForNextCommand(recordingContext,
+                                                       wgpu::TextureUsage::CopySrc,
+                                                       wgpu::ShaderStage::None, srcRange);
+                    dst->TransitionUsageForNextCommand(recordingContext,
+                                                       wgpu::TextureUsage::CopyDst,
+                                                       wgpu::ShaderStage::None, dstRange);
+                    copyCount++;
+                }
+                break;
+            }
+
+            default:
+                canBatch = false;
+                break;
+        }
+    }
+
+    commands->SetPosition(position);
+    return copyCount;
+}
+
 // Reset the query sets used on render pass because the reset command must be called outside
 // render pass.
 void ResetUsedQuerySetsOnRenderPass(Device* device,
@@ -372,61 +617,401 @@ void RecordResolveQuerySetCmd(VkCommandBuffer commands,
         }
         auto nextFalseIt = std::find(firstTrueIt, lastIt, false);
 
-        // The query index of firstTrueIt where the resolving starts
-        uint32_t resolveQueryIndex = std::distance(availability.begin(), firstTrueIt);
-        // The queries count between firstTrueIt and nextFalseIt need to be resolved
-        uint32_t resolveQueryCount = std::distance(firstTrueIt, nextFalseIt);
+        // The query index of firstTrueIt where the resolving starts
+        uint32_t resolveQueryIndex = std::distance(availability.begin(), firstTrueIt);
+        // The queries count between firstTrueIt and nextFalseIt need to be resolved
+        uint32_t resolveQueryCount = std::distance(firstTrueIt, nextFalseIt);
+
+        // Calculate destinationOffset based on the current resolveQueryIndex and firstQuery
+        uint32_t resolveDestinationOffset =
+            destinationOffset + (resolveQueryIndex - firstQuery) * sizeof(uint64_t);
+
+        // Resolve the queries between firstTrueIt and nextFalseIt (which is at most lastIt)
+        device->fn.CmdCopyQueryPoolResults(commands, querySet->GetHandle(), resolveQueryIndex,
+                                           resolveQueryCount, destination->GetHandle(),
+                                           resolveDestinationOffset, sizeof(uint64_t),
+                                           VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+
+        // Set current iterator to next false
+        currentIt = nextFalseIt;
+    }
+}
+
+// Records the commands that can be in both render passes and render bundles, to either the command
+// buffer of a render pass or the secondary command buffer of a render bundle.
+class RenderCommandRecorder {
+  public:
+    RenderCommandRecorder(Device* device, VkCommandBuffer commands)
+        : mDevice(device), mCommands(commands) {}
+
+    // Updates the min/maxDepth push constants needed by the ClampFragDepth transform, deferring
+    // the update if no pipeline is currently bound.
+    void SetClampFragDepthArgs(float minDepth, float maxDepth) {
+        mClampFragDepthArgs = {minDepth, maxDepth};
+        mClampFragDepthArgsDirty = true;
+        ApplyClampFragDepthArgs();
+    }
+
+    void EncodeRenderBundleCommand(CommandIterator* iter, Command type) {
+        switch (type) {
+            case Command::Draw: {
+                DrawCmd* draw = iter->NextCommand<DrawCmd>();
+
+                mDescriptorSets.Apply(mDevice, mCommands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                mDevice->fn.CmdDraw(mCommands, draw->vertexCount, draw->instanceCount,
+                                   draw->firstVertex, draw->firstInstance);
+                break;
+            }
+
+            case Command::DrawIndexed: {
+                DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
+
+                mDescriptorSets.Apply(mDevice, mCommands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                mDevice->fn.CmdDrawIndexed(mCommands, draw->indexCount, draw->instanceCount,
+                                          draw->firstIndex, draw->baseVertex, draw->firstInstance);
+                break;
+            }
+
+            case Command::DrawIndirect: {
+                DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
+                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+
+                mDescriptorSets.Apply(mDevice, mCommands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                mDevice->fn.CmdDrawIndirect(mCommands, buffer->GetHandle(),
+                                           static_cast<VkDeviceSize>(draw->indirectOffset), 1, 0);
+                break;
+            }
+
+            case Command::DrawIndexedIndirect: {
+                DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
+                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+                DAWN_ASSERT(buffer != nullptr);
+
+                mDescriptorSets.Apply(mDevice, mCommands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                mDevice->fn.CmdDrawIndexedIndirect(mCommands, buffer->GetHandle(),
+                                                  static_cast<VkDeviceSize>(draw->indirectOffset),
+                                                  1, 0);
+                break;
+            }
+
+            case Command::MultiDrawIndirect: {
+                MultiDrawIndirectCmd* cmd = iter->NextCommand<MultiDrawIndirectCmd>();
+
+                Buffer* indirectBuffer = ToBackend(cmd->indirectBuffer.Get());
+                DAWN_ASSERT(indirectBuffer != nullptr);
+
+                // Count buffer is optional
+                Buffer* countBuffer = ToBackend(cmd->drawCountBuffer.Get());
+
+                mDescriptorSets.Apply(mDevice, mCommands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+
+                if (countBuffer == nullptr) {
+                    mDevice->fn.CmdDrawIndirect(mCommands, indirectBuffer->GetHandle(),
+                                               static_cast<VkDeviceSize>(cmd->indirectOffset),
+                                               cmd->maxDrawCount, kDrawIndirectSize);
+                } else {
+                    mDevice->fn.CmdDrawIndirectCountKHR(
+                        mCommands, indirectBuffer->GetHandle(),
+                        static_cast<VkDeviceSize>(cmd->indirectOffset), countBuffer->GetHandle(),
+                        static_cast<VkDeviceSize>(cmd->drawCountOffset), cmd->maxDrawCount,
+                        kDrawIndirectSize);
+                }
+                break;
+            }
+            case Command::MultiDrawIndexedIndirect: {
+                MultiDrawIndexedIndirectCmd* cmd = iter->NextCommand<MultiDrawIndexedIndirectCmd>();
+
+                Buffer* indirectBuffer = ToBackend(cmd->indirectBuffer.Get());
+                DAWN_ASSERT(indirectBuffer != nullptr);
+
+                // Count buffer is optional
+                Buffer* countBuffer = ToBackend(cmd->drawCountBuffer.Get());
+
+                mDescriptorSets.Apply(mDevice, mCommands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+
+                if (countBuffer == nullptr) {
+                    mDevice->fn.CmdDrawIndexedIndirect(
+                        mCommands, indirectBuffer->GetHandle(),
+                        static_cast<VkDeviceSize>(cmd->indirectOffset), cmd->maxDrawCount,
+                        kDrawIndexedIndirectSize);
+                } else {
+                    mDevice->fn.CmdDrawIndexedIndirectCountKHR(
+                        mCommands, indirectBuffer->GetHandle(),
+                        static_cast<VkDeviceSize>(cmd->indirectOffset), countBuffer->GetHandle(),
+                        static_cast<VkDeviceSize>(cmd->drawCountOffset), cmd->maxDrawCount,
+                        kDrawIndexedIndirectSize);
+                }
+
+                break;
+            }
+
+            case Command::InsertDebugMarker: {
+                if (mDevice->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
+                    InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
+                    const char* label = iter->NextData<char>(cmd->length + 1);
+                    VkDebugUtilsLabelEXT utilsLabel;
+                    utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+                    utilsLabel.pNext = nullptr;
+                    utilsLabel.pLabelName = label;
+                    // Default color to black
+                    utilsLabel.color[0] = 0.0;
+                    utilsLabel.color[1] = 0.0;
+                    utilsLabel.color[2] = 0.0;
+                    utilsLabel.color[3] = 1.0;
+                    mDevice->fn.CmdInsertDebugUtilsLabelEXT(mCommands, &utilsLabel);
+                } else {
+                    SkipCommand(iter, Command::InsertDebugMarker);
+                }
+                break;
+            }
+
+            case Command::PopDebugGroup: {
+                if (mDevice->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
+                    iter->NextCommand<PopDebugGroupCmd>();
+                    mDevice->fn.CmdEndDebugUtilsLabelEXT(mCommands);
+                } else {
+                    SkipCommand(iter, Command::PopDebugGroup);
+                }
+                break;
+            }
+
+            case Command::PushDebugGroup: {
+                if (mDevice->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
+                    PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
+                    const char* label = iter->NextData<char>(cmd->length + 1);
+                    VkDebugUtilsLabelEXT utilsLabel;
+                    utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+                    utilsLabel.pNext = nullptr;
+                    utilsLabel.pLabelName = label;
+                    // Default color to black
+                    utilsLabel.color[0] = 0.0;
+                    utilsLabel.color[1] = 0.0;
+                    utilsLabel.color[2] = 0.0;
+                    utilsLabel.color[3] = 1.0;
+                    mDevice->fn.CmdBeginDebugUtilsLabelEXT(mCommands, &utilsLabel);
+                } else {
+                    SkipCommand(iter, Command::PushDebugGroup);
+                }
+                break;
+            }
+
+            case Command::SetBindGroup: {
+                SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
+                BindGroup* bindGroup = ToBackend(cmd->group.Get());
+                uint32_t* dynamicOffsets = nullptr;
+                if (cmd->dynamicOffsetCount > 0) {
+                    dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                }
+
+                mDescriptorSets.OnSetBindGroup(cmd->index, bindGroup, cmd->dynamicOffsetCount,
+                                              dynamicOffsets);
+                break;
+            }
+
+            case Command::SetIndexBuffer: {
+                SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
+                VkBuffer indexBuffer = ToBackend(cmd->buffer)->GetHandle();
+
+                mDevice->fn.CmdBindIndexBuffer(mCommands, indexBuffer, cmd->offset,
+                                              VulkanIndexType(cmd->format));
+                break;
+            }
+
+            case Command::SetRenderPipeline: {
+                SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
+                RenderPipeline* pipeline = ToBackend(cmd->pipeline).Get();
+
+                mDevice->fn.CmdBindPipeline(mCommands, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                           pipeline->GetHandle());
+                mLastPipeline = pipeline;
+
+                mDescriptorSets.OnSetPipeline<RenderPipeline>(pipeline);
+
+                // Apply the deferred min/maxDepth push constants update if needed.
+                ApplyClampFragDepthArgs();
+                break;
+            }
+
+            case Command::SetVertexBuffer: {
+                SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
+                VkBuffer buffer = ToBackend(cmd->buffer)->GetHandle();
+                VkDeviceSize offset = static_cast<VkDeviceSize>(cmd->offset);
+
+                mDevice->fn.CmdBindVertexBuffers(mCommands, static_cast<uint8_t>(cmd->slot), 1,
+                                                &*buffer, &offset);
+                break;
+            }
+
+            default:
+                DAWN_UNREACHABLE();
+                break;
+        }
+    }
+
+  private:
+    void ApplyClampFragDepthArgs() {
+        if (!mClampFragDepthArgsDirty || mLastPipeline == nullptr) {
+            return;
+        }
+        mDevice->fn.CmdPushConstants(
+            mCommands, mLastPipeline->GetVkLayout(),
+            ToBackend(mLastPipeline->GetLayout())->GetImmediateDataRangeStage(),
+            kClampFragDepthArgsOffset, kClampFragDepthArgsSize, &mClampFragDepthArgs);
+        mClampFragDepthArgsDirty = false;
+    }
+
+    raw_ptr<Device> mDevice;
+    VkCommandBuffer mCommands;
+    DescriptorSetTracker mDescriptorSets = {};
+    raw_ptr<RenderPipeline> mLastPipeline = nullptr;
+
+    // Tracking for the push constants needed by the ClampFragDepth transform.
+    // TODO(dawn:1125): Avoid the need for this when the depthClamp feature is available, but doing
+    // so would require fixing issue dawn:1576 first to have more dynamic push constant usage. (and
+    // also additional tests that the dirtying logic here is correct so with a Toggle we can test it
+    // on our infra).
+    ClampFragDepthArgs mClampFragDepthArgs = {0.0f, 1.0f};
+    bool mClampFragDepthArgsDirty = true;
+};
+
+ResultOrError<VkRenderPass> GetRenderPassForCmd(Device* device,
+                                                const BeginRenderPassCmd* renderPass) {
+    RenderPassCacheQuery query;
+
+    for (auto i : IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
+        const auto& attachmentInfo = renderPass->colorAttachments[i];
+        bool hasResolveTarget = attachmentInfo.resolveTarget != nullptr;
+
+        query.SetColor(i, attachmentInfo.view->GetFormat().format, attachmentInfo.loadOp,
+                       attachmentInfo.storeOp, hasResolveTarget);
+    }
+
+    if (renderPass->attachmentState->HasDepthStencilAttachment()) {
+        const auto& attachmentInfo = renderPass->depthStencilAttachment;
 
-        // Calculate destinationOffset based on the current resolveQueryIndex and firstQuery
-        uint32_t resolveDestinationOffset =
-            destinationOffset + (resolveQueryIndex - firstQuery) * sizeof(uint64_t);
+        query.SetDepthStencil(attachmentInfo.view->GetTexture()->GetFormat().format,
+                              attachmentInfo.depthLoadOp, attachmentInfo.depthStoreOp,
+                              attachmentInfo.depthReadOnly, attachmentInfo.stencilLoadOp,
+                              attachmentInfo.stencilStoreOp, attachmentInfo.stencilReadOnly);
+    }
 
-        // Resolve the queries between firstTrueIt and nextFalseIt (which is at most lastIt)
-        device->fn.CmdCopyQueryPoolResults(commands, querySet->GetHandle(), resolveQueryIndex,
-                                           resolveQueryCount, destination->GetHandle(),
-                                           resolveDestinationOffset, sizeof(uint64_t),
-                                           VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+    query.SetSampleCount(renderPass->attachmentState->GetSampleCount());
 
-        // Set current iterator to next false
-        currentIt = nextFalseIt;
+    RenderPassCache::RenderPassInfo renderPassInfo;
+    DAWN_TRY_ASSIGN(renderPassInfo, device->GetRenderPassCache()->GetRenderPass(query));
+    return renderPassInfo.renderPass;
+}
+
+// Sets the default value for the dynamic state at the start of a render pass.
+void RecordDefaultDynamicState(Device* device,
+                               VkCommandBuffer commands,
+                               uint32_t width,
+                               uint32_t height) {
+    device->fn.CmdSetLineWidth(commands, 1.0f);
+    device->fn.CmdSetDepthBounds(commands, 0.0f, 1.0f);
+
+    device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK, 0);
+
+    float blendConstants[4] = {
+        0.0f,
+        0.0f,
+        0.0f,
+        0.0f,
+    };
+    device->fn.CmdSetBlendConstants(commands, blendConstants);
+
+    // The viewport and scissor default to cover all of the attachments
+    VkViewport viewport;
+    viewport.x = 0.0f;
+    viewport.y = static_cast<float>(height);
+    viewport.width = static_cast<float>(width);
+    viewport.height = -static_cast<float>(height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    device->fn.CmdSetViewport(commands, 0, 1, &viewport);
+
+    VkRect2D scissorRect;
+    scissorRect.offset.x = 0;
+    scissorRect.offset.y = 0;
+    scissorRect.extent.width = width;
+    scissorRect.extent.height = height;
+    device->fn.CmdSetScissor(commands, 0, 1, &scissorRect);
+}
+
+// Looks ahead at the commands of a render pass and, if they are only ExecuteBundles, gets the
+// secondary command buffers of all the executed bundles, recording them if needed. Returns false
+// if the render pass must be recorded inline instead, in which case `commands` is unchanged.
+ResultOrError<bool> GetSecondaryCommandBuffersForRenderPass(
+    Device* device,
+    CommandIterator* commands,
+    const BeginRenderPassCmd* renderPassCmd,
+    VkRenderPass renderPassVK,
+    std::vector<VkCommandBuffer>* secondaryCommandBuffers) {
+    // The commands of a subpass are either all inline or all in secondary command buffers.
+    std::vector<RenderBundle*> bundles;
+    bool onlyExecutesBundles = false;
+    {
+        CommandIterator::Position position = commands->GetPosition();
+        Command type;
+        while (commands->NextCommandId(&type)) {
+            if (type != Command::ExecuteBundles) {
+                onlyExecutesBundles = type == Command::EndRenderPass;
+                break;
+            }
+            ExecuteBundlesCmd* cmd = commands->NextCommand<ExecuteBundlesCmd>();
+            auto executedBundles = commands->NextData<Ref<RenderBundleBase>>(cmd->count);
+            for (uint32_t i = 0; i < cmd->count; ++i) {
+                bundles.push_back(ToBackend(executedBundles[i].Get()));
+            }
+        }
+        commands->SetPosition(position);
+    }
+    if (!onlyExecutesBundles || bundles.empty()) {
+        return false;
+    }
+
+    RenderBundle::SecondaryCommandBufferKey key;
+    key.renderPass = renderPassVK;
+    key.width = renderPassCmd->width;
+    key.height = renderPassCmd->height;
+
+    secondaryCommandBuffers->reserve(bundles.size());
+    for (RenderBundle* bundle : bundles) {
+        VkCommandBuffer secondaryCommandBuffer = VK_NULL_HANDLE;
+        DAWN_TRY_ASSIGN(
+            secondaryCommandBuffer,
+            bundle->GetOrCreateSecondaryCommandBuffer(key, [&](VkCommandBuffer secondary) {
+                // Secondary command buffers don't inherit any state from the render pass.
+                RecordDefaultDynamicState(device, secondary, key.width, key.height);
+
+                RenderCommandRecorder recorder(device, secondary);
+                CommandIterator* iter = bundle->GetCommands();
+                iter->Reset();
+                Command type;
+                while (iter->NextCommandId(&type)) {
+                    recorder.EncodeRenderBundleCommand(iter, type);
+                }
+            }));
+        if (secondaryCommandBuffer == VK_NULL_HANDLE) {
+            secondaryCommandBuffers->clear();
+            return false;
+        }
+        secondaryCommandBuffers->push_back(secondaryCommandBuffer);
     }
+    return true;
 }
 
 }  // anonymous namespace
 
 MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
                                  Device* device,
-                                 BeginRenderPassCmd* renderPass) {
+                                 BeginRenderPassCmd* renderPass,
+                                 VkSubpassContents contents) {
     VkCommandBuffer commands = recordingContext->commandBuffer;
 
     // Query a VkRenderPass from the cache
     VkRenderPass renderPassVK = VK_NULL_HANDLE;
-    {
-        RenderPassCacheQuery query;
-
-        for (auto i : IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
-            const auto& attachmentInfo = renderPass->colorAttachments[i];
-            bool hasResolveTarget = attachmentInfo.resolveTarget != nullptr;
-
-            query.SetColor(i, attachmentInfo.view->GetFormat().format, attachmentInfo.loadOp,
-                           attachmentInfo.storeOp, hasResolveTarget);
-        }
-
-        if (renderPass->attachmentState->HasDepthStencilAttachment()) {
-            const auto& attachmentInfo = renderPass->depthStencilAttachment;
-
-            query.SetDepthStencil(attachmentInfo.view->GetTexture()->GetFormat().format,
-                                  attachmentInfo.depthLoadOp, attachmentInfo.depthStoreOp,
-                                  attachmentInfo.depthReadOnly, attachmentInfo.stencilLoadOp,
-                                  attachmentInfo.stencilStoreOp, attachmentInfo.stencilReadOnly);
-        }
-
-        query.SetSampleCount(renderPass->attachmentState->GetSampleCount());
-
-        RenderPassCache::RenderPassInfo renderPassInfo;
-        DAWN_TRY_ASSIGN(renderPassInfo, device->GetRenderPassCache()->GetRenderPass(query));
-        renderPassVK = renderPassInfo.renderPass;
-    }
+    DAWN_TRY_ASSIGN(renderPassVK, GetRenderPassForCmd(device, renderPass));
 
     // Create a framebuffer that will be used once for the render pass and gather the clear
     // values for the attachments at the same time.
@@ -538,10 +1123,11 @@ MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
     beginInfo.pClearValues = clearValues.data();
 
     if (renderPass->attachmentState->GetExpandResolveInfo().attachmentsToExpandResolve.any()) {
+        DAWN_ASSERT(contents == VK_SUBPASS_CONTENTS_INLINE);
         DAWN_TRY(BeginRenderPassAndExpandResolveTextureWithDraw(device, recordingContext,
                                                                 renderPass, beginInfo));
     } else {
-        device->fn.CmdBeginRenderPass(commands, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+        device->fn.CmdBeginRenderPass(commands, &beginInfo, contents);
     }
 
     return {};
@@ -636,6 +1222,20 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
         return {};
     };
 
+    // The number of copies after the current command whose transitions were already recorded
+    // with the barrier of an earlier copy.
+    size_t batchedCopyCount = 0;
+    // Records the barrier of the copy from `source` to `destination` whose transitions are
+    // pending, together with the transitions of the copies that follow it when possible.
+    auto FlushCopyBarriers = [&](const ApiObjectBase* source, const ApiObjectBase* destination) {
+        BatchedResources resources;
+        resources.Use(source, /*isReadOnly=*/true);
+        resources.Use(destination, /*isReadOnly=*/false);
+        batchedCopyCount =
+            TransitionFollowingCopies(device, recordingContext, &mCommands, &resources);
+        recordingContext->FlushBarriers(device->fn);
+    };
+
     size_t nextComputePassNumber = 0;
     size_t nextRenderPassNumber = 0;
 
@@ -656,8 +1256,17 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
                 dstBuffer->EnsureDataInitializedAsDestination(recordingContext,
                                                               copy->destinationOffset, copy->size);
 
-                srcBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
-                dstBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
+                // Both transitions are merged into a single vkCmdPipelineBarrier, with the ones of
+                // the following copies when possible.
+                if (batchedCopyCount > 0) {
+                    batchedCopyCount--;
+                } else {
+                    srcBuffer->TransitionUsageForNextCommand(recordingContext,
+                                                             wgpu::BufferUsage::CopySrc);
+                    dstBuffer->TransitionUsageForNextCommand(recordingContext,
+                                                             wgpu::BufferUsage::CopyDst);
+                    FlushCopyBarriers(srcBuffer, dstBuffer);
+                }
 
                 VkBufferCopy region;
                 region.srcOffset = copy->sourceOffset;
@@ -696,11 +1305,17 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
                     DAWN_TRY(ToBackend(dst.texture)
                                  ->EnsureSubresourceContentInitialized(recordingContext, range));
                 }
-                ToBackend(src.buffer)
-                    ->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
-                ToBackend(dst.texture)
-                    ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopyDst,
-                                         wgpu::ShaderStage::None, range);
+                if (batchedCopyCount > 0) {
+                    batchedCopyCount--;
+                } else {
+                    ToBackend(src.buffer)->TransitionUsageForNextCommand(
+                        recordingContext, wgpu::BufferUsage::CopySrc);
+                    ToBackend(dst.texture)
+                        ->TransitionUsageForNextCommand(recordingContext,
+                                                        wgpu::TextureUsage::CopyDst,
+                                                        wgpu::ShaderStage::None, range);
+                    FlushCopyBarriers(src.buffer.Get(), dst.texture.Get());
+                }
                 VkBuffer srcBuffer = ToBackend(src.buffer)->GetHandle();
                 VkImage dstImage = ToBackend(dst.texture)->GetHandle();
 
@@ -731,11 +1346,17 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
                 DAWN_TRY(ToBackend(src.texture)
                              ->EnsureSubresourceContentInitialized(recordingContext, range));
 
-                ToBackend(src.texture)
-                    ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopySrc,
-                                         wgpu::ShaderStage::None, range);
-                ToBackend(dst.buffer)
-                    ->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
+                if (batchedCopyCount > 0) {
+                    batchedCopyCount--;
+                } else {
+                    ToBackend(src.texture)
+                        ->TransitionUsageForNextCommand(recordingContext,
+                                                        wgpu::TextureUsage::CopySrc,
+                                                        wgpu::ShaderStage::None, range);
+                    ToBackend(dst.buffer)->TransitionUsageForNextCommand(
+                        recordingContext, wgpu::BufferUsage::CopyDst);
+                    FlushCopyBarriers(src.texture.Get(), dst.buffer.Get());
+                }
 
                 VkImage srcImage = ToBackend(src.texture)->GetHandle();
                 VkBuffer dstBuffer = ToBackend(dst.buffer)->GetHandle();
@@ -777,12 +1398,26 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
                                                    copy->copySize.depthOrArrayLayers));
                 }
 
-                ToBackend(src.texture)
-                    ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopySrc,
-                                         wgpu::ShaderStage::None, srcRange);
-                ToBackend(dst.texture)
-                    ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopyDst,
-                                         wgpu::ShaderStage::None, dstRange);
+                bool copyUsingTemporaryBuffer = ShouldCopyUsingTemporaryBuffer(device, copy);
+
+                if (batchedCopyCount > 0) {
+                    batchedCopyCount--;
+                } else {
+                    ToBackend(src.texture)
+                        ->TransitionUsageForNextCommand(recordingContext,
+                                                        wgpu::TextureUsage::CopySrc,
+                                                        wgpu::ShaderStage::None, srcRange);
+                    ToBackend(dst.texture)
+                        ->TransitionUsageForNextCommand(recordingContext,
+                                                        wgpu::TextureUsage::CopyDst,
+                                                        wgpu::ShaderStage::None, dstRange);
+                    if (copyUsingTemporaryBuffer) {
+                        // The copy records barriers for the temporary buffer between the copies.
+                        recordingContext->FlushBarriers(device->fn);
+                    } else {
+                        FlushCopyBarriers(src.texture.Get(), dst.texture.Get());
+                    }
+                }
 
                 // In some situations we cannot do texture-to-texture copies with vkCmdCopyImage
                 // because as Vulkan SPEC always validates image copies with the virtual size of
@@ -795,12 +1430,6 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
                 // the extent of vkCmdCopyImage.
                 // Our workaround for this issue is replacing the texture-to-texture copy with
                 // one texture-to-buffer copy and one buffer-to-texture copy.
-                bool copyUsingTemporaryBuffer =
-                    device->IsToggleEnabled(
-                        Toggle::UseTemporaryBufferInCompressedTextureToTextureCopy) &&
-                    src.texture->GetFormat().isCompressed &&
-                    !HasSameTextureCopyExtent(src, dst, copy->copySize);
-
                 if (!copyUsingTemporaryBuffer) {
                     VkImage srcImage = ToBackend(src.texture)->GetHandle();
                     VkImage dstImage = ToBackend(dst.texture)->GetHandle();
@@ -1034,6 +1663,26 @@ MaybeError CommandBuffer::RecordComputePass(CommandRecordingContext* recordingCo
     uint64_t currentDispatch = 0;
     DescriptorSetTracker descriptorSets = {};
 
+    // The dispatches before this index already had their barriers recorded, together with the
+    // barriers of an earlier dispatch. Other commands of the pass don't use resources that need
+    // barriers, so the barriers of consecutive dispatches can be recorded before the first of them.
+    uint64_t nextDispatchToTransition = 0;
+    auto TransitionForCurrentDispatch = [&]() -> MaybeError {
+        if (currentDispatch < nextDispatchToTransition) {
+            return {};
+        }
+        size_t dispatchCount =
+            CountBatchableSyncScopes(resourceUsages.dispatchUsages, currentDispatch);
+        SyncScopeBarriers barriers;
+        for (size_t i = 0; i < dispatchCount; ++i) {
+            DAWN_TRY(AddBarriersAndClearForSyncScope(
+                recordingContext, resourceUsages.dispatchUsages[currentDispatch + i], &barriers));
+        }
+        RecordSyncScopeBarriers(device, recordingContext, barriers);
+        nextDispatchToTransition = currentDispatch + dispatchCount;
+        return {};
+    };
+
     Command type;
     while (mCommands.NextCommandId(&type)) {
         switch (type) {
@@ -1054,9 +1703,8 @@ MaybeError CommandBuffer::RecordComputePass(CommandRecordingContext* recordingCo
             case Command::Dispatch: {
                 DispatchCmd* dispatch = mCommands.NextCommand<DispatchCmd>();
 
-                DAWN_TRY(TransitionAndClearForSyncScope(
-                    device, recordingContext, resourceUsages.dispatchUsages[currentDispatch]));
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_COMPUTE);
+                DAWN_TRY(TransitionForCurrentDispatch());
+                descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_COMPUTE);
 
                 device->fn.CmdDispatch(commands, dispatch->x, dispatch->y, dispatch->z);
                 currentDispatch++;
@@ -1067,9 +1715,8 @@ MaybeError CommandBuffer::RecordComputePass(CommandRecordingContext* recordingCo
                 DispatchIndirectCmd* dispatch = mCommands.NextCommand<DispatchIndirectCmd>();
                 VkBuffer indirectBuffer = ToBackend(dispatch->indirectBuffer)->GetHandle();
 
-                DAWN_TRY(TransitionAndClearForSyncScope(
-                    device, recordingContext, resourceUsages.dispatchUsages[currentDispatch]));
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_COMPUTE);
+                DAWN_TRY(TransitionForCurrentDispatch());
+                descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_COMPUTE);
 
                 device->fn.CmdDispatchIndirect(commands, indirectBuffer,
                                                static_cast<VkDeviceSize>(dispatch->indirectOffset));
@@ -1183,257 +1830,31 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingCon
                                 VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
     }
 
-    DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd));
-
-    // Set the default value for the dynamic state
-    {
-        device->fn.CmdSetLineWidth(commands, 1.0f);
-        device->fn.CmdSetDepthBounds(commands, 0.0f, 1.0f);
-
-        device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK, 0);
-
-        float blendConstants[4] = {
-            0.0f,
-            0.0f,
-            0.0f,
-            0.0f,
-        };
-        device->fn.CmdSetBlendConstants(commands, blendConstants);
-
-        // The viewport and scissor default to cover all of the attachments
-        VkViewport viewport;
-        viewport.x = 0.0f;
-        viewport.y = static_cast<float>(renderPassCmd->height);
-        viewport.width = static_cast<float>(renderPassCmd->width);
-        viewport.height = -static_cast<float>(renderPassCmd->height);
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-        device->fn.CmdSetViewport(commands, 0, 1, &viewport);
-
-        VkRect2D scissorRect;
-        scissorRect.offset.x = 0;
-        scissorRect.offset.y = 0;
-        scissorRect.extent.width = renderPassCmd->width;
-        scissorRect.extent.height = renderPassCmd->height;
-        device->fn.CmdSetScissor(commands, 0, 1, &scissorRect);
+    // Render passes that only execute render bundles run the secondary command buffers of the
+    // bundles instead of recording their commands again.
+    std::vector<VkCommandBuffer> secondaryCommandBuffers;
+    bool useSecondaryCommandBuffers = false;
+    if (device->IsToggleEnabled(Toggle::VulkanUseSecondaryCommandBuffersForRenderBundles) &&
+        !renderPassCmd->attachmentState->GetExpandResolveInfo().attachmentsToExpandResolve.any()) {
+        VkRenderPass renderPassVK = VK_NULL_HANDLE;
+        DAWN_TRY_ASSIGN(renderPassVK, GetRenderPassForCmd(device, renderPassCmd));
+        DAWN_TRY_ASSIGN(useSecondaryCommandBuffers,
+                        GetSecondaryCommandBuffersForRenderPass(device, &mCommands, renderPassCmd,
+                                                                renderPassVK,
+                                                                &secondaryCommandBuffers));
     }
+    size_t nextSecondaryCommandBuffer = 0;
 
-    DescriptorSetTracker descriptorSets = {};
-    RenderPipeline* lastPipeline = nullptr;
-
-    // Tracking for the push constants needed by the ClampFragDepth transform.
-    // TODO(dawn:1125): Avoid the need for this when the depthClamp feature is available, but doing
-    // so would require fixing issue dawn:1576 first to have more dynamic push constant usage. (and
-    // also additional tests that the dirtying logic here is correct so with a Toggle we can test it
-    // on our infra).
-    ClampFragDepthArgs clampFragDepthArgs = {0.0f, 1.0f};
-    bool clampFragDepthArgsDirty = true;
-    auto ApplyClampFragDepthArgs = [&] {
-        if (!clampFragDepthArgsDirty || lastPipeline == nullptr) {
-            return;
-        }
-        device->fn.CmdPushConstants(
-            commands, lastPipeline->GetVkLayout(),
-            ToBackend(lastPipeline->GetLayout())->GetImmediateDataRangeStage(),
-            kClampFragDepthArgsOffset, kClampFragDepthArgsSize, &clampFragDepthArgs);
-        clampFragDepthArgsDirty = false;
-    };
-
-    auto EncodeRenderBundleCommand = [&](CommandIterator* iter, Command type) {
-        switch (type) {
-            case Command::Draw: {
-                DrawCmd* draw = iter->NextCommand<DrawCmd>();
-
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                device->fn.CmdDraw(commands, draw->vertexCount, draw->instanceCount,
-                                   draw->firstVertex, draw->firstInstance);
-                break;
-            }
-
-            case Command::DrawIndexed: {
-                DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
-
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                device->fn.CmdDrawIndexed(commands, draw->indexCount, draw->instanceCount,
-                                          draw->firstIndex, draw->baseVertex, draw->firstInstance);
-                break;
-            }
-
-            case Command::DrawIndirect: {
-                DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
-                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
-
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                device->fn.CmdDrawIndirect(commands, buffer->GetHandle(),
-                                           static_cast<VkDeviceSize>(draw->indirectOffset), 1, 0);
-                break;
-            }
-
-            case Command::DrawIndexedIndirect: {
-                DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
-                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
-                DAWN_ASSERT(buffer != nullptr);
-
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                device->fn.CmdDrawIndexedIndirect(commands, buffer->GetHandle(),
-                                                  static_cast<VkDeviceSize>(draw->indirectOffset),
-                                                  1, 0);
-                break;
-            }
-
-            case Command::MultiDrawIndirect: {
-                MultiDrawIndirectCmd* cmd = iter->NextCommand<MultiDrawIndirectCmd>();
-
-                Buffer* indirectBuffer = ToBackend(cmd->indirectBuffer.Get());
-                DAWN_ASSERT(indirectBuffer != nullptr);
-
-                // Count buffer is optional
-                Buffer* countBuffer = ToBackend(cmd->drawCountBuffer.Get());
-
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-
-                if (countBuffer == nullptr) {
-                    device->fn.CmdDrawIndirect(commands, indirectBuffer->GetHandle(),
-                                               static_cast<VkDeviceSize>(cmd->indirectOffset),
-                                               cmd->maxDrawCount, kDrawIndirectSize);
-                } else {
-                    device->fn.CmdDrawIndirectCountKHR(
-                        commands, indirectBuffer->GetHandle(),
-                        static_cast<VkDeviceSize>(cmd->indirectOffset), countBuffer->GetHandle(),
-                        static_cast<VkDeviceSize>(cmd->drawCountOffset), cmd->maxDrawCount,
-                        kDrawIndirectSize);
-                }
-                break;
-            }
-            case Command::MultiDrawIndexedIndirect: {
-                MultiDrawIndexedIndirectCmd* cmd = iter->NextCommand<MultiDrawIndexedIndirectCmd>();
-
-                Buffer* indirectBuffer = ToBackend(cmd->indirectBuffer.Get());
-                DAWN_ASSERT(indirectBuffer != nullptr);
-
-                // Count buffer is optional
-                Buffer* countBuffer = ToBackend(cmd->drawCountBuffer.Get());
-
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-
-                if (countBuffer == nullptr) {
-                    device->fn.CmdDrawIndexedIndirect(
-                        commands, indirectBuffer->GetHandle(),
-                        static_cast<VkDeviceSize>(cmd->indirectOffset), cmd->maxDrawCount,
-                        kDrawIndexedIndirectSize);
-                } else {
-                    device->fn.CmdDrawIndexedIndirectCountKHR(
-                        commands, indirectBuffer->GetHandle(),
-                        static_cast<VkDeviceSize>(cmd->indirectOffset), countBuffer->GetHandle(),
-                        static_cast<VkDeviceSize>(cmd->drawCountOffset), cmd->maxDrawCount,
-                        kDrawIndexedIndirectSize);
-                }
-
-                break;
-            }
-
-            case Command::InsertDebugMarker: {
-                if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                    InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
-                    const char* label = iter->NextData<char>(cmd->length + 1);
-                    VkDebugUtilsLabelEXT utilsLabel;
-                    utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-                    utilsLabel.pNext = nullptr;
-                    utilsLabel.pLabelName = label;
-                    // Default color to black
-                    utilsLabel.color[0] = 0.0;
-                    utilsLabel.color[1] = 0.0;
-                    utilsLabel.color[2] = 0.0;
-                    utilsLabel.color[3] = 1.0;
-                    device->fn.CmdInsertDebugUtilsLabelEXT(commands, &utilsLabel);
-                } else {
-                    SkipCommand(iter, Command::InsertDebugMarker);
-                }
-                break;
-            }
-
-            case Command::PopDebugGroup: {
-                if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                    iter->NextCommand<PopDebugGroupCmd>();
-                    device->fn.CmdEndDebugUtilsLabelEXT(commands);
-                } else {
-                    SkipCommand(iter, Command::PopDebugGroup);
-                }
-                break;
-            }
-
-            case Command::PushDebugGroup: {
-                if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                    PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
-                    const char* label = iter->NextData<char>(cmd->length + 1);
-                    VkDebugUtilsLabelEXT utilsLabel;
-                    utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-                    utilsLabel.pNext = nullptr;
-                    utilsLabel.pLabelName = label;
-                    // Default color to black
-                    utilsLabel.color[0] = 0.0;
-                    utilsLabel.color[1] = 0.0;
-                    utilsLabel.color[2] = 0.0;
-                    utilsLabel.color[3] = 1.0;
-                    device->fn.CmdBeginDebugUtilsLabelEXT(commands, &utilsLabel);
-                } else {
-                    SkipCommand(iter, Command::PushDebugGroup);
-                }
-                break;
-            }
-
-            case Command::SetBindGroup: {
-                SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
-                BindGroup* bindGroup = ToBackend(cmd->group.Get());
-                uint32_t* dynamicOffsets = nullptr;
-                if (cmd->dynamicOffsetCount > 0) {
-                    dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
-                }
-
-                descriptorSets.OnSetBindGroup(cmd->index, bindGroup, cmd->dynamicOffsetCount,
-                                              dynamicOffsets);
-                break;
-            }
-
-            case Command::SetIndexBuffer: {
-                SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
-                VkBuffer indexBuffer = ToBackend(cmd->buffer)->GetHandle();
-
-                device->fn.CmdBindIndexBuffer(commands, indexBuffer, cmd->offset,
-                                              VulkanIndexType(cmd->format));
-                break;
-            }
-
-            case Command::SetRenderPipeline: {
-                SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
-                RenderPipeline* pipeline = ToBackend(cmd->pipeline).Get();
-
-                device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                           pipeline->GetHandle());
-                lastPipeline = pipeline;
-
-                descriptorSets.OnSetPipeline<RenderPipeline>(pipeline);
-
-                // Apply the deferred min/maxDepth push constants update if needed.
-                ApplyClampFragDepthArgs();
-                break;
-            }
-
-            case Command::SetVertexBuffer: {
-                SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
-                VkBuffer buffer = ToBackend(cmd->buffer)->GetHandle();
-                VkDeviceSize offset = static_cast<VkDeviceSize>(cmd->offset);
+    DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd,
+                                   useSecondaryCommandBuffers
+                                       ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+                                       : VK_SUBPASS_CONTENTS_INLINE));
 
-                device->fn.CmdBindVertexBuffers(commands, static_cast<uint8_t>(cmd->slot), 1,
-                                                &*buffer, &offset);
-                break;
-            }
+    if (!useSecondaryCommandBuffers) {
+        RecordDefaultDynamicState(device, commands, renderPassCmd->width, renderPassCmd->height);
+    }
 
-            default:
-                DAWN_UNREACHABLE();
-                break;
-        }
-    };
+    RenderCommandRecorder recorder(device, commands);
 
     Command type;
     while (mCommands.NextCommandId(&type)) {
@@ -1495,9 +1916,7 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingCon
 
                 // Try applying the push constants that contain min/maxDepth immediately. This can
                 // be deferred if no pipeline is currently bound.
-                clampFragDepthArgs = {viewport.minDepth, viewport.maxDepth};
-                clampFragDepthArgsDirty = true;
-                ApplyClampFragDepthArgs();
+                recorder.SetClampFragDepthArgs(viewport.minDepth, viewport.maxDepth);
                 break;
             }
 
@@ -1517,11 +1936,23 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingCon
                 ExecuteBundlesCmd* cmd = mCommands.NextCommand<ExecuteBundlesCmd>();
                 auto bundles = mCommands.NextData<Ref<RenderBundleBase>>(cmd->count);
 
+                if (useSecondaryCommandBuffers) {
+                    if (cmd->count > 0) {
+                        DAWN_ASSERT(nextSecondaryCommandBuffer + cmd->count <=
+                                    secondaryCommandBuffers.size());
+                        device->fn.CmdExecuteCommands(
+                            commands, cmd->count,
+                            &secondaryCommandBuffers[nextSecondaryCommandBuffer]);
+                        nextSecondaryCommandBuffer += cmd->count;
+                    }
+                    break;
+                }
+
                 for (uint32_t i = 0; i < cmd->count; ++i) {
                     CommandIterator* iter = bundles[i]->GetCommands();
                     iter->Reset();
                     while (iter->NextCommandId(&type)) {
-                        EncodeRenderBundleCommand(iter, type);
+                        recorder.EncodeRenderBundleCommand(iter, type);
                     }
                 }
                 break;
@@ -1552,7 +1983,7 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingCon
             }
 
             default: {
-                EncodeRenderBundleCommand(&mCommands, type);
+                recorder.EncodeRenderBundleCommand(&mCommands, type);
                 break;
             }
         }
@@ -48,7 +48,8 @@ class Device;
 
 MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
                                  Device* device,
-                                 BeginRenderPassCmd* renderPass);
+                                 BeginRenderPassCmd* renderPass,
+                                 VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
 
 class CommandBuffer final : public CommandBufferBase {
   public:
@@ -0,0 +1,72 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/native/vulkan/CommandRecordingContext.h"
+
+#include "dawn/common/Assert.h"
+
+namespace dawn::native::vulkan {
+
+bool BarrierBatch::IsEmpty() const {
+    return bufferBarriers.empty() && imageBarriers.empty();
+}
+
+void CommandRecordingContext::RecordPipelineBarrier(const VulkanFunctions& fn,
+                                                    VkPipelineStageFlags srcStages,
+                                                    VkPipelineStageFlags dstStages,
+                                                    uint32_t bufferBarrierCount,
+                                                    const VkBufferMemoryBarrier* bufferBarriers,
+                                                    uint32_t imageBarrierCount,
+                                                    const VkImageMemoryBarrier* imageBarriers) {
+    DAWN_ASSERT(srcStages != 0 && dstStages != 0);
+    fn.CmdPipelineBarrier(commandBuffer, srcStages, dstStages, 0, 0, nullptr, bufferBarrierCount,
+                          bufferBarriers, imageBarrierCount, imageBarriers);
+
+    barrierStats.pipelineBarrierCount++;
+    barrierStats.bufferBarrierCount += bufferBarrierCount;
+    barrierStats.imageBarrierCount += imageBarrierCount;
+}
+
+void CommandRecordingContext::FlushBarriers(const VulkanFunctions& fn) {
+    if (pendingBarriers.IsEmpty()) {
+        return;
+    }
+
+    RecordPipelineBarrier(fn, pendingBarriers.srcStages, pendingBarriers.dstStages,
+                          pendingBarriers.bufferBarriers.size(),
+                          pendingBarriers.bufferBarriers.data(),
+                          pendingBarriers.imageBarriers.size(),
+                          pendingBarriers.imageBarriers.data());
+
+    // Keep the storage of the vectors for the next commands.
+    pendingBarriers.srcStages = 0;
+    pendingBarriers.dstStages = 0;
+    pendingBarriers.bufferBarriers.clear();
+    pendingBarriers.imageBarriers.clear();
+}
+
+}  // namespace dawn::native::vulkan
@@ -48,9 +48,39 @@ struct CommandPoolAndBuffer {
     VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
 };
 
-// Used to track operations that are handled after recording.
-// Currently only tracks semaphores, but may be used to do barrier coalescing in the future.
+// Buffer and image barriers that are recorded together with a single vkCmdPipelineBarrier.
+struct BarrierBatch {
+    bool IsEmpty() const;
+
+    VkPipelineStageFlags srcStages = 0;
+    VkPipelineStageFlags dstStages = 0;
+    std::vector<VkBufferMemoryBarrier> bufferBarriers;
+    std::vector<VkImageMemoryBarrier> imageBarriers;
+};
+
+// Counts of the barriers recorded in a CommandRecordingContext, reported per submit.
+struct BarrierStats {
+    uint64_t pipelineBarrierCount = 0;
+    uint64_t bufferBarrierCount = 0;
+    uint64_t imageBarrierCount = 0;
+};
+
+// Used to track operations that are handled after recording, and the barriers that are merged
+// before the next command.
 struct CommandRecordingContext {
+    // Records a vkCmdPipelineBarrier and counts it in barrierStats.
+    void RecordPipelineBarrier(const VulkanFunctions& fn,
+                               VkPipelineStageFlags srcStages,
+                               VkPipelineStageFlags dstStages,
+                               uint32_t bufferBarrierCount,
+                               const VkBufferMemoryBarrier* bufferBarriers,
+                               uint32_t imageBarrierCount,
+                               const VkImageMemoryBarrier* imageBarriers);
+
+    // Records the barriers accumulated in pendingBarriers, if any. This must be called before
+    // recording a command that uses resources transitioned with TransitionUsageForNextCommand.
+    void FlushBarriers(const VulkanFunctions& fn);
+
     VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
     std::vector<VkSemaphore> waitSemaphores = {};
     std::vector<VkSemaphore> signalSemaphores = {};
@@ -88,6 +118,11 @@ struct CommandRecordingContext {
     // Need to track if a render pass has already been recorded for the
     // VulkanSplitCommandBufferOnComputePassAfterRenderPass workaround.
     bool hasRecordedRenderPass = false;
+
+    // The transitions of all the resources used by the next command, so that they are recorded
+    // with a single barrier instead of one barrier per resource.
+    BarrierBatch pendingBarriers;
+    BarrierStats barrierStats;
 };
 
 }  // namespace dawn::native::vulkan
@@ -27,6 +27,8 @@
 
 #include "dawn/native/vulkan/DeviceVk.h"
 
+#include "absl/container/flat_hash_set.h"
+
 #include "dawn/common/Log.h"
 #include "dawn/common/NonCopyable.h"
 #include "dawn/common/Platform.h"
@@ -51,6 +53,7 @@
 #include "dawn/native/vulkan/PipelineLayoutVk.h"
 #include "dawn/native/vulkan/QuerySetVk.h"
 #include "dawn/native/vulkan/QueueVk.h"
+#include "dawn/native/vulkan/RenderBundleVk.h"
 #include "dawn/native/vulkan/RenderPassCache.h"
 #include "dawn/native/vulkan/RenderPipelineVk.h"
 #include "dawn/native/vulkan/ResourceMemoryAllocatorVk.h"
@@ -195,6 +198,17 @@ ResultOrError<Ref<CommandBufferBase>> Device::CreateCommandBuffer(
     const CommandBufferDescriptor* descriptor) {
     return CommandBuffer::Create(encoder, descriptor);
 }
+Ref<RenderBundleBase> Device::CreateRenderBundle(RenderBundleEncoder* encoder,
+                                                 const RenderBundleDescriptor* descriptor,
+                                                 Ref<AttachmentState> attachmentState,
+                                                 bool depthReadOnly,
+                                                 bool stencilReadOnly,
+                                                 RenderPassResourceUsage resourceUsage,
+                                                 IndirectDrawMetadata indirectDrawMetadata) {
+    return RenderBundle::Create(encoder, descriptor, std::move(attachmentState), depthReadOnly,
+                                stencilReadOnly, std::move(resourceUsage),
+                                std::move(indirectDrawMetadata));
+}
 Ref<ComputePipelineBase> Device::CreateUninitializedComputePipelineImpl(
     const UnpackedPtr<ComputePipelineDescriptor>& descriptor) {
     return ComputePipeline::CreateUninitialized(this, descriptor);
@@ -244,7 +258,8 @@ Ref<PipelineCacheBase> Device::GetOrCreatePipelineCacheImpl(const CacheKey& key)
             auto& deviceProperties = GetDeviceInfo().properties;
             StreamIn(&cacheKey, deviceProperties.pipelineCacheUUID);
 
-            mMonolithicPipelineCache = PipelineCache::CreateMonolithic(this, cacheKey);
+            mMonolithicPipelineCache = PipelineCache::CreateMonolithic(
+                this, cacheKey, IsToggleEnabled(Toggle::VulkanMergePipelineCaches));
         }
         return mMonolithicPipelineCache;
     }
@@ -924,6 +939,10 @@ void Device::DestroyImpl() {
     // Allow recycled memory to be deleted.
     GetResourceMemoryAllocator()->DestroyPool();
 
+    // The pending pipeline cache merges were cancelled or completed when the device was
+    // disconnected. Destroy the VkPipelineCaches before the VkDevice.
+    mMonolithicPipelineCache = nullptr;
+
     // The VkRenderPasses in the cache can be destroyed immediately since all commands referring
     // to them are guaranteed to be finished executing.
     mRenderPassCache = nullptr;
@@ -1014,13 +1033,81 @@ void Device::SetLabelImpl() {
 
 void Device::PerformIdleTasksImpl() {
     if (mMonolithicPipelineCache) {
-        MaybeError maybeError = mMonolithicPipelineCache->StoreOnIdle();
+        // Merge the compile caches that the worker thread didn't merge yet so that they are
+        // stored too.
+        MaybeError maybeError = mMonolithicPipelineCache->MergeCompileCaches();
+        if (maybeError.IsSuccess()) {
+            maybeError = mMonolithicPipelineCache->StoreOnIdle();
+        }
         if (maybeError.IsError()) {
             std::unique_ptr<ErrorData> error = maybeError.AcquireError();
             EmitLog(WGPULoggingType_Error, error->GetFormattedMessage().c_str());
             return;
         }
     }
+
+    if (IsToggleEnabled(Toggle::VulkanDefragmentMemoryOnIdle)) {
+        // Release the free heaps that are no longer reused, which include the heaps that the
+        // buffers were moved out of once the copies are done.
+        GetResourceMemoryAllocator()->DestroyUnusedPools();
+
+        MaybeError maybeError = MoveBuffersOutOfSparseHeaps();
+        if (maybeError.IsError()) {
+            std::unique_ptr<ErrorData> error = maybeError.AcquireError();
+            EmitLog(WGPULoggingType_Error, error->GetFormattedMessage().c_str());
+            return;
+        }
+    }
+}
+
+MaybeError Device::MoveBuffersOutOfSparseHeaps() {
+    MutexProtected<ResourceMemoryAllocator>& allocator = GetResourceMemoryAllocator();
+
+    std::vector<Ref<Buffer>> movableBuffers;
+    std::vector<ResourceMemoryAllocation> movableAllocations;
+    GetObjectTrackingList(ObjectType::Buffer)->ForEach([&](ApiObjectBase* object) {
+        Buffer* buffer = ToBackend(static_cast<BufferBase*>(object));
+        if (buffer->CanMoveMemory()) {
+            movableBuffers.push_back(buffer);
+            movableAllocations.push_back(buffer->GetMemoryAllocation());
+        }
+    });
+
+    absl::flat_hash_set<const ResourceHeapBase*> heapsToRelease =
+        allocator->SelectHeapsToRelease(movableAllocations);
+    if (heapsToRelease.empty()) {
+        return {};
+    }
+
+    std::vector<Ref<Buffer>> buffers;
+    for (const Ref<Buffer>& buffer : movableBuffers) {
+        if (heapsToRelease.contains(buffer->GetMemoryAllocation().GetResourceHeap())) {
+            buffers.push_back(buffer);
+        }
+    }
+    absl::flat_hash_set<const ResourceHeapBase*> sparseHeaps = allocator->GetSparseHeaps();
+
+    CommandRecordingContext* recordingContext =
+        ToBackend(GetQueue())->GetPendingRecordingContext();
+    for (const Ref<Buffer>& buffer : buffers) {
+        bool moved = false;
+        DAWN_TRY_ASSIGN_WITH_CLEANUP(
+            moved, buffer->MoveMemoryOutOfHeaps(recordingContext, sparseHeaps),
+            { allocator->ReleaseReservedBlocks(); });
+        if (!moved) {
+            // Too many free blocks of the sparse heaps are reserved. The remaining buffers are
+            // moved during the next idle tasks.
+            break;
+        }
+    }
+    allocator->ReleaseReservedBlocks();
+    GetQueue()->ForceEventualFlushOfCommands();
+
+    return {};
+}
+
+ResourceMemoryStats Device::GetResourceMemoryStats() const {
+    return GetResourceMemoryAllocator()->GetStats();
 }
 
 }  // namespace dawn::native::vulkan
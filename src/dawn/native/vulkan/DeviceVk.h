@@ -95,6 +95,13 @@ class Device final : public DeviceBase {
     ResultOrError<Ref<CommandBufferBase>> CreateCommandBuffer(
         CommandEncoder* encoder,
         const CommandBufferDescriptor* descriptor) override;
+    Ref<RenderBundleBase> CreateRenderBundle(RenderBundleEncoder* encoder,
+                                             const RenderBundleDescriptor* descriptor,
+                                             Ref<AttachmentState> attachmentState,
+                                             bool depthReadOnly,
+                                             bool stencilReadOnly,
+                                             RenderPassResourceUsage resourceUsage,
+                                             IndirectDrawMetadata indirectDrawMetadata) override;
 
     MaybeError TickImpl() override;
 
@@ -119,6 +126,7 @@ class Device final : public DeviceBase {
 
     void SetLabelImpl() override;
     void PerformIdleTasksImpl() override;
+    ResourceMemoryStats GetResourceMemoryStats() const override;
 
     void OnDebugMessage(std::string message);
 
@@ -171,6 +179,10 @@ class Device final : public DeviceBase {
 
     ResultOrError<VulkanDeviceKnobs> CreateDevice(VkPhysicalDevice vkPhysicalDevice);
 
+    // Moves the buffers out of the sparse memory heaps that can be released, see
+    // ResourceMemoryAllocator::SelectHeapsToRelease.
+    MaybeError MoveBuffersOutOfSparseHeaps();
+
     MaybeError CheckDebugLayerAndGenerateErrors();
     void AppendDebugLayerMessages(ErrorData* error) override;
     void CheckDebugMessagesAfterDestruction() const;
@@ -43,6 +43,7 @@ class FencedDeleter {
     ~FencedDeleter();
 
     void DeleteWhenUnused(VkBuffer buffer);
+    void DeleteWhenUnused(VkCommandPool pool);
     void DeleteWhenUnused(VkDescriptorPool pool);
     void DeleteWhenUnused(VkDeviceMemory memory);
     void DeleteWhenUnused(VkFence fence);
@@ -65,6 +66,7 @@ class FencedDeleter {
   private:
     raw_ptr<Device> mDevice = nullptr;
     SerialQueue<ExecutionSerial, VkBuffer> mBuffersToDelete;
+    SerialQueue<ExecutionSerial, VkCommandPool> mCommandPoolsToDelete;
     SerialQueue<ExecutionSerial, VkDescriptorPool> mDescriptorPoolsToDelete;
     SerialQueue<ExecutionSerial, VkDeviceMemory> mMemoriesToDelete;
     SerialQueue<ExecutionSerial, VkFence> mFencesToDelete;
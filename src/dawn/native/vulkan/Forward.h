@@ -43,6 +43,7 @@ class PipelineCache;
 class PipelineLayout;
 class QuerySet;
 class Queue;
+class RenderBundle;
 class RenderPipeline;
 class ResourceHeap;
 class Sampler;
@@ -65,6 +66,7 @@ struct VulkanBackendTraits {
     using PipelineLayoutType = PipelineLayout;
     using QuerySetType = QuerySet;
     using QueueType = Queue;
+    using RenderBundleType = RenderBundle;
     using RenderPipelineType = RenderPipeline;
     using ResourceHeapType = ResourceHeap;
     using SamplerType = Sampler;
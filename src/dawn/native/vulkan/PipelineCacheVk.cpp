@@ -28,7 +28,9 @@
 #include "dawn/native/vulkan/PipelineCacheVk.h"
 
 #include <memory>
+#include <utility>
 
+#include "dawn/native/AsyncTask.h"
 #include "dawn/native/Device.h"
 #include "dawn/native/Error.h"
 #include "dawn/native/Toggles.h"
@@ -38,30 +40,59 @@
 
 namespace dawn::native::vulkan {
 
+namespace {
+
+// The amount of data that must be merged into a monolithic cache before the worker thread stores
+// it to BlobCache. Smaller amounts are stored by StoreOnIdle() so that pipelines compiled one
+// after the other don't serialize the whole cache each time.
+constexpr size_t kMinMergedDataSizeToStore = 256 * 1024;
+
+// The number of compile caches created ahead of the compilations that use them, after each merge.
+// Each of them holds a copy of the data of the monolithic cache. Compilations that find none of
+// them left create their own compile cache.
+constexpr size_t kMaxFreeCompileCaches = 4;
+
+}  // anonymous namespace
+
 // static
 Ref<PipelineCache> PipelineCache::Create(DeviceBase* device, const CacheKey& key) {
-    Ref<PipelineCache> cache =
-        AcquireRef(new PipelineCache(device, key, /*isMonolithicCache=*/false));
+    Ref<PipelineCache> cache = AcquireRef(
+        new PipelineCache(device, key, /*isMonolithicCache=*/false, /*mergeCompileCaches=*/false));
     cache->Initialize();
     return cache;
 }
 
 // static
-Ref<PipelineCache> PipelineCache::CreateMonolithic(DeviceBase* device, const CacheKey& key) {
+Ref<PipelineCache> PipelineCache::CreateMonolithic(DeviceBase* device,
+                                                   const CacheKey& key,
+                                                   bool mergeCompileCaches) {
     Ref<PipelineCache> cache =
-        AcquireRef(new PipelineCache(device, key, /*isMonolithicCache=*/true));
+        AcquireRef(new PipelineCache(device, key, /*isMonolithicCache=*/true, mergeCompileCaches));
     cache->Initialize();
     return cache;
 }
 
-PipelineCache::PipelineCache(DeviceBase* device, const CacheKey& key, bool isMonolithicCache)
-    : PipelineCacheBase(device->GetBlobCache(), key, isMonolithicCache), mDevice(device) {}
+PipelineCache::PipelineCache(DeviceBase* device,
+                             const CacheKey& key,
+                             bool isMonolithicCache,
+                             bool mergeCompileCaches)
+    : PipelineCacheBase(device->GetBlobCache(), key, isMonolithicCache),
+      mDevice(device),
+      mMergeCompileCaches(mergeCompileCaches) {}
 
 PipelineCache::~PipelineCache() {
+    Device* device = ToBackend(GetDevice());
+    auto DestroyCompileCaches = [&](auto compileCaches) {
+        for (VkPipelineCache compileCache : *compileCaches) {
+            device->fn.DestroyPipelineCache(device->GetVkDevice(), compileCache, nullptr);
+        }
+    };
+    mCompileCachesToMerge.Use(DestroyCompileCaches);
+    mFreeCompileCaches.Use(DestroyCompileCaches);
+
     if (mHandle == VK_NULL_HANDLE) {
         return;
     }
-    Device* device = ToBackend(GetDevice());
     device->fn.DestroyPipelineCache(device->GetVkDevice(), mHandle, nullptr);
     mHandle = VK_NULL_HANDLE;
 }
@@ -70,8 +101,194 @@ DeviceBase* PipelineCache::GetDevice() const {
     return mDevice;
 }
 
-VkPipelineCache PipelineCache::GetHandle() const {
-    return mHandle;
+VkPipelineCache PipelineCache::AcquireCompileCache() {
+    if (!mMergeCompileCaches || mHandle == VK_NULL_HANDLE) {
+        return mHandle;
+    }
+
+    VkPipelineCache compileCache =
+        mFreeCompileCaches.Use([](auto freeCompileCaches) -> VkPipelineCache {
+            if (freeCompileCaches->empty()) {
+                return VK_NULL_HANDLE;
+            }
+            VkPipelineCache freeCompileCache = freeCompileCaches->back();
+            freeCompileCaches->pop_back();
+            return freeCompileCache;
+        });
+    if (compileCache != VK_NULL_HANDLE) {
+        return compileCache;
+    }
+
+    // Like in Initialize(), compile without a cache if the compile cache can't be created. The
+    // monolithic cache can't be used instead since compile caches are merged into it concurrently.
+    auto CreateFromMonolithicData = [&]() -> ResultOrError<VkPipelineCache> {
+        std::vector<uint8_t> data;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            DAWN_TRY_ASSIGN(data, GetDataLocked());
+        }
+        return CreateCompileCache(data);
+    };
+    ResultOrError<VkPipelineCache> maybeCompileCache = CreateFromMonolithicData();
+    if (maybeCompileCache.IsError()) {
+        std::unique_ptr<ErrorData> error = maybeCompileCache.AcquireError();
+        GetDevice()->EmitLog(WGPULoggingType_Info, error->GetFormattedMessage().c_str());
+        return VK_NULL_HANDLE;
+    }
+    return maybeCompileCache.AcquireSuccess();
+}
+
+void PipelineCache::ReleaseCompileCache(VkPipelineCache compileCache) {
+    if (!mMergeCompileCaches || compileCache == VK_NULL_HANDLE) {
+        return;
+    }
+
+    // Only post a task for the first compile cache to merge, the others are merged with it.
+    bool isFirstCompileCacheToMerge = mCompileCachesToMerge.Use([&](auto compileCachesToMerge) {
+        compileCachesToMerge->push_back(compileCache);
+        return compileCachesToMerge->size() == 1;
+    });
+    if (!isFirstCompileCacheToMerge) {
+        return;
+    }
+
+    // Merging isn't latency-sensitive so it runs after pending pipeline compilations. If the task
+    // is cancelled because the device is destroyed, the compile caches are destroyed with this
+    // cache. The task releases its reference before it completes: once it is no longer pending,
+    // destroying the device doesn't wait for it, and this cache must not be destroyed after the
+    // VkDevice.
+    // The task never waits on another task: it only takes mMutex and the locks of the merge lists,
+    // PipelineCacheBase::Flush() and BlobCache, none of which is held while waiting on a task. So
+    // it can't block a worker of the bounded pool. Shutdown cancels it while it is queued instead
+    // of waiting on it, and a worker waiting on it would run it inline.
+    GetDevice()->GetAsyncTaskManager()->PostTask(
+        [self = Ref<PipelineCache>(this)]() mutable {
+            self->MergeCompileCachesOnWorker();
+            self = nullptr;
+        },
+        {}, dawn::platform::WorkerTaskPriority::Low);
+}
+
+MaybeError PipelineCache::MergeCompileCaches() {
+    // Hold the lock while merging so that this waits for the worker thread to finish merging the
+    // compile caches it took.
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    std::vector<VkPipelineCache> compileCaches;
+    mCompileCachesToMerge->swap(compileCaches);
+    if (compileCaches.empty()) {
+        return {};
+    }
+
+    Device* device = ToBackend(GetDevice());
+    MaybeError maybeError = CheckVkSuccess(
+        device->fn.MergePipelineCaches(device->GetVkDevice(), mHandle,
+                                       static_cast<uint32_t>(compileCaches.size()),
+                                       AsVkArray(compileCaches.data())),
+        "vkMergePipelineCaches");
+
+    // The compile caches are not reused: they hold the data of the monolithic cache from when
+    // they were created, which would be merged again each time, and would miss the data merged
+    // since. The next compilations use compile caches created from the merged data instead.
+    for (VkPipelineCache compileCache : compileCaches) {
+        device->fn.DestroyPipelineCache(device->GetVkDevice(), compileCache, nullptr);
+    }
+    MarkNeedsStore();
+
+    return maybeError;
+}
+
+void PipelineCache::MergeCompileCachesOnWorker() {
+    MaybeError maybeError = MergeCompileCaches();
+
+    // Store the monolithic cache in batches, once enough data was merged into it.
+    if (!maybeError.IsError()) {
+        size_t dataSize = 0;
+        Device* device = ToBackend(GetDevice());
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            maybeError = CheckVkSuccess(
+                device->fn.GetPipelineCacheData(device->GetVkDevice(), mHandle, &dataSize, nullptr),
+                "GetPipelineCacheData");
+            if (dataSize < mStoredDataSize + kMinMergedDataSizeToStore) {
+                dataSize = 0;
+            }
+        }
+        if (!maybeError.IsError() && dataSize > 0) {
+            maybeError = Flush();
+        }
+    }
+
+    // Prepare the compile caches of the next compilations here rather than when they start.
+    if (!maybeError.IsError()) {
+        maybeError = RecreateFreeCompileCaches();
+    }
+
+    if (maybeError.IsError()) {
+        std::unique_ptr<ErrorData> error = maybeError.AcquireError();
+        GetDevice()->EmitLog(WGPULoggingType_Error, error->GetFormattedMessage().c_str());
+    }
+}
+
+ResultOrError<std::vector<uint8_t>> PipelineCache::GetDataLocked() {
+    Device* device = ToBackend(GetDevice());
+
+    size_t dataSize = 0;
+    DAWN_TRY(CheckVkSuccess(
+        device->fn.GetPipelineCacheData(device->GetVkDevice(), mHandle, &dataSize, nullptr),
+        "GetPipelineCacheData"));
+    std::vector<uint8_t> data(dataSize);
+    DAWN_TRY(CheckVkSuccess(
+        device->fn.GetPipelineCacheData(device->GetVkDevice(), mHandle, &dataSize, data.data()),
+        "GetPipelineCacheData"));
+    data.resize(dataSize);
+    return data;
+}
+
+ResultOrError<VkPipelineCache> PipelineCache::CreateCompileCache(const std::vector<uint8_t>& data) {
+    Device* device = ToBackend(GetDevice());
+
+    // Start from the data of the monolithic cache so that compilations can hit it.
+    VkPipelineCacheCreateInfo createInfo;
+    createInfo.flags = 0;
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.initialDataSize = data.size();
+    createInfo.pInitialData = data.data();
+
+    VkPipelineCache compileCache = VK_NULL_HANDLE;
+    DAWN_TRY(CheckVkSuccess(device->fn.CreatePipelineCache(device->GetVkDevice(), &createInfo,
+                                                           nullptr, &*compileCache),
+                            "CreatePipelineCache"));
+    return compileCache;
+}
+
+MaybeError PipelineCache::RecreateFreeCompileCaches() {
+    std::vector<uint8_t> data;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        DAWN_TRY_ASSIGN(data, GetDataLocked());
+    }
+
+    MaybeError maybeError;
+    std::vector<VkPipelineCache> compileCaches;
+    for (size_t i = 0; i < kMaxFreeCompileCaches; ++i) {
+        ResultOrError<VkPipelineCache> maybeCompileCache = CreateCompileCache(data);
+        if (maybeCompileCache.IsError()) {
+            maybeError = maybeCompileCache.AcquireError();
+            break;
+        }
+        compileCaches.push_back(maybeCompileCache.AcquireSuccess());
+    }
+
+    // The free compile caches that weren't acquired yet miss the data merged since they were
+    // created, replace them.
+    mFreeCompileCaches->swap(compileCaches);
+    Device* device = ToBackend(GetDevice());
+    for (VkPipelineCache compileCache : compileCaches) {
+        device->fn.DestroyPipelineCache(device->GetVkDevice(), compileCache, nullptr);
+    }
+    return maybeError;
 }
 
 MaybeError PipelineCache::SerializeToBlobImpl(Blob* blob) {
@@ -80,6 +297,8 @@ MaybeError PipelineCache::SerializeToBlobImpl(Blob* blob) {
         return {};
     }
 
+    std::lock_guard<std::mutex> lock(mMutex);
+
     size_t bufferSize;
     Device* device = ToBackend(GetDevice());
     DAWN_TRY(CheckVkSuccess(
@@ -28,6 +28,10 @@
 #ifndef SRC_DAWN_NATIVE_VULKAN_PIPELINECACHEVK_H_
 #define SRC_DAWN_NATIVE_VULKAN_PIPELINECACHEVK_H_
 
+#include <mutex>
+#include <vector>
+
+#include "dawn/common/MutexProtected.h"
 #include "dawn/native/ObjectBase.h"
 #include "dawn/native/PipelineCache.h"
 #include "partition_alloc/pointers/raw_ptr.h"
@@ -45,23 +49,57 @@ class PipelineCache final : public PipelineCacheBase {
     static Ref<PipelineCache> Create(DeviceBase* device, const CacheKey& key);
 
     // Creates a pipeline cache that is intended to be monolithic. The cache will only be serialized
-    // and stored to BlobCache when StoreOnIdle() is called.
-    static Ref<PipelineCache> CreateMonolithic(DeviceBase* device, const CacheKey& key);
+    // and stored to BlobCache when StoreOnIdle() is called, or when enough data was merged into it
+    // if `mergeCompileCaches` is true, see AcquireCompileCache().
+    static Ref<PipelineCache> CreateMonolithic(DeviceBase* device,
+                                               const CacheKey& key,
+                                               bool mergeCompileCaches);
 
     DeviceBase* GetDevice() const;
-    VkPipelineCache GetHandle() const;
+
+    // Returns the VkPipelineCache to compile a pipeline with, which must be given back with
+    // ReleaseCompileCache() once the compilation is done. When compile caches are merged, each
+    // compilation gets its own VkPipelineCache, created from the data of the monolithic one, so
+    // that concurrent compilations don't contend on the monolithic one. Released compile caches
+    // are merged into the monolithic cache and destroyed on a worker thread, which also stores
+    // the monolithic cache to BlobCache once enough data was merged, and recreates a few compile
+    // caches from its new data for the next compilations.
+    VkPipelineCache AcquireCompileCache();
+    void ReleaseCompileCache(VkPipelineCache compileCache);
+
+    // Merges the compile caches that weren't merged yet by the worker thread, or waits for the
+    // worker thread to be done merging them.
+    MaybeError MergeCompileCaches();
 
   private:
-    explicit PipelineCache(DeviceBase* device, const CacheKey& key, bool isMonolithicCache);
+    explicit PipelineCache(DeviceBase* device,
+                           const CacheKey& key,
+                           bool isMonolithicCache,
+                           bool mergeCompileCaches);
     ~PipelineCache() override;
 
     void Initialize();
     MaybeError SerializeToBlobImpl(Blob* blob) override;
 
+    // Returns the data of the monolithic cache. mMutex must be held.
+    ResultOrError<std::vector<uint8_t>> GetDataLocked();
+    ResultOrError<VkPipelineCache> CreateCompileCache(const std::vector<uint8_t>& data);
+    MaybeError RecreateFreeCompileCaches();
+    void MergeCompileCachesOnWorker();
+
     raw_ptr<DeviceBase> mDevice;
-    VkPipelineCache mHandle = VK_NULL_HANDLE;
+    const bool mMergeCompileCaches;
 
+    // Protects the monolithic VkPipelineCache when compile caches are merged into it, and the
+    // size of its data stored in BlobCache.
+    std::mutex mMutex;
+    VkPipelineCache mHandle = VK_NULL_HANDLE;
     size_t mStoredDataSize = 0;
+
+    // The compile caches that aren't used by any compilation yet, and the ones that are waiting
+    // to be merged into mHandle. A compile cache is merged once, then destroyed.
+    MutexProtected<std::vector<VkPipelineCache>> mFreeCompileCaches;
+    MutexProtected<std::vector<VkPipelineCache>> mCompileCachesToMerge;
 };
 
 }  // namespace dawn::native::vulkan
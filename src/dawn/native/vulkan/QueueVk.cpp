@@ -433,12 +433,18 @@ MaybeError Queue::SubmitPendingCommands() {
     }
     DAWN_ASSERT(externalTextureSemaphoreIter == externalTextureSemaphores.end());
 
+    DAWN_ASSERT(mRecordingContext.pendingBarriers.IsEmpty());
+    mLastSubmitBarrierStats = mRecordingContext.barrierStats;
     mRecordingContext = CommandRecordingContext();
     DAWN_TRY(PrepareRecordingContext());
 
     return {};
 }
 
+const BarrierStats& Queue::GetLastSubmitBarrierStats() const {
+    return mLastSubmitBarrierStats;
+}
+
 ResultOrError<VkFence> Queue::GetUnusedFence() {
     Device* device = ToBackend(GetDevice());
     VkDevice vkDevice = device->GetVkDevice();
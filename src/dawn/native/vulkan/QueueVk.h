@@ -58,6 +58,9 @@ class Queue final : public QueueBase {
 
     ResultOrError<bool> WaitForQueueSerial(ExecutionSerial serial, Nanoseconds timeout) override;
 
+    // The number of barriers recorded in the command buffers of the last submit.
+    const BarrierStats& GetLastSubmitBarrierStats() const;
+
   private:
     Queue(Device* device, const QueueDescriptor* descriptor, uint32_t family);
     ~Queue() override;
@@ -93,6 +96,7 @@ class Queue final : public QueueBase {
     std::vector<CommandPoolAndBuffer> mUnusedCommands;
     // There is always a valid recording context stored in mRecordingContext
     CommandRecordingContext mRecordingContext;
+    BarrierStats mLastSubmitBarrierStats;
 
     uint32_t mQueueFamily = 0;
     VkQueue mQueue = VK_NULL_HANDLE;
@@ -0,0 +1,169 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "dawn/native/vulkan/RenderBundleVk.h"
+
+#include <utility>
+
+#include "dawn/native/Commands.h"
+#include "dawn/native/vulkan/DeviceVk.h"
+#include "dawn/native/vulkan/FencedDeleter.h"
+#include "dawn/native/vulkan/VulkanError.h"
+
+namespace dawn::native::vulkan {
+
+namespace {
+
+// Render bundles are usually executed in render passes of a single size, so only keep a few
+// secondary command buffers per bundle and replay the bundle in other render passes.
+constexpr size_t kMaxSecondaryCommandBuffersPerBundle = 4;
+
+}  // anonymous namespace
+
+// static
+Ref<RenderBundle> RenderBundle::Create(RenderBundleEncoder* encoder,
+                                       const RenderBundleDescriptor* descriptor,
+                                       Ref<AttachmentState> attachmentState,
+                                       bool depthReadOnly,
+                                       bool stencilReadOnly,
+                                       RenderPassResourceUsage resourceUsage,
+                                       IndirectDrawMetadata indirectDrawMetadata) {
+    Ref<RenderBundle> bundle = AcquireRef(new RenderBundle(
+        encoder, descriptor, std::move(attachmentState), depthReadOnly, stencilReadOnly,
+        std::move(resourceUsage), std::move(indirectDrawMetadata)));
+    bundle->Initialize();
+    return bundle;
+}
+
+bool RenderBundle::SecondaryCommandBufferKey::operator==(
+    const SecondaryCommandBufferKey& other) const {
+    return renderPass == other.renderPass && width == other.width && height == other.height;
+}
+
+void RenderBundle::Initialize() {
+    CommandIterator* commands = GetCommands();
+    Command type;
+    while (commands->NextCommandId(&type)) {
+        switch (type) {
+            case Command::DrawIndirect:
+            case Command::DrawIndexedIndirect:
+            case Command::MultiDrawIndirect:
+            case Command::MultiDrawIndexedIndirect:
+                mCanUseSecondaryCommandBuffers = false;
+                break;
+            default:
+                break;
+        }
+        SkipCommand(commands, type);
+    }
+    commands->Reset();
+}
+
+ResultOrError<VkCommandBuffer> RenderBundle::GetOrCreateSecondaryCommandBuffer(
+    const SecondaryCommandBufferKey& key,
+    const RecordCommandsFn& recordCommands) {
+    if (!mCanUseSecondaryCommandBuffers) {
+        return VkCommandBuffer(VK_NULL_HANDLE);
+    }
+
+    for (const auto& [cachedKey, commandBuffer] : mSecondaryCommandBuffers) {
+        if (cachedKey == key) {
+            return commandBuffer;
+        }
+    }
+
+    if (mSecondaryCommandBuffers.size() >= kMaxSecondaryCommandBuffersPerBundle) {
+        return VkCommandBuffer(VK_NULL_HANDLE);
+    }
+
+    Device* device = ToBackend(GetDevice());
+    VkDevice vkDevice = device->GetVkDevice();
+
+    if (mCommandPool == VK_NULL_HANDLE) {
+        VkCommandPoolCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.queueFamilyIndex = device->GetGraphicsQueueFamily();
+
+        DAWN_TRY(CheckVkSuccess(
+            device->fn.CreateCommandPool(vkDevice, &createInfo, nullptr, &*mCommandPool),
+            "vkCreateCommandPool"));
+    }
+
+    // The command buffer is freed with the command pool when the bundle is destroyed.
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    VkCommandBufferAllocateInfo allocateInfo;
+    allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocateInfo.pNext = nullptr;
+    allocateInfo.commandPool = mCommandPool;
+    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+    allocateInfo.commandBufferCount = 1;
+
+    DAWN_TRY(CheckVkSuccess(device->fn.AllocateCommandBuffers(vkDevice, &allocateInfo,
+                                                              &commandBuffer),
+                            "vkAllocateCommandBuffers"));
+
+    VkCommandBufferInheritanceInfo inheritanceInfo;
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.pNext = nullptr;
+    inheritanceInfo.renderPass = key.renderPass;
+    inheritanceInfo.subpass = 0;
+    inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+    inheritanceInfo.occlusionQueryEnable = VK_FALSE;
+    inheritanceInfo.queryFlags = 0;
+    inheritanceInfo.pipelineStatistics = 0;
+
+    // The same secondary command buffer can be pending in the command buffers of several
+    // submits, so it needs SIMULTANEOUS_USE.
+    VkCommandBufferBeginInfo beginInfo;
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.pNext = nullptr;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
+                      VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    DAWN_TRY(CheckVkSuccess(device->fn.BeginCommandBuffer(commandBuffer, &beginInfo),
+                            "vkBeginCommandBuffer"));
+    recordCommands(commandBuffer);
+    DAWN_TRY(CheckVkSuccess(device->fn.EndCommandBuffer(commandBuffer), "vkEndCommandBuffer"));
+
+    mSecondaryCommandBuffers.emplace_back(key, commandBuffer);
+    return commandBuffer;
+}
+
+void RenderBundle::DestroyImpl() {
+    RenderBundleBase::DestroyImpl();
+
+    // The secondary command buffers may still be used by commands in flight.
+    if (mCommandPool != VK_NULL_HANDLE) {
+        ToBackend(GetDevice())->GetFencedDeleter()->DeleteWhenUnused(mCommandPool);
+        mCommandPool = VK_NULL_HANDLE;
+    }
+    mSecondaryCommandBuffers.clear();
+}
+
+}  // namespace dawn::native::vulkan
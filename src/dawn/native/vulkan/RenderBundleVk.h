@@ -0,0 +1,87 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#ifndef SRC_DAWN_NATIVE_VULKAN_RENDERBUNDLEVK_H_
+#define SRC_DAWN_NATIVE_VULKAN_RENDERBUNDLEVK_H_
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/vulkan_platform.h"
+#include "dawn/native/RenderBundle.h"
+
+namespace dawn::native::vulkan {
+
+class Device;
+
+// A render bundle that records its commands once in secondary command buffers, which are then
+// reused every time the bundle is executed in a compatible render pass.
+class RenderBundle final : public RenderBundleBase {
+  public:
+    static Ref<RenderBundle> Create(RenderBundleEncoder* encoder,
+                                    const RenderBundleDescriptor* descriptor,
+                                    Ref<AttachmentState> attachmentState,
+                                    bool depthReadOnly,
+                                    bool stencilReadOnly,
+                                    RenderPassResourceUsage resourceUsage,
+                                    IndirectDrawMetadata indirectDrawMetadata);
+
+    // The render passes that can execute a secondary command buffer.
+    struct SecondaryCommandBufferKey {
+        bool operator==(const SecondaryCommandBufferKey& other) const;
+
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+    using RecordCommandsFn = std::function<void(VkCommandBuffer secondaryCommandBuffer)>;
+
+    // Returns the secondary command buffer for render passes matching `key`, allocating it and
+    // calling `recordCommands` to record the commands of the bundle in it the first time. Returns
+    // VK_NULL_HANDLE if the bundle must be replayed in the render pass instead.
+    ResultOrError<VkCommandBuffer> GetOrCreateSecondaryCommandBuffer(
+        const SecondaryCommandBufferKey& key,
+        const RecordCommandsFn& recordCommands);
+
+  private:
+    using RenderBundleBase::RenderBundleBase;
+
+    void Initialize();
+
+    void DestroyImpl() override;
+
+    // Indirect draws can't be recorded in secondary command buffers because the indirect draw
+    // validation replaces their indirect buffer for each command buffer.
+    bool mCanUseSecondaryCommandBuffers = true;
+
+    VkCommandPool mCommandPool = VK_NULL_HANDLE;
+    std::vector<std::pair<SecondaryCommandBufferKey, VkCommandBuffer>> mSecondaryCommandBuffers;
+};
+
+}  // namespace dawn::native::vulkan
+
+#endif  // SRC_DAWN_NATIVE_VULKAN_RENDERBUNDLEVK_H_
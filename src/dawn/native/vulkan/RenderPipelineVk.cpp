@@ -599,18 +599,19 @@ MaybeError RenderPipeline::InitializeImpl() {
     // Try to see if we have anything in the blob cache.
     platform::metrics::DawnHistogramTimer cacheTimer(GetDevice()->GetPlatform());
     Ref<PipelineCache> cache = ToBackend(GetDevice()->GetOrCreatePipelineCache(GetCacheKey()));
+    if (!cache->CacheHit()) {
+        cacheTimer.Reset();
+    }
+    VkPipelineCache compileCache = cache->AcquireCompileCache();
+    MaybeError maybeError =
+        CheckVkSuccess(device->fn.CreateGraphicsPipelines(device->GetVkDevice(), compileCache, 1,
+                                                          &createInfo, nullptr, &*mHandle),
+                       "CreateGraphicsPipelines");
+    cache->ReleaseCompileCache(compileCache);
+    DAWN_TRY(std::move(maybeError));
     if (cache->CacheHit()) {
-        DAWN_TRY(CheckVkSuccess(
-            device->fn.CreateGraphicsPipelines(device->GetVkDevice(), cache->GetHandle(), 1,
-                                               &createInfo, nullptr, &*mHandle),
-            "CreateGraphicsPipelines"));
         cacheTimer.RecordMicroseconds("Vulkan.CreateGraphicsPipelines.CacheHit");
     } else {
-        cacheTimer.Reset();
-        DAWN_TRY(CheckVkSuccess(
-            device->fn.CreateGraphicsPipelines(device->GetVkDevice(), cache->GetHandle(), 1,
-                                               &createInfo, nullptr, &*mHandle),
-            "CreateGraphicsPipelines"));
         cacheTimer.RecordMicroseconds("Vulkan.CreateGraphicsPipelines.CacheMiss");
     }
 
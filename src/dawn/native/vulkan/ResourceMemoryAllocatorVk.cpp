@@ -30,13 +30,16 @@
 #include <algorithm>
 #include <utility>
 
+#include "absl/container/flat_hash_map.h"
 #include "dawn/common/Math.h"
 #include "dawn/native/BuddyMemoryAllocator.h"
 #include "dawn/native/Queue.h"
 #include "dawn/native/ResourceHeapAllocator.h"
 #include "dawn/native/vulkan/DeviceVk.h"
 #include "dawn/native/vulkan/FencedDeleter.h"
+#include "dawn/native/vulkan/PhysicalDeviceVk.h"
 #include "dawn/native/vulkan/ResourceHeapVk.h"
+#include "dawn/native/vulkan/UtilsVulkan.h"
 #include "dawn/native/vulkan/VulkanError.h"
 #include "partition_alloc/pointers/raw_ptr.h"
 
@@ -53,6 +56,14 @@ constexpr uint64_t kMaxSizeForSubAllocation = 4ull * 1024ull * 1024ull;  // 4MiB
 // size
 constexpr uint64_t kBuddyHeapsSize = 2 * kMaxSizeForSubAllocation;
 
+// A heap is sparse when at most 1/kSparseHeapUsedSizeDivisor of its size is sub-allocated.
+constexpr uint64_t kSparseHeapUsedSizeDivisor = 4;
+
+// The maximum number of free blocks of the sparse heaps reserved while moving resources out of
+// them. This bounds the work done by each defragmentation when the heaps have many small free
+// blocks.
+constexpr size_t kMaxReservedBlocks = 1024;
+
 bool IsMemoryKindMappable(MemoryKind memoryKind) {
     switch (memoryKind) {
         case MemoryKind::LinearReadMappable:
@@ -76,9 +87,15 @@ bool IsMemoryKindMappable(MemoryKind memoryKind) {
 
 class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocator {
   public:
-    SingleTypeAllocator(Device* device, size_t memoryTypeIndex, VkDeviceSize memoryHeapSize)
+    SingleTypeAllocator(Device* device,
+                        ResourceMemoryAllocator* owner,
+                        size_t memoryTypeIndex,
+                        uint32_t memoryHeapIndex,
+                        VkDeviceSize memoryHeapSize)
         : mDevice(device),
+          mOwner(owner),
           mMemoryTypeIndex(memoryTypeIndex),
+          mMemoryHeapIndex(memoryHeapIndex),
           mMemoryHeapSize(memoryHeapSize),
           mPooledMemoryAllocator(this),
           mBuddySystem(
@@ -92,16 +109,68 @@ class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocato
     }
     ~SingleTypeAllocator() override = default;
 
-    void DestroyPool() { mPooledMemoryAllocator.DestroyPool(); }
+    void DestroyPool() {
+        mPooledMemoryAllocator.DestroyPool();
+        mUnusedPoolIdleTaskCount = 0;
+    }
+
+    // Called by DestroyUnusedPools. Returns true if the pool isn't empty and none of its heaps
+    // was reused during the last kMaxUnusedPoolIdleTaskCount calls.
+    bool IsPoolUnusedOnIdle() {
+        if (GetPooledHeapCount() == 0) {
+            mUnusedPoolIdleTaskCount = 0;
+            return false;
+        }
+        return ++mUnusedPoolIdleTaskCount >= kMaxUnusedPoolIdleTaskCount;
+    }
 
     ResultOrError<ResourceMemoryAllocation> AllocateMemory(uint64_t size, uint64_t alignment) {
-        return mBuddySystem.Allocate(size, alignment);
+        const uint64_t pooledHeapCount = GetPooledHeapCount();
+        ResourceMemoryAllocation allocation;
+        DAWN_TRY_ASSIGN(allocation, mBuddySystem.Allocate(size, alignment));
+        if (GetPooledHeapCount() < pooledHeapCount) {
+            mUnusedPoolIdleTaskCount = 0;
+        }
+        return std::move(allocation);
     }
 
     void DeallocateMemory(const ResourceMemoryAllocation& allocation) {
         mBuddySystem.Deallocate(allocation);
     }
 
+    uint32_t GetMemoryHeapIndex() const { return mMemoryHeapIndex; }
+
+    bool IsInSparseHeap(const ResourceMemoryAllocation& allocation) const {
+        return mBuddySystem.GetHeapUsedSize(allocation) <= GetSparseHeapMaxUsedSize();
+    }
+
+    uint64_t GetHeapUsedSize(const ResourceMemoryAllocation& allocation) const {
+        return mBuddySystem.GetHeapUsedSize(allocation);
+    }
+
+    uint64_t GetHeapSubAllocationCount(const ResourceMemoryAllocation& allocation) const {
+        return mBuddySystem.GetHeapSubAllocationCount(allocation);
+    }
+
+    uint64_t GetHeapSize() const { return mBuddySystem.GetMemoryBlockSize(); }
+
+    void AddSparseHeaps(absl::flat_hash_set<const ResourceHeapBase*>* heaps) const {
+        for (const ResourceHeapBase* heap :
+             mBuddySystem.GetSparseHeaps(GetSparseHeapMaxUsedSize())) {
+            heaps->insert(heap);
+        }
+    }
+
+    uint64_t GetPooledHeapCount() const { return mPooledMemoryAllocator.GetPoolSize(); }
+
+    void AddStats(ResourceMemoryStats* stats) const {
+        stats->heapCount += mBuddySystem.GetHeapCount();
+        stats->heapSize += mBuddySystem.GetHeapCount() * mBuddySystem.GetMemoryBlockSize();
+        stats->usedSize += mBuddySystem.GetUsedSize();
+        stats->sparseHeapCount += mBuddySystem.ComputeSparseHeapCount(GetSparseHeapMaxUsedSize());
+        stats->pooledHeapCount += GetPooledHeapCount();
+    }
+
     // Implementation of the MemoryAllocator interface to be a client of BuddyMemoryAllocator
 
     ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(uint64_t size) override {
@@ -109,6 +178,14 @@ class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocato
             return DAWN_OUT_OF_MEMORY_ERROR("Allocation size too large");
         }
 
+        // Give the unused heaps kept for reuse back to the driver before going over the budget.
+        if (mOwner->IsOverBudget(mMemoryHeapIndex, size)) {
+            mOwner->DestroyPool(mMemoryHeapIndex);
+            if (mOwner->IsOverBudget(mMemoryHeapIndex, size)) {
+                mOwner->mOverBudgetAllocationCount++;
+            }
+        }
+
         VkMemoryAllocateInfo allocateInfo;
         allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
         allocateInfo.pNext = nullptr;
@@ -124,19 +201,30 @@ class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocato
                                   "vkAllocateMemory"));
 
         DAWN_ASSERT(allocatedMemory != VK_NULL_HANDLE);
-        return {std::make_unique<ResourceHeap>(allocatedMemory, mMemoryTypeIndex)};
+        mOwner->mAllocatedSizePerMemoryHeap[mMemoryHeapIndex] += size;
+        return {std::make_unique<ResourceHeap>(allocatedMemory, mMemoryTypeIndex, size)};
     }
 
     void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {
-        mDevice->GetFencedDeleter()->DeleteWhenUnused(ToBackend(allocation.get())->GetMemory());
+        ResourceHeap* heap = ToBackend(allocation.get());
+        DAWN_ASSERT(mOwner->mAllocatedSizePerMemoryHeap[mMemoryHeapIndex] >= heap->GetSize());
+        mOwner->mAllocatedSizePerMemoryHeap[mMemoryHeapIndex] -= heap->GetSize();
+        mDevice->GetFencedDeleter()->DeleteWhenUnused(heap->GetMemory());
     }
 
   private:
+    uint64_t GetSparseHeapMaxUsedSize() const {
+        return mBuddySystem.GetMemoryBlockSize() / kSparseHeapUsedSizeDivisor;
+    }
+
     raw_ptr<Device> mDevice;
+    raw_ptr<ResourceMemoryAllocator> mOwner;
     size_t mMemoryTypeIndex;
+    uint32_t mMemoryHeapIndex;
     VkDeviceSize mMemoryHeapSize;
     PooledResourceMemoryAllocator mPooledMemoryAllocator;
     BuddyMemoryAllocator mBuddySystem;
+    uint32_t mUnusedPoolIdleTaskCount = 0;
 };
 
 // Implementation of ResourceMemoryAllocator
@@ -144,10 +232,12 @@ class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocato
 ResourceMemoryAllocator::ResourceMemoryAllocator(Device* device) : mDevice(device) {
     const VulkanDeviceInfo& info = mDevice->GetDeviceInfo();
     mAllocatorsPerType.reserve(info.memoryTypes.size());
+    mAllocatedSizePerMemoryHeap.resize(info.memoryHeaps.size(), 0);
 
     for (size_t i = 0; i < info.memoryTypes.size(); i++) {
+        const uint32_t heapIndex = info.memoryTypes[i].heapIndex;
         mAllocatorsPerType.emplace_back(std::make_unique<SingleTypeAllocator>(
-            mDevice, i, info.memoryHeaps[info.memoryTypes[i].heapIndex].size));
+            mDevice, this, i, heapIndex, info.memoryHeaps[heapIndex].size));
     }
 }
 
@@ -232,8 +322,8 @@ void ResourceMemoryAllocator::Deallocate(ResourceMemoryAllocation* allocation) {
         case AllocationMethod::kDirect: {
             ResourceHeap* heap = ToBackend(allocation->GetResourceHeap());
             allocation->Invalidate();
-            mDevice->GetFencedDeleter()->DeleteWhenUnused(heap->GetMemory());
-            delete heap;
+            mAllocatorsPerType[heap->GetMemoryType()]->DeallocateResourceHeap(
+                std::unique_ptr<ResourceHeapBase>(heap));
             break;
         }
 
@@ -353,8 +443,159 @@ int ResourceMemoryAllocator::FindBestTypeIndex(VkMemoryRequirements requirements
 
 void ResourceMemoryAllocator::DestroyPool() {
     for (auto& alloc : mAllocatorsPerType) {
+        mReleasedHeapCount += alloc->GetPooledHeapCount();
         alloc->DestroyPool();
     }
 }
 
+void ResourceMemoryAllocator::DestroyUnusedPools() {
+    std::vector<bool> hasPooledHeaps(mAllocatedSizePerMemoryHeap.size(), false);
+    for (const auto& alloc : mAllocatorsPerType) {
+        if (alloc->GetPooledHeapCount() > 0) {
+            hasPooledHeaps[alloc->GetMemoryHeapIndex()] = true;
+        }
+    }
+    for (uint32_t i = 0; i < hasPooledHeaps.size(); ++i) {
+        if (hasPooledHeaps[i] && IsOverBudget(i, 0)) {
+            DestroyPool(i);
+        }
+    }
+
+    for (auto& alloc : mAllocatorsPerType) {
+        if (alloc->IsPoolUnusedOnIdle()) {
+            mReleasedHeapCount += alloc->GetPooledHeapCount();
+            alloc->DestroyPool();
+        }
+    }
+}
+
+void ResourceMemoryAllocator::DestroyPool(uint32_t memoryHeapIndex) {
+    for (auto& alloc : mAllocatorsPerType) {
+        if (alloc->GetMemoryHeapIndex() == memoryHeapIndex) {
+            mReleasedHeapCount += alloc->GetPooledHeapCount();
+            alloc->DestroyPool();
+        }
+    }
+}
+
+bool ResourceMemoryAllocator::IsOverBudget(uint32_t memoryHeapIndex,
+                                           VkDeviceSize allocationSize) const {
+    const VulkanDeviceInfo& info = mDevice->GetDeviceInfo();
+
+    VkDeviceSize budget;
+    VkDeviceSize usage;
+    if (info.HasExt(DeviceExt::MemoryBudget)) {
+        // The budget and usage cover all the processes using the memory heap and change over
+        // time, so they are queried for each new VkDeviceMemory.
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties = {};
+        VkPhysicalDeviceMemoryProperties2 properties2 = {};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        properties2.pNext = nullptr;
+        PNextChainBuilder propertiesChain(&properties2);
+        propertiesChain.Add(&budgetProperties,
+                            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT);
+
+        mDevice->fn.GetPhysicalDeviceMemoryProperties2(
+            ToBackend(mDevice->GetPhysicalDevice())->GetVkPhysicalDevice(), &properties2);
+        budget = budgetProperties.heapBudget[memoryHeapIndex];
+        usage = budgetProperties.heapUsage[memoryHeapIndex];
+    } else {
+        // Without VK_EXT_memory_budget, assume that 80% of the memory heap can be used by this
+        // device, leaving some room for the other processes.
+        budget = info.memoryHeaps[memoryHeapIndex].size / 5 * 4;
+        usage = mAllocatedSizePerMemoryHeap[memoryHeapIndex];
+    }
+
+    return allocationSize > budget || usage > budget - allocationSize;
+}
+
+absl::flat_hash_set<const ResourceHeapBase*> ResourceMemoryAllocator::SelectHeapsToRelease(
+    const std::vector<ResourceMemoryAllocation>& movableAllocations) const {
+    // Count the movable sub-allocations of each sparse heap.
+    struct MovableHeap {
+        raw_ptr<const ResourceMemoryAllocation> allocation;
+        uint64_t movableCount = 0;
+    };
+    absl::flat_hash_map<const ResourceHeapBase*, MovableHeap> movableHeaps;
+    for (const ResourceMemoryAllocation& allocation : movableAllocations) {
+        DAWN_ASSERT(allocation.GetInfo().mMethod == AllocationMethod::kSubAllocated);
+        size_t memoryType = ToBackend(allocation.GetResourceHeap())->GetMemoryType();
+        if (mAllocatorsPerType[memoryType]->IsInSparseHeap(allocation)) {
+            MovableHeap& movableHeap = movableHeaps[allocation.GetResourceHeap()];
+            movableHeap.allocation = &allocation;
+            movableHeap.movableCount++;
+        }
+    }
+
+    // Keep the sparse heaps that only contain movable sub-allocations, and sum their used size
+    // per memory type.
+    std::vector<std::vector<const ResourceHeapBase*>> heapsPerType(mAllocatorsPerType.size());
+    std::vector<uint64_t> usedSizePerType(mAllocatorsPerType.size(), 0);
+    for (const auto& [heap, movableHeap] : movableHeaps) {
+        size_t memoryType = ToBackend(heap)->GetMemoryType();
+        const SingleTypeAllocator* allocator = mAllocatorsPerType[memoryType].get();
+        if (allocator->GetHeapSubAllocationCount(*movableHeap.allocation) ==
+            movableHeap.movableCount) {
+            heapsPerType[memoryType].push_back(heap);
+            usedSizePerType[memoryType] += allocator->GetHeapUsedSize(*movableHeap.allocation);
+        }
+    }
+
+    absl::flat_hash_set<const ResourceHeapBase*> heapsToRelease;
+    for (size_t memoryType = 0; memoryType < mAllocatorsPerType.size(); ++memoryType) {
+        const uint64_t heapSize = mAllocatorsPerType[memoryType]->GetHeapSize();
+        const uint64_t minHeapCount = (usedSizePerType[memoryType] + heapSize - 1) / heapSize;
+        if (minHeapCount < heapsPerType[memoryType].size()) {
+            heapsToRelease.insert(heapsPerType[memoryType].begin(),
+                                  heapsPerType[memoryType].end());
+        }
+    }
+    return heapsToRelease;
+}
+
+absl::flat_hash_set<const ResourceHeapBase*> ResourceMemoryAllocator::GetSparseHeaps() const {
+    absl::flat_hash_set<const ResourceHeapBase*> heaps;
+    for (const auto& alloc : mAllocatorsPerType) {
+        alloc->AddSparseHeaps(&heaps);
+    }
+    return heaps;
+}
+
+ResultOrError<ResourceMemoryAllocation> ResourceMemoryAllocator::AllocateOutsideOfHeaps(
+    const VkMemoryRequirements& requirements,
+    MemoryKind kind,
+    const absl::flat_hash_set<const ResourceHeapBase*>& excludedHeaps) {
+    while (mReservedBlocks.size() < kMaxReservedBlocks) {
+        ResourceMemoryAllocation allocation;
+        DAWN_TRY_ASSIGN(allocation, Allocate(requirements, kind));
+        if (!excludedHeaps.contains(allocation.GetResourceHeap())) {
+            mMovedAllocationCount++;
+            return std::move(allocation);
+        }
+        mReservedBlocks.push_back(std::move(allocation));
+    }
+    return ResourceMemoryAllocation{};
+}
+
+void ResourceMemoryAllocator::ReleaseReservedBlocks() {
+    // The reserved blocks were never used by the GPU, so they can be deallocated immediately.
+    for (const ResourceMemoryAllocation& allocation : mReservedBlocks) {
+        DAWN_ASSERT(allocation.GetInfo().mMethod == AllocationMethod::kSubAllocated);
+        size_t memoryType = ToBackend(allocation.GetResourceHeap())->GetMemoryType();
+        mAllocatorsPerType[memoryType]->DeallocateMemory(allocation);
+    }
+    mReservedBlocks.clear();
+}
+
+ResourceMemoryStats ResourceMemoryAllocator::GetStats() const {
+    ResourceMemoryStats stats;
+    for (const auto& alloc : mAllocatorsPerType) {
+        alloc->AddStats(&stats);
+    }
+    stats.movedAllocationCount = mMovedAllocationCount;
+    stats.releasedHeapCount = mReleasedHeapCount;
+    stats.overBudgetAllocationCount = mOverBudgetAllocationCount;
+    return stats;
+}
+
 }  // namespace dawn::native::vulkan
@@ -31,8 +31,10 @@
 #include <memory>
 #include <vector>
 
+#include "absl/container/flat_hash_set.h"
 #include "dawn/common/SerialQueue.h"
 #include "dawn/common/vulkan_platform.h"
+#include "dawn/native/DawnNative.h"
 #include "dawn/native/Error.h"
 #include "dawn/native/IntegerTypes.h"
 #include "dawn/native/PooledResourceMemoryAllocator.h"
@@ -63,19 +65,69 @@ class ResourceMemoryAllocator {
                                                      bool forceDisableSubAllocation = false);
     void Deallocate(ResourceMemoryAllocation* allocation);
 
+    // Releases the free heaps kept for reuse.
     void DestroyPool();
 
+    // The free heaps kept for reuse by a memory type are released by DestroyUnusedPools when none
+    // of them was reused during this number of consecutive calls, or when their memory heap is
+    // over budget. This avoids allocating the heaps again when the embedder calls the idle tasks
+    // frequently.
+    static constexpr uint32_t kMaxUnusedPoolIdleTaskCount = 8;
+    void DestroyUnusedPools();
+
     void Tick(ExecutionSerial completedSerial);
 
     int FindBestTypeIndex(VkMemoryRequirements requirements, MemoryKind kind);
 
+    // Defragmentation moves the resources out of the sparse heaps, in which at most a quarter of
+    // the memory is used, so that these heaps are freed once the moved resources are deallocated.
+    // Returns the heaps to move the resources out of, given the sub-allocations of the resources
+    // that can be moved. A sparse heap is selected only when all its sub-allocations can be
+    // moved, since the other heaps are never freed. The sparse heaps of a memory type are
+    // selected only when their sub-allocations fit in fewer heaps, so that moving them frees more
+    // heaps than it allocates.
+    absl::flat_hash_set<const ResourceHeapBase*> SelectHeapsToRelease(
+        const std::vector<ResourceMemoryAllocation>& movableAllocations) const;
+
+    // Returns all the sparse heaps, which the moved resources are never allocated in so that they
+    // don't have to be moved again.
+    absl::flat_hash_set<const ResourceHeapBase*> GetSparseHeaps() const;
+
+    // Allocates memory like Allocate, but never in `excludedHeaps`, which are the sparse heaps.
+    // The free blocks of the excluded heaps that are returned by the sub-allocator are reserved
+    // until ReleaseReservedBlocks is called, so that the next allocations can't use them either.
+    // Returns an invalid allocation when too many blocks are reserved.
+    ResultOrError<ResourceMemoryAllocation> AllocateOutsideOfHeaps(
+        const VkMemoryRequirements& requirements,
+        MemoryKind kind,
+        const absl::flat_hash_set<const ResourceHeapBase*>& excludedHeaps);
+    void ReleaseReservedBlocks();
+
+    ResourceMemoryStats GetStats() const;
+
   private:
+    // Returns true if allocating `allocationSize` more bytes in the memory heap would exceed its
+    // budget. The budget is queried with VK_EXT_memory_budget when available.
+    bool IsOverBudget(uint32_t memoryHeapIndex, VkDeviceSize allocationSize) const;
+    // Releases the free heaps kept for reuse by the memory types of the memory heap.
+    void DestroyPool(uint32_t memoryHeapIndex);
+
     raw_ptr<Device> mDevice;
 
     class SingleTypeAllocator;
     std::vector<std::unique_ptr<SingleTypeAllocator>> mAllocatorsPerType;
 
     SerialQueue<ExecutionSerial, ResourceMemoryAllocation> mSubAllocationsToDelete;
+
+    // The size of the VkDeviceMemory allocated in each memory heap, including the heaps kept for
+    // reuse.
+    std::vector<VkDeviceSize> mAllocatedSizePerMemoryHeap;
+
+    std::vector<ResourceMemoryAllocation> mReservedBlocks;
+
+    uint64_t mMovedAllocationCount = 0;
+    uint64_t mReleasedHeapCount = 0;
+    uint64_t mOverBudgetAllocationCount = 0;
 };
 
 }  // namespace dawn::native::vulkan
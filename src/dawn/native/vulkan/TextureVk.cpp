@@ -958,21 +958,31 @@ void Texture::TransitionUsageNow(CommandRecordingContext* recordingContext,
                                  wgpu::TextureUsage usage,
                                  wgpu::ShaderStage shaderStages,
                                  const SubresourceRange& range) {
-    std::vector<VkImageMemoryBarrier> barriers;
+    TransitionUsageForNextCommand(recordingContext, usage, shaderStages, range);
+    recordingContext->FlushBarriers(ToBackend(GetDevice())->fn);
+}
+
+void Texture::TransitionUsageForNextCommand(CommandRecordingContext* recordingContext,
+                                            wgpu::TextureUsage usage,
+                                            wgpu::ShaderStage shaderStages,
+                                            const SubresourceRange& range) {
+    BarrierBatch* batch = &recordingContext->pendingBarriers;
+    size_t transitionBarrierStart = batch->imageBarriers.size();
 
     VkPipelineStageFlags srcStages = 0;
     VkPipelineStageFlags dstStages = 0;
 
-    TransitionUsageAndGetResourceBarrier(usage, shaderStages, range, &barriers, &srcStages,
-                                         &dstStages);
+    TransitionUsageAndGetResourceBarrier(usage, shaderStages, range, &batch->imageBarriers,
+                                         &srcStages, &dstStages);
 
-    TweakTransition(recordingContext, &barriers, 0);
+    TweakTransition(recordingContext, &batch->imageBarriers, transitionBarrierStart);
 
-    if (!barriers.empty()) {
+    // Only add the stages if barriers were needed, to avoid putting TOP_OF_PIPE in the source
+    // stages of the batch.
+    if (batch->imageBarriers.size() > transitionBarrierStart) {
         DAWN_ASSERT(srcStages != 0 && dstStages != 0);
-        ToBackend(GetDevice())
-            ->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
-                                    nullptr, 0, nullptr, barriers.size(), barriers.data());
+        batch->srcStages |= srcStages;
+        batch->dstStages |= dstStages;
     }
 }
 
@@ -1499,8 +1509,8 @@ void ImportedTextureBase::TransitionEagerlyForExport(CommandRecordingContext* re
     // importing queue.
     dstStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
 
-    device->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
-                                  nullptr, 0, nullptr, 1, &barrier);
+    recordingContext->RecordPipelineBarrier(device->fn, srcStages, dstStages, 0, nullptr, 1,
+                                            &barrier);
 }
 
 void ImportedTextureBase::UpdateExternalSemaphoreHandle(ExternalSemaphoreHandle handle) {
@@ -80,12 +80,19 @@ class Texture : public TextureBase {
                                    uint32_t mipLevel = 0) const;
 
     // Transitions the texture to be used as `usage`, recording any necessary barrier in
-    // `commands`.
-    // TODO(crbug.com/dawn/851): coalesce barriers and do them early when possible.
+    // `commands`, along with the other barriers pending in `recordingContext`.
+    // TODO(crbug.com/dawn/851): do barriers early when possible.
     void TransitionUsageNow(CommandRecordingContext* recordingContext,
                             wgpu::TextureUsage usage,
                             wgpu::ShaderStage shaderStages,
                             const SubresourceRange& range);
+    // Same as TransitionUsageNow, but adds the barriers to the pending barriers of
+    // `recordingContext` so that they are merged with the barriers of the other resources used
+    // by the next command. The caller must call FlushBarriers before recording that command.
+    void TransitionUsageForNextCommand(CommandRecordingContext* recordingContext,
+                                       wgpu::TextureUsage usage,
+                                       wgpu::ShaderStage shaderStages,
+                                       const SubresourceRange& range);
     void TransitionUsageForPass(CommandRecordingContext* recordingContext,
                                 const TextureSubresourceSyncInfo& textureSyncInfos,
                                 std::vector<VkImageMemoryBarrier>* imageBarriers,
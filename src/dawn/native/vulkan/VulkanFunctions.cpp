@@ -385,6 +385,12 @@ MaybeError VulkanFunctions::LoadDeviceProcs(VkDevice device, const VulkanDeviceI
         GET_DEVICE_PROC(QueuePresentKHR);
     }
 
+    if (deviceInfo.HasExt(DeviceExt::DescriptorUpdateTemplate)) {
+        GET_DEVICE_PROC(CreateDescriptorUpdateTemplate);
+        GET_DEVICE_PROC(DestroyDescriptorUpdateTemplate);
+        GET_DEVICE_PROC(UpdateDescriptorSetWithTemplate);
+    }
+
     if (deviceInfo.HasExt(DeviceExt::GetMemoryRequirements2)) {
         GET_DEVICE_PROC(GetBufferMemoryRequirements2);
         GET_DEVICE_PROC(GetImageMemoryRequirements2);
@@ -338,6 +338,11 @@ struct VulkanFunctions {
     VkFn<PFN_vkImportSemaphoreFdKHR> ImportSemaphoreFdKHR = nullptr;
     VkFn<PFN_vkGetSemaphoreFdKHR> GetSemaphoreFdKHR = nullptr;
 
+    // VK_KHR_descriptor_update_template
+    VkFn<PFN_vkCreateDescriptorUpdateTemplateKHR> CreateDescriptorUpdateTemplate = nullptr;
+    VkFn<PFN_vkDestroyDescriptorUpdateTemplateKHR> DestroyDescriptorUpdateTemplate = nullptr;
+    VkFn<PFN_vkUpdateDescriptorSetWithTemplateKHR> UpdateDescriptorSetWithTemplate = nullptr;
+
     // VK_KHR_get_memory_requirements2
     VkFn<PFN_vkGetBufferMemoryRequirements2KHR> GetBufferMemoryRequirements2 = nullptr;
     VkFn<PFN_vkGetImageMemoryRequirements2KHR> GetImageMemoryRequirements2 = nullptr;
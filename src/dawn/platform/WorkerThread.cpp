@@ -27,77 +27,228 @@
 
 #include "dawn/platform/WorkerThread.h"
 
-#include <condition_variable>
-#include <functional>
-#include <thread>
+#include <algorithm>
+#include <utility>
 
 #include "dawn/common/Assert.h"
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn::platform {
+
+struct AsyncWorkerThreadPool::Task {
+    Task(PostWorkerTaskCallback callbackIn, void* userdataIn)
+        : callback(callbackIn), userdata(userdataIn) {}
+
+    PostWorkerTaskCallback callback;
+    void* userdata;
+    std::atomic<bool> isComplete = false;
+};
 
 namespace {
 
-class AsyncWaitableEventImpl {
+// The pool whose worker is running on the current thread, if any.
+thread_local const AsyncWorkerThreadPool* tWorkerPool = nullptr;
+
+// The event shares ownership of the task with the pool's queue and otherwise only points back at
+// the pool. Waiting on an event after the pool is destroyed is fine since the pool completes all
+// of its tasks before it goes away.
+class AsyncWaitableEvent final : public WaitableEvent {
   public:
-    AsyncWaitableEventImpl() : mIsComplete(false) {}
+    AsyncWaitableEvent(AsyncWorkerThreadPool* pool,
+                       std::shared_ptr<AsyncWorkerThreadPool::Task> task)
+        : mPool(pool), mTask(std::move(task)) {}
 
-    void Wait() {
-        std::unique_lock<std::mutex> lock(mMutex);
-        mCondition.wait(lock, [this] { return mIsComplete; });
+    void Wait() override {
+        if (!IsComplete()) {
+            mPool->WaitForCompletion(mTask.get());
+        }
     }
 
-    bool IsComplete() {
+    bool IsComplete() override { return mTask->isComplete.load(); }
+
+  private:
+    raw_ptr<AsyncWorkerThreadPool> mPool;
+    std::shared_ptr<AsyncWorkerThreadPool::Task> mTask;
+};
+
+}  // anonymous namespace
+
+AsyncWorkerThreadPool::AsyncWorkerThreadPool(uint32_t maxThreadCount)
+    : mMaxThreadCount(maxThreadCount != 0
+                          ? maxThreadCount
+                          : std::max(1u, std::thread::hardware_concurrency())) {
+    mQueues.reserve(mMaxThreadCount);
+    for (uint32_t i = 0; i < mMaxThreadCount; ++i) {
+        mQueues.push_back(std::make_unique<WorkerQueue>());
+    }
+}
+
+AsyncWorkerThreadPool::~AsyncWorkerThreadPool() {
+    {
         std::lock_guard<std::mutex> lock(mMutex);
-        return mIsComplete;
+        mShutdown = true;
     }
+    mWorkAvailable.notify_all();
 
-    void MarkAsComplete() {
-        {
-            std::lock_guard<std::mutex> lock(mMutex);
-            mIsComplete = true;
-        }
-        mCondition.notify_all();
+    // Workers only exit once every queue is empty, so all events are complete after this.
+    for (std::thread& thread : mThreads) {
+        thread.join();
     }
+    DAWN_ASSERT(mQueuedTaskCount.load() == 0);
+}
 
-  private:
-    std::mutex mMutex;
-    std::condition_variable mCondition;
-    bool mIsComplete;
-};
+uint32_t AsyncWorkerThreadPool::GetMaxThreadCount() const {
+    return mMaxThreadCount;
+}
 
-class AsyncWaitableEvent final : public dawn::platform::WaitableEvent {
-  public:
-    AsyncWaitableEvent() : mWaitableEventImpl(std::make_shared<AsyncWaitableEventImpl>()) {}
+uint32_t AsyncWorkerThreadPool::GetThreadCount() const {
+    return mThreadCount.load(std::memory_order_acquire);
+}
 
-    void Wait() override { mWaitableEventImpl->Wait(); }
+std::unique_ptr<WaitableEvent> AsyncWorkerThreadPool::PostWorkerTask(
+    PostWorkerTaskCallback callback,
+    void* userdata) {
+    return PostWorkerTaskWithPriority(callback, userdata, WorkerTaskPriority::High);
+}
 
-    bool IsComplete() override { return mWaitableEventImpl->IsComplete(); }
+std::unique_ptr<WaitableEvent> AsyncWorkerThreadPool::PostWorkerTaskWithPriority(
+    PostWorkerTaskCallback callback,
+    void* userdata,
+    WorkerTaskPriority priority) {
+    std::shared_ptr<Task> task = std::make_shared<Task>(callback, userdata);
+    auto waitableEvent = std::make_unique<AsyncWaitableEvent>(this, task);
 
-    std::shared_ptr<AsyncWaitableEventImpl> GetWaitableEventImpl() const {
-        return mWaitableEventImpl;
+    // Make sure there is a worker to take the task if none of the existing ones are idle.
+    if (mIdleWorkerCount.load() == 0) {
+        MaybeStartWorker();
     }
 
-  private:
-    std::shared_ptr<AsyncWaitableEventImpl> mWaitableEventImpl;
-};
+    // Spread tasks over the started workers. Idle workers steal from the others' queues so the
+    // choice only needs to be roughly balanced.
+    uint32_t queueIndex = mNextQueue.fetch_add(1, std::memory_order_relaxed) % GetThreadCount();
+    WorkerQueue* queue = mQueues[queueIndex].get();
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->tasks[static_cast<size_t>(priority)].push_back(std::move(task));
+    }
 
-}  // anonymous namespace
+    // The increment of mQueuedTaskCount and the load of mIdleWorkerCount pair with the reverse
+    // operations in WorkerLoop so that either the worker sees the task before sleeping or we see
+    // the sleeping worker and wake it up.
+    mQueuedTaskCount.fetch_add(1);
+    if (mIdleWorkerCount.load() != 0) {
+        { std::lock_guard<std::mutex> lock(mMutex); }
+        mWorkAvailable.notify_one();
+    }
 
-namespace dawn::platform {
+    return waitableEvent;
+}
 
-std::unique_ptr<dawn::platform::WaitableEvent> AsyncWorkerThreadPool::PostWorkerTask(
-    dawn::platform::PostWorkerTaskCallback callback,
-    void* userdata) {
-    std::unique_ptr<AsyncWaitableEvent> waitableEvent = std::make_unique<AsyncWaitableEvent>();
+void AsyncWorkerThreadPool::MaybeStartWorker() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mThreads.size() >= mMaxThreadCount || mShutdown) {
+        return;
+    }
+    // Publish the new count first so that the worker sees its own queue in TakeTask.
+    uint32_t workerIndex = static_cast<uint32_t>(mThreads.size());
+    mThreadCount.store(workerIndex + 1, std::memory_order_release);
+    mThreads.emplace_back([this, workerIndex] { WorkerLoop(workerIndex); });
+}
 
-    std::function<void()> doTask = [callback, userdata,
-                                    waitableEventImpl = waitableEvent->GetWaitableEventImpl()] {
-        callback(userdata);
-        waitableEventImpl->MarkAsComplete();
-    };
+std::shared_ptr<AsyncWorkerThreadPool::Task> AsyncWorkerThreadPool::TakeTask(
+    uint32_t workerIndex) {
+    uint32_t threadCount = GetThreadCount();
+    for (size_t priority = 0; priority < kPriorityCount; ++priority) {
+        // Take the oldest task from our own queue first, then steal the newest task from the
+        // other workers' queues.
+        for (uint32_t i = 0; i < threadCount; ++i) {
+            WorkerQueue* queue = mQueues[(workerIndex + i) % threadCount].get();
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            std::deque<std::shared_ptr<Task>>& tasks = queue->tasks[priority];
+            if (tasks.empty()) {
+                continue;
+            }
+            std::shared_ptr<Task> task;
+            if (i == 0) {
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            } else {
+                task = std::move(tasks.back());
+                tasks.pop_back();
+            }
+            mQueuedTaskCount.fetch_sub(1);
+            return task;
+        }
+    }
+    return nullptr;
+}
 
-    std::thread thread(doTask);
-    thread.detach();
+std::shared_ptr<AsyncWorkerThreadPool::Task> AsyncWorkerThreadPool::TakeQueuedTask(
+    const Task* task) {
+    uint32_t threadCount = GetThreadCount();
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        WorkerQueue* queue = mQueues[i].get();
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        for (std::deque<std::shared_ptr<Task>>& tasks : queue->tasks) {
+            auto it = std::find_if(tasks.begin(), tasks.end(), [task](const auto& queued) {
+                return queued.get() == task;
+            });
+            if (it == tasks.end()) {
+                continue;
+            }
+            std::shared_ptr<Task> queuedTask = std::move(*it);
+            tasks.erase(it);
+            mQueuedTaskCount.fetch_sub(1);
+            return queuedTask;
+        }
+    }
+    return nullptr;
+}
 
-    return waitableEvent;
+void AsyncWorkerThreadPool::WorkerLoop(uint32_t workerIndex) {
+    tWorkerPool = this;
+    while (true) {
+        if (std::shared_ptr<Task> task = TakeTask(workerIndex)) {
+            RunTask(task.get());
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mIdleWorkerCount.fetch_add(1);
+        mWorkAvailable.wait(lock, [this] { return mQueuedTaskCount.load() != 0 || mShutdown; });
+        mIdleWorkerCount.fetch_sub(1);
+        if (mShutdown && mQueuedTaskCount.load() == 0) {
+            return;
+        }
+    }
+}
+
+void AsyncWorkerThreadPool::RunTask(Task* task) {
+    task->callback(task->userdata);
+    task->isComplete.store(true);
+
+    // Same pairing as in PostWorkerTaskWithPriority, with WaitForCompletion.
+    if (mCompletionWaiterCount.load() != 0) {
+        { std::lock_guard<std::mutex> lock(mCompletionMutex); }
+        mCompletionCondition.notify_all();
+    }
+}
+
+void AsyncWorkerThreadPool::WaitForCompletion(const Task* task) {
+    // With a bounded number of workers, a worker blocking on a queued task could wait forever if
+    // all the other workers are blocked too. Run the task here instead. A task that isn't queued
+    // is either complete or running on another worker, which makes progress the same way.
+    if (tWorkerPool == this) {
+        if (std::shared_ptr<Task> queuedTask = TakeQueuedTask(task)) {
+            RunTask(queuedTask.get());
+            return;
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(mCompletionMutex);
+    mCompletionWaiterCount.fetch_add(1);
+    mCompletionCondition.wait(lock, [task] { return task->isComplete.load(); });
+    mCompletionWaiterCount.fetch_sub(1);
 }
 
 }  // namespace dawn::platform
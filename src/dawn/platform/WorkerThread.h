@@ -28,18 +28,87 @@
 #ifndef SRC_DAWN_PLATFORM_WORKERTHREAD_H_
 #define SRC_DAWN_PLATFORM_WORKERTHREAD_H_
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "dawn/common/NonCopyable.h"
 #include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::platform {
 
+// A bounded pool of persistent worker threads. Threads are started lazily as tasks are posted, up
+// to a maximum that defaults to the number of hardware threads, and live until the pool is
+// destroyed. Each worker owns a queue per priority and idle workers steal from the other workers'
+// queues, so posting a task never creates a thread once the pool is warm. Destroying the pool
+// runs every task that is still queued and then joins the workers.
+//
+// Tasks may wait on the events of other tasks of the pool. A worker that waits for a task that is
+// still queued takes it out of the queue and runs it itself, so that waits can't deadlock when all
+// the workers are blocked on queued tasks. Such a worker must not hold locks that the awaited task
+// needs, as it would if the task ran on another worker.
 class AsyncWorkerThreadPool : public dawn::platform::WorkerTaskPool, public NonCopyable {
   public:
+    // A |maxThreadCount| of 0 uses the number of hardware threads.
+    explicit AsyncWorkerThreadPool(uint32_t maxThreadCount = 0);
+    ~AsyncWorkerThreadPool() override;
+
     std::unique_ptr<dawn::platform::WaitableEvent> PostWorkerTask(
         dawn::platform::PostWorkerTaskCallback callback,
         void* userdata) override;
+    std::unique_ptr<dawn::platform::WaitableEvent> PostWorkerTaskWithPriority(
+        dawn::platform::PostWorkerTaskCallback callback,
+        void* userdata,
+        dawn::platform::WorkerTaskPriority priority) override;
+
+    uint32_t GetMaxThreadCount() const;
+    uint32_t GetThreadCount() const;
+
+    struct Task;
+
+    // Blocks until |task| has run. Waiting is done on a condition variable shared by the whole
+    // pool so that tasks and their events don't each need their own. When called from one of the
+    // pool's workers, runs |task| inline if it hasn't been taken by a worker yet.
+    void WaitForCompletion(const Task* task);
+
+  private:
+    static constexpr size_t kPriorityCount = 2;
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::array<std::deque<std::shared_ptr<Task>>, kPriorityCount> tasks;
+    };
+
+    void WorkerLoop(uint32_t workerIndex);
+    std::shared_ptr<Task> TakeTask(uint32_t workerIndex);
+    std::shared_ptr<Task> TakeQueuedTask(const Task* task);
+    void RunTask(Task* task);
+    void MaybeStartWorker();
+
+    const uint32_t mMaxThreadCount;
+    // One queue per potential worker, allocated up front so that they can be indexed without
+    // locking while workers are being started.
+    std::vector<std::unique_ptr<WorkerQueue>> mQueues;
+    std::atomic<uint32_t> mThreadCount = 0;
+    std::atomic<uint32_t> mNextQueue = 0;
+
+    // Number of tasks sitting in mQueues. Workers sleep on mWorkAvailable when it reaches 0.
+    std::atomic<size_t> mQueuedTaskCount = 0;
+    std::atomic<uint32_t> mIdleWorkerCount = 0;
+    std::mutex mMutex;
+    std::condition_variable mWorkAvailable;
+    std::vector<std::thread> mThreads;
+    bool mShutdown = false;
+
+    std::atomic<uint32_t> mCompletionWaiterCount = 0;
+    std::mutex mCompletionMutex;
+    std::condition_variable mCompletionCondition;
 };
 
 }  // namespace dawn::platform
@@ -0,0 +1,115 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <webgpu/webgpu.h>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Ref.h"
+#include "dawn/native/CallbackTaskManager.h"
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn::native {
+namespace {
+
+// The number of callbacks added between each flush of the CallbackTaskManager.
+constexpr uint32_t kCallbacksPerFlush = 1024;
+
+void MapCallback(WGPUBufferMapAsyncStatus status, void* userdata) {
+    (*static_cast<uint32_t*>(userdata))++;
+}
+
+struct CountingTask : CallbackTask {
+    explicit CountingTask(uint32_t* count) : mCount(count) {}
+
+    void FinishImpl() override { (*mCount)++; }
+    void HandleShutDownImpl() override { (*mCount)++; }
+    void HandleDeviceLossImpl() override { (*mCount)++; }
+
+    raw_ptr<uint32_t> mCount;
+};
+
+// Adds C callbacks with their userdata, like the ones of the MapAsync that failed validation.
+void BM_FunctionPointerCallbacks(benchmark::State& state) {
+    Ref<CallbackTaskManager> manager = AcquireRef(new CallbackTaskManager());
+    uint32_t count = 0;
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < kCallbacksPerFlush; ++i) {
+            manager->AddCallbackTask(MapCallback, WGPUBufferMapAsyncStatus_ValidationError,
+                                     static_cast<void*>(&count));
+        }
+        manager->Flush();
+    }
+    benchmark::DoNotOptimize(count);
+    state.SetItemsProcessed(state.iterations() * kCallbacksPerFlush);
+}
+BENCHMARK(BM_FunctionPointerCallbacks);
+
+// Adds callbacks wrapped in an std::function.
+void BM_StdFunctionCallbacks(benchmark::State& state) {
+    Ref<CallbackTaskManager> manager = AcquireRef(new CallbackTaskManager());
+    uint32_t count = 0;
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < kCallbacksPerFlush; ++i) {
+            manager->AddCallbackTask([&count] { count++; });
+        }
+        manager->Flush();
+    }
+    benchmark::DoNotOptimize(count);
+    state.SetItemsProcessed(state.iterations() * kCallbacksPerFlush);
+}
+BENCHMARK(BM_StdFunctionCallbacks);
+
+// Adds tasks one at a time, or as a single batch like the queue does when its serial completes.
+void BM_CallbackTasks(benchmark::State& state) {
+    bool batched = state.range(0);
+    Ref<CallbackTaskManager> manager = AcquireRef(new CallbackTaskManager());
+    uint32_t count = 0;
+    for (auto _ : state) {
+        std::vector<std::unique_ptr<CountingTask>> tasks;
+        tasks.reserve(kCallbacksPerFlush);
+        for (uint32_t i = 0; i < kCallbacksPerFlush; ++i) {
+            tasks.push_back(std::make_unique<CountingTask>(&count));
+        }
+        if (batched) {
+            manager->AddCallbackTasks(std::move(tasks));
+        } else {
+            for (std::unique_ptr<CountingTask>& task : tasks) {
+                manager->AddCallbackTask(std::move(task));
+            }
+        }
+        manager->Flush();
+    }
+    benchmark::DoNotOptimize(count);
+    state.SetItemsProcessed(state.iterations() * kCallbacksPerFlush);
+}
+BENCHMARK(BM_CallbackTasks)->ArgName("batched")->Arg(0)->Arg(1);
+
+}  // anonymous namespace
+}  // namespace dawn::native
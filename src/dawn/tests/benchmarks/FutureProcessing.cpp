@@ -0,0 +1,163 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <atomic>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/tests/benchmarks/NullDeviceSetup.h"
+
+namespace dawn {
+namespace {
+
+// The number of futures each thread creates per iteration.
+constexpr uint32_t kFuturesPerIteration = 16;
+
+// Benchmarks for tracking and completing futures, from one or many threads at once.
+class FutureProcessing : public NullDeviceBenchmarkFixture {
+  protected:
+    FutureProcessing() {
+        // The queue is used from multiple threads at once.
+        requiredFeatures.push_back(wgpu::FeatureName::ImplicitDeviceSynchronization);
+    }
+
+    // Creates |count| WaitAnyOnly futures that stay tracked, but are never visited by
+    // ProcessEvents, until they are waited on.
+    std::vector<wgpu::FutureWaitInfo> CreateOutstandingFutures(uint32_t count) {
+        std::vector<wgpu::FutureWaitInfo> futures(count);
+        wgpu::Queue queue = device.GetQueue();
+        for (wgpu::FutureWaitInfo& info : futures) {
+            info.future = queue.OnSubmittedWorkDone(wgpu::CallbackMode::WaitAnyOnly,
+                                                    [](wgpu::QueueWorkDoneStatus) {});
+        }
+        return futures;
+    }
+
+    void WaitForOutstandingFutures(std::vector<wgpu::FutureWaitInfo>* futures) {
+        wgpu::Instance instance = adapter.GetInstance();
+        for (wgpu::FutureWaitInfo& info : *futures) {
+            wgpu::WaitStatus status = instance.WaitAny(1, &info, 0);
+            DAWN_ASSERT(status == wgpu::WaitStatus::Success && info.completed);
+        }
+    }
+
+  private:
+    wgpu::DeviceDescriptor GetDeviceDescriptor() const override {
+        wgpu::DeviceDescriptor deviceDesc = {};
+        deviceDesc.requiredFeatures = requiredFeatures.data();
+        deviceDesc.requiredFeatureCount = requiredFeatures.size();
+        return deviceDesc;
+    }
+
+    std::vector<wgpu::FeatureName> requiredFeatures;
+};
+
+// Each thread creates futures that can be completed by ProcessEvents and calls ProcessEvents until
+// they are all completed. The argument is the number of other futures that stay outstanding.
+BENCHMARK_DEFINE_F(FutureProcessing, ProcessEvents)
+(benchmark::State& state) {
+    wgpu::Instance instance = adapter.GetInstance();
+    wgpu::Queue queue = device.GetQueue();
+
+    std::vector<wgpu::FutureWaitInfo> outstandingFutures;
+    if (state.thread_index() == 0) {
+        outstandingFutures = CreateOutstandingFutures(state.range(0));
+    }
+
+    std::atomic<uint32_t> completedFutures = 0;
+    uint32_t createdFutures = 0;
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < kFuturesPerIteration; ++i) {
+            queue.OnSubmittedWorkDone(
+                wgpu::CallbackMode::AllowProcessEvents,
+                [](wgpu::QueueWorkDoneStatus, std::atomic<uint32_t>* completed) { (*completed)++; },
+                &completedFutures);
+        }
+        createdFutures += kFuturesPerIteration;
+
+        // The callbacks may be called by ProcessEvents on other threads.
+        while (completedFutures.load() != createdFutures) {
+            instance.ProcessEvents();
+        }
+    }
+    state.SetItemsProcessed(createdFutures);
+
+    if (state.thread_index() == 0) {
+        WaitForOutstandingFutures(&outstandingFutures);
+    }
+}
+BENCHMARK_REGISTER_F(FutureProcessing, ProcessEvents)
+    ->Arg(0)
+    ->Arg(4096)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16)
+    ->UseRealTime();
+
+// Each thread creates WaitAnyOnly futures and waits on them. The argument is the number of other
+// futures that stay outstanding.
+BENCHMARK_DEFINE_F(FutureProcessing, WaitAny)
+(benchmark::State& state) {
+    wgpu::Instance instance = adapter.GetInstance();
+    wgpu::Queue queue = device.GetQueue();
+
+    std::vector<wgpu::FutureWaitInfo> outstandingFutures;
+    if (state.thread_index() == 0) {
+        outstandingFutures = CreateOutstandingFutures(state.range(0));
+    }
+
+    std::vector<wgpu::FutureWaitInfo> futures(kFuturesPerIteration);
+    for (auto _ : state) {
+        for (wgpu::FutureWaitInfo& info : futures) {
+            info.future = queue.OnSubmittedWorkDone(wgpu::CallbackMode::WaitAnyOnly,
+                                                    [](wgpu::QueueWorkDoneStatus) {});
+            info.completed = false;
+        }
+        for (wgpu::FutureWaitInfo& info : futures) {
+            while (!info.completed) {
+                instance.WaitAny(1, &info, 0);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kFuturesPerIteration);
+
+    if (state.thread_index() == 0) {
+        WaitForOutstandingFutures(&outstandingFutures);
+    }
+}
+BENCHMARK_REGISTER_F(FutureProcessing, WaitAny)
+    ->Arg(0)
+    ->Arg(4096)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16)
+    ->UseRealTime();
+
+}  // anonymous namespace
+}  // namespace dawn
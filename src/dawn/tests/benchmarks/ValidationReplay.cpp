@@ -0,0 +1,374 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// dawn_validation_replay replays wire traces on the Null backend and reports how long the frontend
+// spent in each entry point. Since the Null backend does no GPU work, the timings only cover
+// validation, resource tracking and command recording, which lets frontend CPU regressions be
+// measured and bisected on any machine.
+//
+// Traces are the ones written by dawn::utils::WireHelper when it is given a trace directory, for
+// example with `dawn_unittests --use-wire --wire-trace-dir=<dir>`. The wire client is installed
+// as the dawn_proc table so every API call of the application is serialized into the trace.
+
+#include <webgpu/webgpu.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Log.h"
+#include "dawn/dawn_proc_table.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/wire/WireCmd_autogen.h"
+#include "dawn/wire/WireServer.h"
+
+namespace dawn {
+namespace {
+
+// The bucket for the InstanceProcessEvents that the wire server runs after each batch of commands.
+constexpr char kProcessEventsName[] = "InstanceProcessEvents (implicit)";
+
+// Discards everything the server sends back to the client.
+class DevNull : public wire::CommandSerializer {
+  public:
+    size_t GetMaximumAllocationSize() const override { return 1024 * 1024 * 1024; }
+    void* GetCmdSpace(size_t size) override {
+        if (size > mBuffer.size()) {
+            mBuffer.resize(size);
+        }
+        return mBuffer.data();
+    }
+    bool Flush() override { return true; }
+
+  private:
+    std::vector<char> mBuffer;
+};
+
+// The dawn_native procs that the replay forwards to.
+DawnProcTable sNativeProcs;
+
+// Traces are usually recorded with a real adapter. Force all the adapter requests to the Null
+// backend so the replay never touches a GPU.
+WGPURequestAdapterOptions GetNullAdapterOptions(const WGPURequestAdapterOptions* options) {
+    WGPURequestAdapterOptions nullOptions = options != nullptr ? *options
+                                                               : WGPURequestAdapterOptions{};
+    nullOptions.backendType = WGPUBackendType_Null;
+    return nullOptions;
+}
+
+void RequestNullAdapter(WGPUInstance instance,
+                        const WGPURequestAdapterOptions* options,
+                        WGPURequestAdapterCallback callback,
+                        void* userdata) {
+    WGPURequestAdapterOptions nullOptions = GetNullAdapterOptions(options);
+    sNativeProcs.instanceRequestAdapter(instance, &nullOptions, callback, userdata);
+}
+
+WGPUFuture RequestNullAdapter2(WGPUInstance instance,
+                               const WGPURequestAdapterOptions* options,
+                               WGPURequestAdapterCallbackInfo2 callbackInfo) {
+    WGPURequestAdapterOptions nullOptions = GetNullAdapterOptions(options);
+    return sNativeProcs.instanceRequestAdapter2(instance, &nullOptions, callbackInfo);
+}
+
+// The wire server calls InstanceProcessEvents at the end of every HandleCommands. The replay
+// calls it itself after each command so that it is timed separately from the command.
+void SkipProcessEvents(WGPUInstance) {}
+
+class Statistics {
+  public:
+    void Record(const char* name, uint64_t durationNs) { mDurations[name].push_back(durationNs); }
+
+    void Print(bool csv, bool histograms) {
+        struct Row {
+            const char* name;
+            const std::vector<uint64_t>* durations;
+            uint64_t total;
+        };
+        std::vector<Row> rows;
+        for (auto& [name, durations] : mDurations) {
+            std::sort(durations.begin(), durations.end());
+            uint64_t total = 0;
+            for (uint64_t duration : durations) {
+                total += duration;
+            }
+            rows.push_back({name.c_str(), &durations, total});
+        }
+        std::sort(rows.begin(), rows.end(),
+                  [](const Row& a, const Row& b) { return a.total > b.total; });
+
+        if (csv) {
+            printf("entry_point,calls,total_ns,mean_ns,p50_ns,p90_ns,p99_ns,max_ns\n");
+        } else {
+            printf("%-40s %10s %12s %10s %10s %10s %10s %10s\n", "Entry point", "Calls",
+                   "Total (ms)", "Mean (us)", "p50 (us)", "p90 (us)", "p99 (us)", "Max (us)");
+        }
+        for (const Row& row : rows) {
+            uint64_t count = row.durations->size();
+            uint64_t mean = row.total / count;
+            uint64_t p50 = Percentile(*row.durations, 50);
+            uint64_t p90 = Percentile(*row.durations, 90);
+            uint64_t p99 = Percentile(*row.durations, 99);
+            uint64_t max = row.durations->back();
+            if (csv) {
+                printf("%s,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64
+                       ",%" PRIu64 "\n",
+                       row.name, count, row.total, mean, p50, p90, p99, max);
+            } else {
+                printf("%-40s %10" PRIu64 " %12.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n", row.name,
+                       count, row.total / 1e6, mean / 1e3, p50 / 1e3, p90 / 1e3, p99 / 1e3,
+                       max / 1e3);
+            }
+        }
+
+        if (histograms && !csv) {
+            for (const Row& row : rows) {
+                PrintHistogram(row.name, *row.durations);
+            }
+        }
+    }
+
+  private:
+    // |durations| must be sorted.
+    static uint64_t Percentile(const std::vector<uint64_t>& durations, uint32_t percentile) {
+        size_t index = (durations.size() - 1) * percentile / 100;
+        return durations[index];
+    }
+
+    // Prints the durations in power of two buckets, from 1ns to the maximum duration.
+    static void PrintHistogram(const char* name, const std::vector<uint64_t>& durations) {
+        std::vector<uint64_t> buckets;
+        for (uint64_t duration : durations) {
+            size_t bucket = 0;
+            while (bucket < 63 && (uint64_t(2) << bucket) <= duration) {
+                bucket++;
+            }
+            if (bucket >= buckets.size()) {
+                buckets.resize(bucket + 1, 0);
+            }
+            buckets[bucket]++;
+        }
+
+        uint64_t largestBucket = *std::max_element(buckets.begin(), buckets.end());
+        constexpr uint64_t kBarWidth = 50;
+
+        printf("\n%s\n", name);
+        for (size_t bucket = 0; bucket < buckets.size(); bucket++) {
+            if (buckets[bucket] == 0) {
+                continue;
+            }
+            uint64_t bar = (buckets[bucket] * kBarWidth + largestBucket - 1) / largestBucket;
+            printf("  [%12.3f us, %12.3f us) %10" PRIu64 " %s\n", (uint64_t(1) << bucket) / 1e3,
+                   (uint64_t(2) << bucket) / 1e3, buckets[bucket], std::string(bar, '#').c_str());
+        }
+    }
+
+    std::map<std::string, std::vector<uint64_t>> mDurations;
+};
+
+bool ReadTrace(const char* path, std::vector<char>* trace) {
+    std::ifstream file(path, std::ios_base::in | std::ios_base::binary);
+    if (!file.is_open()) {
+        ErrorLog() << "Couldn't open " << path;
+        return false;
+    }
+    trace->assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    // Traces start with the index at which the fuzzers inject an error, which the replay ignores.
+    if (trace->size() < sizeof(uint64_t)) {
+        ErrorLog() << path << " is too small to be a wire trace";
+        return false;
+    }
+    return true;
+}
+
+// Replays a trace on a new instance, one command at a time, and records how long each command
+// took. Returns false if the trace is malformed or the server rejected one of its commands.
+bool ReplayTrace(const char* path, const std::vector<char>& trace, Statistics* statistics) {
+    auto instance = std::make_unique<native::Instance>();
+
+    DawnProcTable procs = sNativeProcs;
+    procs.instanceRequestAdapter = RequestNullAdapter;
+    procs.instanceRequestAdapter2 = RequestNullAdapter2;
+    procs.instanceProcessEvents = SkipProcessEvents;
+
+    DevNull devNull;
+    wire::WireServerDescriptor serverDesc = {};
+    serverDesc.procs = &procs;
+    serverDesc.serializer = &devNull;
+    auto server = std::make_unique<wire::WireServer>(serverDesc);
+
+    // Like the fuzzers, assume the trace starts with a fresh wire client so the instance it uses
+    // is the first object that the client allocated.
+    if (!server->InjectInstance(instance->Get(), {1, 0})) {
+        ErrorLog() << "Couldn't inject the instance";
+        return false;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto ElapsedNs = [](Clock::time_point start) -> uint64_t {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    };
+
+    const char* data = trace.data();
+    size_t offset = sizeof(uint64_t);
+    size_t commandIndex = 0;
+    while (offset < trace.size()) {
+        wire::CmdHeader header;
+        wire::WireCmd commandId;
+        size_t remainingSize = trace.size() - offset;
+        if (remainingSize < sizeof(header) + sizeof(commandId)) {
+            ErrorLog() << path << " is truncated after " << commandIndex << " commands";
+            return false;
+        }
+        memcpy(&header, data + offset, sizeof(header));
+        memcpy(&commandId, data + offset + sizeof(header), sizeof(commandId));
+        if (header.commandSize < sizeof(header) + sizeof(commandId) ||
+            header.commandSize > remainingSize) {
+            ErrorLog() << path << " has an invalid command size at command " << commandIndex;
+            return false;
+        }
+
+        const char* name = wire::GetWireCmdName(commandId);
+        if (name == nullptr) {
+            ErrorLog() << path << " has an unknown command at command " << commandIndex;
+            return false;
+        }
+
+        size_t commandSize = static_cast<size_t>(header.commandSize);
+        Clock::time_point start = Clock::now();
+        const volatile char* result = server->HandleCommands(data + offset, commandSize);
+        statistics->Record(name, ElapsedNs(start));
+        if (result == nullptr) {
+            ErrorLog() << path << ": the server rejected command " << commandIndex << " ("
+                       << name << ")";
+            return false;
+        }
+
+        start = Clock::now();
+        sNativeProcs.instanceProcessEvents(instance->Get());
+        statistics->Record(kProcessEventsName, ElapsedNs(start));
+
+        offset += commandSize;
+        commandIndex++;
+    }
+    return true;
+}
+
+void PrintUsage(const char* program) {
+    printf(
+        "Usage: %s [options] <trace>...\n"
+        "\n"
+        "Replays wire traces on the Null backend and reports the time spent in each entry point.\n"
+        "\n"
+        "options\n"
+        "  --iterations=<n>  Replay each trace n times (default 1)\n"
+        "  --histograms      Print a histogram of the durations of each entry point\n"
+        "  --csv             Print the statistics as CSV\n"
+        "  --help            Show this message\n",
+        program);
+}
+
+}  // anonymous namespace
+}  // namespace dawn
+
+int main(int argc, const char** argv) {
+    uint32_t iterations = 1;
+    bool histograms = false;
+    bool csv = false;
+    std::vector<const char*> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        constexpr const char kIterationsArg[] = "--iterations=";
+        size_t argLen = sizeof(kIterationsArg) - 1;
+        if (strncmp(argv[i], kIterationsArg, argLen) == 0) {
+            iterations = static_cast<uint32_t>(strtoul(argv[i] + argLen, nullptr, 0));
+            if (iterations == 0) {
+                dawn::ErrorLog() << "Invalid iteration count: " << argv[i] + argLen;
+                return 1;
+            }
+            continue;
+        }
+
+        if (strcmp("--histograms", argv[i]) == 0) {
+            histograms = true;
+            continue;
+        }
+
+        if (strcmp("--csv", argv[i]) == 0) {
+            csv = true;
+            continue;
+        }
+
+        if (strcmp("-h", argv[i]) == 0 || strcmp("--help", argv[i]) == 0) {
+            dawn::PrintUsage(argv[0]);
+            return 0;
+        }
+
+        if (strncmp(argv[i], "--", 2) == 0) {
+            dawn::ErrorLog() << "Unknown option: " << argv[i];
+            return 1;
+        }
+
+        paths.push_back(argv[i]);
+    }
+
+    if (paths.empty()) {
+        dawn::PrintUsage(argv[0]);
+        return 1;
+    }
+
+    dawn::sNativeProcs = dawn::native::GetProcs();
+
+    dawn::Statistics statistics;
+    bool success = true;
+    for (const char* path : paths) {
+        std::vector<char> trace;
+        if (!dawn::ReadTrace(path, &trace)) {
+            success = false;
+            continue;
+        }
+        for (uint32_t i = 0; i < iterations; ++i) {
+            if (!dawn::ReplayTrace(path, trace, &statistics)) {
+                success = false;
+                break;
+            }
+        }
+    }
+
+    statistics.Print(csv, histograms);
+    return success ? 0 : 1;
+}
@@ -0,0 +1,263 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <dawn/webgpu_cpp_print.h>
+#include <memory>
+#include <utility>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Log.h"
+#include "dawn/dawn_proc.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/utils/TerribleCommandBuffer.h"
+#include "dawn/utils/WGPUHelpers.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireCompactEncoding.h"
+#include "dawn/wire/WireServer.h"
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn {
+namespace {
+
+constexpr uint32_t kDispatchesPerPass = 1000;
+
+// Forwards commands to another handler and counts the number of bytes that went through it.
+class CountingCommandHandler : public wire::CommandHandler {
+  public:
+    void SetHandler(wire::CommandHandler* handler) { mHandler = handler; }
+    uint64_t GetByteCount() const { return mByteCount; }
+
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        mByteCount += size;
+        return mHandler->HandleCommands(commands, size);
+    }
+
+  private:
+    raw_ptr<wire::CommandHandler> mHandler = nullptr;
+    uint64_t mByteCount = 0;
+};
+
+// Benchmarks the throughput of the wire, with the client and the server in the same process
+// talking to each other over a loopback command buffer and the server using the null backend.
+// The first argument selects whether the compact encoding is used.
+class WireCommandEncoding : public benchmark::Fixture {
+  public:
+    void SetUp(const benchmark::State& state) override {
+        bool useCompactEncoding = state.range(0) != 0;
+
+        mNativeInstance = std::make_unique<native::Instance>();
+        mC2sBuf = std::make_unique<utils::TerribleCommandBuffer>();
+        mS2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
+
+        wire::CommandSerializer* c2sSerializer = mC2sBuf.get();
+        wire::CommandSerializer* s2cSerializer = mS2cBuf.get();
+        if (useCompactEncoding) {
+            wire::CompactCommandSerializerDescriptor c2sDesc = {};
+            c2sDesc.serializer = mC2sBuf.get();
+            c2sDesc.elideRedundantCommands = true;
+            mC2sCompactSerializer = std::make_unique<wire::CompactCommandSerializer>(c2sDesc);
+            c2sSerializer = mC2sCompactSerializer.get();
+
+            wire::CompactCommandSerializerDescriptor s2cDesc = {};
+            s2cDesc.serializer = mS2cBuf.get();
+            mS2cCompactSerializer = std::make_unique<wire::CompactCommandSerializer>(s2cDesc);
+            s2cSerializer = mS2cCompactSerializer.get();
+        }
+
+        wire::WireServerDescriptor serverDesc = {};
+        serverDesc.procs = &native::GetProcs();
+        serverDesc.serializer = s2cSerializer;
+        mWireServer = std::make_unique<wire::WireServer>(serverDesc);
+
+        wire::WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = c2sSerializer;
+        mWireClient = std::make_unique<wire::WireClient>(clientDesc);
+
+        if (useCompactEncoding) {
+            mC2sCompactHandler = std::make_unique<wire::CompactCommandHandler>(mWireServer.get());
+            mS2cCompactHandler = std::make_unique<wire::CompactCommandHandler>(mWireClient.get());
+            mC2sCounter.SetHandler(mC2sCompactHandler.get());
+            mS2cBuf->SetHandler(mS2cCompactHandler.get());
+        } else {
+            mC2sCounter.SetHandler(mWireServer.get());
+            mS2cBuf->SetHandler(mWireClient.get());
+        }
+        mC2sBuf->SetHandler(&mC2sCounter);
+        dawnProcSetProcs(&wire::client::GetProcs());
+
+        auto reservedInstance = mWireClient->ReserveInstance();
+        mWireServer->InjectInstance(mNativeInstance->Get(), reservedInstance.handle);
+        mInstance = wgpu::Instance::Acquire(reservedInstance.instance);
+
+        wgpu::RequestAdapterOptions options = {};
+        options.backendType = wgpu::BackendType::Null;
+        wgpu::Adapter adapter;
+        mInstance.RequestAdapter(
+            &options, wgpu::CallbackMode::AllowSpontaneous,
+            [&adapter](wgpu::RequestAdapterStatus status, wgpu::Adapter result, wgpu::StringView) {
+                DAWN_ASSERT(status == wgpu::RequestAdapterStatus::Success);
+                adapter = std::move(result);
+            });
+        while (adapter == nullptr) {
+            FlushWire();
+        }
+
+        wgpu::DeviceDescriptor deviceDesc = {};
+        deviceDesc.SetUncapturedErrorCallback(
+            [](const wgpu::Device&, wgpu::ErrorType, wgpu::StringView message) {
+                ErrorLog() << message;
+                DAWN_UNREACHABLE();
+            });
+        adapter.RequestDevice(
+            &deviceDesc, wgpu::CallbackMode::AllowSpontaneous,
+            [this](wgpu::RequestDeviceStatus status, wgpu::Device result, wgpu::StringView) {
+                DAWN_ASSERT(status == wgpu::RequestDeviceStatus::Success);
+                device = std::move(result);
+            });
+        while (device == nullptr) {
+            FlushWire();
+        }
+        queue = device.GetQueue();
+
+        wgpu::ComputePipelineDescriptor pipelineDesc = {};
+        pipelineDesc.compute.module = utils::CreateShaderModule(device, R"(
+            @group(0) @binding(0) var<uniform> u : vec4u;
+            @compute @workgroup_size(1) fn main() { _ = u; }
+        )");
+        pipeline = device.CreateComputePipeline(&pipelineDesc);
+
+        wgpu::BufferDescriptor bufferDesc = {};
+        bufferDesc.size = 16;
+        bufferDesc.usage = wgpu::BufferUsage::Uniform;
+        wgpu::Buffer buffer = device.CreateBuffer(&bufferDesc);
+        bindGroup = utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0), {{0, buffer}});
+        FlushWire();
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        bindGroup = nullptr;
+        pipeline = nullptr;
+        queue = nullptr;
+        device = nullptr;
+        mInstance = nullptr;
+        FlushWire();
+
+        mC2sBuf->SetHandler(nullptr);
+        mS2cBuf->SetHandler(nullptr);
+        mC2sCounter.SetHandler(nullptr);
+        mC2sCompactHandler = nullptr;
+        mS2cCompactHandler = nullptr;
+        mWireClient = nullptr;
+        mWireServer = nullptr;
+        mC2sCompactSerializer = nullptr;
+        mS2cCompactSerializer = nullptr;
+        mC2sBuf = nullptr;
+        mS2cBuf = nullptr;
+        mNativeInstance = nullptr;
+
+        // Other benchmarks use the native procs directly.
+        dawnProcSetProcs(&native::GetProcs());
+    }
+
+  protected:
+    void FlushWire() {
+        bool success = FlushClient();
+        success &= mS2cCompactSerializer ? mS2cCompactSerializer->Flush() : mS2cBuf->Flush();
+        DAWN_ASSERT(success);
+    }
+
+    bool FlushClient() {
+        return mC2sCompactSerializer ? mC2sCompactSerializer->Flush() : mC2sBuf->Flush();
+    }
+
+    void EncodeAndSubmit(bool redundantState) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, bindGroup);
+        for (uint32_t i = 0; i < kDispatchesPerPass; ++i) {
+            if (redundantState) {
+                pass.SetPipeline(pipeline);
+                pass.SetBindGroup(0, bindGroup);
+            }
+            pass.DispatchWorkgroups(i % 64 + 1);
+        }
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    void Run(benchmark::State& state, bool redundantState) {
+        uint64_t bytesBefore = mC2sCounter.GetByteCount();
+        for (auto _ : state) {
+            EncodeAndSubmit(redundantState);
+            device.Tick();
+            FlushWire();
+        }
+        state.SetItemsProcessed(state.iterations() * kDispatchesPerPass);
+        state.counters["ClientBytesPerIteration"] = benchmark::Counter(
+            static_cast<double>(mC2sCounter.GetByteCount() - bytesBefore) / state.iterations());
+    }
+
+    wgpu::Device device;
+    wgpu::Queue queue;
+    wgpu::ComputePipeline pipeline;
+    wgpu::BindGroup bindGroup;
+
+  private:
+    std::unique_ptr<native::Instance> mNativeInstance;
+    wgpu::Instance mInstance;
+    std::unique_ptr<utils::TerribleCommandBuffer> mC2sBuf;
+    std::unique_ptr<utils::TerribleCommandBuffer> mS2cBuf;
+    std::unique_ptr<wire::CompactCommandSerializer> mC2sCompactSerializer;
+    std::unique_ptr<wire::CompactCommandSerializer> mS2cCompactSerializer;
+    std::unique_ptr<wire::WireServer> mWireServer;
+    std::unique_ptr<wire::WireClient> mWireClient;
+    std::unique_ptr<wire::CompactCommandHandler> mC2sCompactHandler;
+    std::unique_ptr<wire::CompactCommandHandler> mS2cCompactHandler;
+    CountingCommandHandler mC2sCounter;
+};
+
+BENCHMARK_DEFINE_F(WireCommandEncoding, Dispatches)
+(benchmark::State& state) {
+    Run(state, false);
+}
+BENCHMARK_REGISTER_F(WireCommandEncoding, Dispatches)->ArgName("compact")->Arg(0)->Arg(1);
+
+BENCHMARK_DEFINE_F(WireCommandEncoding, RedundantStateDispatches)
+(benchmark::State& state) {
+    Run(state, true);
+}
+BENCHMARK_REGISTER_F(WireCommandEncoding, RedundantStateDispatches)
+    ->ArgName("compact")
+    ->Arg(0)
+    ->Arg(1);
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -0,0 +1,329 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <dawn/webgpu_cpp_print.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Log.h"
+#include "dawn/dawn_proc.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/utils/TerribleCommandBuffer.h"
+#include "dawn/utils/WGPUHelpers.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn {
+namespace {
+
+constexpr uint32_t kDispatchesPerSubmit = 100;
+// Simulates the driver cost of a heavy submit, during which the commands of the other devices
+// can only make progress if they are handled on other threads.
+constexpr auto kSubmitDuration = std::chrono::microseconds(500);
+
+// The server calls the native procs from several threads so the devices must be implicitly
+// synchronized. The wire doesn't support the feature so it is added behind the client's back.
+WGPUFuture RequestSynchronizedDevice(WGPUAdapter adapter,
+                                     const WGPUDeviceDescriptor* descriptor,
+                                     WGPURequestDeviceCallbackInfo2 callbackInfo) {
+    WGPUDeviceDescriptor desc = *descriptor;
+    std::vector<WGPUFeatureName> features(desc.requiredFeatures,
+                                          desc.requiredFeatures + desc.requiredFeatureCount);
+    features.push_back(WGPUFeatureName_ImplicitDeviceSynchronization);
+    desc.requiredFeatures = features.data();
+    desc.requiredFeatureCount = features.size();
+    return native::GetProcs().adapterRequestDevice2(adapter, &desc, callbackInfo);
+}
+
+size_t EnumerateWireFeatures(WGPUDevice device, WGPUFeatureName* features) {
+    std::vector<WGPUFeatureName> allFeatures(native::GetProcs().deviceEnumerateFeatures(device,
+                                                                                        nullptr));
+    native::GetProcs().deviceEnumerateFeatures(device, allFeatures.data());
+    auto end = std::remove(allFeatures.begin(), allFeatures.end(),
+                           WGPUFeatureName_ImplicitDeviceSynchronization);
+    if (features != nullptr) {
+        std::copy(allFeatures.begin(), end, features);
+    }
+    return end - allFeatures.begin();
+}
+
+void SlowQueueSubmit(WGPUQueue queue, size_t commandCount, const WGPUCommandBuffer* commands) {
+    native::GetProcs().queueSubmit(queue, commandCount, commands);
+    std::this_thread::sleep_for(kSubmitDuration);
+}
+
+// Delivers the replies of the server to a client that is shared by several threads, with the
+// lock of the client held.
+class LockedCommandHandler : public wire::CommandHandler {
+  public:
+    LockedCommandHandler(wire::CommandHandler* handler, std::mutex* mutex)
+        : mHandler(handler), mMutex(mutex) {}
+
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        std::lock_guard<std::mutex> lock(*mMutex);
+        return mHandler->HandleCommands(commands, size);
+    }
+
+  private:
+    raw_ptr<wire::CommandHandler> mHandler;
+    raw_ptr<std::mutex> mMutex;
+};
+
+// Benchmarks the aggregate command throughput of a wire server shared by several clients, each
+// submitting work to its own device with an expensive QueueSubmit and waiting for it to complete.
+// Each benchmark thread is a client, like the workers of a page that share its wire client under a
+// lock. A server thread handles the commands of all the clients and sends back the replies, like
+// the GPU process would. The argument is the number of device command threads of the server.
+class WireServerDispatch : public benchmark::Fixture {
+  public:
+    void SetUp(const benchmark::State& state) override {
+        if (state.thread_index() != 0) {
+            // Thread 0 creates the devices of all the clients.
+            std::unique_lock<std::mutex> lock(mSetUpMutex);
+            mSetUpCv.wait(lock, [this] { return mIsSetUp; });
+            return;
+        }
+
+        mProcs = native::GetProcs();
+        mProcs.adapterRequestDevice2 = RequestSynchronizedDevice;
+        mProcs.deviceEnumerateFeatures = EnumerateWireFeatures;
+        mProcs.queueSubmit = SlowQueueSubmit;
+
+        mNativeInstance = std::make_unique<native::Instance>();
+        mC2sBuf = std::make_unique<utils::TerribleCommandBuffer>();
+        mS2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
+
+        wire::WireServerDescriptor serverDesc = {};
+        serverDesc.procs = &mProcs;
+        serverDesc.serializer = mS2cBuf.get();
+        serverDesc.deviceCommandThreadCount = static_cast<uint32_t>(state.range(0));
+        mWireServer = std::make_unique<wire::WireServer>(serverDesc);
+
+        wire::WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = mC2sBuf.get();
+        mWireClient = std::make_unique<wire::WireClient>(clientDesc);
+        mLockedWireClient =
+            std::make_unique<LockedCommandHandler>(mWireClient.get(), &mClientMutex);
+
+        mC2sBuf->SetHandler(mWireServer.get());
+        mS2cBuf->SetHandler(mLockedWireClient.get());
+        dawnProcSetProcs(&wire::client::GetProcs());
+
+        auto reservedInstance = mWireClient->ReserveInstance();
+        mWireServer->InjectInstance(mNativeInstance->Get(), reservedInstance.handle);
+        mInstance = wgpu::Instance::Acquire(reservedInstance.instance);
+
+        wgpu::RequestAdapterOptions options = {};
+        options.backendType = wgpu::BackendType::Null;
+        wgpu::Adapter adapter;
+        mInstance.RequestAdapter(
+            &options, wgpu::CallbackMode::AllowSpontaneous,
+            [&adapter](wgpu::RequestAdapterStatus status, wgpu::Adapter result, wgpu::StringView) {
+                DAWN_ASSERT(status == wgpu::RequestAdapterStatus::Success);
+                adapter = std::move(result);
+            });
+        while (adapter == nullptr) {
+            Pump();
+        }
+
+        mDevices.resize(state.threads());
+        for (wgpu::Device& device : mDevices) {
+            wgpu::DeviceDescriptor deviceDesc = {};
+            deviceDesc.SetUncapturedErrorCallback(
+                [](const wgpu::Device&, wgpu::ErrorType, wgpu::StringView message) {
+                    ErrorLog() << message;
+                    DAWN_UNREACHABLE();
+                });
+            adapter.RequestDevice(
+                &deviceDesc, wgpu::CallbackMode::AllowSpontaneous,
+                [&device](wgpu::RequestDeviceStatus status, wgpu::Device result, wgpu::StringView) {
+                    DAWN_ASSERT(status == wgpu::RequestDeviceStatus::Success);
+                    device = std::move(result);
+                });
+            while (device == nullptr) {
+                Pump();
+            }
+        }
+
+        for (const wgpu::Device& device : mDevices) {
+            wgpu::ComputePipelineDescriptor pipelineDesc = {};
+            pipelineDesc.compute.module = utils::CreateShaderModule(device, R"(
+                @compute @workgroup_size(1) fn main() {}
+            )");
+            mPipelines.push_back(device.CreateComputePipeline(&pipelineDesc));
+            mQueues.push_back(device.GetQueue());
+        }
+        Pump();
+
+        mStopServerThread = false;
+        mServerThread = std::thread([this] {
+            while (!mStopServerThread.load()) {
+                Pump();
+            }
+        });
+
+        {
+            std::lock_guard<std::mutex> lock(mSetUpMutex);
+            mIsSetUp = true;
+            mDoneClientCount = 0;
+        }
+        mSetUpCv.notify_all();
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        {
+            std::unique_lock<std::mutex> lock(mSetUpMutex);
+            mDoneClientCount++;
+            if (state.thread_index() != 0) {
+                mSetUpCv.notify_all();
+                return;
+            }
+            // Thread 0 tears down the wire once all the clients are done with it.
+            mSetUpCv.wait(lock, [&] { return mDoneClientCount == state.threads(); });
+            mIsSetUp = false;
+        }
+
+        mStopServerThread = true;
+        mServerThread.join();
+
+        mPipelines.clear();
+        mQueues.clear();
+        mDevices.clear();
+        mInstance = nullptr;
+        Pump();
+
+        mC2sBuf->SetHandler(nullptr);
+        mS2cBuf->SetHandler(nullptr);
+        mLockedWireClient = nullptr;
+        mWireClient = nullptr;
+        mWireServer = nullptr;
+        mC2sBuf = nullptr;
+        mS2cBuf = nullptr;
+        mNativeInstance = nullptr;
+
+        // Other benchmarks use the native procs directly.
+        dawnProcSetProcs(&native::GetProcs());
+    }
+
+  protected:
+    // Handles the commands of all the clients, and sends back the replies of each device as soon
+    // as its commands are handled. It is only called by one thread at a time.
+    void Pump() {
+        bool success;
+        {
+            std::lock_guard<std::mutex> lock(mClientMutex);
+            success = mC2sBuf->Flush();
+        }
+        success &= mWireServer->WaitForDispatchedCommands();
+        DAWN_ASSERT(success);
+    }
+
+    // Submits work to the device of |client| and waits until it completes.
+    void SubmitAndWait(size_t client) {
+        bool done = false;
+        {
+            // The wire client is shared by all the clients.
+            std::lock_guard<std::mutex> lock(mClientMutex);
+            wgpu::CommandEncoder encoder = mDevices[client].CreateCommandEncoder();
+            wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+            pass.SetPipeline(mPipelines[client]);
+            for (uint32_t i = 0; i < kDispatchesPerSubmit; ++i) {
+                pass.DispatchWorkgroups(i % 64 + 1);
+            }
+            pass.End();
+            wgpu::CommandBuffer commands = encoder.Finish();
+            mQueues[client].Submit(1, &commands);
+            mQueues[client].OnSubmittedWorkDone(
+                wgpu::CallbackMode::AllowSpontaneous, [this, &done](wgpu::QueueWorkDoneStatus) {
+                    std::lock_guard<std::mutex> lock(mWorkDoneMutex);
+                    done = true;
+                    mWorkDoneCv.notify_all();
+                });
+        }
+
+        std::unique_lock<std::mutex> lock(mWorkDoneMutex);
+        mWorkDoneCv.wait(lock, [&] { return done; });
+    }
+
+  private:
+    // Used by the clients in the order of their thread index.
+    std::vector<wgpu::Device> mDevices;
+    std::vector<wgpu::Queue> mQueues;
+    std::vector<wgpu::ComputePipeline> mPipelines;
+
+    DawnProcTable mProcs;
+    std::unique_ptr<native::Instance> mNativeInstance;
+    wgpu::Instance mInstance;
+    std::unique_ptr<utils::TerribleCommandBuffer> mC2sBuf;
+    std::unique_ptr<utils::TerribleCommandBuffer> mS2cBuf;
+    std::unique_ptr<wire::WireServer> mWireServer;
+    std::unique_ptr<wire::WireClient> mWireClient;
+    std::unique_ptr<LockedCommandHandler> mLockedWireClient;
+    // Guards the wire client and the buffer of its commands.
+    std::mutex mClientMutex;
+
+    std::thread mServerThread;
+    std::atomic<bool> mStopServerThread = false;
+
+    std::mutex mSetUpMutex;
+    std::condition_variable mSetUpCv;
+    bool mIsSetUp = false;
+    int mDoneClientCount = 0;
+
+    std::mutex mWorkDoneMutex;
+    std::condition_variable mWorkDoneCv;
+};
+
+BENCHMARK_DEFINE_F(WireServerDispatch, Submits)
+(benchmark::State& state) {
+    for (auto _ : state) {
+        SubmitAndWait(state.thread_index());
+    }
+    state.SetItemsProcessed(state.iterations() * kDispatchesPerSubmit);
+}
+BENCHMARK_REGISTER_F(WireServerDispatch, Submits)
+    ->ArgName("server_threads")
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(4)
+    ->Threads(1)
+    ->Threads(4)
+    ->UseRealTime();
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -25,9 +25,14 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <sstream>
 #include <string_view>
 
+#include "dawn/native/DawnNative.h"
 #include "dawn/tests/DawnTest.h"
 #include "dawn/tests/mocks/platform/CachingInterfaceMock.h"
 #include "dawn/utils/ComboRenderPipelineDescriptor.h"
@@ -672,5 +677,120 @@ DAWN_INSTANTIATE_TEST(SinglePipelineCachingTests,
                       OpenGLESBackend(),
                       VulkanBackend());
 
+class MonolithicPipelineCachingTests : public PipelineCachingTests {
+  protected:
+    void SetUp() override {
+        PipelineCachingTests::SetUp();
+        // PerformIdleTasks() is only available with dawn::native.
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+    }
+};
+
+// Tests that the monolithic pipeline cache is only stored in the blob cache when the device is
+// idle, and that it is used by the next devices.
+TEST_P(MonolithicPipelineCachingTests, ComputePipelineStoredOnIdle) {
+    // First time should only write out the monolithic cache in PerformIdleTasks().
+    {
+        wgpu::Device device = CreateDevice();
+        wgpu::ComputePipelineDescriptor desc;
+        desc.compute.module = utils::CreateShaderModule(device, kComputeShaderDefault.data());
+        desc.compute.entryPoint = "main";
+        EXPECT_CACHE_STATS(mMockCache, Hit(0), Add(counts.shaderModule),
+                           device.CreateComputePipeline(&desc));
+        EXPECT_CACHE_STATS(mMockCache, Hit(0), Add(counts.pipeline),
+                           native::PerformIdleTasks(device));
+    }
+
+    // Second time should create using the monolithic cache.
+    {
+        wgpu::Device device = CreateDevice();
+        wgpu::ComputePipelineDescriptor desc;
+        desc.compute.module = utils::CreateShaderModule(device, kComputeShaderDefault.data());
+        desc.compute.entryPoint = "main";
+        EXPECT_CACHE_STATS(mMockCache, Hit(counts.shaderModule + counts.pipeline), Add(0),
+                           device.CreateComputePipeline(&desc));
+    }
+}
+
+// Tests that pipelines compiled concurrently are merged into the monolithic pipeline cache on a
+// worker thread, which stores the cache without waiting for PerformIdleTasks() once enough data
+// was merged into it.
+TEST_P(MonolithicPipelineCachingTests, ConcurrentCompilationsStoredOnWorker) {
+    DAWN_TEST_UNSUPPORTED_IF(!HasToggleEnabled("vulkan_merge_pipeline_caches"));
+
+    // The amount of merged data from which the worker thread stores the monolithic cache.
+    constexpr size_t kMinMergedDataSizeToStore = 256 * 1024;
+    constexpr uint32_t kPipelineCount = 256;
+
+    // The stores are done on worker threads.
+    std::mutex mutex;
+    size_t largeStoreCount = 0;
+    size_t largestStoreSize = 0;
+    EXPECT_CALL(mMockCache, StoreData)
+        .WillRepeatedly([&](const void*, size_t, const void*, size_t valueSize) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (valueSize >= kMinMergedDataSizeToStore) {
+                largeStoreCount++;
+            }
+            largestStoreSize = std::max(largestStoreSize, valueSize);
+        });
+
+    wgpu::Device device = CreateDevice();
+
+    // Each pipeline uses a different shader so that it adds data to the pipeline cache.
+    std::atomic<uint32_t> completedCount = 0;
+    for (uint32_t i = 0; i < kPipelineCount; ++i) {
+        std::ostringstream shader;
+        shader << R"(
+            @group(0) @binding(0) var<storage, read_write> data : array<u32>;
+
+            @compute @workgroup_size(64) fn main(@builtin(global_invocation_id) id : vec3u) {
+                var x = data[id.x];
+                for (var i = 0u; i < )"
+               << (i + 1) << R"(u; i++) {
+                    x = x * 1664525u + 1013904223u;
+                }
+                data[id.x] = x;
+            })";
+
+        wgpu::ComputePipelineDescriptor desc;
+        desc.compute.module = utils::CreateShaderModule(device, shader.str().c_str());
+        device.CreateComputePipelineAsync(
+            &desc, wgpu::CallbackMode::AllowProcessEvents,
+            [&completedCount](wgpu::CreatePipelineAsyncStatus status, wgpu::ComputePipeline,
+                              wgpu::StringView) {
+                EXPECT_EQ(wgpu::CreatePipelineAsyncStatus::Success, status);
+                completedCount++;
+            });
+    }
+    while (completedCount < kPipelineCount) {
+        WaitABit();
+    }
+
+    // The merges run after the compilations on the worker threads, wait for them to store the
+    // cache if enough data was merged.
+    for (uint32_t i = 0; i < 100; ++i) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (largeStoreCount > 0) {
+                break;
+            }
+        }
+        WaitABit();
+    }
+
+    // Storing the remaining data shows whether the pipelines added enough data to the cache for
+    // the worker thread to store it. Some drivers only keep a small amount of data.
+    native::PerformIdleTasks(device);
+    std::lock_guard<std::mutex> lock(mutex);
+    DAWN_TEST_UNSUPPORTED_IF(largestStoreSize < kMinMergedDataSizeToStore);
+    EXPECT_GT(largeStoreCount, 0u);
+}
+
+DAWN_INSTANTIATE_TEST(MonolithicPipelineCachingTests,
+                      VulkanBackend({"vulkan_monolithic_pipeline_cache"}),
+                      VulkanBackend({"vulkan_monolithic_pipeline_cache",
+                                     "vulkan_merge_pipeline_caches"}));
+
 }  // anonymous namespace
 }  // namespace dawn
@@ -209,13 +209,52 @@ TEST_P(RenderBundleTest, BundleAndRenderPassCommands) {
     EXPECT_PIXEL_RGBA8_EQ(kColors[1], renderPass.color, 3, 1);
 }
 
+// Test that a bundle can be executed again in other render passes, including render passes of a
+// different size and in later submits.
+TEST_P(RenderBundleTest, BundleExecutedInSeveralPasses) {
+    utils::ComboRenderBundleEncoderDescriptor desc = {};
+    desc.colorFormatCount = 1;
+    desc.cColorFormats[0] = renderPass.colorFormat;
+
+    wgpu::RenderBundleEncoder renderBundleEncoder = device.CreateRenderBundleEncoder(&desc);
+
+    renderBundleEncoder.SetPipeline(pipeline);
+    renderBundleEncoder.SetVertexBuffer(0, vertexBuffer);
+    renderBundleEncoder.SetBindGroup(0, bindGroups[0]);
+    renderBundleEncoder.Draw(6);
+
+    wgpu::RenderBundle renderBundle = renderBundleEncoder.Finish();
+
+    constexpr uint32_t kLargeRTSize = 2 * kRTSize;
+    utils::BasicRenderPass largeRenderPass =
+        utils::CreateBasicRenderPass(device, kLargeRTSize, kLargeRTSize);
+
+    for (uint32_t i = 0; i < 2; ++i) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        for (const utils::BasicRenderPass* target : {&renderPass, &largeRenderPass, &renderPass}) {
+            wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&target->renderPassInfo);
+            pass.ExecuteBundles(1, &renderBundle);
+            pass.End();
+        }
+
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+
+        EXPECT_PIXEL_RGBA8_EQ(kColors[0], renderPass.color, 1, 3);
+        EXPECT_PIXEL_RGBA8_EQ(kColors[0], renderPass.color, 3, 1);
+        EXPECT_PIXEL_RGBA8_EQ(kColors[0], largeRenderPass.color, 1, kLargeRTSize - 1);
+        EXPECT_PIXEL_RGBA8_EQ(kColors[0], largeRenderPass.color, kLargeRTSize - 1, 1);
+    }
+}
+
 DAWN_INSTANTIATE_TEST(RenderBundleTest,
                       D3D11Backend(),
                       D3D12Backend(),
                       MetalBackend(),
                       OpenGLBackend(),
                       OpenGLESBackend(),
-                      VulkanBackend());
+                      VulkanBackend(),
+                      VulkanBackend({"vulkan_use_secondary_command_buffers_for_render_bundles"}));
 
 }  // anonymous namespace
 }  // namespace dawn
@@ -0,0 +1,161 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+// The number of bind groups created, used and released in each step.
+constexpr uint32_t kNumBindGroups = 1000;
+constexpr uint64_t kUniformSize = 4 * sizeof(float);
+// The uniform buffer binding of each bind group is at a multiple of this offset, which is the
+// largest minUniformBufferOffsetAlignment allowed by the spec.
+constexpr uint64_t kUniformOffsetAlignment = 256;
+
+constexpr char kShader[] = R"(
+        @group(0) @binding(0) var<uniform> params : vec4f;
+        @group(0) @binding(1) var s : sampler;
+        @group(0) @binding(2) var t : texture_2d<f32>;
+
+        @compute @workgroup_size(1) fn main() {
+            _ = params;
+            _ = s;
+            _ = t;
+        })";
+
+enum class BindGroupContents {
+    // All the bind groups of a step bind the same resources.
+    Identical,
+    // Each bind group of a step binds the uniform buffer at a different offset.
+    Unique,
+};
+
+struct BindGroupChurnParams : AdapterTestParam {
+    BindGroupChurnParams(const AdapterTestParam& param, BindGroupContents contentsIn)
+        : AdapterTestParam(param), contents(contentsIn) {}
+    BindGroupContents contents;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const BindGroupChurnParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    switch (param.contents) {
+        case BindGroupContents::Identical:
+            ostream << "_Identical";
+            break;
+        case BindGroupContents::Unique:
+            ostream << "_Unique";
+            break;
+    }
+    return ostream;
+}
+
+// Test the cost of bind groups that are only used once: each step creates many bind groups, uses
+// each of them for a dispatch and releases all of them. Bind groups are either all identical,
+// which backends can share descriptors between, or all different.
+class BindGroupChurnPerf : public DawnPerfTestWithParams<BindGroupChurnParams> {
+  public:
+    BindGroupChurnPerf() : DawnPerfTestWithParams(kNumBindGroups, 1) {}
+    ~BindGroupChurnPerf() override = default;
+
+    bool SupportsCPUAdapters() const override { return true; }
+
+    void SetUp() override {
+        DawnPerfTestWithParams<BindGroupChurnParams>::SetUp();
+
+        mLayout = utils::MakeBindGroupLayout(
+            device, {
+                        {0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Uniform},
+                        {1, wgpu::ShaderStage::Compute, wgpu::SamplerBindingType::Filtering},
+                        {2, wgpu::ShaderStage::Compute, wgpu::TextureSampleType::Float},
+                    });
+
+        wgpu::ComputePipelineDescriptor pipelineDesc;
+        pipelineDesc.layout = utils::MakePipelineLayout(device, {mLayout});
+        pipelineDesc.compute.module = utils::CreateShaderModule(device, kShader);
+        mPipeline = device.CreateComputePipeline(&pipelineDesc);
+
+        wgpu::BufferDescriptor bufferDesc;
+        bufferDesc.size = kUniformOffsetAlignment * (kNumBindGroups - 1) + kUniformSize;
+        bufferDesc.usage = wgpu::BufferUsage::Uniform;
+        mUniformBuffer = device.CreateBuffer(&bufferDesc);
+
+        mSampler = device.CreateSampler();
+
+        wgpu::TextureDescriptor textureDesc;
+        textureDesc.size = {1, 1, 1};
+        textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        textureDesc.usage = wgpu::TextureUsage::TextureBinding;
+        mTextureView = device.CreateTexture(&textureDesc).CreateView();
+    }
+
+  private:
+    void Step() override {
+        const bool unique = GetParam().contents == BindGroupContents::Unique;
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.SetPipeline(mPipeline);
+        for (uint32_t i = 0; i < kNumBindGroups; ++i) {
+            uint64_t offset = unique ? i * kUniformOffsetAlignment : 0;
+            wgpu::BindGroup bindGroup =
+                utils::MakeBindGroup(device, mLayout,
+                                     {
+                                         {0, mUniformBuffer, offset, kUniformSize},
+                                         {1, mSampler},
+                                         {2, mTextureView},
+                                     });
+            pass.SetBindGroup(0, bindGroup);
+            pass.DispatchWorkgroups(1);
+        }
+        pass.End();
+
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    wgpu::BindGroupLayout mLayout;
+    wgpu::ComputePipeline mPipeline;
+    wgpu::Buffer mUniformBuffer;
+    wgpu::Sampler mSampler;
+    wgpu::TextureView mTextureView;
+};
+
+TEST_P(BindGroupChurnPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(BindGroupChurnPerf,
+                        {D3D12Backend(), MetalBackend(), NullBackend(), OpenGLBackend(),
+                         VulkanBackend()},
+                        {BindGroupContents::Identical, BindGroupContents::Unique});
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -0,0 +1,157 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/TestUtils.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+// The total number of command buffers encoded in each step, split evenly between the threads.
+constexpr uint32_t kNumCommandBuffers = 64;
+constexpr uint32_t kNumDrawsPerCommandBuffer = 500;
+
+constexpr uint32_t kTextureSize = 64;
+constexpr size_t kUniformSize = 4 * sizeof(float);
+
+constexpr char kShader[] = R"(
+        @group(0) @binding(0) var<uniform> color : vec4f;
+
+        @vertex fn vs_main(@builtin(vertex_index) i : u32) -> @builtin(position) vec4f {
+            return vec4f(f32(i), 0.0, 0.0, 1.0);
+        }
+
+        @fragment fn fs_main() -> @location(0) vec4f {
+            return color;
+        })";
+
+struct CommandEncodingParams : AdapterTestParam {
+    CommandEncodingParams(const AdapterTestParam& param, uint32_t numThreadsIn)
+        : AdapterTestParam(param), numThreads(numThreadsIn) {}
+    uint32_t numThreads;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const CommandEncodingParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_threads_" << param.numThreads;
+    return ostream;
+}
+
+// Test the throughput of encoding command buffers on several threads at once. The same total
+// number of command buffers is encoded for each thread count, so the time per command buffer
+// shows how encoding scales with the number of threads. The command buffers are submitted on the
+// main thread once all of the threads have finished.
+class CommandEncodingPerf : public DawnPerfTestWithParams<CommandEncodingParams> {
+  public:
+    CommandEncodingPerf() : DawnPerfTestWithParams(kNumCommandBuffers, 1) {}
+    ~CommandEncodingPerf() override = default;
+
+    bool SupportsCPUAdapters() const override { return true; }
+
+    std::vector<wgpu::FeatureName> GetRequiredFeatures() override {
+        std::vector<wgpu::FeatureName> requiredFeatures =
+            DawnPerfTestWithParams::GetRequiredFeatures();
+        // TODO(crbug.com/dawn/1678): DawnWire doesn't support thread safe API yet.
+        if (!UsesWire()) {
+            requiredFeatures.push_back(wgpu::FeatureName::ImplicitDeviceSynchronization);
+        }
+        return requiredFeatures;
+    }
+
+    void SetUp() override {
+        DawnPerfTestWithParams<CommandEncodingParams>::SetUp();
+        // TODO(crbug.com/dawn/1678): DawnWire doesn't support thread safe API yet.
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+        wgpu::TextureDescriptor textureDesc;
+        textureDesc.size = {kTextureSize, kTextureSize, 1};
+        textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        textureDesc.usage = wgpu::TextureUsage::RenderAttachment;
+        mColorAttachment = device.CreateTexture(&textureDesc).CreateView();
+
+        wgpu::ShaderModule module = utils::CreateShaderModule(device, kShader);
+        utils::ComboRenderPipelineDescriptor pipelineDesc;
+        pipelineDesc.vertex.module = module;
+        pipelineDesc.cFragment.module = module;
+        pipelineDesc.cTargets[0].format = textureDesc.format;
+        mPipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+        wgpu::BufferDescriptor bufferDesc;
+        bufferDesc.size = kUniformSize;
+        bufferDesc.usage = wgpu::BufferUsage::Uniform;
+        mUniformBuffer = device.CreateBuffer(&bufferDesc);
+        mBindGroup = utils::MakeBindGroup(device, mPipeline.GetBindGroupLayout(0),
+                                          {{0, mUniformBuffer, 0, kUniformSize}});
+    }
+
+  private:
+    void Step() override {
+        const uint32_t numThreads = GetParam().numThreads;
+        std::vector<wgpu::CommandBuffer> commandBuffers(kNumCommandBuffers);
+
+        utils::RunInParallel(numThreads, [&](uint32_t threadIndex) {
+            for (uint32_t i = threadIndex; i < kNumCommandBuffers; i += numThreads) {
+                commandBuffers[i] = EncodeCommandBuffer();
+            }
+        });
+
+        queue.Submit(commandBuffers.size(), commandBuffers.data());
+    }
+
+    wgpu::CommandBuffer EncodeCommandBuffer() {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        utils::ComboRenderPassDescriptor renderPass({mColorAttachment});
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(mPipeline);
+        for (uint32_t i = 0; i < kNumDrawsPerCommandBuffer; i++) {
+            pass.SetBindGroup(0, mBindGroup);
+            pass.Draw(3);
+        }
+        pass.End();
+        return encoder.Finish();
+    }
+
+    wgpu::TextureView mColorAttachment;
+    wgpu::RenderPipeline mPipeline;
+    wgpu::Buffer mUniformBuffer;
+    wgpu::BindGroup mBindGroup;
+};
+
+TEST_P(CommandEncodingPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(CommandEncodingPerf,
+                        {D3D12Backend(), MetalBackend(), NullBackend(), VulkanBackend()},
+                        {1, 2, 4, 8, 16});
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -0,0 +1,118 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <atomic>
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr char kShader[] = R"(
+        override value : u32;
+        @group(0) @binding(0) var<storage, read_write> result : array<u32>;
+
+        @compute @workgroup_size(64) fn main(@builtin(global_invocation_id) id : vec3u) {
+            result[id.x] = id.x * value;
+        })";
+
+struct CreatePipelineAsyncParams : AdapterTestParam {
+    CreatePipelineAsyncParams(const AdapterTestParam& param, uint32_t numPipelinesIn)
+        : AdapterTestParam(param), numPipelines(numPipelinesIn) {}
+    uint32_t numPipelines;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const CreatePipelineAsyncParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_pipelines_" << param.numPipelines;
+    return ostream;
+}
+
+// Test the latency and throughput of asynchronous pipeline creation, which runs on the device's
+// worker task pool. Each step creates a batch of compute pipelines and waits for all of them to be
+// ready. A batch of one pipeline measures the dispatch latency of the pool while bigger batches
+// show how well the compilations are spread over the workers. Every pipeline uses a different
+// override value so that none of them are found in the pipeline cache.
+class CreatePipelineAsyncPerf : public DawnPerfTestWithParams<CreatePipelineAsyncParams> {
+  public:
+    CreatePipelineAsyncPerf() : DawnPerfTestWithParams(GetParam().numPipelines, 1) {}
+    ~CreatePipelineAsyncPerf() override = default;
+
+    void SetUp() override {
+        DawnPerfTestWithParams<CreatePipelineAsyncParams>::SetUp();
+        mModule = utils::CreateShaderModule(device, kShader);
+    }
+
+  private:
+    void Step() override {
+        const uint32_t numPipelines = GetParam().numPipelines;
+        std::atomic<uint32_t> numCompleted = 0;
+        std::vector<wgpu::ComputePipeline> pipelines(numPipelines);
+
+        for (uint32_t i = 0; i < numPipelines; ++i) {
+            wgpu::ConstantEntry constant;
+            constant.key = "value";
+            constant.value = static_cast<double>(mNextOverrideValue++);
+
+            wgpu::ComputePipelineDescriptor desc;
+            desc.compute.module = mModule;
+            desc.compute.constants = &constant;
+            desc.compute.constantCount = 1;
+
+            device.CreateComputePipelineAsync(
+                &desc, wgpu::CallbackMode::AllowProcessEvents,
+                [&pipelines, &numCompleted, i](wgpu::CreatePipelineAsyncStatus status,
+                                               wgpu::ComputePipeline pipeline, wgpu::StringView) {
+                    EXPECT_EQ(wgpu::CreatePipelineAsyncStatus::Success, status);
+                    pipelines[i] = std::move(pipeline);
+                    numCompleted++;
+                });
+        }
+
+        while (numCompleted.load() < numPipelines) {
+            instance.ProcessEvents();
+            FlushWire();
+        }
+    }
+
+    wgpu::ShaderModule mModule;
+    uint32_t mNextOverrideValue = 0;
+};
+
+TEST_P(CreatePipelineAsyncPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(CreatePipelineAsyncPerf,
+                        {D3D12Backend(), MetalBackend(), NullBackend(), OpenGLBackend(),
+                         OpenGLESBackend(), VulkanBackend()},
+                        {1, 16, 64});
+
+}  // anonymous namespace
+}  // namespace dawn
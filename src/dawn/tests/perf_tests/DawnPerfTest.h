@@ -141,7 +141,8 @@ class DawnPerfTestWithParams : public DawnTestWithParams<Params>, public DawnPer
 
         wgpu::AdapterInfo info;
         this->GetAdapter().GetInfo(&info);
-        DAWN_TEST_UNSUPPORTED_IF(info.adapterType == wgpu::AdapterType::CPU);
+        DAWN_TEST_UNSUPPORTED_IF(info.adapterType == wgpu::AdapterType::CPU &&
+                                 !SupportsCPUAdapters());
 
         if (mSupportsTimestampQuery) {
             InitializeGPUTimer();
@@ -149,6 +150,10 @@ class DawnPerfTestWithParams : public DawnTestWithParams<Params>, public DawnPer
     }
     ~DawnPerfTestWithParams() override = default;
 
+    // CPU adapters are skipped unless the test measures costs that are mostly on the CPU, like
+    // the frontend on the Null backend or the Vulkan backend on SwiftShader.
+    virtual bool SupportsCPUAdapters() const { return false; }
+
     std::vector<wgpu::FeatureName> GetRequiredFeatures() override {
         std::vector<wgpu::FeatureName> requiredFeatures = {wgpu::FeatureName::TimestampQuery};
         mSupportsTimestampQuery = DawnTestWithParams<Params>::SupportsFeatures(requiredFeatures);
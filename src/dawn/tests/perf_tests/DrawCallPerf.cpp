@@ -39,6 +39,8 @@ namespace dawn {
 namespace {
 
 constexpr unsigned int kNumDraws = 2000;
+// The number of bind groups that BindGroup::Alternating cycles through.
+constexpr unsigned int kNumAlternatingBindGroups = 4;
 
 constexpr uint32_t kTextureSize = 64;
 constexpr size_t kUniformSize = 3 * sizeof(float);
@@ -83,8 +85,9 @@ enum class BindGroup {
     NoChange,   // Use one bind group for all draws.
     Redundant,  // Use the same bind group, but redundantly set it.
     NoReuse,    // Create a new bind group every time.
-    Multiple,   // Use multiple static bind groups.
-    Dynamic,    // Use bind groups with dynamic offsets.
+    Multiple,     // Use multiple static bind groups.
+    Alternating,  // Cycle through a few static bind groups.
+    Dynamic,      // Use bind groups with dynamic offsets.
 };
 
 enum class VertexBuffer {
@@ -184,6 +187,9 @@ std::ostream& operator<<(std::ostream& ostream, const DrawCallParamForTest& test
         case BindGroup::Multiple:
             ostream << "_MultipleBindGroups";
             break;
+        case BindGroup::Alternating:
+            ostream << "_AlternatingBindGroups";
+            break;
         case BindGroup::Dynamic:
             ostream << "_DynamicBindGroup";
             break;
@@ -216,6 +222,8 @@ std::ostream& operator<<(std::ostream& ostream, const DrawCallParamForTest& test
 //   - Static/Multiple/Dynamic vertex buffers: Tests switching buffer bindings. This has
 //     a state tracking cost as well as a GPU driver cost.
 //   - Static/Multiple/Dynamic bind groups: Same rationale as vertex buffers
+//   - Alternating bind groups: Re-binding groups already used in the pass only costs the
+//     state tracking and not the resource usage tracking.
 //   - Static/Dynamic pipelines: In addition to a change to GPU state, changing the pipeline
 //     layout incurs additional state tracking costs in Dawn.
 //   - With/Without render bundles: All of the above can have lower validation costs if
@@ -326,6 +334,7 @@ void DrawCallPerf::SetUp() {
         case BindGroup::Redundant:
         case BindGroup::NoReuse:
         case BindGroup::Multiple:
+        case BindGroup::Alternating:
             mUniformBindGroupLayout = utils::MakeBindGroupLayout(
                 device,
                 {
@@ -437,6 +446,17 @@ void DrawCallPerf::SetUp() {
             }
             break;
 
+        case BindGroup::Alternating:
+            for (uint32_t i = 0; i < kNumAlternatingBindGroups; ++i) {
+                mUniformBuffers[i] = utils::CreateBufferFromData(
+                    device, mUniformBufferData.data() + i * mNumUniformFloats, 3 * sizeof(float),
+                    wgpu::BufferUsage::Uniform);
+
+                mUniformBindGroups[i] = utils::MakeBindGroup(
+                    device, mUniformBindGroupLayout, {{0, mUniformBuffers[i], 0, kUniformSize}});
+            }
+            break;
+
         case BindGroup::Dynamic:
             mUniformBuffers[0] = utils::CreateBufferFromData(
                 device, mUniformBufferData.data(), mUniformBufferData.size() * sizeof(float),
@@ -540,6 +560,11 @@ void DrawCallPerf::RecordRenderCommands(Encoder pass) {
                 pass.SetBindGroup(uniformBindGroupIndex, mUniformBindGroups[i]);
                 break;
 
+            case BindGroup::Alternating:
+                pass.SetBindGroup(uniformBindGroupIndex,
+                                  mUniformBindGroups[i % kNumAlternatingBindGroups]);
+                break;
+
             case BindGroup::Dynamic: {
                 uint32_t dynamicOffset = static_cast<uint32_t>(i * mAlignedUniformSize);
                 pass.SetBindGroup(uniformBindGroupIndex, mUniformBindGroups[0], 1, &dynamicOffset);
@@ -574,6 +599,13 @@ void DrawCallPerf::Step() {
                                       3 * sizeof(float));
                 }
                 break;
+            case BindGroup::Alternating:
+                for (uint32_t i = 0; i < kNumAlternatingBindGroups; ++i) {
+                    queue.WriteBuffer(mUniformBuffers[i], 0,
+                                      mUniformBufferData.data() + i * mNumUniformFloats,
+                                      3 * sizeof(float));
+                }
+                break;
             case BindGroup::Dynamic:
                 queue.WriteBuffer(mUniformBuffers[0], 0, mUniformBufferData.data(),
                                   mUniformBufferData.size() * sizeof(float));
@@ -619,9 +651,10 @@ DAWN_INSTANTIATE_TEST_P(
         MakeParam(VertexBuffer::Dynamic),   // Dynamic vertex buffer
 
         // Change bind group binding
-        MakeParam(BindGroup::Multiple),  // Multiple bind groups
-        MakeParam(BindGroup::Dynamic),   // Dynamic bind groups
-        MakeParam(BindGroup::NoReuse),   // New bind group per-draw
+        MakeParam(BindGroup::Multiple),     // Multiple bind groups
+        MakeParam(BindGroup::Alternating),  // Re-bind a few bind groups
+        MakeParam(BindGroup::Dynamic),      // Dynamic bind groups
+        MakeParam(BindGroup::NoReuse),      // New bind group per-draw
 
         // Redundantly set pipeline / bind groups
         MakeParam(Pipeline::Redundant, BindGroup::Redundant),
@@ -629,6 +662,8 @@ DAWN_INSTANTIATE_TEST_P(
         // Switch the pipeline every draw to test state tracking and updates to binding points
         MakeParam(Pipeline::Dynamic,
                   BindGroup::Multiple),  // Multiple bind groups w/ dynamic pipeline
+        MakeParam(Pipeline::Dynamic,
+                  BindGroup::Alternating),  // Re-bind a few bind groups w/ dynamic pipeline
         MakeParam(Pipeline::Dynamic,
                   BindGroup::Dynamic),  // Dynamic bind groups w/ dynamic pipeline
 
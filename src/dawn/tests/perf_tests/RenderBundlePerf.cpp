@@ -0,0 +1,188 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/ComboRenderBundleEncoderDescriptor.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+// The number of render passes encoded and submitted in each step.
+constexpr uint32_t kNumPasses = 16;
+constexpr uint32_t kNumBundles = 4;
+constexpr uint32_t kNumDrawsPerBundle = 256;
+
+constexpr uint32_t kTextureSize = 64;
+constexpr size_t kUniformSize = 4 * sizeof(float);
+
+constexpr char kShader[] = R"(
+        @group(0) @binding(0) var<uniform> color : vec4f;
+
+        @vertex fn vs_main(@builtin(vertex_index) i : u32) -> @builtin(position) vec4f {
+            return vec4f(f32(i), 0.0, 0.0, 1.0);
+        }
+
+        @fragment fn fs_main() -> @location(0) vec4f {
+            return color;
+        })";
+
+enum class EncodingMode {
+    Direct,
+    RenderBundle,
+};
+
+std::ostream& operator<<(std::ostream& ostream, const EncodingMode& mode) {
+    switch (mode) {
+        case EncodingMode::Direct:
+            ostream << "Direct";
+            break;
+        case EncodingMode::RenderBundle:
+            ostream << "RenderBundle";
+            break;
+    }
+    return ostream;
+}
+
+struct RenderBundleParams : AdapterTestParam {
+    RenderBundleParams(const AdapterTestParam& param, EncodingMode modeIn)
+        : AdapterTestParam(param), mode(modeIn) {}
+    EncodingMode mode;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const RenderBundleParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_" << param.mode;
+    return ostream;
+}
+
+// Test the CPU cost of encoding and submitting render passes that draw the same commands every
+// frame, either encoded directly in the pass or executed from render bundles created once. On
+// Vulkan the commands of the bundles are replayed in every pass, unless
+// vulkan_use_secondary_command_buffers_for_render_bundles is enabled, in which case the bundles
+// are recorded once in secondary command buffers.
+class RenderBundlePerf : public DawnPerfTestWithParams<RenderBundleParams> {
+  public:
+    RenderBundlePerf() : DawnPerfTestWithParams(kNumPasses, 1) {}
+    ~RenderBundlePerf() override = default;
+
+    bool SupportsCPUAdapters() const override { return true; }
+
+    void SetUp() override {
+        DawnPerfTestWithParams<RenderBundleParams>::SetUp();
+
+        wgpu::TextureDescriptor textureDesc;
+        textureDesc.size = {kTextureSize, kTextureSize, 1};
+        textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        textureDesc.usage = wgpu::TextureUsage::RenderAttachment;
+        mColorAttachment = device.CreateTexture(&textureDesc).CreateView();
+
+        wgpu::ShaderModule module = utils::CreateShaderModule(device, kShader);
+        utils::ComboRenderPipelineDescriptor pipelineDesc;
+        pipelineDesc.vertex.module = module;
+        pipelineDesc.cFragment.module = module;
+        pipelineDesc.cTargets[0].format = textureDesc.format;
+        mPipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+        wgpu::BufferDescriptor bufferDesc;
+        bufferDesc.size = kUniformSize;
+        bufferDesc.usage = wgpu::BufferUsage::Uniform;
+        mUniformBuffer = device.CreateBuffer(&bufferDesc);
+        mBindGroup = utils::MakeBindGroup(device, mPipeline.GetBindGroupLayout(0),
+                                          {{0, mUniformBuffer, 0, kUniformSize}});
+
+        if (GetParam().mode == EncodingMode::RenderBundle) {
+            utils::ComboRenderBundleEncoderDescriptor bundleEncoderDesc;
+            bundleEncoderDesc.colorFormatCount = 1;
+            bundleEncoderDesc.cColorFormats[0] = textureDesc.format;
+
+            for (uint32_t i = 0; i < kNumBundles; ++i) {
+                wgpu::RenderBundleEncoder encoder =
+                    device.CreateRenderBundleEncoder(&bundleEncoderDesc);
+                EncodeDraws(encoder);
+                mBundles.push_back(encoder.Finish());
+            }
+        }
+    }
+
+  private:
+    template <typename Encoder>
+    void EncodeDraws(Encoder encoder) {
+        encoder.SetPipeline(mPipeline);
+        for (uint32_t i = 0; i < kNumDrawsPerBundle; ++i) {
+            encoder.SetBindGroup(0, mBindGroup);
+            encoder.Draw(3);
+        }
+    }
+
+    void Step() override {
+        std::vector<wgpu::CommandBuffer> commandBuffers;
+        commandBuffers.reserve(kNumPasses);
+
+        for (uint32_t i = 0; i < kNumPasses; ++i) {
+            wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+            utils::ComboRenderPassDescriptor renderPass({mColorAttachment});
+            wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+            switch (GetParam().mode) {
+                case EncodingMode::Direct:
+                    for (uint32_t j = 0; j < kNumBundles; ++j) {
+                        EncodeDraws(pass);
+                    }
+                    break;
+                case EncodingMode::RenderBundle:
+                    pass.ExecuteBundles(mBundles.size(), mBundles.data());
+                    break;
+            }
+            pass.End();
+            commandBuffers.push_back(encoder.Finish());
+        }
+
+        queue.Submit(commandBuffers.size(), commandBuffers.data());
+    }
+
+    wgpu::TextureView mColorAttachment;
+    wgpu::RenderPipeline mPipeline;
+    wgpu::Buffer mUniformBuffer;
+    wgpu::BindGroup mBindGroup;
+    std::vector<wgpu::RenderBundle> mBundles;
+};
+
+TEST_P(RenderBundlePerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(
+    RenderBundlePerf,
+    {D3D12Backend(), MetalBackend(), NullBackend(), VulkanBackend(),
+     VulkanBackend({"vulkan_use_secondary_command_buffers_for_render_bundles"})},
+    {EncodingMode::Direct, EncodingMode::RenderBundle});
+
+}  // anonymous namespace
+}  // namespace dawn
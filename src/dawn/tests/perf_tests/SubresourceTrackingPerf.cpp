@@ -25,6 +25,8 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <vector>
+
 #include "dawn/tests/perf_tests/DawnPerfTest.h"
 
 #include "dawn/utils/ComboRenderPipelineDescriptor.h"
@@ -164,5 +166,122 @@ DAWN_INSTANTIATE_TEST_P(SubresourceTrackingPerf,
                         {1, 4, 16, 256},
                         {2, 3, 8});
 
+struct BindGroupTrackingParams : AdapterTestParam {
+    BindGroupTrackingParams(const AdapterTestParam& param, uint32_t bindGroupCountIn)
+        : AdapterTestParam(param), bindGroupCount(bindGroupCountIn) {}
+    uint32_t bindGroupCount;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const BindGroupTrackingParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_bindGroups_" << param.bindGroupCount;
+    return ostream;
+}
+
+// Test the performance of tracking the usage of resources in bind groups in a render pass with many
+// draws. Each draw sets a bind group with several views of single layers of an array texture and
+// a uniform buffer, cycling through the given number of bind groups. With few bind groups this
+// measures the cost of re-binding groups already used in the pass, and with many it measures the
+// cost of merging the usages of new resources into the pass.
+class BindGroupTrackingPerf : public DawnPerfTestWithParams<BindGroupTrackingParams> {
+  public:
+    static constexpr unsigned int kNumDraws = 1000;
+    static constexpr uint32_t kViewsPerBindGroup = 4;
+    static constexpr uint32_t kArrayLayerCount = 64;
+
+    BindGroupTrackingPerf() : DawnPerfTestWithParams(kNumDraws, 1) {}
+    ~BindGroupTrackingPerf() override = default;
+
+    void SetUp() override {
+        DawnPerfTestWithParams<BindGroupTrackingParams>::SetUp();
+
+        wgpu::TextureDescriptor colorDesc;
+        colorDesc.size = {4, 4, 1};
+        colorDesc.usage = wgpu::TextureUsage::RenderAttachment;
+        colorDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        mColorAttachment = device.CreateTexture(&colorDesc).CreateView();
+
+        wgpu::TextureDescriptor materialDesc;
+        materialDesc.size = {4, 4, kArrayLayerCount};
+        materialDesc.usage = wgpu::TextureUsage::TextureBinding;
+        materialDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        wgpu::Texture materials = device.CreateTexture(&materialDesc);
+
+        utils::ComboRenderPipelineDescriptor pipelineDesc;
+        pipelineDesc.vertex.module = utils::CreateShaderModule(device, R"(
+            @vertex fn main() -> @builtin(position) vec4f {
+                return vec4f(1.0, 0.0, 0.0, 1.0);
+            }
+        )");
+        pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+            @group(0) @binding(0) var<uniform> color : vec4f;
+            @group(0) @binding(1) var material0 : texture_2d<f32>;
+            @group(0) @binding(2) var material1 : texture_2d<f32>;
+            @group(0) @binding(3) var material2 : texture_2d<f32>;
+            @group(0) @binding(4) var material3 : texture_2d<f32>;
+            @fragment fn main() -> @location(0) vec4f {
+                _ = material0;
+                _ = material1;
+                _ = material2;
+                _ = material3;
+                return color;
+            }
+        )");
+        mPipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+        wgpu::BufferDescriptor bufferDesc;
+        bufferDesc.size = 4 * sizeof(float);
+        bufferDesc.usage = wgpu::BufferUsage::Uniform;
+
+        const uint32_t bindGroupCount = GetParam().bindGroupCount;
+        for (uint32_t i = 0; i < bindGroupCount; ++i) {
+            std::vector<wgpu::TextureView> views;
+            for (uint32_t j = 0; j < kViewsPerBindGroup; ++j) {
+                wgpu::TextureViewDescriptor viewDesc;
+                viewDesc.dimension = wgpu::TextureViewDimension::e2D;
+                viewDesc.baseArrayLayer = (i * kViewsPerBindGroup + j) % kArrayLayerCount;
+                viewDesc.arrayLayerCount = 1;
+                views.push_back(materials.CreateView(&viewDesc));
+            }
+
+            mBindGroups.push_back(utils::MakeBindGroup(device, mPipeline.GetBindGroupLayout(0),
+                                                       {{0, device.CreateBuffer(&bufferDesc)},
+                                                        {1, views[0]},
+                                                        {2, views[1]},
+                                                        {3, views[2]},
+                                                        {4, views[3]}}));
+        }
+    }
+
+  private:
+    void Step() override {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        utils::ComboRenderPassDescriptor renderPass({mColorAttachment});
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(mPipeline);
+        for (unsigned int i = 0; i < kNumDraws; ++i) {
+            pass.SetBindGroup(0, mBindGroups[i % mBindGroups.size()]);
+            pass.Draw(3);
+        }
+        pass.End();
+
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    wgpu::TextureView mColorAttachment;
+    wgpu::RenderPipeline mPipeline;
+    std::vector<wgpu::BindGroup> mBindGroups;
+};
+
+TEST_P(BindGroupTrackingPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(BindGroupTrackingPerf,
+                        {D3D12Backend(), MetalBackend(), NullBackend(), OpenGLBackend(),
+                         VulkanBackend()},
+                        {1, 16, 256});
+
 }  // anonymous namespace
 }  // namespace dawn
@@ -29,15 +29,21 @@
 // AsyncTaskTests:
 //     Simple tests for native::AsyncTask and native::AsnycTaskManager.
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "dawn/common/NonCopyable.h"
 #include "dawn/native/AsyncTask.h"
 #include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/WorkerThread.h"
 #include "gtest/gtest.h"
 
 namespace dawn {
@@ -75,6 +81,61 @@ void DoTask(ConcurrentTaskResultQueue* resultQueue, uint32_t id) {
     resultQueue->AddResult(std::move(result));
 }
 
+// A task that posts the next task to the same pool and waits for it before recording its id.
+struct NestedTask {
+    platform::AsyncWorkerThreadPool* pool;
+    ConcurrentTaskResultQueue* resultQueue;
+    uint32_t id;
+    NestedTask* next;
+    platform::WorkerTaskPriority nextPriority = platform::WorkerTaskPriority::High;
+};
+
+void RunNestedTask(void* userdata) {
+    NestedTask* task = static_cast<NestedTask*>(userdata);
+    if (task->next != nullptr) {
+        task->pool->PostWorkerTaskWithPriority(RunNestedTask, task->next, task->nextPriority)
+            ->Wait();
+    }
+    DoTask(task->resultQueue, task->id);
+}
+
+// A WorkerTaskPool that only runs the tasks when asked to, so that tests control which tasks have
+// started when they are cancelled.
+class ManualWorkerTaskPool : public platform::WorkerTaskPool {
+  public:
+    class Event : public platform::WaitableEvent {
+      public:
+        explicit Event(std::shared_ptr<bool> isComplete) : mIsComplete(std::move(isComplete)) {}
+        void Wait() override { EXPECT_TRUE(*mIsComplete); }
+        bool IsComplete() override { return *mIsComplete; }
+
+      private:
+        std::shared_ptr<bool> mIsComplete;
+    };
+
+    std::unique_ptr<platform::WaitableEvent> PostWorkerTask(
+        platform::PostWorkerTaskCallback callback,
+        void* userdata) override {
+        mTasks.push_back({callback, userdata, std::make_shared<bool>(false)});
+        return std::make_unique<Event>(mTasks.back().isComplete);
+    }
+
+    size_t GetTaskCount() const { return mTasks.size(); }
+
+    void RunTask(size_t index) {
+        mTasks[index].callback(mTasks[index].userdata);
+        *mTasks[index].isComplete = true;
+    }
+
+  private:
+    struct Task {
+        platform::PostWorkerTaskCallback callback;
+        void* userdata;
+        std::shared_ptr<bool> isComplete;
+    };
+    std::vector<Task> mTasks;
+};
+
 class AsyncTaskTest : public testing::Test {};
 
 // Emulate the basic usage of worker thread pool in Create*PipelineAsync().
@@ -103,5 +164,228 @@ TEST_F(AsyncTaskTest, Basic) {
     ASSERT_TRUE(idset.empty());
 }
 
+// Test that many tasks of mixed priorities all run on the worker task pool.
+TEST_F(AsyncTaskTest, ManyTasksWithMixedPriorities) {
+    platform::Platform platform;
+    std::unique_ptr<platform::WorkerTaskPool> pool = platform.CreateWorkerTaskPool();
+
+    native::AsyncTaskManager taskManager(pool.get());
+    ConcurrentTaskResultQueue taskResultQueue;
+
+    constexpr uint32_t kTaskCount = 1000u;
+    for (uint32_t i = 0; i < kTaskCount; ++i) {
+        platform::WorkerTaskPriority priority =
+            i % 2 == 0 ? platform::WorkerTaskPriority::High : platform::WorkerTaskPriority::Low;
+        taskManager.PostTask([&taskResultQueue, i] { DoTask(&taskResultQueue, i); }, {},
+                             priority);
+    }
+
+    taskManager.WaitAllPendingTasks();
+    EXPECT_FALSE(taskManager.HasPendingTasks());
+
+    std::vector<std::unique_ptr<SimpleTaskResult>> results = taskResultQueue.GetAllResults();
+    ASSERT_EQ(kTaskCount, results.size());
+    std::set<uint32_t> idset;
+    for (std::unique_ptr<SimpleTaskResult>& result : results) {
+        idset.insert(result->id);
+    }
+    EXPECT_EQ(kTaskCount, idset.size());
+}
+
+// Test that a worker runs the queued High priority tasks before the Low priority ones, each in the
+// order they were posted. A single worker is kept busy while the tasks are posted so that they
+// are all queued when it looks for the next task.
+TEST_F(AsyncTaskTest, HighPriorityTasksRunBeforeLowPriorityTasks) {
+    platform::AsyncWorkerThreadPool pool(1);
+    native::AsyncTaskManager taskManager(&pool);
+    ConcurrentTaskResultQueue taskResultQueue;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool gateStarted = false;
+    bool gateReleased = false;
+    taskManager.PostTask(
+        [&] {
+            std::unique_lock<std::mutex> lock(mutex);
+            gateStarted = true;
+            condition.notify_all();
+            condition.wait(lock, [&] { return gateReleased; });
+        },
+        {}, platform::WorkerTaskPriority::High);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return gateStarted; });
+    }
+
+    constexpr uint32_t kTaskCount = 100u;
+    for (uint32_t i = 0; i < kTaskCount; ++i) {
+        platform::WorkerTaskPriority priority =
+            i % 2 == 0 ? platform::WorkerTaskPriority::High : platform::WorkerTaskPriority::Low;
+        taskManager.PostTask([&taskResultQueue, i] { DoTask(&taskResultQueue, i); }, {},
+                             priority);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        gateReleased = true;
+    }
+    condition.notify_all();
+    taskManager.WaitAllPendingTasks();
+
+    // The even ids were posted with High priority and the odd ones with Low priority.
+    std::vector<std::unique_ptr<SimpleTaskResult>> results = taskResultQueue.GetAllResults();
+    ASSERT_EQ(kTaskCount, results.size());
+    for (uint32_t i = 0; i < kTaskCount / 2; ++i) {
+        EXPECT_EQ(2 * i, results[i]->id);
+        EXPECT_EQ(2 * i + 1, results[kTaskCount / 2 + i]->id);
+    }
+}
+
+// Test that tasks can wait on tasks they posted to the same pool when every worker is busy: the
+// waiting worker runs the queued tasks itself instead of deadlocking.
+TEST_F(AsyncTaskTest, WorkerWaitsOnQueuedTask) {
+    platform::AsyncWorkerThreadPool pool(1);
+    ConcurrentTaskResultQueue taskResultQueue;
+
+    constexpr uint32_t kDepth = 3;
+    std::array<NestedTask, kDepth> tasks;
+    for (uint32_t i = 0; i < kDepth; ++i) {
+        tasks[i] = {&pool, &taskResultQueue, i, i + 1 < kDepth ? &tasks[i + 1] : nullptr};
+    }
+    pool.PostWorkerTask(RunNestedTask, &tasks[0])->Wait();
+
+    // The innermost task completes first.
+    std::vector<std::unique_ptr<SimpleTaskResult>> results = taskResultQueue.GetAllResults();
+    ASSERT_EQ(kDepth, results.size());
+    for (uint32_t i = 0; i < kDepth; ++i) {
+        EXPECT_EQ(kDepth - 1 - i, results[i]->id);
+    }
+    EXPECT_EQ(1u, pool.GetThreadCount());
+}
+
+// Test that a task can wait on a Low priority task it posted while High priority tasks are queued
+// in front of it: the waiting worker runs the awaited task itself, not the next queued one. This
+// is what keeps a task that waits on a queued Vulkan pipeline cache merge from blocking a worker.
+TEST_F(AsyncTaskTest, WorkerWaitsOnQueuedLowPriorityTask) {
+    platform::AsyncWorkerThreadPool pool(1);
+    native::AsyncTaskManager taskManager(&pool);
+    ConcurrentTaskResultQueue taskResultQueue;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool gateStarted = false;
+    bool gateReleased = false;
+
+    constexpr uint32_t kHighPriorityTaskCount = 4;
+    NestedTask merge = {&pool, &taskResultQueue, kHighPriorityTaskCount + 1, nullptr};
+    NestedTask compile = {&pool, &taskResultQueue, kHighPriorityTaskCount, &merge,
+                          platform::WorkerTaskPriority::Low};
+
+    // Keep the single worker busy until the nested task and the High priority tasks are queued.
+    taskManager.PostTask([&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        gateStarted = true;
+        condition.notify_all();
+        condition.wait(lock, [&] { return gateReleased; });
+    });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return gateStarted; });
+    }
+    taskManager.PostTask([&] { RunNestedTask(&compile); });
+    for (uint32_t i = 0; i < kHighPriorityTaskCount; ++i) {
+        taskManager.PostTask([&taskResultQueue, i] { DoTask(&taskResultQueue, i); });
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        gateReleased = true;
+    }
+    condition.notify_all();
+    taskManager.WaitAllPendingTasks();
+
+    // The nested task ran inline before the High priority tasks queued after its parent.
+    std::vector<std::unique_ptr<SimpleTaskResult>> results = taskResultQueue.GetAllResults();
+    ASSERT_EQ(kHighPriorityTaskCount + 2, results.size());
+    EXPECT_EQ(kHighPriorityTaskCount + 1, results[0]->id);
+    EXPECT_EQ(kHighPriorityTaskCount, results[1]->id);
+    for (uint32_t i = 0; i < kHighPriorityTaskCount; ++i) {
+        EXPECT_EQ(i, results[i + 2]->id);
+    }
+}
+
+// Test that shutting down while a worker is running a task that posted a Low priority task only
+// waits for the running task. The Low priority task is either cancelled while it is queued or run
+// to completion, exactly once, like the Vulkan pipeline cache merge task on device destruction.
+TEST_F(AsyncTaskTest, CancelWhileTaskPostedByTaskIsQueued) {
+    for (uint32_t iteration = 0; iteration < 20; ++iteration) {
+        platform::AsyncWorkerThreadPool pool(1);
+        native::AsyncTaskManager taskManager(&pool);
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool compileStarted = false;
+        bool compileReleased = false;
+        std::atomic<uint32_t> mergeRan = 0;
+        std::atomic<uint32_t> mergeCancelled = 0;
+
+        taskManager.PostTask([&] {
+            taskManager.PostTask([&] { mergeRan++; }, [&] { mergeCancelled++; },
+                                 platform::WorkerTaskPriority::Low);
+            std::unique_lock<std::mutex> lock(mutex);
+            compileStarted = true;
+            condition.notify_all();
+            condition.wait(lock, [&] { return compileReleased; });
+        });
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&] { return compileStarted; });
+        }
+
+        std::thread releaseThread([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            compileReleased = true;
+            condition.notify_all();
+        });
+        taskManager.CancelAndWaitAllPendingTasks();
+        releaseThread.join();
+
+        EXPECT_FALSE(taskManager.HasPendingTasks());
+        EXPECT_EQ(1u, mergeRan + mergeCancelled);
+    }
+}
+
+// Test that cancelling runs the cancel callback of the tasks that didn't start instead of their
+// body, and that the worker pool can still run the cancelled tasks afterwards.
+TEST_F(AsyncTaskTest, CancelPendingTasks) {
+    ManualWorkerTaskPool pool;
+    std::vector<uint32_t> ran;
+    std::vector<uint32_t> cancelled;
+
+    {
+        native::AsyncTaskManager taskManager(&pool);
+        for (uint32_t i = 0; i < 3; ++i) {
+            taskManager.PostTask([&ran, i] { ran.push_back(i); },
+                                 [&cancelled, i] { cancelled.push_back(i); });
+        }
+        ASSERT_EQ(3u, pool.GetTaskCount());
+
+        pool.RunTask(1);
+        EXPECT_EQ(std::vector<uint32_t>({1}), ran);
+
+        taskManager.CancelAndWaitAllPendingTasks();
+        EXPECT_FALSE(taskManager.HasPendingTasks());
+        EXPECT_EQ(std::vector<uint32_t>({1}), ran);
+        std::sort(cancelled.begin(), cancelled.end());
+        EXPECT_EQ(std::vector<uint32_t>({0, 2}), cancelled);
+    }
+
+    // The cancelled tasks are skipped even though the task manager is gone.
+    pool.RunTask(0);
+    pool.RunTask(2);
+    EXPECT_EQ(std::vector<uint32_t>({1}), ran);
+    EXPECT_EQ(2u, cancelled.size());
+}
+
 }  // anonymous namespace
 }  // namespace dawn
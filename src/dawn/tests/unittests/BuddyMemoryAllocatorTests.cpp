@@ -411,14 +411,14 @@ TEST(BuddyMemoryAllocatorTests, ReuseFreedHeaps) {
         allocations.push_back(std::move(allocation));
     }
 
-    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), 0u);
+    ASSERT_EQ(poolAllocator.GetPoolSize(), 0u);
 
     // Return the allocations to the pool.
     for (ResourceMemoryAllocation& allocation : allocations) {
         allocator.Deallocate(allocation);
     }
 
-    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), heaps.size());
+    ASSERT_EQ(poolAllocator.GetPoolSize(), heaps.size());
 
     // Allocate again reusing the same heaps.
     for (uint32_t i = 0; i < kNumOfAllocations; i++) {
@@ -427,7 +427,7 @@ TEST(BuddyMemoryAllocatorTests, ReuseFreedHeaps) {
         ASSERT_FALSE(heaps.insert(allocation.GetResourceHeap()).second);
     }
 
-    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), 0u);
+    ASSERT_EQ(poolAllocator.GetPoolSize(), 0u);
 }
 
 // Verify resource heaps that were reused from a pool can be destroyed.
@@ -454,18 +454,75 @@ TEST(BuddyMemoryAllocatorTests, DestroyHeaps) {
         allocations.push_back(std::move(allocation));
     }
 
-    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), 0u);
+    ASSERT_EQ(poolAllocator.GetPoolSize(), 0u);
 
     // Return the allocations to the pool.
     for (ResourceMemoryAllocation& allocation : allocations) {
         allocator.Deallocate(allocation);
     }
 
-    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), kNumOfHeaps);
+    ASSERT_EQ(poolAllocator.GetPoolSize(), kNumOfHeaps);
 
     // Make sure we can destroy the remaining heaps.
     poolAllocator.DestroyPool();
-    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), 0u);
+    ASSERT_EQ(poolAllocator.GetPoolSize(), 0u);
+}
+
+// Verify the size sub-allocated in each heap is tracked to find the sparse heaps.
+TEST(BuddyMemoryAllocatorTests, HeapUsedSize) {
+    // After two 32 byte and one 128 byte resource allocations.
+    //
+    // max block size -> -------------------------------------------------------
+    //                   |                                                     |
+    //                   -------------------------------------------------------
+    //                   |                         |                           |
+    // max heap size  -> -------------------------------------------------------
+    //                   |     H0     |     H1     |                           |
+    //                   -------------------------------------------------------
+    //                   | A1 | A2 |  |     A3     |                           |
+    //                   -------------------------------------------------------
+    //
+    constexpr uint64_t kHeapSize = 128;
+    constexpr uint64_t kMaxBlockSize = 512;
+
+    PlaceholderResourceHeapAllocator heapAllocator;
+    BuddyMemoryAllocator allocator(kMaxBlockSize, kHeapSize, &heapAllocator);
+
+    ResourceMemoryAllocation allocation1 = allocator.Allocate(32, 1).AcquireSuccess();
+    // The size of the block is rounded up to a power of two.
+    ResourceMemoryAllocation allocation2 = allocator.Allocate(20, 1).AcquireSuccess();
+    ResourceMemoryAllocation allocation3 = allocator.Allocate(128, 1).AcquireSuccess();
+    ASSERT_EQ(allocation1.GetResourceHeap(), allocation2.GetResourceHeap());
+    ASSERT_NE(allocation1.GetResourceHeap(), allocation3.GetResourceHeap());
+
+    EXPECT_EQ(allocator.GetHeapCount(), 2u);
+    EXPECT_EQ(allocator.GetUsedSize(), 192u);
+    EXPECT_EQ(allocator.GetHeapUsedSize(allocation1), 64u);
+    EXPECT_EQ(allocator.GetHeapUsedSize(allocation3), 128u);
+    EXPECT_EQ(allocator.GetHeapSubAllocationCount(allocation1), 2u);
+    EXPECT_EQ(allocator.GetHeapSubAllocationCount(allocation3), 1u);
+    EXPECT_EQ(allocator.ComputeSparseHeapCount(32), 0u);
+    EXPECT_EQ(allocator.ComputeSparseHeapCount(64), 1u);
+    EXPECT_EQ(allocator.ComputeSparseHeapCount(128), 2u);
+    EXPECT_EQ(allocator.GetSparseHeaps(64),
+              std::vector<const ResourceHeapBase*>{allocation1.GetResourceHeap()});
+
+    allocator.Deallocate(allocation2);
+    EXPECT_EQ(allocator.GetHeapCount(), 2u);
+    EXPECT_EQ(allocator.GetUsedSize(), 160u);
+    EXPECT_EQ(allocator.GetHeapUsedSize(allocation1), 32u);
+    EXPECT_EQ(allocator.GetHeapSubAllocationCount(allocation1), 1u);
+    EXPECT_EQ(allocator.ComputeSparseHeapCount(32), 1u);
+
+    allocator.Deallocate(allocation1);
+    EXPECT_EQ(allocator.GetHeapCount(), 1u);
+    EXPECT_EQ(allocator.GetUsedSize(), 128u);
+    EXPECT_EQ(allocator.ComputeSparseHeapCount(128), 1u);
+
+    allocator.Deallocate(allocation3);
+    EXPECT_EQ(allocator.GetHeapCount(), 0u);
+    EXPECT_EQ(allocator.GetUsedSize(), 0u);
+    EXPECT_EQ(allocator.ComputeSparseHeapCount(128), 0u);
 }
 
 }  // namespace dawn::native
@@ -26,6 +26,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <limits>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -343,6 +344,43 @@ TEST(CommandAllocator, IteratorReset) {
     }
 }
 
+// Test looking ahead with iterator.GetPosition and iterator.SetPosition, including across blocks.
+TEST(CommandAllocator, IteratorPosition) {
+    CommandAllocator allocator;
+
+    // Enough commands to need several blocks.
+    const int kCommandCount = 50000;
+    for (int i = 0; i < kCommandCount; i++) {
+        CommandSmall* small = allocator.Allocate<CommandSmall>(CommandType::Small);
+        small->data = static_cast<uint16_t>(i);
+    }
+
+    CommandIterator iterator(std::move(allocator));
+    CommandType type;
+    for (int i = 0; i < kCommandCount; i += 10000) {
+        CommandIterator::Position position = iterator.GetPosition();
+
+        // Look ahead at all the remaining commands.
+        int count = i;
+        while (iterator.NextCommandId(&type)) {
+            ASSERT_EQ(iterator.NextCommand<CommandSmall>()->data, count);
+            count++;
+        }
+        ASSERT_EQ(count, kCommandCount);
+
+        // Continue the iteration from where it was.
+        iterator.SetPosition(position);
+        for (int j = i; j < i + 10000; j++) {
+            ASSERT_TRUE(iterator.NextCommandId(&type));
+            ASSERT_EQ(type, CommandType::Small);
+            ASSERT_EQ(iterator.NextCommand<CommandSmall>()->data, j);
+        }
+    }
+    ASSERT_FALSE(iterator.NextCommandId(&type));
+
+    iterator.MakeEmptyAsDataWasDestroyed();
+}
+
 // Test iterating empty iterators
 TEST(CommandAllocator, EmptyIterator) {
     {
@@ -513,4 +551,105 @@ TEST(CommandAllocator, AcquireCommandBlocks) {
     iterator.MakeEmptyAsDataWasDestroyed();
 }
 
+// Test that the blocks freed by an allocator are reused by the next allocator on the same thread.
+TEST(CommandAllocator, RecyclesFreedBlocks) {
+    CommandDraw* firstDraw = nullptr;
+    {
+        CommandAllocator allocator;
+        firstDraw = allocator.Allocate<CommandDraw>(CommandType::Draw);
+        CommandIterator iterator(std::move(allocator));
+        iterator.MakeEmptyAsDataWasDestroyed();
+    }
+
+    CommandAllocator allocator;
+    CommandDraw* secondDraw = allocator.Allocate<CommandDraw>(CommandType::Draw);
+    ASSERT_EQ(firstDraw, secondDraw);
+
+    allocator.Reset();
+    CommandDraw* thirdDraw = allocator.Allocate<CommandDraw>(CommandType::Draw);
+    ASSERT_EQ(firstDraw, thirdDraw);
+
+    CommandIterator iterator(std::move(allocator));
+    iterator.MakeEmptyAsDataWasDestroyed();
+}
+
+// Test recording commands on several threads at once, with the commands being iterated and freed
+// on another thread, like command buffers that are encoded in parallel and submitted on a single
+// thread.
+TEST(CommandAllocator, MultithreadedRecording) {
+    constexpr uint32_t kNumThreads = 8;
+    constexpr uint32_t kNumRounds = 4;
+    constexpr uint32_t kNumCommands = 10000;
+
+    for (uint32_t round = 0; round < kNumRounds; round++) {
+        std::vector<CommandIterator> iterators(kNumThreads);
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < kNumThreads; t++) {
+            threads.emplace_back([&iterators, t] {
+                CommandAllocator allocator;
+                for (uint32_t i = 0; i < kNumCommands; i++) {
+                    CommandDraw* draw = allocator.Allocate<CommandDraw>(CommandType::Draw);
+                    draw->first = t;
+                    draw->count = i;
+                }
+                iterators[t] = CommandIterator(std::move(allocator));
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        for (uint32_t t = 0; t < kNumThreads; t++) {
+            CommandIterator& iterator = iterators[t];
+            CommandType type;
+            for (uint32_t i = 0; i < kNumCommands; i++) {
+                ASSERT_TRUE(iterator.NextCommandId(&type));
+                ASSERT_EQ(type, CommandType::Draw);
+                CommandDraw* draw = iterator.NextCommand<CommandDraw>();
+                ASSERT_EQ(draw->first, t);
+                ASSERT_EQ(draw->count, i);
+            }
+            ASSERT_FALSE(iterator.NextCommandId(&type));
+            iterator.MakeEmptyAsDataWasDestroyed();
+        }
+    }
+}
+
+// Test that the blocks returned to the shared pool by exiting threads are freed by trimming the
+// pool once they stayed unused between two trims.
+TEST(CommandAllocator, TrimBlockPool) {
+    TrimCommandBlockPool(/*freeAll=*/true);
+    ASSERT_EQ(0u, GetCommandBlockPoolSizeForTesting());
+
+    // Record enough commands on another thread that its cache overflows, and free them there so
+    // that the cached blocks are returned to the shared pool when the thread exits.
+    std::thread thread([] {
+        CommandAllocator allocator;
+        for (uint32_t i = 0; i < 100000; i++) {
+            allocator.Allocate<CommandDraw>(CommandType::Draw);
+        }
+        CommandIterator iterator(std::move(allocator));
+        iterator.MakeEmptyAsDataWasDestroyed();
+    });
+    thread.join();
+    size_t pooledSize = GetCommandBlockPoolSizeForTesting();
+    EXPECT_GT(pooledSize, 0u);
+
+    // The blocks were released since the last trim, so the first trim keeps them.
+    TrimCommandBlockPool();
+    EXPECT_EQ(pooledSize, GetCommandBlockPoolSizeForTesting());
+
+    // Blocks acquired between two trims are kept, the ones that stayed in the pool are freed.
+    CommandAllocator allocator;
+    allocator.Allocate<CommandDraw>(CommandType::Draw);
+    TrimCommandBlockPool();
+    size_t trimmedSize = GetCommandBlockPoolSizeForTesting();
+    EXPECT_LT(trimmedSize, pooledSize);
+
+    CommandIterator iterator(std::move(allocator));
+    iterator.MakeEmptyAsDataWasDestroyed();
+    TrimCommandBlockPool(/*freeAll=*/true);
+    EXPECT_EQ(0u, GetCommandBlockPoolSizeForTesting());
+}
+
 }  // namespace dawn::native
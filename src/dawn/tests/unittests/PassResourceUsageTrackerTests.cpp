@@ -0,0 +1,82 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <vector>
+
+#include "dawn/native/PassResourceUsageTracker.h"
+#include "gtest/gtest.h"
+
+namespace dawn::native {
+namespace {
+
+// Test that objects get dense indices in the order they are first added, both while the map uses
+// a linear search and after it switches to a hash map.
+TEST(DenseIndexMapTests, IndicesInInsertionOrder) {
+    constexpr uint32_t kObjectCount = 100;
+    std::vector<int> objects(kObjectCount);
+
+    DenseIndexMap<int> map;
+    for (uint32_t i = 0; i < kObjectCount; ++i) {
+        auto [index, added] = map.GetOrAdd(&objects[i]);
+        EXPECT_EQ(i, index);
+        EXPECT_TRUE(added);
+        EXPECT_EQ(i + 1, map.size());
+
+        // Objects added before keep their index.
+        for (uint32_t j = 0; j <= i; j += 7) {
+            auto [existingIndex, existingAdded] = map.GetOrAdd(&objects[j]);
+            EXPECT_EQ(j, existingIndex);
+            EXPECT_FALSE(existingAdded);
+        }
+    }
+    EXPECT_EQ(kObjectCount, map.size());
+}
+
+// Test that AcquireObjects returns the objects in index order and resets the map.
+TEST(DenseIndexMapTests, AcquireObjects) {
+    std::vector<int> objects(40);
+
+    DenseIndexMap<int> map;
+    for (int& object : objects) {
+        map.GetOrAdd(&object);
+    }
+
+    std::vector<int*> acquired = map.AcquireObjects();
+    ASSERT_EQ(objects.size(), acquired.size());
+    for (size_t i = 0; i < objects.size(); ++i) {
+        EXPECT_EQ(&objects[i], acquired[i]);
+    }
+
+    EXPECT_EQ(0u, map.size());
+    auto [index, added] = map.GetOrAdd(&objects[10]);
+    EXPECT_EQ(0u, index);
+    EXPECT_TRUE(added);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
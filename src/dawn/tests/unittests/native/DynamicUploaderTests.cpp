@@ -0,0 +1,273 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "dawn/common/Constants.h"
+#include "dawn/native/Buffer.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/native/Device.h"
+#include "dawn/native/DynamicUploader.h"
+#include "dawn/native/Queue.h"
+#include "dawn/native/Texture.h"
+#include "dawn/tests/DawnNativeTest.h"
+#include "dawn/tests/unittests/native/mocks/DawnMockTest.h"
+#include "dawn/tests/unittests/native/mocks/QueueMock.h"
+
+namespace dawn::native {
+namespace {
+
+using ::testing::_;
+
+constexpr uint64_t kMiB = 1024 * 1024;
+
+// The number of chunks that fit in kMaxInFlightUploadSize, and the number of chunks of an upload
+// twice as large.
+constexpr uint32_t kMaxInFlightChunkCount =
+    DynamicUploader::kMaxInFlightUploadSize / DynamicUploader::kUploadChunkSize;
+constexpr uint32_t kChunkCount = 2 * kMaxInFlightChunkCount;
+
+class DynamicUploaderTests : public DawnNativeTest {
+  protected:
+    void SetUp() override {
+        DawnNativeTest::SetUp();
+        mDevice = FromAPI(device.Get());
+        mUploader = mDevice->GetDynamicUploader();
+    }
+
+    // Makes a staging allocation as if the data was uploaded for a copy.
+    void Upload(uint64_t size) {
+        UploadHandle uploadHandle;
+        ASSERT_FALSE(mDevice->ConsumedError(
+            mUploader->Allocate(size, mDevice->GetQueue()->GetPendingCommandSerial(),
+                                kCopyBufferToBufferOffsetAlignment),
+            &uploadHandle));
+        EXPECT_NE(uploadHandle.mappedBuffer, nullptr);
+    }
+
+    // Completes the work using the staging allocations and ticks the device to reclaim them.
+    void SubmitAndTick() {
+        device.GetQueue().Submit(0, nullptr);
+        device.Tick();
+    }
+
+    raw_ptr<DeviceBase> mDevice = nullptr;
+    raw_ptr<DynamicUploader> mUploader = nullptr;
+};
+
+// Test that uploads larger than a chunk are split through the ring buffers instead of a
+// dedicated staging buffer, and that the data is still copied correctly.
+TEST_F(DynamicUploaderTests, UploadDataInChunks) {
+    constexpr uint64_t kSize = 3 * DynamicUploader::kUploadChunkSize + 256;
+    wgpu::BufferDescriptor desc;
+    desc.size = kSize;
+    desc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::MapRead;
+    wgpu::Buffer buffer = device.CreateBuffer(&desc);
+
+    std::vector<uint32_t> data(kSize / sizeof(uint32_t));
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = i;
+    }
+    EXPECT_FALSE(mDevice->ConsumedError(FromAPI(buffer.Get())->UploadData(0, data.data(), kSize)));
+    // The null backend only submits its copies with Queue::Submit, so none of the chunks complete
+    // during the upload and each of them uses its own ring buffer.
+    EXPECT_EQ(mUploader->GetTotalAllocatedSize(), 4 * DynamicUploader::kMinRingBufferSize);
+    SubmitAndTick();
+
+    bool done = false;
+    buffer.MapAsync(wgpu::MapMode::Read, 0, kSize, wgpu::CallbackMode::AllowProcessEvents,
+                    [&done](wgpu::MapAsyncStatus status, wgpu::StringView) {
+                        EXPECT_EQ(status, wgpu::MapAsyncStatus::Success);
+                        done = true;
+                    });
+    while (!done) {
+        InstanceProcessEvents(instance->Get());
+    }
+    EXPECT_EQ(memcmp(buffer.GetConstMappedRange(), data.data(), kSize), 0);
+}
+
+// Test that ring buffers adapt to the upload volume of the previous ticks and are kept alive
+// between ticks.
+TEST_F(DynamicUploaderTests, RingBufferSizeAdaptsToUploadVolume) {
+    for (uint32_t i = 0; i < 3; ++i) {
+        Upload(DynamicUploader::kMinRingBufferSize);
+    }
+    EXPECT_EQ(mUploader->GetTotalAllocatedSize(), 3 * DynamicUploader::kMinRingBufferSize);
+    SubmitAndTick();
+
+    // The ring buffers used during the last tick are retained.
+    EXPECT_EQ(mUploader->GetTotalAllocatedSize(), 3 * DynamicUploader::kMinRingBufferSize);
+
+    // They are reused by the next tick with the same volume, new ones are sized for it.
+    for (uint32_t i = 0; i < 4; ++i) {
+        Upload(DynamicUploader::kMinRingBufferSize);
+    }
+    EXPECT_EQ(mUploader->GetTotalAllocatedSize(),
+              3 * DynamicUploader::kMinRingBufferSize + 16 * kMiB);
+    EXPECT_EQ(mUploader->GetStagingHighWaterMark(),
+              3 * DynamicUploader::kMinRingBufferSize + 16 * kMiB);
+}
+
+// Test that the staging memory retained after a spike of uploads is capped, and given back once
+// the upload volume goes down.
+TEST_F(DynamicUploaderTests, RetainedStagingMemoryIsCapped) {
+    constexpr uint64_t kUploadSize = 8 * kMiB;
+    for (uint32_t i = 0; i < 6; ++i) {
+        Upload(kUploadSize);
+    }
+    EXPECT_EQ(mUploader->GetStagingHighWaterMark(), 6 * kUploadSize);
+    SubmitAndTick();
+    EXPECT_EQ(mUploader->GetTotalAllocatedSize(), DynamicUploader::kMaxRetainedStagingSize);
+
+    // The large ring buffers are released once the spike leaves the upload history, and smaller
+    // ones are created instead.
+    for (uint32_t i = 0; i < 16; ++i) {
+        Upload(1024);
+        SubmitAndTick();
+    }
+    EXPECT_EQ(mUploader->GetTotalAllocatedSize(), 0u);
+    Upload(1024);
+    EXPECT_EQ(mUploader->GetTotalAllocatedSize(), DynamicUploader::kMinRingBufferSize);
+    EXPECT_EQ(mUploader->GetStagingHighWaterMark(), 6 * kUploadSize);
+}
+
+// Test that writing a whole texture in several chunks leaves it initialized, and that each chunk
+// is uploaded through a ring buffer of the size of a chunk.
+TEST_F(DynamicUploaderTests, WriteTextureInChunks) {
+    wgpu::TextureDescriptor desc;
+    desc.size = {2048, 2048, 2};
+    desc.format = wgpu::TextureFormat::RGBA8Unorm;
+    desc.usage = wgpu::TextureUsage::CopyDst;
+    wgpu::Texture texture = device.CreateTexture(&desc);
+
+    wgpu::ImageCopyTexture destination = {};
+    destination.texture = texture;
+    destination.origin = {0, 0, 1};
+    wgpu::TextureDataLayout dataLayout = {};
+    dataLayout.bytesPerRow = 2048 * 4;
+    std::vector<uint8_t> data(2048 * 1536 * 4);
+    wgpu::Extent3D writeSize = {2048, 1536, 1};
+    device.GetQueue().WriteTexture(&destination, data.data(), data.size(), &dataLayout, &writeSize);
+
+    TextureBase* nativeTexture = FromAPI(texture.Get());
+    EXPECT_FALSE(nativeTexture->IsSubresourceContentInitialized(
+        SubresourceRange::MakeSingle(Aspect::Color, 0, 0)));
+    EXPECT_TRUE(nativeTexture->IsSubresourceContentInitialized(
+        SubresourceRange::MakeSingle(Aspect::Color, 1, 0)));
+    // The null backend only submits its copies with Queue::Submit, so none of the chunks complete
+    // during the upload and each of them keeps its ring buffer. Without chunks, the 12MiB upload
+    // would have used a 16MiB ring buffer.
+    EXPECT_EQ(mUploader->GetStagingHighWaterMark(), 3 * DynamicUploader::kUploadChunkSize);
+}
+
+// Uploads chunks on a queue whose copies only complete when the test waits for them, like a GPU
+// that is behind, to check how much staging memory the chunks keep in flight.
+class DynamicUploaderMockTests : public DawnMockTest {
+  protected:
+    void SetUp() override {
+        DawnMockTest::SetUp();
+        mUploader = mDeviceMock->GetDynamicUploader();
+
+        QueueMock* queue = mDeviceMock->GetQueueMock();
+        ON_CALL(*queue, HasPendingCommands).WillByDefault([this] { return mHasPendingCopies; });
+        ON_CALL(*queue, SubmitPendingCommands).WillByDefault([this, queue]() -> MaybeError {
+            queue->IncrementLastSubmittedCommandSerial();
+            mHasPendingCopies = false;
+            return {};
+        });
+        ON_CALL(*queue, CheckAndUpdateCompletedSerials)
+            .WillByDefault([this]() -> ResultOrError<ExecutionSerial> { return mGPUSerial; });
+        ON_CALL(*queue, WaitForQueueSerial)
+            .WillByDefault([this](ExecutionSerial serial, Nanoseconds) -> ResultOrError<bool> {
+                mGPUSerial = std::max(mGPUSerial, serial);
+                return true;
+            });
+    }
+
+    // Uploads the chunks of an upload of |chunkCount| chunks like WriteBuffer does, and returns the
+    // largest staging memory in flight when the next chunk is uploaded.
+    uint64_t UploadChunks(uint32_t chunkCount) {
+        uint64_t maxInFlightUploadSize = 0;
+        for (uint32_t i = 0; i < chunkCount; ++i) {
+            UploadHandle uploadHandle;
+            EXPECT_FALSE(mDeviceMock->ConsumedError(
+                mUploader->Allocate(DynamicUploader::kUploadChunkSize,
+                                    mDeviceMock->GetQueue()->GetPendingCommandSerial(),
+                                    kCopyBufferToBufferOffsetAlignment),
+                &uploadHandle));
+            mHasPendingCopies = true;
+            maxInFlightUploadSize =
+                std::max(maxInFlightUploadSize, mUploader->GetInFlightUploadSize());
+            EXPECT_FALSE(mDeviceMock->ConsumedError(mUploader->OnUploadChunkRecorded()));
+        }
+        return maxInFlightUploadSize;
+    }
+
+    raw_ptr<DynamicUploader> mUploader = nullptr;
+    bool mHasPendingCopies = false;
+    // The serial of the last copies that the mock GPU completed.
+    ExecutionSerial mGPUSerial = kBeginningOfGPUTime;
+};
+
+// Test that by default, uploads don't wait for the GPU once kMaxInFlightUploadSize is reached, and
+// use more staging memory instead, which the next device tick reclaims.
+TEST_F(DynamicUploaderMockTests, UploadDoesNotWaitByDefault) {
+    EXPECT_CALL(*mDeviceMock->GetQueueMock(), WaitForQueueSerial(_, _)).Times(0);
+
+    EXPECT_EQ(UploadChunks(kChunkCount), kChunkCount * DynamicUploader::kUploadChunkSize);
+    EXPECT_EQ(mUploader->GetStagingHighWaterMark(),
+              kChunkCount * DynamicUploader::kUploadChunkSize);
+
+    // The staging memory is reclaimed once the GPU completes the copies.
+    mGPUSerial = mDeviceMock->GetQueue()->GetLastSubmittedCommandSerial();
+    EXPECT_FALSE(mDeviceMock->ConsumedError(mDeviceMock->GetQueue()->CheckPassedSerials()));
+    mUploader->Deallocate(mDeviceMock->GetQueue()->GetCompletedCommandSerial());
+    EXPECT_EQ(mUploader->GetInFlightUploadSize(), 0u);
+}
+
+class DynamicUploaderWaitMockTests : public DynamicUploaderMockTests {
+  public:
+    DynamicUploaderWaitMockTests() : DynamicUploaderMockTests() {
+        mDeviceToggles.ForceSet(Toggle::WaitForInFlightUploadChunks, true);
+    }
+};
+
+// Test that with wait_for_in_flight_upload_chunks, uploads wait for the GPU to complete previous
+// chunks so that at most kMaxInFlightUploadSize of staging memory is in flight, and reuse it.
+TEST_F(DynamicUploaderWaitMockTests, UploadWaitsAtMaxInFlightUploadSize) {
+    // Each chunk from the one that fills kMaxInFlightUploadSize waits for the oldest chunk.
+    EXPECT_CALL(*mDeviceMock->GetQueueMock(), WaitForQueueSerial(_, _))
+        .Times(kChunkCount - kMaxInFlightChunkCount + 1);
+
+    EXPECT_EQ(UploadChunks(kChunkCount), DynamicUploader::kMaxInFlightUploadSize);
+    EXPECT_EQ(mUploader->GetStagingHighWaterMark(), DynamicUploader::kMaxInFlightUploadSize);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
@@ -0,0 +1,77 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "dawn/native/Buffer.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/native/Device.h"
+#include "dawn/native/EventManager.h"
+#include "dawn/native/Instance.h"
+#include "dawn/tests/DawnNativeTest.h"
+
+namespace dawn::native {
+namespace {
+
+class EventManagerTests : public DawnNativeTest {
+  protected:
+    EventManager* GetEventManager() {
+        return FromAPI(device.Get())->GetInstance()->GetEventManager();
+    }
+};
+
+// Test that unmapping a buffer with a pending MapAsync completes the map on the next
+// ProcessEvents instead of waiting for the serial the map was tracked with, and that the event
+// isn't left in the EventManager once completed.
+TEST_F(EventManagerTests, UnmapCompletesPendingMapOnNextProcessEvents) {
+    wgpu::BufferDescriptor desc;
+    desc.size = 4;
+    desc.usage = wgpu::BufferUsage::MapRead;
+    wgpu::Buffer buffer = device.CreateBuffer(&desc);
+
+    // The null backend doesn't track buffer usages, so mark the buffer as used by the pending
+    // commands for the map to wait on a serial that isn't submitted yet.
+    FromAPI(buffer.Get())->MarkUsedInPendingCommands();
+
+    // Other events, like the device lost event, stay tracked.
+    size_t otherEventCount = GetEventManager()->GetTrackedEventCountForTesting();
+    bool done = false;
+    buffer.MapAsync(wgpu::MapMode::Read, 0, 4, wgpu::CallbackMode::AllowProcessEvents,
+                    [&done](wgpu::MapAsyncStatus status, wgpu::StringView) {
+                        EXPECT_EQ(status, wgpu::MapAsyncStatus::Aborted);
+                        done = true;
+                    });
+    EXPECT_GT(GetEventManager()->GetTrackedEventCountForTesting(), otherEventCount);
+
+    buffer.Unmap();
+    EXPECT_FALSE(done);
+    InstanceProcessEvents(instance->Get());
+    EXPECT_TRUE(done);
+    EXPECT_EQ(GetEventManager()->GetTrackedEventCountForTesting(), otherEventCount);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
@@ -909,5 +909,162 @@ TEST_F(ShaderModuleExtensionValidationTestUnsafeAllFeatures, ShaderModuleCompila
     device.CreateShaderModule(&desc);
 }
 
+// Test that the device counts the shader modules found in its caches.
+TEST_F(ShaderModuleValidationTest, ShaderModuleCacheStats) {
+    FlushWire();
+    dawn::native::ShaderModuleCacheStats before =
+        dawn::native::GetShaderModuleCacheStats(backendDevice);
+
+    wgpu::ShaderModule module =
+        utils::CreateShaderModule(device, "@compute @workgroup_size(1) fn main() {}");
+    wgpu::ShaderModule sameSource =
+        utils::CreateShaderModule(device, "@compute @workgroup_size(1) fn main() {}");
+    wgpu::ShaderModule otherSource =
+        utils::CreateShaderModule(device, "@compute @workgroup_size(1) fn main() { }");
+
+    FlushWire();
+    dawn::native::ShaderModuleCacheStats after =
+        dawn::native::GetShaderModuleCacheStats(backendDevice);
+    EXPECT_EQ(after.lookupCount - before.lookupCount, 3u);
+    EXPECT_EQ(after.contentHitCount - before.contentHitCount, 1u);
+    // Modules are only shared by program when dedup_shader_modules_by_program is enabled.
+    EXPECT_EQ(after.programHitCount, 0u);
+}
+
+class ShaderModuleParallelUniformityValidationTest : public ValidationTest {
+  protected:
+    std::vector<const char*> GetEnabledToggles() override {
+        return {"parallel_wgsl_uniformity_analysis"};
+    }
+
+    // Returns a compute shader with a chain of kFunctionCount functions, enough for their
+    // uniformity to be analyzed in parallel, the last of which calls workgroupBarrier(). The
+    // entry point calls the first one under |condition|.
+    std::string MakeShaderWithCallChain(const char* condition) {
+        constexpr uint32_t kFunctionCount = 32;
+        std::ostringstream shader;
+        shader << "@group(0) @binding(0) var<storage, read_write> data : array<u32>;\n";
+        shader << "fn f" << kFunctionCount << "(x : u32) -> u32 {\n"
+               << "    workgroupBarrier();\n"
+               << "    return x;\n"
+               << "}\n";
+        for (uint32_t i = kFunctionCount; i > 0; --i) {
+            shader << "fn f" << (i - 1) << "(x : u32) -> u32 {\n"
+                   << "    return f" << i << "(x) + " << i << "u;\n"
+                   << "}\n";
+        }
+        shader << "@compute @workgroup_size(64)\n"
+               << "fn main(@builtin(local_invocation_index) index : u32) {\n"
+               << "    if (" << condition << ") {\n"
+               << "        data[index] = f0(data[index]);\n"
+               << "    }\n"
+               << "}\n";
+        return shader.str();
+    }
+};
+
+// Test that a module with many functions is valid with the parallel uniformity analysis when the
+// functions are called from uniform control flow.
+TEST_F(ShaderModuleParallelUniformityValidationTest, UniformCallChain) {
+    ASSERT_TRUE(HasToggleEnabled("parallel_wgsl_uniformity_analysis"));
+    utils::CreateShaderModule(device, MakeShaderWithCallChain("true").c_str());
+}
+
+// Test that the parallel uniformity analysis reports a barrier reached from non-uniform control
+// flow through a chain of functions.
+TEST_F(ShaderModuleParallelUniformityValidationTest, NonUniformCallChain) {
+    ASSERT_DEVICE_ERROR(
+        utils::CreateShaderModule(device, MakeShaderWithCallChain("index == 0u").c_str()),
+        testing::HasSubstr("'workgroupBarrier' must only be called from uniform control flow"));
+}
+
+class ShaderModuleDedupValidationTest : public ValidationTest {
+  protected:
+    std::vector<const char*> GetEnabledToggles() override {
+        return {"dedup_shader_modules_by_program"};
+    }
+
+    uint64_t GetProgramHitCount() {
+        FlushWire();
+        return dawn::native::GetShaderModuleCacheStats(backendDevice).programHitCount;
+    }
+};
+
+// Test that shaders that only differ in formatting, comments, the names of declarations that
+// aren't visible to the API, or unused declarations share a shader module.
+TEST_F(ShaderModuleDedupValidationTest, EquivalentShadersAreShared) {
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+        @group(0) @binding(0) var<storage, read_write> data : array<u32>;
+
+        fn double(x : u32) -> u32 {
+            return x * 2u;
+        }
+
+        @compute @workgroup_size(64) fn main(@builtin(global_invocation_id) id : vec3u) {
+            data[id.x] = double(data[id.x]);
+        })");
+    uint64_t hitCount = GetProgramHitCount();
+
+    wgpu::ShaderModule equivalent = utils::CreateShaderModule(device, R"(
+        // Doubles all the values.
+        @group(0) @binding(0) var<storage, read_write> values : array<u32>;
+        @group(0) @binding(1) var<uniform> unusedBinding : vec4f;
+        fn twice(v : u32) -> u32 { return v * 2u; }
+        fn unused() -> vec4f { return unusedBinding; }
+        @compute @workgroup_size(64)
+        fn main(@builtin(global_invocation_id) gid : vec3u) {
+            values[gid.x] = twice(values[gid.x]);
+        })");
+    EXPECT_EQ(GetProgramHitCount(), hitCount + 1);
+    if (!UsesWire()) {
+        EXPECT_EQ(module.Get(), equivalent.Get());
+    }
+}
+
+// Test that a shader that was shared by program is found by its content afterwards, without
+// canonicalizing it again.
+TEST_F(ShaderModuleDedupValidationTest, SharedShaderIsFoundByContent) {
+    constexpr char kEquivalentSource[] = R"(
+        // Same program, different formatting.
+        @compute @workgroup_size(1)
+        fn main() {})";
+
+    wgpu::ShaderModule module =
+        utils::CreateShaderModule(device, "@compute @workgroup_size(1) fn main() {}");
+    wgpu::ShaderModule equivalent = utils::CreateShaderModule(device, kEquivalentSource);
+    uint64_t hitCount = GetProgramHitCount();
+    dawn::native::ShaderModuleCacheStats before =
+        dawn::native::GetShaderModuleCacheStats(backendDevice);
+
+    wgpu::ShaderModule equivalentAgain = utils::CreateShaderModule(device, kEquivalentSource);
+    EXPECT_EQ(GetProgramHitCount(), hitCount);
+    dawn::native::ShaderModuleCacheStats after =
+        dawn::native::GetShaderModuleCacheStats(backendDevice);
+    EXPECT_EQ(after.contentHitCount - before.contentHitCount, 1u);
+    if (!UsesWire()) {
+        EXPECT_EQ(module.Get(), equivalentAgain.Get());
+    }
+}
+
+// Test that shaders with different entry point names, override names or code aren't shared.
+TEST_F(ShaderModuleDedupValidationTest, DifferentShadersAreNotShared) {
+    uint64_t hitCount = GetProgramHitCount();
+
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+        override size = 1u;
+        @compute @workgroup_size(size) fn main() {})");
+    wgpu::ShaderModule otherOverrideName = utils::CreateShaderModule(device, R"(
+        override count = 1u;
+        @compute @workgroup_size(count) fn main() {})");
+    wgpu::ShaderModule otherEntryPointName = utils::CreateShaderModule(device, R"(
+        override size = 1u;
+        @compute @workgroup_size(size) fn main2() {})");
+    wgpu::ShaderModule otherCode = utils::CreateShaderModule(device, R"(
+        override size = 2u;
+        @compute @workgroup_size(size) fn main() {})");
+
+    EXPECT_EQ(GetProgramHitCount(), hitCount);
+}
+
 }  // anonymous namespace
 }  // namespace dawn
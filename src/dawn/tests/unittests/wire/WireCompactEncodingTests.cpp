@@ -0,0 +1,234 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "dawn/tests/unittests/wire/WireTest.h"
+#include "dawn/utils/TerribleCommandBuffer.h"
+#include "dawn/wire/WireCompactEncoding.h"
+
+namespace dawn::wire {
+namespace {
+
+using testing::_;
+using testing::InSequence;
+using testing::Return;
+
+class WireCompactEncodingTests : public WireTest {
+  protected:
+    void SetUp() override {
+        WireTest::SetUp();
+
+        wgpu::BindGroupLayoutDescriptor bglDescriptor = {};
+        bgl = device.CreateBindGroupLayout(&bglDescriptor);
+        WGPUBindGroupLayout apiBgl = api.GetNewBindGroupLayout();
+        EXPECT_CALL(api, DeviceCreateBindGroupLayout(apiDevice, _)).WillOnce(Return(apiBgl));
+
+        wgpu::BindGroupDescriptor bindGroupDescriptor = {};
+        bindGroupDescriptor.layout = bgl;
+        {
+            InSequence s;
+            for (size_t i = 0; i < bindGroups.size(); ++i) {
+                bindGroups[i] = device.CreateBindGroup(&bindGroupDescriptor);
+                apiBindGroups[i] = api.GetNewBindGroup();
+                EXPECT_CALL(api, DeviceCreateBindGroup(apiDevice, _))
+                    .WillOnce(Return(apiBindGroups[i]));
+            }
+        }
+
+        encoder = device.CreateCommandEncoder();
+        apiEncoder = api.GetNewCommandEncoder();
+        EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+            .WillOnce(Return(apiEncoder));
+
+        pass = encoder.BeginComputePass();
+        apiPass = api.GetNewComputePassEncoder();
+        EXPECT_CALL(api, CommandEncoderBeginComputePass(apiEncoder, nullptr))
+            .WillOnce(Return(apiPass));
+
+        FlushClient();
+    }
+
+    void TearDown() override {
+        bgl = nullptr;
+        bindGroups = {};
+        encoder = nullptr;
+        pass = nullptr;
+        WireTest::TearDown();
+    }
+
+    wgpu::BindGroupLayout bgl;
+    std::array<wgpu::BindGroup, 2> bindGroups;
+    std::array<WGPUBindGroup, 2> apiBindGroups;
+    wgpu::CommandEncoder encoder;
+    WGPUCommandEncoder apiEncoder;
+    wgpu::ComputePassEncoder pass;
+    WGPUComputePassEncoder apiPass;
+
+  private:
+    bool UseCompactEncoding() override { return true; }
+};
+
+// Test that commands are forwarded to the server, and that a redundant SetBindGroup is elided.
+TEST_F(WireCompactEncodingTests, RedundantSetBindGroupIsElided) {
+    pass.SetBindGroup(0, bindGroups[0]);
+    pass.DispatchWorkgroups(1, 2, 3);
+    pass.SetBindGroup(0, bindGroups[0]);
+    pass.DispatchWorkgroups(4, 5, 6);
+
+    InSequence s;
+    EXPECT_CALL(api, ComputePassEncoderSetBindGroup(apiPass, 0, apiBindGroups[0], 0, _)).Times(1);
+    EXPECT_CALL(api, ComputePassEncoderDispatchWorkgroups(apiPass, 1, 2, 3)).Times(1);
+    EXPECT_CALL(api, ComputePassEncoderDispatchWorkgroups(apiPass, 4, 5, 6)).Times(1);
+    FlushClient();
+
+    EXPECT_EQ(GetClientCompactEncodingStats().elidedCommands, 1u);
+}
+
+// Test that a SetBindGroup is only elided if it is identical to the previous one.
+TEST_F(WireCompactEncodingTests, DifferentSetBindGroupIsNotElided) {
+    std::array<uint32_t, 1> offsets0 = {0};
+    std::array<uint32_t, 1> offsets256 = {256};
+    pass.SetBindGroup(0, bindGroups[0]);
+    pass.SetBindGroup(0, bindGroups[1]);
+    pass.SetBindGroup(1, bindGroups[1]);
+    pass.SetBindGroup(1, bindGroups[1], offsets0.size(), offsets0.data());
+    pass.SetBindGroup(1, bindGroups[1], offsets256.size(), offsets256.data());
+
+    InSequence s;
+    EXPECT_CALL(api, ComputePassEncoderSetBindGroup(apiPass, 0, apiBindGroups[0], 0, _)).Times(1);
+    EXPECT_CALL(api, ComputePassEncoderSetBindGroup(apiPass, 0, apiBindGroups[1], 0, _)).Times(1);
+    EXPECT_CALL(api, ComputePassEncoderSetBindGroup(apiPass, 1, apiBindGroups[1], 0, _)).Times(1);
+    EXPECT_CALL(api, ComputePassEncoderSetBindGroup(apiPass, 1, apiBindGroups[1], 1, _)).Times(2);
+    FlushClient();
+
+    EXPECT_EQ(GetClientCompactEncodingStats().elidedCommands, 0u);
+}
+
+// Test that a command which could change the encoder state prevents the elision, so that for
+// example setting state on an ended pass still produces a validation error on the server.
+TEST_F(WireCompactEncodingTests, StateChangePreventsElision) {
+    pass.SetBindGroup(0, bindGroups[0]);
+    pass.End();
+    pass.SetBindGroup(0, bindGroups[0]);
+
+    InSequence s;
+    EXPECT_CALL(api, ComputePassEncoderSetBindGroup(apiPass, 0, apiBindGroups[0], 0, _)).Times(1);
+    EXPECT_CALL(api, ComputePassEncoderEnd(apiPass)).Times(1);
+    EXPECT_CALL(api, ComputePassEncoderSetBindGroup(apiPass, 0, apiBindGroups[0], 0, _)).Times(1);
+    FlushClient();
+
+    EXPECT_EQ(GetClientCompactEncodingStats().elidedCommands, 0u);
+}
+
+// Test that elision state is kept across flushes.
+TEST_F(WireCompactEncodingTests, ElisionAcrossFlushes) {
+    pass.SetBindGroup(0, bindGroups[0]);
+    EXPECT_CALL(api, ComputePassEncoderSetBindGroup(apiPass, 0, apiBindGroups[0], 0, _)).Times(1);
+    FlushClient();
+
+    pass.DispatchWorkgroups(1, 1, 1);
+    pass.SetBindGroup(0, bindGroups[0]);
+    EXPECT_CALL(api, ComputePassEncoderDispatchWorkgroups(apiPass, 1, 1, 1)).Times(1);
+    FlushClient();
+
+    EXPECT_EQ(GetClientCompactEncodingStats().elidedCommands, 1u);
+}
+
+// Test that repeated commands are encoded in a fraction of their size.
+TEST_F(WireCompactEncodingTests, RepeatedCommandsAreCompressed) {
+    constexpr uint32_t kDispatchCount = 1000;
+    CompactEncodingStats statsBefore = GetClientCompactEncodingStats();
+
+    for (uint32_t i = 0; i < kDispatchCount; ++i) {
+        pass.SetBindGroup(0, bindGroups[i % 2]);
+        pass.DispatchWorkgroups(i, 1, 1);
+    }
+    EXPECT_CALL(api, ComputePassEncoderSetBindGroup(apiPass, 0, _, 0, _)).Times(kDispatchCount);
+    EXPECT_CALL(api, ComputePassEncoderDispatchWorkgroups(apiPass, _, 1, 1)).Times(kDispatchCount);
+    FlushClient();
+
+    CompactEncodingStats stats = GetClientCompactEncodingStats();
+    uint64_t decodedBytes = stats.decodedBytes - statsBefore.decodedBytes;
+    uint64_t encodedBytes = stats.encodedBytes - statsBefore.encodedBytes;
+    EXPECT_LT(encodedBytes * 3, decodedBytes);
+}
+
+class RecordingCommandHandler : public CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        const char* data = const_cast<const char*>(commands);
+        recorded.insert(recorded.end(), data, data + size);
+        return commands + size;
+    }
+
+    std::vector<char> recorded;
+};
+
+// Test that frames claiming to be larger than kMaxCompactFrameDecodedSize are rejected as soon as
+// their header is received, instead of being buffered until the payload arrives.
+TEST(WireCompactEncodingDecoderTests, OversizedFramesAreRejected) {
+    // The offsets of payloadSize and decodedSize in the frame header.
+    constexpr size_t kPayloadSizeOffset = 8;
+    constexpr size_t kDecodedSizeOffset = 16;
+    constexpr size_t kHeaderSize = 24;
+
+    // Encode a small frame.
+    RecordingCommandHandler encoded;
+    utils::TerribleCommandBuffer buffer(&encoded);
+    CompactCommandSerializerDescriptor descriptor = {};
+    descriptor.serializer = &buffer;
+    CompactCommandSerializer serializer(descriptor);
+    memset(serializer.GetCmdSpace(64), 0, 64);
+    ASSERT_TRUE(serializer.Flush());
+    ASSERT_GT(encoded.recorded.size(), kHeaderSize);
+
+    // The frame is accepted as is.
+    {
+        RecordingCommandHandler decoded;
+        CompactCommandHandler handler(&decoded);
+        EXPECT_NE(handler.HandleCommands(encoded.recorded.data(), encoded.recorded.size()),
+                  nullptr);
+        EXPECT_EQ(decoded.recorded.size(), 64u);
+    }
+
+    for (size_t offset : {kPayloadSizeOffset, kDecodedSizeOffset}) {
+        std::vector<char> frame(encoded.recorded.begin(), encoded.recorded.begin() + kHeaderSize);
+        uint64_t size = 3 * kMaxCompactFrameDecodedSize;
+        memcpy(frame.data() + offset, &size, sizeof(size));
+
+        RecordingCommandHandler decoded;
+        CompactCommandHandler handler(&decoded);
+        EXPECT_EQ(handler.HandleCommands(frame.data(), frame.size()), nullptr);
+        EXPECT_TRUE(decoded.recorded.empty());
+    }
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
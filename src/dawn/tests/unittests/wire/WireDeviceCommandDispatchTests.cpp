@@ -0,0 +1,328 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "dawn/common/StringViewUtils.h"
+#include "dawn/tests/MockCallback.h"
+#include "dawn/tests/unittests/wire/WireTest.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+
+namespace dawn::wire {
+namespace {
+
+using testing::_;
+using testing::InSequence;
+using testing::Invoke;
+using testing::InvokeWithoutArgs;
+using testing::MockCallback;
+using testing::NotNull;
+using testing::Return;
+using testing::SaveArg;
+using testing::Sequence;
+using testing::WithArg;
+
+// Long enough for commands of another device to be handled meanwhile if they don't wait.
+constexpr auto kSlowCommandDuration = std::chrono::milliseconds(20);
+// How long a command waits for the commands of another device before the test fails.
+constexpr auto kWaitTimeout = std::chrono::seconds(5);
+
+// Waits until |flag| is set by another thread. Returns false on timeout.
+bool WaitUntil(const std::atomic<bool>& flag) {
+    auto deadline = std::chrono::steady_clock::now() + kWaitTimeout;
+    while (!flag.load() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return flag.load();
+}
+
+class WireDeviceCommandDispatchTests : public WireTest {
+  protected:
+    void SetUp() override {
+        WireTest::SetUp();
+
+        // Request a second device from the adapter so that its commands go to another lane.
+        apiDevice2 = api.GetNewDevice();
+        MockCallback<void (*)(wgpu::RequestDeviceStatus, wgpu::Device, wgpu::StringView, void*)>
+            deviceCb;
+        adapter.RequestDevice(nullptr, wgpu::CallbackMode::AllowSpontaneous, deviceCb.Callback(),
+                              deviceCb.MakeUserdata(this));
+        EXPECT_CALL(api, OnAdapterRequestDevice2(apiAdapter, NotNull(), _))
+            .WillOnce(InvokeWithoutArgs([&] {
+                EXPECT_CALL(api, OnDeviceSetLoggingCallback(apiDevice2, NotNull(), NotNull()))
+                    .Times(1);
+                EXPECT_CALL(api, DeviceGetLimits(apiDevice2, NotNull()))
+                    .WillOnce(WithArg<1>(Invoke([&](WGPUSupportedLimits* limits) {
+                        *limits = {};
+                        return WGPUStatus_Success;
+                    })));
+                EXPECT_CALL(api, DeviceEnumerateFeatures(apiDevice2, nullptr))
+                    .WillOnce(Return(0))
+                    .WillOnce(Return(0));
+                api.CallAdapterRequestDevice2Callback(apiAdapter, WGPURequestDeviceStatus_Success,
+                                                      apiDevice2, kEmptyOutputStringView);
+            }));
+        FlushClient();
+        EXPECT_CALL(deviceCb, Call(wgpu::RequestDeviceStatus::Success, NotNull(), _, this))
+            .WillOnce(SaveArg<1>(&device2));
+        FlushServer();
+        ASSERT_NE(device2, nullptr);
+
+        queue2 = device2.GetQueue();
+        apiQueue2 = api.GetNewQueue();
+        EXPECT_CALL(api, DeviceGetQueue(apiDevice2)).WillOnce(Return(apiQueue2));
+        FlushClient();
+    }
+
+    void TearDown() override {
+        device2 = nullptr;
+        queue2 = nullptr;
+        EXPECT_CALL(api, OnDeviceSetLoggingCallback(apiDevice2, nullptr, nullptr)).Times(1);
+        WireTest::TearDown();
+    }
+
+    wgpu::Device device2;
+    WGPUDevice apiDevice2;
+    wgpu::Queue queue2;
+    WGPUQueue apiQueue2;
+
+  private:
+    uint32_t GetDeviceCommandThreadCount() override { return 2; }
+};
+
+// Test that commands are forwarded in order when they are handled on the device command threads.
+TEST_F(WireDeviceCommandDispatchTests, CommandsAreForwardedInOrder) {
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+    queue.Submit(1, &commandBuffer);
+
+    WGPUCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+    WGPUCommandBuffer apiCommandBuffer = api.GetNewCommandBuffer();
+    InSequence s;
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr)).WillOnce(Return(apiEncoder));
+    EXPECT_CALL(api, CommandEncoderFinish(apiEncoder, nullptr)).WillOnce(Return(apiCommandBuffer));
+    EXPECT_CALL(api, QueueSubmit(apiQueue, 1, _)).Times(1);
+    FlushClient();
+}
+
+// Test that the commands of each device keep their order when they are interleaved, even if the
+// commands of one device are slow.
+TEST_F(WireDeviceCommandDispatchTests, CommandsOfEachDeviceAreOrdered) {
+    constexpr uint32_t kCommandCount = 4;
+    std::vector<wgpu::CommandEncoder> encoders;
+    for (uint32_t i = 0; i < kCommandCount; ++i) {
+        queue.Submit(0, nullptr);
+        queue2.Submit(0, nullptr);
+        encoders.push_back(device.CreateCommandEncoder());
+        encoders.push_back(device2.CreateCommandEncoder());
+    }
+
+    Sequence sequence1;
+    Sequence sequence2;
+    for (uint32_t i = 0; i < kCommandCount; ++i) {
+        EXPECT_CALL(api, QueueSubmit(apiQueue, 0, _))
+            .InSequence(sequence1)
+            .WillOnce(InvokeWithoutArgs([] { std::this_thread::sleep_for(kSlowCommandDuration); }));
+        EXPECT_CALL(api, QueueSubmit(apiQueue2, 0, _)).InSequence(sequence2);
+        EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+            .InSequence(sequence1)
+            .WillOnce(Return(api.GetNewCommandEncoder()));
+        EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice2, nullptr))
+            .InSequence(sequence2)
+            .WillOnce(Return(api.GetNewCommandEncoder()));
+    }
+    FlushClient();
+}
+
+// Test that a command using an object of another device waits for the commands of that device
+// which use the object, starting with its creation.
+TEST_F(WireDeviceCommandDispatchTests, CrossDeviceUseWaitsForOtherDevice) {
+    wgpu::BufferDescriptor descriptor = {};
+    descriptor.size = 4;
+    descriptor.usage = wgpu::BufferUsage::CopyDst;
+    wgpu::Buffer buffer2 = device2.CreateBuffer(&descriptor);
+    uint32_t data = 0;
+    queue.WriteBuffer(buffer2, 0, &data, sizeof(data));
+    buffer2.Destroy();
+
+    WGPUBuffer apiBuffer2 = api.GetNewBuffer();
+    InSequence s;
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevice2, _))
+        .WillOnce(InvokeWithoutArgs([&] {
+            std::this_thread::sleep_for(kSlowCommandDuration);
+            return apiBuffer2;
+        }));
+    EXPECT_CALL(api, QueueWriteBuffer(apiQueue, apiBuffer2, 0, _, sizeof(data))).Times(1);
+    EXPECT_CALL(api, BufferDestroy(apiBuffer2)).Times(1);
+    FlushClient();
+}
+
+// Test that an error while handling a command on the device command threads is reported when
+// waiting for the commands, and only once.
+TEST_F(WireDeviceCommandDispatchTests, ErrorIsReportedOnce) {
+    // Releasing a reservation that was never injected is an error on the server.
+    wgpu::BufferDescriptor descriptor = {};
+    ReservedBuffer reservation = GetWireClient()->ReserveBuffer(
+        device.Get(), reinterpret_cast<const WGPUBufferDescriptor*>(&descriptor));
+    wgpuBufferRelease(reservation.buffer);
+    FlushClient(false);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .WillOnce(Return(api.GetNewCommandEncoder()));
+    FlushClient();
+}
+
+// Test that an injected buffer is used by the commands of its device.
+TEST_F(WireDeviceCommandDispatchTests, InjectedBuffer) {
+    wgpu::BufferDescriptor descriptor = {};
+    ReservedBuffer reservation = GetWireClient()->ReserveBuffer(
+        device2.Get(), reinterpret_cast<const WGPUBufferDescriptor*>(&descriptor));
+    wgpu::Buffer buffer = wgpu::Buffer::Acquire(reservation.buffer);
+
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    EXPECT_CALL(api, BufferAddRef(apiBuffer));
+    ASSERT_TRUE(
+        GetWireServer()->InjectBuffer(apiBuffer, reservation.handle, reservation.deviceHandle));
+
+    queue2.WriteBuffer(buffer, 0, nullptr, 0);
+    buffer.Destroy();
+    InSequence s;
+    EXPECT_CALL(api, QueueWriteBuffer(apiQueue2, apiBuffer, 0, _, 0)).Times(1);
+    EXPECT_CALL(api, BufferDestroy(apiBuffer)).Times(1);
+    FlushClient();
+}
+
+// Test that an injected object with an ID too far ahead of the IDs known by the server is rejected.
+// KnownObjects allows out of order allocations, so the dispatcher does this check instead.
+TEST_F(WireDeviceCommandDispatchTests, InjectedIdTooFarAheadIsRejected) {
+    wgpu::BufferDescriptor descriptor = {};
+    ReservedBuffer reservation = GetWireClient()->ReserveBuffer(
+        device.Get(), reinterpret_cast<const WGPUBufferDescriptor*>(&descriptor));
+    wgpu::Buffer buffer = wgpu::Buffer::Acquire(reservation.buffer);
+
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    Handle tooFarAhead = reservation.handle;
+    tooFarAhead.id++;
+    ASSERT_FALSE(GetWireServer()->InjectBuffer(apiBuffer, tooFarAhead, reservation.deviceHandle));
+
+    // The next ID is still accepted.
+    EXPECT_CALL(api, BufferAddRef(apiBuffer));
+    ASSERT_TRUE(
+        GetWireServer()->InjectBuffer(apiBuffer, reservation.handle, reservation.deviceHandle));
+}
+
+// Test that an object created by a device after another device created an object with a greater
+// ID gets the ID that was skipped.
+TEST_F(WireDeviceCommandDispatchTests, SkippedIdIsAllocatedLater) {
+    wgpu::BufferDescriptor descriptor = {};
+    descriptor.size = 4;
+    descriptor.usage = wgpu::BufferUsage::CopyDst;
+    queue2.Submit(0, nullptr);
+    wgpu::Buffer buffer2 = device2.CreateBuffer(&descriptor);
+    wgpu::Buffer buffer = device.CreateBuffer(&descriptor);
+    buffer2.Destroy();
+    buffer.Destroy();
+
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    WGPUBuffer apiBuffer2 = api.GetNewBuffer();
+    std::atomic<bool> bufferCreated = false;
+    // The second device only creates its buffer once the first device created the buffer with
+    // the next ID, which skips the ID of buffer2.
+    EXPECT_CALL(api, QueueSubmit(apiQueue2, 0, _)).WillOnce(InvokeWithoutArgs([&] {
+        EXPECT_TRUE(WaitUntil(bufferCreated));
+    }));
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(InvokeWithoutArgs([&] {
+        bufferCreated = true;
+        return apiBuffer;
+    }));
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevice2, _)).WillOnce(Return(apiBuffer2));
+    EXPECT_CALL(api, BufferDestroy(apiBuffer2)).Times(1);
+    EXPECT_CALL(api, BufferDestroy(apiBuffer)).Times(1);
+    FlushClient();
+}
+
+// Test that the replies of a device are flushed once its commands are handled, without waiting
+// for the commands of a slower device.
+TEST_F(WireDeviceCommandDispatchTests, RepliesAreNotDelayedBySlowerDevice) {
+    std::atomic<bool> workDone = false;
+    queue2.Submit(0, nullptr);
+    queue.OnSubmittedWorkDone(wgpu::CallbackMode::AllowSpontaneous,
+                              [&workDone](wgpu::QueueWorkDoneStatus status) {
+                                  EXPECT_EQ(status, wgpu::QueueWorkDoneStatus::Success);
+                                  workDone = true;
+                              });
+
+    // The second device is busy until the client got the reply of the first device.
+    EXPECT_CALL(api, QueueSubmit(apiQueue2, 0, _)).WillOnce(InvokeWithoutArgs([&] {
+        EXPECT_TRUE(WaitUntil(workDone));
+    }));
+    EXPECT_CALL(api, OnQueueOnSubmittedWorkDone2(apiQueue, _)).WillOnce(InvokeWithoutArgs([&] {
+        api.CallQueueOnSubmittedWorkDone2Callback(apiQueue, WGPUQueueWorkDoneStatus_Success);
+    }));
+    FlushClientAndDispatchedReplies();
+    EXPECT_TRUE(workDone);
+}
+
+// Test that a pipeline compiled by a device doesn't block the commands of the other devices. The
+// backend may compile the pipeline before CreateComputePipelineAsync returns.
+TEST_F(WireDeviceCommandDispatchTests, PipelineCompilationDoesNotBlockOtherDevice) {
+    wgpu::ShaderModuleDescriptor shaderDescriptor = {};
+    wgpu::ShaderModule shader = device.CreateShaderModule(&shaderDescriptor);
+    EXPECT_CALL(api, DeviceCreateShaderModule(apiDevice, _))
+        .WillOnce(Return(api.GetNewShaderModule()));
+    FlushClient();
+
+    wgpu::ComputePipelineDescriptor descriptor = {};
+    descriptor.compute.module = shader;
+    device.CreateComputePipelineAsync(
+        &descriptor, wgpu::CallbackMode::AllowSpontaneous,
+        [](wgpu::CreatePipelineAsyncStatus, wgpu::ComputePipeline, wgpu::StringView) {});
+    queue2.Submit(0, nullptr);
+
+    // The compilation only finishes once the second device handled its commands.
+    std::atomic<bool> submitted = false;
+    WGPUComputePipeline apiPipeline = api.GetNewComputePipeline();
+    EXPECT_CALL(api, OnDeviceCreateComputePipelineAsync2(apiDevice, _, _))
+        .WillOnce(InvokeWithoutArgs([&] {
+            EXPECT_TRUE(WaitUntil(submitted));
+            api.CallDeviceCreateComputePipelineAsync2Callback(
+                apiDevice, WGPUCreatePipelineAsyncStatus_Success, apiPipeline,
+                kEmptyOutputStringView);
+        }));
+    EXPECT_CALL(api, QueueSubmit(apiQueue2, 0, _)).WillOnce(InvokeWithoutArgs([&] {
+        submitted = true;
+    }));
+    FlushClient();
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
@@ -0,0 +1,288 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "dawn/common/Platform.h"
+#include "dawn/utils/SharedMemoryRingBuffer.h"
+#include "dawn/wire/RingBufferTransport.h"
+#include "gtest/gtest.h"
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn::wire {
+namespace {
+
+// Records the commands it receives, one entry per call to HandleCommands.
+class RecordingCommandHandler : public CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        if (fail) {
+            return nullptr;
+        }
+        const char* data = const_cast<const char*>(commands);
+        calls.emplace_back(data, data + size);
+        receivedSize += size;
+        return commands + size;
+    }
+
+    std::vector<char> GetReceivedCommands() const {
+        std::vector<char> received;
+        for (const std::vector<char>& call : calls) {
+            received.insert(received.end(), call.begin(), call.end());
+        }
+        return received;
+    }
+
+    std::vector<std::vector<char>> calls;
+    size_t receivedSize = 0;
+    bool fail = false;
+};
+
+// Doorbells for both ends of a ring used on a single thread: ringing the producer's doorbell
+// processes the commands immediately, so it never has to wait.
+class SynchronousDoorbell : public RingBufferDoorbell {
+  public:
+    void SetReader(RingBufferCommandReader* reader) { mReader = reader; }
+
+    void Ring() override {
+        if (mReader != nullptr) {
+            processSucceeded &= mReader->ProcessCommands();
+        }
+        ringCount++;
+    }
+    bool Wait() override { return processSucceeded; }
+
+    uint32_t ringCount = 0;
+    bool processSucceeded = true;
+
+  private:
+    raw_ptr<RingBufferCommandReader> mReader = nullptr;
+};
+
+class WireRingBufferTransportTests : public testing::Test {
+  protected:
+    void CreateRing(size_t capacity) {
+        mMemory = std::make_unique<uint64_t[]>(GetRingBufferMemorySize(capacity) / 8);
+        InitializeRingBuffer(mMemory.get(), capacity);
+        serializer = std::make_unique<RingBufferCommandSerializer>(mMemory.get(), capacity,
+                                                                   &producerDoorbell);
+        reader = std::make_unique<RingBufferCommandReader>(mMemory.get(), capacity, &handler,
+                                                           &consumerDoorbell);
+        producerDoorbell.SetReader(reader.get());
+    }
+
+    // Serializes a command of |size| bytes filled with a pattern based on |index|.
+    void SerializeCommand(size_t size, uint32_t index) {
+        char* space = static_cast<char*>(serializer->GetCmdSpace(size));
+        ASSERT_NE(space, nullptr);
+        for (size_t i = 0; i < size; ++i) {
+            space[i] = static_cast<char>(index * 31 + i);
+            expected.push_back(space[i]);
+        }
+    }
+
+    void* GetMemory() { return mMemory.get(); }
+
+    RecordingCommandHandler handler;
+    SynchronousDoorbell producerDoorbell;
+    SynchronousDoorbell consumerDoorbell;
+    std::unique_ptr<RingBufferCommandSerializer> serializer;
+    std::unique_ptr<RingBufferCommandReader> reader;
+    std::vector<char> expected;
+
+  private:
+    std::unique_ptr<uint64_t[]> mMemory;
+};
+
+// Test that commands are only handled once flushed, as a single block.
+TEST_F(WireRingBufferTransportTests, FlushHandlesCommands) {
+    CreateRing(1024);
+    SerializeCommand(16, 0);
+    SerializeCommand(24, 1);
+    SerializeCommand(5, 2);
+    EXPECT_TRUE(handler.calls.empty());
+
+    EXPECT_TRUE(serializer->Flush());
+    ASSERT_EQ(handler.calls.size(), 1u);
+    EXPECT_EQ(handler.GetReceivedCommands(), expected);
+    EXPECT_EQ(producerDoorbell.ringCount, 1u);
+    EXPECT_EQ(consumerDoorbell.ringCount, 1u);
+
+    // Flushing without new commands doesn't ring the doorbell.
+    EXPECT_TRUE(serializer->Flush());
+    EXPECT_EQ(producerDoorbell.ringCount, 1u);
+}
+
+// Test allocations of the maximum size, and that larger ones fail.
+TEST_F(WireRingBufferTransportTests, MaximumAllocationSize) {
+    CreateRing(1024);
+    size_t maxSize = serializer->GetMaximumAllocationSize();
+    EXPECT_GE(maxSize, 1024u / 2 - 16);
+    EXPECT_EQ(serializer->GetCmdSpace(maxSize + 1), nullptr);
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        SerializeCommand(maxSize, i);
+    }
+    EXPECT_TRUE(serializer->Flush());
+    EXPECT_EQ(handler.GetReceivedCommands(), expected);
+}
+
+// Test that the commands are received in order when the ring wraps around and becomes full.
+TEST_F(WireRingBufferTransportTests, WrapAroundWhenFull) {
+    CreateRing(256);
+    for (uint32_t i = 0; i < 500; ++i) {
+        SerializeCommand(8 + (i * 13) % 97, i);
+        if (i % 37 == 0) {
+            EXPECT_TRUE(serializer->Flush());
+        }
+    }
+    EXPECT_TRUE(serializer->Flush());
+    EXPECT_EQ(handler.GetReceivedCommands(), expected);
+    EXPECT_TRUE(producerDoorbell.processSucceeded);
+}
+
+// Test that a handler error is returned by the reader and makes the producer fail.
+TEST_F(WireRingBufferTransportTests, HandlerError) {
+    CreateRing(256);
+    handler.fail = true;
+    SerializeCommand(16, 0);
+    EXPECT_TRUE(serializer->Flush());
+    EXPECT_FALSE(producerDoorbell.processSucceeded);
+
+    // The ring is never freed, so filling it fails.
+    void* space = nullptr;
+    for (uint32_t i = 0; i < 10; ++i) {
+        space = serializer->GetCmdSpace(64);
+        if (space == nullptr) {
+            break;
+        }
+    }
+    EXPECT_EQ(space, nullptr);
+}
+
+// Test that the reader rejects a corrupted write position.
+TEST_F(WireRingBufferTransportTests, CorruptedWritePosition) {
+    CreateRing(256);
+    uint64_t writePosition = 1024;
+    memcpy(GetMemory(), &writePosition, sizeof(writePosition));
+    EXPECT_FALSE(reader->ProcessCommands());
+}
+
+// Test that the reader rejects a block larger than the ring.
+TEST_F(WireRingBufferTransportTests, CorruptedBlockSize) {
+    CreateRing(256);
+    SerializeCommand(16, 0);
+    producerDoorbell.SetReader(nullptr);
+    EXPECT_TRUE(serializer->Flush());
+
+    // The block size is the first thing after the 128 byte header.
+    uint64_t blockSize = 4096;
+    memcpy(static_cast<char*>(GetMemory()) + 128, &blockSize, sizeof(blockSize));
+    EXPECT_FALSE(reader->ProcessCommands());
+    EXPECT_TRUE(handler.calls.empty());
+}
+
+#if DAWN_PLATFORM_IS(LINUX)
+// Test the ring in shared memory, with the producer and the consumer on different threads and
+// separate mappings of the memory.
+TEST_F(WireRingBufferTransportTests, SharedMemoryAcrossThreads) {
+    constexpr size_t kCapacity = 4096;
+    constexpr uint32_t kCommandCount = 20000;
+
+    std::unique_ptr<utils::SharedMemoryRingBuffer> producerRing =
+        utils::SharedMemoryRingBuffer::Create(kCapacity);
+    ASSERT_NE(producerRing, nullptr);
+    std::unique_ptr<utils::SharedMemoryRingBuffer> consumerRing =
+        utils::SharedMemoryRingBuffer::Import(producerRing->DuplicateHandles());
+    ASSERT_NE(consumerRing, nullptr);
+    EXPECT_NE(producerRing->GetMemory(), consumerRing->GetMemory());
+
+    std::vector<char> sent;
+    size_t sentSize = 0;
+    for (uint32_t i = 0; i < kCommandCount; ++i) {
+        sentSize += 8 + (i * 13) % 300;
+    }
+    sent.reserve(sentSize);
+
+    std::thread producer([&] {
+        RingBufferCommandSerializer ringSerializer(producerRing->GetMemory(), kCapacity,
+                                                   producerRing->GetProducerDoorbell());
+        for (uint32_t i = 0; i < kCommandCount; ++i) {
+            size_t size = 8 + (i * 13) % 300;
+            char* space = static_cast<char*>(ringSerializer.GetCmdSpace(size));
+            ASSERT_NE(space, nullptr);
+            for (size_t j = 0; j < size; ++j) {
+                space[j] = static_cast<char>(i + j);
+                sent.push_back(space[j]);
+            }
+            if (i % 64 == 0) {
+                ringSerializer.Flush();
+            }
+        }
+        ringSerializer.Flush();
+    });
+
+    RingBufferCommandReader ringReader(consumerRing->GetMemory(), kCapacity, &handler,
+                                       consumerRing->GetConsumerDoorbell());
+    while (handler.receivedSize < sentSize) {
+        ASSERT_TRUE(consumerRing->GetConsumerDoorbell()->Wait());
+        ASSERT_TRUE(ringReader.ProcessCommands());
+    }
+    producer.join();
+
+    EXPECT_EQ(handler.GetReceivedCommands(), sent);
+}
+
+// Test that importing handles whose capacity doesn't match the shared memory fails, since the
+// handles can come from another process.
+TEST_F(WireRingBufferTransportTests, SharedMemoryImportValidatesCapacity) {
+    constexpr size_t kCapacity = 4096;
+
+    std::unique_ptr<utils::SharedMemoryRingBuffer> ring =
+        utils::SharedMemoryRingBuffer::Create(kCapacity);
+    ASSERT_NE(ring, nullptr);
+
+    // The capacity matches the memory.
+    EXPECT_NE(utils::SharedMemoryRingBuffer::Import(ring->DuplicateHandles()), nullptr);
+
+    // The memory is too small for the capacity.
+    utils::SharedMemoryRingBufferHandles tooLarge = ring->DuplicateHandles();
+    tooLarge.capacity = kCapacity * 2;
+    EXPECT_EQ(utils::SharedMemoryRingBuffer::Import(tooLarge), nullptr);
+
+    // The capacity isn't a multiple of the block alignment.
+    utils::SharedMemoryRingBufferHandles unaligned = ring->DuplicateHandles();
+    unaligned.capacity = kCapacity - 4;
+    EXPECT_EQ(utils::SharedMemoryRingBuffer::Import(unaligned), nullptr);
+}
+#endif  // DAWN_PLATFORM_IS(LINUX)
+
+}  // anonymous namespace
+}  // namespace dawn::wire
@@ -32,6 +32,7 @@
 #include "dawn/tests/MockCallback.h"
 #include "dawn/utils/TerribleCommandBuffer.h"
 #include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireCompactEncoding.h"
 #include "dawn/wire/WireServer.h"
 
 using testing::_;
@@ -61,6 +62,14 @@ wire::server::MemoryTransferService* WireTest::GetServerMemoryTransferService()
     return nullptr;
 }
 
+bool WireTest::UseCompactEncoding() {
+    return false;
+}
+
+uint32_t WireTest::GetDeviceCommandThreadCount() {
+    return 0;
+}
+
 void WireTest::SetUp() {
     DawnProcTable mockProcs;
     api.GetProcTable(&mockProcs);
@@ -69,21 +78,44 @@ void WireTest::SetUp() {
     mS2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
     mC2sBuf = std::make_unique<utils::TerribleCommandBuffer>(mWireServer.get());
 
+    wire::CommandSerializer* s2cSerializer = mS2cBuf.get();
+    wire::CommandSerializer* c2sSerializer = mC2sBuf.get();
+    if (UseCompactEncoding()) {
+        wire::CompactCommandSerializerDescriptor s2cCompactDesc = {};
+        s2cCompactDesc.serializer = mS2cBuf.get();
+        mS2cCompactSerializer = std::make_unique<wire::CompactCommandSerializer>(s2cCompactDesc);
+
+        wire::CompactCommandSerializerDescriptor c2sCompactDesc = {};
+        c2sCompactDesc.serializer = mC2sBuf.get();
+        c2sCompactDesc.elideRedundantCommands = true;
+        mC2sCompactSerializer = std::make_unique<wire::CompactCommandSerializer>(c2sCompactDesc);
+        s2cSerializer = mS2cCompactSerializer.get();
+        c2sSerializer = mC2sCompactSerializer.get();
+    }
+
     wire::WireServerDescriptor serverDesc = {};
     serverDesc.procs = &mockProcs;
-    serverDesc.serializer = mS2cBuf.get();
+    serverDesc.serializer = s2cSerializer;
     serverDesc.memoryTransferService = GetServerMemoryTransferService();
+    serverDesc.deviceCommandThreadCount = GetDeviceCommandThreadCount();
 
     mWireServer.reset(new wire::WireServer(serverDesc));
     mC2sBuf->SetHandler(mWireServer.get());
 
     wire::WireClientDescriptor clientDesc = {};
-    clientDesc.serializer = mC2sBuf.get();
+    clientDesc.serializer = c2sSerializer;
     clientDesc.memoryTransferService = GetClientMemoryTransferService();
 
     mWireClient.reset(new wire::WireClient(clientDesc));
     mS2cBuf->SetHandler(mWireClient.get());
 
+    if (UseCompactEncoding()) {
+        mC2sCompactHandler = std::make_unique<wire::CompactCommandHandler>(mWireServer.get());
+        mS2cCompactHandler = std::make_unique<wire::CompactCommandHandler>(mWireClient.get());
+        mC2sBuf->SetHandler(mC2sCompactHandler.get());
+        mS2cBuf->SetHandler(mS2cCompactHandler.get());
+    }
+
     dawnProcSetProcs(&wire::client::GetProcs());
 
     auto reservedInstance = GetWireClient()->ReserveInstance();
@@ -203,6 +235,7 @@ void WireTest::TearDown() {
     // cannot be null.
     api.IgnoreAllReleaseCalls();
     mS2cBuf->SetHandler(nullptr);
+    mS2cCompactHandler = nullptr;
     mWireClient = nullptr;
 
     if (mWireServer && apiDevice) {
@@ -211,6 +244,7 @@ void WireTest::TearDown() {
         EXPECT_CALL(api, OnDeviceSetLoggingCallback(apiDevice, nullptr, nullptr)).Times(Exactly(1));
     }
     mC2sBuf->SetHandler(nullptr);
+    mC2sCompactHandler = nullptr;
     mWireServer = nullptr;
 }
 
@@ -227,14 +261,32 @@ void WireTest::DefaultApiAdapterWasReleased() {
 }
 
 void WireTest::FlushClient(bool success) {
-    ASSERT_EQ(mC2sBuf->Flush(), success);
+    // The replies are only flushed by FlushServer so that tests can set expectations before.
+    FlushClientImpl(success, /*flushReplies=*/false);
+}
+
+void WireTest::FlushClientAndDispatchedReplies(bool success) {
+    FlushClientImpl(success, /*flushReplies=*/true);
+}
+
+void WireTest::FlushClientImpl(bool success, bool flushReplies) {
+    bool flushed = mC2sCompactSerializer ? mC2sCompactSerializer->Flush() : mC2sBuf->Flush();
+    // Commands handled on the device command threads report their errors when waited on.
+    if (flushed && mWireServer) {
+        flushed = mWireServer->WaitForDispatchedCommands(flushReplies);
+    }
+    ASSERT_EQ(flushed, success);
 
     Mock::VerifyAndClearExpectations(&api);
     SetupIgnoredCallExpectations();
 }
 
 void WireTest::FlushServer(bool success) {
-    ASSERT_EQ(mS2cBuf->Flush(), success);
+    if (mS2cCompactSerializer) {
+        ASSERT_EQ(mS2cCompactSerializer->Flush(), success);
+    } else {
+        ASSERT_EQ(mS2cBuf->Flush(), success);
+    }
 }
 
 wire::WireServer* WireTest::GetWireServer() {
@@ -245,6 +297,10 @@ wire::WireClient* WireTest::GetWireClient() {
     return mWireClient.get();
 }
 
+wire::CompactEncodingStats WireTest::GetClientCompactEncodingStats() {
+    return mC2sCompactSerializer->GetStats();
+}
+
 void WireTest::DeleteServer() {
     EXPECT_CALL(api, QueueRelease(apiQueue)).Times(1);
     EXPECT_CALL(api, DeviceRelease(apiDevice)).Times(1);
@@ -257,11 +313,13 @@ void WireTest::DeleteServer() {
         EXPECT_CALL(api, OnDeviceSetLoggingCallback(apiDevice, nullptr, nullptr)).Times(Exactly(1));
     }
     mC2sBuf->SetHandler(nullptr);
+    mC2sCompactHandler = nullptr;
     mWireServer = nullptr;
 }
 
 void WireTest::DeleteClient() {
     mS2cBuf->SetHandler(nullptr);
+    mS2cCompactHandler = nullptr;
     mWireClient = nullptr;
 }
 
@@ -122,6 +122,9 @@ inline testing::Matcher<const char*> ValidStringMessage() {
     } while (0)
 
 namespace wire {
+class CompactCommandHandler;
+class CompactCommandSerializer;
+struct CompactEncodingStats;
 class WireClient;
 class WireServer;
 namespace client {
@@ -146,6 +149,9 @@ class WireTest : public testing::Test {
 
     void FlushClient(bool success = true);
     void FlushServer(bool success = true);
+    // Flushes the client, then the server each time the commands of a device are handled on the
+    // device command threads, so that their replies don't wait for the other devices.
+    void FlushClientAndDispatchedReplies(bool success = true);
 
     void DefaultApiDeviceWasReleased();
     void DefaultApiAdapterWasReleased();
@@ -169,20 +175,30 @@ class WireTest : public testing::Test {
 
     dawn::wire::WireServer* GetWireServer();
     dawn::wire::WireClient* GetWireClient();
+    dawn::wire::CompactEncodingStats GetClientCompactEncodingStats();
 
     void DeleteServer();
     void DeleteClient();
 
   private:
     void SetupIgnoredCallExpectations();
+    void FlushClientImpl(bool success, bool flushReplies);
 
     virtual dawn::wire::client::MemoryTransferService* GetClientMemoryTransferService();
     virtual dawn::wire::server::MemoryTransferService* GetServerMemoryTransferService();
+    // Whether the client and the server talk to each other using the compact encoding.
+    virtual bool UseCompactEncoding();
+    // The number of threads the server uses to handle the commands of each device, if any.
+    virtual uint32_t GetDeviceCommandThreadCount();
 
     std::unique_ptr<dawn::wire::WireServer> mWireServer;
     std::unique_ptr<dawn::wire::WireClient> mWireClient;
     std::unique_ptr<dawn::utils::TerribleCommandBuffer> mS2cBuf;
     std::unique_ptr<dawn::utils::TerribleCommandBuffer> mC2sBuf;
+    std::unique_ptr<dawn::wire::CompactCommandSerializer> mS2cCompactSerializer;
+    std::unique_ptr<dawn::wire::CompactCommandSerializer> mC2sCompactSerializer;
+    std::unique_ptr<dawn::wire::CompactCommandHandler> mS2cCompactHandler;
+    std::unique_ptr<dawn::wire::CompactCommandHandler> mC2sCompactHandler;
 };
 
 }  // namespace dawn
@@ -0,0 +1,207 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include <vector>
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/native/vulkan/QueueVk.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn::native::vulkan {
+namespace {
+
+constexpr uint32_t kCommandCount = 16;
+constexpr uint64_t kBufferSize = 256;
+
+class VulkanBarrierTests : public DawnTest {
+  protected:
+    void SetUp() override {
+        DawnTest::SetUp();
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+    }
+
+    // Creates buffers whose last usage is a copy write, so that any later usage needs a barrier.
+    std::vector<wgpu::Buffer> CreateWrittenBuffers(wgpu::BufferUsage usage) {
+        wgpu::BufferDescriptor desc;
+        desc.size = kBufferSize;
+        desc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+        wgpu::Buffer source = device.CreateBuffer(&desc);
+        std::vector<uint8_t> data(kBufferSize, 0x42);
+        queue.WriteBuffer(source, 0, data.data(), data.size());
+
+        desc.usage = usage | wgpu::BufferUsage::CopyDst;
+        std::vector<wgpu::Buffer> buffers;
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        for (uint32_t i = 0; i < kCommandCount; ++i) {
+            buffers.push_back(device.CreateBuffer(&desc));
+            encoder.CopyBufferToBuffer(source, 0, buffers.back(), 0, kBufferSize);
+        }
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+        return buffers;
+    }
+
+    const BarrierStats& GetLastSubmitBarrierStats() {
+        return ToBackend(FromAPI(queue.Get()))->GetLastSubmitBarrierStats();
+    }
+};
+
+// Test that the transitions of the sources and the destinations of independent copies are recorded
+// with a single barrier.
+TEST_P(VulkanBarrierTests, CopyHeavy) {
+    std::vector<wgpu::Buffer> sources = CreateWrittenBuffers(wgpu::BufferUsage::CopySrc);
+    std::vector<wgpu::Buffer> destinations = CreateWrittenBuffers(wgpu::BufferUsage::None);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (uint32_t i = 0; i < kCommandCount; ++i) {
+        encoder.CopyBufferToBuffer(sources[i], 0, destinations[i], 0, kBufferSize);
+    }
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    const BarrierStats& stats = GetLastSubmitBarrierStats();
+    EXPECT_EQ(stats.pipelineBarrierCount, 1u);
+    EXPECT_EQ(stats.bufferBarrierCount, 2 * kCommandCount);
+    EXPECT_EQ(stats.imageBarrierCount, 0u);
+}
+
+// Test that copies reading the same source are recorded with a single barrier.
+TEST_P(VulkanBarrierTests, CopiesFromSharedSource) {
+    std::vector<wgpu::Buffer> sources = CreateWrittenBuffers(wgpu::BufferUsage::CopySrc);
+    std::vector<wgpu::Buffer> destinations = CreateWrittenBuffers(wgpu::BufferUsage::None);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (uint32_t i = 0; i < kCommandCount; ++i) {
+        encoder.CopyBufferToBuffer(sources[0], 0, destinations[i], 0, kBufferSize);
+    }
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    const BarrierStats& stats = GetLastSubmitBarrierStats();
+    EXPECT_EQ(stats.pipelineBarrierCount, 1u);
+    EXPECT_EQ(stats.bufferBarrierCount, 1 + kCommandCount);
+    EXPECT_EQ(stats.imageBarrierCount, 0u);
+}
+
+// Test that a copy reading the destination of the previous copy gets its own barrier.
+TEST_P(VulkanBarrierTests, DependentCopies) {
+    std::vector<wgpu::Buffer> buffers = CreateWrittenBuffers(wgpu::BufferUsage::CopySrc);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (uint32_t i = 0; i + 1 < kCommandCount; ++i) {
+        encoder.CopyBufferToBuffer(buffers[i], 0, buffers[i + 1], 0, kBufferSize);
+    }
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    const BarrierStats& stats = GetLastSubmitBarrierStats();
+    EXPECT_EQ(stats.pipelineBarrierCount, kCommandCount - 1);
+    EXPECT_EQ(stats.bufferBarrierCount, 2 * (kCommandCount - 1));
+    EXPECT_EQ(stats.imageBarrierCount, 0u);
+}
+
+// Test that the transitions of the source buffers and the destination textures of independent
+// copies, which include layout transitions, are recorded with a single barrier.
+TEST_P(VulkanBarrierTests, CopyBufferToTextureHeavy) {
+    std::vector<wgpu::Buffer> sources = CreateWrittenBuffers(wgpu::BufferUsage::CopySrc);
+
+    // Each copy writes the whole texture so that it doesn't need to be lazily cleared first.
+    wgpu::TextureDescriptor textureDesc;
+    textureDesc.size = {kBufferSize / 4, 1, 1};
+    textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+    textureDesc.usage = wgpu::TextureUsage::CopyDst;
+
+    std::vector<wgpu::Texture> destinations;
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (uint32_t i = 0; i < kCommandCount; ++i) {
+        destinations.push_back(device.CreateTexture(&textureDesc));
+        wgpu::ImageCopyBuffer source = utils::CreateImageCopyBuffer(sources[i], 0, kBufferSize);
+        wgpu::ImageCopyTexture destination = utils::CreateImageCopyTexture(destinations.back());
+        encoder.CopyBufferToTexture(&source, &destination, &textureDesc.size);
+    }
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    const BarrierStats& stats = GetLastSubmitBarrierStats();
+    EXPECT_EQ(stats.pipelineBarrierCount, 1u);
+    EXPECT_EQ(stats.bufferBarrierCount, kCommandCount);
+    EXPECT_EQ(stats.imageBarrierCount, kCommandCount);
+}
+
+// Test that the barriers of dispatches writing different buffers are recorded with a single
+// barrier, and that dispatches writing the same buffer each get their own barrier.
+TEST_P(VulkanBarrierTests, DispatchHeavy) {
+    wgpu::ComputePipelineDescriptor pipelineDesc;
+    pipelineDesc.compute.module = utils::CreateShaderModule(device, R"(
+        @group(0) @binding(0) var<storage, read_write> data : array<u32>;
+        @compute @workgroup_size(1) fn main() {
+            data[0] = 1u;
+        })");
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&pipelineDesc);
+
+    std::vector<wgpu::Buffer> buffers = CreateWrittenBuffers(wgpu::BufferUsage::Storage);
+    std::vector<wgpu::BindGroup> bindGroups;
+    for (const wgpu::Buffer& buffer : buffers) {
+        bindGroups.push_back(
+            utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0), {{0, buffer}}));
+    }
+
+    auto DispatchWithBindGroups = [&](bool sameBindGroup) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.SetPipeline(pipeline);
+        for (uint32_t i = 0; i < kCommandCount; ++i) {
+            pass.SetBindGroup(0, bindGroups[sameBindGroup ? 0 : i]);
+            pass.DispatchWorkgroups(1);
+        }
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    };
+
+    DispatchWithBindGroups(/*sameBindGroup=*/false);
+    {
+        const BarrierStats& stats = GetLastSubmitBarrierStats();
+        EXPECT_EQ(stats.pipelineBarrierCount, 1u);
+        EXPECT_EQ(stats.bufferBarrierCount, kCommandCount);
+        EXPECT_EQ(stats.imageBarrierCount, 0u);
+    }
+
+    // Each dispatch waits for the write of the previous one.
+    DispatchWithBindGroups(/*sameBindGroup=*/true);
+    {
+        const BarrierStats& stats = GetLastSubmitBarrierStats();
+        EXPECT_EQ(stats.pipelineBarrierCount, kCommandCount);
+        EXPECT_EQ(stats.bufferBarrierCount, kCommandCount);
+        EXPECT_EQ(stats.imageBarrierCount, 0u);
+    }
+}
+
+DAWN_INSTANTIATE_TEST(VulkanBarrierTests, VulkanBackend());
+
+}  // anonymous namespace
+}  // namespace dawn::native::vulkan
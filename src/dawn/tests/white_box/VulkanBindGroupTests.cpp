@@ -0,0 +1,95 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/native/vulkan/BindGroupVk.h"
+#include "dawn/native/vulkan/Forward.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn::native::vulkan {
+namespace {
+
+class VulkanBindGroupTests : public DawnTest {
+  protected:
+    void SetUp() override {
+        DawnTest::SetUp();
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+        mLayout = utils::MakeBindGroupLayout(
+            device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Uniform}});
+
+        wgpu::BufferDescriptor bufferDesc;
+        bufferDesc.size = 512;
+        bufferDesc.usage = wgpu::BufferUsage::Uniform;
+        mBuffer = device.CreateBuffer(&bufferDesc);
+    }
+
+    wgpu::BindGroup MakeBindGroup(const wgpu::Buffer& buffer, uint64_t offset) {
+        return utils::MakeBindGroup(device, mLayout, {{0, buffer, offset, 16}});
+    }
+
+    VkDescriptorSet GetDescriptorSet(const wgpu::BindGroup& bindGroup) {
+        return ToBackend(FromAPI(bindGroup.Get()))->GetHandle();
+    }
+
+    wgpu::BindGroupLayout mLayout;
+    wgpu::Buffer mBuffer;
+};
+
+// Test that bind groups with the same contents share their descriptor set.
+TEST_P(VulkanBindGroupTests, IdenticalBindGroupsShareDescriptorSet) {
+    wgpu::BindGroup bindGroupA = MakeBindGroup(mBuffer, 0);
+    wgpu::BindGroup bindGroupB = MakeBindGroup(mBuffer, 0);
+    wgpu::BindGroup bindGroupC = MakeBindGroup(mBuffer, 256);
+
+    EXPECT_EQ(GetDescriptorSet(bindGroupA), GetDescriptorSet(bindGroupB));
+    EXPECT_NE(GetDescriptorSet(bindGroupA), GetDescriptorSet(bindGroupC));
+
+    // The shared descriptor set stays valid while any of the bind groups is alive.
+    VkDescriptorSet set = GetDescriptorSet(bindGroupA);
+    bindGroupA = nullptr;
+    EXPECT_EQ(set, GetDescriptorSet(bindGroupB));
+}
+
+// Test that bind groups referencing destroyed resources don't share their descriptor set.
+TEST_P(VulkanBindGroupTests, DestroyedResourcesAreNotShared) {
+    wgpu::BufferDescriptor bufferDesc;
+    bufferDesc.size = 16;
+    bufferDesc.usage = wgpu::BufferUsage::Uniform;
+    wgpu::Buffer buffer = device.CreateBuffer(&bufferDesc);
+    buffer.Destroy();
+
+    wgpu::BindGroup bindGroupA = MakeBindGroup(buffer, 0);
+    wgpu::BindGroup bindGroupB = MakeBindGroup(buffer, 0);
+    EXPECT_NE(GetDescriptorSet(bindGroupA), GetDescriptorSet(bindGroupB));
+}
+
+DAWN_INSTANTIATE_TEST(VulkanBindGroupTests, VulkanBackend());
+
+}  // anonymous namespace
+}  // namespace dawn::native::vulkan
@@ -0,0 +1,247 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/native/DawnNative.h"
+#include "dawn/native/vulkan/ResourceMemoryAllocatorVk.h"
+
+namespace dawn::native::vulkan {
+namespace {
+
+// Sub-allocated buffers are placed in 8MiB heaps.
+constexpr uint64_t kBufferSize = 1024 * 1024;
+constexpr uint32_t kBuffersPerHeap = 8;
+constexpr uint32_t kHeapCount = 4;
+
+class VulkanResourceMemoryTests : public DawnTest {
+  protected:
+    void SetUp() override {
+        DawnTest::SetUp();
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+        DAWN_TEST_UNSUPPORTED_IF(HasToggleEnabled("disable_resource_suballocation"));
+        DAWN_TEST_UNSUPPORTED_IF(!HasToggleEnabled("vulkan_defragment_memory_on_idle"));
+    }
+
+    ResourceMemoryStats GetStats() { return native::GetResourceMemoryStats(device.Get()); }
+
+    void PerformIdleTasks() {
+        WaitForAllOperations();
+        native::PerformIdleTasks(device);
+        WaitForAllOperations();
+    }
+
+    // Streams buffers through kHeapCount heaps, keeping one copy-only buffer per heap so that the
+    // heaps are left sparse. The kept buffers are filled with their index if |initialize| is true.
+    std::vector<wgpu::Buffer> CreateBuffersInSparseHeaps(bool initialize) {
+        wgpu::BufferDescriptor desc;
+        desc.size = kBufferSize;
+        desc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+
+        std::vector<wgpu::Buffer> keptBuffers;
+        for (uint32_t i = 0; i < kBuffersPerHeap * kHeapCount; ++i) {
+            wgpu::Buffer buffer = device.CreateBuffer(&desc);
+            if (i % kBuffersPerHeap != 0) {
+                buffer.Destroy();
+                continue;
+            }
+            if (initialize) {
+                uint32_t index = static_cast<uint32_t>(keptBuffers.size());
+                std::vector<uint32_t> data(kBufferSize / sizeof(uint32_t), index);
+                queue.WriteBuffer(buffer, 0, data.data(), kBufferSize);
+            }
+            keptBuffers.push_back(buffer);
+        }
+
+        WaitForAllOperations();
+        return keptBuffers;
+    }
+};
+
+// Test that streaming many buffers and keeping a few of them alive leaves sparse heaps that are
+// released by PerformIdleTasks after moving the remaining buffers once, without changing their
+// contents.
+TEST_P(VulkanResourceMemoryTests, StreamingChurn) {
+    ResourceMemoryStats initialStats = GetStats();
+
+    wgpu::BufferDescriptor desc;
+    desc.size = kBufferSize;
+    desc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+
+    std::vector<wgpu::Buffer> keptBuffers;
+    std::vector<std::vector<uint32_t>> keptData;
+    for (uint32_t i = 0; i < kBuffersPerHeap * kHeapCount; ++i) {
+        wgpu::Buffer buffer = device.CreateBuffer(&desc);
+        std::vector<uint32_t> data(kBufferSize / sizeof(uint32_t), i);
+        queue.WriteBuffer(buffer, 0, data.data(), kBufferSize);
+
+        // Keep one buffer out of every heap's worth of buffers, the others are streamed.
+        if (i % kBuffersPerHeap == 0) {
+            keptBuffers.push_back(buffer);
+            keptData.push_back(std::move(data));
+        } else {
+            buffer.Destroy();
+        }
+    }
+
+    WaitForAllOperations();
+    ResourceMemoryStats churnStats = GetStats();
+    EXPECT_GE(churnStats.heapCount, initialStats.heapCount + kHeapCount);
+    EXPECT_GT(churnStats.sparseHeapCount, 0u);
+
+    // The first idle tasks move the buffers out of the sparse heaps, the next ones release the
+    // heaps that were freed once the copies completed and stayed unused. The moved buffers are
+    // never moved again.
+    PerformIdleTasks();
+    uint64_t movedAllocationCount = GetStats().movedAllocationCount;
+    EXPECT_GT(movedAllocationCount, churnStats.movedAllocationCount);
+    for (uint32_t i = 0; i < ResourceMemoryAllocator::kMaxUnusedPoolIdleTaskCount; ++i) {
+        PerformIdleTasks();
+        EXPECT_EQ(GetStats().movedAllocationCount, movedAllocationCount);
+    }
+
+    ResourceMemoryStats stats = GetStats();
+    EXPECT_GT(stats.releasedHeapCount, churnStats.releasedHeapCount);
+    EXPECT_LT(stats.heapCount, churnStats.heapCount);
+    EXPECT_EQ(stats.usedSize, churnStats.usedSize);
+
+    for (size_t i = 0; i < keptBuffers.size(); ++i) {
+        EXPECT_BUFFER_U32_RANGE_EQ(keptData[i].data(), keptBuffers[i], 0, keptData[i].size());
+    }
+}
+
+// Test that the copy-only buffers in sparse heaps that also contain buffers that can't be moved
+// are never moved, since these heaps can't be released.
+TEST_P(VulkanResourceMemoryTests, PinnedSparseHeaps) {
+    wgpu::BufferDescriptor pinnedDesc;
+    pinnedDesc.size = kBufferSize;
+    pinnedDesc.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopyDst;
+
+    wgpu::BufferDescriptor desc;
+    desc.size = kBufferSize;
+    desc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+
+    // In each heap's worth of buffers, keep a storage buffer that pins the heap and a copy-only
+    // buffer, the others are streamed.
+    std::vector<wgpu::Buffer> keptBuffers;
+    std::vector<std::vector<uint32_t>> keptData;
+    for (uint32_t i = 0; i < kBuffersPerHeap * kHeapCount; ++i) {
+        wgpu::Buffer buffer = device.CreateBuffer(i % kBuffersPerHeap == 0 ? &pinnedDesc : &desc);
+        std::vector<uint32_t> data(kBufferSize / sizeof(uint32_t), i);
+        queue.WriteBuffer(buffer, 0, data.data(), kBufferSize);
+
+        if (i % kBuffersPerHeap < 2) {
+            keptBuffers.push_back(buffer);
+            keptData.push_back(std::move(data));
+        } else {
+            buffer.Destroy();
+        }
+    }
+
+    WaitForAllOperations();
+    ResourceMemoryStats churnStats = GetStats();
+    EXPECT_GT(churnStats.sparseHeapCount, 0u);
+
+    for (uint32_t i = 0; i < ResourceMemoryAllocator::kMaxUnusedPoolIdleTaskCount; ++i) {
+        PerformIdleTasks();
+        EXPECT_EQ(GetStats().movedAllocationCount, churnStats.movedAllocationCount);
+    }
+    EXPECT_EQ(GetStats().heapCount, churnStats.heapCount);
+
+    for (size_t i = 0; i < keptBuffers.size(); ++i) {
+        EXPECT_BUFFER_U32_RANGE_EQ(keptData[i].data(), keptBuffers[i], 0, keptData[i].size());
+    }
+}
+
+// Test that moving buffers keeps their contents, including the writes that were still pending
+// when they were moved, and that commands encoded before the move but submitted after it use the
+// new memory.
+TEST_P(VulkanResourceMemoryTests, MovedBufferContents) {
+    std::vector<wgpu::Buffer> buffers = CreateBuffersInSparseHeaps(true);
+    uint32_t bufferCount = static_cast<uint32_t>(buffers.size());
+    uint64_t movedAllocationCount = GetStats().movedAllocationCount;
+
+    // Each buffer is written in quarters: the first one before the move, without waiting for the
+    // write, the second one after the move, and the third one with a copy from the first quarter
+    // of the previous buffer that is encoded before the move and submitted after it. The last
+    // quarter keeps the data written when the buffer was created.
+    constexpr uint64_t kQuarterSize = kBufferSize / 4;
+    constexpr size_t kQuarterCount = kQuarterSize / sizeof(uint32_t);
+    for (uint32_t i = 0; i < bufferCount; ++i) {
+        std::vector<uint32_t> data(kQuarterCount, 1000 + i);
+        queue.WriteBuffer(buffers[i], 0, data.data(), kQuarterSize);
+    }
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (uint32_t i = 0; i < bufferCount; ++i) {
+        encoder.CopyBufferToBuffer(buffers[i], 0, buffers[(i + 1) % bufferCount], 2 * kQuarterSize,
+                                   kQuarterSize);
+    }
+    wgpu::CommandBuffer commands = encoder.Finish();
+
+    native::PerformIdleTasks(device);
+    EXPECT_GT(GetStats().movedAllocationCount, movedAllocationCount);
+
+    for (uint32_t i = 0; i < bufferCount; ++i) {
+        std::vector<uint32_t> data(kQuarterCount, 2000 + i);
+        queue.WriteBuffer(buffers[i], kQuarterSize, data.data(), kQuarterSize);
+    }
+    queue.Submit(1, &commands);
+
+    for (uint32_t i = 0; i < bufferCount; ++i) {
+        uint32_t previous = (i + bufferCount - 1) % bufferCount;
+        for (uint32_t quarter = 0; quarter < 4; ++quarter) {
+            const uint32_t expectedValues[] = {1000 + i, 2000 + i, 1000 + previous, i};
+            std::vector<uint32_t> expected(kQuarterCount, expectedValues[quarter]);
+            EXPECT_BUFFER_U32_RANGE_EQ(expected.data(), buffers[i], quarter * kQuarterSize,
+                                       kQuarterCount);
+        }
+    }
+}
+
+// Test that buffers that were never initialized still read as zeros after they are moved, since
+// their contents aren't copied to the new memory.
+TEST_P(VulkanResourceMemoryTests, MovedUninitializedBufferReadsZeros) {
+    std::vector<wgpu::Buffer> buffers = CreateBuffersInSparseHeaps(false);
+    uint64_t movedAllocationCount = GetStats().movedAllocationCount;
+
+    PerformIdleTasks();
+    EXPECT_GT(GetStats().movedAllocationCount, movedAllocationCount);
+
+    std::vector<uint32_t> zeros(kBufferSize / sizeof(uint32_t), 0);
+    for (const wgpu::Buffer& buffer : buffers) {
+        EXPECT_BUFFER_U32_RANGE_EQ(zeros.data(), buffer, 0, zeros.size());
+    }
+}
+
+// Memory defragmentation is disabled by default.
+DAWN_INSTANTIATE_TEST(VulkanResourceMemoryTests,
+                      VulkanBackend({"vulkan_defragment_memory_on_idle"}));
+
+}  // anonymous namespace
+}  // namespace dawn::native::vulkan
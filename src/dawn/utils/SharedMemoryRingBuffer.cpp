@@ -0,0 +1,230 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/utils/SharedMemoryRingBuffer.h"
+
+#include <cstdint>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Platform.h"
+
+#if DAWN_PLATFORM_IS(LINUX)
+#include <fcntl.h>
+#include <linux/memfd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <limits>
+#endif
+
+namespace dawn::utils {
+
+class SharedMemoryRingBuffer::EventFdDoorbell : public wire::RingBufferDoorbell {
+  public:
+    EventFdDoorbell(int ringFd, int waitFd) : mRingFd(ringFd), mWaitFd(waitFd) {}
+
+#if DAWN_PLATFORM_IS(LINUX)
+    void Ring() override {
+        uint64_t value = 1;
+        while (write(mRingFd, &value, sizeof(value)) < 0 && errno == EINTR) {
+        }
+    }
+
+    bool Wait() override {
+        // Reading an eventfd blocks until it is non-zero, then resets it.
+        uint64_t value;
+        while (true) {
+            ssize_t result = read(mWaitFd, &value, sizeof(value));
+            if (result == sizeof(value)) {
+                return true;
+            }
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+    }
+#else
+    void Ring() override { DAWN_UNREACHABLE(); }
+    bool Wait() override { DAWN_UNREACHABLE(); }
+#endif
+
+  private:
+    int mRingFd;
+    int mWaitFd;
+};
+
+#if DAWN_PLATFORM_IS(LINUX)
+
+namespace {
+
+void CloseHandles(const SharedMemoryRingBufferHandles& handles) {
+    for (int fd : {handles.memoryFd, handles.commandsAvailableFd, handles.spaceAvailableFd}) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+// The ring memory is sealed so that neither process can resize it while the other has it mapped,
+// which would make accesses past the new end fault.
+constexpr int kMemorySeals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL;
+
+// Checks that the memory of |handles| can hold a ring of |handles.capacity| bytes, because the
+// handles can come from another process.
+bool ValidateHandles(const SharedMemoryRingBufferHandles& handles) {
+    // The ring is made of 8-byte aligned blocks.
+    if (handles.capacity == 0 || handles.capacity % sizeof(uint64_t) != 0 ||
+        handles.capacity > std::numeric_limits<size_t>::max() / 2) {
+        return false;
+    }
+
+    struct stat memoryStat;
+    if (fstat(handles.memoryFd, &memoryStat) != 0 || memoryStat.st_size < 0 ||
+        static_cast<uint64_t>(memoryStat.st_size) <
+            wire::GetRingBufferMemorySize(handles.capacity)) {
+        return false;
+    }
+
+    int seals = fcntl(handles.memoryFd, F_GET_SEALS);
+    return seals >= 0 && (seals & kMemorySeals) == kMemorySeals;
+}
+
+void* MapHandles(const SharedMemoryRingBufferHandles& handles) {
+    void* memory = mmap(nullptr, wire::GetRingBufferMemorySize(handles.capacity),
+                        PROT_READ | PROT_WRITE, MAP_SHARED, handles.memoryFd, 0);
+    return memory == MAP_FAILED ? nullptr : memory;
+}
+
+}  // anonymous namespace
+
+// static
+std::unique_ptr<SharedMemoryRingBuffer> SharedMemoryRingBuffer::Create(size_t capacity) {
+    SharedMemoryRingBufferHandles handles;
+    handles.capacity = capacity;
+    // Use the syscall directly because memfd_create is missing from older C libraries.
+    handles.memoryFd = static_cast<int>(
+        syscall(__NR_memfd_create, "dawn_wire_ring", MFD_CLOEXEC | MFD_ALLOW_SEALING));
+    handles.commandsAvailableFd = eventfd(0, EFD_CLOEXEC);
+    handles.spaceAvailableFd = eventfd(0, EFD_CLOEXEC);
+    if (handles.memoryFd < 0 || handles.commandsAvailableFd < 0 ||
+        handles.spaceAvailableFd < 0 ||
+        ftruncate(handles.memoryFd, wire::GetRingBufferMemorySize(capacity)) != 0 ||
+        fcntl(handles.memoryFd, F_ADD_SEALS, kMemorySeals) != 0) {
+        CloseHandles(handles);
+        return nullptr;
+    }
+
+    std::unique_ptr<SharedMemoryRingBuffer> ring = Import(handles);
+    if (ring != nullptr) {
+        wire::InitializeRingBuffer(ring->GetMemory(), capacity);
+    }
+    return ring;
+}
+
+// static
+std::unique_ptr<SharedMemoryRingBuffer> SharedMemoryRingBuffer::Import(
+    const SharedMemoryRingBufferHandles& handles) {
+    if (!ValidateHandles(handles)) {
+        CloseHandles(handles);
+        return nullptr;
+    }
+    void* memory = MapHandles(handles);
+    if (memory == nullptr) {
+        CloseHandles(handles);
+        return nullptr;
+    }
+    return std::unique_ptr<SharedMemoryRingBuffer>(new SharedMemoryRingBuffer(handles, memory));
+}
+
+SharedMemoryRingBuffer::~SharedMemoryRingBuffer() {
+    void* memory = mMemory;
+    mMemory = nullptr;
+    munmap(memory, wire::GetRingBufferMemorySize(mHandles.capacity));
+    CloseHandles(mHandles);
+}
+
+SharedMemoryRingBufferHandles SharedMemoryRingBuffer::DuplicateHandles() const {
+    SharedMemoryRingBufferHandles handles;
+    handles.memoryFd = dup(mHandles.memoryFd);
+    handles.commandsAvailableFd = dup(mHandles.commandsAvailableFd);
+    handles.spaceAvailableFd = dup(mHandles.spaceAvailableFd);
+    handles.capacity = mHandles.capacity;
+    return handles;
+}
+
+#else  // DAWN_PLATFORM_IS(LINUX)
+
+// static
+std::unique_ptr<SharedMemoryRingBuffer> SharedMemoryRingBuffer::Create(size_t capacity) {
+    return nullptr;
+}
+
+// static
+std::unique_ptr<SharedMemoryRingBuffer> SharedMemoryRingBuffer::Import(
+    const SharedMemoryRingBufferHandles& handles) {
+    return nullptr;
+}
+
+SharedMemoryRingBuffer::~SharedMemoryRingBuffer() = default;
+
+SharedMemoryRingBufferHandles SharedMemoryRingBuffer::DuplicateHandles() const {
+    DAWN_UNREACHABLE();
+}
+
+#endif  // DAWN_PLATFORM_IS(LINUX)
+
+SharedMemoryRingBuffer::SharedMemoryRingBuffer(const SharedMemoryRingBufferHandles& handles,
+                                               void* memory)
+    : mHandles(handles),
+      mMemory(memory),
+      mProducerDoorbell(std::make_unique<EventFdDoorbell>(handles.commandsAvailableFd,
+                                                          handles.spaceAvailableFd)),
+      mConsumerDoorbell(std::make_unique<EventFdDoorbell>(handles.spaceAvailableFd,
+                                                          handles.commandsAvailableFd)) {}
+
+void* SharedMemoryRingBuffer::GetMemory() const {
+    return mMemory;
+}
+
+size_t SharedMemoryRingBuffer::GetCapacity() const {
+    return mHandles.capacity;
+}
+
+wire::RingBufferDoorbell* SharedMemoryRingBuffer::GetProducerDoorbell() {
+    return mProducerDoorbell.get();
+}
+
+wire::RingBufferDoorbell* SharedMemoryRingBuffer::GetConsumerDoorbell() {
+    return mConsumerDoorbell.get();
+}
+
+}  // namespace dawn::utils
@@ -0,0 +1,84 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_UTILS_SHAREDMEMORYRINGBUFFER_H_
+#define SRC_DAWN_UTILS_SHAREDMEMORYRINGBUFFER_H_
+
+#include <cstddef>
+#include <memory>
+
+#include "dawn/wire/RingBufferTransport.h"
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn::utils {
+
+// File descriptors of a SharedMemoryRingBuffer, to be sent to the process at the other end.
+struct SharedMemoryRingBufferHandles {
+    int memoryFd = -1;
+    // Rung by the producer when commands are available.
+    int commandsAvailableFd = -1;
+    // Rung by the consumer when space is available.
+    int spaceAvailableFd = -1;
+    size_t capacity = 0;
+};
+
+// The shared memory and doorbells of a wire ring buffer, created with memfd and eventfd.
+class SharedMemoryRingBuffer {
+  public:
+    // Creates and initializes a ring with |capacity| bytes of commands. Returns nullptr on
+    // failure or if the platform isn't supported, which is anything but Linux and Android.
+    static std::unique_ptr<SharedMemoryRingBuffer> Create(size_t capacity);
+    // Maps a ring from handles returned by DuplicateHandles, and takes ownership of them. Returns
+    // nullptr if the memory isn't sealed against resizing or is too small for the capacity.
+    static std::unique_ptr<SharedMemoryRingBuffer> Import(
+        const SharedMemoryRingBufferHandles& handles);
+
+    ~SharedMemoryRingBuffer();
+
+    SharedMemoryRingBufferHandles DuplicateHandles() const;
+
+    void* GetMemory() const;
+    size_t GetCapacity() const;
+
+    // The producer's doorbell rings the consumer and waits for it, and conversely.
+    wire::RingBufferDoorbell* GetProducerDoorbell();
+    wire::RingBufferDoorbell* GetConsumerDoorbell();
+
+  private:
+    class EventFdDoorbell;
+
+    SharedMemoryRingBuffer(const SharedMemoryRingBufferHandles& handles, void* memory);
+
+    SharedMemoryRingBufferHandles mHandles;
+    raw_ptr<void> mMemory;
+    std::unique_ptr<EventFdDoorbell> mProducerDoorbell;
+    std::unique_ptr<EventFdDoorbell> mConsumerDoorbell;
+};
+
+}  // namespace dawn::utils
+
+#endif  // SRC_DAWN_UTILS_SHAREDMEMORYRINGBUFFER_H_
@@ -106,6 +106,9 @@ class ChunkedCommandSerializer {
             std::forward<Extensions>(extensions)...);
     }
 
+    // Flushes the commands serialized so far.
+    bool Flush() { return mSerializer->Flush(); }
+
   private:
     template <typename Cmd, typename SerializeCmdFn, typename... Extensions>
     void SerializeCommandImpl(const Cmd& cmd,
@@ -0,0 +1,481 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/wire/CompactEncoding.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "dawn/common/Alloc.h"
+#include "dawn/common/Assert.h"
+#include "dawn/wire/WireCmd_autogen.h"
+
+namespace dawn::wire {
+
+namespace {
+
+// "DWCF" in little endian.
+constexpr uint32_t kFrameMagic = 0x46435744;
+
+// Larger commands are sent as raw units so that the memory used by the history stays bounded.
+constexpr size_t kMaxDeltaCommandSize = 512;
+// Maximum number of command IDs tracked by the history.
+constexpr size_t kMaxHistorySize = 1024;
+// Every command starts with a CmdHeader and its ID, which delta units encode implicitly.
+constexpr size_t kCommandPrefixSize = sizeof(CmdHeader) + sizeof(uint32_t);
+
+constexpr size_t kMinStagingCapacity = 4096;
+
+// Raw units take at most 10 bytes more than their contents, and delta units at most 5 bytes per
+// 32-bit word, so a valid frame is never encoded in more than twice its decoded size.
+constexpr uint64_t kMaxCompactFramePayloadSize = 2 * kMaxCompactFrameDecodedSize;
+
+enum class UnitMode : uint64_t {
+    Raw = 0,
+    Delta = 1,
+};
+
+enum class CommandKind {
+    // Sets encoder state that stays the same until it is set again.
+    StateSetting,
+    // Uses the encoder state without changing it.
+    Draw,
+    // Anything else, which could change the encoder state or the objects it references.
+    Other,
+};
+
+CommandKind ClassifyCommand(uint32_t commandId) {
+    switch (static_cast<WireCmd>(commandId)) {
+        case WireCmd::ComputePassEncoderSetBindGroup:
+        case WireCmd::ComputePassEncoderSetPipeline:
+        case WireCmd::RenderBundleEncoderSetBindGroup:
+        case WireCmd::RenderBundleEncoderSetIndexBuffer:
+        case WireCmd::RenderBundleEncoderSetPipeline:
+        case WireCmd::RenderBundleEncoderSetVertexBuffer:
+        case WireCmd::RenderPassEncoderSetBindGroup:
+        case WireCmd::RenderPassEncoderSetBlendConstant:
+        case WireCmd::RenderPassEncoderSetIndexBuffer:
+        case WireCmd::RenderPassEncoderSetPipeline:
+        case WireCmd::RenderPassEncoderSetScissorRect:
+        case WireCmd::RenderPassEncoderSetStencilReference:
+        case WireCmd::RenderPassEncoderSetVertexBuffer:
+        case WireCmd::RenderPassEncoderSetViewport:
+            return CommandKind::StateSetting;
+
+        case WireCmd::ComputePassEncoderDispatchWorkgroups:
+        case WireCmd::ComputePassEncoderDispatchWorkgroupsIndirect:
+        case WireCmd::RenderBundleEncoderDraw:
+        case WireCmd::RenderBundleEncoderDrawIndexed:
+        case WireCmd::RenderBundleEncoderDrawIndexedIndirect:
+        case WireCmd::RenderBundleEncoderDrawIndirect:
+        case WireCmd::RenderPassEncoderDraw:
+        case WireCmd::RenderPassEncoderDrawIndexed:
+        case WireCmd::RenderPassEncoderDrawIndexedIndirect:
+        case WireCmd::RenderPassEncoderDrawIndirect:
+            return CommandKind::Draw;
+
+        default:
+            return CommandKind::Other;
+    }
+}
+
+void WriteVarint(std::vector<uint8_t>* out, uint64_t value) {
+    while (value >= 0x80) {
+        out->push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out->push_back(static_cast<uint8_t>(value));
+}
+
+bool ReadVarint(const uint8_t** data, const uint8_t* end, uint64_t* value) {
+    uint64_t result = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+        if (*data == end) {
+            return false;
+        }
+        uint8_t byte = **data;
+        (*data)++;
+        result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t ZigZagEncode(uint32_t delta) {
+    return (delta << 1) ^ static_cast<uint32_t>(static_cast<int32_t>(delta) >> 31);
+}
+
+uint32_t ZigZagDecode(uint32_t value) {
+    return (value >> 1) ^ (0u - (value & 1));
+}
+
+uint64_t MakeUnitTag(size_t size, UnitMode mode) {
+    return (static_cast<uint64_t>(size) << 1) | static_cast<uint64_t>(mode);
+}
+
+bool IsDeltaUnitSize(size_t size) {
+    return size >= kCommandPrefixSize && size <= kMaxDeltaCommandSize &&
+           size % sizeof(uint32_t) == 0;
+}
+
+uint32_t GetPreviousWord(const std::vector<uint32_t>& previous, size_t i) {
+    return i < previous.size() ? previous[i] : 0;
+}
+
+}  // anonymous namespace
+
+std::vector<uint32_t>* CompactCommandHistory::GetOrAdd(uint32_t commandId) {
+    auto it = mBodies.find(commandId);
+    if (it != mBodies.end()) {
+        return &it->second;
+    }
+    if (mBodies.size() >= kMaxHistorySize) {
+        return nullptr;
+    }
+    return &mBodies[commandId];
+}
+
+CompactEncoder::CompactEncoder(const CompactCommandSerializerDescriptor& descriptor)
+    : mSerializer(descriptor.serializer),
+      mElideRedundantCommands(descriptor.elideRedundantCommands),
+      mMaxAllocationSize(std::min(descriptor.serializer->GetMaximumAllocationSize(),
+                                  static_cast<size_t>(kMaxCompactFrameDecodedSize))) {}
+
+CompactEncoder::~CompactEncoder() = default;
+
+void* CompactEncoder::GetCmdSpace(size_t size) {
+    if (size > mMaxAllocationSize) {
+        return nullptr;
+    }
+
+    // Staging never holds more than an allocation of the wrapped serializer so that command
+    // chunks, which use the maximum allocation size, always end a frame.
+    if (size > mMaxAllocationSize - mStagingSize) {
+        if (!WriteFrame()) {
+            return nullptr;
+        }
+    }
+
+    if (mStaging == nullptr || size > mStagingCapacity - mStagingSize) {
+        size_t capacity =
+            std::max({mStagingCapacity * 2, mStagingSize + size, kMinStagingCapacity});
+        capacity = std::min(capacity, mMaxAllocationSize);
+        std::unique_ptr<char[]> staging(AllocNoThrow<char>(capacity));
+        if (staging == nullptr) {
+            return nullptr;
+        }
+        if (mStagingSize > 0) {
+            memcpy(staging.get(), mStaging.get(), mStagingSize);
+        }
+        mStaging = std::move(staging);
+        mStagingCapacity = capacity;
+    }
+
+    char* result = mStaging.get() + mStagingSize;
+    mStagingSize += size;
+    mUnitSizes.push_back(size);
+    return result;
+}
+
+bool CompactEncoder::Flush() {
+    if (!WriteFrame()) {
+        return false;
+    }
+    return mSerializer->Flush();
+}
+
+size_t CompactEncoder::GetMaximumAllocationSize() const {
+    return mMaxAllocationSize;
+}
+
+void CompactEncoder::OnSerializeError() {
+    mSerializer->OnSerializeError();
+}
+
+CompactEncodingStats CompactEncoder::GetStats() const {
+    return mStats;
+}
+
+bool CompactEncoder::WriteFrame() {
+    if (mUnitSizes.empty()) {
+        return true;
+    }
+
+    mFrame.resize(sizeof(CompactFrameHeader));
+    mFrameDecodedSize = 0;
+    const char* unit = mStaging.get();
+    for (size_t size : mUnitSizes) {
+        EncodeUnit(unit, size);
+        unit += size;
+    }
+    mStats.decodedBytes += mStagingSize;
+    mStagingSize = 0;
+    mUnitSizes.clear();
+
+    // All the commands of the frame were elided.
+    if (mFrame.size() == sizeof(CompactFrameHeader)) {
+        return true;
+    }
+
+    CompactFrameHeader header;
+    header.magic = kFrameMagic;
+    header.version = kCompactEncodingVersion;
+    header.payloadSize = mFrame.size() - sizeof(CompactFrameHeader);
+    header.decodedSize = mFrameDecodedSize;
+    memcpy(mFrame.data(), &header, sizeof(header));
+    mStats.encodedBytes += mFrame.size();
+
+    // The frame can be larger than an allocation of the wrapped serializer, in which case it is
+    // split and reassembled by the decoder.
+    const uint8_t* data = mFrame.data();
+    size_t remainingSize = mFrame.size();
+    while (remainingSize > 0) {
+        size_t chunkSize = std::min(remainingSize, mMaxAllocationSize);
+        void* dst = mSerializer->GetCmdSpace(chunkSize);
+        if (dst == nullptr) {
+            return false;
+        }
+        memcpy(dst, data, chunkSize);
+        data += chunkSize;
+        remainingSize -= chunkSize;
+    }
+    return true;
+}
+
+void CompactEncoder::EncodeUnit(const char* unit, size_t size) {
+    if (EncodeDeltaUnit(unit, size)) {
+        return;
+    }
+
+    // Raw units can be anything, including part of a command that changes the encoder state.
+    mStateEpoch++;
+    WriteVarint(&mFrame, MakeUnitTag(size, UnitMode::Raw));
+    mFrame.insert(mFrame.end(), reinterpret_cast<const uint8_t*>(unit),
+                  reinterpret_cast<const uint8_t*>(unit) + size);
+    mFrameDecodedSize += size;
+}
+
+bool CompactEncoder::EncodeDeltaUnit(const char* unit, size_t size) {
+    if (!IsDeltaUnitSize(size)) {
+        return false;
+    }
+
+    // The first chunk of a chunked command is smaller than the command.
+    CmdHeader header;
+    memcpy(&header, unit, sizeof(header));
+    if (header.commandSize != size) {
+        return false;
+    }
+
+    uint32_t commandId;
+    memcpy(&commandId, unit + sizeof(CmdHeader), sizeof(commandId));
+    std::vector<uint32_t>* previous = mHistory.GetOrAdd(commandId);
+    if (previous == nullptr) {
+        return false;
+    }
+
+    size_t wordCount = (size - kCommandPrefixSize) / sizeof(uint32_t);
+    mBody.resize(wordCount);
+    memcpy(mBody.data(), unit + kCommandPrefixSize, wordCount * sizeof(uint32_t));
+
+    if (mElideRedundantCommands) {
+        switch (ClassifyCommand(commandId)) {
+            case CommandKind::StateSetting: {
+                // The command is redundant if the previous one with the same ID, which sets the
+                // same state on the same encoder, is identical and nothing changed the encoder
+                // state since then.
+                auto [it, inserted] = mLastStateEpoch.try_emplace(commandId, mStateEpoch);
+                if (!inserted && it->second == mStateEpoch && *previous == mBody) {
+                    mStats.elidedCommands++;
+                    return true;
+                }
+                it->second = mStateEpoch;
+                break;
+            }
+            case CommandKind::Draw:
+                break;
+            case CommandKind::Other:
+                mStateEpoch++;
+                break;
+        }
+    }
+
+    WriteVarint(&mFrame, MakeUnitTag(size, UnitMode::Delta));
+    WriteVarint(&mFrame, commandId);
+
+    size_t unchangedRun = 0;
+    for (size_t i = 0; i < wordCount; ++i) {
+        uint32_t delta = mBody[i] - GetPreviousWord(*previous, i);
+        if (delta == 0) {
+            unchangedRun++;
+            continue;
+        }
+        if (unchangedRun > 0) {
+            WriteVarint(&mFrame, 0);
+            WriteVarint(&mFrame, unchangedRun - 1);
+            unchangedRun = 0;
+        }
+        WriteVarint(&mFrame, ZigZagEncode(delta));
+    }
+    if (unchangedRun > 0) {
+        WriteVarint(&mFrame, 0);
+        WriteVarint(&mFrame, unchangedRun - 1);
+    }
+
+    std::swap(*previous, mBody);
+    mFrameDecodedSize += size;
+    return true;
+}
+
+CompactDecoder::CompactDecoder(CommandHandler* handler) : mHandler(handler) {}
+
+CompactDecoder::~CompactDecoder() = default;
+
+const volatile char* CompactDecoder::HandleCommands(const volatile char* commands, size_t size) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(const_cast<const char*>(commands));
+    mPending.insert(mPending.end(), data, data + size);
+
+    size_t offset = 0;
+    while (mPending.size() - offset >= sizeof(CompactFrameHeader)) {
+        CompactFrameHeader header;
+        memcpy(&header, mPending.data() + offset, sizeof(header));
+        if (header.magic != kFrameMagic || header.version != kCompactEncodingVersion) {
+            return nullptr;
+        }
+        // Reject oversized frames before buffering their payload or allocating their contents.
+        if (header.payloadSize > kMaxCompactFramePayloadSize ||
+            header.decodedSize > kMaxCompactFrameDecodedSize) {
+            return nullptr;
+        }
+
+        size_t availableSize = mPending.size() - offset - sizeof(header);
+        if (header.payloadSize > availableSize) {
+            break;
+        }
+        size_t payloadSize = static_cast<size_t>(header.payloadSize);
+
+        if (!DecodeFrame(mPending.data() + offset + sizeof(header), payloadSize,
+                         header.decodedSize)) {
+            return nullptr;
+        }
+        offset += sizeof(header) + payloadSize;
+
+        if (mHandler->HandleCommands(mDecoded.data(), mDecoded.size()) == nullptr) {
+            return nullptr;
+        }
+    }
+    mPending.erase(mPending.begin(), mPending.begin() + offset);
+
+    return commands + size;
+}
+
+bool CompactDecoder::DecodeFrame(const uint8_t* payload, size_t payloadSize, uint64_t decodedSize) {
+    mDecoded.clear();
+
+    const uint8_t* data = payload;
+    const uint8_t* end = payload + payloadSize;
+    while (data != end) {
+        uint64_t tag;
+        if (!ReadVarint(&data, end, &tag)) {
+            return false;
+        }
+        uint64_t unitSize = tag >> 1;
+        if (unitSize > decodedSize - mDecoded.size()) {
+            return false;
+        }
+        size_t size = static_cast<size_t>(unitSize);
+
+        if ((tag & 1) == static_cast<uint64_t>(UnitMode::Raw)) {
+            if (size > static_cast<size_t>(end - data)) {
+                return false;
+            }
+            mDecoded.insert(mDecoded.end(), reinterpret_cast<const char*>(data),
+                            reinterpret_cast<const char*>(data) + size);
+            data += size;
+            continue;
+        }
+
+        if (!IsDeltaUnitSize(size)) {
+            return false;
+        }
+        uint64_t commandId;
+        if (!ReadVarint(&data, end, &commandId) ||
+            commandId > std::numeric_limits<uint32_t>::max()) {
+            return false;
+        }
+        std::vector<uint32_t>* previous = mHistory.GetOrAdd(static_cast<uint32_t>(commandId));
+        if (previous == nullptr) {
+            return false;
+        }
+
+        size_t wordCount = (size - kCommandPrefixSize) / sizeof(uint32_t);
+        mBody.resize(wordCount);
+        for (size_t i = 0; i < wordCount;) {
+            uint64_t token;
+            if (!ReadVarint(&data, end, &token)) {
+                return false;
+            }
+            if (token == 0) {
+                uint64_t unchangedRun;
+                if (!ReadVarint(&data, end, &unchangedRun) || unchangedRun >= wordCount - i) {
+                    return false;
+                }
+                for (uint64_t j = 0; j <= unchangedRun; ++j, ++i) {
+                    mBody[i] = GetPreviousWord(*previous, i);
+                }
+                continue;
+            }
+            if (token > std::numeric_limits<uint32_t>::max()) {
+                return false;
+            }
+            mBody[i] = GetPreviousWord(*previous, i) + ZigZagDecode(static_cast<uint32_t>(token));
+            ++i;
+        }
+
+        CmdHeader header;
+        header.commandSize = size;
+        uint32_t id = static_cast<uint32_t>(commandId);
+
+        size_t unitOffset = mDecoded.size();
+        mDecoded.resize(unitOffset + size);
+        char* unit = mDecoded.data() + unitOffset;
+        memcpy(unit, &header, sizeof(header));
+        memcpy(unit + sizeof(CmdHeader), &id, sizeof(id));
+        memcpy(unit + kCommandPrefixSize, mBody.data(), wordCount * sizeof(uint32_t));
+
+        std::swap(*previous, mBody);
+    }
+
+    return mDecoded.size() == decodedSize;
+}
+
+}  // namespace dawn::wire
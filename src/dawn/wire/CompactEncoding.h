@@ -0,0 +1,135 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_WIRE_COMPACTENCODING_H_
+#define SRC_DAWN_WIRE_COMPACTENCODING_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "dawn/wire/Wire.h"
+#include "dawn/wire/WireCompactEncoding.h"
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn::wire {
+
+// The compact stream is a sequence of frames, each starting with a FrameHeader followed by
+// |payloadSize| bytes of encoded units. Each unit is one allocation made with GetCmdSpace, and
+// the decoder hands all the units of a frame to its handler in a single HandleCommands call so
+// that chunked commands keep the same boundaries as without the compact encoding.
+//
+// A unit starts with a varint tag containing its size and mode:
+//  - Raw units are followed by their bytes. They are used for command chunks and for commands
+//    that don't benefit from the delta encoding.
+//  - Delta units contain a single command. The tag is followed by the varint command ID and by
+//    one token per 32-bit word of the command body, coded as the zigzag varint of the difference
+//    with the same word of the previous command with that ID. Runs of unchanged words are coded
+//    as a zero followed by the varint run length minus one.
+struct CompactFrameHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t payloadSize;
+    uint64_t decodedSize;
+};
+
+// Previous command body for each command ID, shared by the encoder and the decoder so that both
+// stay in sync.
+class CompactCommandHistory {
+  public:
+    // Returns the previous body for |commandId|, or nullptr if the history is full and doesn't
+    // already track |commandId|.
+    std::vector<uint32_t>* GetOrAdd(uint32_t commandId);
+
+  private:
+    absl::flat_hash_map<uint32_t, std::vector<uint32_t>> mBodies;
+};
+
+class CompactEncoder {
+  public:
+    explicit CompactEncoder(const CompactCommandSerializerDescriptor& descriptor);
+    ~CompactEncoder();
+
+    void* GetCmdSpace(size_t size);
+    bool Flush();
+    size_t GetMaximumAllocationSize() const;
+    void OnSerializeError();
+
+    CompactEncodingStats GetStats() const;
+
+  private:
+    // Encodes all the staged units in a frame and writes it to the wrapped serializer.
+    bool WriteFrame();
+    void EncodeUnit(const char* unit, size_t size);
+    bool EncodeDeltaUnit(const char* unit, size_t size);
+
+    raw_ptr<CommandSerializer> mSerializer;
+    const bool mElideRedundantCommands;
+    const size_t mMaxAllocationSize;
+
+    std::unique_ptr<char[]> mStaging;
+    size_t mStagingCapacity = 0;
+    size_t mStagingSize = 0;
+    std::vector<size_t> mUnitSizes;
+
+    std::vector<uint8_t> mFrame;
+    size_t mFrameDecodedSize = 0;
+    std::vector<uint32_t> mBody;
+    CompactCommandHistory mHistory;
+
+    // Incremented on every command that could change the state of an encoder. A state-setting
+    // command can only be elided if the previous one was sent in the same epoch.
+    uint64_t mStateEpoch = 0;
+    absl::flat_hash_map<uint32_t, uint64_t> mLastStateEpoch;
+
+    CompactEncodingStats mStats;
+};
+
+class CompactDecoder {
+  public:
+    explicit CompactDecoder(CommandHandler* handler);
+    ~CompactDecoder();
+
+    const volatile char* HandleCommands(const volatile char* commands, size_t size);
+
+  private:
+    bool DecodeFrame(const uint8_t* payload, size_t payloadSize, uint64_t decodedSize);
+
+    raw_ptr<CommandHandler> mHandler;
+
+    // Frames can be split across multiple calls to HandleCommands. The incoming data is copied
+    // here first, which also guarantees it isn't modified while it is being decoded.
+    std::vector<uint8_t> mPending;
+    std::vector<char> mDecoded;
+    std::vector<uint32_t> mBody;
+    CompactCommandHistory mHistory;
+};
+
+}  // namespace dawn::wire
+
+#endif  // SRC_DAWN_WIRE_COMPACTENCODING_H_
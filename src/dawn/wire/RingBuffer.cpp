@@ -0,0 +1,227 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/wire/RingBuffer.h"
+
+#include <limits>
+#include <new>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Constants.h"
+#include "dawn/common/Math.h"
+
+namespace dawn::wire {
+
+namespace {
+
+constexpr uint64_t kBlockHeaderSize = sizeof(uint64_t);
+constexpr uint64_t kWrapMarker = std::numeric_limits<uint64_t>::max();
+
+RingBufferHeader* GetHeader(void* memory) {
+    return static_cast<RingBufferHeader*>(memory);
+}
+
+char* GetData(void* memory) {
+    return static_cast<char*>(memory) + sizeof(RingBufferHeader);
+}
+
+}  // anonymous namespace
+
+size_t GetRingBufferMemorySize(size_t capacity) {
+    DAWN_ASSERT(capacity % kBlockHeaderSize == 0);
+    return sizeof(RingBufferHeader) + capacity;
+}
+
+void InitializeRingBuffer(void* memory, size_t capacity) {
+    DAWN_ASSERT(capacity % kBlockHeaderSize == 0);
+    RingBufferHeader* header = new (memory) RingBufferHeader();
+    header->writePosition.store(0, std::memory_order_relaxed);
+    header->readPosition.store(0, std::memory_order_release);
+}
+
+RingBufferProducer::RingBufferProducer(void* memory,
+                                       size_t capacity,
+                                       RingBufferDoorbell* doorbell)
+    : mHeader(GetHeader(memory)), mData(GetData(memory)), mCapacity(capacity), mDoorbell(doorbell) {
+    DAWN_ASSERT(mCapacity % kBlockHeaderSize == 0);
+}
+
+RingBufferProducer::~RingBufferProducer() = default;
+
+size_t RingBufferProducer::GetMaximumAllocationSize() const {
+    // Any allocation, including the block header and the space skipped at the end of the ring,
+    // fits in an empty ring.
+    return static_cast<size_t>(mCapacity / 2 - kBlockHeaderSize);
+}
+
+void* RingBufferProducer::GetCmdSpace(size_t size) {
+    if (size > GetMaximumAllocationSize()) {
+        return nullptr;
+    }
+
+    while (true) {
+        uint64_t readPosition = mHeader->readPosition.load(std::memory_order_acquire);
+        if (readPosition > mWritePosition || mWritePosition - readPosition > mCapacity) {
+            return nullptr;
+        }
+        uint64_t freeSize = mCapacity - (mWritePosition - readPosition);
+
+        if (mHasOpenBlock) {
+            // Append to the current block if the allocation fits before the end of the ring.
+            uint64_t blockEnd = mBlockPosition % mCapacity + (mWritePosition - mBlockPosition);
+            if (blockEnd + size > mCapacity) {
+                CloseBlock();
+                continue;
+            }
+            if (Align(mWritePosition + size, kBlockHeaderSize) - mWritePosition <= freeSize) {
+                char* result = mData + blockEnd;
+                mWritePosition += size;
+                return result;
+            }
+        } else {
+            // Start a new block, skipping the end of the ring if the allocation doesn't fit.
+            uint64_t offset = mWritePosition % mCapacity;
+            uint64_t requiredSize = kBlockHeaderSize + Align(static_cast<uint64_t>(size), kBlockHeaderSize);
+            uint64_t skippedSize = mCapacity - offset < requiredSize ? mCapacity - offset : 0;
+            if (skippedSize + requiredSize <= freeSize) {
+                if (skippedSize > 0) {
+                    *reinterpret_cast<uint64_t*>(mData + offset) = kWrapMarker;
+                    mWritePosition += skippedSize;
+                    offset = 0;
+                }
+                mBlockPosition = mWritePosition;
+                mHasOpenBlock = true;
+                mWritePosition += kBlockHeaderSize + size;
+                return mData + offset + kBlockHeaderSize;
+            }
+        }
+
+        // The ring is full. Publish the commands so the consumer can make progress and wait for
+        // it to free some space.
+        Publish();
+        mDoorbell->Ring();
+        if (!mDoorbell->Wait()) {
+            return nullptr;
+        }
+    }
+}
+
+bool RingBufferProducer::Flush() {
+    if (Publish()) {
+        mDoorbell->Ring();
+    }
+    return true;
+}
+
+void RingBufferProducer::CloseBlock() {
+    if (!mHasOpenBlock) {
+        return;
+    }
+    uint64_t blockSize = mWritePosition - mBlockPosition - kBlockHeaderSize;
+    *reinterpret_cast<uint64_t*>(mData + mBlockPosition % mCapacity) = blockSize;
+    mWritePosition = Align(mWritePosition, kBlockHeaderSize);
+    mHasOpenBlock = false;
+}
+
+bool RingBufferProducer::Publish() {
+    CloseBlock();
+    if (mWritePosition == mPublishedPosition) {
+        return false;
+    }
+    mHeader->writePosition.store(mWritePosition, std::memory_order_release);
+    mPublishedPosition = mWritePosition;
+    return true;
+}
+
+RingBufferConsumer::RingBufferConsumer(void* memory,
+                                       size_t capacity,
+                                       CommandHandler* handler,
+                                       RingBufferDoorbell* doorbell)
+    : mHeader(GetHeader(memory)),
+      mData(GetData(memory)),
+      mCapacity(capacity),
+      mHandler(handler),
+      mDoorbell(doorbell) {
+    DAWN_ASSERT(mCapacity % kBlockHeaderSize == 0);
+}
+
+RingBufferConsumer::~RingBufferConsumer() = default;
+
+bool RingBufferConsumer::ProcessCommands() {
+    uint64_t writePosition = mHeader->writePosition.load(std::memory_order_acquire);
+    if (writePosition < mReadPosition || writePosition - mReadPosition > mCapacity) {
+        return false;
+    }
+    if (writePosition == mReadPosition) {
+        return true;
+    }
+
+    while (mReadPosition != writePosition) {
+        uint64_t offset = mReadPosition % mCapacity;
+        uint64_t availableSize = writePosition - mReadPosition;
+        uint64_t tailSize = mCapacity - offset;
+        if (availableSize < kBlockHeaderSize) {
+            return false;
+        }
+
+        // The producer can modify the shared memory at any time, so the block size is read only
+        // once and validated before use.
+        const volatile char* block = mData + offset;
+        uint64_t blockSize = *reinterpret_cast<const volatile uint64_t*>(block);
+
+        if (blockSize == kWrapMarker) {
+            if (tailSize > availableSize) {
+                return false;
+            }
+            mReadPosition += tailSize;
+            continue;
+        }
+
+        if (blockSize > tailSize - kBlockHeaderSize) {
+            return false;
+        }
+        uint64_t paddedSize = kBlockHeaderSize + Align(blockSize, kBlockHeaderSize);
+        if (paddedSize > availableSize) {
+            return false;
+        }
+        if (mHandler->HandleCommands(block + kBlockHeaderSize, static_cast<size_t>(blockSize)) ==
+            nullptr) {
+            return false;
+        }
+
+        // Free the block right away so that the producer can reuse it while the next one is
+        // handled.
+        mReadPosition += paddedSize;
+        mHeader->readPosition.store(mReadPosition, std::memory_order_release);
+    }
+
+    mHeader->readPosition.store(mReadPosition, std::memory_order_release);
+    mDoorbell->Ring();
+    return true;
+}
+
+}  // namespace dawn::wire
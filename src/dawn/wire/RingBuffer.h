@@ -0,0 +1,106 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_WIRE_RINGBUFFER_H_
+#define SRC_DAWN_WIRE_RINGBUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "dawn/wire/RingBufferTransport.h"
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn::wire {
+
+// The shared memory of a ring starts with a RingBufferHeader followed by |capacity| bytes of
+// blocks. Each block is a uint64_t size followed by that many bytes of commands and is padded to
+// 8 bytes. Blocks never wrap around the end of the ring: when the next block doesn't fit, the
+// producer writes kWrapMarker instead of a size and continues at the start of the ring.
+// Positions are monotonically increasing byte counts, and wrap at |capacity| in the ring.
+struct RingBufferHeader {
+    // Position up to which the producer published blocks.
+    std::atomic<uint64_t> writePosition;
+    char padding0[56];
+    // Position up to which the consumer handled blocks.
+    std::atomic<uint64_t> readPosition;
+    char padding1[56];
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "The ring buffer needs address-free atomics to work across processes.");
+
+class RingBufferProducer {
+  public:
+    RingBufferProducer(void* memory, size_t capacity, RingBufferDoorbell* doorbell);
+    ~RingBufferProducer();
+
+    void* GetCmdSpace(size_t size);
+    bool Flush();
+    size_t GetMaximumAllocationSize() const;
+
+  private:
+    // Writes the size of the block being allocated, after which allocations start a new block.
+    void CloseBlock();
+    // Makes the allocated commands visible to the consumer. Returns whether there were any.
+    bool Publish();
+
+    raw_ptr<RingBufferHeader> mHeader;
+    raw_ptr<char, AllowPtrArithmetic> mData;
+    const uint64_t mCapacity;
+    raw_ptr<RingBufferDoorbell> mDoorbell;
+
+    // End of the allocated commands, which is ahead of the published position.
+    uint64_t mWritePosition = 0;
+    uint64_t mPublishedPosition = 0;
+    // Start of the block being allocated, if there is one.
+    uint64_t mBlockPosition = 0;
+    bool mHasOpenBlock = false;
+};
+
+class RingBufferConsumer {
+  public:
+    RingBufferConsumer(void* memory,
+                       size_t capacity,
+                       CommandHandler* handler,
+                       RingBufferDoorbell* doorbell);
+    ~RingBufferConsumer();
+
+    bool ProcessCommands();
+
+  private:
+    raw_ptr<RingBufferHeader> mHeader;
+    raw_ptr<char, AllowPtrArithmetic> mData;
+    const uint64_t mCapacity;
+    raw_ptr<CommandHandler> mHandler;
+    raw_ptr<RingBufferDoorbell> mDoorbell;
+
+    // The consumer keeps its own read position because the shared memory can't be trusted.
+    uint64_t mReadPosition = 0;
+};
+
+}  // namespace dawn::wire
+
+#endif  // SRC_DAWN_WIRE_RINGBUFFER_H_
@@ -0,0 +1,72 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/wire/RingBufferTransport.h"
+#include "dawn/wire/RingBuffer.h"
+
+namespace dawn::wire {
+
+RingBufferDoorbell::RingBufferDoorbell() = default;
+
+RingBufferDoorbell::~RingBufferDoorbell() = default;
+
+RingBufferCommandSerializer::RingBufferCommandSerializer(void* memory,
+                                                         size_t capacity,
+                                                         RingBufferDoorbell* doorbell)
+    : mImpl(new RingBufferProducer(memory, capacity, doorbell)) {}
+
+RingBufferCommandSerializer::~RingBufferCommandSerializer() {
+    mImpl.reset();
+}
+
+void* RingBufferCommandSerializer::GetCmdSpace(size_t size) {
+    return mImpl->GetCmdSpace(size);
+}
+
+bool RingBufferCommandSerializer::Flush() {
+    return mImpl->Flush();
+}
+
+size_t RingBufferCommandSerializer::GetMaximumAllocationSize() const {
+    return mImpl->GetMaximumAllocationSize();
+}
+
+RingBufferCommandReader::RingBufferCommandReader(void* memory,
+                                                 size_t capacity,
+                                                 CommandHandler* handler,
+                                                 RingBufferDoorbell* doorbell)
+    : mImpl(new RingBufferConsumer(memory, capacity, handler, doorbell)) {}
+
+RingBufferCommandReader::~RingBufferCommandReader() {
+    mImpl.reset();
+}
+
+bool RingBufferCommandReader::ProcessCommands() {
+    return mImpl->ProcessCommands();
+}
+
+}  // namespace dawn::wire
@@ -0,0 +1,73 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/wire/WireCompactEncoding.h"
+#include "dawn/wire/CompactEncoding.h"
+
+namespace dawn::wire {
+
+CompactCommandSerializer::CompactCommandSerializer(
+    const CompactCommandSerializerDescriptor& descriptor)
+    : mImpl(new CompactEncoder(descriptor)) {}
+
+CompactCommandSerializer::~CompactCommandSerializer() {
+    mImpl.reset();
+}
+
+void* CompactCommandSerializer::GetCmdSpace(size_t size) {
+    return mImpl->GetCmdSpace(size);
+}
+
+bool CompactCommandSerializer::Flush() {
+    return mImpl->Flush();
+}
+
+size_t CompactCommandSerializer::GetMaximumAllocationSize() const {
+    return mImpl->GetMaximumAllocationSize();
+}
+
+void CompactCommandSerializer::OnSerializeError() {
+    mImpl->OnSerializeError();
+}
+
+CompactEncodingStats CompactCommandSerializer::GetStats() const {
+    return mImpl->GetStats();
+}
+
+CompactCommandHandler::CompactCommandHandler(CommandHandler* handler)
+    : mImpl(new CompactDecoder(handler)) {}
+
+CompactCommandHandler::~CompactCommandHandler() {
+    mImpl.reset();
+}
+
+const volatile char* CompactCommandHandler::HandleCommands(const volatile char* commands,
+                                                           size_t size) {
+    return mImpl->HandleCommands(commands, size);
+}
+
+}  // namespace dawn::wire
@@ -33,9 +33,11 @@ namespace dawn::wire {
 WireServer::WireServer(const WireServerDescriptor& descriptor)
     : mImpl(server::Server::Create(*descriptor.procs,
                                    descriptor.serializer,
-                                   descriptor.memoryTransferService)) {}
+                                   descriptor.memoryTransferService,
+                                   descriptor.deviceCommandThreadCount)) {}
 
 WireServer::~WireServer() {
+    mImpl->StopDispatchingCommands();
     mImpl.reset();
 }
 
@@ -71,6 +73,10 @@ bool WireServer::IsDeviceKnown(WGPUDevice device) const {
     return mImpl->IsDeviceKnown(device);
 }
 
+bool WireServer::WaitForDispatchedCommands(bool flushReplies) {
+    return mImpl->WaitForDispatchedCommands(flushReplies);
+}
+
 namespace server {
 MemoryTransferService::MemoryTransferService() = default;
 
@@ -0,0 +1,356 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/wire/server/DeviceCommandDispatcher.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "dawn/common/Assert.h"
+#include "dawn/wire/server/Server.h"
+
+namespace dawn::wire::server {
+
+void CommandObjects::Clear() {
+    target.reset();
+    used.clear();
+    created.clear();
+}
+
+DeviceCommandDispatcher::DeviceCommandDispatcher(Server* server, uint32_t threadCount)
+    : mServer(server), mSharedLane(std::make_unique<Lane>()) {
+    DAWN_ASSERT(threadCount > 0);
+
+    // Reserve ID 0 like KnownObjects does since it represents nullptr.
+    for (std::vector<ObjectRoute>& routes : mRoutes) {
+        routes.resize(1);
+    }
+    mLanes.push_back(mSharedLane.get());
+
+    mThreads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        mThreads.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+DeviceCommandDispatcher::~DeviceCommandDispatcher() {
+    Stop();
+}
+
+DeviceCommandDispatcher::ObjectRoute* DeviceCommandDispatcher::FindRoute(ObjectReference object) {
+    if (static_cast<uint32_t>(object.type) >= kObjectTypes) {
+        return nullptr;
+    }
+    std::vector<ObjectRoute>& routes = mRoutes[object.type];
+    if (object.id == 0 || object.id >= routes.size()) {
+        return nullptr;
+    }
+    return &routes[object.id];
+}
+
+DeviceCommandDispatcher::Lane* DeviceCommandDispatcher::GetOrCreateDeviceLane(ObjectId device) {
+    auto [it, inserted] = mDeviceLanes.try_emplace(device);
+    if (inserted) {
+        it->second = std::make_unique<Lane>();
+        std::lock_guard<std::mutex> lock(mMutex);
+        mLanes.push_back(it->second.get());
+    }
+    return it->second.get();
+}
+
+DeviceCommandDispatcher::Lane* DeviceCommandDispatcher::SelectLane(const CommandObjects& objects) {
+    if (objects.target) {
+        ObjectRoute* route = FindRoute(*objects.target);
+        if (route != nullptr && route->owner != nullptr) {
+            return route->owner;
+        }
+    }
+
+    // Commands on objects that don't belong to a device, like Surface::GetCurrentTexture, go to
+    // the lane of the device they use if any.
+    for (const ObjectReference& object : objects.used) {
+        if (object.type != ObjectType::Device) {
+            continue;
+        }
+        ObjectRoute* route = FindRoute(object);
+        if (route != nullptr && route->owner != nullptr) {
+            return route->owner;
+        }
+    }
+    return mSharedLane.get();
+}
+
+void DeviceCommandDispatcher::AddDependency(Lane* lane, ObjectReference object) {
+    ObjectRoute* route = FindRoute(object);
+    if (route == nullptr || route->lastUse.lane == nullptr || route->lastUse.lane == lane) {
+        return;
+    }
+
+    for (TaskPosition& dependency : mDependencies) {
+        if (dependency.lane == route->lastUse.lane) {
+            dependency.index = std::max(dependency.index, route->lastUse.index);
+            return;
+        }
+    }
+    mDependencies.push_back(route->lastUse);
+}
+
+void DeviceCommandDispatcher::RecordUse(TaskPosition position, ObjectReference object) {
+    ObjectRoute* route = FindRoute(object);
+    if (route != nullptr) {
+        route->lastUse = position;
+    }
+}
+
+WireResult DeviceCommandDispatcher::Dispatch(const char* command,
+                                             size_t size,
+                                             const CommandObjects& objects) {
+    // Created objects must use the next ID or reuse one, like in KnownObjects::Allocate.
+    for (const ObjectReference& object : objects.created) {
+        if (static_cast<uint32_t>(object.type) >= kObjectTypes) {
+            return WireResult::FatalError;
+        }
+        std::vector<ObjectRoute>& routes = mRoutes[object.type];
+        if (object.id == 0 || object.id > routes.size()) {
+            return WireResult::FatalError;
+        }
+        if (object.id == routes.size()) {
+            routes.emplace_back();
+        }
+    }
+
+    Lane* lane = SelectLane(objects);
+
+    mDependencies.clear();
+    if (objects.target) {
+        AddDependency(lane, *objects.target);
+    }
+    for (const ObjectReference& object : objects.used) {
+        AddDependency(lane, object);
+    }
+    for (const ObjectReference& object : objects.created) {
+        AddDependency(lane, object);
+    }
+
+    // Dependencies are only waited on before a task starts, so a command with dependencies
+    // starts a new task. The tasks it depends on are closed so that they don't get commands
+    // dispatched after this one, which could in turn depend on it.
+    if (lane->openTask == nullptr || !mDependencies.empty()) {
+        CloseOpenTask(lane);
+        lane->openTask = std::make_unique<Task>();
+        lane->openTask->dependencies = mDependencies;
+        lane->taskCount++;
+
+        for (const TaskPosition& dependency : mDependencies) {
+            if (dependency.index + 1 == dependency.lane->taskCount) {
+                CloseOpenTask(dependency.lane);
+            }
+        }
+    }
+    lane->openTask->commands.insert(lane->openTask->commands.end(), command, command + size);
+
+    TaskPosition position = {lane, lane->taskCount - 1};
+    if (objects.target) {
+        RecordUse(position, *objects.target);
+    }
+    for (const ObjectReference& object : objects.used) {
+        RecordUse(position, object);
+    }
+    for (const ObjectReference& object : objects.created) {
+        ObjectRoute* route = FindRoute(object);
+        DAWN_ASSERT(route != nullptr);
+        route->lastUse = position;
+        // Devices get their own lane, other objects belong to the lane of their device.
+        if (object.type == ObjectType::Device) {
+            route->owner = GetOrCreateDeviceLane(object.id);
+        } else {
+            route->owner = lane != mSharedLane.get() ? lane : nullptr;
+        }
+    }
+    return WireResult::Success;
+}
+
+void DeviceCommandDispatcher::CloseOpenTask(Lane* lane) {
+    if (lane->openTask == nullptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    lane->submittedTasks.push_back(std::move(lane->openTask));
+    mPendingTaskCount++;
+    ScheduleIfReadyLocked(lane);
+}
+
+void DeviceCommandDispatcher::Submit() {
+    CloseOpenTask(mSharedLane.get());
+    for (auto& [device, lane] : mDeviceLanes) {
+        CloseOpenTask(lane.get());
+    }
+}
+
+WireResult DeviceCommandDispatcher::PrepareInjection(ObjectReference object,
+                                                     std::optional<ObjectReference> parent) {
+    Submit();
+
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        for (std::optional<ObjectReference> reference : {std::make_optional(object), parent}) {
+            if (!reference) {
+                continue;
+            }
+            ObjectRoute* route = FindRoute(*reference);
+            if (route == nullptr || route->lastUse.lane == nullptr) {
+                continue;
+            }
+            TaskPosition lastUse = route->lastUse;
+            mTaskCompleted.wait(lock,
+                                [&] { return lastUse.lane->completedTaskCount > lastUse.index; });
+        }
+    }
+
+    if (static_cast<uint32_t>(object.type) >= kObjectTypes) {
+        return WireResult::FatalError;
+    }
+    std::vector<ObjectRoute>& routes = mRoutes[object.type];
+    if (object.id == 0 || object.id > routes.size()) {
+        return WireResult::FatalError;
+    }
+    if (object.id == routes.size()) {
+        routes.emplace_back();
+    }
+
+    ObjectRoute* parentRoute = parent ? FindRoute(*parent) : nullptr;
+    ObjectRoute& route = routes[object.id];
+    route.owner = parentRoute != nullptr ? parentRoute->owner : nullptr;
+    route.lastUse = {nullptr, 0};
+    return WireResult::Success;
+}
+
+bool DeviceCommandDispatcher::WaitForIdle(const std::function<void()>& onLaneIdle) {
+    Submit();
+
+    // The flag isn't cleared first: lanes may have become idle since the commands were submitted
+    // by Server::HandleCommands, and their replies are waiting to be flushed.
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        mTaskCompleted.wait(lock, [&] {
+            return mPendingTaskCount == 0 || (onLaneIdle && mLaneBecameIdle);
+        });
+        if (mPendingTaskCount == 0) {
+            break;
+        }
+        mLaneBecameIdle = false;
+        lock.unlock();
+        onLaneIdle();
+        lock.lock();
+    }
+    bool success = !mError;
+    mError = false;
+    return success;
+}
+
+bool DeviceCommandDispatcher::HasError() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mError;
+}
+
+void DeviceCommandDispatcher::Stop() {
+    if (mThreads.empty()) {
+        return;
+    }
+
+    WaitForIdle();
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mWorkAvailable.notify_all();
+
+    for (std::thread& thread : mThreads) {
+        thread.join();
+    }
+    mThreads.clear();
+}
+
+void DeviceCommandDispatcher::ScheduleIfReadyLocked(Lane* lane) {
+    if (lane->scheduled || lane->submittedTasks.empty()) {
+        return;
+    }
+    for (const TaskPosition& dependency : lane->submittedTasks.front()->dependencies) {
+        if (dependency.lane->completedTaskCount <= dependency.index) {
+            return;
+        }
+    }
+
+    lane->scheduled = true;
+    mReadyLanes.push_back(lane);
+    mWorkAvailable.notify_one();
+}
+
+void DeviceCommandDispatcher::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        mWorkAvailable.wait(lock, [&] { return mStopping || !mReadyLanes.empty(); });
+        if (mReadyLanes.empty()) {
+            return;
+        }
+
+        Lane* lane = mReadyLanes.front();
+        mReadyLanes.pop_front();
+        std::unique_ptr<Task> task = std::move(lane->submittedTasks.front());
+        lane->submittedTasks.pop_front();
+
+        // Commands are skipped after an error but their tasks still complete so that nothing
+        // waits on them forever.
+        WireResult result = WireResult::Success;
+        if (!mError) {
+            lock.unlock();
+            result = mServer->HandleDispatchedCommands(task->commands.data(),
+                                                       task->commands.size(), &lane->allocator);
+            task = nullptr;
+            lock.lock();
+        }
+
+        if (result != WireResult::Success) {
+            mError = true;
+        }
+        lane->completedTaskCount++;
+        lane->scheduled = false;
+        mPendingTaskCount--;
+        if (lane->submittedTasks.empty()) {
+            mLaneBecameIdle = true;
+        }
+
+        // The completion can unblock this lane and the lanes waiting on it.
+        for (Lane* other : mLanes) {
+            ScheduleIfReadyLocked(other);
+        }
+        mTaskCompleted.notify_all();
+    }
+}
+
+}  // namespace dawn::wire::server
@@ -0,0 +1,183 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_WIRE_SERVER_DEVICECOMMANDDISPATCHER_H_
+#define SRC_DAWN_WIRE_SERVER_DEVICECOMMANDDISPATCHER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "dawn/common/NonMovable.h"
+#include "dawn/wire/ObjectHandle.h"
+#include "dawn/wire/ObjectType_autogen.h"
+#include "dawn/wire/WireDeserializeAllocator.h"
+#include "dawn/wire/WireResult.h"
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn::wire::server {
+
+class Server;
+
+struct ObjectReference {
+    ObjectType type;
+    ObjectId id;
+};
+
+// The objects used by a command, gathered by Server::GetCommandObjects before it is dispatched.
+struct CommandObjects {
+    void Clear();
+
+    // The object the command is called on, if any.
+    std::optional<ObjectReference> target;
+    // All the objects passed to the command, including the target.
+    std::vector<ObjectReference> used;
+    // The objects created by the command.
+    std::vector<ObjectReference> created;
+};
+
+// Shards the commands handled by a Server by the device they target onto a pool of worker
+// threads, so that a device doing heavy work doesn't stall the commands of the other devices.
+//
+// Each device has a lane of commands that are handled in order, one at a time. Objects created
+// by a command belong to the lane of the command, and commands go to the lane of the object they
+// are called on. Objects that don't belong to a device (instances, adapters, surfaces) use a
+// shared lane. A command using an object that was last used by another lane waits until that
+// lane handled the previous use. This keeps object IDs consistent when the client reuses them,
+// and keeps commands using objects of several devices in order, at the cost of synchronization.
+// Objects of a type created on several lanes are not allocated in the order of their IDs, so the
+// dispatcher checks that the IDs aren't too far ahead in place of KnownObjects.
+//
+// The commands are routed and copied on the thread calling Server::HandleCommands, which is the
+// only thread allowed to call the methods of the dispatcher.
+class DeviceCommandDispatcher : NonMovable {
+  public:
+    DeviceCommandDispatcher(Server* server, uint32_t threadCount);
+    ~DeviceCommandDispatcher();
+
+    // Adds a copy of |command| to the lane of its device. It isn't handled before the next
+    // call to Submit, unless a later command needs to wait for it.
+    WireResult Dispatch(const char* command, size_t size, const CommandObjects& objects);
+    // Submits the commands dispatched since the last call for them to be handled.
+    void Submit();
+
+    // Waits until the dispatched commands using |object| and |parent| are handled, before
+    // |object| is injected in the server. The object then belongs to the lane of |parent|.
+    // Returns an error if the ID of |object| is too far ahead, like for created objects.
+    WireResult PrepareInjection(ObjectReference object, std::optional<ObjectReference> parent);
+
+    // Waits until all the dispatched commands are handled. Returns false if any of them failed
+    // since the last call, in which case the commands dispatched after the failure are skipped.
+    // If set, |onLaneIdle| is called on the waiting thread, without the dispatcher locked, after
+    // all the commands of one or more lanes are handled while other lanes are still busy.
+    bool WaitForIdle(const std::function<void()>& onLaneIdle = {});
+    // Returns whether handling a command failed since the last call to WaitForIdle.
+    bool HasError();
+    // Waits until all the dispatched commands are handled and stops the worker threads.
+    void Stop();
+
+  private:
+    struct Lane;
+
+    // The position of a task in the tasks of a lane.
+    struct TaskPosition {
+        raw_ptr<Lane> lane;
+        uint64_t index;
+    };
+
+    // Consecutive commands of a lane that are handled together once the tasks they depend on
+    // are complete.
+    struct Task {
+        std::vector<char> commands;
+        std::vector<TaskPosition> dependencies;
+    };
+
+    struct Lane {
+        // Only used by the dispatching thread. The tasks are indexed in creation order.
+        std::unique_ptr<Task> openTask;
+        uint64_t taskCount = 0;
+
+        // Protected by mMutex.
+        std::deque<std::unique_ptr<Task>> submittedTasks;
+        uint64_t completedTaskCount = 0;
+        // Whether the lane is waiting in mReadyLanes or its first task is being handled.
+        bool scheduled = false;
+
+        // Only used by the thread handling the first task of the lane.
+        WireDeserializeAllocator allocator;
+    };
+
+    // What the dispatching thread knows about an object ID.
+    struct ObjectRoute {
+        // The lane of the device the object belongs to. Null for the shared lane.
+        raw_ptr<Lane> owner = nullptr;
+        // The task that last used the object. Null lane if the object isn't used by any task.
+        TaskPosition lastUse = {nullptr, 0};
+    };
+
+    ObjectRoute* FindRoute(ObjectReference object);
+    Lane* GetOrCreateDeviceLane(ObjectId device);
+    Lane* SelectLane(const CommandObjects& objects);
+    void AddDependency(Lane* lane, ObjectReference object);
+    void RecordUse(TaskPosition position, ObjectReference object);
+    void CloseOpenTask(Lane* lane);
+
+    void ScheduleIfReadyLocked(Lane* lane);
+    void WorkerLoop();
+
+    raw_ptr<Server> mServer;
+
+    // Only used by the dispatching thread.
+    PerObjectType<std::vector<ObjectRoute>> mRoutes;
+    absl::flat_hash_map<ObjectId, std::unique_ptr<Lane>> mDeviceLanes;
+    std::unique_ptr<Lane> mSharedLane;
+    std::vector<TaskPosition> mDependencies;
+
+    std::mutex mMutex;
+    std::condition_variable mWorkAvailable;
+    std::condition_variable mTaskCompleted;
+    std::vector<raw_ptr<Lane>> mLanes;
+    std::deque<raw_ptr<Lane>> mReadyLanes;
+    uint64_t mPendingTaskCount = 0;
+    // Whether a lane handled all its tasks since WaitForIdle last checked.
+    bool mLaneBecameIdle = false;
+    bool mError = false;
+    bool mStopping = false;
+
+    std::vector<std::thread> mThreads;
+};
+
+}  // namespace dawn::wire::server
+
+#endif  // SRC_DAWN_WIRE_SERVER_DEVICECOMMANDDISPATCHER_H_
@@ -47,6 +47,8 @@ enum class AllocationState : uint32_t {
     Free,
     Reserved,
     Allocated,
+    // IDs that were skipped by an out of order allocation and were never allocated since.
+    Skipped,
 };
 
 template <typename T>
@@ -147,17 +149,17 @@ class KnownObjectsBase {
         Data reservation;
         reservation.handle = nullptr;
         reservation.state = AllocationState::Free;
-        mKnown.push_back(std::move(reservation));
+        PushBack(std::move(reservation));
     }
 
     // Get a backend objects for a given client ID.
     // Returns an error if the object wasn't previously allocated.
     WireResult GetNativeHandle(ObjectId id, T* handle) const {
-        if (id >= mKnown.size()) {
+        if (id >= Size()) {
             return WireResult::FatalError;
         }
 
-        const Data* data = &mKnown[id];
+        const Data* data = &At(id);
         if (data->state != AllocationState::Allocated) {
             return WireResult::FatalError;
         }
@@ -167,12 +169,12 @@ class KnownObjectsBase {
     }
 
     WireResult Get(ObjectId id, Reserved<T>* result) {
-        if (id >= mKnown.size()) {
+        if (id >= Size()) {
             return WireResult::FatalError;
         }
 
-        Data* data = &mKnown[id];
-        if (data->state == AllocationState::Free) {
+        Data* data = &At(id);
+        if (data->state == AllocationState::Free || data->state == AllocationState::Skipped) {
             return WireResult::FatalError;
         }
 
@@ -181,11 +183,11 @@ class KnownObjectsBase {
     }
 
     WireResult Get(ObjectId id, Known<T>* result) {
-        if (id >= mKnown.size()) {
+        if (id >= Size()) {
             return WireResult::FatalError;
         }
 
-        Data* data = &mKnown[id];
+        Data* data = &At(id);
         if (data->state != AllocationState::Allocated) {
             return WireResult::FatalError;
         }
@@ -195,9 +197,9 @@ class KnownObjectsBase {
     }
 
     WireResult FillReservation(ObjectId id, T handle, Known<T>* known = nullptr) {
-        DAWN_ASSERT(id < mKnown.size());
+        DAWN_ASSERT(id < Size());
         DAWN_ASSERT(handle != nullptr);
-        Data* data = &mKnown[id];
+        Data* data = &At(id);
 
         if (data->state != AllocationState::Reserved) {
             return WireResult::FatalError;
@@ -212,11 +214,12 @@ class KnownObjectsBase {
 
     // Allocates the data for a given ID and returns it in result.
     // Returns false if the ID is already allocated, or too far ahead, or if ID is 0 (ID 0 is
-    // reserved for nullptr). Invalidates all the Data*
+    // reserved for nullptr). Invalidates all the Data*, unless out of order allocations are
+    // allowed.
     WireResult Allocate(Reserved<T>* result,
                         ObjectHandle handle,
                         AllocationState state = AllocationState::Allocated) {
-        if (handle.id == 0 || handle.id > mKnown.size()) {
+        if (handle.id == 0 || (handle.id > Size() && !mAllowOutOfOrderAllocations)) {
             return WireResult::FatalError;
         }
 
@@ -224,41 +227,67 @@ class KnownObjectsBase {
         data.state = state;
         data.handle = nullptr;
 
-        if (handle.id >= mKnown.size()) {
-            mKnown.push_back(std::move(data));
-            *result = {handle.id, &mKnown.back()};
+        if (handle.id >= Size()) {
+            while (handle.id > Size()) {
+                Data skipped;
+                skipped.state = AllocationState::Skipped;
+                skipped.handle = nullptr;
+                PushBack(std::move(skipped));
+            }
+            *result = {handle.id, &PushBack(std::move(data))};
+            return WireResult::Success;
+        }
+
+        if (At(handle.id).state == AllocationState::Skipped) {
+            At(handle.id) = std::move(data);
+            *result = {handle.id, &At(handle.id)};
             return WireResult::Success;
         }
 
-        if (mKnown[handle.id].state != AllocationState::Free) {
+        if (At(handle.id).state != AllocationState::Free) {
             return WireResult::FatalError;
         }
 
         // The generation should be strictly increasing.
-        if (handle.generation <= mKnown[handle.id].generation) {
+        if (handle.generation <= At(handle.id).generation) {
             return WireResult::FatalError;
         }
         // update the generation in the slot
         data.generation = handle.generation;
 
-        mKnown[handle.id] = std::move(data);
+        At(handle.id) = std::move(data);
 
-        *result = {handle.id, &mKnown[handle.id]};
+        *result = {handle.id, &At(handle.id)};
         return WireResult::Success;
     }
 
+    // Allows Allocate to skip IDs, for when objects are created in a different order than their
+    // IDs were allocated by the client. The caller must check that the IDs are not too far ahead.
+    // The Data is then stored in blocks that never move, so that commands handled concurrently
+    // by the DeviceCommandDispatcher keep valid pointers when other commands allocate.
+    void AllowOutOfOrderAllocations() {
+        DAWN_ASSERT(!mAllowOutOfOrderAllocations);
+        std::vector<Data> known = std::move(mKnown);
+        mKnown.clear();
+        mAllowOutOfOrderAllocations = true;
+        for (Data& data : known) {
+            PushBack(std::move(data));
+        }
+    }
+
     // Marks an ID as deallocated
     void Free(ObjectId id) {
-        DAWN_ASSERT(id < mKnown.size());
+        DAWN_ASSERT(id < Size());
         Data data;
-        data.generation = mKnown[id].generation;
+        data.generation = At(id).generation;
         data.state = AllocationState::Free;
-        mKnown[id] = std::move(data);
+        At(id) = std::move(data);
     }
 
     std::vector<T> AcquireAllHandles() {
         std::vector<T> objects;
-        for (Data& data : mKnown) {
+        for (ObjectId id = 0; id < Size(); ++id) {
+            Data& data = At(id);
             if (data.state == AllocationState::Allocated && data.handle != nullptr) {
                 objects.push_back(data.handle);
                 data.state = AllocationState::Free;
@@ -271,7 +300,8 @@ class KnownObjectsBase {
 
     std::vector<T> GetAllHandles() const {
         std::vector<T> objects;
-        for (const Data& data : mKnown) {
+        for (ObjectId id = 0; id < Size(); ++id) {
+            const Data& data = At(id);
             if (data.state == AllocationState::Allocated && data.handle != nullptr) {
                 objects.push_back(data.handle);
             }
@@ -281,7 +311,46 @@ class KnownObjectsBase {
     }
 
   protected:
+    size_t Size() const {
+        return mAllowOutOfOrderAllocations ? mStableKnownCount : mKnown.size();
+    }
+
+    // Returns the Data of |id|, which must be less than Size().
+    Data& At(ObjectId id) {
+        DAWN_ASSERT(id < Size());
+        if (mAllowOutOfOrderAllocations) {
+            return mStableKnown[id / kStableBlockSize][id % kStableBlockSize];
+        }
+        return mKnown[id];
+    }
+    const Data& At(ObjectId id) const {
+        DAWN_ASSERT(id < Size());
+        if (mAllowOutOfOrderAllocations) {
+            return mStableKnown[id / kStableBlockSize][id % kStableBlockSize];
+        }
+        return mKnown[id];
+    }
+
+    // Appends |data| as the Data of the ID Size() and returns it.
+    Data& PushBack(Data data) {
+        if (!mAllowOutOfOrderAllocations) {
+            mKnown.push_back(std::move(data));
+            return mKnown.back();
+        }
+        if (mStableKnownCount % kStableBlockSize == 0) {
+            mStableKnown.push_back(std::make_unique<Data[]>(kStableBlockSize));
+        }
+        Data& slot = At(mStableKnownCount++);
+        slot = std::move(data);
+        return slot;
+    }
+
+    // The Data is in mKnown, or in mStableKnown once out of order allocations are allowed.
     std::vector<Data> mKnown;
+    static constexpr size_t kStableBlockSize = 256;
+    std::vector<std::unique_ptr<Data[]>> mStableKnown;
+    size_t mStableKnownCount = 0;
+    bool mAllowOutOfOrderAllocations = false;
 };
 
 template <typename T>
@@ -311,7 +380,7 @@ class KnownObjects<WGPUDevice> : public KnownObjectsBase<WGPUDevice> {
     }
 
     void Free(ObjectId id) {
-        mKnownSet.erase(mKnown[id].handle);
+        mKnownSet.erase(At(id).handle);
         KnownObjectsBase<WGPUDevice>::Free(id);
     }
 
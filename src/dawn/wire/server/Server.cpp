@@ -26,6 +26,11 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "dawn/wire/server/Server.h"
+
+#include <cstring>
+#include <functional>
+
+#include "dawn/wire/BufferConsumer_impl.h"
 #include "dawn/wire/WireServer.h"
 
 namespace dawn::wire::server {
@@ -35,24 +40,37 @@ CallbackUserdata::CallbackUserdata(const std::weak_ptr<Server>& server) : server
 // static
 std::shared_ptr<Server> Server::Create(const DawnProcTable& procs,
                                        CommandSerializer* serializer,
-                                       MemoryTransferService* memoryTransferService) {
-    auto server = std::shared_ptr<Server>(new Server(procs, serializer, memoryTransferService));
+                                       MemoryTransferService* memoryTransferService,
+                                       uint32_t deviceCommandThreadCount) {
+    auto server = std::shared_ptr<Server>(
+        new Server(procs, serializer, memoryTransferService, deviceCommandThreadCount));
     server->mSelf = server;
     return server;
 }
 
 Server::Server(const DawnProcTable& procs,
                CommandSerializer* serializer,
-               MemoryTransferService* memoryTransferService)
+               MemoryTransferService* memoryTransferService,
+               uint32_t deviceCommandThreadCount)
     : mSerializer(serializer), mProcs(procs), mMemoryTransferService(memoryTransferService) {
     if (mMemoryTransferService == nullptr) {
         // If a MemoryTransferService is not provided, fallback to inline memory.
         mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
         mMemoryTransferService = mOwnedMemoryTransferService.get();
     }
+    if (deviceCommandThreadCount > 0) {
+        mStateMutex = std::make_unique<StateMutex>();
+        mDispatcher = std::make_unique<DeviceCommandDispatcher>(this, deviceCommandThreadCount);
+        // Objects of a type can be created by several device command threads, so not in the order
+        // of their IDs. The dispatcher checks the IDs instead.
+        AllowOutOfOrderAllocations();
+    }
 }
 
 Server::~Server() {
+    // No command can be handled concurrently with the destruction.
+    StopDispatchingCommands();
+
     // Un-set the error and lost callbacks since we cannot forward them
     // after the server has been destroyed.
     for (WGPUDevice device : Objects<WGPUDevice>().GetAllHandles()) {
@@ -65,6 +83,12 @@ WireResult Server::InjectBuffer(WGPUBuffer buffer,
                                 const Handle& handle,
                                 const Handle& deviceHandle) {
     DAWN_ASSERT(buffer != nullptr);
+    if (mDispatcher != nullptr) {
+        ObjectReference parent = {ObjectType::Device, deviceHandle.id};
+        WIRE_TRY(mDispatcher->PrepareInjection({ObjectType::Buffer, handle.id}, parent));
+    }
+    auto lock = LockState();
+
     Known<WGPUDevice> device;
     WIRE_TRY(Objects<WGPUDevice>().Get(deviceHandle.id, &device));
     if (device->generation != deviceHandle.generation) {
@@ -89,6 +113,12 @@ WireResult Server::InjectTexture(WGPUTexture texture,
                                  const Handle& handle,
                                  const Handle& deviceHandle) {
     DAWN_ASSERT(texture != nullptr);
+    if (mDispatcher != nullptr) {
+        ObjectReference parent = {ObjectType::Device, deviceHandle.id};
+        WIRE_TRY(mDispatcher->PrepareInjection({ObjectType::Texture, handle.id}, parent));
+    }
+    auto lock = LockState();
+
     Known<WGPUDevice> device;
     WIRE_TRY(Objects<WGPUDevice>().Get(deviceHandle.id, &device));
     if (device->generation != deviceHandle.generation) {
@@ -113,6 +143,12 @@ WireResult Server::InjectSurface(WGPUSurface surface,
                                  const Handle& handle,
                                  const Handle& instanceHandle) {
     DAWN_ASSERT(surface != nullptr);
+    if (mDispatcher != nullptr) {
+        ObjectReference parent = {ObjectType::Instance, instanceHandle.id};
+        WIRE_TRY(mDispatcher->PrepareInjection({ObjectType::Surface, handle.id}, parent));
+    }
+    auto lock = LockState();
+
     Known<WGPUInstance> instance;
     WIRE_TRY(Objects<WGPUInstance>().Get(instanceHandle.id, &instance));
     if (instance->generation != instanceHandle.generation) {
@@ -135,6 +171,11 @@ WireResult Server::InjectSurface(WGPUSurface surface,
 
 WireResult Server::InjectInstance(WGPUInstance instance, const Handle& handle) {
     DAWN_ASSERT(instance != nullptr);
+    if (mDispatcher != nullptr) {
+        WIRE_TRY(mDispatcher->PrepareInjection({ObjectType::Instance, handle.id}, std::nullopt));
+    }
+    auto lock = LockState();
+
     Reserved<WGPUInstance> data;
     WIRE_TRY(Objects<WGPUInstance>().Allocate(&data, handle));
 
@@ -150,6 +191,7 @@ WireResult Server::InjectInstance(WGPUInstance instance, const Handle& handle) {
 }
 
 WGPUDevice Server::GetDevice(uint32_t id, uint32_t generation) {
+    auto lock = LockState();
     Known<WGPUDevice> device;
     if (Objects<WGPUDevice>().Get(id, &device) != WireResult::Success ||
         device->generation != generation) {
@@ -159,9 +201,131 @@ WGPUDevice Server::GetDevice(uint32_t id, uint32_t generation) {
 }
 
 bool Server::IsDeviceKnown(WGPUDevice device) const {
+    auto lock = LockState();
     return Objects<WGPUDevice>().IsKnown(device);
 }
 
+WireResult Server::DispatchCommand(DeserializeBuffer* deserializeBuffer) {
+    // Report the failure of a dispatched command once all the commands after it were skipped,
+    // like the commands after a failure are not handled when they aren't dispatched.
+    if (mDispatcher->HasError()) {
+        mDispatcher->WaitForIdle();
+        return WireResult::FatalError;
+    }
+
+    // Copy the command before looking at it so that the command that is routed is the one that
+    // is handled, even if the client modifies the command buffer concurrently.
+    const volatile CmdHeader* header;
+    WIRE_TRY(deserializeBuffer->Peek(&header));
+    uint64_t commandSize = header->commandSize;
+    if (commandSize < sizeof(CmdHeader) + sizeof(WireCmd) ||
+        commandSize > deserializeBuffer->AvailableSize()) {
+        return WireResult::FatalError;
+    }
+    mDispatchedCommandStaging.resize(commandSize);
+    memcpy(mDispatchedCommandStaging.data(), const_cast<const char*>(deserializeBuffer->Buffer()),
+           commandSize);
+
+    DeserializeBuffer command(mDispatchedCommandStaging.data(), commandSize);
+    WIRE_TRY(GetCommandObjects(&command, &mAllocator, &mDispatchedCommandObjects));
+    size_t commandReadSize = commandSize - command.AvailableSize();
+    WIRE_TRY(mDispatcher->Dispatch(mDispatchedCommandStaging.data(), commandReadSize,
+                                   mDispatchedCommandObjects));
+
+    const volatile char* unused;
+    return deserializeBuffer->ReadN(commandReadSize, &unused);
+}
+
+WireResult Server::HandleDispatchedCommands(const volatile char* commands,
+                                            size_t size,
+                                            WireDeserializeAllocator* allocator) {
+    DeserializeBuffer deserializeBuffer(commands, size);
+    while (deserializeBuffer.AvailableSize() > 0) {
+        {
+            auto lock = LockState();
+            WIRE_TRY(HandleCommand(&deserializeBuffer, allocator));
+        }
+        allocator->Reset();
+    }
+    return WireResult::Success;
+}
+
+bool Server::WaitForDispatchedCommands(bool flushReplies) {
+    bool success = true;
+    if (mDispatcher != nullptr) {
+        // Flush the replies of the devices whose commands are complete without waiting for the
+        // commands of the other devices.
+        std::function<void()> onLaneIdle;
+        if (flushReplies) {
+            onLaneIdle = [&] { success &= FlushReplies(); };
+        }
+        success &= mDispatcher->WaitForIdle(onLaneIdle);
+    }
+    if (flushReplies) {
+        success &= FlushReplies();
+    }
+    return success;
+}
+
+bool Server::FlushReplies() {
+    auto lock = LockState();
+    return mSerializer->Flush();
+}
+
+void Server::StopDispatchingCommands() {
+    if (mDispatcher != nullptr) {
+        mDispatcher->Stop();
+    }
+}
+
+std::unique_lock<Server::StateMutex> Server::LockState() const {
+    if (mStateMutex == nullptr) {
+        return {};
+    }
+    return std::unique_lock<StateMutex>(*mStateMutex);
+}
+
+void Server::StateMutex::lock() {
+    mMutex.lock();
+    mDepth++;
+}
+
+void Server::StateMutex::unlock() {
+    DAWN_ASSERT(mDepth > 0);
+    mDepth--;
+    mMutex.unlock();
+}
+
+uint32_t Server::StateMutex::UnlockAll() {
+    uint32_t depth = mDepth;
+    DAWN_ASSERT(depth > 0);
+    mDepth = 0;
+    for (uint32_t i = 0; i < depth; ++i) {
+        mMutex.unlock();
+    }
+    return depth;
+}
+
+void Server::StateMutex::LockAll(uint32_t depth) {
+    for (uint32_t i = 0; i < depth; ++i) {
+        mMutex.lock();
+    }
+    mDepth = depth;
+}
+
+Server::BackendCallScope::BackendCallScope(Server* server)
+    : mStateMutex(server->mStateMutex.get()) {
+    if (mStateMutex != nullptr) {
+        mDepth = mStateMutex->UnlockAll();
+    }
+}
+
+Server::BackendCallScope::~BackendCallScope() {
+    if (mStateMutex != nullptr) {
+        mStateMutex->LockAll(mDepth);
+    }
+}
+
 void Server::SetForwardingDeviceCallbacks(Known<WGPUDevice> device) {
     // Note: these callbacks are manually inlined here since they do not acquire and
     // free their userdata. Also unlike other callbacks, these are cleared and unset when
@@ -176,6 +340,7 @@ void Server::SetForwardingDeviceCallbacks(Known<WGPUDevice> device) {
         device->handle,
         [](WGPULoggingType type, WGPUStringView message, void* userdata) {
             DeviceInfo* info = static_cast<DeviceInfo*>(userdata);
+            auto lock = info->server->LockState();
             info->server->OnLogging(info->self, type, message);
         },
         device->info.get());
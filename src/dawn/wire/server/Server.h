@@ -29,10 +29,14 @@
 #define SRC_DAWN_WIRE_SERVER_SERVER_H_
 
 #include <memory>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 #include "dawn/common/MutexProtected.h"
+#include "dawn/common/NonMovable.h"
 #include "dawn/wire/ChunkedCommandSerializer.h"
+#include "dawn/wire/server/DeviceCommandDispatcher.h"
 #include "dawn/wire/server/ServerBase_autogen.h"
 #include "partition_alloc/pointers/raw_ptr.h"
 
@@ -91,6 +95,7 @@ struct ForwardToServerHelper {
                 return;
             }
             // Forward the arguments and the typed userdata to the Server:: member function.
+            auto lock = server->LockState();
             (server.get()->*F)(data.get(), std::forward<decltype(args)>(args)...);
         }
         static Return Callback2(Args... args, void* userdata, void*) {
@@ -102,6 +107,7 @@ struct ForwardToServerHelper {
                 return;
             }
             // Forward the arguments and the typed userdata to the Server:: member function.
+            auto lock = server->LockState();
             (server.get()->*F)(data.get(), std::forward<decltype(args)>(args)...);
         }
     };
@@ -192,12 +198,49 @@ class Server : public ServerBase {
   public:
     static std::shared_ptr<Server> Create(const DawnProcTable& procs,
                                           CommandSerializer* serializer,
-                                          MemoryTransferService* memoryTransferService);
+                                          MemoryTransferService* memoryTransferService,
+                                          uint32_t deviceCommandThreadCount = 0);
     ~Server() override;
 
     // ChunkedCommandHandler implementation
     const volatile char* HandleCommandsImpl(const volatile char* commands, size_t size) override;
 
+    // Handles commands previously dispatched by device. Called on the dispatcher's threads.
+    WireResult HandleDispatchedCommands(const volatile char* commands,
+                                        size_t size,
+                                        WireDeserializeAllocator* allocator);
+    // Waits for the commands dispatched by device to be handled, flushing the serializer as the
+    // commands of each device complete if |flushReplies| is true. Returns false if the handling
+    // of any of them failed, or if a flush failed.
+    bool WaitForDispatchedCommands(bool flushReplies);
+    // Waits for the commands dispatched by device and stops the dispatcher's threads. It must be
+    // called before the last reference to the server can be released on one of these threads.
+    void StopDispatchingCommands();
+
+    // A recursive mutex that its owner can fully release around a call to the backend, however
+    // many times it locked it. See BackendCallScope.
+    class StateMutex : NonMovable {
+      public:
+        void lock();
+        void unlock();
+
+        // Releases all the locks held by the current thread and returns how many there were.
+        uint32_t UnlockAll();
+        // Locks the mutex |depth| times again after UnlockAll.
+        void LockAll(uint32_t depth);
+
+      private:
+        std::recursive_mutex mMutex;
+        // Only used by the thread holding mMutex.
+        uint32_t mDepth = 0;
+    };
+
+    // When commands are dispatched by device, the state of the server (the known objects and
+    // their data, and the serializer) is shared between threads and protected by a lock that
+    // must be held by anything accessing it. Otherwise the lock is a no-op. The lock is recursive
+    // because backend callbacks can be called synchronously by the server while the lock is held.
+    [[nodiscard]] std::unique_lock<StateMutex> LockState() const;
+
     WireResult InjectBuffer(WGPUBuffer buffer, const Handle& handle, const Handle& deviceHandle);
     WireResult InjectTexture(WGPUTexture texture, const Handle& handle, const Handle& deviceHandle);
     WireResult InjectSurface(WGPUSurface surface,
@@ -217,7 +260,29 @@ class Server : public ServerBase {
   private:
     Server(const DawnProcTable& procs,
            CommandSerializer* serializer,
-           MemoryTransferService* memoryTransferService);
+           MemoryTransferService* memoryTransferService,
+           uint32_t deviceCommandThreadCount);
+
+    // Releases the state lock for the duration of a call to the backend so that commands for
+    // other devices can be handled concurrently. The lock must be held by the current thread,
+    // and is released even if it was locked recursively.
+    class BackendCallScope : NonMovable {
+      public:
+        explicit BackendCallScope(Server* server);
+        ~BackendCallScope();
+
+      private:
+        raw_ptr<StateMutex> mStateMutex;
+        uint32_t mDepth = 0;
+    };
+
+    // Flushes the replies serialized so far, with the state locked so that the commands handled
+    // concurrently don't serialize replies meanwhile.
+    bool FlushReplies();
+
+    // Copies the command at the start of |deserializeBuffer| and dispatches it to the thread
+    // handling commands for its device.
+    WireResult DispatchCommand(DeserializeBuffer* deserializeBuffer);
 
     template <typename Cmd>
     void SerializeCommand(const Cmd& cmd) {
@@ -289,6 +354,12 @@ class Server : public ServerBase {
 
     // Weak pointer to self to facilitate creation of userdata.
     std::weak_ptr<Server> mSelf;
+
+    // Only set when commands are dispatched by device.
+    std::unique_ptr<StateMutex> mStateMutex;
+    std::unique_ptr<DeviceCommandDispatcher> mDispatcher;
+    CommandObjects mDispatchedCommandObjects;
+    std::vector<char> mDispatchedCommandStaging;
 };
 
 std::unique_ptr<MemoryTransferService> CreateInlineMemoryTransferService();
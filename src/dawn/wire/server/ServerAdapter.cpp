@@ -64,10 +64,12 @@ WireResult Server::DoAdapterRequestDevice(Known<WGPUAdapter> adapter,
         nullptr,
         [](WGPUDevice const*, WGPUErrorType type, WGPUStringView message, void*, void* userdata) {
             DeviceInfo* info = static_cast<DeviceInfo*>(userdata);
+            auto lock = info->server->LockState();
             info->server->OnUncapturedError(info->self, type, message);
         },
         nullptr, device->info.get()};
 
+    BackendCallScope backendCall(this);
     if (userdataCount == 1) {
         mProcs.adapterRequestDevice(adapter->handle, &desc,
                                     ForwardToServer<&Server::OnRequestDeviceCallback>,
@@ -103,6 +103,7 @@ WireResult Server::DoBufferMapAsync(Known<WGPUBuffer> buffer,
     userdata->offset = offset;
     userdata->size = size;
 
+    BackendCallScope backendCall(this);
     if (userdataCount == 1) {
         mProcs.bufferMapAsync(buffer->handle, mode, offset, size,
                               ForwardToServer<&Server::OnBufferMapAsyncCallback>,
@@ -127,7 +128,13 @@ WireResult Server::DoDeviceCreateBuffer(Known<WGPUDevice> device,
     // Create and register the buffer object.
     Reserved<WGPUBuffer> buffer;
     WIRE_TRY(Objects<WGPUBuffer>().Allocate(&buffer, bufferHandle));
-    buffer->handle = mProcs.deviceCreateBuffer(device->handle, descriptor);
+    WGPUDevice deviceHandle = device->handle;
+    WGPUBuffer createdBuffer;
+    {
+        BackendCallScope backendCall(this);
+        createdBuffer = mProcs.deviceCreateBuffer(deviceHandle, descriptor);
+    }
+    buffer->handle = createdBuffer;
     buffer->usage = descriptor->usage;
     buffer->mappedAtCreation = descriptor->mappedAtCreation;
 
@@ -158,7 +165,11 @@ WireResult Server::DoDeviceCreateBuffer(Known<WGPUDevice> device,
         writeHandle->SetDataLength(descriptor->size);
 
         if (descriptor->mappedAtCreation) {
-            void* mapping = mProcs.bufferGetMappedRange(buffer->handle, 0, descriptor->size);
+            void* mapping;
+            {
+                BackendCallScope backendCall(this);
+                mapping = mProcs.bufferGetMappedRange(createdBuffer, 0, descriptor->size);
+            }
             if (mapping == nullptr) {
                 // A zero mapping is used to indicate an allocation error of an error buffer.
                 // This is a valid case and isn't fatal. Remember the buffer is an error so as
@@ -72,6 +72,7 @@ WireResult Server::DoDevicePopErrorScope(Known<WGPUDevice> device,
     userdata->eventManager = eventManager;
     userdata->future = future;
 
+    BackendCallScope backendCall(this);
     mProcs.devicePopErrorScope2(device->handle, {nullptr, WGPUCallbackMode_AllowProcessEvents,
                                                  ForwardToServer2<&Server::OnDevicePopErrorScope>,
                                                  userdata.release(), nullptr});
@@ -107,6 +108,7 @@ WireResult Server::DoDeviceCreateComputePipelineAsync(
     userdata->future = future;
     userdata->pipelineObjectID = pipeline.id;
 
+    BackendCallScope backendCall(this);
     mProcs.deviceCreateComputePipelineAsync2(
         device->handle, descriptor,
         {nullptr, WGPUCallbackMode_AllowProcessEvents,
@@ -149,6 +151,7 @@ WireResult Server::DoDeviceCreateRenderPipelineAsync(
     userdata->future = future;
     userdata->pipelineObjectID = pipeline.id;
 
+    BackendCallScope backendCall(this);
     mProcs.deviceCreateRenderPipelineAsync2(
         device->handle, descriptor,
         {nullptr, WGPUCallbackMode_AllowProcessEvents,
@@ -49,6 +49,7 @@ WireResult Server::DoInstanceRequestAdapter(Known<WGPUInstance> instance,
     userdata->future = future;
     userdata->adapterObjectId = adapter.id;
 
+    BackendCallScope backendCall(this);
     if (userdataCount == 1) {
         mProcs.instanceRequestAdapter(instance->handle, options,
                                       ForwardToServer<&Server::OnRequestAdapterCallback>,
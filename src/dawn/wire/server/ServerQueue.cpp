@@ -50,6 +50,7 @@ WireResult Server::DoQueueOnSubmittedWorkDone(Known<WGPUQueue> queue,
     userdata->eventManager = eventManager;
     userdata->future = future;
 
+    BackendCallScope backendCall(this);
     if (userdataCount == 1) {
         mProcs.queueOnSubmittedWorkDone(queue->handle, ForwardToServer<&Server::OnQueueWorkDone>,
                                         userdata.release());
@@ -71,6 +72,7 @@ WireResult Server::DoQueueWriteBuffer(Known<WGPUQueue> queue,
         return WireResult::FatalError;
     }
 
+    BackendCallScope backendCall(this);
     mProcs.queueWriteBuffer(queue->handle, buffer->handle, bufferOffset, data,
                             static_cast<size_t>(size));
     return WireResult::Success;
@@ -86,6 +88,7 @@ WireResult Server::DoQueueWriteTexture(Known<WGPUQueue> queue,
         return WireResult::FatalError;
     }
 
+    BackendCallScope backendCall(this);
     mProcs.queueWriteTexture(queue->handle, destination, data, static_cast<size_t>(dataSize),
                              dataLayout, writeSize);
     return WireResult::Success;
@@ -38,6 +38,7 @@ WireResult Server::DoShaderModuleGetCompilationInfo(Known<WGPUShaderModule> shad
     userdata->eventManager = eventManager;
     userdata->future = future;
 
+    BackendCallScope backendCall(this);
     mProcs.shaderModuleGetCompilationInfo2(
         shaderModule->handle,
         {nullptr, WGPUCallbackMode_AllowProcessEvents,
@@ -37,7 +37,10 @@ WireResult Server::DoSurfaceGetCurrentTexture(Known<WGPUSurface> surface,
     WIRE_TRY(Objects<WGPUTexture>().Allocate(&texture, textureHandle, AllocationState::Reserved));
 
     WGPUSurfaceTexture surfaceTexture;
-    mProcs.surfaceGetCurrentTexture(surface->handle, &surfaceTexture);
+    {
+        BackendCallScope backendCall(this);
+        mProcs.surfaceGetCurrentTexture(surface->handle, &surfaceTexture);
+    }
 
     if (surfaceTexture.texture != nullptr) {
         return FillReservation(texture.id, surfaceTexture.texture);
@@ -45,7 +48,11 @@ WireResult Server::DoSurfaceGetCurrentTexture(Known<WGPUSurface> surface,
         // The client always assumes that a texture will be associated with the reservation, so
         // create an error texture on the configured device.
         WGPUTextureDescriptor desc = WGPU_TEXTURE_DESCRIPTOR_INIT;
-        WGPUTexture errorTexture = mProcs.deviceCreateErrorTexture(configuredDevice->handle, &desc);
+        WGPUTexture errorTexture;
+        {
+            BackendCallScope backendCall(this);
+            errorTexture = mProcs.deviceCreateErrorTexture(configuredDevice->handle, &desc);
+        }
         return FillReservation(texture.id, errorTexture);
     }
 }
@@ -35,6 +35,7 @@
 ################################################################################
 
 include(cmd/bench/BUILD.cmake)
+include(cmd/bench_pipeline/BUILD.cmake)
 include(cmd/common/BUILD.cmake)
 include(cmd/fuzz/BUILD.cmake)
 include(cmd/info/BUILD.cmake)
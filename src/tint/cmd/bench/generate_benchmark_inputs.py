@@ -48,6 +48,8 @@ from os import path
 kBenchmarkFiles = [
     "test/tint/benchmark/atan2-const-eval.wgsl",
     "test/tint/benchmark/cluster-lights.wgsl",
+    "test/tint/benchmark/deferred-lighting.wgsl",
+    "test/tint/benchmark/matmul-softmax.wgsl",
     "test/tint/benchmark/metaball-isosurface.wgsl",
     "test/tint/benchmark/particles.wgsl",
     "test/tint/benchmark/shadow-fragment.wgsl",
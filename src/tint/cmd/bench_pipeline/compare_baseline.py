@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 The Dawn & Tint Authors
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from
+#    this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+"""
+Compares the results of tint_bench_pipeline against a stored baseline, and fails if any stage of the
+pipeline has regressed for any of the benchmark shaders.
+
+Both files are the JSON written by Google Benchmark. If the benchmarks were run with repetitions,
+the median of the repetitions is compared.
+
+Usage:
+   tint_bench_pipeline --benchmark_out=<results.json> --benchmark_repetitions=5
+   compare_baseline.py <baseline.json> <results.json>
+   compare_baseline.py --update <baseline.json> <results.json>
+"""
+
+import argparse
+import json
+import shutil
+import sys
+
+# The metrics that are compared, and the default tolerance of each, as a fraction of the baseline.
+# Time is noisy across runs, allocation counts are not.
+kMetrics = {
+    'real_time': 0.10,
+    'allocs': 0.01,
+    'alloc_bytes': 0.01,
+    'peak_rss_kib': 0.10,
+    'arena_objects': 0.01,
+    'arena_bytes': 0.01,
+}
+
+# Multipliers that convert Google Benchmark time units to nanoseconds.
+kTimeUnits = {
+    'ns': 1,
+    'us': 1e3,
+    'ms': 1e6,
+    's': 1e9,
+}
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compares tint_bench_pipeline results to a baseline.')
+    parser.add_argument('baseline', help='the baseline JSON file')
+    parser.add_argument('results', help='the JSON file of the run to check')
+    parser.add_argument('--update',
+                        action='store_true',
+                        help='replace the baseline with the results')
+    for metric, tolerance in kMetrics.items():
+        parser.add_argument(
+            f'--{metric.replace("_", "-")}-tolerance',
+            type=float,
+            default=tolerance,
+            dest=metric,
+            metavar='FRACTION',
+            help=f'the allowed increase of {metric} (default: {tolerance})')
+    args = parser.parse_args()
+
+    if args.update:
+        shutil.copyfile(args.results, args.baseline)
+        print(f'Updated {args.baseline}')
+        return 0
+
+    baseline = load_results(args.baseline)
+    results = load_results(args.results)
+
+    regressions = []
+    for name, base in sorted(baseline.items()):
+        result = results.get(name)
+        if result is None:
+            regressions.append(f'{name}: missing from results')
+            continue
+        if 'error' in result:
+            regressions.append(f'{name}: failed: {result["error"]}')
+            continue
+        if 'error' in base:
+            continue
+        for metric in kMetrics:
+            if metric not in base or metric not in result:
+                continue
+            limit = base[metric] * (1 + getattr(args, metric))
+            if result[metric] > limit:
+                change = (result[metric] / base[metric] - 1) * 100
+                regressions.append(
+                    f'{name}: {metric} {base[metric]:.0f} -> {result[metric]:.0f} (+{change:.1f}%)'
+                )
+
+    if regressions:
+        print(f'{len(regressions)} regression(s) found:')
+        for regression in regressions:
+            print(f'  {regression}')
+        return 1
+
+    print(f'No regressions found in {len(baseline)} benchmarks.')
+    return 0
+
+
+def load_results(path):
+    """
+    Loads a Google Benchmark JSON file, returning a dictionary of benchmark name to a dictionary of
+    metric name to value. Failed benchmarks have an 'error' entry instead of metrics.
+    """
+    with open(path) as file:
+        benchmarks = json.load(file)['benchmarks']
+
+    # Use the median aggregate if the benchmarks were repeated.
+    has_median = set(b['run_name'] for b in benchmarks
+                     if b.get('aggregate_name') == 'median')
+
+    results = {}
+    for b in benchmarks:
+        name = b['run_name']
+        if name in has_median:
+            if b.get('aggregate_name') != 'median':
+                continue
+        elif b.get('run_type') != 'iteration':
+            continue
+
+        if b.get('error_occurred'):
+            results[name] = {'error': b.get('error_message', '')}
+            continue
+
+        metrics = {}
+        for metric in kMetrics:
+            if metric in b:
+                metrics[metric] = b[metric]
+        if 'real_time' in metrics:
+            metrics['real_time'] *= kTimeUnits[b['time_unit']]
+        results[name] = metrics
+    return results
+
+
+if __name__ == '__main__':
+    sys.exit(main())
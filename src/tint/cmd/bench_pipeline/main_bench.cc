@@ -0,0 +1,424 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "src/tint/cmd/bench/bench.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/wgsl/reader/reader.h"
+#include "src/tint/utils/memory/allocator_stats.h"
+
+#if TINT_BUILD_IS_LINUX
+#include <fstream>
+#endif  // TINT_BUILD_IS_LINUX
+
+#if TINT_BUILD_GLSL_WRITER
+#include "src/tint/lang/core/ir/transform/single_entry_point.h"
+#include "src/tint/lang/glsl/writer/helpers/generate_bindings.h"
+#include "src/tint/lang/glsl/writer/writer.h"
+#endif  // TINT_BUILD_GLSL_WRITER
+
+#if TINT_BUILD_HLSL_WRITER
+#include "src/tint/lang/hlsl/writer/helpers/generate_bindings.h"
+#include "src/tint/lang/hlsl/writer/writer.h"
+#endif  // TINT_BUILD_HLSL_WRITER
+
+#if TINT_BUILD_MSL_WRITER
+#include "src/tint/lang/msl/writer/helpers/generate_bindings.h"
+#include "src/tint/lang/msl/writer/writer.h"
+#include "src/tint/lang/wgsl/ast/module.h"
+#include "src/tint/lang/wgsl/helpers/flatten_bindings.h"
+#include "src/tint/lang/wgsl/sem/variable.h"
+#endif  // TINT_BUILD_MSL_WRITER
+
+#if TINT_BUILD_SPV_WRITER
+#include "src/tint/lang/spirv/writer/helpers/generate_bindings.h"
+#include "src/tint/lang/spirv/writer/writer.h"
+#endif  // TINT_BUILD_SPV_WRITER
+
+namespace {
+
+// The number of heap allocations, and the total bytes allocated, since the process started.
+std::atomic<uint64_t> allocation_count{0};
+std::atomic<uint64_t> allocation_bytes{0};
+
+}  // namespace
+
+// Replace the global allocation functions to count the allocations made by each pipeline stage.
+// The array and nothrow forms call these by default.
+void* operator new(size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    std::abort();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace tint::bench {
+namespace {
+
+/// AllocationCounter accumulates the heap allocations made by the measured sections of a
+/// benchmark, and reports them as per-iteration counters.
+class AllocationCounter {
+  public:
+    /// Begins a measured section.
+    void Start() {
+        start_count_ = allocation_count.load(std::memory_order_relaxed);
+        start_bytes_ = allocation_bytes.load(std::memory_order_relaxed);
+    }
+
+    /// Ends a measured section.
+    void Stop() {
+        count_ += allocation_count.load(std::memory_order_relaxed) - start_count_;
+        bytes_ += allocation_bytes.load(std::memory_order_relaxed) - start_bytes_;
+    }
+
+    /// Adds the 'allocs' and 'alloc_bytes' per-iteration counters to @p state.
+    /// @param state the benchmark state
+    void Report(benchmark::State& state) const {
+        state.counters["allocs"] =
+            benchmark::Counter(static_cast<double>(count_), benchmark::Counter::kAvgIterations);
+        state.counters["alloc_bytes"] =
+            benchmark::Counter(static_cast<double>(bytes_), benchmark::Counter::kAvgIterations);
+    }
+
+  private:
+    uint64_t start_count_ = 0;
+    uint64_t start_bytes_ = 0;
+    uint64_t count_ = 0;
+    uint64_t bytes_ = 0;
+};
+
+/// Resets the peak resident set size of the process to the current resident set size.
+/// The peak can only be reset on Linux, so the 'peak_rss_kib' counter is only reported there.
+void ResetPeakRSS() {
+#if TINT_BUILD_IS_LINUX
+    std::ofstream("/proc/self/clear_refs") << "5";
+#endif  // TINT_BUILD_IS_LINUX
+}
+
+/// Adds the 'peak_rss_kib' counter to @p state, holding the peak resident set size of the process
+/// since the last call to ResetPeakRSS().
+/// @param state the benchmark state
+void ReportPeakRSS([[maybe_unused]] benchmark::State& state) {
+#if TINT_BUILD_IS_LINUX
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            state.counters["peak_rss_kib"] = std::stod(line.substr(6));
+            return;
+        }
+    }
+#endif  // TINT_BUILD_IS_LINUX
+}
+
+/// @returns the summed memory usage counters of the allocators owned by @p program
+AllocatorStats ArenaStats(const Program& program) {
+    return program.ASTNodes().Stats() + program.SemNodes().Stats() + program.Types().Stats() +
+           program.Constants().Stats() + program.Symbols().Stats();
+}
+
+/// @returns the summed memory usage counters of the allocators owned by @p ir
+AllocatorStats ArenaStats(const core::ir::Module& ir) {
+    return ir.InstructionAllocatorStats() + ir.ValueAllocatorStats() + ir.blocks.Stats() +
+           ir.Types().Stats() + ir.constant_values.Stats() + ir.symbols.Stats();
+}
+
+/// Adds the 'arena_objects' and 'arena_bytes' counters to @p state, holding the number of objects
+/// and the bytes reserved by the allocators of the program or IR module produced by the stage.
+/// For the writers, this is the IR module after it has been transformed by the writer.
+/// @param state the benchmark state
+/// @param stats the summed allocator counters
+void ReportArena(benchmark::State& state, const AllocatorStats& stats) {
+    state.counters["arena_objects"] = static_cast<double>(stats.allocations);
+    state.counters["arena_bytes"] = static_cast<double>(stats.bytes_reserved);
+}
+
+/// Runs a single pipeline stage for each iteration of the benchmark.
+/// Only @p stage is timed and has its allocations counted. @p setup is used to build the input to
+/// the stage, and is neither timed nor counted.
+/// @param state the benchmark state
+/// @param setup a function that returns the input for the stage
+/// @param stage a function that runs the stage on the input, returning a Result
+template <typename SETUP, typename STAGE>
+void RunStage(benchmark::State& state, SETUP&& setup, STAGE&& stage) {
+    ResetPeakRSS();
+    AllocationCounter allocations;
+    std::optional<decltype(setup())> input;
+    for (auto _ : state) {
+        state.PauseTiming();
+        input.reset();
+        input.emplace(setup());
+        state.ResumeTiming();
+
+        allocations.Start();
+        auto res = stage(*input);
+        allocations.Stop();
+        if (res != Success) {
+            state.SkipWithError(res.Failure().reason.Str());
+            return;
+        }
+    }
+    allocations.Report(state);
+    ReportPeakRSS(state);
+}
+
+/// A setup function for stages that have no input besides the benchmark program.
+int NoSetup() {
+    return 0;
+}
+
+void ParseWGSL(benchmark::State& state, std::string input_name) {
+    auto res = GetWgslFile(input_name);
+    if (res != Success) {
+        state.SkipWithError(res.Failure().reason.Str());
+        return;
+    }
+    AllocatorStats arena;
+    RunStage(state, NoSetup, [&](int) -> Result<SuccessType> {
+        auto program = wgsl::reader::Parse(&res.Get());
+        if (!program.IsValid()) {
+            return Failure{program.Diagnostics()};
+        }
+        arena = ArenaStats(program);
+        return Success;
+    });
+    ReportArena(state, arena);
+}
+TINT_BENCHMARK_PROGRAMS(ParseWGSL);
+
+void LowerToIR(benchmark::State& state, std::string input_name) {
+    auto res = GetWgslProgram(input_name);
+    if (res != Success) {
+        state.SkipWithError(res.Failure().reason.Str());
+        return;
+    }
+    AllocatorStats arena;
+    RunStage(state, NoSetup, [&](int) -> Result<SuccessType> {
+        auto ir = wgsl::reader::ProgramToLoweredIR(res->program);
+        if (ir != Success) {
+            return ir.Failure();
+        }
+        arena = ArenaStats(ir.Get());
+        return Success;
+    });
+    ReportArena(state, arena);
+}
+TINT_BENCHMARK_PROGRAMS(LowerToIR);
+
+#if TINT_BUILD_SPV_WRITER
+void GenerateSPIRV(benchmark::State& state, std::string input_name) {
+    auto res = GetWgslProgram(input_name);
+    if (res != Success) {
+        state.SkipWithError(res.Failure().reason.Str());
+        return;
+    }
+    auto lower = [&] { return wgsl::reader::ProgramToLoweredIR(res->program); };
+
+    spirv::writer::Options options;
+    if (auto ir = lower(); ir == Success) {
+        options.bindings = spirv::writer::GenerateBindings(ir.Get());
+    }
+
+    AllocatorStats arena;
+    RunStage(state, lower, [&](Result<core::ir::Module>& ir) -> Result<SuccessType> {
+        if (ir != Success) {
+            return ir.Failure();
+        }
+        auto output = spirv::writer::Generate(ir.Get(), options);
+        if (output != Success) {
+            return output.Failure();
+        }
+        arena = ArenaStats(ir.Get());
+        return Success;
+    });
+    ReportArena(state, arena);
+}
+TINT_BENCHMARK_PROGRAMS(GenerateSPIRV);
+#endif  // TINT_BUILD_SPV_WRITER
+
+#if TINT_BUILD_HLSL_WRITER
+void GenerateHLSL(benchmark::State& state, std::string input_name) {
+    auto res = GetWgslProgram(input_name);
+    if (res != Success) {
+        state.SkipWithError(res.Failure().reason.Str());
+        return;
+    }
+    auto lower = [&] { return wgsl::reader::ProgramToLoweredIR(res->program); };
+
+    hlsl::writer::Options options;
+    options.bindings = hlsl::writer::GenerateBindings(res->program);
+
+    AllocatorStats arena;
+    RunStage(state, lower, [&](Result<core::ir::Module>& ir) -> Result<SuccessType> {
+        if (ir != Success) {
+            return ir.Failure();
+        }
+        auto output = hlsl::writer::Generate(ir.Get(), options);
+        if (output != Success) {
+            return output.Failure();
+        }
+        arena = ArenaStats(ir.Get());
+        return Success;
+    });
+    ReportArena(state, arena);
+}
+TINT_BENCHMARK_PROGRAMS(GenerateHLSL);
+#endif  // TINT_BUILD_HLSL_WRITER
+
+#if TINT_BUILD_MSL_WRITER
+void GenerateMSL(benchmark::State& state, std::string input_name) {
+    auto res = GetWgslProgram(input_name);
+    if (res != Success) {
+        state.SkipWithError(res.Failure().reason.Str());
+        return;
+    }
+
+    // Remap resource numbers to a flat namespace.
+    const Program* program = &res->program;
+    auto flattened = wgsl::FlattenBindings(res->program);
+    if (flattened) {
+        program = &*flattened;
+    }
+    auto lower = [&] { return wgsl::reader::ProgramToLoweredIR(*program); };
+
+    msl::writer::Options options;
+    options.bindings = msl::writer::GenerateBindings(*program);
+    options.array_length_from_uniform.ubo_binding = 30;
+    for (auto* var : program->AST().GlobalVariables()) {
+        auto* sem_var = program->Sem().Get<sem::GlobalVariable>(var);
+        if (!sem_var->Type()->UnwrapRef()->HasFixedFootprint()) {
+            auto& sizes = options.array_length_from_uniform.bindpoint_to_size_index;
+            sizes.emplace(sem_var->Attributes().binding_point.value(),
+                          static_cast<uint32_t>(sizes.size()));
+        }
+    }
+
+    AllocatorStats arena;
+    RunStage(state, lower, [&](Result<core::ir::Module>& ir) -> Result<SuccessType> {
+        if (ir != Success) {
+            return ir.Failure();
+        }
+        auto output = msl::writer::Generate(ir.Get(), options);
+        if (output != Success) {
+            return output.Failure();
+        }
+        arena = ArenaStats(ir.Get());
+        return Success;
+    });
+    ReportArena(state, arena);
+}
+TINT_BENCHMARK_PROGRAMS(GenerateMSL);
+#endif  // TINT_BUILD_MSL_WRITER
+
+#if TINT_BUILD_GLSL_WRITER
+void GenerateGLSL(benchmark::State& state, std::string input_name) {
+    auto res = GetWgslProgram(input_name);
+    if (res != Success) {
+        state.SkipWithError(res.Failure().reason.Str());
+        return;
+    }
+
+    // GLSL is generated for a single entry point at a time, so the stage generates every entry
+    // point, each from its own IR module.
+    glsl::writer::Options options;
+    Vector<std::string, 4> entry_points;
+    {
+        auto ir = wgsl::reader::ProgramToLoweredIR(res->program);
+        if (ir != Success) {
+            state.SkipWithError(ir.Failure().reason.Str());
+            return;
+        }
+        options.bindings = glsl::writer::GenerateBindings(ir.Get());
+        for (auto& func : ir->functions) {
+            if (func->Stage() != core::ir::Function::PipelineStage::kUndefined) {
+                entry_points.Push(ir->NameOf(func).Name());
+            }
+        }
+    }
+    using Modules = Vector<Result<core::ir::Module>, 4>;
+    auto lower = [&] {
+        Modules modules;
+        for (size_t i = 0; i < entry_points.Length(); i++) {
+            modules.Push(wgsl::reader::ProgramToLoweredIR(res->program));
+        }
+        return modules;
+    };
+
+    AllocatorStats arena;
+    RunStage(state, lower, [&](Modules& modules) -> Result<SuccessType> {
+        arena = {};
+        for (size_t i = 0; i < entry_points.Length(); i++) {
+            auto& ir = modules[i];
+            if (ir != Success) {
+                return ir.Failure();
+            }
+            auto single = core::ir::transform::SingleEntryPoint(ir.Get(), entry_points[i]);
+            if (single != Success) {
+                return single.Failure();
+            }
+            auto output = glsl::writer::Generate(ir.Get(), options, entry_points[i]);
+            if (output != Success) {
+                return output.Failure();
+            }
+            arena += ArenaStats(ir.Get());
+        }
+        return Success;
+    });
+    ReportArena(state, arena);
+}
+TINT_BENCHMARK_PROGRAMS(GenerateGLSL);
+#endif  // TINT_BUILD_GLSL_WRITER
+
+}  // namespace
+}  // namespace tint::bench
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -47,6 +47,7 @@ tint_target_add_dependencies(tint_cmd_info_cmd cmd
   tint_cmd_common
   tint_lang_core
   tint_lang_core_constant
+  tint_lang_core_ir
   tint_lang_core_type
   tint_lang_wgsl
   tint_lang_wgsl_ast
@@ -80,4 +81,10 @@ if(TINT_BUILD_SPV_READER)
   )
 endif(TINT_BUILD_SPV_READER)
 
+if(TINT_BUILD_WGSL_READER)
+  tint_target_add_dependencies(tint_cmd_info_cmd cmd
+    tint_lang_wgsl_reader
+  )
+endif(TINT_BUILD_WGSL_READER)
+
 tint_target_set_output_name(tint_cmd_info_cmd cmd "tint_info")
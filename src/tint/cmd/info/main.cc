@@ -26,15 +26,25 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <iomanip>
 #include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "src/tint/utils/text/styled_text_printer.h"
 
 #include "src/tint/cmd/common/helper.h"
 #include "src/tint/lang/core/type/struct.h"
 #include "src/tint/lang/wgsl/inspector/entry_point.h"
+#include "src/tint/utils/memory/allocator_stats.h"
 #include "src/tint/utils/text/string.h"
 
+#if TINT_BUILD_WGSL_READER
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/wgsl/reader/reader.h"
+#endif  // TINT_BUILD_WGSL_READER
+
 namespace {
 
 struct Options {
@@ -46,12 +56,15 @@ struct Options {
 
     std::string input_filename;
     bool emit_json = false;
+    bool emit_memory = false;
 };
 
 const char kUsage[] = R"(Usage: tint [options] <input-file>
 
  options:
    --json                    -- Emit JSON
+   --memory                  -- Emit the memory usage of the program's allocators, and of the
+                                allocators of the IR module lowered from the program
    -h                        -- This help text
 
 )";
@@ -63,6 +76,8 @@ bool ParseArgs(const std::vector<std::string>& args, Options* opts) {
             opts->show_help = true;
         } else if (arg == "--json") {
             opts->emit_json = true;
+        } else if (arg == "--memory") {
+            opts->emit_memory = true;
         } else if (!arg.empty()) {
             if (arg[0] == '-') {
                 std::cerr << "Unrecognized option: " << arg << "\n";
@@ -79,7 +94,78 @@ bool ParseArgs(const std::vector<std::string>& args, Options* opts) {
     return true;
 }
 
-void EmitJson(const tint::Program& program) {
+/// The memory usage counters of a named allocator
+using NamedAllocatorStats = std::pair<std::string, tint::AllocatorStats>;
+
+/// @returns the memory usage counters of each of the allocators owned by @p program, followed by
+/// those of the IR module lowered from @p program, if the WGSL reader is enabled.
+std::vector<NamedAllocatorStats> CollectMemoryStats(const tint::Program& program) {
+    std::vector<NamedAllocatorStats> stats{
+        {"program.ast_nodes", program.ASTNodes().Stats()},
+        {"program.sem_nodes", program.SemNodes().Stats()},
+        {"program.types", program.Types().Stats()},
+        {"program.constants", program.Constants().Stats()},
+        {"program.symbols", program.Symbols().Stats()},
+    };
+
+#if TINT_BUILD_WGSL_READER
+    auto ir = tint::wgsl::reader::ProgramToLoweredIR(program);
+    if (ir == tint::Success) {
+        const auto& mod = ir.Get();
+        stats.emplace_back("ir.instructions", mod.InstructionAllocatorStats());
+        stats.emplace_back("ir.values", mod.ValueAllocatorStats());
+        stats.emplace_back("ir.blocks", mod.blocks.Stats());
+        stats.emplace_back("ir.types", mod.Types().Stats());
+        stats.emplace_back("ir.constants", mod.constant_values.Stats());
+        stats.emplace_back("ir.symbols", mod.symbols.Stats());
+    } else {
+        std::cerr << "Failed to lower the program to IR: " << ir.Failure() << "\n";
+    }
+#endif  // TINT_BUILD_WGSL_READER
+
+    tint::AllocatorStats total;
+    for (auto& it : stats) {
+        total += it.second;
+    }
+    stats.emplace_back("total", total);
+    return stats;
+}
+
+void EmitMemoryJson(const tint::Program& program) {
+    std::cout << "\"memory\": [";
+    bool first = true;
+    for (auto& [name, stats] : CollectMemoryStats(program)) {
+        if (!first) {
+            std::cout << ",";
+        }
+        first = false;
+        std::cout << "\n{\n"
+                  << "\"allocator\": \"" << name << "\",\n"
+                  << "\"allocations\": " << stats.allocations << ",\n"
+                  << "\"blocks\": " << stats.blocks << ",\n"
+                  << "\"bytes_allocated\": " << stats.bytes_allocated << ",\n"
+                  << "\"bytes_reserved\": " << stats.bytes_reserved << ",\n"
+                  << "\"peak_bytes_reserved\": " << stats.peak_bytes_reserved << "\n"
+                  << "}";
+    }
+    std::cout << "\n]";
+}
+
+void EmitMemoryText(const tint::Program& program) {
+    std::cout << "Memory\n";
+    std::cout << std::left << std::setw(20) << "allocator" << std::right << std::setw(12)
+              << "allocations" << std::setw(8) << "blocks" << std::setw(16) << "bytes allocated"
+              << std::setw(16) << "bytes reserved" << std::setw(16) << "peak reserved" << "\n";
+    for (auto& [name, stats] : CollectMemoryStats(program)) {
+        std::cout << std::left << std::setw(20) << name << std::right << std::setw(12)
+                  << stats.allocations << std::setw(8) << stats.blocks << std::setw(16)
+                  << stats.bytes_allocated << std::setw(16) << stats.bytes_reserved
+                  << std::setw(16) << stats.peak_bytes_reserved << "\n";
+    }
+    std::cout << "\n";
+}
+
+void EmitJson(const tint::Program& program, bool emit_memory) {
     tint::inspector::Inspector inspector(program);
 
     std::cout << "{\n\"extensions\": [\n";
@@ -253,10 +339,15 @@ void EmitJson(const tint::Program& program) {
         }
         std::cout << "\n]\n}";
     }
-    std::cout << "\n]\n}\n";
+    std::cout << "\n]";
+    if (emit_memory) {
+        std::cout << ",\n";
+        EmitMemoryJson(program);
+    }
+    std::cout << "\n}\n";
 }
 
-void EmitText(const tint::Program& program) {
+void EmitText(const tint::Program& program, bool emit_memory) {
     auto printer = tint::StyledTextPrinter::Create(stdout);
     tint::inspector::Inspector inspector(program);
     if (!inspector.GetUsedExtensionNames().empty()) {
@@ -288,6 +379,10 @@ void EmitText(const tint::Program& program) {
             printer->Print(s->Layout() << "\n\n");
         }
     }
+
+    if (emit_memory) {
+        EmitMemoryText(program);
+    }
 }
 
 }  // namespace
@@ -317,9 +412,9 @@ int main(int argc, const char** argv) {
     auto info = tint::cmd::LoadProgramInfo(opts);
 
     if (options.emit_json) {
-        EmitJson(info.program);
+        EmitJson(info.program, options.emit_memory);
     } else {
-        EmitText(info.program);
+        EmitText(info.program, options.emit_memory);
     }
 
     return 0;
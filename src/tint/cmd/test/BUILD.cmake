@@ -47,6 +47,7 @@ tint_target_add_dependencies(tint_cmd_test_test_cmd test_cmd
   tint_api_common_test
   tint_lang_core_constant_test
   tint_lang_core_intrinsic_test
+  tint_lang_core_ir_binary_flat_test
   tint_lang_core_ir_transform_test
   tint_lang_core_ir_test
   tint_lang_core_type_test
@@ -32,6 +32,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <memory>
 
 #include "src/tint/lang/wgsl/ls/serve.h"
 
@@ -64,9 +65,9 @@ int main() {
 #endif  // TINT_BUILD_IS_WIN
 
     StdoutStream stdout_stream;
-    StdinStream stdin_stream;
 
-    if (auto res = tint::wgsl::ls::Serve(stdin_stream, stdout_stream); res != tint::Success) {
+    if (auto res = tint::wgsl::ls::Serve(std::make_unique<StdinStream>(), stdout_stream);
+        res != tint::Success) {
         std::cerr << res.Failure();
         return 1;
     }
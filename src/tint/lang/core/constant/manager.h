@@ -95,6 +95,10 @@ class Manager final {
     /// @returns an iterator to the end of the types
     TypeIterator end() const { return values_.end(); }
 
+    /// @returns the memory usage counters of the constant value allocator. The counters of the
+    /// type manager are reported separately by `types.Stats()`.
+    const AllocatorStats& Stats() const { return values_.Stats(); }
+
     /// Constructs a constant of a vector, matrix or array type.
     ///
     /// Examines the element values and will return either a constant::Composite or a
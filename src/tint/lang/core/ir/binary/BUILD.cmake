@@ -34,6 +34,8 @@
 #                       Do not modify this file directly
 ################################################################################
 
+include(lang/core/ir/binary/flat/BUILD.cmake)
+
 if(TINT_BUILD_IR_BINARY)
 ################################################################################
 # Target:    tint_lang_core_ir_binary
@@ -0,0 +1,1142 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/core/ir/binary/flat/decode.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "src/tint/lang/core/ir/binary/flat/format.h"
+#include "src/tint/lang/core/ir/builder.h"
+#include "src/tint/lang/core/ir/control_instruction.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/type/depth_multisampled_texture.h"
+#include "src/tint/lang/core/type/depth_texture.h"
+#include "src/tint/lang/core/type/external_texture.h"
+#include "src/tint/lang/core/type/input_attachment.h"
+#include "src/tint/lang/core/type/invalid.h"
+#include "src/tint/lang/core/type/multisampled_texture.h"
+#include "src/tint/lang/core/type/sampled_texture.h"
+#include "src/tint/lang/core/type/storage_texture.h"
+#include "src/tint/lang/core/type/vector.h"
+#include "src/tint/utils/constants/internal_limits.h"
+#include "src/tint/utils/containers/hashset.h"
+#include "src/tint/utils/diagnostic/diagnostic.h"
+#include "src/tint/utils/file/mapped_file.h"
+#include "src/tint/utils/macros/compiler.h"
+#include "src/tint/utils/math/math.h"
+#include "src/tint/utils/result/result.h"
+#include "src/tint/utils/text/text_style.h"
+
+using namespace tint::core::fluent_types;  // NOLINT
+
+namespace tint::core::ir::binary::flat {
+namespace {
+
+/// kMagic as read on a machine of the opposite byte order.
+static constexpr uint32_t kMagicSwapped = ((kMagic & 0x000000ffu) << 24) |  //
+                                          ((kMagic & 0x0000ff00u) << 8) |   //
+                                          ((kMagic & 0x00ff0000u) >> 8) |   //
+                                          ((kMagic & 0xff000000u) >> 24);
+
+struct Decoder {
+    const Slice<const std::byte> in_;
+
+    Header header_{};
+    Module mod_out_{};
+    Vector<ir::Block*, 32> blocks_{};
+    Vector<const type::Type*, 32> types_{};
+    Vector<const core::constant::Value*, 32> constant_values_{};
+    Vector<ir::Value*, 32> values_{};
+    Builder b{mod_out_};
+
+    Vector<ir::ExitIf*, 32> exit_ifs_{};
+    Vector<ir::ExitSwitch*, 32> exit_switches_{};
+    Vector<ir::ExitLoop*, 32> exit_loops_{};
+    Vector<ir::NextIteration*, 32> next_iterations_{};
+    Vector<ir::BreakIf*, 32> break_ifs_{};
+    Vector<ir::Continue*, 32> continues_{};
+
+    diag::List diags_{};
+    Hashset<std::string, 4> struct_names_{};
+
+    Result<Module> Decode() {
+        if (!DecodeHeader()) {
+            return Failure{std::move(diags_)};
+        }
+
+        {
+            const uint32_t n = Count(Section::kTypes);
+            types_.Reserve(n);
+            for (uint32_t i = 0; i < n; i++) {
+                types_.Push(CreateType(Record<flat::Type>(Section::kTypes, i)));
+            }
+        }
+        {
+            const uint32_t n = Count(Section::kFunctions);
+            mod_out_.functions.Reserve(n);
+            for (uint32_t i = 0; i < n; i++) {
+                mod_out_.functions.Push(mod_out_.CreateValue<ir::Function>());
+            }
+        }
+        {
+            const uint32_t n = Count(Section::kBlocks);
+            blocks_.Reserve(n);
+            for (uint32_t i = 0; i < n; i++) {
+                if (i == header_.root_block) {
+                    blocks_.Push(mod_out_.root_block);
+                } else {
+                    auto block_in = Record<flat::Block>(Section::kBlocks, i);
+                    blocks_.Push(block_in.is_multi_in ? b.MultiInBlock() : b.Block());
+                }
+            }
+        }
+        {
+            const uint32_t n = Count(Section::kConstants);
+            constant_values_.Reserve(n);
+            for (uint32_t i = 0; i < n; i++) {
+                constant_values_.Push(
+                    CreateConstantValue(Record<flat::Constant>(Section::kConstants, i)));
+            }
+        }
+        {
+            const uint32_t n = Count(Section::kValues);
+            values_.Reserve(n);
+            for (uint32_t i = 0; i < n; i++) {
+                values_.Push(CreateValue(Record<flat::Value>(Section::kValues, i)));
+            }
+        }
+        for (uint32_t i = 0, n = Count(Section::kFunctions); i < n; i++) {
+            PopulateFunction(mod_out_.functions[i], Record<flat::Function>(Section::kFunctions, i));
+        }
+        for (uint32_t i = 0, n = Count(Section::kBlocks); i < n; i++) {
+            PopulateBlock(blocks_[i], Record<flat::Block>(Section::kBlocks, i));
+        }
+
+        if (diags_.ContainsErrors()) {
+            // Note: Its not safe to call InferControlInstruction() with a broken IR.
+            return Failure{std::move(diags_)};
+        }
+
+        if (CheckBlocks()) {
+            for (auto* exit : exit_ifs_) {
+                InferControlInstruction(exit, &ExitIf::SetIf);
+            }
+            for (auto* exit : exit_switches_) {
+                InferControlInstruction(exit, &ExitSwitch::SetSwitch);
+            }
+            for (auto* exit : exit_loops_) {
+                InferControlInstruction(exit, &ExitLoop::SetLoop);
+            }
+            for (auto* break_ifs : break_ifs_) {
+                InferControlInstruction(break_ifs, &BreakIf::SetLoop);
+            }
+            for (auto* next_iters : next_iterations_) {
+                InferControlInstruction(next_iters, &NextIteration::SetLoop);
+            }
+            for (auto* cont : continues_) {
+                InferControlInstruction(cont, &Continue::SetLoop);
+            }
+        }
+
+        if (diags_.ContainsErrors()) {
+            return Failure{std::move(diags_)};
+        }
+        return std::move(mod_out_);
+    }
+
+    /// Adds a new error to the diagnostics and returns a reference to it
+    diag::Diagnostic& Error() { return diags_.AddError(Source{}); }
+
+    /// Errors if @p number is not finite.
+    /// @returns @p number if finite, otherwise 0.
+    template <typename T>
+    Number<T> CheckFinite(Number<T> number) {
+        if (DAWN_UNLIKELY(!std::isfinite(number.value))) {
+            Error() << "value must be finite";
+            return Number<T>{};
+        }
+        return number;
+    }
+
+    /// @returns true if all blocks are reachable, acyclic nesting depth is less than or equal to
+    /// kMaxBlockDepth.
+    bool CheckBlocks() {
+        const size_t kMaxBlockDepth = 128;
+        Vector<std::pair<const ir::Block*, size_t>, 32> pending;
+        pending.Push(std::make_pair(mod_out_.root_block, 0));
+        for (auto& fn : mod_out_.functions) {
+            pending.Push(std::make_pair(fn->Block(), 0));
+        }
+        Hashset<const ir::Block*, 32> seen;
+        while (!pending.IsEmpty()) {
+            const auto block_depth = pending.Pop();
+            const auto* block = block_depth.first;
+            const size_t depth = block_depth.second;
+            if (!seen.Add(block)) {
+                Error() << "cyclic nesting of blocks";
+                return false;
+            }
+            if (depth > kMaxBlockDepth) {
+                Error() << "block nesting exceeds " << kMaxBlockDepth;
+                return false;
+            }
+            for (auto* inst = block->Instructions(); inst; inst = inst->next) {
+                if (auto* ctrl = inst->As<ir::ControlInstruction>()) {
+                    ctrl->ForeachBlock([&](const ir::Block* child) {
+                        pending.Push(std::make_pair(child, depth + 1));
+                    });
+                }
+            }
+        }
+
+        for (auto* block : blocks_) {
+            if (!seen.Contains(block)) {
+                Error() << "unreachable block";
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template <typename EXIT, typename CTRL_INST>
+    void InferControlInstruction(EXIT* exit, void (EXIT::*set)(CTRL_INST*)) {
+        for (auto* block = exit->Block(); block;) {
+            auto* parent = block->Parent();
+            if (!parent) {
+                break;
+            }
+            if (auto* ctrl_inst = parent->template As<CTRL_INST>()) {
+                (exit->*set)(ctrl_inst);
+                break;
+            }
+            block = parent->Block();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Sections
+    ////////////////////////////////////////////////////////////////////////////
+    /// Reads and validates the header, ensuring that every section lies within the input.
+    /// @returns true if the header is valid
+    bool DecodeHeader() {
+        if (DAWN_UNLIKELY(in_.len < sizeof(Header))) {
+            Error() << "flat binary is too small to hold a header";
+            return false;
+        }
+        std::memcpy(&header_, in_.data, sizeof(Header));
+        if (DAWN_UNLIKELY(header_.magic != kMagic)) {
+            if (header_.magic == kMagicSwapped) {
+                Error() << "flat binary was encoded with a different byte order";
+            } else {
+                Error() << "invalid flat binary magic number";
+            }
+            return false;
+        }
+        if (DAWN_UNLIKELY(header_.version != kVersion)) {
+            Error() << "unsupported flat binary version " << header_.version << ", expected "
+                    << kVersion;
+            return false;
+        }
+        for (uint32_t i = 0; i < kNumSections; i++) {
+            auto& section = header_.sections[i];
+            uint64_t end =
+                section.offset + static_cast<uint64_t>(section.count) * RecordSize(Section(i));
+            if (DAWN_UNLIKELY(section.offset < sizeof(Header) || section.offset % 4 != 0 ||
+                              end > in_.len)) {
+                Error() << "flat binary section " << i << " is out of bounds";
+                return false;
+            }
+        }
+        if (DAWN_UNLIKELY(header_.root_block >= Count(Section::kBlocks))) {
+            Error() << "root block id " << header_.root_block << " out of range";
+            return false;
+        }
+        return true;
+    }
+
+    /// @returns the number of records in @p section
+    uint32_t Count(Section section) const {
+        return header_.sections[static_cast<uint32_t>(section)].count;
+    }
+
+    /// @returns the record with index @p index in @p section.
+    /// @note @p index must be less than Count(section).
+    template <typename T>
+    T Record(Section section, uint32_t index) const {
+        TINT_ASSERT(RecordSize(section) == sizeof(T));
+        TINT_ASSERT(index < Count(section));
+        T out;
+        auto offset = header_.sections[static_cast<uint32_t>(section)].offset;
+        std::memcpy(&out, in_.data + offset + static_cast<size_t>(index) * sizeof(T), sizeof(T));
+        return out;
+    }
+
+    /// Errors if the records [@p first, @p first + @p count) do not lie within @p section.
+    /// @returns true if the range is valid
+    bool CheckRange(Section section, uint32_t first, uint32_t count) {
+        if (DAWN_UNLIKELY(static_cast<uint64_t>(first) + count > Count(section))) {
+            Error() << "record range [" << first << ", " << (static_cast<uint64_t>(first) + count)
+                    << ") of section " << static_cast<uint32_t>(section) << " is out of bounds";
+            return false;
+        }
+        return true;
+    }
+
+    /// Calls @p f with each of the ids in the range [@p first, @p first + @p count).
+    template <typename F>
+    void ForeachId(uint32_t first, uint32_t count, F&& f) {
+        if (CheckRange(Section::kIds, first, count)) {
+            for (uint32_t i = 0; i < count; i++) {
+                f(Record<uint32_t>(Section::kIds, first + i));
+            }
+        }
+    }
+
+    /// @returns the string with the 1-based id @p id, or an empty string if @p id is 0.
+    /// The returned string references the input bytes.
+    std::string_view String(uint32_t id) {
+        if (id == 0) {
+            return {};
+        }
+        if (DAWN_UNLIKELY(id > Count(Section::kStrings))) {
+            Error() << "string id " << id << " out of range";
+            return {};
+        }
+        auto str = Record<flat::String>(Section::kStrings, id - 1);
+        if (DAWN_UNLIKELY(!CheckRange(Section::kStringData, str.offset, str.length))) {
+            return {};
+        }
+        auto offset = header_.sections[static_cast<uint32_t>(Section::kStringData)].offset;
+        return std::string_view(reinterpret_cast<const char*>(in_.data + offset + str.offset),
+                                str.length);
+    }
+
+    /// @returns the name string with the 1-based id @p id, erroring if the name contains a '\0'.
+    std::string_view Name(uint32_t id, const char* what) {
+        auto name = String(id);
+        if (DAWN_UNLIKELY(name.find('\0') != std::string_view::npos)) {
+            Error() << what << " name '" << name << "' contains '\\0' before end of the string";
+            return {};
+        }
+        return name;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Functions
+    ////////////////////////////////////////////////////////////////////////////
+    void PopulateFunction(ir::Function* fn_out, const flat::Function& fn_in) {
+        if (auto name = Name(fn_in.name, "function"); !name.empty()) {
+            mod_out_.SetName(fn_out, name);
+        }
+        fn_out->SetReturnType(Type(fn_in.return_type));
+        fn_out->SetStage(PipelineStage(fn_in.stage));
+        if (fn_in.has_workgroup_size) {
+            // TODO(dsinclair): When overrides are supported we should add support for generating
+            // override expressions here.
+            fn_out->SetWorkgroupSize(Value(fn_in.workgroup_size[0]),
+                                     Value(fn_in.workgroup_size[1]),
+                                     Value(fn_in.workgroup_size[2]));
+        }
+
+        Vector<FunctionParam*, 8> params_out;
+        ForeachId(fn_in.params_first, fn_in.params_count, [&](uint32_t param_in) {
+            auto* param_out = ValueAs<FunctionParam>(param_in);
+            if (DAWN_LIKELY(param_out)) {
+                params_out.Push(param_out);
+            }
+        });
+        if (auto attrs = Attributes(fn_in.return_attributes)) {
+            if (attrs->flags & kHasLocation) {
+                fn_out->SetReturnLocation(attrs->location);
+            }
+            if (attrs->flags & kHasInterpolation) {
+                fn_out->SetReturnInterpolation(Interpolation(*attrs));
+            }
+            if (attrs->flags & kHasBuiltin) {
+                fn_out->SetReturnBuiltin(BuiltinValue(attrs->builtin));
+            }
+            if (attrs->flags & kInvariant) {
+                fn_out->SetReturnInvariant(true);
+            }
+        }
+        fn_out->SetParams(std::move(params_out));
+        fn_out->SetBlock(Block(fn_in.block));
+    }
+
+    ir::Function* Function(uint32_t id) {
+        if (DAWN_UNLIKELY(id >= mod_out_.functions.Length())) {
+            Error() << "function id " << id << " out of range";
+            return nullptr;
+        }
+        return mod_out_.functions[id];
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Blocks
+    ////////////////////////////////////////////////////////////////////////////
+    void PopulateBlock(ir::Block* block_out, const flat::Block& block_in) {
+        if (auto* mib = block_out->As<ir::MultiInBlock>()) {
+            Vector<ir::BlockParam*, 8> params;
+            ForeachId(block_in.params_first, block_in.params_count, [&](uint32_t param_in) {
+                auto* param_out = ValueAs<BlockParam>(param_in);
+                if (DAWN_LIKELY(param_out)) {
+                    params.Push(param_out);
+                }
+            });
+            mib->SetParams(std::move(params));
+        }
+        if (CheckRange(Section::kInstructions, block_in.instructions_first,
+                       block_in.instructions_count)) {
+            for (uint32_t i = 0; i < block_in.instructions_count; i++) {
+                auto inst_in = Record<flat::Instruction>(Section::kInstructions,
+                                                         block_in.instructions_first + i);
+                block_out->Append(Instruction(inst_in));
+            }
+        }
+    }
+
+    ir::Block* Block(uint32_t id) {
+        if (DAWN_UNLIKELY(id >= blocks_.Length())) {
+            Error() << "block id " << id << " out of range";
+            return b.Block();
+        }
+        return blocks_[id];
+    }
+
+    /// @returns the block with the 1-based id @p id, or a new empty block if @p id is 0
+    ir::Block* OptionalBlock(uint32_t id) { return id > 0 ? Block(id - 1) : b.Block(); }
+
+    template <typename T>
+    T* BlockAs(uint32_t id) {
+        auto* block = Block(id);
+        if (auto cast = As<T>(block); DAWN_LIKELY(cast)) {
+            return cast;
+        }
+        Error() << "block " << id << " is " << (block ? block->TypeInfo().name : "<null>")
+                << " expected " << TypeInfo::Of<T>().name;
+        return nullptr;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Instructions
+    ////////////////////////////////////////////////////////////////////////////
+    ir::Instruction* Instruction(const flat::Instruction& inst_in) {
+        ir::Instruction* inst_out = nullptr;
+        switch (inst_in.kind) {
+            case InstructionKind::kAccess:
+                inst_out = mod_out_.CreateInstruction<ir::Access>();
+                break;
+            case InstructionKind::kBinary: {
+                auto* binary_out = mod_out_.CreateInstruction<ir::CoreBinary>();
+                binary_out->SetOp(BinaryOp(inst_in.a));
+                inst_out = binary_out;
+                break;
+            }
+            case InstructionKind::kBitcast:
+                inst_out = mod_out_.CreateInstruction<ir::Bitcast>();
+                break;
+            case InstructionKind::kBreakIf:
+                inst_out = Track(break_ifs_, mod_out_.CreateInstruction<ir::BreakIf>());
+                break;
+            case InstructionKind::kBuiltinCall: {
+                auto* call_out = mod_out_.CreateInstruction<ir::CoreBuiltinCall>();
+                call_out->SetFunc(BuiltinFn(inst_in.a));
+                inst_out = call_out;
+                break;
+            }
+            case InstructionKind::kConstruct:
+                inst_out = mod_out_.CreateInstruction<ir::Construct>();
+                break;
+            case InstructionKind::kContinue:
+                inst_out = Track(continues_, mod_out_.CreateInstruction<ir::Continue>());
+                break;
+            case InstructionKind::kConvert:
+                inst_out = mod_out_.CreateInstruction<ir::Convert>();
+                break;
+            case InstructionKind::kDiscard:
+                inst_out = mod_out_.CreateInstruction<ir::Discard>();
+                break;
+            case InstructionKind::kExitIf:
+                inst_out = Track(exit_ifs_, mod_out_.CreateInstruction<ir::ExitIf>());
+                break;
+            case InstructionKind::kExitLoop:
+                inst_out = Track(exit_loops_, mod_out_.CreateInstruction<ir::ExitLoop>());
+                break;
+            case InstructionKind::kExitSwitch:
+                inst_out = Track(exit_switches_, mod_out_.CreateInstruction<ir::ExitSwitch>());
+                break;
+            case InstructionKind::kIf: {
+                auto* if_out = mod_out_.CreateInstruction<ir::If>();
+                if_out->SetTrue(OptionalBlock(inst_in.a));
+                if_out->SetFalse(OptionalBlock(inst_in.b));
+                inst_out = if_out;
+                break;
+            }
+            case InstructionKind::kLet:
+                inst_out = mod_out_.CreateInstruction<ir::Let>();
+                break;
+            case InstructionKind::kLoad:
+                inst_out = mod_out_.CreateInstruction<ir::Load>();
+                break;
+            case InstructionKind::kLoadVectorElement:
+                inst_out = mod_out_.CreateInstruction<ir::LoadVectorElement>();
+                break;
+            case InstructionKind::kLoop:
+                inst_out = CreateInstructionLoop(inst_in);
+                break;
+            case InstructionKind::kNextIteration:
+                inst_out = Track(next_iterations_, mod_out_.CreateInstruction<ir::NextIteration>());
+                break;
+            case InstructionKind::kReturn:
+                inst_out = mod_out_.CreateInstruction<ir::Return>();
+                break;
+            case InstructionKind::kStore:
+                inst_out = mod_out_.CreateInstruction<ir::Store>();
+                break;
+            case InstructionKind::kStoreVectorElement:
+                inst_out = mod_out_.CreateInstruction<ir::StoreVectorElement>();
+                break;
+            case InstructionKind::kSwitch:
+                inst_out = CreateInstructionSwitch(inst_in);
+                break;
+            case InstructionKind::kSwizzle: {
+                auto* swizzle_out = mod_out_.CreateInstruction<ir::Swizzle>();
+                Vector<uint32_t, 4> indices;
+                ForeachId(inst_in.a, inst_in.b, [&](uint32_t idx) { indices.Push(idx); });
+                swizzle_out->SetIndices(indices);
+                inst_out = swizzle_out;
+                break;
+            }
+            case InstructionKind::kUnary: {
+                auto* unary_out = mod_out_.CreateInstruction<ir::CoreUnary>();
+                unary_out->SetOp(UnaryOp(inst_in.a));
+                inst_out = unary_out;
+                break;
+            }
+            case InstructionKind::kUnreachable:
+                inst_out = b.Unreachable();
+                break;
+            case InstructionKind::kUserCall:
+                inst_out = mod_out_.CreateInstruction<ir::UserCall>();
+                break;
+            case InstructionKind::kVar:
+                inst_out = CreateInstructionVar(inst_in);
+                break;
+        }
+        if (!inst_out) {
+            Error() << "invalid Instruction.kind: " << static_cast<uint32_t>(inst_in.kind);
+            return b.Let(mod_out_.Types().invalid());
+        }
+
+        Vector<ir::Value*, 4> operands;
+        ForeachId(inst_in.operands_first, inst_in.operands_count,
+                  [&](uint32_t id) { operands.Push(Value(id)); });
+        inst_out->SetOperands(std::move(operands));
+
+        Vector<ir::InstructionResult*, 4> results;
+        ForeachId(inst_in.results_first, inst_in.results_count,
+                  [&](uint32_t id) { results.Push(ValueAs<ir::InstructionResult>(id)); });
+        inst_out->SetResults(std::move(results));
+
+        if (inst_in.kind == InstructionKind::kBreakIf) {
+            auto num_next_iter_values = inst_in.a;
+            bool is_valid =
+                inst_out->Operands().Length() >= num_next_iter_values + BreakIf::kArgsOperandOffset;
+            if (DAWN_LIKELY(is_valid)) {
+                static_cast<BreakIf*>(inst_out)->SetNumNextIterValues(num_next_iter_values);
+            } else {
+                Error() << "invalid value for num_next_iter_values()";
+            }
+        }
+
+        return inst_out;
+    }
+
+    /// Appends @p inst to @p list, so that its control instruction can be inferred once all the
+    /// blocks have been populated.
+    /// @returns @p inst
+    template <typename T, size_t N>
+    T* Track(Vector<T*, N>& list, T* inst) {
+        list.Push(inst);
+        return inst;
+    }
+
+    ir::Loop* CreateInstructionLoop(const flat::Instruction& loop_in) {
+        auto* loop_out = mod_out_.CreateInstruction<ir::Loop>();
+        loop_out->SetInitializer(OptionalBlock(loop_in.a));
+        loop_out->SetBody(BlockAs<ir::MultiInBlock>(loop_in.b));
+        if (loop_in.c > 0) {
+            loop_out->SetContinuing(BlockAs<ir::MultiInBlock>(loop_in.c - 1));
+        } else {
+            loop_out->SetContinuing(b.MultiInBlock());
+        }
+        return loop_out;
+    }
+
+    ir::Switch* CreateInstructionSwitch(const flat::Instruction& switch_in) {
+        auto* switch_out = mod_out_.CreateInstruction<ir::Switch>();
+        if (!CheckRange(Section::kSwitchCases, switch_in.a, switch_in.b)) {
+            return switch_out;
+        }
+        for (uint32_t i = 0; i < switch_in.b; i++) {
+            auto case_in = Record<flat::SwitchCase>(Section::kSwitchCases, switch_in.a + i);
+            ir::Switch::Case case_out{};
+            case_out.block = Block(case_in.block);
+            case_out.block->SetParent(switch_out);
+            ForeachId(case_in.selectors_first, case_in.selectors_count, [&](uint32_t selector_in) {
+                ir::Switch::CaseSelector selector_out{};
+                selector_out.val = Constant(selector_in);
+                case_out.selectors.Push(std::move(selector_out));
+            });
+            if (case_in.is_default) {
+                ir::Switch::CaseSelector selector_out{};
+                case_out.selectors.Push(std::move(selector_out));
+            }
+            switch_out->Cases().Push(std::move(case_out));
+        }
+        return switch_out;
+    }
+
+    ir::Var* CreateInstructionVar(const flat::Instruction& var_in) {
+        auto* var_out = mod_out_.CreateInstruction<ir::Var>();
+        if (auto attrs = Attributes(var_in.a)) {
+            if (attrs->flags & kHasBindingPoint) {
+                var_out->SetBindingPoint(attrs->group, attrs->binding);
+            }
+            if (attrs->flags & kHasInputAttachmentIndex) {
+                var_out->SetInputAttachmentIndex(attrs->input_attachment_index);
+            }
+        }
+        return var_out;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////////////////////
+    const type::Type* CreateType(const flat::Type& type_in) {
+        switch (type_in.kind) {
+            case TypeKind::kVoid:
+                return mod_out_.Types().Get<void>();
+            case TypeKind::kBool:
+                return mod_out_.Types().Get<bool>();
+            case TypeKind::kI32:
+                return mod_out_.Types().Get<i32>();
+            case TypeKind::kU32:
+                return mod_out_.Types().Get<u32>();
+            case TypeKind::kF32:
+                return mod_out_.Types().Get<f32>();
+            case TypeKind::kF16:
+                return mod_out_.Types().Get<f16>();
+            case TypeKind::kVector:
+                return CreateTypeVector(type_in);
+            case TypeKind::kMatrix:
+                return CreateTypeMatrix(type_in);
+            case TypeKind::kPointer:
+                return mod_out_.Types().ptr(AddressSpace(type_in.a), Type(type_in.b),
+                                            AccessControl(type_in.c));
+            case TypeKind::kStruct:
+                return CreateTypeStruct(type_in);
+            case TypeKind::kAtomic:
+                return mod_out_.Types().atomic(Type(type_in.a));
+            case TypeKind::kArray:
+                return CreateTypeArray(type_in);
+            case TypeKind::kDepthTexture:
+                return CreateTypeDepthTexture(type_in);
+            case TypeKind::kSampledTexture:
+                return mod_out_.Types().Get<type::SampledTexture>(TextureDimension(type_in.a),
+                                                                  Type(type_in.b));
+            case TypeKind::kMultisampledTexture:
+                return mod_out_.Types().Get<type::MultisampledTexture>(
+                    TextureDimension(type_in.a), Type(type_in.b));
+            case TypeKind::kDepthMultisampledTexture:
+                return CreateTypeDepthMultisampledTexture(type_in);
+            case TypeKind::kStorageTexture: {
+                auto texel_format = TexelFormat(type_in.b);
+                return mod_out_.Types().Get<type::StorageTexture>(
+                    TextureDimension(type_in.a), texel_format, AccessControl(type_in.c),
+                    type::StorageTexture::SubtypeFor(texel_format, b.ir.Types()));
+            }
+            case TypeKind::kExternalTexture:
+                return mod_out_.Types().Get<type::ExternalTexture>();
+            case TypeKind::kSampler:
+                return mod_out_.Types().Get<type::Sampler>(SamplerKind(type_in.a));
+            case TypeKind::kInputAttachment:
+                return mod_out_.Types().Get<type::InputAttachment>(Type(type_in.a));
+        }
+
+        Error() << "invalid Type.kind: " << static_cast<uint32_t>(type_in.kind);
+        return mod_out_.Types().invalid();
+    }
+
+    const type::Type* CreateTypeVector(const flat::Type& vector_in) {
+        const auto width = vector_in.a;
+        if (DAWN_UNLIKELY(width < 2 || width > 4)) {
+            Error() << "invalid vector width";
+            return mod_out_.Types().invalid();
+        }
+        return mod_out_.Types().vec(Type(vector_in.b), width);
+    }
+
+    const type::Type* CreateTypeMatrix(const flat::Type& matrix_in) {
+        const auto cols = matrix_in.a;
+        const auto rows = matrix_in.b;
+        if (DAWN_UNLIKELY(rows < 2 || rows > 4 || cols < 2 || cols > 4)) {
+            Error() << "invalid matrix dimensions";
+            return mod_out_.Types().invalid();
+        }
+        auto* column_ty = mod_out_.Types().vec(Type(matrix_in.c), rows);
+        return mod_out_.Types().mat(column_ty, cols);
+    }
+
+    const type::Type* CreateTypeStruct(const flat::Type& struct_in) {
+        auto struct_name = String(struct_in.a);
+        if (DAWN_UNLIKELY(struct_name.empty())) {
+            Error() << "struct must have a name";
+            return mod_out_.Types().invalid();
+        }
+
+        if (DAWN_UNLIKELY(struct_name.find('\0') != std::string_view::npos)) {
+            Error() << "structure name '" << struct_name
+                    << "' contains '\\0' before end of the string";
+            return mod_out_.Types().invalid();
+        }
+
+        if (!struct_names_.Add(std::string(struct_name))) {
+            Error() << "duplicate struct name: " << style::Type(struct_name);
+            return mod_out_.Types().invalid();
+        }
+
+        if (!CheckRange(Section::kStructMembers, struct_in.b, struct_in.c)) {
+            return mod_out_.Types().invalid();
+        }
+
+        Vector<const core::type::StructMember*, 8> members_out;
+        uint32_t offset = 0;
+        for (uint32_t i = 0; i < struct_in.c; i++) {
+            auto member_in = Record<flat::StructMember>(Section::kStructMembers, struct_in.b + i);
+            auto member_name = String(member_in.name);
+            if (DAWN_UNLIKELY(member_name.empty())) {
+                Error() << "struct member must have a name";
+                return mod_out_.Types().invalid();
+            }
+
+            if (DAWN_UNLIKELY(member_name.find('\0') != std::string_view::npos)) {
+                Error() << "member name '" << member_name
+                        << "' contains '\\0' before end of the string";
+                return mod_out_.Types().invalid();
+            }
+
+            auto symbol = mod_out_.symbols.Register(member_name);
+            auto* type = Type(member_in.type);
+            auto index = static_cast<uint32_t>(members_out.Length());
+            auto align = member_in.align;
+            auto size = member_in.size;
+            if (DAWN_UNLIKELY(align == 0)) {
+                Error() << "struct member must have non-zero alignment";
+                align = 1;
+            }
+            if (DAWN_UNLIKELY(size == 0)) {
+                Error() << "struct member must have non-zero size";
+                size = 1;
+            }
+            core::IOAttributes attributes_out{};
+            if (auto attrs = Attributes(member_in.attributes)) {
+                if (attrs->flags & kHasLocation) {
+                    attributes_out.location = attrs->location;
+                }
+                if (attrs->flags & kHasBlendSrc) {
+                    attributes_out.blend_src = attrs->blend_src;
+                }
+                if (attrs->flags & kHasColor) {
+                    attributes_out.color = attrs->color;
+                }
+                if (attrs->flags & kHasBuiltin) {
+                    attributes_out.builtin = BuiltinValue(attrs->builtin);
+                }
+                if (attrs->flags & kHasInterpolation) {
+                    attributes_out.interpolation = Interpolation(*attrs);
+                }
+                attributes_out.invariant = (attrs->flags & kInvariant) != 0;
+            }
+            offset = RoundUp(align, offset);
+            auto* member_out = mod_out_.Types().Get<core::type::StructMember>(
+                symbol, type, index, offset, align, size, std::move(attributes_out));
+            offset += size;
+            members_out.Push(member_out);
+        }
+        if (DAWN_UNLIKELY(members_out.IsEmpty())) {
+            Error() << "struct requires at least one member";
+            return mod_out_.Types().invalid();
+        }
+        auto name = mod_out_.symbols.Register(struct_name);
+        return mod_out_.Types().Struct(name, std::move(members_out));
+    }
+
+    const type::Type* CreateTypeArray(const flat::Type& array_in) {
+        auto* element = Type(array_in.a);
+        uint32_t count = array_in.b;
+        uint32_t stride = array_in.c;
+        if (element->Align() == 0 || element->Size() == 0) {
+            Error() << "cannot create an array of an unsized type";
+            return mod_out_.Types().invalid();
+        }
+        uint32_t implicit_stride = tint::RoundUp(element->Align(), element->Size());
+        if (stride < implicit_stride) {
+            Error() << "array element stride is smaller than the implicit stride";
+            return mod_out_.Types().invalid();
+        }
+        if (count >= internal_limits::kMaxArrayElementCount) {
+            Error() << "array count (" << count << ") must be less than "
+                    << internal_limits::kMaxArrayElementCount;
+            return mod_out_.Types().invalid();
+        }
+
+        return count > 0 ? mod_out_.Types().array(element, count, stride)
+                         : mod_out_.Types().runtime_array(element, stride);
+    }
+
+    const type::Type* CreateTypeDepthTexture(const flat::Type& texture_in) {
+        auto dimension = TextureDimension(texture_in.a);
+        if (!type::DepthTexture::IsValidDimension(dimension)) {
+            Error() << "invalid DepthTexture dimension";
+            return mod_out_.Types().invalid();
+        }
+        return mod_out_.Types().Get<type::DepthTexture>(dimension);
+    }
+
+    const type::Type* CreateTypeDepthMultisampledTexture(const flat::Type& texture_in) {
+        auto dimension = TextureDimension(texture_in.a);
+        if (!type::DepthMultisampledTexture::IsValidDimension(dimension)) {
+            Error() << "invalid DepthMultisampledTexture dimension";
+            return mod_out_.Types().invalid();
+        }
+        return mod_out_.Types().Get<type::DepthMultisampledTexture>(dimension);
+    }
+
+    const type::Type* Type(uint32_t id) {
+        if (DAWN_UNLIKELY(id >= types_.Length())) {
+            Error() << "type id " << id << " out of range";
+            return mod_out_.Types().invalid();
+        }
+        return types_[id];
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Values
+    ////////////////////////////////////////////////////////////////////////////
+    ir::Value* CreateValue(const flat::Value& value_in) {
+        ir::Value* value_out = nullptr;
+        switch (value_in.kind) {
+            case ValueKind::kFunction:
+                value_out = Function(value_in.a);
+                break;
+            case ValueKind::kInstructionResult:
+                value_out = Named(b.InstructionResult(Type(value_in.a)), value_in.b, "result");
+                break;
+            case ValueKind::kFunctionParameter:
+                value_out = FunctionParameter(value_in);
+                break;
+            case ValueKind::kBlockParameter:
+                value_out = Named(b.BlockParam(Type(value_in.a)), value_in.b, "param");
+                break;
+            case ValueKind::kConstant:
+                value_out = Constant(value_in.a);
+                break;
+        }
+
+        if (!value_out) {
+            Error() << "invalid value kind: " << static_cast<uint32_t>(value_in.kind);
+            return b.InvalidConstant();
+        }
+
+        return value_out;
+    }
+
+    /// Sets the name of @p value to the string with id @p name.
+    /// @returns @p value, or nullptr if the name is invalid
+    template <typename T>
+    T* Named(T* value, uint32_t name, const char* what) {
+        if (name != 0) {
+            auto str = Name(name, what);
+            if (DAWN_UNLIKELY(str.empty())) {
+                return nullptr;
+            }
+            mod_out_.SetName(value, str);
+        }
+        return value;
+    }
+
+    ir::FunctionParam* FunctionParameter(const flat::Value& param_in) {
+        auto* param_out = Named(b.FunctionParam(Type(param_in.a)), param_in.b, "param");
+        if (!param_out) {
+            return nullptr;
+        }
+        if (auto attrs = Attributes(param_in.c)) {
+            if (attrs->flags & kHasBindingPoint) {
+                param_out->SetBindingPoint(attrs->group, attrs->binding);
+            }
+            if (attrs->flags & kHasLocation) {
+                param_out->SetLocation(attrs->location);
+            }
+            if (attrs->flags & kHasColor) {
+                param_out->SetColor(attrs->color);
+            }
+            if (attrs->flags & kHasInterpolation) {
+                param_out->SetInterpolation(Interpolation(*attrs));
+            }
+            if (attrs->flags & kHasBuiltin) {
+                param_out->SetBuiltin(BuiltinValue(attrs->builtin));
+            }
+            if (attrs->flags & kInvariant) {
+                param_out->SetInvariant(true);
+            }
+        }
+        return param_out;
+    }
+
+    ir::Constant* Constant(uint32_t value_id) { return b.Constant(ConstantValue(value_id)); }
+
+    ir::Value* Value(uint32_t id) {
+        if (DAWN_UNLIKELY(id > values_.Length())) {
+            Error() << "value id " << id << " out of range";
+            return nullptr;
+        }
+        return id > 0 ? values_[id - 1] : nullptr;
+    }
+
+    template <typename T>
+    T* ValueAs(uint32_t id) {
+        auto* value = Value(id);
+        if (auto cast = As<T>(value); DAWN_LIKELY(cast)) {
+            return cast;
+        }
+        Error() << "value " << id << " is " << (value ? value->TypeInfo().name : "<null>")
+                << " expected " << TypeInfo::Of<T>().name;
+        return nullptr;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // ConstantValues
+    ////////////////////////////////////////////////////////////////////////////
+    const core::constant::Value* CreateConstantValue(const flat::Constant& value_in) {
+        switch (value_in.kind) {
+            case ConstantKind::kBool:
+                return b.ConstantValue(value_in.a != 0);
+            case ConstantKind::kI32:
+                return b.ConstantValue(i32(FromBits<int32_t>(value_in.a)));
+            case ConstantKind::kU32:
+                return b.ConstantValue(u32(value_in.a));
+            case ConstantKind::kF32:
+                return b.ConstantValue(CheckFinite(f32(FromBits<float>(value_in.a))));
+            case ConstantKind::kF16:
+                return b.ConstantValue(CheckFinite(f16(FromBits<float>(value_in.a))));
+            case ConstantKind::kComposite:
+                return CreateConstantComposite(value_in);
+            case ConstantKind::kSplat:
+                return CreateConstantSplat(value_in);
+        }
+        Error() << "invalid ConstantValue.kind: " << static_cast<uint32_t>(value_in.kind);
+        return b.InvalidConstant()->Value();
+    }
+
+    /// @returns the 32-bit scalar with the bits @p bits
+    template <typename T>
+    T FromBits(uint32_t bits) {
+        static_assert(sizeof(T) == sizeof(uint32_t));
+        T value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    const core::constant::Value* CreateConstantComposite(const flat::Constant& composite_in) {
+        auto* type = Type(composite_in.a);
+        auto type_elements = type->Elements();
+        size_t num_values = composite_in.c;
+        if (DAWN_UNLIKELY(type_elements.count == 0)) {
+            Error() << "cannot create a composite of type " << type->FriendlyName();
+            return b.InvalidConstant()->Value();
+        }
+        if (DAWN_UNLIKELY(type_elements.count != num_values)) {
+            Error() << "constant composite type " << type->FriendlyName() << " expects "
+                    << type_elements.count << " elements, but " << num_values << " values encoded";
+            return b.InvalidConstant()->Value();
+        }
+        if (!CheckRange(Section::kIds, composite_in.b, composite_in.c)) {
+            return b.InvalidConstant()->Value();
+        }
+        Vector<const core::constant::Value*, 8> elements_out;
+        for (uint32_t i = 0; i < composite_in.c; i++) {
+            auto* value = ConstantValue(Record<uint32_t>(Section::kIds, composite_in.b + i));
+            if (auto* el_type = type->Element(i); DAWN_UNLIKELY(value->Type() != el_type)) {
+                Error() << "constant composite element value type " << value->Type()->FriendlyName()
+                        << " does not match element type " << el_type->FriendlyName();
+                return b.InvalidConstant()->Value();
+            }
+            elements_out.Push(value);
+        }
+        return mod_out_.constant_values.Composite(type, std::move(elements_out));
+    }
+
+    const core::constant::Value* CreateConstantSplat(const flat::Constant& splat_in) {
+        auto* type = Type(splat_in.a);
+        uint32_t num_elements = type->Elements().count;
+        if (DAWN_UNLIKELY(num_elements == 0)) {
+            Error() << "cannot create a splat of type " << type->FriendlyName();
+            return b.InvalidConstant()->Value();
+        }
+        if (DAWN_UNLIKELY(num_elements > internal_limits::kMaxArrayConstructorElements)) {
+            Error() << "array constructor has excessive number of elements (>"
+                    << internal_limits::kMaxArrayConstructorElements << ")";
+            return b.InvalidConstant()->Value();
+        }
+        auto* value = ConstantValue(splat_in.b);
+        for (uint32_t i = 0; i < num_elements; i++) {
+            auto* el_type = type->Element(i);
+            if (DAWN_UNLIKELY(el_type != value->Type())) {
+                Error() << "constant splat element value type " << value->Type()->FriendlyName()
+                        << " does not match element " << i << " type " << el_type->FriendlyName();
+                return b.InvalidConstant()->Value();
+            }
+        }
+        return mod_out_.constant_values.Splat(type, value);
+    }
+
+    const core::constant::Value* ConstantValue(uint32_t id) {
+        if (DAWN_UNLIKELY(id >= constant_values_.Length())) {
+            Error() << "constant value id " << id << " out of range";
+            return b.InvalidConstant()->Value();
+        }
+        return constant_values_[id];
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Attributes
+    ////////////////////////////////////////////////////////////////////////////
+    /// @returns the attributes with the 1-based id @p id, or std::nullopt if @p id is 0
+    std::optional<flat::Attributes> Attributes(uint32_t id) {
+        if (id == 0) {
+            return std::nullopt;
+        }
+        if (DAWN_UNLIKELY(id > Count(Section::kAttributes))) {
+            Error() << "attributes id " << id << " out of range";
+            return std::nullopt;
+        }
+        return Record<flat::Attributes>(Section::kAttributes, id - 1);
+    }
+
+    core::Interpolation Interpolation(const flat::Attributes& attrs) {
+        core::Interpolation interpolation_out{};
+        interpolation_out.type = Enum(attrs.interpolation_type, InterpolationType::kFlat,
+                                      InterpolationType::kPerspective, "InterpolationType");
+        interpolation_out.sampling =
+            Enum(attrs.interpolation_sampling, InterpolationSampling::kUndefined,
+                 InterpolationSampling::kSample, "InterpolationSampling");
+        return interpolation_out;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Enums
+    ////////////////////////////////////////////////////////////////////////////
+    /// @returns @p in as the enum ENUM, erroring if @p in is not in the range [@p first, @p last]
+    template <typename ENUM>
+    ENUM Enum(uint32_t in, ENUM first, ENUM last, const char* name) {
+        if (DAWN_UNLIKELY(in < static_cast<uint32_t>(first) || in > static_cast<uint32_t>(last))) {
+            Error() << "invalid " << name << ": " << in;
+            return first;
+        }
+        return static_cast<ENUM>(in);
+    }
+
+    ir::Function::PipelineStage PipelineStage(uint32_t in) {
+        return Enum(in, ir::Function::PipelineStage::kUndefined,
+                    ir::Function::PipelineStage::kVertex, "PipelineStage");
+    }
+
+    core::AddressSpace AddressSpace(uint32_t in) {
+        return Enum(in, core::AddressSpace::kFunction, core::AddressSpace::kWorkgroup,
+                    "AddressSpace");
+    }
+
+    core::Access AccessControl(uint32_t in) {
+        return Enum(in, core::Access::kRead, core::Access::kWrite, "Access");
+    }
+
+    core::UnaryOp UnaryOp(uint32_t in) {
+        return Enum(in, core::UnaryOp::kAddressOf, core::UnaryOp::kNot, "UnaryOp");
+    }
+
+    core::BinaryOp BinaryOp(uint32_t in) {
+        return Enum(in, core::BinaryOp::kAnd, core::BinaryOp::kModulo, "BinaryOp");
+    }
+
+    core::type::TextureDimension TextureDimension(uint32_t in) {
+        return Enum(in, core::type::TextureDimension::k1d, core::type::TextureDimension::kCubeArray,
+                    "TextureDimension");
+    }
+
+    core::TexelFormat TexelFormat(uint32_t in) {
+        return Enum(in, core::TexelFormat::kBgra8Unorm, core::TexelFormat::kRgba8Unorm,
+                    "TexelFormat");
+    }
+
+    core::type::SamplerKind SamplerKind(uint32_t in) {
+        return Enum(in, core::type::SamplerKind::kSampler,
+                    core::type::SamplerKind::kComparisonSampler, "SamplerKind");
+    }
+
+    core::BuiltinValue BuiltinValue(uint32_t in) {
+        return Enum(in, core::BuiltinValue::kPointSize, core::BuiltinValue::kWorkgroupId,
+                    "BuiltinValue");
+    }
+
+    core::BuiltinFn BuiltinFn(uint32_t in) {
+        return Enum(in, core::BuiltinFn::kAbs, core::BuiltinFn::kQuadSwapDiagonal, "BuiltinFn");
+    }
+};
+
+}  // namespace
+
+Result<Module> Decode(Slice<const std::byte> encoded) {
+    return Decoder{encoded}.Decode();
+}
+
+Result<Module> DecodeFile(const std::string& path) {
+    MappedFile file(path);
+    if (!file) {
+        return Failure{"failed to map file '" + path + "'"};
+    }
+    return Decode(Slice<const std::byte>{file.Data(), file.Size()});
+}
+
+}  // namespace tint::core::ir::binary::flat
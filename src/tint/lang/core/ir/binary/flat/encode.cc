@@ -0,0 +1,761 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/core/ir/binary/flat/encode.h"
+
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "src/tint/lang/core/constant/composite.h"
+#include "src/tint/lang/core/constant/scalar.h"
+#include "src/tint/lang/core/constant/splat.h"
+#include "src/tint/lang/core/ir/access.h"
+#include "src/tint/lang/core/ir/binary/flat/format.h"
+#include "src/tint/lang/core/ir/bitcast.h"
+#include "src/tint/lang/core/ir/break_if.h"
+#include "src/tint/lang/core/ir/construct.h"
+#include "src/tint/lang/core/ir/continue.h"
+#include "src/tint/lang/core/ir/convert.h"
+#include "src/tint/lang/core/ir/core_binary.h"
+#include "src/tint/lang/core/ir/core_builtin_call.h"
+#include "src/tint/lang/core/ir/core_unary.h"
+#include "src/tint/lang/core/ir/discard.h"
+#include "src/tint/lang/core/ir/exit_if.h"
+#include "src/tint/lang/core/ir/exit_loop.h"
+#include "src/tint/lang/core/ir/exit_switch.h"
+#include "src/tint/lang/core/ir/function_param.h"
+#include "src/tint/lang/core/ir/if.h"
+#include "src/tint/lang/core/ir/let.h"
+#include "src/tint/lang/core/ir/load.h"
+#include "src/tint/lang/core/ir/load_vector_element.h"
+#include "src/tint/lang/core/ir/loop.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/multi_in_block.h"
+#include "src/tint/lang/core/ir/next_iteration.h"
+#include "src/tint/lang/core/ir/return.h"
+#include "src/tint/lang/core/ir/store.h"
+#include "src/tint/lang/core/ir/store_vector_element.h"
+#include "src/tint/lang/core/ir/switch.h"
+#include "src/tint/lang/core/ir/swizzle.h"
+#include "src/tint/lang/core/ir/unreachable.h"
+#include "src/tint/lang/core/ir/user_call.h"
+#include "src/tint/lang/core/ir/var.h"
+#include "src/tint/lang/core/type/array.h"
+#include "src/tint/lang/core/type/bool.h"
+#include "src/tint/lang/core/type/depth_multisampled_texture.h"
+#include "src/tint/lang/core/type/depth_texture.h"
+#include "src/tint/lang/core/type/external_texture.h"
+#include "src/tint/lang/core/type/f16.h"
+#include "src/tint/lang/core/type/f32.h"
+#include "src/tint/lang/core/type/i32.h"
+#include "src/tint/lang/core/type/input_attachment.h"
+#include "src/tint/lang/core/type/matrix.h"
+#include "src/tint/lang/core/type/multisampled_texture.h"
+#include "src/tint/lang/core/type/pointer.h"
+#include "src/tint/lang/core/type/sampled_texture.h"
+#include "src/tint/lang/core/type/sampler.h"
+#include "src/tint/lang/core/type/storage_texture.h"
+#include "src/tint/lang/core/type/u32.h"
+#include "src/tint/lang/core/type/void.h"
+#include "src/tint/utils/constants/internal_limits.h"
+#include "src/tint/utils/containers/hashmap.h"
+#include "src/tint/utils/macros/compiler.h"
+#include "src/tint/utils/math/math.h"
+#include "src/tint/utils/rtti/switch.h"
+
+namespace tint::core::ir::binary::flat {
+namespace {
+
+struct Encoder {
+    const Module& mod_in_;
+
+    // The output sections
+    Vector<flat::String, 32> strings_out_{};
+    std::string string_data_out_{};
+    Vector<flat::Type, 32> types_out_{};
+    Vector<flat::StructMember, 32> struct_members_out_{};
+    Vector<flat::Attributes, 16> attributes_out_{};
+    Vector<flat::Constant, 32> constants_out_{};
+    Vector<flat::Value, 64> values_out_{};
+    Vector<flat::Function, 16> functions_out_{};
+    Vector<flat::Block, 32> blocks_out_{};
+    Vector<flat::Instruction, 64> instructions_out_{};
+    Vector<flat::SwitchCase, 16> switch_cases_out_{};
+    Vector<uint32_t, 128> ids_out_{};
+
+    Hashmap<std::string, uint32_t, 32> strings_{};
+    Hashmap<const core::ir::Function*, uint32_t, 32> functions_{};
+    Hashmap<const core::ir::Block*, uint32_t, 32> blocks_{};
+    Hashmap<const core::type::Type*, uint32_t, 32> types_{};
+    Hashmap<const core::ir::Value*, uint32_t, 32> values_{};
+    Hashmap<const core::constant::Value*, uint32_t, 32> constant_values_{};
+
+    diag::List diags_{};
+
+    Result<Vector<std::byte, 0>> Encode() {
+        // Encode all user-declared structures first. This is to ensure that the IR disassembly
+        // (which prints structure types first) does not reorder after encoding and decoding.
+        for (auto* ty : mod_in_.Types()) {
+            if (auto* str = ty->As<core::type::Struct>()) {
+                Type(str);
+            }
+        }
+        for (auto& fn_in : mod_in_.functions) {
+            functions_.Add(fn_in, static_cast<uint32_t>(functions_out_.Length()));
+            functions_out_.Push(flat::Function{});
+        }
+        for (size_t i = 0, n = mod_in_.functions.Length(); i < n; i++) {
+            // Note: PopulateFunction() may grow functions_out_, so build the record before
+            // assigning it.
+            auto fn_out = PopulateFunction(mod_in_.functions[i]);
+            functions_out_[i] = fn_out;
+        }
+        uint32_t root_block = Block(mod_in_.root_block);
+
+        if (diags_.ContainsErrors()) {
+            return Failure{std::move(diags_)};
+        }
+        return Serialize(root_block);
+    }
+
+    /// Adds a new error to the diagnostics and returns a reference to it
+    diag::Diagnostic& Error() { return diags_.AddError(Source{}); }
+
+    /// Appends @p records to the end of @p section.
+    /// @returns the index of the first appended record
+    template <typename T, size_t N, typename RECORDS>
+    uint32_t Append(Vector<T, N>& section, const RECORDS& records) {
+        auto first = static_cast<uint32_t>(section.Length());
+        for (auto& record : records) {
+            section.Push(record);
+        }
+        return first;
+    }
+
+    /// @returns the number of elements in @p list as a uint32_t
+    template <typename T>
+    uint32_t Count(const T& list) {
+        return static_cast<uint32_t>(list.Length());
+    }
+
+    /// @returns the 1-based string id of @p str, or 0 if @p str is empty
+    uint32_t String(std::string_view str) {
+        if (str.empty()) {
+            return 0;
+        }
+        return strings_.GetOrAdd(std::string(str), [&] {
+            flat::String string_out{};
+            string_out.offset = static_cast<uint32_t>(string_data_out_.size());
+            string_out.length = static_cast<uint32_t>(str.size());
+            string_data_out_.append(str);
+            strings_out_.Push(string_out);
+            return Count(strings_out_);
+        });
+    }
+
+    /// @returns the numeric value of the enum @p value
+    template <typename ENUM>
+    uint32_t Enum(ENUM value) {
+        return static_cast<uint32_t>(value);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Functions
+    ////////////////////////////////////////////////////////////////////////////
+    flat::Function PopulateFunction(const ir::Function* fn_in) {
+        flat::Function fn_out{};
+        if (auto name = mod_in_.NameOf(fn_in)) {
+            fn_out.name = String(name.Name());
+        }
+        fn_out.return_type = Type(fn_in->ReturnType());
+        fn_out.stage = Enum(fn_in->Stage());
+        if (auto wg_size_in = fn_in->WorkgroupSize()) {
+            fn_out.has_workgroup_size = 1;
+            for (size_t i = 0; i < 3; i++) {
+                fn_out.workgroup_size[i] = Value((*wg_size_in)[i]);
+            }
+        }
+        Vector<uint32_t, 8> params;
+        for (auto* param_in : fn_in->Params()) {
+            params.Push(Value(param_in));
+        }
+        fn_out.params_first = Append(ids_out_, params);
+        fn_out.params_count = Count(params);
+
+        flat::Attributes attrs{};
+        if (auto ret_loc_in = fn_in->ReturnLocation()) {
+            attrs.flags |= kHasLocation;
+            attrs.location = *ret_loc_in;
+        }
+        if (auto ret_interp_in = fn_in->ReturnInterpolation()) {
+            Interpolation(attrs, *ret_interp_in);
+        }
+        if (auto builtin_in = fn_in->ReturnBuiltin()) {
+            attrs.flags |= kHasBuiltin;
+            attrs.builtin = Enum(*builtin_in);
+        }
+        if (fn_in->ReturnInvariant()) {
+            attrs.flags |= kInvariant;
+        }
+        fn_out.return_attributes = Attributes(attrs);
+        fn_out.block = Block(fn_in->Block());
+        return fn_out;
+    }
+
+    uint32_t Function(const ir::Function* fn_in) { return *functions_.Get(fn_in); }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Blocks
+    ////////////////////////////////////////////////////////////////////////////
+    uint32_t Block(const ir::Block* block_in) {
+        TINT_ASSERT(block_in != nullptr);
+
+        return blocks_.GetOrAdd(block_in, [&]() -> uint32_t {
+            auto id = Count(blocks_out_);
+            blocks_out_.Push(flat::Block{});
+
+            // Encoding the instructions may encode nested blocks, so gather the records before
+            // appending them to keep the block's instructions contiguous.
+            Vector<flat::Instruction, 16> instructions;
+            for (auto* inst : *block_in) {
+                instructions.Push(Instruction(inst));
+            }
+
+            flat::Block block_out{};
+            block_out.instructions_first = Append(instructions_out_, instructions);
+            block_out.instructions_count = Count(instructions);
+            if (auto* mib = block_in->As<ir::MultiInBlock>()) {
+                block_out.is_multi_in = 1;
+                Vector<uint32_t, 4> params;
+                for (auto* param : mib->Params()) {
+                    params.Push(Value(param));
+                }
+                block_out.params_first = Append(ids_out_, params);
+                block_out.params_count = Count(params);
+            }
+            blocks_out_[id] = block_out;
+            return id;
+        });
+    }
+
+    /// @returns the 1-based id of @p block_in, or 0 if @p block_in is null
+    uint32_t OptionalBlock(const ir::Block* block_in) { return block_in ? Block(block_in) + 1 : 0; }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Instructions
+    ////////////////////////////////////////////////////////////////////////////
+    flat::Instruction Instruction(const ir::Instruction* inst_in) {
+        flat::Instruction inst_out{};
+        auto kind = [&](InstructionKind k) { inst_out.kind = k; };
+        tint::Switch(
+            inst_in,  //
+            [&](const ir::Access*) { kind(InstructionKind::kAccess); },
+            [&](const ir::Bitcast*) { kind(InstructionKind::kBitcast); },
+            [&](const ir::BreakIf* i) {
+                kind(InstructionKind::kBreakIf);
+                inst_out.a = Count(i->NextIterValues());
+            },
+            [&](const ir::CoreBinary* i) {
+                kind(InstructionKind::kBinary);
+                inst_out.a = Enum(i->Op());
+            },
+            [&](const ir::CoreBuiltinCall* i) {
+                kind(InstructionKind::kBuiltinCall);
+                inst_out.a = Enum(i->Func());
+            },
+            [&](const ir::CoreUnary* i) {
+                kind(InstructionKind::kUnary);
+                inst_out.a = Enum(i->Op());
+            },
+            [&](const ir::Construct*) { kind(InstructionKind::kConstruct); },
+            [&](const ir::Continue*) { kind(InstructionKind::kContinue); },
+            [&](const ir::Convert*) { kind(InstructionKind::kConvert); },
+            [&](const ir::Discard*) { kind(InstructionKind::kDiscard); },
+            [&](const ir::ExitIf*) { kind(InstructionKind::kExitIf); },
+            [&](const ir::ExitLoop*) { kind(InstructionKind::kExitLoop); },
+            [&](const ir::ExitSwitch*) { kind(InstructionKind::kExitSwitch); },
+            [&](const ir::If* i) {
+                kind(InstructionKind::kIf);
+                inst_out.a = OptionalBlock(i->True());
+                inst_out.b = OptionalBlock(i->False());
+            },
+            [&](const ir::Let*) { kind(InstructionKind::kLet); },
+            [&](const ir::Load*) { kind(InstructionKind::kLoad); },
+            [&](const ir::LoadVectorElement*) { kind(InstructionKind::kLoadVectorElement); },
+            [&](const ir::Loop* i) {
+                kind(InstructionKind::kLoop);
+                inst_out.a = i->HasInitializer() ? OptionalBlock(i->Initializer()) : 0;
+                inst_out.b = Block(i->Body());
+                inst_out.c = i->HasContinuing() ? OptionalBlock(i->Continuing()) : 0;
+            },
+            [&](const ir::NextIteration*) { kind(InstructionKind::kNextIteration); },
+            [&](const ir::Return*) { kind(InstructionKind::kReturn); },
+            [&](const ir::Store*) { kind(InstructionKind::kStore); },
+            [&](const ir::StoreVectorElement*) { kind(InstructionKind::kStoreVectorElement); },
+            [&](const ir::Switch* i) {
+                kind(InstructionKind::kSwitch);
+                InstructionSwitch(inst_out, i);
+            },
+            [&](const ir::Swizzle* i) {
+                kind(InstructionKind::kSwizzle);
+                inst_out.a = Append(ids_out_, i->Indices());
+                inst_out.b = Count(i->Indices());
+            },
+            [&](const ir::UserCall*) { kind(InstructionKind::kUserCall); },
+            [&](const ir::Var* i) {
+                kind(InstructionKind::kVar);
+                InstructionVar(inst_out, i);
+            },
+            [&](const ir::Unreachable*) { kind(InstructionKind::kUnreachable); },
+            TINT_ICE_ON_NO_MATCH);
+
+        Vector<uint32_t, 8> operands;
+        for (auto* operand : inst_in->Operands()) {
+            operands.Push(Value(operand));
+        }
+        inst_out.operands_first = Append(ids_out_, operands);
+        inst_out.operands_count = Count(operands);
+
+        Vector<uint32_t, 4> results;
+        for (auto* result : inst_in->Results()) {
+            results.Push(Value(result));
+        }
+        inst_out.results_first = Append(ids_out_, results);
+        inst_out.results_count = Count(results);
+        return inst_out;
+    }
+
+    void InstructionSwitch(flat::Instruction& switch_out, const ir::Switch* switch_in) {
+        Vector<flat::SwitchCase, 8> cases;
+        for (auto& case_in : switch_in->Cases()) {
+            flat::SwitchCase case_out{};
+            case_out.block = Block(case_in.block);
+            Vector<uint32_t, 4> selectors;
+            for (auto& selector_in : case_in.selectors) {
+                if (selector_in.IsDefault()) {
+                    case_out.is_default = 1;
+                } else {
+                    selectors.Push(ConstantValue(selector_in.val->Value()));
+                }
+            }
+            case_out.selectors_first = Append(ids_out_, selectors);
+            case_out.selectors_count = Count(selectors);
+            cases.Push(case_out);
+        }
+        switch_out.a = Append(switch_cases_out_, cases);
+        switch_out.b = Count(cases);
+    }
+
+    void InstructionVar(flat::Instruction& var_out, const ir::Var* var_in) {
+        flat::Attributes attrs{};
+        if (auto bp_in = var_in->BindingPoint()) {
+            attrs.flags |= kHasBindingPoint;
+            attrs.group = bp_in->group;
+            attrs.binding = bp_in->binding;
+        }
+        if (auto iidx_in = var_in->InputAttachmentIndex()) {
+            attrs.flags |= kHasInputAttachmentIndex;
+            attrs.input_attachment_index = *iidx_in;
+        }
+        var_out.a = Attributes(attrs);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////////////////////
+    uint32_t Type(const core::type::Type* type_in) {
+        TINT_ASSERT(type_in != nullptr);
+        return types_.GetOrAdd(type_in, [&]() -> uint32_t {
+            flat::Type type_out{};
+            auto kind = [&](TypeKind k) { type_out.kind = k; };
+            tint::Switch(
+                type_in,  //
+                [&](const core::type::Void*) { kind(TypeKind::kVoid); },
+                [&](const core::type::Bool*) { kind(TypeKind::kBool); },
+                [&](const core::type::I32*) { kind(TypeKind::kI32); },
+                [&](const core::type::U32*) { kind(TypeKind::kU32); },
+                [&](const core::type::F32*) { kind(TypeKind::kF32); },
+                [&](const core::type::F16*) { kind(TypeKind::kF16); },
+                [&](const core::type::Vector* v) {
+                    kind(TypeKind::kVector);
+                    type_out.a = v->Width();
+                    type_out.b = Type(v->Type());
+                },
+                [&](const core::type::Matrix* m) {
+                    kind(TypeKind::kMatrix);
+                    type_out.a = m->Columns();
+                    type_out.b = m->Rows();
+                    type_out.c = Type(m->Type());
+                },
+                [&](const core::type::Pointer* p) {
+                    kind(TypeKind::kPointer);
+                    type_out.a = Enum(p->AddressSpace());
+                    type_out.b = Type(p->StoreType());
+                    type_out.c = Enum(p->Access());
+                },
+                [&](const core::type::Struct* s) {
+                    kind(TypeKind::kStruct);
+                    TypeStruct(type_out, s);
+                },
+                [&](const core::type::Atomic* a) {
+                    kind(TypeKind::kAtomic);
+                    type_out.a = Type(a->Type());
+                },
+                [&](const core::type::Array* a) {
+                    kind(TypeKind::kArray);
+                    TypeArray(type_out, a);
+                },
+                [&](const core::type::DepthTexture* t) {
+                    kind(TypeKind::kDepthTexture);
+                    type_out.a = Enum(t->Dim());
+                },
+                [&](const core::type::SampledTexture* t) {
+                    kind(TypeKind::kSampledTexture);
+                    type_out.a = Enum(t->Dim());
+                    type_out.b = Type(t->Type());
+                },
+                [&](const core::type::MultisampledTexture* t) {
+                    kind(TypeKind::kMultisampledTexture);
+                    type_out.a = Enum(t->Dim());
+                    type_out.b = Type(t->Type());
+                },
+                [&](const core::type::DepthMultisampledTexture* t) {
+                    kind(TypeKind::kDepthMultisampledTexture);
+                    type_out.a = Enum(t->Dim());
+                },
+                [&](const core::type::StorageTexture* t) {
+                    kind(TypeKind::kStorageTexture);
+                    type_out.a = Enum(t->Dim());
+                    type_out.b = Enum(t->TexelFormat());
+                    type_out.c = Enum(t->Access());
+                },
+                [&](const core::type::ExternalTexture*) { kind(TypeKind::kExternalTexture); },
+                [&](const core::type::Sampler* s) {
+                    kind(TypeKind::kSampler);
+                    type_out.a = Enum(s->Kind());
+                },
+                [&](const core::type::InputAttachment* i) {
+                    kind(TypeKind::kInputAttachment);
+                    type_out.a = Type(i->Type());
+                },
+                [&](const core::type::SubgroupMatrix*) {
+                    // TODO(crbug.com/348702031): Encode SubgroupMatrix once it is fully
+                    // implemented. This matches the protobuf encoding.
+                    Error() << "SubgroupMatrix is currently not implemented";
+                },
+                TINT_ICE_ON_NO_MATCH);
+
+            types_out_.Push(type_out);
+            return Count(types_out_) - 1;
+        });
+    }
+
+    void TypeStruct(flat::Type& struct_out, const core::type::Struct* struct_in) {
+        struct_out.a = String(struct_in->Name().Name());
+        Vector<flat::StructMember, 8> members;
+        for (auto* member_in : struct_in->Members()) {
+            flat::StructMember member_out{};
+            member_out.name = String(member_in->Name().Name());
+            member_out.type = Type(member_in->Type());
+            member_out.size = member_in->Size();
+            member_out.align = member_in->Align();
+
+            auto& attrs_in = member_in->Attributes();
+            flat::Attributes attrs{};
+            if (attrs_in.location) {
+                attrs.flags |= kHasLocation;
+                attrs.location = *attrs_in.location;
+            }
+            if (attrs_in.blend_src) {
+                attrs.flags |= kHasBlendSrc;
+                attrs.blend_src = *attrs_in.blend_src;
+            }
+            if (attrs_in.color) {
+                attrs.flags |= kHasColor;
+                attrs.color = *attrs_in.color;
+            }
+            if (attrs_in.builtin) {
+                attrs.flags |= kHasBuiltin;
+                attrs.builtin = Enum(*attrs_in.builtin);
+            }
+            if (attrs_in.interpolation) {
+                Interpolation(attrs, *attrs_in.interpolation);
+            }
+            if (attrs_in.invariant) {
+                attrs.flags |= kInvariant;
+            }
+            member_out.attributes = Attributes(attrs);
+            members.Push(member_out);
+        }
+        struct_out.b = Append(struct_members_out_, members);
+        struct_out.c = Count(members);
+    }
+
+    void TypeArray(flat::Type& array_out, const core::type::Array* array_in) {
+        array_out.a = Type(array_in->ElemType());
+        array_out.c = array_in->Stride();
+        tint::Switch(
+            array_in->Count(),  //
+            [&](const core::type::ConstantArrayCount* c) {
+                array_out.b = c->value;
+                if (c->value >= internal_limits::kMaxArrayElementCount) {
+                    Error() << "array count (" << c->value << ") must be less than "
+                            << internal_limits::kMaxArrayElementCount;
+                }
+            },
+            [&](const core::type::RuntimeArrayCount*) { array_out.b = 0; },
+            TINT_ICE_ON_NO_MATCH);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Values
+    ////////////////////////////////////////////////////////////////////////////
+    uint32_t Value(const ir::Value* value_in) {
+        if (!value_in) {
+            return 0;
+        }
+        return values_.GetOrAdd(value_in, [&] {
+            flat::Value value_out{};
+            tint::Switch(
+                value_in,
+                [&](const ir::InstructionResult* v) {
+                    value_out.kind = ValueKind::kInstructionResult;
+                    value_out.a = Type(v->Type());
+                    value_out.b = Name(v);
+                },
+                [&](const ir::FunctionParam* v) {
+                    value_out.kind = ValueKind::kFunctionParameter;
+                    value_out.a = Type(v->Type());
+                    value_out.b = Name(v);
+                    value_out.c = FunctionParameterAttributes(v);
+                },
+                [&](const ir::BlockParam* v) {
+                    value_out.kind = ValueKind::kBlockParameter;
+                    value_out.a = Type(v->Type());
+                    value_out.b = Name(v);
+                },
+                [&](const ir::Function* v) {
+                    value_out.kind = ValueKind::kFunction;
+                    value_out.a = Function(v);
+                },
+                [&](const ir::Constant* v) {
+                    value_out.kind = ValueKind::kConstant;
+                    value_out.a = ConstantValue(v->Value());
+                },
+                TINT_ICE_ON_NO_MATCH);
+
+            values_out_.Push(value_out);
+            return Count(values_out_);
+        });
+    }
+
+    /// @returns the 1-based string id of the name of @p value, or 0 if the value is unnamed
+    uint32_t Name(const ir::Value* value) {
+        if (auto name = mod_in_.NameOf(value); name.IsValid()) {
+            return String(name.Name());
+        }
+        return 0;
+    }
+
+    uint32_t FunctionParameterAttributes(const ir::FunctionParam* param_in) {
+        flat::Attributes attrs{};
+        if (auto bp_in = param_in->BindingPoint()) {
+            attrs.flags |= kHasBindingPoint;
+            attrs.group = bp_in->group;
+            attrs.binding = bp_in->binding;
+        }
+        if (auto location_in = param_in->Location()) {
+            attrs.flags |= kHasLocation;
+            attrs.location = *location_in;
+        }
+        if (auto color_in = param_in->Color()) {
+            attrs.flags |= kHasColor;
+            attrs.color = *color_in;
+        }
+        if (auto interpolation_in = param_in->Interpolation()) {
+            Interpolation(attrs, *interpolation_in);
+        }
+        if (auto builtin_in = param_in->Builtin()) {
+            attrs.flags |= kHasBuiltin;
+            attrs.builtin = Enum(*builtin_in);
+        }
+        if (param_in->Invariant()) {
+            attrs.flags |= kInvariant;
+        }
+        return Attributes(attrs);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // ConstantValues
+    ////////////////////////////////////////////////////////////////////////////
+    uint32_t ConstantValue(const core::constant::Value* constant_in) {
+        TINT_ASSERT(constant_in != nullptr);
+        return constant_values_.GetOrAdd(constant_in, [&] {
+            flat::Constant constant_out{};
+            tint::Switch(
+                constant_in,  //
+                [&](const core::constant::Scalar<bool>* b) {
+                    constant_out.kind = ConstantKind::kBool;
+                    constant_out.a = b->value ? 1 : 0;
+                },
+                [&](const core::constant::Scalar<core::i32>* i32) {
+                    constant_out.kind = ConstantKind::kI32;
+                    constant_out.a = Bits(i32->value.value);
+                },
+                [&](const core::constant::Scalar<core::u32>* u32) {
+                    constant_out.kind = ConstantKind::kU32;
+                    constant_out.a = u32->value;
+                },
+                [&](const core::constant::Scalar<core::f32>* f32) {
+                    constant_out.kind = ConstantKind::kF32;
+                    constant_out.a = Bits(f32->value.value);
+                },
+                [&](const core::constant::Scalar<core::f16>* f16) {
+                    constant_out.kind = ConstantKind::kF16;
+                    constant_out.a = Bits(static_cast<float>(f16->value.value));
+                },
+                [&](const core::constant::Composite* composite) {
+                    constant_out.kind = ConstantKind::kComposite;
+                    constant_out.a = Type(composite->type);
+                    Vector<uint32_t, 8> elements;
+                    for (auto* el : composite->elements) {
+                        elements.Push(ConstantValue(el));
+                    }
+                    constant_out.b = Append(ids_out_, elements);
+                    constant_out.c = Count(elements);
+                },
+                [&](const core::constant::Splat* splat) {
+                    constant_out.kind = ConstantKind::kSplat;
+                    constant_out.a = Type(splat->type);
+                    if (DAWN_UNLIKELY(splat->count >
+                                      internal_limits::kMaxArrayConstructorElements)) {
+                        Error() << "array constructor has excessive number of elements (>"
+                                << internal_limits::kMaxArrayConstructorElements << ")";
+                    }
+                    constant_out.b = ConstantValue(splat->el);
+                    constant_out.c = static_cast<uint32_t>(splat->count);
+                },
+                TINT_ICE_ON_NO_MATCH);
+
+            constants_out_.Push(constant_out);
+            return Count(constants_out_) - 1;
+        });
+    }
+
+    /// @returns the bits of the 32-bit scalar @p value
+    template <typename T>
+    uint32_t Bits(T value) {
+        static_assert(sizeof(T) == sizeof(uint32_t));
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Attributes
+    ////////////////////////////////////////////////////////////////////////////
+    /// @returns the 1-based id of the attributes @p attrs, or 0 if @p attrs holds no attributes
+    uint32_t Attributes(const flat::Attributes& attrs) {
+        if (attrs.flags == 0) {
+            return 0;
+        }
+        attributes_out_.Push(attrs);
+        return Count(attributes_out_);
+    }
+
+    void Interpolation(flat::Attributes& attrs, const core::Interpolation& interpolation_in) {
+        attrs.flags |= kHasInterpolation;
+        attrs.interpolation_type = Enum(interpolation_in.type);
+        attrs.interpolation_sampling = Enum(interpolation_in.sampling);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Serialization
+    ////////////////////////////////////////////////////////////////////////////
+    Result<Vector<std::byte, 0>> Serialize(uint32_t root_block) {
+        struct SectionData {
+            const void* data;
+            size_t count;
+        };
+        SectionData sections[kNumSections] = {};
+        auto set = [&](Section section, const void* data, size_t count) {
+            sections[static_cast<uint32_t>(section)] = {data, count};
+        };
+        set(Section::kStrings, strings_out_.Slice().data, strings_out_.Length());
+        set(Section::kStringData, string_data_out_.data(), string_data_out_.size());
+        set(Section::kTypes, types_out_.Slice().data, types_out_.Length());
+        set(Section::kStructMembers, struct_members_out_.Slice().data,
+            struct_members_out_.Length());
+        set(Section::kAttributes, attributes_out_.Slice().data, attributes_out_.Length());
+        set(Section::kConstants, constants_out_.Slice().data, constants_out_.Length());
+        set(Section::kValues, values_out_.Slice().data, values_out_.Length());
+        set(Section::kFunctions, functions_out_.Slice().data, functions_out_.Length());
+        set(Section::kBlocks, blocks_out_.Slice().data, blocks_out_.Length());
+        set(Section::kInstructions, instructions_out_.Slice().data, instructions_out_.Length());
+        set(Section::kSwitchCases, switch_cases_out_.Slice().data, switch_cases_out_.Length());
+        set(Section::kIds, ids_out_.Slice().data, ids_out_.Length());
+
+        Header header{};
+        header.magic = kMagic;
+        header.version = kVersion;
+        header.root_block = root_block;
+
+        // Lay out the sections one after another, each aligned to 4 bytes.
+        uint64_t size = sizeof(Header);
+        for (uint32_t i = 0; i < kNumSections; i++) {
+            size = RoundUp<uint64_t>(4, size);
+            header.sections[i].offset = static_cast<uint32_t>(size);
+            header.sections[i].count = static_cast<uint32_t>(sections[i].count);
+            size += static_cast<uint64_t>(sections[i].count) * RecordSize(Section(i));
+        }
+        if (DAWN_UNLIKELY(size > std::numeric_limits<uint32_t>::max())) {
+            return Failure{"module is too large for the flat binary encoding"};
+        }
+
+        Vector<std::byte, 0> buffer;
+        buffer.Resize(static_cast<size_t>(size));
+        std::memcpy(&buffer[0], &header, sizeof(header));
+        for (uint32_t i = 0; i < kNumSections; i++) {
+            if (sections[i].count > 0) {
+                std::memcpy(&buffer[header.sections[i].offset], sections[i].data,
+                            sections[i].count * RecordSize(Section(i)));
+            }
+        }
+        return buffer;
+    }
+};
+
+}  // namespace
+
+Result<Vector<std::byte, 0>> Encode(const Module& mod_in) {
+    return Encoder{mod_in}.Encode();
+}
+
+}  // namespace tint::core::ir::binary::flat
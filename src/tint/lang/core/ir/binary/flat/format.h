@@ -0,0 +1,410 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_TINT_LANG_CORE_IR_BINARY_FLAT_FORMAT_H_
+#define SRC_TINT_LANG_CORE_IR_BINARY_FLAT_FORMAT_H_
+
+#include <cstdint>
+#include <type_traits>
+
+/// The flat IR binary format.
+///
+/// A flat-encoded module is a single contiguous buffer holding a Header followed by a number of
+/// sections. Each section is a densely packed array of fixed-size records, so the decoder can
+/// address any record directly from the encoded bytes without first parsing the buffer into an
+/// intermediate representation. This allows the buffer to be memory-mapped from disk and decoded
+/// in place.
+///
+/// Records refer to other records by index. Ranges of variable length lists (instruction
+/// operands, struct members, etc) are stored as a (first, count) pair into the relevant section.
+/// Unless noted otherwise, ids follow the same conventions as the protobuf encoding:
+/// * Type, constant, function and block ids are 0-based indices into their section.
+/// * Value ids are 1-based indices into the values section. 0 is used for a null value.
+/// * String, attribute and optional block ids are 1-based. 0 is used when absent.
+///
+/// All words are stored in the byte order of the encoding machine. A mismatch is detected by
+/// the decoder with the byte-swapped Header::magic.
+///
+/// Core enums (address spaces, builtin functions, etc) are stored using their numeric value.
+/// kVersion must be bumped whenever a record layout or the numbering of one of these enums changes.
+namespace tint::core::ir::binary::flat {
+
+/// The magic number at the start of every flat-encoded module. Reads as 'TIRF' in little-endian.
+static constexpr uint32_t kMagic = 0x46524954;
+
+/// The flat encoding version.
+static constexpr uint32_t kVersion = 1;
+
+/// Section identifies a section of the encoded module.
+enum class Section : uint32_t {
+    /// String records.
+    kStrings,
+    /// The raw bytes referenced by the String records.
+    kStringData,
+    /// Type records.
+    kTypes,
+    /// StructMember records.
+    kStructMembers,
+    /// Attributes records.
+    kAttributes,
+    /// Constant records.
+    kConstants,
+    /// Value records.
+    kValues,
+    /// Function records.
+    kFunctions,
+    /// Block records.
+    kBlocks,
+    /// Instruction records.
+    kInstructions,
+    /// SwitchCase records.
+    kSwitchCases,
+    /// uint32_t ids, referenced by the (first, count) ranges of the other records.
+    kIds,
+    /// The number of sections.
+    kCount,
+};
+
+/// The number of sections in an encoded module.
+static constexpr uint32_t kNumSections = static_cast<uint32_t>(Section::kCount);
+
+/// SectionInfo describes the location of a section in the encoded module.
+struct SectionInfo {
+    /// The byte offset of the section from the start of the encoded module.
+    /// Always a multiple of 4.
+    uint32_t offset;
+    /// The number of records in the section.
+    uint32_t count;
+};
+
+/// Header is the first record of the encoded module.
+struct Header {
+    /// Must be kMagic.
+    uint32_t magic;
+    /// Must be kVersion.
+    uint32_t version;
+    /// The id of the module's root block.
+    uint32_t root_block;
+    /// The location of each section.
+    SectionInfo sections[kNumSections];
+};
+
+/// String is a range of bytes in the Section::kStringData section.
+struct String {
+    /// The byte offset of the string in Section::kStringData.
+    uint32_t offset;
+    /// The length of the string in bytes.
+    uint32_t length;
+};
+
+/// TypeKind is the kind of a Type record.
+enum class TypeKind : uint32_t {
+    kVoid,
+    kBool,
+    kI32,
+    kU32,
+    kF32,
+    kF16,
+    /// a: width, b: element type.
+    kVector,
+    /// a: columns, b: rows, c: element type.
+    kMatrix,
+    /// a: address space, b: store type, c: access.
+    kPointer,
+    /// a: name string, b: first struct member, c: struct member count.
+    kStruct,
+    /// a: type.
+    kAtomic,
+    /// a: element type, b: count (0 for runtime-sized), c: stride.
+    kArray,
+    /// a: dimension.
+    kDepthTexture,
+    /// a: dimension, b: sub type.
+    kSampledTexture,
+    /// a: dimension, b: sub type.
+    kMultisampledTexture,
+    /// a: dimension.
+    kDepthMultisampledTexture,
+    /// a: dimension, b: texel format, c: access.
+    kStorageTexture,
+    kExternalTexture,
+    /// a: sampler kind.
+    kSampler,
+    /// a: sub type.
+    kInputAttachment,
+};
+
+/// Type is a record in the Section::kTypes section.
+/// A type only ever refers to types with a lower id.
+struct Type {
+    /// The kind of the type.
+    TypeKind kind;
+    /// Kind-specific operands. See TypeKind.
+    uint32_t a, b, c;
+};
+
+/// StructMember is a record in the Section::kStructMembers section.
+struct StructMember {
+    /// The member name string.
+    uint32_t name;
+    /// The member type.
+    uint32_t type;
+    /// The member size in bytes.
+    uint32_t size;
+    /// The member alignment in bytes.
+    uint32_t align;
+    /// The member attributes, or 0 if the member has no attributes.
+    uint32_t attributes;
+};
+
+/// AttributeFlags is a bitmask of the attributes held by an Attributes record.
+enum AttributeFlags : uint32_t {
+    kHasBindingPoint = 1u << 0,
+    kHasLocation = 1u << 1,
+    kHasBlendSrc = 1u << 2,
+    kHasColor = 1u << 3,
+    kHasBuiltin = 1u << 4,
+    kHasInterpolation = 1u << 5,
+    kInvariant = 1u << 6,
+    kHasInputAttachmentIndex = 1u << 7,
+};
+
+/// Attributes is a record in the Section::kAttributes section.
+/// It holds the IO attributes of struct members, function parameters and function return values.
+struct Attributes {
+    /// A bitmask of AttributeFlags.
+    uint32_t flags;
+    /// The binding point group.
+    uint32_t group;
+    /// The binding point binding.
+    uint32_t binding;
+    /// The location.
+    uint32_t location;
+    /// The blend source.
+    uint32_t blend_src;
+    /// The color.
+    uint32_t color;
+    /// The input attachment index.
+    uint32_t input_attachment_index;
+    /// The builtin value.
+    uint32_t builtin;
+    /// The interpolation type.
+    uint32_t interpolation_type;
+    /// The interpolation sampling.
+    uint32_t interpolation_sampling;
+};
+
+/// ConstantKind is the kind of a Constant record.
+enum class ConstantKind : uint32_t {
+    /// a: value.
+    kBool,
+    /// a: value.
+    kI32,
+    /// a: value.
+    kU32,
+    /// a: the bits of the f32 value.
+    kF32,
+    /// a: the bits of the f16 value, widened to f32.
+    kF16,
+    /// a: type, b: first element id, c: element count.
+    kComposite,
+    /// a: type, b: element constant, c: count.
+    kSplat,
+};
+
+/// Constant is a record in the Section::kConstants section.
+/// A constant only ever refers to constants with a lower id.
+struct Constant {
+    /// The kind of the constant.
+    ConstantKind kind;
+    /// Kind-specific operands. See ConstantKind.
+    uint32_t a, b, c;
+};
+
+/// ValueKind is the kind of a Value record.
+enum class ValueKind : uint32_t {
+    /// a: type, b: name string.
+    kInstructionResult,
+    /// a: type, b: name string, c: attributes.
+    kFunctionParameter,
+    /// a: type, b: name string.
+    kBlockParameter,
+    /// a: function.
+    kFunction,
+    /// a: constant.
+    kConstant,
+};
+
+/// Value is a record in the Section::kValues section.
+struct Value {
+    /// The kind of the value.
+    ValueKind kind;
+    /// Kind-specific operands. See ValueKind.
+    uint32_t a, b, c;
+};
+
+/// Function is a record in the Section::kFunctions section.
+struct Function {
+    /// The function name string.
+    uint32_t name;
+    /// The function return type.
+    uint32_t return_type;
+    /// The function pipeline stage.
+    uint32_t stage;
+    /// 1 if the function has a workgroup size, otherwise 0.
+    uint32_t has_workgroup_size;
+    /// The workgroup size value ids.
+    uint32_t workgroup_size[3];
+    /// The first parameter value id.
+    uint32_t params_first;
+    /// The number of parameters.
+    uint32_t params_count;
+    /// The return value attributes, or 0 if the return value has no attributes.
+    uint32_t return_attributes;
+    /// The function body block.
+    uint32_t block;
+};
+
+/// Block is a record in the Section::kBlocks section.
+struct Block {
+    /// 1 if the block is a MultiInBlock, otherwise 0.
+    uint32_t is_multi_in;
+    /// The first block parameter value id.
+    uint32_t params_first;
+    /// The number of block parameters.
+    uint32_t params_count;
+    /// The index of the first instruction of the block.
+    uint32_t instructions_first;
+    /// The number of instructions in the block.
+    uint32_t instructions_count;
+};
+
+/// InstructionKind is the kind of an Instruction record.
+enum class InstructionKind : uint32_t {
+    kAccess,
+    /// a: binary op.
+    kBinary,
+    kBitcast,
+    /// a: number of next iteration values.
+    kBreakIf,
+    /// a: builtin function.
+    kBuiltinCall,
+    kConstruct,
+    kContinue,
+    kConvert,
+    kDiscard,
+    kExitIf,
+    kExitLoop,
+    kExitSwitch,
+    /// a: true block, b: false block. Both optional.
+    kIf,
+    kLet,
+    kLoad,
+    kLoadVectorElement,
+    /// a: initializer block (optional), b: body block, c: continuing block (optional).
+    kLoop,
+    kNextIteration,
+    kReturn,
+    kStore,
+    kStoreVectorElement,
+    /// a: first case, b: case count.
+    kSwitch,
+    /// a: first index id, b: index count.
+    kSwizzle,
+    /// a: unary op.
+    kUnary,
+    kUnreachable,
+    kUserCall,
+    /// a: attributes.
+    kVar,
+};
+
+/// Instruction is a record in the Section::kInstructions section.
+struct Instruction {
+    /// The kind of the instruction.
+    InstructionKind kind;
+    /// The first operand value id.
+    uint32_t operands_first;
+    /// The number of operands.
+    uint32_t operands_count;
+    /// The first result value id.
+    uint32_t results_first;
+    /// The number of results.
+    uint32_t results_count;
+    /// Kind-specific operands. See InstructionKind.
+    uint32_t a, b, c;
+};
+
+/// SwitchCase is a record in the Section::kSwitchCases section.
+struct SwitchCase {
+    /// The case block.
+    uint32_t block;
+    /// 1 if the case contains the default selector, otherwise 0.
+    uint32_t is_default;
+    /// The first selector constant id.
+    uint32_t selectors_first;
+    /// The number of selectors.
+    uint32_t selectors_count;
+};
+
+/// @returns the size in bytes of a single record of section @p section
+constexpr uint32_t RecordSize(Section section) {
+    switch (section) {
+        case Section::kStrings:
+            return sizeof(String);
+        case Section::kStringData:
+            return 1;
+        case Section::kTypes:
+            return sizeof(Type);
+        case Section::kStructMembers:
+            return sizeof(StructMember);
+        case Section::kAttributes:
+            return sizeof(Attributes);
+        case Section::kConstants:
+            return sizeof(Constant);
+        case Section::kValues:
+            return sizeof(Value);
+        case Section::kFunctions:
+            return sizeof(Function);
+        case Section::kBlocks:
+            return sizeof(Block);
+        case Section::kInstructions:
+            return sizeof(Instruction);
+        case Section::kSwitchCases:
+            return sizeof(SwitchCase);
+        case Section::kIds:
+            return sizeof(uint32_t);
+        case Section::kCount:
+            break;
+    }
+    return 0;
+}
+
+}  // namespace tint::core::ir::binary::flat
+
+#endif  // SRC_TINT_LANG_CORE_IR_BINARY_FLAT_FORMAT_H_
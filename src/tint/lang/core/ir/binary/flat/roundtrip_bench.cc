@@ -0,0 +1,134 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <string>
+#include <utility>
+
+#include "src/tint/cmd/bench/bench.h"
+#include "src/tint/lang/core/ir/binary/flat/decode.h"
+#include "src/tint/lang/core/ir/binary/flat/encode.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/wgsl/reader/reader.h"
+
+#if TINT_BUILD_IR_BINARY
+#include "src/tint/lang/core/ir/binary/decode.h"
+#include "src/tint/lang/core/ir/binary/encode.h"
+#endif  // TINT_BUILD_IR_BINARY
+
+// These benchmarks compare the flat binary encoding against the protobuf encoding. Each records
+// the size of the encoded module in the 'encoded_bytes' counter.
+
+namespace tint::core::ir::binary {
+namespace {
+
+/// @returns the lowered IR module for the benchmark input @p input_name
+Result<Module> LoadModule(const std::string& input_name) {
+    auto res = bench::GetWgslProgram(input_name);
+    if (res != Success) {
+        return res.Failure();
+    }
+    return wgsl::reader::ProgramToLoweredIR(res->program);
+}
+
+/// Runs a benchmark that encodes the module @p input_name with @p encode
+template <typename ENCODE>
+void RunEncode(benchmark::State& state, const std::string& input_name, ENCODE&& encode) {
+    auto mod = LoadModule(input_name);
+    if (mod != Success) {
+        state.SkipWithError(mod.Failure().reason.Str());
+        return;
+    }
+    size_t encoded_bytes = 0;
+    for (auto _ : state) {
+        auto encoded = encode(mod.Get());
+        if (encoded != Success) {
+            state.SkipWithError(encoded.Failure().reason.Str());
+            return;
+        }
+        encoded_bytes = encoded->Length();
+    }
+    state.counters["encoded_bytes"] = static_cast<double>(encoded_bytes);
+}
+
+/// Runs a benchmark that decodes the module @p input_name with @p decode, after encoding it with
+/// @p encode
+template <typename ENCODE, typename DECODE>
+void RunDecode(benchmark::State& state,
+               const std::string& input_name,
+               ENCODE&& encode,
+               DECODE&& decode) {
+    auto mod = LoadModule(input_name);
+    if (mod != Success) {
+        state.SkipWithError(mod.Failure().reason.Str());
+        return;
+    }
+    auto encoded = encode(mod.Get());
+    if (encoded != Success) {
+        state.SkipWithError(encoded.Failure().reason.Str());
+        return;
+    }
+    for (auto _ : state) {
+        auto decoded = decode(encoded->Slice());
+        if (decoded != Success) {
+            state.SkipWithError(decoded.Failure().reason.Str());
+            return;
+        }
+    }
+    state.counters["encoded_bytes"] = static_cast<double>(encoded->Length());
+}
+
+void EncodeFlat(benchmark::State& state, std::string input_name) {
+    RunEncode(state, input_name, [](const Module& mod) { return flat::Encode(mod); });
+}
+
+void DecodeFlat(benchmark::State& state, std::string input_name) {
+    RunDecode(
+        state, input_name, [](const Module& mod) { return flat::Encode(mod); },
+        [](Slice<const std::byte> encoded) { return flat::Decode(encoded); });
+}
+
+TINT_BENCHMARK_PROGRAMS(EncodeFlat);
+TINT_BENCHMARK_PROGRAMS(DecodeFlat);
+
+#if TINT_BUILD_IR_BINARY
+void EncodeProtobuf(benchmark::State& state, std::string input_name) {
+    RunEncode(state, input_name, [](const Module& mod) { return EncodeToBinary(mod); });
+}
+
+void DecodeProtobuf(benchmark::State& state, std::string input_name) {
+    RunDecode(
+        state, input_name, [](const Module& mod) { return EncodeToBinary(mod); },
+        [](Slice<const std::byte> encoded) { return Decode(encoded); });
+}
+
+TINT_BENCHMARK_PROGRAMS(EncodeProtobuf);
+TINT_BENCHMARK_PROGRAMS(DecodeProtobuf);
+#endif  // TINT_BUILD_IR_BINARY
+
+}  // namespace
+}  // namespace tint::core::ir::binary
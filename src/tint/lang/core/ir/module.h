@@ -176,6 +176,14 @@ class Module {
     /// @returns the functions in the module, in dependency order
     Vector<const Function*, 16> DependencyOrderedFunctions() const;
 
+    /// @returns the memory usage counters of the instruction allocator
+    const AllocatorStats& InstructionAllocatorStats() const {
+        return allocators_.instructions.Stats();
+    }
+
+    /// @returns the memory usage counters of the value allocator
+    const AllocatorStats& ValueAllocatorStats() const { return allocators_.values.Stats(); }
+
     /// The block allocator
     BlockAllocator<Block> blocks;
 
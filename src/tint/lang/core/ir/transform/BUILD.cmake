@@ -63,6 +63,8 @@ tint_add_target(tint_lang_core_ir_transform lib
   lang/core/ir/transform/direct_variable_access.h
   lang/core/ir/transform/multiplanar_external_texture.cc
   lang/core/ir/transform/multiplanar_external_texture.h
+  lang/core/ir/transform/optimize.cc
+  lang/core/ir/transform/optimize.h
   lang/core/ir/transform/prepare_push_constants.cc
   lang/core/ir/transform/prepare_push_constants.h
   lang/core/ir/transform/preserve_padding.cc
@@ -108,6 +110,7 @@ tint_target_add_dependencies(tint_lang_core_ir_transform lib
   tint_utils_result
   tint_utils_rtti
   tint_utils_symbol
+  tint_utils_system
   tint_utils_text
   tint_utils_traits
 )
@@ -134,6 +137,7 @@ tint_add_target(tint_lang_core_ir_transform_test test
   lang/core/ir/transform/direct_variable_access_test.cc
   lang/core/ir/transform/helper_test.h
   lang/core/ir/transform/multiplanar_external_texture_test.cc
+  lang/core/ir/transform/optimize_test.cc
   lang/core/ir/transform/prepare_push_constants_test.cc
   lang/core/ir/transform/preserve_padding_test.cc
   lang/core/ir/transform/remove_continue_in_switch_test.cc
@@ -220,6 +224,7 @@ tint_add_target(tint_lang_core_ir_transform_fuzz fuzz
   lang/core/ir/transform/demote_to_helper_fuzz.cc
   lang/core/ir/transform/direct_variable_access_fuzz.cc
   lang/core/ir/transform/multiplanar_external_texture_fuzz.cc
+  lang/core/ir/transform/optimize_fuzz.cc
   lang/core/ir/transform/preserve_padding_fuzz.cc
   lang/core/ir/transform/remove_terminator_args_fuzz.cc
   lang/core/ir/transform/rename_conflicts_fuzz.cc
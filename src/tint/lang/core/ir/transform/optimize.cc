@@ -0,0 +1,410 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/tint/lang/core/ir/transform/optimize.h"
+
+#include <utility>
+
+#include "src/tint/lang/core/ir/builder.h"
+#include "src/tint/lang/core/ir/evaluator.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/validator.h"
+#include "src/tint/utils/containers/hashmap.h"
+#include "src/tint/utils/containers/scope_stack.h"
+
+namespace tint::core::ir::transform {
+
+namespace {
+
+/// ExpressionKey identifies the value computed by a pure instruction, so that equivalent
+/// instructions produce equal keys.
+struct ExpressionKey {
+    /// The type of the instruction
+    const tint::TypeInfo* kind = nullptr;
+    /// The binary or unary operator, or 0 for other instructions
+    uint32_t op = 0;
+    /// The result type of the instruction
+    const core::type::Type* type = nullptr;
+    /// The instruction operands
+    Vector<ir::Value*, 4> operands;
+    /// The swizzle indices, for swizzle instructions
+    Vector<uint32_t, 4> indices;
+
+    /// @returns the hash code of the key
+    tint::HashCode HashCode() const { return Hash(kind, op, type, operands, indices); }
+
+    /// Equality operator
+    /// @param other the key to compare against
+    /// @returns true if this key is equal to @p other
+    bool operator==(const ExpressionKey& other) const {
+        return kind == other.kind && op == other.op && type == other.type &&
+               operands == other.operands && indices == other.indices;
+    }
+};
+
+/// PIMPL state for the transform.
+struct State {
+    /// The IR module.
+    Module& ir;
+
+    /// The configuration
+    const OptimizeConfig& cfg;
+
+    /// The IR builder.
+    Builder b{ir};
+
+    /// The pure instructions that are available at the current point of the CSE traversal.
+    ScopeStack<ExpressionKey, ir::InstructionResult*> available{};
+
+    /// Process the module.
+    void Process() {
+        if (cfg.forward_stores) {
+            for (auto func : ir.functions) {
+                ForwardStores(func->Block());
+            }
+        }
+        if (cfg.fold_constants) {
+            for (auto func : ir.functions) {
+                FoldConstants(func->Block());
+            }
+        }
+        if (cfg.eliminate_common_subexpressions) {
+            for (auto func : ir.functions) {
+                available.Clear();
+                EliminateCommonSubexpressions(func->Block());
+            }
+        }
+        if (cfg.eliminate_dead_code) {
+            EliminateDeadCode();
+        }
+    }
+
+  private:
+    /// @returns true if @p var is a function-scope variable whose pointer is only used directly by
+    /// load and store instructions, so that the variable cannot be accessed via any other pointer.
+    bool IsForwardable(ir::Var* var) {
+        if (var->Block() == ir.root_block) {
+            return false;
+        }
+        auto* ptr = var->Result(0)->Type()->As<core::type::Pointer>();
+        if (!ptr || ptr->AddressSpace() != core::AddressSpace::kFunction) {
+            return false;
+        }
+        for (auto& use : var->Result(0)->UsagesUnsorted()) {
+            if (use->instruction->Is<ir::Load>() &&
+                use->operand_index == ir::Load::kFromOperandOffset) {
+                continue;
+            }
+            if (use->instruction->Is<ir::Store>() &&
+                use->operand_index == ir::Store::kToOperandOffset) {
+                continue;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    /// Forwards values stored to variables to loads of the same variables in @p block, then
+    /// recurses into the child blocks.
+    /// @param block the block to process
+    void ForwardStores(ir::Block* block) {
+        // The current value held by each variable in the block.
+        Hashmap<ir::Value*, ir::Value*, 8> values;
+        // The result of IsForwardable() for each variable.
+        Hashmap<ir::Var*, bool, 8> replaceable;
+        auto is_replaceable = [&](ir::Value* ptr) {
+            auto* result = ptr->As<ir::InstructionResult>();
+            auto* var = result ? result->Instruction()->As<ir::Var>() : nullptr;
+            if (!var) {
+                return false;
+            }
+            return replaceable.GetOrAdd(var, [&] { return IsForwardable(var); });
+        };
+
+        for (auto* inst = block->Front(); inst;) {
+            auto* next = inst->next.Get();
+            tint::Switch(
+                inst,  //
+                [&](ir::Var* var) {
+                    if (var->Initializer() && is_replaceable(var->Result(0))) {
+                        values.Replace(var->Result(0), var->Initializer());
+                    }
+                },
+                [&](ir::Store* store) {
+                    if (is_replaceable(store->To())) {
+                        values.Replace(store->To(), store->From());
+                    }
+                },
+                [&](ir::Load* load) {
+                    if (!is_replaceable(load->From())) {
+                        return;
+                    }
+                    if (auto value = values.Get(load->From())) {
+                        load->Result(0)->ReplaceAllUsesWith(*value);
+                        load->Destroy();
+                    } else {
+                        values.Add(load->From(), load->Result(0));
+                    }
+                },
+                [&](ir::ControlInstruction* ctrl) {
+                    // The child blocks may store to any of the variables.
+                    values.Clear();
+                    ctrl->ForeachBlock([&](ir::Block* child) { ForwardStores(child); });
+                });
+            inst = next;
+        }
+    }
+
+    /// @returns true if @p inst is a pure instruction that the Evaluator can evaluate, and that can
+    /// be compared for equivalence with other instructions
+    bool IsPureExpression(ir::Instruction* inst) {
+        return inst->IsAnyOf<ir::CoreBinary, ir::CoreUnary, ir::Access, ir::Construct, ir::Convert,
+                             ir::Swizzle, ir::Bitcast>();
+    }
+
+    /// Replaces instructions in @p block and its child blocks that have only constant operands
+    /// with the result of evaluating the instruction.
+    /// @param block the block to process
+    void FoldConstants(ir::Block* block) {
+        for (auto* inst = block->Front(); inst;) {
+            auto* next = inst->next.Get();
+            if (auto* ctrl = inst->As<ir::ControlInstruction>()) {
+                ctrl->ForeachBlock([&](ir::Block* child) { FoldConstants(child); });
+            } else if (CanFold(inst)) {
+                // Evaluation may legitimately fail, for example on integer overflow, in which
+                // case the instruction is left for evaluation at runtime.
+                auto res = eval::Eval(b, inst);
+                if (res == Success && res.Get()) {
+                    inst->Result(0)->ReplaceAllUsesWith(res.Get());
+                    inst->Destroy();
+                }
+            }
+            inst = next;
+        }
+    }
+
+    /// @returns true if @p inst is an instruction that can be replaced with a constant
+    bool CanFold(ir::Instruction* inst) {
+        if (!IsPureExpression(inst) && !inst->Is<ir::CoreBuiltinCall>()) {
+            return false;
+        }
+        if (inst->Results().Length() != 1 || inst->Result(0)->Type()->Is<core::type::Void>()) {
+            return false;
+        }
+        if (inst->Operands().IsEmpty()) {
+            // Zero-value constructors and builtins that take no arguments are not folded.
+            return false;
+        }
+        for (auto* operand : inst->Operands()) {
+            if (!operand || !operand->Is<ir::Constant>()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Replaces pure instructions in @p block and its child blocks with equivalent instructions
+    /// that dominate them.
+    /// @param block the block to process
+    void EliminateCommonSubexpressions(ir::Block* block) {
+        for (auto* inst = block->Front(); inst;) {
+            auto* next = inst->next.Get();
+            if (auto* ctrl = inst->As<ir::ControlInstruction>()) {
+                // Values declared in a child block do not dominate the sibling blocks or the
+                // instructions that follow the control instruction.
+                ctrl->ForeachBlock([&](ir::Block* child) {
+                    available.Push();
+                    EliminateCommonSubexpressions(child);
+                    available.Pop();
+                });
+            } else if (IsPureExpression(inst) && inst->Results().Length() == 1) {
+                auto key = KeyOf(inst);
+                if (auto* existing = available.Get(key)) {
+                    inst->Result(0)->ReplaceAllUsesWith(existing);
+                    inst->Destroy();
+                } else {
+                    available.Set(key, inst->Result(0));
+                }
+            }
+            inst = next;
+        }
+    }
+
+    /// @returns the ExpressionKey for the pure instruction @p inst
+    ExpressionKey KeyOf(ir::Instruction* inst) {
+        ExpressionKey key;
+        key.kind = &inst->TypeInfo();
+        key.type = inst->Result(0)->Type();
+        for (auto* operand : inst->Operands()) {
+            key.operands.Push(operand);
+        }
+        tint::Switch(
+            inst,  //
+            [&](ir::CoreBinary* binary) { key.op = static_cast<uint32_t>(binary->Op()); },
+            [&](ir::CoreUnary* unary) { key.op = static_cast<uint32_t>(unary->Op()); },
+            [&](ir::Swizzle* swizzle) {
+                for (auto idx : swizzle->Indices()) {
+                    key.indices.Push(idx);
+                }
+            });
+        return key;
+    }
+
+    /// Removes dead instructions, variables and functions from the module.
+    void EliminateDeadCode() {
+        // Remove unused functions, if the module has an entry point. Removing a function may
+        // leave its callees unused, so repeat until no more functions are removed.
+        bool has_entry_point = false;
+        for (auto func : ir.functions) {
+            has_entry_point |= func->Stage() != ir::Function::PipelineStage::kUndefined;
+        }
+        for (bool changed = has_entry_point; changed;) {
+            changed = false;
+            for (size_t i = 0; i < ir.functions.Length();) {
+                auto func = ir.functions[i];
+                if (func->Stage() == ir::Function::PipelineStage::kUndefined && !IsCalled(func)) {
+                    func->Destroy();
+                    ir.functions.Erase(i);
+                    changed = true;
+                } else {
+                    i++;
+                }
+            }
+        }
+
+        for (auto func : ir.functions) {
+            EliminateDeadVars(func->Block());
+            EliminateDeadInstructions(func->Block());
+        }
+
+        // Remove unused private and workgroup variables.
+        for (auto* inst = ir.root_block->Front(); inst;) {
+            auto* next = inst->next.Get();
+            if (auto* var = inst->As<ir::Var>(); var && !var->Result(0)->IsUsed()) {
+                auto* ptr = var->Result(0)->Type()->As<core::type::Pointer>();
+                if (ptr->AddressSpace() == core::AddressSpace::kPrivate ||
+                    ptr->AddressSpace() == core::AddressSpace::kWorkgroup) {
+                    var->Destroy();
+                }
+            }
+            inst = next;
+        }
+    }
+
+    /// @returns true if @p func is called by a user call instruction
+    bool IsCalled(ir::Function* func) {
+        // Functions are also used by their own return instructions.
+        for (auto& use : func->UsagesUnsorted()) {
+            if (use->instruction->Is<ir::UserCall>()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Removes unused instructions without side-effects from @p block and its child blocks.
+    /// Instructions are visited in reverse order so that removing an instruction also allows the
+    /// instructions that produce its operands to be removed.
+    /// @param block the block to process
+    void EliminateDeadInstructions(ir::Block* block) {
+        for (auto* inst = block->Back(); inst;) {
+            auto* prev = inst->prev.Get();
+            if (auto* ctrl = inst->As<ir::ControlInstruction>()) {
+                ctrl->ForeachBlock([&](ir::Block* child) { EliminateDeadInstructions(child); });
+            } else if (IsDead(inst)) {
+                inst->Destroy();
+            }
+            inst = prev;
+        }
+    }
+
+    /// Removes the function-scope variables in @p block and its child blocks that are never
+    /// loaded, along with the instructions that store to them. This runs before
+    /// EliminateDeadInstructions() so that the stored values can also be removed.
+    /// @param block the block to process
+    void EliminateDeadVars(ir::Block* block) {
+        for (auto* inst = block->Front(); inst;) {
+            auto* next = inst->next.Get();
+            if (auto* ctrl = inst->As<ir::ControlInstruction>()) {
+                ctrl->ForeachBlock([&](ir::Block* child) { EliminateDeadVars(child); });
+            } else if (auto* var = inst->As<ir::Var>(); var && IsStoreOnly(var)) {
+                var->Result(0)->ForEachUseUnsorted([&](Usage use) { use.instruction->Destroy(); });
+                // The instruction following the variable may have been one of its stores.
+                next = var->next.Get();
+                var->Destroy();
+            }
+            inst = next;
+        }
+    }
+
+    /// @returns true if @p var is a forwardable variable that is only ever stored to
+    bool IsStoreOnly(ir::Var* var) {
+        if (!IsForwardable(var)) {
+            return false;
+        }
+        for (auto& use : var->Result(0)->UsagesUnsorted()) {
+            if (!use->instruction->Is<ir::Store>()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @returns true if @p inst has no used results and no side-effects
+    bool IsDead(ir::Instruction* inst) {
+        if (inst->Results().IsEmpty()) {
+            return false;
+        }
+        for (auto* result : inst->Results()) {
+            if (result->IsUsed() || result->Type()->Is<core::type::Void>()) {
+                return false;
+            }
+        }
+        if (IsPureExpression(inst) || inst->IsAnyOf<ir::Let, ir::Load, ir::LoadVectorElement>()) {
+            return true;
+        }
+        if (auto* call = inst->As<ir::CoreBuiltinCall>()) {
+            return !core::HasSideEffects(call->Func());
+        }
+        return false;
+    }
+};
+
+}  // namespace
+
+Result<SuccessType> Optimize(Module& ir, const OptimizeConfig& cfg) {
+    auto result = ValidateAndDumpIfNeeded(ir, "core.Optimize", kOptimizeCapabilities);
+    if (result != Success) {
+        return result;
+    }
+
+    State{ir, cfg}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::core::ir::transform
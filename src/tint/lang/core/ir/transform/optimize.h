@@ -0,0 +1,94 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_TINT_LANG_CORE_IR_TRANSFORM_OPTIMIZE_H_
+#define SRC_TINT_LANG_CORE_IR_TRANSFORM_OPTIMIZE_H_
+
+#include "src/tint/lang/core/ir/validator.h"
+#include "src/tint/utils/reflection/reflection.h"
+#include "src/tint/utils/result/result.h"
+
+// Forward declarations.
+namespace tint::core::ir {
+class Module;
+}
+
+namespace tint::core::ir::transform {
+
+/// The capabilities that the transform can support.
+const core::ir::Capabilities kOptimizeCapabilities{
+    core::ir::Capability::kAllow8BitIntegers,
+    core::ir::Capability::kAllowPointersInStructures,
+    core::ir::Capability::kAllowVectorElementPointer,
+    core::ir::Capability::kAllowHandleVarsWithoutBindings,
+    core::ir::Capability::kAllowClipDistancesOnF32,
+};
+
+/// Configuration for Optimize transform.
+struct OptimizeConfig {
+    /// Forward values stored to function-scope variables to later loads in the same block
+    bool forward_stores = true;
+
+    /// Replace instructions that only have constant operands with the evaluated constant
+    bool fold_constants = true;
+
+    /// Replace pure instructions with an equivalent instruction that dominates them
+    bool eliminate_common_subexpressions = true;
+
+    /// Remove unused instructions, functions and module-scope variables
+    bool eliminate_dead_code = true;
+
+    /// Reflection for this class
+    TINT_REFLECT(OptimizeConfig,
+                 forward_stores,
+                 fold_constants,
+                 eliminate_common_subexpressions,
+                 eliminate_dead_code);
+};
+
+/// Optimize is an opt-in transform that performs simple, target-independent optimizations on the
+/// core IR, reducing the size of the generated code. The passes run in the following order:
+/// * Store-to-load forwarding: a load of a function-scope variable is replaced with the value most
+///   recently stored to the variable, if the store is in the same block. Only variables whose
+///   pointer is used exclusively by loads and stores are considered.
+/// * Constant folding: pure instructions with only constant operands are replaced with the result
+///   of evaluating the instruction with core::ir::Evaluator.
+/// * Common subexpression elimination: pure instructions (binary, unary, access, construct,
+///   convert, swizzle and bitcast) that are equivalent to a dominating instruction are replaced
+///   with the dominating instruction's result.
+/// * Dead code elimination: unused instructions that have no side-effects, function-scope
+///   variables that are never loaded, unused private and workgroup module-scope variables and, if
+///   the module has an entry point, functions that are never called are removed.
+///
+/// @param module the module to transform
+/// @param cfg the configuration
+/// @returns error diagnostics on failure
+Result<SuccessType> Optimize(Module& module, const OptimizeConfig& cfg = {});
+
+}  // namespace tint::core::ir::transform
+
+#endif  // SRC_TINT_LANG_CORE_IR_TRANSFORM_OPTIMIZE_H_
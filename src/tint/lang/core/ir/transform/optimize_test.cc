@@ -0,0 +1,900 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/tint/lang/core/ir/transform/optimize.h"
+
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "src/tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::core::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;     // NOLINT
+using namespace tint::core::number_suffixes;  // NOLINT
+
+using IR_OptimizeTest = TransformTest;
+
+TEST_F(IR_OptimizeTest, Empty) {
+    auto* expect = R"(
+)";
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, FoldConstants_Binary) {
+    auto* fn = b.Function("F", ty.i32());
+    b.Append(fn->Block(), [&] {
+        auto* x = b.Add<i32>(1_i, 2_i);
+        auto* y = b.Multiply<i32>(x, 3_i);
+        b.Return(fn, y);
+    });
+
+    auto* src = R"(
+%F = func():i32 {
+  $B1: {
+    %2:i32 = add 1i, 2i
+    %3:i32 = mul %2, 3i
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = R"(
+%F = func():i32 {
+  $B1: {
+    ret 9i
+  }
+}
+)";
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, FoldConstants_Construct) {
+    auto* fn = b.Function("F", ty.f32());
+    b.Append(fn->Block(), [&] {
+        auto* v = b.Construct<vec3<f32>>(1_f, 2_f, 3_f);
+        auto* s = b.Access<f32>(v, 1_u);
+        b.Return(fn, s);
+    });
+
+    auto* src = R"(
+%F = func():f32 {
+  $B1: {
+    %2:vec3<f32> = construct 1.0f, 2.0f, 3.0f
+    %3:f32 = access %2, 1u
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = R"(
+%F = func():f32 {
+  $B1: {
+    ret 2.0f
+  }
+}
+)";
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, FoldConstants_Builtin) {
+    auto* fn = b.Function("F", ty.i32());
+    b.Append(fn->Block(), [&] {
+        auto* x = b.Call<i32>(core::BuiltinFn::kMax, 4_i, 7_i);
+        b.Return(fn, x);
+    });
+
+    auto* src = R"(
+%F = func():i32 {
+  $B1: {
+    %2:i32 = max 4i, 7i
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = R"(
+%F = func():i32 {
+  $B1: {
+    ret 7i
+  }
+}
+)";
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, FoldConstants_EvaluationError) {
+    auto* fn = b.Function("F", ty.i32());
+    b.Append(fn->Block(), [&] {
+        auto* x = b.Divide<i32>(1_i, 0_i);
+        auto* y = b.Add<i32>(x, 1_i);
+        b.Return(fn, y);
+    });
+
+    auto* src = R"(
+%F = func():i32 {
+  $B1: {
+    %2:i32 = div 1i, 0i
+    %3:i32 = add %2, 1i
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = src;
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, FoldConstants_NonConstantOperand) {
+    auto* p = b.FunctionParam<i32>("p");
+    auto* fn = b.Function("F", ty.i32());
+    fn->SetParams({p});
+    b.Append(fn->Block(), [&] {
+        auto* x = b.Add<i32>(p, 1_i);
+        b.Return(fn, x);
+    });
+
+    auto* src = R"(
+%F = func(%p:i32):i32 {
+  $B1: {
+    %3:i32 = add %p, 1i
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = src;
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, CSE_SameBlock) {
+    auto* p = b.FunctionParam<i32>("p");
+    auto* q = b.FunctionParam<i32>("q");
+    auto* fn = b.Function("F", ty.i32());
+    fn->SetParams({p, q});
+    b.Append(fn->Block(), [&] {
+        auto* x = b.Add<i32>(p, q);
+        auto* y = b.Add<i32>(p, q);
+        auto* z = b.Subtract<i32>(p, q);
+        b.Return(fn, b.Multiply<i32>(b.Multiply<i32>(x, y), z));
+    });
+
+    auto* src = R"(
+%F = func(%p:i32, %q:i32):i32 {
+  $B1: {
+    %4:i32 = add %p, %q
+    %5:i32 = add %p, %q
+    %6:i32 = sub %p, %q
+    %7:i32 = mul %4, %5
+    %8:i32 = mul %7, %6
+    ret %8
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = R"(
+%F = func(%p:i32, %q:i32):i32 {
+  $B1: {
+    %4:i32 = add %p, %q
+    %5:i32 = sub %p, %q
+    %6:i32 = mul %4, %4
+    %7:i32 = mul %6, %5
+    ret %7
+  }
+}
+)";
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, CSE_DominatingBlock) {
+    auto* p = b.FunctionParam<i32>("p");
+    auto* fn = b.Function("F", ty.i32());
+    fn->SetParams({p});
+    b.Append(fn->Block(), [&] {
+        auto* x = b.Negation<i32>(p);
+        auto* ifelse = b.If(true);
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {  //
+            b.ExitIf(ifelse, b.Negation<i32>(p));
+        });
+        b.Append(ifelse->False(), [&] {  //
+            b.ExitIf(ifelse, x);
+        });
+        b.Return(fn, b.Add<i32>(x, ifelse->Result(0)));
+    });
+
+    auto* src = R"(
+%F = func(%p:i32):i32 {
+  $B1: {
+    %3:i32 = negation %p
+    %4:i32 = if true [t: $B2, f: $B3] {  # if_1
+      $B2: {  # true
+        %5:i32 = negation %p
+        exit_if %5  # if_1
+      }
+      $B3: {  # false
+        exit_if %3  # if_1
+      }
+    }
+    %6:i32 = add %3, %4
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = R"(
+%F = func(%p:i32):i32 {
+  $B1: {
+    %3:i32 = negation %p
+    %4:i32 = if true [t: $B2, f: $B3] {  # if_1
+      $B2: {  # true
+        exit_if %3  # if_1
+      }
+      $B3: {  # false
+        exit_if %3  # if_1
+      }
+    }
+    %5:i32 = add %3, %4
+    ret %5
+  }
+}
+)";
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, CSE_SiblingBlocks) {
+    auto* p = b.FunctionParam<i32>("p");
+    auto* fn = b.Function("F", ty.i32());
+    fn->SetParams({p});
+    b.Append(fn->Block(), [&] {
+        auto* ifelse = b.If(true);
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {  //
+            b.ExitIf(ifelse, b.Negation<i32>(p));
+        });
+        b.Append(ifelse->False(), [&] {  //
+            b.ExitIf(ifelse, b.Negation<i32>(p));
+        });
+        b.Return(fn, b.Add<i32>(b.Negation<i32>(p), ifelse->Result(0)));
+    });
+
+    auto* src = R"(
+%F = func(%p:i32):i32 {
+  $B1: {
+    %3:i32 = if true [t: $B2, f: $B3] {  # if_1
+      $B2: {  # true
+        %4:i32 = negation %p
+        exit_if %4  # if_1
+      }
+      $B3: {  # false
+        %5:i32 = negation %p
+        exit_if %5  # if_1
+      }
+    }
+    %6:i32 = negation %p
+    %7:i32 = add %6, %3
+    ret %7
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = src;
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, CSE_DifferentOperators) {
+    auto* p = b.FunctionParam<vec4<f32>>("p");
+    auto* fn = b.Function("F", ty.vec2<f32>());
+    fn->SetParams({p});
+    b.Append(fn->Block(), [&] {
+        auto* x = b.Swizzle(ty.vec2<f32>(), p, {0u, 1u});
+        auto* y = b.Swizzle(ty.vec2<f32>(), p, {1u, 0u});
+        b.Return(fn, b.Add<vec2<f32>>(x, y));
+    });
+
+    auto* src = R"(
+%F = func(%p:vec4<f32>):vec2<f32> {
+  $B1: {
+    %3:vec2<f32> = swizzle %p, xy
+    %4:vec2<f32> = swizzle %p, yx
+    %5:vec2<f32> = add %3, %4
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = src;
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, ForwardStores_StoreThenLoad) {
+    auto* p = b.FunctionParam<i32>("p");
+    auto* fn = b.Function("F", ty.i32());
+    fn->SetParams({p});
+    b.Append(fn->Block(), [&] {
+        auto* v = b.Var<function, i32>("v");
+        b.Store(v, p);
+        auto* x = b.Load(v);
+        b.Return(fn, x);
+    });
+
+    auto* src = R"(
+%F = func(%p:i32):i32 {
+  $B1: {
+    %v:ptr<function, i32, read_write> = var
+    store %v, %p
+    %4:i32 = load %v
+    ret %4
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = R"(
+%F = func(%p:i32):i32 {
+  $B1: {
+    ret %p
+  }
+}
+)";
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, ForwardStores_Initializer) {
+    auto* fn = b.Function("F", ty.i32());
+    b.Append(fn->Block(), [&] {
+        auto* v = b.Var<function>("v", 4_i);
+        auto* x = b.Load(v);
+        b.Return(fn, b.Add<i32>(x, 1_i));
+    });
+
+    auto* src = R"(
+%F = func():i32 {
+  $B1: {
+    %v:ptr<function, i32, read_write> = var, 4i
+    %3:i32 = load %v
+    %4:i32 = add %3, 1i
+    ret %4
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = R"(
+%F = func():i32 {
+  $B1: {
+    ret 5i
+  }
+}
+)";
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, ForwardStores_LoadThenLoad) {
+    auto* fn = b.Function("F", ty.i32());
+    b.Append(fn->Block(), [&] {
+        auto* v = b.Var<function, i32>("v");
+        auto* ifelse = b.If(true);
+        b.Append(ifelse->True(), [&] {
+            b.Store(v, 1_i);
+            b.ExitIf(ifelse);
+        });
+        auto* x = b.Load(v);
+        auto* y = b.Load(v);
+        b.Return(fn, b.Add<i32>(x, y));
+    });
+
+    auto* src = R"(
+%F = func():i32 {
+  $B1: {
+    %v:ptr<function, i32, read_write> = var
+    if true [t: $B2] {  # if_1
+      $B2: {  # true
+        store %v, 1i
+        exit_if  # if_1
+      }
+    }
+    %3:i32 = load %v
+    %4:i32 = load %v
+    %5:i32 = add %3, %4
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = R"(
+%F = func():i32 {
+  $B1: {
+    %v:ptr<function, i32, read_write> = var
+    if true [t: $B2] {  # if_1
+      $B2: {  # true
+        store %v, 1i
+        exit_if  # if_1
+      }
+    }
+    %3:i32 = load %v
+    %4:i32 = add %3, %3
+    ret %4
+  }
+}
+)";
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, ForwardStores_StoreInChildBlock) {
+    auto* p = b.FunctionParam<bool>("p");
+    auto* fn = b.Function("F", ty.i32());
+    fn->SetParams({p});
+    b.Append(fn->Block(), [&] {
+        auto* v = b.Var<function, i32>("v");
+        b.Store(v, 1_i);
+        auto* ifelse = b.If(p);
+        b.Append(ifelse->True(), [&] {
+            b.Store(v, 2_i);
+            b.ExitIf(ifelse);
+        });
+        b.Return(fn, b.Load(v));
+    });
+
+    auto* src = R"(
+%F = func(%p:bool):i32 {
+  $B1: {
+    %v:ptr<function, i32, read_write> = var
+    store %v, 1i
+    if %p [t: $B2] {  # if_1
+      $B2: {  # true
+        store %v, 2i
+        exit_if  # if_1
+      }
+    }
+    %4:i32 = load %v
+    ret %4
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = src;
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, ForwardStores_PointerEscapes) {
+    auto* fn = b.Function("F", ty.i32());
+    b.Append(fn->Block(), [&] {
+        auto* v = b.Var<function, array<i32, 2>>("v");
+        b.Store(v, b.Zero<array<i32, 2>>());
+        b.Store(b.Access<ptr<function, i32>>(v, 0_u), 2_i);
+        auto* x = b.Load(v);
+        b.Return(fn, b.Access<i32>(x, 0_u));
+    });
+
+    auto* src = R"(
+%F = func():i32 {
+  $B1: {
+    %v:ptr<function, array<i32, 2>, read_write> = var
+    store %v, array<i32, 2>(0i)
+    %3:ptr<function, i32, read_write> = access %v, 0u
+    store %3, 2i
+    %4:array<i32, 2> = load %v
+    %5:i32 = access %4, 0u
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = src;
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, DCE_UnusedInstructions) {
+    auto* p = b.FunctionParam<f32>("p");
+    auto* fn = b.Function("F", ty.void_());
+    fn->SetParams({p});
+    b.Append(fn->Block(), [&] {
+        auto* x = b.Multiply<f32>(p, 2_f);
+        b.Let("y", b.Call<f32>(core::BuiltinFn::kSqrt, x));
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%F = func(%p:f32):void {
+  $B1: {
+    %3:f32 = mul %p, 2.0f
+    %4:f32 = sqrt %3
+    %y:f32 = let %4
+    ret
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = R"(
+%F = func(%p:f32):void {
+  $B1: {
+    ret
+  }
+}
+)";
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, DCE_SideEffects) {
+    auto* a = b.Var<workgroup, atomic<i32>>("a");
+    b.ir.root_block->Append(a);
+
+    auto* g = b.Function("g", ty.i32());
+    b.Append(g->Block(), [&] {  //
+        b.Return(g, 1_i);
+    });
+
+    auto* fn = b.ComputeFunction("F");
+    b.Append(fn->Block(), [&] {
+        b.Call<i32>(core::BuiltinFn::kAtomicAdd, a, 1_i);
+        b.Call(g);
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+$B1: {  # root
+  %a:ptr<workgroup, atomic<i32>, read_write> = var
+}
+
+%g = func():i32 {
+  $B2: {
+    ret 1i
+  }
+}
+%F = @compute @workgroup_size(1u, 1u, 1u) func():void {
+  $B3: {
+    %4:i32 = atomicAdd %a, 1i
+    %5:i32 = call %g
+    ret
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = src;
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, DCE_StoreOnlyVar) {
+    auto* p = b.FunctionParam<i32>("p");
+    auto* fn = b.Function("F", ty.void_());
+    fn->SetParams({p});
+    b.Append(fn->Block(), [&] {
+        auto* v = b.Var<function, i32>("v");
+        b.Store(v, b.Add<i32>(p, 1_i));
+        auto* ifelse = b.If(true);
+        b.Append(ifelse->True(), [&] {
+            b.Store(v, 2_i);
+            b.ExitIf(ifelse);
+        });
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%F = func(%p:i32):void {
+  $B1: {
+    %v:ptr<function, i32, read_write> = var
+    %4:i32 = add %p, 1i
+    store %v, %4
+    if true [t: $B2] {  # if_1
+      $B2: {  # true
+        store %v, 2i
+        exit_if  # if_1
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = R"(
+%F = func(%p:i32):void {
+  $B1: {
+    if true [t: $B2] {  # if_1
+      $B2: {  # true
+        exit_if  # if_1
+      }
+    }
+    ret
+  }
+}
+)";
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, DCE_UnusedFunctionsAndVars) {
+    auto* used = b.Var<private_, i32>("used");
+    b.ir.root_block->Append(used);
+    auto* unused = b.Var<private_, i32>("unused");
+    b.ir.root_block->Append(unused);
+
+    auto* leaf = b.Function("leaf", ty.void_());
+    b.Append(leaf->Block(), [&] {
+        b.Store(unused, 1_i);
+        b.Return(leaf);
+    });
+
+    auto* dead = b.Function("dead", ty.void_());
+    b.Append(dead->Block(), [&] {
+        b.Call(leaf);
+        b.Return(dead);
+    });
+
+    auto* live = b.Function("live", ty.void_());
+    b.Append(live->Block(), [&] {
+        b.Store(used, 1_i);
+        b.Return(live);
+    });
+
+    auto* ep = b.ComputeFunction("main");
+    b.Append(ep->Block(), [&] {
+        b.Call(live);
+        b.Return(ep);
+    });
+
+    auto* src = R"(
+$B1: {  # root
+  %used:ptr<private, i32, read_write> = var
+  %unused:ptr<private, i32, read_write> = var
+}
+
+%leaf = func():void {
+  $B2: {
+    store %unused, 1i
+    ret
+  }
+}
+%dead = func():void {
+  $B3: {
+    %5:void = call %leaf
+    ret
+  }
+}
+%live = func():void {
+  $B4: {
+    store %used, 1i
+    ret
+  }
+}
+%main = @compute @workgroup_size(1u, 1u, 1u) func():void {
+  $B5: {
+    %8:void = call %live
+    ret
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = R"(
+$B1: {  # root
+  %used:ptr<private, i32, read_write> = var
+}
+
+%live = func():void {
+  $B2: {
+    store %used, 1i
+    ret
+  }
+}
+%main = @compute @workgroup_size(1u, 1u, 1u) func():void {
+  $B3: {
+    %4:void = call %live
+    ret
+  }
+}
+)";
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, DCE_NoEntryPoint) {
+    auto* fn = b.Function("F", ty.void_());
+    b.Append(fn->Block(), [&] {  //
+        b.Return(fn);
+    });
+
+    auto* src = R"(
+%F = func():void {
+  $B1: {
+    ret
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = src;
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, AllPasses) {
+    auto* p = b.FunctionParam<i32>("p");
+    auto* fn = b.Function("F", ty.i32());
+    fn->SetParams({p});
+    b.Append(fn->Block(), [&] {
+        auto* v = b.Var<function, i32>("v");
+        b.Store(v, 2_i);
+        auto* x = b.Multiply<i32>(b.Load(v), 3_i);
+        auto* y = b.Add<i32>(p, x);
+        auto* z = b.Add<i32>(p, x);
+        b.Let("unused", b.Subtract<i32>(y, z));
+        b.Return(fn, b.Multiply<i32>(y, z));
+    });
+
+    auto* src = R"(
+%F = func(%p:i32):i32 {
+  $B1: {
+    %v:ptr<function, i32, read_write> = var
+    store %v, 2i
+    %4:i32 = load %v
+    %5:i32 = mul %4, 3i
+    %6:i32 = add %p, %5
+    %7:i32 = add %p, %5
+    %8:i32 = sub %6, %7
+    %unused:i32 = let %8
+    %10:i32 = mul %6, %7
+    ret %10
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = R"(
+%F = func(%p:i32):i32 {
+  $B1: {
+    %3:i32 = add %p, 6i
+    %4:i32 = mul %3, %3
+    ret %4
+  }
+}
+)";
+
+    Run(Optimize, OptimizeConfig{});
+
+    EXPECT_EQ(str(), expect);
+}
+
+TEST_F(IR_OptimizeTest, AllPassesDisabled) {
+    auto* p = b.FunctionParam<i32>("p");
+    auto* fn = b.Function("F", ty.i32());
+    fn->SetParams({p});
+    b.Append(fn->Block(), [&] {
+        auto* v = b.Var<function, i32>("v");
+        b.Store(v, 2_i);
+        auto* x = b.Multiply<i32>(b.Load(v), 3_i);
+        auto* y = b.Add<i32>(p, x);
+        auto* z = b.Add<i32>(p, x);
+        b.Let("unused", b.Subtract<i32>(y, z));
+        b.Return(fn, b.Multiply<i32>(y, z));
+    });
+
+    auto* src = R"(
+%F = func(%p:i32):i32 {
+  $B1: {
+    %v:ptr<function, i32, read_write> = var
+    store %v, 2i
+    %4:i32 = load %v
+    %5:i32 = mul %4, 3i
+    %6:i32 = add %p, %5
+    %7:i32 = add %p, %5
+    %8:i32 = sub %6, %7
+    %unused:i32 = let %8
+    %10:i32 = mul %6, %7
+    ret %10
+  }
+}
+)";
+    EXPECT_EQ(str(), src);
+
+    auto* expect = src;
+
+    OptimizeConfig cfg;
+    cfg.forward_stores = false;
+    cfg.fold_constants = false;
+    cfg.eliminate_common_subexpressions = false;
+    cfg.eliminate_dead_code = false;
+    Run(Optimize, cfg);
+
+    EXPECT_EQ(str(), expect);
+}
+
+}  // namespace
+}  // namespace tint::core::ir::transform
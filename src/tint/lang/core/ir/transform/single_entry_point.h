@@ -28,12 +28,13 @@
 #ifndef SRC_TINT_LANG_CORE_IR_TRANSFORM_SINGLE_ENTRY_POINT_H_
 #define SRC_TINT_LANG_CORE_IR_TRANSFORM_SINGLE_ENTRY_POINT_H_
 
-#include "src/tint/utils/result/result.h"
+#include <functional>
+#include <string>
 
-// Forward declarations.
-namespace tint::core::ir {
-class Module;
-}
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/utils/containers/vector.h"
+#include "src/tint/utils/result/result.h"
+#include "src/tint/utils/system/parallel.h"
 
 namespace tint::core::ir::transform {
 
@@ -44,6 +45,52 @@ namespace tint::core::ir::transform {
 /// @returns success or failure
 Result<SuccessType> SingleEntryPoint(Module& module, std::string_view entry_point_name);
 
+/// A function that builds a new IR module.
+/// GenerateEntryPoints() calls this once per entry point, as each entry point needs a private
+/// module that can be stripped and raised in-place. The function may be called concurrently from
+/// multiple threads.
+using ModuleFactory = std::function<Result<Module>()>;
+
+/// Calls @p generate for each of the entry points in @p entry_points, with each entry point
+/// generated on one of up to @p max_threads worker threads.
+/// For each entry point, a new IR module is built with @p factory, stripped down to the single
+/// entry point with SingleEntryPoint(), then passed to @p generate with the entry point's options.
+/// @param factory the function used to build the IR module for each entry point
+/// @param entry_points the entry points to generate, each with a `name` and `options`. Each must
+/// exist in the built module.
+/// @param max_threads the maximum number of threads to use. If 0, then a thread is used per
+/// hardware thread.
+/// @param generate the backend's generator, called as `generate(module, options)`
+/// @returns the result of @p generate for each entry point, in the order of @p entry_points
+template <typename OUTPUT, typename REQUEST, typename GENERATE>
+Vector<Result<OUTPUT>, 4> GenerateEntryPoints(const ModuleFactory& factory,
+                                              VectorRef<REQUEST> entry_points,
+                                              uint32_t max_threads,
+                                              GENERATE&& generate) {
+    Vector<Result<OUTPUT>, 4> results;
+    results.Resize(entry_points.Length());
+    ParallelFor(entry_points.Length(), max_threads, [&](size_t i) {
+        auto& entry_point = entry_points[i];
+
+        // Build a private module for this entry point, as the module is modified in-place.
+        auto ir = factory();
+        if (ir != Success) {
+            results[i] = ir.Failure();
+            return;
+        }
+
+        // Strip the module down to the single entry point.
+        auto res = SingleEntryPoint(ir.Get(), entry_point.name);
+        if (res != Success) {
+            results[i] = res.Failure();
+            return;
+        }
+
+        results[i] = generate(ir.Get(), entry_point.options);
+    });
+    return results;
+}
+
 }  // namespace tint::core::ir::transform
 
 #endif  // SRC_TINT_LANG_CORE_IR_TRANSFORM_SINGLE_ENTRY_POINT_H_
@@ -612,6 +612,11 @@ class Manager final {
     /// @returns an iterator to the end of the types
     TypeIterator end() const { return types_.end(); }
 
+    /// @returns the summed memory usage counters of the allocators owned by the manager
+    AllocatorStats Stats() const {
+        return types_.Stats() + unique_nodes_.Stats() + nodes_.Stats();
+    }
+
   private:
     /// Unique types owned by the manager
     UniqueAllocator<Type> types_;
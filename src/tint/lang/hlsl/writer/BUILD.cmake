@@ -59,6 +59,7 @@ tint_target_add_dependencies(tint_lang_hlsl_writer lib
   tint_lang_core
   tint_lang_core_constant
   tint_lang_core_ir
+  tint_lang_core_ir_transform
   tint_lang_core_type
   tint_lang_hlsl_writer_common
   tint_lang_hlsl_writer_printer
@@ -119,6 +120,7 @@ tint_add_target(tint_lang_hlsl_writer_test test
   lang/hlsl/writer/switch_test.cc
   lang/hlsl/writer/unary_test.cc
   lang/hlsl/writer/var_let_test.cc
+  lang/hlsl/writer/writer_test.cc
 )
 
 tint_target_add_dependencies(tint_lang_hlsl_writer_test test
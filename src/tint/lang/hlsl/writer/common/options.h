@@ -211,6 +211,9 @@ struct Options {
     /// `unpack4xI8` and `unpack4xU8` builtins
     bool polyfill_pack_unpack_4x8 = false;
 
+    /// Set to `true` to run the core IR Optimize transform before raising the module
+    bool optimize_ir = false;
+
     /// The downstream compiler which will be used
     Compiler compiler = Compiler::kDXC;
 
@@ -240,6 +243,7 @@ struct Options {
                  polyfill_dot_4x8_packed,
                  disable_polyfill_integer_div_mod,
                  polyfill_pack_unpack_4x8,
+                 optimize_ir,
                  compiler,
                  array_length_from_uniform,
                  interstage_locations,
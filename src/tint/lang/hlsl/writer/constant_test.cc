@@ -87,6 +87,27 @@ void unused_entry_point() {
 )");
 }
 
+TEST_F(HlslWriterTest, ConstantInt_OptimizeIR) {
+    auto* f = b.Function("a", ty.i32());
+    b.Append(f->Block(), [&] {  //
+        b.Return(f, b.Add(ty.i32(), 1_i, 2_i));
+    });
+
+    Options options;
+    options.optimize_ir = true;
+    ASSERT_TRUE(Generate(options)) << err_ << output_.hlsl;
+    EXPECT_EQ(output_.hlsl, R"(
+int a() {
+  return int(3);
+}
+
+[numthreads(1, 1, 1)]
+void unused_entry_point() {
+}
+
+)");
+}
+
 TEST_F(HlslWriterTest, ConstantUInt) {
     auto* f = b.Function("a", ty.u32());
     f->Block()->Append(b.Return(f, 56779_u));
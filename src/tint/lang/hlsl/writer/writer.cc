@@ -32,6 +32,7 @@
 
 #include "src/tint/lang/core/ir/function.h"
 #include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/transform/single_entry_point.h"
 #include "src/tint/lang/hlsl/writer/ast_printer/ast_printer.h"
 #include "src/tint/lang/hlsl/writer/printer/printer.h"
 #include "src/tint/lang/hlsl/writer/raise/raise.h"
@@ -117,4 +118,12 @@ Result<Output> Generate(const Program& program, const Options& options) {
     return output;
 }
 
+Vector<Result<Output>, 4> GenerateEntryPoints(const ModuleFactory& factory,
+                                              VectorRef<EntryPointRequest> entry_points,
+                                              uint32_t max_threads) {
+    return core::ir::transform::GenerateEntryPoints<Output>(
+        factory, entry_points, max_threads,
+        [](core::ir::Module& ir, const Options& options) { return Generate(ir, options); });
+}
+
 }  // namespace tint::hlsl::writer
@@ -30,8 +30,10 @@
 
 #include <string>
 
+#include "src/tint/lang/core/ir/transform/single_entry_point.h"
 #include "src/tint/lang/hlsl/writer/common/options.h"
 #include "src/tint/lang/hlsl/writer/output.h"
+#include "src/tint/utils/containers/vector.h"
 #include "src/tint/utils/diagnostic/diagnostic.h"
 #include "src/tint/utils/result/result.h"
 
@@ -59,6 +61,30 @@ Result<Output> Generate(core::ir::Module& ir, const Options& options);
 /// @returns the resulting HLSL and supplementary information, or failure
 Result<Output> Generate(const Program& program, const Options& options);
 
+/// A function that builds a new core-dialect IR module, see GenerateEntryPoints().
+using ModuleFactory = core::ir::transform::ModuleFactory;
+
+/// A single entry point to generate with GenerateEntryPoints().
+struct EntryPointRequest {
+    /// The name of the entry point
+    std::string name;
+    /// The configuration options to use when generating HLSL for the entry point
+    Options options;
+};
+
+/// Generate HLSL for each of the entry points in @p entry_points, with each entry point generated
+/// on one of up to @p max_threads worker threads.
+/// For each entry point, a new IR module is built with @p factory, stripped down to the single
+/// entry point, then raised and printed with Generate().
+/// @param factory the function used to build the IR module for each entry point
+/// @param entry_points the entry points to generate. Each must exist in the built module.
+/// @param max_threads the maximum number of threads to use. If 0, then a thread is used per
+/// hardware thread.
+/// @returns the HLSL generation result for each entry point, in the order of @p entry_points
+Vector<Result<Output>, 4> GenerateEntryPoints(const ModuleFactory& factory,
+                                              VectorRef<EntryPointRequest> entry_points,
+                                              uint32_t max_threads = 0);
+
 }  // namespace tint::hlsl::writer
 
 #endif  // SRC_TINT_LANG_HLSL_WRITER_WRITER_H_
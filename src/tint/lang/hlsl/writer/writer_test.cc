@@ -0,0 +1,87 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/tint/lang/hlsl/writer/helper_test.h"
+
+#include "gmock/gmock.h"
+
+namespace tint::hlsl::writer {
+namespace {
+
+TEST_F(HlslWriterTest, GenerateEntryPoints) {
+    auto factory = []() -> Result<core::ir::Module> {
+        core::ir::Module m;
+        core::ir::Builder builder{m};
+        for (auto* name : {"ep_a", "ep_b", "ep_c", "ep_d"}) {
+            auto* ep = builder.ComputeFunction(name);
+            builder.Append(ep->Block(), [&] {  //
+                builder.Return(ep);
+            });
+        }
+        return m;
+    };
+
+    Vector<EntryPointRequest, 4> requests{
+        {"ep_d", {}},
+        {"ep_b", {}},
+        {"ep_a", {}},
+        {"ep_c", {}},
+    };
+    auto results = GenerateEntryPoints(factory, requests, 3);
+    ASSERT_EQ(results.Length(), requests.Length());
+    for (size_t i = 0; i < requests.Length(); i++) {
+        ASSERT_EQ(results[i], Success) << results[i].Failure().reason.Str();
+
+        // Each output must contain only the requested entry point.
+        for (auto& other : requests) {
+            auto entry_point = "void " + other.name + "()";
+            if (other.name == requests[i].name) {
+                EXPECT_THAT(results[i]->hlsl, testing::HasSubstr(entry_point));
+            } else {
+                EXPECT_THAT(results[i]->hlsl, testing::Not(testing::HasSubstr(entry_point)));
+            }
+        }
+    }
+}
+
+TEST_F(HlslWriterTest, GenerateEntryPoints_FactoryFailure) {
+    auto factory = []() -> Result<core::ir::Module> { return Failure{"factory failed"}; };
+
+    Vector<EntryPointRequest, 2> requests{
+        {"ep_a", {}},
+        {"ep_b", {}},
+    };
+    auto results = GenerateEntryPoints(factory, requests);
+    ASSERT_EQ(results.Length(), 2u);
+    for (auto& result : results) {
+        ASSERT_NE(result, Success);
+        EXPECT_EQ(result.Failure().reason.Str(), "error: factory failed");
+    }
+}
+
+}  // namespace
+}  // namespace tint::hlsl::writer
@@ -148,6 +148,9 @@ struct Options {
     /// Set to `true` to disable the polyfills on integer division and modulo.
     bool disable_polyfill_integer_div_mod = false;
 
+    /// Set to `true` to run the core IR Optimize transform before raising the module
+    bool optimize_ir = false;
+
     /// The index to use when generating a UBO to receive storage buffer sizes.
     /// Defaults to 30, which is the last valid buffer slot.
     uint32_t buffer_size_ubo_index = 30;
@@ -172,6 +175,7 @@ struct Options {
                  disable_workgroup_init,
                  emit_vertex_point_size,
                  disable_polyfill_integer_div_mod,
+                 optimize_ir,
                  buffer_size_ubo_index,
                  fixed_sample_mask,
                  pixel_local_attachments,
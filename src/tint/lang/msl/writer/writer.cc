@@ -30,6 +30,8 @@
 #include <memory>
 #include <utility>
 
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/transform/single_entry_point.h"
 #include "src/tint/lang/msl/writer/ast_printer/ast_printer.h"
 #include "src/tint/lang/msl/writer/common/option_helpers.h"
 #include "src/tint/lang/msl/writer/printer/printer.h"
@@ -98,4 +100,12 @@ Result<Output> Generate(const Program& program, const Options& options) {
     return output;
 }
 
+Vector<Result<Output>, 4> GenerateEntryPoints(const ModuleFactory& factory,
+                                              VectorRef<EntryPointRequest> entry_points,
+                                              uint32_t max_threads) {
+    return core::ir::transform::GenerateEntryPoints<Output>(
+        factory, entry_points, max_threads,
+        [](core::ir::Module& ir, const Options& options) { return Generate(ir, options); });
+}
+
 }  // namespace tint::msl::writer
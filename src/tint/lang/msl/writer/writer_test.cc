@@ -91,6 +91,19 @@ kernel void foo(uint tint_local_index [[thread_index_in_threadgroup]], threadgro
     EXPECT_THAT(output_.workgroup_allocations.at("bar"), testing::ElementsAre());
 }
 
+TEST_F(MslWriterTest, OptimizeIR) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {  //
+        b.Return(func, b.Add(ty.i32(), 1_i, 2_i));
+    });
+
+    Options options;
+    options.optimize_ir = true;
+    ASSERT_TRUE(Generate(options)) << err_ << output_.msl;
+    EXPECT_THAT(output_.msl, testing::HasSubstr("return 3;"));
+    EXPECT_THAT(output_.msl, testing::Not(testing::HasSubstr("+")));
+}
+
 TEST_F(MslWriterTest, NeedsStorageBufferSizes_False) {
     auto* var = b.Var("a", ty.ptr<storage, array<u32>>());
     var->SetBindingPoint(0, 0);
@@ -179,5 +192,56 @@ kernel void foo(device tint_array<uint, 1>* a [[buffer(0)]], const constant tint
     EXPECT_TRUE(output_.needs_storage_buffer_sizes);
 }
 
+TEST_F(MslWriterTest, GenerateEntryPoints) {
+    auto factory = []() -> Result<core::ir::Module> {
+        core::ir::Module m;
+        core::ir::Builder builder{m};
+        for (auto* name : {"ep_a", "ep_b", "ep_c", "ep_d"}) {
+            auto* ep = builder.ComputeFunction(name);
+            builder.Append(ep->Block(), [&] {  //
+                builder.Return(ep);
+            });
+        }
+        return m;
+    };
+
+    Vector<EntryPointRequest, 4> requests{
+        {"ep_d", {}},
+        {"ep_b", {}},
+        {"ep_a", {}},
+        {"ep_c", {}},
+    };
+    auto results = GenerateEntryPoints(factory, requests, 3);
+    ASSERT_EQ(results.Length(), requests.Length());
+    for (size_t i = 0; i < requests.Length(); i++) {
+        ASSERT_EQ(results[i], Success) << results[i].Failure().reason.Str();
+
+        // Each output must contain only the requested entry point.
+        for (auto& other : requests) {
+            auto entry_point = "kernel void " + other.name + "()";
+            if (other.name == requests[i].name) {
+                EXPECT_THAT(results[i]->msl, testing::HasSubstr(entry_point));
+            } else {
+                EXPECT_THAT(results[i]->msl, testing::Not(testing::HasSubstr(entry_point)));
+            }
+        }
+    }
+}
+
+TEST_F(MslWriterTest, GenerateEntryPoints_FactoryFailure) {
+    auto factory = []() -> Result<core::ir::Module> { return Failure{"factory failed"}; };
+
+    Vector<EntryPointRequest, 2> requests{
+        {"ep_a", {}},
+        {"ep_b", {}},
+    };
+    auto results = GenerateEntryPoints(factory, requests);
+    ASSERT_EQ(results.Length(), 2u);
+    for (auto& result : results) {
+        ASSERT_NE(result, Success);
+        EXPECT_EQ(result.Failure().reason.Str(), "error: factory failed");
+    }
+}
+
 }  // namespace
 }  // namespace tint::msl::writer
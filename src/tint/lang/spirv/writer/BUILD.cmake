@@ -58,6 +58,7 @@ tint_target_add_dependencies(tint_lang_spirv_writer lib
   tint_lang_core_common
   tint_lang_core_constant
   tint_lang_core_ir
+  tint_lang_core_ir_transform
   tint_lang_core_type
   tint_utils_containers
   tint_utils_diagnostic
@@ -181,6 +181,9 @@ struct Options {
     /// Set to `true` if the Vulkan Memory Model should be used
     bool use_vulkan_memory_model = false;
 
+    /// Set to `true` to run the core IR Optimize transform before raising the module
+    bool optimize_ir = false;
+
     /// Reflect the fields of this class so that it can be used by tint::ForeachField()
     TINT_REFLECT(Options,
                  bindings,
@@ -197,7 +200,8 @@ struct Options {
                  experimental_require_subgroup_uniform_control_flow,
                  polyfill_dot_4x8_packed,
                  disable_polyfill_integer_div_mod,
-                 use_vulkan_memory_model);
+                 use_vulkan_memory_model,
+                 optimize_ir);
 };
 
 }  // namespace tint::spirv::writer
@@ -30,6 +30,8 @@
 #include <memory>
 #include <utility>
 
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/transform/single_entry_point.h"
 #include "src/tint/lang/spirv/writer/common/option_helpers.h"
 #include "src/tint/lang/spirv/writer/printer/printer.h"
 #include "src/tint/lang/spirv/writer/raise/raise.h"
@@ -64,4 +66,12 @@ Result<Output> Generate(core::ir::Module& ir, const Options& options) {
     return output;
 }
 
+Vector<Result<Output>, 4> GenerateEntryPoints(const ModuleFactory& factory,
+                                              VectorRef<EntryPointRequest> entry_points,
+                                              uint32_t max_threads) {
+    return core::ir::transform::GenerateEntryPoints<Output>(
+        factory, entry_points, max_threads,
+        [](core::ir::Module& ir, const Options& options) { return Generate(ir, options); });
+}
+
 }  // namespace tint::spirv::writer
@@ -28,9 +28,13 @@
 #ifndef SRC_TINT_LANG_SPIRV_WRITER_WRITER_H_
 #define SRC_TINT_LANG_SPIRV_WRITER_WRITER_H_
 
+#include <string>
+
 #include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/transform/single_entry_point.h"
 #include "src/tint/lang/spirv/writer/common/options.h"
 #include "src/tint/lang/spirv/writer/output.h"
+#include "src/tint/utils/containers/vector.h"
 #include "src/tint/utils/result/result.h"
 
 namespace tint::spirv::writer {
@@ -42,6 +46,30 @@ namespace tint::spirv::writer {
 /// @returns the resulting SPIR-V and supplementary information, or failure.
 Result<Output> Generate(core::ir::Module& ir, const Options& options);
 
+/// A function that builds a new core-dialect IR module, see GenerateEntryPoints().
+using ModuleFactory = core::ir::transform::ModuleFactory;
+
+/// A single entry point to generate with GenerateEntryPoints().
+struct EntryPointRequest {
+    /// The name of the entry point
+    std::string name;
+    /// The configuration options to use when generating SPIR-V for the entry point
+    Options options;
+};
+
+/// Generate SPIR-V for each of the entry points in @p entry_points, with each entry point generated
+/// on one of up to @p max_threads worker threads.
+/// For each entry point, a new IR module is built with @p factory, stripped down to the single
+/// entry point, then raised and printed with Generate().
+/// @param factory the function used to build the IR module for each entry point
+/// @param entry_points the entry points to generate. Each must exist in the built module.
+/// @param max_threads the maximum number of threads to use. If 0, then a thread is used per
+/// hardware thread.
+/// @returns the SPIR-V generation result for each entry point, in the order of @p entry_points
+Vector<Result<Output>, 4> GenerateEntryPoints(const ModuleFactory& factory,
+                                              VectorRef<EntryPointRequest> entry_points,
+                                              uint32_t max_threads = 0);
+
 }  // namespace tint::spirv::writer
 
 #endif  // SRC_TINT_LANG_SPIRV_WRITER_WRITER_H_
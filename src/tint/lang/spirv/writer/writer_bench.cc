@@ -29,6 +29,7 @@
 
 #include "src/tint/cmd/bench/bench.h"
 #include "src/tint/lang/spirv/writer/writer.h"
+#include "src/tint/lang/wgsl/ast/function.h"
 #include "src/tint/lang/wgsl/reader/reader.h"
 
 #if TINT_BUILD_IS_MSVC
@@ -65,6 +66,35 @@ void GenerateSPIRV(benchmark::State& state, std::string input_name) {
 
 TINT_BENCHMARK_PROGRAMS(GenerateSPIRV);
 
+void GenerateSPIRVEntryPoints(benchmark::State& state, std::string input_name) {
+    auto res = bench::GetWgslProgram(input_name);
+    if (res != Success) {
+        state.SkipWithError(res.Failure().reason.Str());
+        return;
+    }
+
+    // Get the list of entry point names.
+    Vector<EntryPointRequest, 4> requests;
+    for (auto* func : res->program.AST().Functions()) {
+        if (func->IsEntryPoint()) {
+            requests.Push({func->name->symbol.Name(), {}});
+        }
+    }
+
+    // Each entry point lowers its own IR module from the shared program.
+    auto factory = [&] { return tint::wgsl::reader::ProgramToLoweredIR(res->program); };
+
+    for (auto _ : state) {
+        for (auto& gen_res : GenerateEntryPoints(factory, requests)) {
+            if (gen_res != Success) {
+                state.SkipWithError(gen_res.Failure().reason.Str());
+            }
+        }
+    }
+}
+
+TINT_BENCHMARK_PROGRAMS(GenerateSPIRVEntryPoints);
+
 }  // namespace
 }  // namespace tint::spirv::writer
 
@@ -51,6 +51,20 @@ TEST_F(SpirvWriterTest, ModuleHeader_VulkanMemoryModel) {
     EXPECT_INST("OpMemoryModel Logical Vulkan");
 }
 
+TEST_F(SpirvWriterTest, OptimizeIR) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {  //
+        b.Return(func, b.Add(ty.i32(), 1_i, 2_i));
+    });
+
+    Options opts;
+    opts.optimize_ir = true;
+
+    ASSERT_TRUE(Generate(opts)) << Error() << output_;
+    EXPECT_INST("OpReturnValue %int_3");
+    EXPECT_THAT(output_, testing::Not(testing::HasSubstr("OpIAdd")));
+}
+
 TEST_F(SpirvWriterTest, Unreachable) {
     auto* func = b.Function("foo", ty.void_());
     b.Append(func->Block(), [&] {
@@ -116,5 +130,58 @@ TEST_F(SpirvWriterTest, TooManyFunctionParameters) {
                     "Function 'foo' has more than 255 parameters after running Tint transforms"));
 }
 
+TEST_F(SpirvWriterTest, GenerateEntryPoints) {
+    auto factory = []() -> Result<core::ir::Module> {
+        core::ir::Module m;
+        core::ir::Builder builder{m};
+        for (auto* name : {"ep_a", "ep_b", "ep_c", "ep_d"}) {
+            auto* ep = builder.ComputeFunction(name);
+            builder.Append(ep->Block(), [&] {  //
+                builder.Return(ep);
+            });
+        }
+        return m;
+    };
+
+    Vector<EntryPointRequest, 4> requests{
+        {"ep_d", {}},
+        {"ep_b", {}},
+        {"ep_a", {}},
+        {"ep_c", {}},
+    };
+    auto results = GenerateEntryPoints(factory, requests, 3);
+    ASSERT_EQ(results.Length(), requests.Length());
+    for (size_t i = 0; i < requests.Length(); i++) {
+        ASSERT_EQ(results[i], Success) << results[i].Failure().reason.Str();
+        EXPECT_TRUE(Validate(results[i]->spirv)) << Error();
+
+        // Each output must contain only the requested entry point.
+        auto spirv = Disassemble(results[i]->spirv);
+        for (auto& other : requests) {
+            auto entry_point = "OpEntryPoint GLCompute %" + other.name + " \"" + other.name + "\"";
+            if (other.name == requests[i].name) {
+                EXPECT_THAT(spirv, testing::HasSubstr(entry_point));
+            } else {
+                EXPECT_THAT(spirv, testing::Not(testing::HasSubstr(entry_point)));
+            }
+        }
+    }
+}
+
+TEST_F(SpirvWriterTest, GenerateEntryPoints_FactoryFailure) {
+    auto factory = []() -> Result<core::ir::Module> { return Failure{"factory failed"}; };
+
+    Vector<EntryPointRequest, 2> requests{
+        {"ep_a", {}},
+        {"ep_b", {}},
+    };
+    auto results = GenerateEntryPoints(factory, requests);
+    ASSERT_EQ(results.Length(), 2u);
+    for (auto& result : results) {
+        ASSERT_NE(result, Success);
+        EXPECT_EQ(result.Failure().reason.Str(), "error: factory failed");
+    }
+}
+
 }  // namespace
 }  // namespace tint::spirv::writer
@@ -125,6 +125,7 @@ tint_add_target(tint_lang_wgsl_ls_test test
   lang/wgsl/ls/completions_test.cc
   lang/wgsl/ls/definition_test.cc
   lang/wgsl/ls/diagnostics_test.cc
+  lang/wgsl/ls/document_test.cc
   lang/wgsl/ls/helpers_test.cc
   lang/wgsl/ls/helpers_test.h
   lang/wgsl/ls/hover_test.cc
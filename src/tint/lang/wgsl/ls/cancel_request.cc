@@ -33,6 +33,9 @@ namespace lsp = langsvr::lsp;
 namespace tint::wgsl::ls {
 
 langsvr::Result<langsvr::SuccessType> Server::Handle(const lsp::CancelRequestNotification&) {
+    // Requests that are still queued when their cancellation arrives are answered with a
+    // RequestCancelled error by Serve(), without being handled. By the time the notification
+    // itself is handled, the request has been answered, so there is nothing left to do.
     return langsvr::Success;
 }
 
@@ -42,7 +42,7 @@ namespace tint::wgsl::ls {
 
 typename lsp::TextDocumentCompletionRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentCompletionRequest& r) {
-    auto file = files_.Get(r.text_document.uri);
+    auto file = GetFile(r.text_document.uri);
     if (!file) {
         return lsp::Null{};
     }
@@ -37,7 +37,7 @@ typename lsp::TextDocumentDefinitionRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentDefinitionRequest& r) {
     typename lsp::TextDocumentDefinitionRequest::SuccessType result = lsp::Null{};
 
-    if (auto file = files_.Get(r.text_document.uri)) {
+    if (auto file = GetFile(r.text_document.uri)) {
         if (auto def = (*file)->Definition((*file)->Conv(r.position))) {
             lsp::Location loc;
             loc.range = (*file)->Conv(def->definition);
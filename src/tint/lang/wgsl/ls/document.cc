@@ -28,6 +28,7 @@
 #include "src/tint/lang/wgsl/ls/server.h"
 
 #include "src/tint/lang/wgsl/reader/reader.h"
+#include "src/tint/utils/text/unicode.h"
 
 namespace lsp = langsvr::lsp;
 
@@ -47,23 +48,36 @@ std::vector<size_t> LineOffsets(std::string_view str) {
     return offsets;
 }
 
+/// @returns the byte offset in @p str of the zero-based position @p pos, which is in utf-16 code
+/// points. @p line_offsets must hold the LineOffsets() of @p str.
+size_t Offset(std::string_view str, const std::vector<size_t>& line_offsets, lsp::Position pos) {
+    if (pos.line >= line_offsets.size()) {
+        return str.length();
+    }
+    size_t offset = line_offsets[pos.line];
+    for (lsp::Uinteger i = 0; i < pos.character && offset < str.length() && str[offset] != '\n';) {
+        const auto [code_point, n] = utf8::Decode(str.substr(offset));
+        if (n == 0) {
+            break;
+        }
+        offset += n;
+        i += utf16::Encode(code_point, nullptr);
+    }
+    return offset;
+}
+
 }  // namespace
 
 langsvr::Result<langsvr::SuccessType> Server::Handle(
     const lsp::TextDocumentDidOpenNotification& n) {
-    wgsl::reader::Options options;
-    options.allowed_features = wgsl::AllowedFeatures::Everything();
-    auto source = std::make_unique<Source::File>(n.text_document.uri, n.text_document.text);
-    auto program = wgsl::reader::Parse(source.get(), options);
-    auto file =
-        std::make_shared<File>(std::move(source), n.text_document.version, std::move(program));
-    files_.Add(n.text_document.uri, file);
-    return PublishDiagnostics(*file);
+    pending_changes_.Remove(n.text_document.uri);
+    return Parse(n.text_document.uri, n.text_document.text, n.text_document.version);
 }
 
 langsvr::Result<langsvr::SuccessType> Server::Handle(
     const lsp::TextDocumentDidCloseNotification& n) {
     files_.Remove(n.text_document.uri);
+    pending_changes_.Remove(n.text_document.uri);
     return langsvr::Success;
 }
 
@@ -74,22 +88,59 @@ langsvr::Result<langsvr::SuccessType> Server::Handle(
         return langsvr::Failure{"document not found"};
     }
 
-    auto utf8 = (*file)->source->content.data;
+    // Apply the edits to the latest text of the document, which may already hold changes that
+    // have not been parsed yet. Each edit is relative to the text produced by the edit before it.
+    auto& pending = pending_changes_.GetOrAdd(n.text_document.uri, [&] {
+        return PendingChange{(*file)->source->content.data, (*file)->version};
+    });
     for (auto& change : n.content_changes) {
         if (auto* edit = change.Get<lsp::TextDocumentContentChangePartial>()) {
-            auto range = (*file)->Conv(edit->range);
-            std::vector<size_t> line_offsets = LineOffsets(utf8);
-            size_t utf8_start = line_offsets[range.begin.line - 1] + range.begin.column - 1;
-            size_t utf8_end = line_offsets[range.end.line - 1] + range.end.column - 1;
-            utf8 = utf8.substr(0, utf8_start) + edit->text + utf8.substr(utf8_end);
+            std::vector<size_t> line_offsets = LineOffsets(pending.text);
+            size_t utf8_start = Offset(pending.text, line_offsets, edit->range.start);
+            size_t utf8_end = Offset(pending.text, line_offsets, edit->range.end);
+            pending.text =
+                pending.text.substr(0, utf8_start) + edit->text + pending.text.substr(utf8_end);
         }
     }
+    pending.version = n.text_document.version;
+
+    // The document is re-parsed by ProcessPendingChanges(), or by the next request that needs it.
+    return langsvr::Success;
+}
+
+langsvr::Result<langsvr::SuccessType> Server::ProcessPendingChanges() {
+    for (auto& uri : pending_changes_.Keys()) {
+        auto pending = pending_changes_.Get(uri);
+        auto res = Parse(uri, pending->text, pending->version);
+        pending_changes_.Remove(uri);
+        if (res != langsvr::Success) {
+            return res;
+        }
+    }
+    return langsvr::Success;
+}
+
+GetResult<std::shared_ptr<File>> Server::GetFile(const std::string& uri) {
+    if (auto pending = pending_changes_.Get(uri)) {
+        auto res = Parse(uri, pending->text, pending->version);
+        pending_changes_.Remove(uri);
+        if (res != langsvr::Success) {
+            Error() << "failed to publish diagnostics: " << res.Failure().reason;
+        }
+    }
+    return files_.Get(uri);
+}
+
+langsvr::Result<langsvr::SuccessType> Server::Parse(const std::string& uri,
+                                                    std::string_view text,
+                                                    int64_t version) {
     wgsl::reader::Options options;
     options.allowed_features = wgsl::AllowedFeatures::Everything();
-    auto source = std::make_unique<Source::File>(n.text_document.uri, utf8);
+    auto source = std::make_unique<Source::File>(uri, text);
     auto program = wgsl::reader::Parse(source.get(), options);
-    *file = std::make_shared<File>(std::move(source), n.text_document.version, std::move(program));
-    return PublishDiagnostics(**file);
+    auto file = std::make_shared<File>(std::move(source), version, std::move(program));
+    files_.Replace(uri, file);
+    return PublishDiagnostics(*file);
 }
 
 }  // namespace tint::wgsl::ls
@@ -0,0 +1,155 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "langsvr/lsp/lsp.h"
+#include "langsvr/lsp/primitives.h"
+#include "langsvr/lsp/printer.h"
+#include "src/tint/lang/wgsl/ls/helpers_test.h"
+
+namespace tint::wgsl::ls {
+namespace {
+
+namespace lsp = langsvr::lsp;
+
+struct Edit {
+    lsp::Range range;
+    std::string_view text;
+};
+
+class LsDocumentTest : public LsTest {
+  public:
+    /// Sends a langsvr::lsp::TextDocumentDidChangeNotification holding @p edits for the document
+    /// @p uri.
+    void Change(const std::string& uri, std::vector<Edit> edits) {
+        lsp::TextDocumentDidChangeNotification notification{};
+        notification.text_document.uri = uri;
+        notification.text_document.version = ++version_;
+        for (auto& edit : edits) {
+            lsp::TextDocumentContentChangePartial change{};
+            change.range = edit.range;
+            change.text = edit.text;
+            notification.content_changes.push_back(change);
+        }
+        EXPECT_EQ(client_session_.Send(notification), langsvr::Success);
+    }
+
+    /// @returns the names of the symbols of the document @p uri
+    std::vector<std::string> Symbols(const std::string& uri) {
+        lsp::TextDocumentDocumentSymbolRequest req{};
+        req.text_document.uri = uri;
+        auto future = client_session_.Send(req);
+        EXPECT_EQ(future, langsvr::Success);
+        auto res = future->get();
+        std::vector<std::string> names;
+        if (auto* symbols = res.Get<std::vector<lsp::DocumentSymbol>>()) {
+            for (auto& symbol : *symbols) {
+                names.push_back(symbol.name);
+            }
+        }
+        return names;
+    }
+
+  private:
+    int64_t version_ = 0;
+};
+
+TEST_F(LsDocumentTest, ChangesAreParsedByProcessPendingChanges) {
+    auto uri = OpenDocument("const a = 1;");
+    ASSERT_EQ(diagnostics_.Length(), 1u);
+    EXPECT_TRUE(diagnostics_[0].diagnostics.empty());
+
+    Change(uri, {{{{0, 10}, {0, 11}}, "x"}});
+    Change(uri, {{{{0, 10}, {0, 11}}, "y"}});
+
+    // The document is not parsed until the pending changes are processed.
+    EXPECT_EQ(diagnostics_.Length(), 1u);
+
+    ASSERT_EQ(server_.ProcessPendingChanges(), langsvr::Success);
+    ASSERT_EQ(diagnostics_.Length(), 2u);
+    EXPECT_EQ(diagnostics_[1].uri, uri);
+    ASSERT_EQ(diagnostics_[1].diagnostics.size(), 1u);
+    EXPECT_THAT(diagnostics_[1].diagnostics[0].message, testing::HasSubstr("'y'"));
+
+    // There is nothing left to parse.
+    ASSERT_EQ(server_.ProcessPendingChanges(), langsvr::Success);
+    EXPECT_EQ(diagnostics_.Length(), 2u);
+}
+
+TEST_F(LsDocumentTest, RequestParsesPendingChanges) {
+    auto uri = OpenDocument("fn a() {}\n");
+    Change(uri, {{{{1, 0}, {1, 0}}, "fn b() {}\n"}});
+    EXPECT_EQ(diagnostics_.Length(), 1u);
+
+    EXPECT_THAT(Symbols(uri), testing::ElementsAre("a", "b"));
+    EXPECT_EQ(diagnostics_.Length(), 2u);
+}
+
+TEST_F(LsDocumentTest, EditsAreAppliedInOrder) {
+    // Each edit is relative to the document produced by the edit before it.
+    auto uri = OpenDocument("const a = 1;");
+    Change(uri, {
+                    {{{0, 6}, {0, 7}}, "abc"},     // const abc = 1;
+                    {{{0, 12}, {0, 13}}, "true"},  // const abc = true;
+                    {{{0, 0}, {0, 0}}, "\n"},       // \nconst abc = true;
+                    {{{1, 6}, {1, 9}}, "d"},       // \nconst d = true;
+                });
+    EXPECT_THAT(Symbols(uri), testing::ElementsAre("d"));
+    ASSERT_EQ(diagnostics_.Length(), 2u);
+    EXPECT_TRUE(diagnostics_[1].diagnostics.empty());
+}
+
+TEST_F(LsDocumentTest, EditPositionsAreUtf16) {
+    // '𝐱' is 4 bytes in UTF-8, and 2 code units in UTF-16.
+    auto uri = OpenDocument("const 𝐱 = 1;");
+    Change(uri, {{{{0, 11}, {0, 12}}, "z"}});  // const 𝐱 = z;
+    ASSERT_EQ(server_.ProcessPendingChanges(), langsvr::Success);
+    ASSERT_EQ(diagnostics_.Length(), 2u);
+    ASSERT_EQ(diagnostics_[1].diagnostics.size(), 1u);
+    EXPECT_THAT(diagnostics_[1].diagnostics[0].message, testing::HasSubstr("'z'"));
+}
+
+TEST_F(LsDocumentTest, CloseDiscardsPendingChanges) {
+    auto uri = OpenDocument("const a = 1;");
+    Change(uri, {{{{0, 10}, {0, 11}}, "x"}});
+
+    lsp::TextDocumentDidCloseNotification close{};
+    close.text_document.uri = uri;
+    ASSERT_EQ(client_session_.Send(close), langsvr::Success);
+
+    ASSERT_EQ(server_.ProcessPendingChanges(), langsvr::Success);
+    EXPECT_EQ(diagnostics_.Length(), 1u);
+}
+
+}  // namespace
+}  // namespace tint::wgsl::ls
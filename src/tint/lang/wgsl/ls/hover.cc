@@ -182,7 +182,7 @@ void Constant(const core::constant::Value* val, std::vector<lsp::MarkedString>&
 
 typename lsp::TextDocumentHoverRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentHoverRequest& r) {
-    auto file = files_.Get(r.text_document.uri);
+    auto file = GetFile(r.text_document.uri);
     if (!file) {
         return lsp::Null{};
     }
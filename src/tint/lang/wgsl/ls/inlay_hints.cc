@@ -41,7 +41,7 @@ namespace tint::wgsl::ls {
 
 typename lsp::TextDocumentInlayHintRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentInlayHintRequest& r) {
-    auto file = files_.Get(r.text_document.uri);
+    auto file = GetFile(r.text_document.uri);
     if (!file) {
         return lsp::Null{};
     }
@@ -46,7 +46,7 @@ typename lsp::TextDocumentPrepareRenameRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentPrepareRenameRequest& r) {
     typename lsp::TextDocumentPrepareRenameRequest::SuccessType result = lsp::Null{};
 
-    auto file = files_.Get(r.text_document.uri);
+    auto file = GetFile(r.text_document.uri);
     if (!file) {
         return lsp::Null{};
     }
@@ -64,7 +64,7 @@ Server::Handle(const lsp::TextDocumentPrepareRenameRequest& r) {
 
 typename lsp::TextDocumentRenameRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentRenameRequest& r) {
-    auto file = files_.Get(r.text_document.uri);
+    auto file = GetFile(r.text_document.uri);
     if (!file) {
         return lsp::Null{};
     }
@@ -125,7 +125,7 @@ typename lsp::TextDocumentSemanticTokensFullRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentSemanticTokensFullRequest& r) {
     typename lsp::TextDocumentSemanticTokensFullRequest::SuccessType result;
 
-    if (auto file = files_.Get(r.text_document.uri)) {
+    if (auto file = GetFile(r.text_document.uri)) {
         lsp::SemanticTokens out;
         // https://microsoft.github.io/language-server-protocol/specifications/lsp/3.17/specification/#textDocument_semanticTokens
         Token last;
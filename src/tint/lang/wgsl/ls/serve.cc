@@ -28,13 +28,23 @@
 #include "src/tint/lang/wgsl/ls/serve.h"
 
 #include <stdio.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <utility>
 
 #include "langsvr/content_stream.h"
+#include "langsvr/json/builder.h"
+#include "langsvr/json/value.h"
 #include "langsvr/lsp/lsp.h"
 #include "langsvr/session.h"
 
 #include "src/tint/lang/wgsl/ls/server.h"
+#include "src/tint/utils/containers/hashset.h"
 #include "src/tint/utils/macros/compiler.h"
 #include "src/tint/utils/macros/defer.h"
 
@@ -64,6 +74,62 @@ namespace tint::wgsl::ls {
 
 namespace {
 
+/// The LSP error code of a response to a request that was cancelled by the client.
+constexpr int64_t kRequestCancelled = -32800;
+
+/// Message is a message read from the client, with the fields the loop in Serve() needs to know
+/// before the message is handled by the session.
+struct Message {
+    /// The JSON of the message
+    std::string json;
+    /// The ID of the message, if it is a request
+    std::optional<langsvr::json::I64> request_id;
+    /// The ID of the cancelled request, if the message is a $/cancelRequest notification
+    std::optional<langsvr::json::I64> cancelled_id;
+    /// True if the message is the exit notification, after which the client sends nothing else
+    bool is_exit = false;
+};
+
+/// @returns the Message for the JSON @p json. Only the fields of the message are looked at: if
+/// the JSON is malformed, the error is reported when the session handles the message.
+Message ParseMessage(std::string json) {
+    Message msg;
+    auto builder = langsvr::json::Builder::Create();
+    if (auto object = builder->Parse(json); object == langsvr::Success) {
+        auto method = object.Get()->Get<langsvr::json::String>("method");
+        if (method == langsvr::Success) {
+            if (auto id = object.Get()->Get<langsvr::json::I64>("id"); id == langsvr::Success) {
+                msg.request_id = id.Get();
+            }
+            if (method.Get() == "$/cancelRequest") {
+                if (auto params = object.Get()->Get("params"); params == langsvr::Success) {
+                    auto id = params.Get()->Get<langsvr::json::I64>("id");
+                    if (id == langsvr::Success) {
+                        msg.cancelled_id = id.Get();
+                    }
+                }
+            }
+            msg.is_exit = method.Get() == "exit";
+        }
+    }
+    msg.json = std::move(json);
+    return msg;
+}
+
+/// MessageQueue holds the messages read from the client that have not been handled yet.
+struct MessageQueue {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Message> messages;
+    /// The IDs of the requests that the client cancelled before they were handled.
+    Hashset<langsvr::json::I64, 8> cancelled;
+    /// True once the reader has read the exit notification, reached the end of the stream, or
+    /// failed.
+    bool closed = false;
+    /// The reason the reader failed, if it did.
+    std::string error;
+};
+
 #if LOG_TO_FILE
 FILE* log = nullptr;
 void TintInternalCompilerErrorReporter(const tint::InternalCompilerError& err) {
@@ -77,7 +143,7 @@ void TintInternalCompilerErrorReporter(const tint::InternalCompilerError& err) {
 
 }  // namespace
 
-Result<SuccessType> Serve(langsvr::Reader& reader, langsvr::Writer& writer) {
+Result<SuccessType> Serve(std::unique_ptr<langsvr::Reader> reader, langsvr::Writer& writer) {
 #if LOG_TO_FILE
     log = fopen("log.txt", "wb");
     TINT_DEFER(fclose(log));
@@ -99,23 +165,110 @@ Result<SuccessType> Serve(langsvr::Reader& reader, langsvr::Writer& writer) {
 
     LOG("Running...");
 
+    // Messages are read on a separate thread, so that the loop below knows when it has caught up
+    // with the client. Document changes are only parsed once there are no more messages waiting,
+    // so a burst of edits is parsed once instead of once per edit. Reading ahead also lets the
+    // loop skip the requests that the client cancelled while they were waiting.
+    // The thread stops once it has read the exit notification, which the client sends after the
+    // response to the shutdown request. The thread owns the reader and shares the queue, and
+    // touches nothing else, as it is detached if the loop below fails.
+    auto queue = std::make_shared<MessageQueue>();
+    std::thread reader_thread([queue, reader = std::move(reader)] {
+        while (true) {
+            auto content = langsvr::ReadContent(*reader);
+            if (content != langsvr::Success) {
+                std::lock_guard<std::mutex> lock(queue->mutex);
+                queue->error = content.Failure().reason;
+                queue->closed = true;
+                queue->cv.notify_one();
+                return;
+            }
+            Message msg = ParseMessage(std::move(content.Get()));
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            if (msg.cancelled_id) {
+                queue->cancelled.Add(*msg.cancelled_id);
+            }
+            bool is_exit = msg.is_exit;
+            queue->messages.push_back(std::move(msg));
+            if (is_exit) {
+                queue->closed = true;
+            }
+            queue->cv.notify_one();
+            if (is_exit) {
+                return;
+            }
+        }
+    });
+
+    bool failed = false;
     while (!server.ShuttingDown()) {
-        auto msg = langsvr::ReadContent(reader);
-        if (msg != langsvr::Success) {
-            LOG("ERROR: %s", msg.Failure().reason.c_str());
-            break;
+        Message msg;
+        bool cancelled = false;
+        {
+            std::unique_lock<std::mutex> lock(queue->mutex);
+            if (queue->messages.empty() && !queue->closed) {
+                lock.unlock();
+                if (auto res = server.ProcessPendingChanges(); res != langsvr::Success) {
+                    LOG("ERROR: %s", res.Failure().reason.c_str());
+                    failed = true;
+                    break;
+                }
+                lock.lock();
+            }
+            queue->cv.wait(lock, [&] { return !queue->messages.empty() || queue->closed; });
+            if (queue->messages.empty()) {
+                LOG("ERROR: %s", queue->error.c_str());
+                failed = true;
+                break;
+            }
+            msg = std::move(queue->messages.front());
+            queue->messages.pop_front();
+
+            // A cancellation always follows the request it cancels, so once it is dequeued the
+            // request was either skipped or already answered.
+            if (msg.request_id) {
+                cancelled = queue->cancelled.Contains(*msg.request_id);
+            } else if (msg.cancelled_id) {
+                queue->cancelled.Remove(*msg.cancelled_id);
+            }
         }
-        LOG(">> %s", msg.Get().c_str());
+        LOG(">> %s", msg.json.c_str());
 
-        auto res = session.Receive(msg.Get());
+        if (cancelled) {
+            // Skip the request, and any parse of the documents it needs.
+            auto res = langsvr::WriteContent(
+                writer, R"({"jsonrpc":"2.0","id":)" + std::to_string(*msg.request_id) +
+                            R"(,"error":{"code":)" + std::to_string(kRequestCancelled) +
+                            R"(,"message":"request cancelled"}})");
+            if (res != langsvr::Success) {
+                LOG("ERROR: %s", res.Failure().reason.c_str());
+                failed = true;
+                break;
+            }
+            continue;
+        }
+
+        auto res = session.Receive(msg.json);
         if (res != langsvr::Success) {
             LOG("ERROR: %s", res.Failure().reason.c_str());
+            failed = true;
             break;
         }
 
         LOG("----------------");
     }
 
+    // After a shutdown, the reader thread stops once it has read the exit notification, so it can
+    // be joined. If the loop failed, the thread may be blocked in ReadContent() waiting for input
+    // that never arrives, and langsvr::Reader provides no way to interrupt the read, so the
+    // thread is detached instead. It owns the reader, so it never reads from an object destroyed
+    // by the caller.
+    if (failed) {
+        reader_thread.detach();
+    } else {
+        reader_thread.join();
+    }
+
     LOG("Shutting down");
     return Success;
 }
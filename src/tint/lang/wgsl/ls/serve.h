@@ -28,6 +28,8 @@
 #ifndef SRC_TINT_LANG_WGSL_LS_SERVE_H_
 #define SRC_TINT_LANG_WGSL_LS_SERVE_H_
 
+#include <memory>
+
 #include "langsvr/reader.h"
 #include "langsvr/writer.h"
 #include "src/tint/utils/result/result.h"
@@ -36,7 +38,9 @@ namespace tint::wgsl::ls {
 
 /// Serve creates a WGSL language server that reads from @p reader and writes to @p writer.
 /// Blocks until the server is shutdown by the client.
-Result<SuccessType> Serve(langsvr::Reader& reader, langsvr::Writer& writer);
+/// @p reader is read on a separate thread that owns it. If the server shuts down before the end of
+/// the stream, the thread keeps running until the read blocked on the client returns.
+Result<SuccessType> Serve(std::unique_ptr<langsvr::Reader> reader, langsvr::Writer& writer);
 
 }  // namespace tint::wgsl::ls
 
@@ -28,8 +28,10 @@
 #ifndef SRC_TINT_LANG_WGSL_LS_SERVER_H_
 #define SRC_TINT_LANG_WGSL_LS_SERVER_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "langsvr/lsp/lsp.h"
@@ -54,6 +56,16 @@ class Server {
     /// @returns true if the server has been requested to shut down.
     bool ShuttingDown() const { return shutting_down_; }
 
+    /// Parses the documents that have changed since they were last parsed, and publishes their
+    /// diagnostics.
+    /// Changes to a document are applied to its text as they arrive, but the document is not
+    /// parsed again until this is called, or a request needs the document. This lets a burst of
+    /// edits be parsed once, instead of once per edit. Serve() calls this whenever it has no more
+    /// messages waiting to be handled.
+    /// The whole document is parsed and resolved again: no tokens or AST nodes are reused from
+    /// the previous parse.
+    langsvr::Result<langsvr::SuccessType> ProcessPendingChanges();
+
   private:
     ////////////////////////////////////////////////////////////////////////////
     // Requests
@@ -135,6 +147,17 @@ class Server {
     langsvr::Result<langsvr::SuccessType>  //
     Handle(const langsvr::lsp::WorkspaceDidChangeWatchedFilesNotification&);
 
+    /// @returns the File for the document with the URI @p uri, or null if the document is not
+    /// open. If the document has changes that have not been parsed yet, then the document is
+    /// parsed and its diagnostics are published before returning.
+    GetResult<std::shared_ptr<File>> GetFile(const std::string& uri);
+
+    /// Parses @p text as the document with the URI @p uri, replaces the document's File with the
+    /// result, and publishes the new diagnostics.
+    langsvr::Result<langsvr::SuccessType> Parse(const std::string& uri,
+                                                std::string_view text,
+                                                int64_t version);
+
     /// Publishes the tint::Program diagnostics to the server via a
     /// TextDocumentPublishDiagnosticsNotification.
     langsvr::Result<langsvr::SuccessType>  //
@@ -166,8 +189,18 @@ class Server {
 
     /// The LSP session.
     langsvr::Session& session_;
+    /// A document change that has not been parsed yet.
+    struct PendingChange {
+        /// The new text of the document
+        std::string text;
+        /// The new version of the document
+        int64_t version = 0;
+    };
+
     /// Map of URI to File.
     Hashmap<std::string, std::shared_ptr<File>, 8> files_;
+    /// Map of URI to the changes of the document that have not been parsed yet.
+    Hashmap<std::string, PendingChange, 8> pending_changes_;
     /// True if the server has been asked to shutdown.
     bool shutting_down_ = false;
 };
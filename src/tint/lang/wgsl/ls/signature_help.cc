@@ -171,7 +171,7 @@ void PrintOverload(std::string& name,
 
 typename lsp::TextDocumentSignatureHelpRequest::ResultType  //
 Server::Handle(const lsp::TextDocumentSignatureHelpRequest& r) {
-    auto file = files_.Get(r.text_document.uri);
+    auto file = GetFile(r.text_document.uri);
     if (!file) {
         return lsp::Null{};
     }
@@ -44,7 +44,7 @@ Server::Handle(const lsp::TextDocumentDocumentSymbolRequest& r) {
     typename lsp::TextDocumentDocumentSymbolRequest::SuccessType result = lsp::Null{};
 
     std::vector<lsp::DocumentSymbol> symbols;
-    if (auto file = files_.Get(r.text_document.uri)) {
+    if (auto file = GetFile(r.text_document.uri)) {
         for (auto* decl : (*file)->program.AST().Functions()) {
             lsp::DocumentSymbol sym;
             sym.range = (*file)->Conv(decl->source.range);
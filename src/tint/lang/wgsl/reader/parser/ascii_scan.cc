@@ -0,0 +1,236 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/wgsl/reader/parser/ascii_scan.h"
+
+#include <cstdint>
+
+#include "src/tint/utils/macros/compiler.h"
+
+#if defined(__AVX2__)
+#define TINT_WGSL_SCAN_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TINT_WGSL_SCAN_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define TINT_WGSL_SCAN_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if TINT_BUILD_IS_MSVC
+#include <intrin.h>
+#endif
+
+namespace tint::wgsl::reader {
+namespace {
+
+/// @returns the number of trailing zero bits in @p bits, which must be non-zero
+[[maybe_unused]] inline uint32_t CountTrailingZeros(uint64_t bits) {
+#if TINT_BUILD_IS_MSVC && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index = 0;
+    _BitScanForward64(&index, bits);
+    return static_cast<uint32_t>(index);
+#elif TINT_BUILD_IS_MSVC
+    uint32_t count = 0;
+    for (; (bits & 1) == 0; bits >>= 1) {
+        count++;
+    }
+    return count;
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(bits));
+#endif
+}
+
+// The vector instruction sets below all expose the same set of operations on a register of
+// kWidth bytes. Comparisons produce 0xff in lanes that match and 0x00 in lanes that don't.
+// StopMask() returns a bit mask with kBitsPerLane bits set for each lane that is zero in its
+// argument, so the index of the first such lane is CountTrailingZeros(mask) / kBitsPerLane.
+//
+// InRange() only needs to handle ASCII bounds, and must never match a byte with the high bit set.
+
+#if TINT_WGSL_SCAN_AVX2
+struct AVX2 {
+    using Reg = __m256i;
+    static constexpr size_t kWidth = 32;
+    static constexpr uint32_t kBitsPerLane = 1;
+
+    static Reg Load(const char* ptr) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    }
+    static Reg Splat(char c) { return _mm256_set1_epi8(c); }
+    static Reg Eq(Reg v, char c) { return _mm256_cmpeq_epi8(v, Splat(c)); }
+    static Reg Or(Reg a, Reg b) { return _mm256_or_si256(a, b); }
+    static Reg Not(Reg v) { return _mm256_xor_si256(v, _mm256_cmpeq_epi8(v, v)); }
+    static Reg InRange(Reg v, char lo, char hi) {
+        // Signed comparisons, so bytes >= 0x80 compare as negative and are never in range.
+        return _mm256_and_si256(_mm256_cmpgt_epi8(v, Splat(static_cast<char>(lo - 1))),
+                                _mm256_cmpgt_epi8(Splat(static_cast<char>(hi + 1)), v));
+    }
+    static uint64_t StopMask(Reg v) {
+        return ~static_cast<uint32_t>(_mm256_movemask_epi8(v));
+    }
+};
+#endif  // TINT_WGSL_SCAN_AVX2
+
+#if TINT_WGSL_SCAN_SSE2
+struct SSE2 {
+    using Reg = __m128i;
+    static constexpr size_t kWidth = 16;
+    static constexpr uint32_t kBitsPerLane = 1;
+
+    static Reg Load(const char* ptr) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+    }
+    static Reg Splat(char c) { return _mm_set1_epi8(c); }
+    static Reg Eq(Reg v, char c) { return _mm_cmpeq_epi8(v, Splat(c)); }
+    static Reg Or(Reg a, Reg b) { return _mm_or_si128(a, b); }
+    static Reg Not(Reg v) { return _mm_xor_si128(v, _mm_cmpeq_epi8(v, v)); }
+    static Reg InRange(Reg v, char lo, char hi) {
+        // Signed comparisons, so bytes >= 0x80 compare as negative and are never in range.
+        return _mm_and_si128(_mm_cmpgt_epi8(v, Splat(static_cast<char>(lo - 1))),
+                             _mm_cmplt_epi8(v, Splat(static_cast<char>(hi + 1))));
+    }
+    static uint64_t StopMask(Reg v) {
+        return ~static_cast<uint32_t>(_mm_movemask_epi8(v)) & 0xffffu;
+    }
+};
+#endif  // TINT_WGSL_SCAN_SSE2
+
+#if TINT_WGSL_SCAN_NEON
+struct NEON {
+    using Reg = uint8x16_t;
+    static constexpr size_t kWidth = 16;
+    static constexpr uint32_t kBitsPerLane = 4;
+
+    static Reg Load(const char* ptr) { return vld1q_u8(reinterpret_cast<const uint8_t*>(ptr)); }
+    static Reg Splat(char c) { return vdupq_n_u8(static_cast<uint8_t>(c)); }
+    static Reg Eq(Reg v, char c) { return vceqq_u8(v, Splat(c)); }
+    static Reg Or(Reg a, Reg b) { return vorrq_u8(a, b); }
+    static Reg Not(Reg v) { return vmvnq_u8(v); }
+    static Reg InRange(Reg v, char lo, char hi) {
+        return vandq_u8(vcgeq_u8(v, Splat(lo)), vcleq_u8(v, Splat(hi)));
+    }
+    static uint64_t StopMask(Reg v) {
+        // NEON has no movemask. Narrowing each 16-bit pair by 4 bits packs every lane into a
+        // nibble of a 64-bit value.
+        uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(v), 4);
+        return ~vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+    }
+};
+#endif  // TINT_WGSL_SCAN_NEON
+
+/// Matches ASCII blankspace
+struct Blankspace {
+    static bool Match(uint8_t c) { return c == ' ' || c == '\t'; }
+    template <typename ISA>
+    static typename ISA::Reg Match(typename ISA::Reg v) {
+        return ISA::Or(ISA::Eq(v, ' '), ISA::Eq(v, '\t'));
+    }
+};
+
+/// Matches ASCII identifier characters
+struct Identifier {
+    static bool Match(uint8_t c) {
+        uint8_t lower = c | 0x20;
+        return (lower >= 'a' && lower <= 'z') || (c >= '0' && c <= '9') || c == '_';
+    }
+    template <typename ISA>
+    static typename ISA::Reg Match(typename ISA::Reg v) {
+        auto lower = ISA::Or(v, ISA::Splat(0x20));
+        return ISA::Or(ISA::Or(ISA::InRange(lower, 'a', 'z'), ISA::InRange(v, '0', '9')),
+                       ISA::Eq(v, '_'));
+    }
+};
+
+/// Matches everything but the bytes that are significant inside a block comment
+struct BlockCommentBody {
+    static bool Match(uint8_t c) { return c != '/' && c != '*' && c != '\0'; }
+    template <typename ISA>
+    static typename ISA::Reg Match(typename ISA::Reg v) {
+        return ISA::Not(ISA::Or(ISA::Or(ISA::Eq(v, '/'), ISA::Eq(v, '*')), ISA::Eq(v, '\0')));
+    }
+};
+
+/// Advances @p i over whole ISA::kWidth byte blocks of @p data that only contain bytes matched by
+/// CLASS.
+/// @returns true if a byte not matched by CLASS was found, in which case @p i is its offset.
+template <typename ISA, typename CLASS>
+[[maybe_unused]] bool ScanBlocks(const char* data, size_t size, size_t& i) {
+    for (; i + ISA::kWidth <= size; i += ISA::kWidth) {
+        if (uint64_t stop = ISA::StopMask(CLASS::template Match<ISA>(ISA::Load(data + i)))) {
+            i += CountTrailingZeros(stop) / ISA::kBitsPerLane;
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @returns the offset of the first byte at or after @p offset that is not matched by CLASS
+template <typename CLASS>
+size_t Scan(std::string_view str, size_t offset) {
+    const char* data = str.data();
+    size_t size = str.size();
+    size_t i = offset;
+#if TINT_WGSL_SCAN_AVX2
+    if (ScanBlocks<AVX2, CLASS>(data, size, i)) {
+        return i;
+    }
+#endif
+#if TINT_WGSL_SCAN_SSE2
+    if (ScanBlocks<SSE2, CLASS>(data, size, i)) {
+        return i;
+    }
+#elif TINT_WGSL_SCAN_NEON
+    if (ScanBlocks<NEON, CLASS>(data, size, i)) {
+        return i;
+    }
+#endif
+    while (i < size && CLASS::Match(static_cast<uint8_t>(data[i]))) {
+        i++;
+    }
+    return i;
+}
+
+}  // namespace
+
+size_t SkipAsciiBlankspace(std::string_view str, size_t offset) {
+    return Scan<Blankspace>(str, offset);
+}
+
+size_t SkipAsciiIdentifier(std::string_view str, size_t offset) {
+    return Scan<Identifier>(str, offset);
+}
+
+size_t FindBlockCommentDelimiter(std::string_view str, size_t offset) {
+    return Scan<BlockCommentBody>(str, offset);
+}
+
+}  // namespace tint::wgsl::reader
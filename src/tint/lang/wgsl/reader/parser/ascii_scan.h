@@ -0,0 +1,63 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_TINT_LANG_WGSL_READER_PARSER_ASCII_SCAN_H_
+#define SRC_TINT_LANG_WGSL_READER_PARSER_ASCII_SCAN_H_
+
+#include <cstddef>
+#include <string_view>
+
+// The functions in this file are the Lexer's ASCII fast paths. Each one scans a run of bytes that
+// the Lexer would otherwise consume one code point at a time, classifying 16 or 32 bytes per step
+// with SSE2, AVX2 or NEON where the target supports them, and one byte at a time otherwise.
+// Non-ASCII bytes always stop a scan, so that the Lexer can fall back to UTF-8 decoding.
+
+namespace tint::wgsl::reader {
+
+/// @param str the string to scan
+/// @param offset the byte offset to start scanning from
+/// @returns the offset of the first byte at or after @p offset that is not an ASCII space or
+/// horizontal tab, or `str.size()` if there is no such byte.
+size_t SkipAsciiBlankspace(std::string_view str, size_t offset);
+
+/// @param str the string to scan
+/// @param offset the byte offset to start scanning from
+/// @returns the offset of the first byte at or after @p offset that is not an ASCII identifier
+/// character (`[a-zA-Z0-9_]`), or `str.size()` if there is no such byte.
+size_t SkipAsciiIdentifier(std::string_view str, size_t offset);
+
+/// @param str the string to scan
+/// @param offset the byte offset to start scanning from
+/// @returns the offset of the first '/', '*' or null byte at or after @p offset, or `str.size()`
+/// if there is no such byte. These are the only bytes that can end or nest a block comment, or
+/// make it invalid.
+size_t FindBlockCommentDelimiter(std::string_view str, size_t offset);
+
+}  // namespace tint::wgsl::reader
+
+#endif  // SRC_TINT_LANG_WGSL_READER_PARSER_ASCII_SCAN_H_
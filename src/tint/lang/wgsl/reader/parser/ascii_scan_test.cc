@@ -0,0 +1,109 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/lang/wgsl/reader/parser/ascii_scan.h"
+
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace tint::wgsl::reader {
+namespace {
+
+// Byte-at-a-time reference implementations of the scanners.
+bool IsBlankspace(uint8_t c) {
+    return c == ' ' || c == '\t';
+}
+bool IsIdentifier(uint8_t c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+bool IsNotBlockCommentDelimiter(uint8_t c) {
+    return c != '/' && c != '*' && c != '\0';
+}
+
+template <typename PRED>
+size_t Reference(std::string_view str, size_t offset, PRED&& pred) {
+    while (offset < str.size() && pred(static_cast<uint8_t>(str[offset]))) {
+        offset++;
+    }
+    return offset;
+}
+
+// Places each byte value at each position of a run of bytes matched by the scanner, at each
+// starting offset, and checks the scanner against the reference. The run lengths cover the
+// scalar tail and the 16 and 32 byte vector paths.
+template <typename SCAN, typename PRED>
+void CheckAllBytes(char fill, SCAN&& scan, PRED&& pred) {
+    for (size_t length : {1u, 15u, 16u, 17u, 31u, 32u, 33u, 64u, 80u}) {
+        for (size_t stop = 0; stop < length; stop++) {
+            for (uint32_t byte = 0; byte < 256; byte++) {
+                std::string str(length, fill);
+                str[stop] = static_cast<char>(byte);
+                for (size_t offset : {size_t{0}, size_t{1}, stop, length - 1}) {
+                    ASSERT_EQ(scan(str, offset), Reference(str, offset, pred))
+                        << "length: " << length << " stop: " << stop << " byte: " << byte
+                        << " offset: " << offset;
+                }
+            }
+        }
+    }
+}
+
+TEST(AsciiScanTest, SkipAsciiBlankspace) {
+    CheckAllBytes(' ', SkipAsciiBlankspace, IsBlankspace);
+    CheckAllBytes('\t', SkipAsciiBlankspace, IsBlankspace);
+}
+
+TEST(AsciiScanTest, SkipAsciiIdentifier) {
+    CheckAllBytes('a', SkipAsciiIdentifier, IsIdentifier);
+    CheckAllBytes('Z', SkipAsciiIdentifier, IsIdentifier);
+    CheckAllBytes('_', SkipAsciiIdentifier, IsIdentifier);
+    CheckAllBytes('9', SkipAsciiIdentifier, IsIdentifier);
+}
+
+TEST(AsciiScanTest, FindBlockCommentDelimiter) {
+    CheckAllBytes('x', FindBlockCommentDelimiter, IsNotBlockCommentDelimiter);
+    CheckAllBytes('\x80', FindBlockCommentDelimiter, IsNotBlockCommentDelimiter);
+}
+
+TEST(AsciiScanTest, Empty) {
+    EXPECT_EQ(SkipAsciiBlankspace("", 0), 0u);
+    EXPECT_EQ(SkipAsciiIdentifier("", 0), 0u);
+    EXPECT_EQ(FindBlockCommentDelimiter("", 0), 0u);
+}
+
+TEST(AsciiScanTest, OffsetAtEnd) {
+    std::string str(40, ' ');
+    EXPECT_EQ(SkipAsciiBlankspace(str, 40), 40u);
+    EXPECT_EQ(SkipAsciiIdentifier(str, 40), 40u);
+    EXPECT_EQ(FindBlockCommentDelimiter(str, 40), 40u);
+}
+
+}  // namespace
+}  // namespace tint::wgsl::reader
@@ -39,6 +39,7 @@
 
 #include "src/tint/lang/core/fluent_types.h"
 #include "src/tint/lang/core/number.h"
+#include "src/tint/lang/wgsl/reader/parser/ascii_scan.h"
 #include "src/tint/utils/ice/ice.h"
 #include "src/tint/utils/strconv/parse_num.h"
 #include "src/tint/utils/text/unicode.h"
@@ -265,6 +266,15 @@ std::optional<Token> Lexer::skip_blankspace_and_comments() {
                 continue;
             }
 
+            // Skip runs of ASCII blankspace without decoding each code point.
+            set_pos(static_cast<uint32_t>(SkipAsciiBlankspace(line(), pos())));
+            if (is_eol()) {
+                continue;
+            }
+            if (static_cast<uint8_t>(at(pos())) < 0x80) {
+                break;  // ASCII, but not blankspace.
+            }
+
             bool is_blankspace;
             uint32_t blankspace_size;
             if (!read_blankspace(line(), pos(), &is_blankspace, &blankspace_size)) {
@@ -298,12 +308,11 @@ std::optional<Token> Lexer::skip_blankspace_and_comments() {
 std::optional<Token> Lexer::skip_comment() {
     if (matches(pos(), "//")) {
         // Line comment: ignore everything until the end of line.
-        while (!is_eol()) {
-            if (is_null()) {
-                return Token{Token::Type::kError, begin_source(), "null character found"};
-            }
-            advance();
+        if (auto null_pos = line().find('\0', pos()); null_pos != std::string_view::npos) {
+            set_pos(static_cast<uint32_t>(null_pos));
+            return Token{Token::Type::kError, begin_source(), "null character found"};
         }
+        set_pos(length());
         return {};
     }
 
@@ -332,8 +341,9 @@ std::optional<Token> Lexer::skip_comment() {
             } else if (is_null()) {
                 return Token{Token::Type::kError, begin_source(), "null character found"};
             } else {
-                // Anything else: skip and update source location.
+                // Anything else: skip up to the next byte that could end the comment.
                 advance();
+                set_pos(static_cast<uint32_t>(FindBlockCommentDelimiter(line(), pos())));
             }
         }
         if (depth > 0) {
@@ -984,7 +994,13 @@ std::optional<Token> Lexer::try_ident() {
     auto start = pos();
 
     // Must begin with an XID_Source unicode character, or underscore
-    {
+    if (auto c = static_cast<uint8_t>(at(pos())); c < 0x80) {
+        // ASCII fast path
+        if (c != '_' && !(c >= 'a' && c <= 'z') && !(c >= 'A' && c <= 'Z')) {
+            return {};
+        }
+        advance();
+    } else {
         auto* utf8 = reinterpret_cast<const uint8_t*>(&at(pos()));
         auto [code_point, n] = tint::utf8::Decode(utf8, length() - pos());
         if (n == 0) {
@@ -999,6 +1015,12 @@ std::optional<Token> Lexer::try_ident() {
     }
 
     while (!is_eol()) {
+        // Consume ASCII identifier characters without decoding each code point.
+        set_pos(static_cast<uint32_t>(SkipAsciiIdentifier(line(), pos())));
+        if (is_eol() || static_cast<uint8_t>(at(pos())) < 0x80) {
+            break;
+        }
+
         // Must continue with an XID_Continue unicode character
         auto* utf8 = reinterpret_cast<const uint8_t*>(&at(pos()));
         auto [code_point, n] = tint::utf8::Decode(utf8, line().size() - pos());
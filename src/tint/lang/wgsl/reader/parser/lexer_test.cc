@@ -399,6 +399,81 @@ TEST_F(LexerTest, Null_InIdentifier_IsError) {
     }
 }
 
+// The tests below use runs of characters long enough to be consumed by the vectorized scanners
+// in ascii_scan.h, with the interesting character at an offset that is not a multiple of the
+// vector width.
+
+TEST_F(LexerTest, Skips_Blankspace_LongRun) {
+    Source::File file("", std::string(37, ' ') + "\t" + std::string(20, ' ') + kL2R "  ident");
+    Lexer l(&file);
+
+    auto list = l.Lex();
+    ASSERT_EQ(2u, list.size());
+
+    auto& t = list[0];
+    EXPECT_TRUE(t.IsIdentifier());
+    EXPECT_EQ(t.source().range.begin.column, 64u);
+    EXPECT_EQ(t.to_str(), "ident");
+}
+
+TEST_F(LexerTest, Skips_Comments_Block_LongRun) {
+    Source::File file("", "/*" + std::string(45, 'x') + "/*" + std::string(33, '*') + "*/ " +
+                              std::string(19, '/') + " */ident");
+    Lexer l(&file);
+
+    auto list = l.Lex();
+    ASSERT_EQ(2u, list.size());
+
+    auto& t = list[0];
+    EXPECT_TRUE(t.IsIdentifier());
+    EXPECT_EQ(t.source().range.begin.column, 108u);
+    EXPECT_EQ(t.to_str(), "ident");
+}
+
+TEST_F(LexerTest, Null_InLongLineComment_IsError) {
+    Source::File file("", "//" + std::string(50, 'x') + std::string(1, '\0') + "x");
+    Lexer l(&file);
+
+    auto list = l.Lex();
+    ASSERT_EQ(1u, list.size());
+
+    auto& t = list[0];
+    EXPECT_TRUE(t.IsError());
+    EXPECT_EQ(t.source().range.begin.column, 53u);
+    EXPECT_EQ(t.to_str(), "null character found");
+}
+
+TEST_F(LexerTest, Null_InLongBlockComment_IsError) {
+    Source::File file("", "/*" + std::string(50, 'x') + std::string(1, '\0') + "*/");
+    Lexer l(&file);
+
+    auto list = l.Lex();
+    ASSERT_EQ(1u, list.size());
+
+    auto& t = list[0];
+    EXPECT_TRUE(t.IsError());
+    EXPECT_EQ(t.source().range.begin.column, 53u);
+    EXPECT_EQ(t.to_str(), "null character found");
+}
+
+TEST_F(LexerTest, IdentifierTest_LongRun) {
+    std::string ascii = std::string(40, 'a') + "_Z9" + std::string(30, 'b');
+    std::string ident = ascii + "\xC3\xA9" + ascii;  // U+00E9 in the middle
+    Source::File file("", ident + "+" + ascii);
+    Lexer l(&file);
+
+    auto list = l.Lex();
+    ASSERT_EQ(4u, list.size());
+
+    EXPECT_TRUE(list[0].IsIdentifier());
+    EXPECT_EQ(list[0].to_str(), ident);
+    EXPECT_EQ(list[0].source().range.end.column, ident.size() + 1);
+    EXPECT_EQ(list[1].type(), Token::Type::kPlus);
+    EXPECT_TRUE(list[2].IsIdentifier());
+    EXPECT_EQ(list[2].to_str(), ascii);
+    EXPECT_TRUE(list[3].IsEof());
+}
+
 struct FloatData {
     const char* input;
     double result;
@@ -28,6 +28,7 @@
 #include <string>
 
 #include "src/tint/cmd/bench/bench.h"
+#include "src/tint/lang/wgsl/reader/parser/lexer.h"
 #include "src/tint/lang/wgsl/reader/reader.h"
 
 namespace tint::wgsl::reader {
@@ -47,7 +48,23 @@ void ParseWGSL(benchmark::State& state, std::string input_name) {
     }
 }
 
+void LexWGSL(benchmark::State& state, std::string input_name) {
+    auto res = bench::GetWgslFile(input_name);
+    if (res != Success) {
+        state.SkipWithError(res.Failure().reason.Str());
+        return;
+    }
+    for (auto _ : state) {
+        Lexer lexer(&res.Get());
+        auto tokens = lexer.Lex();
+        if (tokens.back().IsError()) {
+            state.SkipWithError(tokens.back().to_str());
+        }
+    }
+}
+
 TINT_BENCHMARK_PROGRAMS(ParseWGSL);
+TINT_BENCHMARK_PROGRAMS(LexWGSL);
 
 }  // namespace
 }  // namespace tint::wgsl::reader
@@ -134,7 +134,9 @@ constexpr size_t kMaxNestDepthOfCompositeType = 255;
 
 }  // namespace
 
-Resolver::Resolver(ProgramBuilder* builder, const wgsl::AllowedFeatures& allowed_features)
+Resolver::Resolver(ProgramBuilder* builder,
+                   const wgsl::AllowedFeatures& allowed_features,
+                   uint32_t max_threads)
     : b(*builder),
       diagnostics_(builder->Diagnostics()),
       const_eval_(builder->constants, diagnostics_),
@@ -146,7 +148,8 @@ Resolver::Resolver(ProgramBuilder* builder, const wgsl::AllowedFeatures& allowed
                  allowed_features_,
                  atomic_composite_info_,
                  valid_type_storage_layouts_),
-      allowed_features_(allowed_features) {}
+      allowed_features_(allowed_features),
+      max_threads_(max_threads) {}
 
 Resolver::~Resolver() = default;
 
@@ -183,7 +186,7 @@ bool Resolver::Resolve() {
         enabled_extensions_.Contains(wgsl::Extension::kChromiumDisableUniformityAnalysis);
     if (result && !disable_uniformity_analysis) {
         // Run the uniformity analysis, which requires a complete semantic module.
-        if (!AnalyzeUniformity(b, dependencies_)) {
+        if (!AnalyzeUniformity(b, dependencies_, max_threads_)) {
             return false;
         }
     }
@@ -100,7 +100,11 @@ class Resolver {
     /// Constructor
     /// @param builder the program builder
     /// @param allowed_features the extensions and features that are allowed to be used
-    Resolver(ProgramBuilder* builder, const wgsl::AllowedFeatures& allowed_features);
+    /// @param max_threads the maximum number of threads used by the uniformity analysis. See
+    /// AnalyzeUniformity().
+    Resolver(ProgramBuilder* builder,
+             const wgsl::AllowedFeatures& allowed_features,
+             uint32_t max_threads = 1);
 
     /// Destructor
     ~Resolver();
@@ -687,6 +691,7 @@ class Resolver {
     SemHelper sem_;
     Validator validator_;
     wgsl::AllowedFeatures allowed_features_;
+    uint32_t max_threads_ = 1;
     wgsl::Extensions enabled_extensions_;
     Vector<sem::Function*, 8> entry_points_;
     Hashmap<const core::type::Type*, const Source*, 8> atomic_composite_info_;
@@ -27,7 +27,9 @@
 
 #include "src/tint/lang/wgsl/resolver/uniformity.h"
 
+#include <algorithm>
 #include <limits>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -55,6 +57,7 @@
 #include "src/tint/utils/macros/defer.h"
 #include "src/tint/utils/memory/block_allocator.h"
 #include "src/tint/utils/rtti/switch.h"
+#include "src/tint/utils/system/parallel.h"
 #include "src/tint/utils/text/string_stream.h"
 
 // Set to `1` to dump the uniformity graph for each function in graphviz format.
@@ -355,7 +358,10 @@ class UniformityGraph {
     /// Constructor.
     /// @param builder the program to analyze
     explicit UniformityGraph(ProgramBuilder& builder)
-        : b(builder), sem_(b.Sem()), diagnostics_(builder.Diagnostics()) {}
+        : b(builder),
+          sem_(b.Sem()),
+          diagnostics_(builder.Diagnostics()),
+          functions_(own_functions_) {}
 
     /// Destructor.
     ~UniformityGraph() {}
@@ -363,22 +369,36 @@ class UniformityGraph {
     /// Build and analyze the graph to determine whether the program satisfies the uniformity
     /// constraints of WGSL.
     /// @param dependency_graph the dependency-ordered module-scope declarations
+    /// @param max_threads the maximum number of threads used to analyze functions
     /// @returns true if all uniformity constraints are satisfied, otherise false
-    bool Build(const DependencyGraph& dependency_graph) {
+    bool Build(const DependencyGraph& dependency_graph, uint32_t max_threads) {
 #if TINT_DUMP_UNIFORMITY_GRAPH
         std::cout << "digraph G {\n";
         std::cout << "rankdir=BT\n";
+
+        // The graph dump is written as each function is processed.
+        max_threads = 1;
 #endif
 
         // Process all functions in the module.
         bool success = true;
+        size_t function_count = 0;
         for (auto* decl : dependency_graph.ordered_globals) {
-            if (auto* func = decl->As<ast::Function>()) {
-                if (!ProcessFunction(func)) {
-                    success = false;
-                    break;
+            if (decl->Is<ast::Function>()) {
+                function_count++;
+            }
+        }
+        if (max_threads == 1 || function_count < kMinFunctionsForParallelUniformity) {
+            for (auto* decl : dependency_graph.ordered_globals) {
+                if (auto* func = decl->As<ast::Function>()) {
+                    if (!ProcessFunction(func, functions_.Add(func, FunctionInfo(func, b)).value)) {
+                        success = false;
+                        break;
+                    }
                 }
             }
+        } else {
+            success = ProcessFunctionsInParallel(dependency_graph, max_threads);
         }
 
 #if TINT_DUMP_UNIFORMITY_GRAPH
@@ -389,12 +409,37 @@ class UniformityGraph {
     }
 
   private:
+    /// Map of function to analyzed function results.
+    using FunctionInfoMap = Hashmap<const ast::Function*, FunctionInfo, 8>;
+
+    /// Constructor for a worker of a parallel analysis.
+    /// @param builder the program to analyze
+    /// @param diagnostics the diagnostic list for the function processed by the worker
+    /// @param functions the analyzed function results, shared by all workers
+    /// @param make_error_mutex the mutex used to serialize calls to MakeError()
+    UniformityGraph(const ProgramBuilder& builder,
+                    diag::List& diagnostics,
+                    FunctionInfoMap& functions,
+                    std::mutex& make_error_mutex)
+        : b(builder),
+          sem_(b.Sem()),
+          diagnostics_(diagnostics),
+          functions_(functions),
+          make_error_mutex_(&make_error_mutex) {}
+
     const ProgramBuilder& b;
     const sem::Info& sem_;
     diag::List& diagnostics_;
 
+    /// Storage for #functions_, unused by the workers of a parallel analysis.
+    FunctionInfoMap own_functions_;
+
     /// Map of analyzed function results.
-    Hashmap<const ast::Function*, FunctionInfo, 8> functions_;
+    FunctionInfoMap& functions_;
+
+    /// The mutex used to serialize calls to MakeError() between the workers of a parallel
+    /// analysis, or nullptr if the analysis is serial.
+    std::mutex* make_error_mutex_ = nullptr;
 
     /// The function currently being analyzed.
     FunctionInfo* current_function_;
@@ -429,11 +474,89 @@ class UniformityGraph {
         return fn->Declaration()->name->symbol.Name();
     }
 
+    /// Process the functions of the module using up to @p max_threads threads.
+    /// Each function is assigned to the wave after the latest wave of its callees, and the
+    /// functions of a wave are processed concurrently. Each function records its diagnostics to its
+    /// own list, and the lists are appended in dependency order, so the diagnostics and result are
+    /// identical to processing the functions serially.
+    /// @param dependency_graph the dependency-ordered module-scope declarations
+    /// @param max_threads the maximum number of threads to use
+    /// @returns true if there are no uniformity issues, false otherwise
+    bool ProcessFunctionsInParallel(const DependencyGraph& dependency_graph,
+                                    uint32_t max_threads) {
+        Vector<const ast::Function*, 8> funcs;
+        Hashmap<const ast::Function*, size_t, 8> func_waves;
+        Vector<Vector<size_t, 8>, 8> waves;
+        for (auto* decl : dependency_graph.ordered_globals) {
+            if (auto* func = decl->As<ast::Function>()) {
+                size_t wave = 0;
+                for (auto* call : sem_.Get(func)->DirectCalls()) {
+                    if (auto* callee = call->Target()->As<sem::Function>()) {
+                        if (auto callee_wave = func_waves.Get(callee->Declaration())) {
+                            wave = std::max(wave, *callee_wave + 1);
+                        }
+                    }
+                }
+                func_waves.Add(func, wave);
+                if (wave >= waves.Length()) {
+                    waves.Resize(wave + 1);
+                }
+                waves[wave].Push(funcs.Length());
+                funcs.Push(func);
+            }
+        }
+
+        Vector<diag::List, 8> func_diagnostics;
+        func_diagnostics.Resize(funcs.Length());
+
+        // The serial analysis stops at the first function that fails, so functions after it in
+        // dependency order do not need to be processed, and their diagnostics are dropped.
+        size_t first_failure = funcs.Length();
+        std::mutex make_error_mutex;
+        for (auto& wave : waves) {
+            Vector<size_t, 8> work;
+            for (auto index : wave) {
+                if (index < first_failure) {
+                    work.Push(index);
+                }
+            }
+
+            // Add the FunctionInfos before processing, as the workers read from functions_.
+            for (auto index : work) {
+                functions_.Add(funcs[index], FunctionInfo(funcs[index], b));
+            }
+            Vector<FunctionInfo*, 8> infos;
+            for (auto index : work) {
+                infos.Push(&*functions_.Get(funcs[index]));
+            }
+
+            Vector<bool, 8> succeeded;
+            succeeded.Resize(work.Length());
+            ParallelFor(work.Length(), max_threads, [&](size_t i) {
+                auto index = work[i];
+                UniformityGraph worker(b, func_diagnostics[index], functions_, make_error_mutex);
+                succeeded[i] = worker.ProcessFunction(funcs[index], *infos[i]);
+            });
+
+            for (size_t i = 0; i < work.Length(); i++) {
+                if (!succeeded[i]) {
+                    first_failure = std::min(first_failure, work[i]);
+                }
+            }
+        }
+
+        for (size_t i = 0; i < funcs.Length() && i <= first_failure; i++) {
+            diagnostics_.Add(func_diagnostics[i]);
+        }
+        return first_failure == funcs.Length();
+    }
+
     /// Process a function.
     /// @param func the function to process
+    /// @param info the FunctionInfo to populate for @p func
     /// @returns true if there are no uniformity issues, false otherwise
-    bool ProcessFunction(const ast::Function* func) {
-        current_function_ = &functions_.Add(func, FunctionInfo(func, b)).value;
+    bool ProcessFunction(const ast::Function* func, FunctionInfo& info) {
+        current_function_ = &info;
 
         // Process function body.
         if (func->body) {
@@ -478,6 +601,11 @@ class UniformityGraph {
             auto traverse = [&](wgsl::DiagnosticSeverity severity) {
                 Traverse(current_function_->RequiredToBeUniform(severity), &reachable);
                 if (reachable.Contains(current_function_->may_be_non_uniform)) {
+                    // MakeError() traverses the graphs of callees, which are shared by workers.
+                    std::unique_lock<std::mutex> lock;
+                    if (make_error_mutex_) {
+                        lock = std::unique_lock<std::mutex>(*make_error_mutex_);
+                    }
                     MakeError(*current_function_, current_function_->may_be_non_uniform, severity);
                     return false;
                 }
@@ -2049,9 +2177,11 @@ class UniformityGraph {
 
 }  // namespace
 
-bool AnalyzeUniformity(ProgramBuilder& builder, const DependencyGraph& dependency_graph) {
+bool AnalyzeUniformity(ProgramBuilder& builder,
+                       const DependencyGraph& dependency_graph,
+                       uint32_t max_threads) {
     UniformityGraph graph(builder);
-    return graph.Build(dependency_graph);
+    return graph.Build(dependency_graph, max_threads);
 }
 
 }  // namespace tint::resolver
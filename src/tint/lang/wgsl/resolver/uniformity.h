@@ -28,6 +28,9 @@
 #ifndef SRC_TINT_LANG_WGSL_RESOLVER_UNIFORMITY_H_
 #define SRC_TINT_LANG_WGSL_RESOLVER_UNIFORMITY_H_
 
+#include <cstddef>
+#include <cstdint>
+
 // Forward declarations.
 namespace tint::resolver {
 struct DependencyGraph;
@@ -41,11 +44,21 @@ namespace tint::resolver {
 /// If true, uniformity analysis failures will be treated as an error, else as a warning.
 constexpr bool kUniformityFailuresAsError = true;
 
+/// Modules with fewer functions than this are analyzed serially, whatever the number of threads
+/// allowed, as the cost of distributing their functions to threads outweighs the gain.
+constexpr size_t kMinFunctionsForParallelUniformity = 16;
+
 /// Analyze the uniformity of a program.
 /// @param builder the program to analyze
 /// @param dependency_graph the dependency-ordered module-scope declarations
+/// @param max_threads the maximum number of threads used to analyze functions whose callees have
+/// already been analyzed. If 1, or if the module has fewer than
+/// kMinFunctionsForParallelUniformity functions, the functions are analyzed serially. If 0, then
+/// DefaultThreadCount() threads are used. The result and diagnostics do not depend on this value.
 /// @returns true if there are no uniformity issues, false otherwise
-bool AnalyzeUniformity(ProgramBuilder& builder, const resolver::DependencyGraph& dependency_graph);
+bool AnalyzeUniformity(ProgramBuilder& builder,
+                       const resolver::DependencyGraph& dependency_graph,
+                       uint32_t max_threads = 1);
 
 }  // namespace tint::resolver
 
@@ -31,6 +31,7 @@
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "src/tint/lang/wgsl/program/program_builder.h"
 #include "src/tint/lang/wgsl/reader/reader.h"
@@ -10200,5 +10201,117 @@ test:15:11 note: reading from module-scope private variable 'non_uniform' may re
 )");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Parallel analysis tests.
+////////////////////////////////////////////////////////////////////////////////
+
+/// Shaders with several functions that can be analyzed concurrently.
+const char* const kParallelAnalysisShaders[] = {
+    // Functions that pass, with a diamond-shaped call graph.
+    R"(
+@group(0) @binding(0) var<storage, read_write> non_uniform : i32;
+
+fn leaf() -> i32 { return non_uniform; }
+fn left() -> i32 { return leaf() + 1; }
+fn right(p : i32) { if (p == 0) { workgroupBarrier(); } }
+fn top() { _ = left(); right(1); }
+
+@compute @workgroup_size(64)
+fn main() {
+  top();
+  _ = left();
+}
+)",
+
+    // Warnings in functions from several waves, which must be reported in declaration order.
+    R"(
+@group(0) @binding(0) var<storage, read_write> non_uniform : i32;
+
+@diagnostic(warning, derivative_uniformity)
+fn a() { if (non_uniform == 0) { _ = dpdx(1.0); } }
+@diagnostic(warning, derivative_uniformity)
+fn b() { a(); if (non_uniform == 1) { _ = dpdy(1.0); } }
+@diagnostic(warning, derivative_uniformity)
+fn c() { if (non_uniform == 2) { _ = fwidth(1.0); } }
+@diagnostic(info, derivative_uniformity)
+fn d() { b(); c(); if (non_uniform == 3) { _ = dpdx(1.0); } }
+)",
+
+    // Two functions in the same wave that report uniformity issues through the same callee.
+    R"(
+@group(0) @binding(0) var<storage, read_write> non_uniform : i32;
+
+@diagnostic(warning, derivative_uniformity)
+fn leaf(p : i32) { if (p == 0) { _ = dpdx(1.0); } }
+@diagnostic(warning, derivative_uniformity)
+fn a() { leaf(non_uniform); }
+@diagnostic(warning, derivative_uniformity)
+fn b() { if (non_uniform == 0) { leaf(1); } }
+@diagnostic(warning, derivative_uniformity)
+fn c() { leaf(non_uniform + 1); }
+)",
+
+    // An error in a later wave. The warnings of functions declared after the error must be
+    // dropped, even though those functions are analyzed before the function with the error.
+    R"(
+@group(0) @binding(0) var<storage, read_write> non_uniform : i32;
+
+@diagnostic(warning, derivative_uniformity)
+fn a() { if (non_uniform == 0) { _ = dpdx(1.0); } }
+fn leaf() { _ = dpdx(1.0); }
+fn caller() { if (non_uniform == 1) { leaf(); } }
+@diagnostic(warning, derivative_uniformity)
+fn later() { if (non_uniform == 2) { _ = dpdy(1.0); } }
+)",
+
+    // Errors in several functions of the same wave. Only the first is reported.
+    R"(
+@group(0) @binding(0) var<storage, read_write> non_uniform : i32;
+
+fn a() { if (non_uniform == 0) { workgroupBarrier(); } }
+fn b() { if (non_uniform == 1) { storageBarrier(); } }
+fn c() { if (non_uniform == 2) { _ = dpdx(1.0); } }
+)",
+};
+
+class UniformityAnalysisParallelTest : public ::testing::TestWithParam<const char*> {
+  protected:
+    /// Parse and resolve a WGSL shader.
+    /// @param src the WGSL source code
+    /// @param max_threads the maximum number of threads used by the resolver
+    /// @returns the resolved program
+    Program Parse(const char* src, uint32_t max_threads) {
+        wgsl::reader::Options options;
+        options.allowed_features = wgsl::AllowedFeatures::Everything();
+        options.max_resolver_threads = max_threads;
+
+        // Pad the shader with empty functions so that it is large enough to be analyzed in
+        // parallel. They come last, so they don't change the diagnostics.
+        std::string padded = src;
+        for (size_t i = 0; i < kMinFunctionsForParallelUniformity; i++) {
+            padded += "fn padding_" + std::to_string(i) + "() {}\n";
+        }
+        files_.push_back(std::make_unique<Source::File>("test", padded));
+        return wgsl::reader::Parse(files_.back().get(), options);
+    }
+
+    /// The source files, which must outlive the programs' diagnostics.
+    std::vector<std::unique_ptr<Source::File>> files_;
+};
+
+TEST_P(UniformityAnalysisParallelTest, MatchesSerial) {
+    auto serial = Parse(GetParam(), 1);
+    for (uint32_t max_threads : {0u, 2u, 4u}) {
+        auto parallel = Parse(GetParam(), max_threads);
+        EXPECT_EQ(parallel.IsValid(), serial.IsValid()) << "max_threads: " << max_threads;
+        EXPECT_EQ(parallel.Diagnostics().Str(), serial.Diagnostics().Str())
+            << "max_threads: " << max_threads;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(UniformityAnalysisTest,
+                         UniformityAnalysisParallelTest,
+                         ::testing::ValuesIn(kParallelAnalysisShaders));
+
 }  // namespace
 }  // namespace tint::resolver
@@ -32,6 +32,7 @@
 #include <utility>
 
 #include "src/tint/utils/containers/hashmap_base.h"
+#include "src/tint/utils/memory/allocator_stats.h"
 #include "src/tint/utils/memory/block_allocator.h"
 
 namespace tint {
@@ -84,6 +85,9 @@ class UniqueAllocator {
     /// @returns an iterator to the end of the types
     Iterator end() const { return allocator.Objects().end(); }
 
+    /// @returns the memory usage counters of the allocator
+    const AllocatorStats& Stats() const { return allocator.Stats(); }
+
   private:
     /// Comparator is the hashing function used by the Hashset
     struct Hasher {
@@ -39,6 +39,7 @@
 # Kind:      lib
 ################################################################################
 tint_add_target(tint_utils_file lib
+  utils/file/mapped_file.h
   utils/file/tmpfile.h
 )
 
@@ -54,18 +55,21 @@ tint_target_add_external_dependencies(tint_utils_file lib
 
 if((NOT TINT_BUILD_IS_LINUX) AND (NOT TINT_BUILD_IS_MAC) AND (NOT TINT_BUILD_IS_WIN))
   tint_target_add_sources(tint_utils_file lib
+    "utils/file/mapped_file_other.cc"
     "utils/file/tmpfile_other.cc"
   )
 endif((NOT TINT_BUILD_IS_LINUX) AND (NOT TINT_BUILD_IS_MAC) AND (NOT TINT_BUILD_IS_WIN))
 
 if(TINT_BUILD_IS_LINUX OR TINT_BUILD_IS_MAC)
   tint_target_add_sources(tint_utils_file lib
+    "utils/file/mapped_file_posix.cc"
     "utils/file/tmpfile_posix.cc"
   )
 endif(TINT_BUILD_IS_LINUX OR TINT_BUILD_IS_MAC)
 
 if(TINT_BUILD_IS_WIN)
   tint_target_add_sources(tint_utils_file lib
+    "utils/file/mapped_file_windows.cc"
     "utils/file/tmpfile_windows.cc"
   )
 endif(TINT_BUILD_IS_WIN)
@@ -75,6 +79,7 @@ endif(TINT_BUILD_IS_WIN)
 # Kind:      test
 ################################################################################
 tint_add_target(tint_utils_file_test test
+  utils/file/mapped_file_test.cc
   utils/file/tmpfile_test.cc
 )
 
@@ -0,0 +1,73 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef SRC_TINT_UTILS_FILE_MAPPED_FILE_H_
+#define SRC_TINT_UTILS_FILE_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+namespace tint {
+
+/// MappedFile maps the contents of a file into memory for reading.
+/// On platforms that support it the file is memory-mapped, so that the contents are only paged in
+/// as they are read. Other platforms fall back to reading the whole file into a heap allocation.
+/// The mapping is released on destruction.
+class MappedFile {
+  public:
+    /// Constructor.
+    /// Opens and maps the file at @p path. Use operator bool() to check whether this succeeded.
+    /// @param path the path to the file to map
+    explicit MappedFile(const std::string& path);
+
+    /// Destructor.
+    /// Unmaps the file.
+    ~MappedFile();
+
+    /// @return true if the file was successfully mapped.
+    explicit operator bool() const { return ok_; }
+
+    /// @return a pointer to the start of the mapped file contents. May be null if the file is
+    /// empty.
+    const std::byte* Data() const { return data_; }
+
+    /// @return the size of the mapped file contents in bytes
+    size_t Size() const { return size_; }
+
+  private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const std::byte* data_ = nullptr;
+    size_t size_ = 0;
+    bool ok_ = false;
+};
+
+}  // namespace tint
+
+#endif  // SRC_TINT_UTILS_FILE_MAPPED_FILE_H_
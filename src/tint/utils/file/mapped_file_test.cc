@@ -0,0 +1,80 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "src/tint/utils/file/mapped_file.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "src/tint/utils/file/tmpfile.h"
+
+namespace tint {
+namespace {
+
+TEST(MappedFileTest, MapContents) {
+    TmpFile tmp;
+    if (!tmp) {
+        GTEST_SKIP() << "Unable to create a temporary file";
+    }
+    tmp << "hello world";
+
+    MappedFile file(tmp.Path());
+    ASSERT_TRUE(file);
+    ASSERT_EQ(file.Size(), 11u);
+    EXPECT_EQ(std::memcmp(file.Data(), "hello world", 11), 0);
+}
+
+TEST(MappedFileTest, MapEmpty) {
+    TmpFile tmp;
+    if (!tmp) {
+        GTEST_SKIP() << "Unable to create a temporary file";
+    }
+
+    MappedFile file(tmp.Path());
+    ASSERT_TRUE(file);
+    EXPECT_EQ(file.Size(), 0u);
+}
+
+TEST(MappedFileTest, MissingFile) {
+    std::string path;
+    {
+        TmpFile tmp;
+        if (!tmp) {
+            GTEST_SKIP() << "Unable to create a temporary file";
+        }
+        path = tmp.Path();
+    }
+
+    MappedFile file(path);
+    EXPECT_FALSE(file);
+    EXPECT_EQ(file.Data(), nullptr);
+    EXPECT_EQ(file.Size(), 0u);
+}
+
+}  // namespace
+}  // namespace tint
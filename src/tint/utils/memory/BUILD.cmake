@@ -40,6 +40,7 @@
 ################################################################################
 tint_add_target(tint_utils_memory lib
   utils/memory/aligned_storage.h
+  utils/memory/allocator_stats.h
   utils/memory/bitcast.h
   utils/memory/block_allocator.h
   utils/memory/bump_allocator.h
@@ -0,0 +1,86 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_TINT_UTILS_MEMORY_ALLOCATOR_STATS_H_
+#define SRC_TINT_UTILS_MEMORY_ALLOCATOR_STATS_H_
+
+#include <algorithm>
+#include <cstddef>
+
+namespace tint {
+
+/// AllocatorStats holds the memory usage counters of a BlockAllocator or BumpAllocator, or the sum
+/// of the counters of several allocators.
+struct AllocatorStats {
+    /// The number of allocations made since the allocator was last reset.
+    /// For a BlockAllocator, this is the number of objects created.
+    size_t allocations = 0;
+    /// The number of heap blocks currently held by the allocator.
+    size_t blocks = 0;
+    /// The number of bytes handed out by the allocations, excluding alignment padding and
+    /// bookkeeping.
+    size_t bytes_allocated = 0;
+    /// The number of heap bytes currently held by the allocator's blocks.
+    size_t bytes_reserved = 0;
+    /// The highest value of #bytes_reserved over the lifetime of the allocator, including before
+    /// any calls to Reset().
+    size_t peak_bytes_reserved = 0;
+
+    /// Called when the allocator allocates a new heap block.
+    /// @param size the size of the block in bytes
+    void AddBlock(size_t size) {
+        blocks++;
+        bytes_reserved += size;
+        peak_bytes_reserved = std::max(peak_bytes_reserved, bytes_reserved);
+    }
+
+    /// Adds the counters of @p other to this.
+    /// @note the summed #peak_bytes_reserved is an upper bound, as the allocators may have peaked
+    /// at different times.
+    /// @param other the stats to add
+    /// @returns this AllocatorStats
+    AllocatorStats& operator+=(const AllocatorStats& other) {
+        allocations += other.allocations;
+        blocks += other.blocks;
+        bytes_allocated += other.bytes_allocated;
+        bytes_reserved += other.bytes_reserved;
+        peak_bytes_reserved += other.peak_bytes_reserved;
+        return *this;
+    }
+
+    /// @param other the stats to add
+    /// @returns the sum of this and @p other
+    AllocatorStats operator+(const AllocatorStats& other) const {
+        AllocatorStats out = *this;
+        out += other;
+        return out;
+    }
+};
+
+}  // namespace tint
+
+#endif  // SRC_TINT_UTILS_MEMORY_ALLOCATOR_STATS_H_
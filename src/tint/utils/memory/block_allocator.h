@@ -33,6 +33,7 @@
 #include <utility>
 
 #include "src/tint/utils/math/math.h"
+#include "src/tint/utils/memory/allocator_stats.h"
 #include "src/tint/utils/memory/bitcast.h"
 
 namespace tint {
@@ -205,7 +206,8 @@ class BlockAllocator {
         auto* ptr = Allocate<TYPE>();
         new (ptr) TYPE(std::forward<ARGS>(args)...);
         AddObjectPointer(ptr);
-        data.count++;
+        data.stats.allocations++;
+        data.stats.bytes_allocated += sizeof(TYPE);
 
         return ptr;
     }
@@ -221,11 +223,16 @@ class BlockAllocator {
             delete block;
             block = next;
         }
+        size_t peak_bytes_reserved = data.stats.peak_bytes_reserved;
         data = {};
+        data.stats.peak_bytes_reserved = peak_bytes_reserved;
     }
 
     /// @returns the total number of allocated objects.
-    size_t Count() const { return data.count; }
+    size_t Count() const { return data.stats.allocations; }
+
+    /// @returns the memory usage counters of the allocator
+    const AllocatorStats& Stats() const { return data.stats; }
 
   private:
     BlockAllocator(const BlockAllocator&) = delete;
@@ -251,6 +258,7 @@ class BlockAllocator {
             }
             block.current->next = nullptr;
             block.current_offset = 0;
+            data.stats.AddBlock(sizeof(Block));
             if (prev_block) {
                 prev_block->next = block.current;
             } else {
@@ -310,7 +318,8 @@ class BlockAllocator {
             Pointers* current = nullptr;
         } pointers;
 
-        size_t count = 0;
+        /// The memory usage counters, including the total number of allocated objects
+        AllocatorStats stats;
     } data;
 };
 
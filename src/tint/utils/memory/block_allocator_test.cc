@@ -76,6 +76,41 @@ TEST_F(BlockAllocatorTest, Count) {
     }
 }
 
+TEST_F(BlockAllocatorTest, Stats) {
+    using Allocator = BlockAllocator<int, 1024>;
+
+    Allocator allocator;
+    EXPECT_EQ(allocator.Stats().allocations, 0u);
+    EXPECT_EQ(allocator.Stats().blocks, 0u);
+    EXPECT_EQ(allocator.Stats().bytes_allocated, 0u);
+    EXPECT_EQ(allocator.Stats().bytes_reserved, 0u);
+    EXPECT_EQ(allocator.Stats().peak_bytes_reserved, 0u);
+
+    allocator.Create(1);
+    EXPECT_EQ(allocator.Stats().allocations, 1u);
+    EXPECT_EQ(allocator.Stats().blocks, 1u);
+    EXPECT_EQ(allocator.Stats().bytes_allocated, sizeof(int));
+    EXPECT_GE(allocator.Stats().bytes_reserved, 1024u);
+    EXPECT_EQ(allocator.Stats().peak_bytes_reserved, allocator.Stats().bytes_reserved);
+
+    for (size_t i = 0; i < 1000; i++) {
+        allocator.Create(2);
+    }
+    EXPECT_EQ(allocator.Stats().allocations, 1001u);
+    EXPECT_GT(allocator.Stats().blocks, 1u);
+    EXPECT_EQ(allocator.Stats().bytes_allocated, 1001u * sizeof(int));
+    EXPECT_GE(allocator.Stats().bytes_reserved, allocator.Stats().bytes_allocated);
+    EXPECT_EQ(allocator.Stats().peak_bytes_reserved, allocator.Stats().bytes_reserved);
+
+    size_t peak = allocator.Stats().peak_bytes_reserved;
+    allocator.Reset();
+    EXPECT_EQ(allocator.Stats().allocations, 0u);
+    EXPECT_EQ(allocator.Stats().blocks, 0u);
+    EXPECT_EQ(allocator.Stats().bytes_allocated, 0u);
+    EXPECT_EQ(allocator.Stats().bytes_reserved, 0u);
+    EXPECT_EQ(allocator.Stats().peak_bytes_reserved, peak);
+}
+
 TEST_F(BlockAllocatorTest, ObjectLifetime) {
     using Allocator = BlockAllocator<LifetimeCounter>;
 
@@ -36,6 +36,7 @@
 
 #include "src/tint/utils/macros/compiler.h"
 #include "src/tint/utils/math/math.h"
+#include "src/tint/utils/memory/allocator_stats.h"
 #include "src/tint/utils/memory/bitcast.h"
 
 namespace tint {
@@ -94,6 +95,7 @@ class BumpAllocator {
             }
             data.current->next = nullptr;
             data.current_data_size = data_size;
+            data.stats.AddBlock(sizeof(BlockHeader) + data_size);
             data.current_offset = 0;
             if (prev_block) {
                 prev_block->next = data.current;
@@ -105,7 +107,8 @@ class BumpAllocator {
         auto* base = Bitcast<std::byte*>(data.current) + sizeof(BlockHeader);
         auto* ptr = base + data.current_offset;
         data.current_offset += size_in_bytes;
-        data.count++;
+        data.stats.allocations++;
+        data.stats.bytes_allocated += size_in_bytes;
         return ptr;
     }
 
@@ -117,11 +120,16 @@ class BumpAllocator {
             delete[] Bitcast<std::byte*>(block);
             block = next;
         }
+        size_t peak_bytes_reserved = data.stats.peak_bytes_reserved;
         data = {};
+        data.stats.peak_bytes_reserved = peak_bytes_reserved;
     }
 
     /// @returns the total number of allocations
-    size_t Count() const { return data.count; }
+    size_t Count() const { return data.stats.allocations; }
+
+    /// @returns the memory usage counters of the allocator
+    const AllocatorStats& Stats() const { return data.stats; }
 
   private:
     BumpAllocator(const BumpAllocator&) = delete;
@@ -137,8 +145,8 @@ class BumpAllocator {
         size_t current_offset = 0;
         /// The size of the #current, excluding the header size
         size_t current_data_size = 0;
-        /// Total number of allocations
-        size_t count = 0;
+        /// The memory usage counters, including the total number of allocations
+        AllocatorStats stats;
     } data;
 };
 
@@ -70,6 +70,35 @@ TEST_F(BumpAllocatorTest, Count) {
     }
 }
 
+TEST_F(BumpAllocatorTest, Stats) {
+    BumpAllocator allocator;
+    EXPECT_EQ(allocator.Stats().allocations, 0u);
+    EXPECT_EQ(allocator.Stats().blocks, 0u);
+    EXPECT_EQ(allocator.Stats().bytes_allocated, 0u);
+    EXPECT_EQ(allocator.Stats().bytes_reserved, 0u);
+
+    allocator.Allocate(5);
+    allocator.Allocate(7);
+    EXPECT_EQ(allocator.Stats().allocations, 2u);
+    EXPECT_EQ(allocator.Stats().blocks, 1u);
+    EXPECT_EQ(allocator.Stats().bytes_allocated, 12u);
+    EXPECT_GT(allocator.Stats().bytes_reserved, BumpAllocator::kDefaultBlockDataSize);
+
+    allocator.Allocate(BumpAllocator::kDefaultBlockDataSize * 2);
+    EXPECT_EQ(allocator.Stats().allocations, 3u);
+    EXPECT_EQ(allocator.Stats().blocks, 2u);
+    EXPECT_EQ(allocator.Stats().bytes_allocated, 12u + BumpAllocator::kDefaultBlockDataSize * 2);
+    EXPECT_GT(allocator.Stats().bytes_reserved, BumpAllocator::kDefaultBlockDataSize * 3);
+    EXPECT_EQ(allocator.Stats().peak_bytes_reserved, allocator.Stats().bytes_reserved);
+
+    size_t peak = allocator.Stats().peak_bytes_reserved;
+    allocator.Reset();
+    EXPECT_EQ(allocator.Stats().allocations, 0u);
+    EXPECT_EQ(allocator.Stats().blocks, 0u);
+    EXPECT_EQ(allocator.Stats().bytes_reserved, 0u);
+    EXPECT_EQ(allocator.Stats().peak_bytes_reserved, peak);
+}
+
 TEST_F(BumpAllocatorTest, MoveConstruct) {
     for (size_t n : {0u, 1u, 10u, 16u, 20u, 32u, 50u, 64u, 100u, 256u, 300u, 512u, 500u, 512u}) {
         BumpAllocator allocator_a;
@@ -41,6 +41,8 @@
 tint_add_target(tint_utils_system lib
   utils/system/env.h
   utils/system/executable_path.h
+  utils/system/parallel.cc
+  utils/system/parallel.h
   utils/system/terminal.h
 )
 
@@ -56,6 +58,7 @@ tint_target_add_dependencies(tint_utils_system lib
 
 tint_target_add_external_dependencies(tint_utils_system lib
   "src_utils"
+  "thread"
 )
 
 if((NOT TINT_BUILD_IS_LINUX) AND (NOT TINT_BUILD_IS_MAC) AND (NOT TINT_BUILD_IS_WIN))
@@ -0,0 +1,171 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/tint/utils/system/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace tint {
+namespace {
+
+/// The calls of a single ParallelFor(), shared by the calling thread and the pool threads helping
+/// it.
+struct Job {
+    /// Constructor
+    /// @param c the number of calls
+    /// @param f the function to call
+    Job(size_t c, const std::function<void(size_t)>& f) : count(c), func(f) {}
+
+    /// Makes calls until every index has been claimed.
+    void Work() {
+        for (size_t i = next++; i < count; i = next++) {
+            func(i);
+            if (++completed == count) {
+                std::lock_guard<std::mutex> lock(mutex);
+                all_completed.notify_all();
+            }
+        }
+    }
+
+    /// Blocks until every call has returned.
+    void Wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        all_completed.wait(lock, [&] { return completed.load() == count; });
+    }
+
+    /// The number of calls
+    const size_t count;
+    /// The function to call. Only used by the threads that claimed an index, which the calling
+    /// thread waits for, so the reference doesn't outlive the ParallelFor() call.
+    const std::function<void(size_t)>& func;
+    /// The next index to claim
+    std::atomic<size_t> next{0};
+    /// The number of calls that have returned
+    std::atomic<size_t> completed{0};
+    /// The mutex and condition variable used to wait for #completed to reach #count
+    std::mutex mutex;
+    std::condition_variable all_completed;
+};
+
+/// A pool of threads that live for the rest of the process, so that ParallelFor() doesn't create
+/// and join threads on each call.
+class ThreadPool {
+  public:
+    /// Constructor
+    /// @param thread_count the number of threads of the pool
+    explicit ThreadPool(size_t thread_count) : thread_count_(thread_count) {
+        for (size_t i = 0; i < thread_count; i++) {
+            std::thread([this] { Run(); }).detach();
+        }
+    }
+
+    /// Asks @p helper_count threads of the pool to help with @p job. The calling thread works on
+    /// the job too, so the job completes even if all the threads of the pool are busy.
+    /// @param job the job to help with
+    /// @param helper_count the number of threads to ask
+    void Help(const std::shared_ptr<Job>& job, size_t helper_count) {
+        helper_count = std::min(helper_count, thread_count_);
+        if (helper_count == 0) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t i = 0; i < helper_count; i++) {
+                jobs_.push_back(job);
+            }
+        }
+        if (helper_count == 1) {
+            jobs_available_.notify_one();
+        } else {
+            jobs_available_.notify_all();
+        }
+    }
+
+  private:
+    /// Runs the jobs posted to the pool, forever.
+    void Run() {
+        while (true) {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                jobs_available_.wait(lock, [&] { return !jobs_.empty(); });
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            // Jobs that already completed are skipped, as all their indices are claimed.
+            job->Work();
+        }
+    }
+
+    const size_t thread_count_;
+    std::mutex mutex_;
+    std::condition_variable jobs_available_;
+    std::deque<std::shared_ptr<Job>> jobs_;
+};
+
+/// @returns the thread pool used by ParallelFor()
+ThreadPool& GetThreadPool() {
+    // Never destroyed, as its threads are never joined.
+    static ThreadPool* pool = new ThreadPool(DefaultThreadCount() - 1);
+    return *pool;
+}
+
+}  // namespace
+
+uint32_t DefaultThreadCount() {
+    // hardware_concurrency() may return 0 if the value is not computable.
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+void ParallelFor(size_t count, uint32_t max_threads, const std::function<void(size_t)>& func) {
+    if (max_threads == 0) {
+        max_threads = DefaultThreadCount();
+    }
+    size_t num_threads = std::min<size_t>(count, max_threads);
+    if (num_threads <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            func(i);
+        }
+        return;
+    }
+
+    // Each thread pulls the next unclaimed index until all indices have been claimed. This keeps
+    // threads busy when the cost of each call varies wildly.
+    auto job = std::make_shared<Job>(count, func);
+    GetThreadPool().Help(job, num_threads - 1);
+    job->Work();
+    job->Wait();
+}
+
+}  // namespace tint
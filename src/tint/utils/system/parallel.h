@@ -0,0 +1,53 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_TINT_UTILS_SYSTEM_PARALLEL_H_
+#define SRC_TINT_UTILS_SYSTEM_PARALLEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace tint {
+
+/// @returns the number of worker threads to use when the caller does not specify a thread count.
+uint32_t DefaultThreadCount();
+
+/// Calls @p func once for each index in [0, @p count), distributing the calls across up to
+/// @p max_threads threads. The calling thread participates in the work, and the function does not
+/// return until every call has returned. The other threads come from a pool that is created on the
+/// first call and reused by the following ones. The pool has DefaultThreadCount() - 1 threads, so
+/// @p max_threads values above DefaultThreadCount() don't add more threads.
+/// @param count the number of indices to call @p func with
+/// @param max_threads the maximum number of threads to use. If 0, then DefaultThreadCount() is
+/// used.
+/// @param func the function to call, which must be safe to call concurrently from multiple threads
+void ParallelFor(size_t count, uint32_t max_threads, const std::function<void(size_t)>& func);
+
+}  // namespace tint
+
+#endif  // SRC_TINT_UTILS_SYSTEM_PARALLEL_H_
@@ -0,0 +1,158 @@
+// Deferred shading: a G-buffer pass that writes surface attributes, followed by a full-screen
+// lighting pass that accumulates many point lights from a storage buffer.
+
+struct Camera {
+  viewProjection : mat4x4<f32>,
+  invViewProjection : mat4x4<f32>,
+  position : vec3<f32>,
+  exposure : f32,
+}
+
+struct Model {
+  model : mat4x4<f32>,
+  normalModel : mat3x3<f32>,
+}
+
+struct PointLight {
+  position : vec3<f32>,
+  radius : f32,
+  color : vec3<f32>,
+  intensity : f32,
+}
+
+struct Lights {
+  count : u32,
+  ambient : vec3<f32>,
+  lights : array<PointLight>,
+}
+
+@group(0) @binding(0) var<uniform> camera : Camera;
+@group(0) @binding(1) var<uniform> model : Model;
+@group(0) @binding(2) var<storage, read> lights : Lights;
+
+@group(1) @binding(0) var albedoTexture : texture_2d<f32>;
+@group(1) @binding(1) var normalTexture : texture_2d<f32>;
+@group(1) @binding(2) var materialSampler : sampler;
+
+@group(2) @binding(0) var gBufferAlbedo : texture_2d<f32>;
+@group(2) @binding(1) var gBufferNormal : texture_2d<f32>;
+@group(2) @binding(2) var gBufferDepth : texture_depth_2d;
+
+struct VertexInput {
+  @location(0) position : vec3<f32>,
+  @location(1) normal : vec3<f32>,
+  @location(2) tangent : vec4<f32>,
+  @location(3) uv : vec2<f32>,
+}
+
+struct GBufferVarying {
+  @builtin(position) position : vec4<f32>,
+  @location(0) normal : vec3<f32>,
+  @location(1) tangent : vec3<f32>,
+  @location(2) bitangent : vec3<f32>,
+  @location(3) uv : vec2<f32>,
+}
+
+struct GBufferOutput {
+  @location(0) albedo : vec4<f32>,
+  @location(1) normal : vec4<f32>,
+}
+
+@vertex
+fn gbuffer_vs(input : VertexInput) -> GBufferVarying {
+  var output : GBufferVarying;
+  let world = model.model * vec4(input.position, 1.0);
+  output.position = camera.viewProjection * world;
+  output.normal = normalize(model.normalModel * input.normal);
+  output.tangent = normalize(model.normalModel * input.tangent.xyz);
+  output.bitangent = cross(output.normal, output.tangent) * input.tangent.w;
+  output.uv = input.uv;
+  return output;
+}
+
+// Packs a unit vector into two components with an octahedral mapping.
+fn encode_normal(n : vec3<f32>) -> vec2<f32> {
+  let p = n.xy / (abs(n.x) + abs(n.y) + abs(n.z));
+  if (n.z >= 0.0) {
+    return p;
+  }
+  return (1.0 - abs(p.yx)) * select(vec2(-1.0), vec2(1.0), p >= vec2(0.0));
+}
+
+fn decode_normal(e : vec2<f32>) -> vec3<f32> {
+  var n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+  let t = max(-n.z, 0.0);
+  n.x += select(t, -t, n.x >= 0.0);
+  n.y += select(t, -t, n.y >= 0.0);
+  return normalize(n);
+}
+
+@fragment
+fn gbuffer_fs(input : GBufferVarying) -> GBufferOutput {
+  let tbn = mat3x3(normalize(input.tangent), normalize(input.bitangent), normalize(input.normal));
+  let tangentNormal = textureSample(normalTexture, materialSampler, input.uv).xyz * 2.0 - 1.0;
+  let albedo = textureSample(albedoTexture, materialSampler, input.uv);
+  if (albedo.a < 0.5) {
+    discard;
+  }
+  var output : GBufferOutput;
+  output.albedo = vec4(albedo.rgb, 1.0);
+  output.normal = vec4(encode_normal(normalize(tbn * tangentNormal)), 0.0, 1.0);
+  return output;
+}
+
+@vertex
+fn lighting_vs(@builtin(vertex_index) index : u32) -> @builtin(position) vec4<f32> {
+  const positions = array(vec2(-1.0, -1.0), vec2(3.0, -1.0), vec2(-1.0, 3.0));
+  return vec4(positions[index], 0.0, 1.0);
+}
+
+fn world_position(uv : vec2<f32>, depth : f32) -> vec3<f32> {
+  let clip = vec4(uv.x * 2.0 - 1.0, (1.0 - uv.y) * 2.0 - 1.0, depth, 1.0);
+  let world = camera.invViewProjection * clip;
+  return world.xyz / world.w;
+}
+
+fn attenuation(distance : f32, radius : f32) -> f32 {
+  let falloff = saturate(1.0 - pow(distance / radius, 4.0));
+  return falloff * falloff / (distance * distance + 1.0);
+}
+
+fn shade(light : PointLight, position : vec3<f32>, normal : vec3<f32>, albedo : vec3<f32>) -> vec3<f32> {
+  let toLight = light.position - position;
+  let distance = length(toLight);
+  if (distance > light.radius) {
+    return vec3(0.0);
+  }
+  let l = toLight / distance;
+  let v = normalize(camera.position - position);
+  let h = normalize(l + v);
+  let diffuse = max(dot(normal, l), 0.0) * albedo;
+  let specular = pow(max(dot(normal, h), 0.0), 32.0) * vec3(0.25);
+  return (diffuse + specular) * light.color * light.intensity * attenuation(distance, light.radius);
+}
+
+fn tonemap(color : vec3<f32>) -> vec3<f32> {
+  let c = color * camera.exposure;
+  let mapped = (c * (2.51 * c + 0.03)) / (c * (2.43 * c + 0.59) + 0.14);
+  return pow(saturate(mapped), vec3(1.0 / 2.2));
+}
+
+@fragment
+fn lighting_fs(@builtin(position) coord : vec4<f32>) -> @location(0) vec4<f32> {
+  let texel = vec2<i32>(floor(coord.xy));
+  let depth = textureLoad(gBufferDepth, texel, 0);
+  if (depth >= 1.0) {
+    discard;
+  }
+  let uv = coord.xy / vec2<f32>(textureDimensions(gBufferDepth));
+  let position = world_position(uv, depth);
+  let normal = decode_normal(textureLoad(gBufferNormal, texel, 0).xy);
+  let albedo = textureLoad(gBufferAlbedo, texel, 0).rgb;
+
+  var color = lights.ambient * albedo;
+  for (var i = 0u; i < min(lights.count, arrayLength(&lights.lights)); i++) {
+    color += shade(lights.lights[i], position, normal, albedo);
+  }
+  return vec4(tonemap(color), 1.0);
+}
@@ -0,0 +1,141 @@
+// Machine learning kernels: a tiled matrix multiplication that stages tiles in workgroup memory,
+// and a row-wise softmax that uses workgroup reductions.
+
+struct Matrix {
+  numbers : array<f32>,
+}
+
+struct Uniforms {
+  dimAOuter : u32,
+  dimInner : u32,
+  dimBOuter : u32,
+  alpha : f32,
+}
+
+@group(0) @binding(0) var<storage, read> firstMatrix : Matrix;
+@group(0) @binding(1) var<storage, read> secondMatrix : Matrix;
+@group(0) @binding(2) var<storage, read_write> resultMatrix : Matrix;
+@group(0) @binding(3) var<uniform> uniforms : Uniforms;
+
+const kTileSize = 32u;
+const kRowPerThread = 4u;
+const kColPerThread = 4u;
+
+var<workgroup> mm_Asub : array<array<f32, kTileSize>, kTileSize>;
+var<workgroup> mm_Bsub : array<array<f32, kTileSize>, kTileSize>;
+
+fn mm_readA(row : u32, col : u32) -> f32 {
+  if (row < uniforms.dimAOuter && col < uniforms.dimInner) {
+    return firstMatrix.numbers[row * uniforms.dimInner + col];
+  }
+  return 0.0;
+}
+
+fn mm_readB(row : u32, col : u32) -> f32 {
+  if (row < uniforms.dimInner && col < uniforms.dimBOuter) {
+    return secondMatrix.numbers[row * uniforms.dimBOuter + col];
+  }
+  return 0.0;
+}
+
+fn mm_write(row : u32, col : u32, value : f32) {
+  if (row < uniforms.dimAOuter && col < uniforms.dimBOuter) {
+    resultMatrix.numbers[row * uniforms.dimBOuter + col] = uniforms.alpha * value;
+  }
+}
+
+@compute @workgroup_size(8, 8, 1)
+fn matmul(@builtin(local_invocation_id) local_id : vec3<u32>,
+          @builtin(global_invocation_id) global_id : vec3<u32>) {
+  let tileRow = local_id.y * kRowPerThread;
+  let tileCol = local_id.x * kColPerThread;
+  let globalRow = global_id.y * kRowPerThread;
+  let globalCol = global_id.x * kColPerThread;
+  let numTiles = (uniforms.dimInner - 1u) / kTileSize + 1u;
+
+  var acc : array<array<f32, kColPerThread>, kRowPerThread>;
+  var BCached : array<f32, kColPerThread>;
+
+  for (var t = 0u; t < numTiles; t++) {
+    // Load one tile of each input matrix into workgroup memory.
+    for (var innerRow = 0u; innerRow < kRowPerThread; innerRow++) {
+      for (var innerCol = 0u; innerCol < kColPerThread; innerCol++) {
+        let inputRow = tileRow + innerRow;
+        let inputCol = tileCol + innerCol;
+        mm_Asub[inputRow][inputCol] = mm_readA(globalRow + innerRow, t * kTileSize + inputCol);
+        mm_Bsub[inputRow][inputCol] = mm_readB(t * kTileSize + inputRow, globalCol + innerCol);
+      }
+    }
+    workgroupBarrier();
+
+    // Accumulate the products of the tiles.
+    for (var k = 0u; k < kTileSize; k++) {
+      for (var inner = 0u; inner < kColPerThread; inner++) {
+        BCached[inner] = mm_Bsub[k][tileCol + inner];
+      }
+      for (var innerRow = 0u; innerRow < kRowPerThread; innerRow++) {
+        let ACached = mm_Asub[tileRow + innerRow][k];
+        for (var innerCol = 0u; innerCol < kColPerThread; innerCol++) {
+          acc[innerRow][innerCol] = fma(ACached, BCached[innerCol], acc[innerRow][innerCol]);
+        }
+      }
+    }
+    workgroupBarrier();
+  }
+
+  for (var innerRow = 0u; innerRow < kRowPerThread; innerRow++) {
+    for (var innerCol = 0u; innerCol < kColPerThread; innerCol++) {
+      mm_write(globalRow + innerRow, globalCol + innerCol, acc[innerRow][innerCol]);
+    }
+  }
+}
+
+const kSoftmaxWorkgroupSize = 64u;
+
+@group(0) @binding(4) var<storage, read_write> logits : Matrix;
+
+var<workgroup> row_scratch : array<f32, kSoftmaxWorkgroupSize>;
+
+// Reduces row_scratch to a single value in row_scratch[0], using either max or sum.
+fn reduce_row(lid : u32, use_max : bool) {
+  for (var stride = kSoftmaxWorkgroupSize / 2u; stride > 0u; stride >>= 1u) {
+    if (lid < stride) {
+      let a = row_scratch[lid];
+      let b = row_scratch[lid + stride];
+      row_scratch[lid] = select(a + b, max(a, b), use_max);
+    }
+    workgroupBarrier();
+  }
+}
+
+@compute @workgroup_size(kSoftmaxWorkgroupSize)
+fn softmax(@builtin(local_invocation_index) lid : u32,
+           @builtin(workgroup_id) wid : vec3<u32>) {
+  let row = wid.x;
+  let cols = uniforms.dimBOuter;
+
+  var row_max = -3.4e38f;
+  for (var c = lid; c < cols; c += kSoftmaxWorkgroupSize) {
+    row_max = max(row_max, logits.numbers[row * cols + c]);
+  }
+  row_scratch[lid] = row_max;
+  workgroupBarrier();
+  reduce_row(lid, true);
+  let max_value = row_scratch[0];
+  workgroupBarrier();
+
+  var sum = 0.0;
+  for (var c = lid; c < cols; c += kSoftmaxWorkgroupSize) {
+    let e = exp(logits.numbers[row * cols + c] - max_value);
+    logits.numbers[row * cols + c] = e;
+    sum += e;
+  }
+  row_scratch[lid] = sum;
+  workgroupBarrier();
+  reduce_row(lid, false);
+  let total = row_scratch[0];
+
+  for (var c = lid; c < cols; c += kSoftmaxWorkgroupSize) {
+    logits.numbers[row * cols + c] /= total;
+  }
+}